@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_config.h"
+#include "audio_pool.h"
+#include "audio_ring.h"
+#include "audio_frontend.h"
+#include "audio_conditioning.h"
+#include "noise_suppressor.h"
+#include "energy_vad.h"
+#include "decimator.h"
+#include "beamformer.h"
+#include "boot_profile.h"
+
+// 부팅 초기화 비용 (호스트): wake_word.cpp app_main/process_audio의 플랫폼 독립적인 초기화를 같은 순서로 실행
+// - 첫 실행(콜드): 단계별 시간을 boot_profile로 출력 (ESP32의 부팅 로그와 같은 형식)
+// - 반복 실행: 전체 초기화 평균 시간
+// I2S/UART 드라이버, 모델 파티션 mmap, AllocateTensors(TFLM)는 호스트에 없으므로 빠져 있습니다.
+// ESP32의 리셋 → 첫 추론 시간은 부팅 로그의 "BOOT" 태그를 보세요.
+//
+//   ./bench_boot [--iterations N]
+
+// wake_word.cpp와 같은 크기 (모노, 16비트 슬롯 기본 설정)
+#define CAPTURE_BLOCK_SAMPLES 512
+#define MODEL_BLOCK_SAMPLES (CAPTURE_BLOCK_SAMPLES / MODEL_DECIMATION)
+#define MODEL_WINDOW_MAX_SAMPLES MODEL_SAMPLE_RATE
+#define PREROLL_SAMPLES (MODEL_SAMPLE_RATE * 300 / 1000)
+#define AUDIO_BLOCK_BYTES (CAPTURE_BLOCK_SAMPLES * sizeof(int16_t))
+#define TENSOR_ARENA_SIZE (70 * 1024)
+
+static const audio_pool_budget_t pool_budget[] = {
+    {"block", AUDIO_BLOCK_BYTES, 3, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    {"wide", 2 * AUDIO_BLOCK_BYTES, 1, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    {"preroll", PREROLL_SAMPLES * sizeof(int16_t), 1, AUDIO_POOL_CAP_INTERNAL},
+    {"arena", TENSOR_ARENA_SIZE, 1, AUDIO_POOL_CAP_INTERNAL},
+};
+
+static audio_ring_t ring;
+static audio_frontend_t frontend;
+static noise_suppressor_t suppressor;
+static audio_conditioning_t conditioning;
+static energy_vad_t vad;
+static decimator_t decimator;
+static beamformer_t beamformer;
+
+// 초기화 한 번 (profile이면 단계마다 기록)
+static int run_init(int profile) {
+#define MARK(phase) do { if (profile) boot_profile_mark(phase); } while (0)
+    MARK("start");
+    if (!audio_pool_init(pool_budget, sizeof(pool_budget) / sizeof(pool_budget[0]))) {
+        return 0;
+    }
+    MARK("audio_pool");
+    if (!audio_ring_init(&ring, MODEL_WINDOW_MAX_SAMPLES + PREROLL_SAMPLES + 4 * MODEL_BLOCK_SAMPLES)) {
+        return 0;
+    }
+    MARK("audio_ring");
+
+    beamformer_init(&beamformer, MODEL_SAMPLE_RATE * MODEL_DECIMATION, 60.0f, 0.0f);
+    energy_vad_init(&vad);
+    audio_conditioning_config_t conditioning_config;
+    audio_conditioning_default_config(&conditioning_config);
+    audio_conditioning_init(&conditioning, &conditioning_config);
+    MARK("capture_dsp");
+
+    noise_suppressor_config_t suppressor_config;
+    noise_suppressor_default_config(&suppressor_config, MODEL_SAMPLE_RATE);
+    audio_frontend_init(&frontend);
+    noise_suppressor_init(&suppressor, &suppressor_config);
+    decimator_init(&decimator);
+    MARK("frontend");
+
+    // 첫 블록 처리 (캐시/페이지가 처음 닿는 비용)
+    int16_t block[CAPTURE_BLOCK_SAMPLES];
+    memset(block, 0, sizeof(block));
+    audio_conditioning_process(&conditioning, block, CAPTURE_BLOCK_SAMPLES);
+    audio_ring_write(&ring, block, MODEL_BLOCK_SAMPLES);
+    MARK("first_block");
+#undef MARK
+    return 1;
+}
+
+static void run_deinit(void) {
+    free(ring.data);  // 호스트 경로는 malloc
+    audio_pool_deinit();
+}
+
+int main(int argc, char **argv) {
+    int iterations = 200;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--iterations N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    // 콜드: 프로세스 시작 후 첫 초기화
+    if (!run_init(1)) {
+        printf("FAILED: init\n");
+        return 1;
+    }
+    boot_profile_report();
+    run_deinit();
+
+    // 웜: 반복 평균
+    int64_t start = boot_profile_now_us();
+    for (int i = 0; i < iterations; i++) {
+        if (!run_init(0)) {
+            printf("FAILED: init\n");
+            return 1;
+        }
+        run_deinit();
+    }
+    double average = (double)(boot_profile_now_us() - start) / iterations;
+    printf("Warm init + deinit: %.1f us average over %d iterations (MODEL_SAMPLE_RATE %d)\n",
+           average, iterations, MODEL_SAMPLE_RATE);
+    return 0;
+}
@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_conditioning.h"
+
+// audio_conditioning.c 확인 및 벤치마크 (samples/µs)
+// 1. 샘플 단위 기준 구현(reference_process, 펼치지 않은 루프, 64비트 중간값)과 비트 단위로 같은지:
+//    단계별/전체 설정 여러 개 × 블록 길이(512, 홀수 길이, 무작위 길이) × 입력(고정 신호, 클리핑/전체 범위 무작위)
+// 2. 고정 입력, 모든 단계, 512 샘플 블록 출력의 CRC32가 GOLDEN_CRC32와 같은지 (저장소에 기록된 값)
+// 다르면 1 반환. 일부러 출력을 바꿨으면 기준 구현과 GOLDEN_CRC32를 같이 고쳐주세요.
+//
+//   ./bench_conditioning                           # 확인 + 처리 속도
+//   ./bench_conditioning --check                   # 확인만
+//   ./bench_conditioning --write-golden out.raw    # 고정 입력에 대한 출력 저장
+//   ./bench_conditioning --golden out.raw          # 저장된 출력과 비트 단위로 비교 (코드 수정 후 결과가 바뀌었는지 확인)
+
+#define SAMPLE_RATE   16000
+#define BLOCK_SAMPLES 512             // wake_word.cpp의 CAPTURE_BLOCK_SAMPLES (DMA 버퍼 하나)
+#define SIGNAL_SAMPLES (SAMPLE_RATE * 10)
+#define GOLDEN_CRC32  0xC5E4A15Au     // make_signal(), 모든 단계(기본 파라미터), BLOCK_SAMPLES 블록
+
+static int16_t input[SIGNAL_SAMPLES];
+static int16_t output[SIGNAL_SAMPLES];
+static int16_t extreme[SIGNAL_SAMPLES];
+
+// 고정 입력: DC 오프셋 + 크기가 변하는 톤 + 잡음 (난수도 고정)
+static void make_signal(void) {
+    uint32_t seed = 12345;
+    int32_t phase = 0;
+    for (int i = 0; i < SIGNAL_SAMPLES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int32_t noise = (int32_t)(seed >> 22) - 512;
+        phase = (phase + 440 * 65536 / SAMPLE_RATE) & 0xFFFF;
+        int32_t triangle = phase < 32768 ? phase - 16384 : 49152 - phase;  // -16384..16384
+        int32_t amplitude = 200 + (i * 19800LL) / SIGNAL_SAMPLES;          // 점점 커짐
+        int32_t value = 1500 + triangle * amplitude / 16384 + noise;
+        input[i] = (int16_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
+}
+
+// 극단적인 입력: 양 끝 값 사각파, 큰 DC 계단, 전체 범위 무작위, 무음을 1초씩 번갈아
+static void make_extreme(void) {
+    uint32_t seed = 777;
+    for (int i = 0; i < SIGNAL_SAMPLES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int32_t value;
+        switch ((i / SAMPLE_RATE) % 4) {
+        case 0:
+            value = (i / 20) & 1 ? 32767 : -32768;
+            break;
+        case 1:
+            value = (i / 4000) & 1 ? 30000 : -30000;
+            break;
+        case 2:
+            value = (int16_t)(seed >> 16);
+            break;
+        default:
+            value = 0;
+            break;
+        }
+        extreme[i] = (int16_t)value;
+    }
+}
+
+static uint32_t crc32(const uint8_t *data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+// ---- 샘플 단위 기준 구현 (audio_conditioning.h의 식 그대로, 펼치지 않고 64비트로 계산) ----
+// 커널이 int32에서 넘치거나 펼친 루프의 꼬리 처리가 틀리면 여기와 달라짐
+
+typedef struct {
+    int64_t dc_x1;
+    int64_t dc_y1;              // Q12 추가 정밀도
+    int64_t pre_x1;
+    int64_t gain_q16;
+    int64_t applied_gain_q16;
+} reference_t;
+
+static int16_t reference_saturate(int64_t value) {
+    return (int16_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+}
+
+static void reference_init(reference_t *r) {
+    memset(r, 0, sizeof(*r));
+    r->gain_q16 = 65536;
+    r->applied_gain_q16 = 65536;
+}
+
+static void reference_process(reference_t *r, const audio_conditioning_config_t *c, int16_t *x, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    for (size_t n = 0; n < count && c->dc_block; n++) {
+        // y[n] = x[n] - x[n-1] + a * y[n-1]
+        int64_t xn = x[n];
+        r->dc_y1 = (xn - r->dc_x1) * 4096 + ((c->dc_pole_q15 * r->dc_y1) >> 15);
+        r->dc_x1 = xn;
+        x[n] = reference_saturate((r->dc_y1 + 2048) >> 12);
+    }
+    for (size_t n = 0; n < count && c->preemphasis; n++) {
+        // y[n] = x[n] - b * x[n-1]
+        int64_t xn = x[n];
+        x[n] = reference_saturate(xn - ((c->preemphasis_q15 * r->pre_x1 + 16384) >> 15));
+        r->pre_x1 = xn;
+    }
+    if (!c->agc) {
+        return;
+    }
+    int64_t peak = 0;
+    for (size_t n = 0; n < count; n++) {
+        int64_t a = x[n] < 0 ? -(int64_t)x[n] : x[n];
+        peak = a > peak ? a : peak;
+    }
+    int64_t target = c->agc_max_gain_q16;
+    if (peak > 0 && ((int64_t)c->agc_target << 16) / peak < target) {
+        target = ((int64_t)c->agc_target << 16) / peak;
+    }
+    if (target < r->gain_q16) {
+        r->gain_q16 -= (r->gain_q16 - target) >> c->agc_attack_shift;
+    } else {
+        r->gain_q16 += (target - r->gain_q16) >> c->agc_release_shift;
+    }
+    int64_t gain_end = r->gain_q16;
+    if (peak > 0 && ((int64_t)c->agc_limit << 16) / peak < gain_end) {
+        gain_end = ((int64_t)c->agc_limit << 16) / peak;
+    }
+    int64_t gain = r->applied_gain_q16 < gain_end ? r->applied_gain_q16 : gain_end;
+    int64_t step = (gain_end - gain) / (int64_t)count;
+    for (size_t n = 0; n < count; n++) {
+        x[n] = reference_saturate((x[n] * gain + 32768) >> 16);
+        gain += step;
+    }
+    r->applied_gain_q16 = gain_end;
+}
+
+// 블록 길이 순서: 0 = BLOCK_SAMPLES, 1~5 = 고정 홀수 길이, 6 = 1~600 무작위
+#define SCHEDULE_COUNT 7
+
+static size_t block_length(int schedule, uint32_t *seed) {
+    static const size_t odd[] = {1, 3, 7, 31, 509};
+    if (schedule == 0) {
+        return BLOCK_SAMPLES;
+    }
+    if (schedule <= 5) {
+        return odd[schedule - 1];
+    }
+    *seed = *seed * 1664525u + 1013904223u;
+    return 1 + (*seed >> 8) % 600;
+}
+
+// 커널과 기준 구현을 같은 블록 순서로 돌려서 비교
+static bool check_reference(const char *name, const audio_conditioning_config_t *config, const int16_t *signal,
+                            int schedule) {
+    static int16_t a[SIGNAL_SAMPLES], b[SIGNAL_SAMPLES];
+    audio_conditioning_t state;
+    reference_t reference;
+    audio_conditioning_init(&state, config);
+    reference_init(&reference);
+    memcpy(a, signal, sizeof(a));
+    memcpy(b, signal, sizeof(b));
+    uint32_t seed = 99;
+    for (size_t i = 0; i < SIGNAL_SAMPLES;) {
+        size_t count = block_length(schedule, &seed);
+        count = count < SIGNAL_SAMPLES - i ? count : SIGNAL_SAMPLES - i;
+        audio_conditioning_process(&state, a + i, count);
+        reference_process(&reference, config, b + i, count);
+        for (size_t n = i; n < i + count; n++) {
+            if (a[n] != b[n]) {
+                printf("MISMATCH %s (%s, block schedule %d): sample %lu, block of %lu, kernel %d, reference %d\n", name,
+                       signal == input ? "signal" : "extreme", schedule, (unsigned long)n, (unsigned long)count, a[n], b[n]);
+                return false;
+            }
+        }
+        i += count;
+    }
+    return true;
+}
+
+static bool check_all(const audio_conditioning_config_t *all) {
+    struct {
+        const char *name;
+        audio_conditioning_config_t config;
+    } cases[6];
+    for (int c = 0; c < 6; c++) {
+        cases[c].config = *all;
+    }
+    cases[0].name = "all stages";
+    cases[1].name = "dc_block";
+    cases[1].config.preemphasis = cases[1].config.agc = false;
+    cases[2].name = "preemphasis";
+    cases[2].config.dc_block = cases[2].config.agc = false;
+    cases[3].name = "agc + limiter";
+    cases[3].config.dc_block = cases[3].config.preemphasis = false;
+    // 게인이 크게/빠르게 움직이는 AGC (리미터, 보간 step이 자주 걸림)
+    cases[4].name = "fast agc";
+    cases[4].config.agc_max_gain_q16 = 64 * 65536;
+    cases[4].config.agc_attack_shift = 0;
+    cases[4].config.agc_release_shift = 0;
+    cases[4].config.agc_limit = 20000;
+    // 극이 1에 가까운 DC 제거 + 큰 프리엠퍼시스 계수
+    cases[5].name = "extreme coefficients";
+    cases[5].config.dc_pole_q15 = 32767;
+    cases[5].config.preemphasis_q15 = 32767;
+
+    bool ok = true;
+    int checked = 0;
+    for (int c = 0; c < 6; c++) {
+        for (int schedule = 0; schedule < SCHEDULE_COUNT; schedule++) {
+            ok = check_reference(cases[c].name, &cases[c].config, input, schedule) && ok;
+            ok = check_reference(cases[c].name, &cases[c].config, extreme, schedule) && ok;
+            checked += 2;
+        }
+    }
+    printf("Reference (per-sample) comparison: %d runs, %s\n", checked, ok ? "bit-exact" : "MISMATCH");
+    return ok;
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 전체 신호를 BLOCK_SAMPLES씩 처리
+static void run(const audio_conditioning_config_t *config, int16_t *buffer) {
+    audio_conditioning_t state;
+    audio_conditioning_init(&state, config);
+    memcpy(buffer, input, sizeof(input));
+    for (int i = 0; i < SIGNAL_SAMPLES; i += BLOCK_SAMPLES) {
+        int count = SIGNAL_SAMPLES - i < BLOCK_SAMPLES ? SIGNAL_SAMPLES - i : BLOCK_SAMPLES;
+        audio_conditioning_process(&state, buffer + i, count);
+    }
+}
+
+static void bench(const char *name, const audio_conditioning_config_t *config) {
+    static int16_t buffer[SIGNAL_SAMPLES];
+    int iterations = 0;
+    double elapsed = 0;
+    double start = now_us();
+    while (elapsed < 500000.0) {  // 0.5초 이상 반복
+        run(config, buffer);
+        iterations++;
+        elapsed = now_us() - start;
+    }
+    // memcpy 시간 제외
+    double copy_start = now_us();
+    for (int i = 0; i < iterations; i++) {
+        memcpy(buffer, input, sizeof(input));
+    }
+    elapsed -= now_us() - copy_start;
+
+    double samples = (double)iterations * SIGNAL_SAMPLES;
+    printf("%-28s %8.1f samples/us  %7.2f us/block (%d samples)\n",
+           name, samples / elapsed, elapsed / (samples / BLOCK_SAMPLES), BLOCK_SAMPLES);
+}
+
+int main(int argc, char **argv) {
+    const char *golden = NULL;
+    const char *write_golden = NULL;
+    bool check_only = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0) {
+            check_only = true;
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden = argv[++i];
+        } else if (strcmp(argv[i], "--write-golden") == 0 && i + 1 < argc) {
+            write_golden = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--check] [--golden FILE | --write-golden FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    make_signal();
+    make_extreme();
+
+    audio_conditioning_config_t config;
+    audio_conditioning_default_config(&config);
+    config.dc_block = true;
+    config.preemphasis = true;
+    config.agc = true;
+
+    // 모든 단계를 켠 출력 (비교 기준)
+    run(&config, output);
+    uint32_t crc = crc32((const uint8_t *)output, sizeof(output));
+    bool ok = crc == GOLDEN_CRC32;
+    printf("Output CRC32 (all stages): %08X, expected %08X: %s\n", (unsigned)crc, (unsigned)GOLDEN_CRC32,
+           ok ? "match" : "MISMATCH");
+    ok = check_all(&config) && ok;
+
+    if (write_golden) {
+        FILE *f = fopen(write_golden, "wb");
+        if (!f || fwrite(output, 1, sizeof(output), f) != sizeof(output)) {
+            fprintf(stderr, "Failed to write %s\n", write_golden);
+            return 1;
+        }
+        fclose(f);
+        printf("Golden output written to %s\n", write_golden);
+    }
+    if (golden) {
+        static int16_t expected[SIGNAL_SAMPLES];
+        FILE *f = fopen(golden, "rb");
+        if (!f || fread(expected, 1, sizeof(expected), f) != sizeof(expected)) {
+            fprintf(stderr, "Failed to read %s\n", golden);
+            return 1;
+        }
+        fclose(f);
+        for (int i = 0; i < SIGNAL_SAMPLES; i++) {
+            if (expected[i] != output[i]) {
+                printf("MISMATCH at sample %d: expected %d, got %d\n", i, expected[i], output[i]);
+                return 1;
+            }
+        }
+        printf("Output matches %s bit-exactly.\n", golden);
+    }
+    if (!ok || check_only) {
+        printf("%s\n", ok ? "OK" : "FAILED");
+        return ok ? 0 : 1;
+    }
+
+    audio_conditioning_config_t stage = config;
+    stage.preemphasis = false;
+    stage.agc = false;
+    bench("dc_block", &stage);
+    stage.dc_block = false;
+    stage.preemphasis = true;
+    bench("preemphasis", &stage);
+    stage.preemphasis = false;
+    stage.agc = true;
+    bench("agc + limiter", &stage);
+    bench("all stages", &config);
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,343 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_config.h"
+#include "audio_frontend.h"
+#include "dsp_tables.h"
+#include "fft_q15.h"
+#include "frontend_simd.h"
+
+// 특징 추출 커널 (창, FFT, 파워 스펙트럼, mel 필터뱅크)의 ISA별 확인과 벤치마크 (host/frontend_simd.c)
+// 1. 비트 단위 확인: 이 CPU가 지원하는 ISA마다 portable(장치와 같은 C)과 결과가 같은지
+//    - 커널별 무작위 입력 (int16 전체 범위, -32768 포함. FFT는 2^3 ~ 2^12 크기)
+//    - audio_frontend_analyze + audio_frontend_mel 전체: 무음, 작은 잡음, 사인파 섞은 신호, 클리핑된 사각파,
+//      전체 범위 무작위를 번갈아 이어 붙인 hop
+// 2. 벤치마크: 커널별/ISA별 frames/s (프레임 = FRONTEND_FFT_SIZE 샘플 분석 한 번)와 portable 대비 배수
+//    portable도 호스트 컴파일러의 자동 벡터화(SSE2)는 받음. fft는 입력 복사 포함
+//
+//   ./bench_frontend             # 다르면 1 반환
+//   ./bench_frontend --ms 50     # 측정 하나당 시간 (기본 200ms)
+//   ./bench_frontend --hops N    # 전체 경로 확인 hop 수 (기본 5000)
+
+#define FFT_MAX_LOG2 12
+#define FFT_MAX_SIZE (1 << FFT_MAX_LOG2)
+#define KERNEL_TRIALS 2000
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// -32768 ~ 32767 (양 끝 값이 자주 나오도록 1/16은 끝 값)
+static int16_t random_sample(void) {
+    uint32_t r = rng();
+    if ((r & 15) == 0) {
+        return (r & 16) ? 32767 : -32768;
+    }
+    return (int16_t)(r >> 16);
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// dsp_tables.h의 트위들과 같은 규칙 (-sin(π/2) = -32768 포함)
+static void make_twiddle(int16_t *twiddle, int log2n) {
+    const int n = 1 << log2n;
+    for (int k = 0; k < n / 2; k++) {
+        double c = round(cos(2.0 * M_PI * k / n) * 32768.0), s = round(-sin(2.0 * M_PI * k / n) * 32768.0);
+        twiddle[2 * k] = (int16_t)(c > 32767 ? 32767 : c);
+        twiddle[2 * k + 1] = (int16_t)(s > 32767 ? 32767 : s);
+    }
+}
+
+// ---- 1. 비트 단위 확인 ----
+
+static bool check_kernels(const audio_frontend_kernels_t *ref, const audio_frontend_kernels_t *k) {
+    static int16_t samples[FFT_MAX_SIZE], window[FFT_MAX_SIZE];
+    static int16_t a[2 * FFT_MAX_SIZE], b[2 * FFT_MAX_SIZE];
+    static int16_t twiddle[FFT_MAX_SIZE];
+    static uint32_t power_a[FFT_MAX_SIZE], power_b[FFT_MAX_SIZE];
+    uint64_t energy_a[FRONTEND_MEL_BINS], energy_b[FRONTEND_MEL_BINS];
+
+    for (int trial = 0; trial < KERNEL_TRIALS; trial++) {
+        int count = 1 + (int)(rng() % FRONTEND_FFT_SIZE);
+        for (int i = 0; i < count; i++) {
+            samples[i] = random_sample();
+            window[i] = (int16_t)(rng() & 0x7FFF);
+        }
+        if (ref->peak(samples, count) != k->peak(samples, count)) {
+            printf("%s peak: mismatch (trial %d, %d samples)\n", k->name, trial, count);
+            return false;
+        }
+
+        // shift > 0이면 (샘플 << shift)가 int16에 들어감 (analyze가 고르는 범위)
+        int shift = (int)(rng() % 15);
+        for (int i = 0; i < count && shift > 0; i++) {
+            samples[i] = (int16_t)(samples[i] >> shift);
+        }
+        const int16_t *w = (trial & 1) ? window : dsp_window.q15;
+        ref->window(a, samples, w, count, shift);
+        k->window(b, samples, w, count, shift);
+        if (memcmp(a, b, 2 * count * sizeof(int16_t)) != 0) {
+            printf("%s window: mismatch (trial %d, %d samples, shift %d)\n", k->name, trial, count, shift);
+            return false;
+        }
+
+        int log2n = 3 + (int)(rng() % (FFT_MAX_LOG2 - 2));
+        int n = 1 << log2n;
+        make_twiddle(twiddle, log2n);
+        for (int i = 0; i < 2 * n; i++) {
+            a[i] = (trial & 2) ? random_sample() : (int16_t)((int16_t)rng() >> (rng() % 15));
+        }
+        memcpy(b, a, 2 * n * sizeof(int16_t));
+        int shift_a = ref->fft(a, log2n, twiddle);
+        int shift_b = k->fft(b, log2n, twiddle);
+        if (shift_a != shift_b || memcmp(a, b, 2 * n * sizeof(int16_t)) != 0) {
+            printf("%s fft: mismatch (trial %d, N=%d)\n", k->name, trial, n);
+            return false;
+        }
+
+        for (int i = 0; i < 2 * FRONTEND_FFT_SIZE; i++) {
+            a[i] = random_sample();
+        }
+        int bins = 1 + (int)(rng() % FRONTEND_FFT_SIZE);
+        ref->power(a, power_a, bins);
+        k->power(a, power_b, bins);
+        if (memcmp(power_a, power_b, bins * sizeof(uint32_t)) != 0) {
+            printf("%s power: mismatch (trial %d, %d bins)\n", k->name, trial, bins);
+            return false;
+        }
+        ref->mel(a, energy_a);
+        k->mel(a, energy_b);
+        if (memcmp(energy_a, energy_b, sizeof(energy_a)) != 0) {
+            printf("%s mel: mismatch (trial %d)\n", k->name, trial);
+            return false;
+        }
+    }
+    return true;
+}
+
+// 시험 신호 hop: 64 hop마다 종류를 바꿈
+static void make_hop(int16_t *hop, int index) {
+    static double phase = 0;
+    const int kind = (index / 64) % 5;
+    for (int i = 0; i < FRONTEND_HOP; i++) {
+        double t = (double)(index * FRONTEND_HOP + i) / MODEL_SAMPLE_RATE;
+        int32_t v = 0;
+        switch (kind) {
+        case 0:  // 무음
+            break;
+        case 1:  // 작은 잡음 (-70dBFS 정도)
+            v = (int32_t)(rng() % 21) - 10;
+            break;
+        case 2:  // 음성 비슷하게: 기본음 + 배음 + 잡음, 느린 진폭 변화
+            phase += 2 * M_PI * (140 + 30 * sin(2 * M_PI * 3 * t)) / MODEL_SAMPLE_RATE;
+            v = (int32_t)((4000 + 3000 * sin(2 * M_PI * 4 * t)) *
+                          (sin(phase) + 0.5 * sin(2 * phase) + 0.3 * sin(5 * phase))) +
+                (int32_t)(rng() % 401) - 200;
+            break;
+        case 3:  // 클리핑된 사각파 (양 끝 값)
+            v = sin(2 * M_PI * 440 * t) >= 0 ? 32767 : -32768;
+            break;
+        default:  // 전체 범위 무작위
+            v = random_sample();
+            break;
+        }
+        hop[i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+}
+
+static bool check_frontend(const audio_frontend_kernels_t *k, int hops) {
+    static audio_frontend_t ref, test;
+    int16_t hop[FRONTEND_HOP];
+    int32_t mel_ref[FRONTEND_MEL_BINS], mel_test[FRONTEND_MEL_BINS];
+    audio_frontend_init(&ref);
+    audio_frontend_init(&test);
+    bool ok = true;
+    for (int h = 0; h < hops && ok; h++) {
+        make_hop(hop, h);
+        audio_frontend_set_kernels(NULL);
+        audio_frontend_analyze(&ref, hop);
+        audio_frontend_mel(&ref, mel_ref);
+        audio_frontend_set_kernels(k);
+        audio_frontend_analyze(&test, hop);
+        audio_frontend_mel(&test, mel_test);
+        if (ref.exponent != test.exponent || memcmp(ref.spectrum, test.spectrum, sizeof(ref.spectrum)) != 0 ||
+            memcmp(ref.log_power, test.log_power, sizeof(ref.log_power)) != 0 ||
+            memcmp(mel_ref, mel_test, sizeof(mel_ref)) != 0) {
+            printf("%s analyze/mel: mismatch at hop %d\n", k->name, h);
+            ok = false;
+        }
+    }
+    audio_frontend_set_kernels(NULL);
+    return ok;
+}
+
+// ---- 2. 벤치마크 ----
+
+enum {
+    BENCH_PEAK,
+    BENCH_WINDOW,
+    BENCH_FFT,
+    BENCH_POWER,
+    BENCH_MEL,
+    BENCH_ANALYZE,
+    BENCH_ANALYZE_MEL,
+    BENCH_COUNT,
+};
+
+static const char *const bench_names[BENCH_COUNT] = {"peak", "window", "fft", "power", "mel", "analyze", "analyze+mel"};
+
+#define BENCH_HOPS 64
+
+static int16_t bench_hops[BENCH_HOPS][FRONTEND_HOP];
+static int16_t bench_frame[FRONTEND_FFT_SIZE];
+static int16_t bench_windowed[2 * FRONTEND_FFT_SIZE];
+static int16_t bench_spectrum[2 * FRONTEND_FFT_SIZE];
+
+static void bench_prepare(void) {
+    for (int h = 0; h < BENCH_HOPS; h++) {
+        make_hop(bench_hops[h], 2 * 64 + h);  // 음성 비슷한 신호
+    }
+    memcpy(bench_frame, bench_hops[0], sizeof(bench_hops[0]));
+    memcpy(bench_frame + FRONTEND_HOP, bench_hops[1], sizeof(bench_hops[1]));
+    audio_frontend_portable_kernels.window(bench_windowed, bench_frame, dsp_window.q15, FRONTEND_FFT_SIZE, 1);
+    memcpy(bench_spectrum, bench_windowed, sizeof(bench_spectrum));
+    audio_frontend_portable_kernels.fft(bench_spectrum, FRONTEND_FFT_LOG2, dsp_twiddle.q15);
+}
+
+static void bench_once(int bench, const audio_frontend_kernels_t *k, audio_frontend_t *fe, int frame,
+                       volatile uint32_t *sink) {
+    static int16_t spectrum[2 * FRONTEND_FFT_SIZE];
+    static uint32_t power[FRONTEND_BINS];
+    uint64_t energy[FRONTEND_MEL_BINS];
+    int32_t mel[FRONTEND_MEL_BINS];
+    switch (bench) {
+    case BENCH_PEAK:
+        *sink += k->peak(bench_frame, FRONTEND_FFT_SIZE);
+        break;
+    case BENCH_WINDOW:
+        k->window(spectrum, bench_frame, dsp_window.q15, FRONTEND_FFT_SIZE, frame & 1);
+        *sink += (uint16_t)spectrum[2 * (frame & 15)];
+        break;
+    case BENCH_FFT:
+        memcpy(spectrum, bench_windowed, sizeof(spectrum));
+        *sink += (uint32_t)k->fft(spectrum, FRONTEND_FFT_LOG2, dsp_twiddle.q15);
+        break;
+    case BENCH_POWER:
+        k->power(bench_spectrum, power, FRONTEND_BINS);
+        *sink += power[frame & 15];
+        break;
+    case BENCH_MEL:
+        k->mel(bench_spectrum, energy);
+        *sink += (uint32_t)energy[frame % FRONTEND_MEL_BINS];
+        break;
+    case BENCH_ANALYZE:
+        audio_frontend_analyze(fe, bench_hops[frame % BENCH_HOPS]);
+        *sink += (uint32_t)fe->log_power[frame & 15];
+        break;
+    default:
+        audio_frontend_analyze(fe, bench_hops[frame % BENCH_HOPS]);
+        audio_frontend_mel(fe, mel);
+        *sink += (uint32_t)mel[frame % FRONTEND_MEL_BINS];
+        break;
+    }
+}
+
+static double bench_frames_per_second(int bench, const audio_frontend_kernels_t *k, double ms) {
+    static audio_frontend_t fe;
+    volatile uint32_t sink = 0;
+    audio_frontend_init(&fe);
+    audio_frontend_set_kernels(k);
+    long frames = 0;
+    double start = now_us(), elapsed = 0;
+    while (elapsed < ms * 1000.0) {
+        for (int i = 0; i < 100; i++) {
+            bench_once(bench, k, &fe, (int)frames + i, &sink);
+        }
+        frames += 100;
+        elapsed = now_us() - start;
+    }
+    audio_frontend_set_kernels(NULL);
+    return frames * 1e6 / elapsed;
+}
+
+static int usage(const char *program) {
+    fprintf(stderr, "usage: %s [--ms N] [--hops N]\n", program);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    double ms = 200;
+    int hops = 5000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ms") == 0 && i + 1 < argc) {
+            ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--hops") == 0 && i + 1 < argc) {
+            hops = atoi(argv[++i]);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    const audio_frontend_kernels_t *kernels[FRONTEND_ISA_COUNT];
+    printf("FFT %d points, %d mel bins, ISA:", FRONTEND_FFT_SIZE, FRONTEND_MEL_BINS);
+    for (int isa = 0; isa < FRONTEND_ISA_COUNT; isa++) {
+        kernels[isa] = frontend_simd_kernels((frontend_isa_t)isa);
+        printf(" %s%s", frontend_isa_name((frontend_isa_t)isa), kernels[isa] ? "" : " (not supported)");
+    }
+    printf("\n");
+
+    // 1. 비트 단위 확인
+    bool ok = true;
+    for (int isa = 1; isa < FRONTEND_ISA_COUNT; isa++) {
+        if (!kernels[isa]) {
+            continue;
+        }
+        bool same = check_kernels(kernels[0], kernels[isa]) && check_frontend(kernels[isa], hops);
+        printf("%-8s bit-exact with portable: %s (%d kernel trials, %d hops)\n", kernels[isa]->name,
+               same ? "yes" : "NO", KERNEL_TRIALS, hops);
+        ok = ok && same;
+    }
+
+    // 2. 벤치마크
+    bench_prepare();
+    printf("\n%-12s", "frames/s");
+    for (int isa = 0; isa < FRONTEND_ISA_COUNT; isa++) {
+        printf(" %22s", frontend_isa_name((frontend_isa_t)isa));
+    }
+    printf("\n");
+    for (int bench = 0; bench < BENCH_COUNT; bench++) {
+        printf("%-12s", bench_names[bench]);
+        double base = 0;
+        for (int isa = 0; isa < FRONTEND_ISA_COUNT; isa++) {
+            if (!kernels[isa]) {
+                printf(" %22s", "-");
+                continue;
+            }
+            double fps = bench_frames_per_second(bench, kernels[isa], ms);
+            if (isa == 0) {
+                base = fps;
+                printf(" %22.0f", fps);
+            } else {
+                printf(" %14.0f (x%5.2f)", fps, fps / base);
+            }
+        }
+        printf("\n");
+    }
+    printf("realtime: %.0f frames/s (%d Hz, hop %d)\n", (double)MODEL_SAMPLE_RATE / FRONTEND_HOP, MODEL_SAMPLE_RATE,
+           FRONTEND_HOP);
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "pcm_convert.h"
+
+// pcm_convert.c 벤치마크: 32비트 슬롯 DMA 버퍼 하나를 int16으로 바꾸는 시간과 작은 소리의 정밀도
+//
+//   ./bench_pcm_convert
+//
+// 비교 대상: 같은 게인(MIC_32BIT_MIN_SHIFT)에서 샘플마다 포화시키는 단순 변환 (큰 소리는 클리핑됨)
+// PC는 SIMD로 자동 벡터화되므로 ESP32에서의 상대 비용과는 다를 수 있음
+
+#define SAMPLE_RATE 16000
+#define MAX_SAMPLES 2048
+
+// DMA 버퍼 크기 (샘플 수): wake_word.cpp 모노/스테레오, microphone.c
+static const struct {
+    const char *name;
+    size_t samples;
+} buffers[] = {
+    {"wake_word mono (512)", 512},
+    {"wake_word stereo (2x512)", 1024},
+    {"microphone.c (2000)", 2000},
+};
+
+static int32_t input[MAX_SAMPLES];
+static int16_t output[MAX_SAMPLES];
+
+static void naive_convert(const int32_t *in, int16_t *out, size_t count, int shift) {
+    for (size_t i = 0; i < count; i++) {
+        int32_t v = in[i] >> shift;
+        if (v > 32767) {
+            v = 32767;
+        } else if (v < -32768) {
+            v = -32768;
+        }
+        out[i] = (int16_t)v;
+    }
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 24비트 샘플(32비트 슬롯 왼쪽 정렬)로 된 사인파, amplitude는 dBFS
+static void make_sine(int32_t *x, size_t count, double dbfs) {
+    double amplitude = pow(10.0, dbfs / 20.0) * 8388607.0;
+    for (size_t i = 0; i < count; i++) {
+        int32_t v = (int32_t)lrint(amplitude * sin(2 * M_PI * 440 * i / SAMPLE_RATE));
+        x[i] = v * 256;
+    }
+}
+
+// 변환 결과를 24비트 원래 값과 비교한 SNR (shift만큼 되돌려서)
+static double conversion_snr(const int32_t *x, const int16_t *y, size_t count, int shift) {
+    double signal = 0, error = 0;
+    for (size_t i = 0; i < count; i++) {
+        double original = x[i] / 256.0;
+        double restored = (double)y[i] * (1 << shift) / 256.0;
+        signal += original * original;
+        error += (original - restored) * (original - restored);
+    }
+    return error > 0 ? 10 * log10(signal / error) : 999.0;
+}
+
+int main(void) {
+    // 1. 처리 시간 (큰 소리/작은 소리 섞어서)
+    printf("%-26s %12s %12s %14s\n", "DMA buffer", "block (us)", "naive (us)", "ns/sample");
+    for (size_t b = 0; b < sizeof(buffers) / sizeof(buffers[0]); b++) {
+        size_t count = buffers[b].samples;
+        make_sine(input, count, -20);
+
+        volatile int sink = 0;
+        int iterations = 0;
+        double start = now_us(), elapsed = 0;
+        while (elapsed < 200000.0) {
+            for (int k = 0; k < 100; k++) {
+                input[k & 7] ^= k;  // 컴파일러가 반복을 없애지 않도록
+                sink += pcm_convert_s32_block(input, output, count, MIC_32BIT_MIN_SHIFT);
+            }
+            iterations += 100;
+            elapsed = now_us() - start;
+        }
+        double block_us = elapsed / iterations;
+
+        iterations = 0;
+        start = now_us();
+        elapsed = 0;
+        while (elapsed < 200000.0) {
+            for (int k = 0; k < 100; k++) {
+                input[k & 7] ^= k;
+                naive_convert(input, output, count, MIC_32BIT_MIN_SHIFT);
+                sink += output[k & 7];
+            }
+            iterations += 100;
+            elapsed = now_us() - start;
+        }
+        double naive_us = elapsed / iterations;
+        printf("%-26s %12.3f %12.3f %14.3f\n", buffers[b].name, block_us, naive_us, block_us * 1000 / count);
+    }
+
+    // 2. 레벨별 정밀도: 16비트 슬롯(상위 16비트만)과 블록 부동소수점 변환 비교
+    printf("\n%10s %18s %18s %8s\n", "level", "16-bit slot SNR", "block FP SNR", "shift");
+    static const double levels[] = {-90, -70, -50, -30, -10, -1};
+    for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        make_sine(input, 1024, levels[l]);
+        naive_convert(input, output, 1024, 16);
+        double truncated = conversion_snr(input, output, 1024, 16);
+        int shift = pcm_convert_s32_block(input, output, 1024, MIC_32BIT_MIN_SHIFT);
+        double block = conversion_snr(input, output, 1024, shift);
+        printf("%6.0f dBFS %15.1f dB %15.1f dB %8d\n", levels[l], truncated, block, shift);
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_config.h"
+#include "audio_frontend.h"
+#include "model_scheduler.h"
+#include "boot_profile.h"
+
+// 모델 스케줄러 확인 (호스트): 실행 시간이 정해진 가짜 모델로 wake_word.cpp 추론 태스크의 주기를 실시간으로 재현
+// - 캡처 블록(32ms)마다 한 주기: 특징 추출(external) → 호출어(100ms마다, external) → model_scheduler_cycle
+// - 가짜 소리 이벤트 모델은 정해진 시간(±20%)만큼 CPU를 씀
+// - --load로 이벤트 모델 시간을 늘리면 예산이 빠듯해지면서 우선순위 낮은 모델부터 미뤄지는 것을 볼 수 있습니다.
+// 끝에 model_scheduler_report() (장치의 SCHED_REPORT와 같은 형식)
+//
+//   ./bench_scheduler [--seconds 10] [--load 1.0] [--budget-percent 60] [--max-defer 8]
+
+#define CAPTURE_BLOCK_SAMPLES 512  // wake_word.cpp와 같은 값
+#define MODEL_BLOCK_SAMPLES (CAPTURE_BLOCK_SAMPLES / MODEL_DECIMATION)
+#define BLOCK_US ((int64_t)MODEL_BLOCK_SAMPLES * 1000000 / MODEL_SAMPLE_RATE)
+#define BLOCK_FRAMES (MODEL_BLOCK_SAMPLES / FRONTEND_HOP)
+#define FRAME_MS (FRONTEND_HOP * 1000 / MODEL_SAMPLE_RATE)
+#define WAKE_WORD_HOP_MS 100
+#define WAKE_WORD_US 9000   // ESP32-S3 호출어 Invoke 정도
+#define FRONTEND_US 1200    // 캡처 블록 처리 (다른 태스크지만 같은 코어로 가정)
+
+typedef struct {
+    const char *name;
+    uint32_t hop_ms;
+    uint8_t priority;
+    uint32_t cost_us;
+} fake_model_t;
+
+static const fake_model_t fake_models[] = {
+    {"smoke_alarm", 500, 0, 3000},   // 절대 미루지 않음
+    {"glass_break", 250, 1, 5000},
+    {"door_chime", 200, 2, 4000},
+    {"water_leak", 1000, 3, 8000},
+};
+#define FAKE_MODEL_COUNT (sizeof(fake_models) / sizeof(fake_models[0]))
+
+static double load = 1.0;
+
+static void spin_us(uint32_t us) {
+    int64_t end = boot_profile_now_us() + us;
+    while (boot_profile_now_us() < end) {
+    }
+}
+
+static uint32_t jitter(uint32_t us) {
+    return (uint32_t)(us * (0.8 + 0.4 * rand() / (double)RAND_MAX));
+}
+
+static bool run_fake(void *user, uint32_t frame) {
+    (void)frame;
+    const fake_model_t *m = (const fake_model_t *)user;
+    spin_us(jitter((uint32_t)(m->cost_us * load)));
+    return true;
+}
+
+static void sleep_until(int64_t deadline_us) {
+    int64_t wait = deadline_us - boot_profile_now_us();
+    if (wait > 0) {
+        struct timespec ts = {(time_t)(wait / 1000000), (long)(wait % 1000000) * 1000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+int main(int argc, char **argv) {
+    double seconds = 10.0;
+    int budget_percent = 60;
+    int max_defer = 8;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc) {
+            load = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--budget-percent") == 0 && i + 1 < argc) {
+            budget_percent = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-defer") == 0 && i + 1 < argc) {
+            max_defer = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--load X] [--budget-percent P] [--max-defer N]\n", argv[0]);
+            return 2;
+        }
+    }
+    srand(1);
+
+    static model_scheduler_t scheduler;
+    uint32_t budget_us = (uint32_t)(BLOCK_US * budget_percent / 100);
+    model_scheduler_init(&scheduler, budget_us, (uint8_t)max_defer);
+    int wake_word = model_scheduler_add_external(&scheduler, "wake_word");
+    int frontend = model_scheduler_add_external(&scheduler, "frontend");
+    for (size_t m = 0; m < FAKE_MODEL_COUNT; m++) {
+        model_scheduler_add(&scheduler, fake_models[m].name, fake_models[m].hop_ms / FRAME_MS, fake_models[m].priority,
+                            0, run_fake, (void *)&fake_models[m]);
+    }
+    printf("Block %lld us, budget %u us (%d%%), event model load x%.2f, %.0f s\n", (long long)BLOCK_US,
+           (unsigned)budget_us, budget_percent, load, seconds);
+
+    const uint32_t cycles = (uint32_t)(seconds * 1e6 / BLOCK_US);
+    const uint32_t wake_hop_blocks = (WAKE_WORD_HOP_MS * 1000 + BLOCK_US - 1) / BLOCK_US;
+    uint32_t frame = 0;
+    uint32_t late_blocks = 0;
+    int64_t deadline = boot_profile_now_us();
+    for (uint32_t c = 0; c < cycles; c++) {
+        deadline += BLOCK_US;
+
+        // 캡처 태스크: 블록 처리 → 특징 프레임
+        uint32_t cost = jitter(FRONTEND_US);
+        spin_us(cost);
+        model_scheduler_account(&scheduler, frontend, cost);
+        frame += BLOCK_FRAMES;
+
+        // 추론 태스크: 호출어 (INFERENCE_HOP_MS마다) → 남은 예산으로 이벤트 모델
+        uint32_t used = 0;
+        if (c % wake_hop_blocks == 0) {
+            used = jitter(WAKE_WORD_US);
+            spin_us(used);
+            model_scheduler_account(&scheduler, wake_word, used);
+        }
+        if (boot_profile_now_us() > deadline) {
+            used = budget_us;  // 다음 블록이 이미 들어옴
+        }
+        model_scheduler_cycle(&scheduler, frame, used);
+
+        if (boot_profile_now_us() > deadline) {
+            late_blocks++;  // 장치라면 캡처 태스크가 블록을 기다리게 됨 (링 버퍼 여유로 흡수)
+        }
+        sleep_until(deadline);
+    }
+    model_scheduler_report(&scheduler);
+    printf("Blocks finished after the next block arrived: %u of %u\n", (unsigned)late_blocks, (unsigned)cycles);
+    return 0;
+}
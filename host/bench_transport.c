@@ -0,0 +1,384 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "audio_config.h"
+#include "audio_ring.h"
+#include "audio_transport.h"
+#include "transport_socket.h"
+
+// 전송 확인 (호스트): audio_transport + transport_socket(장치와 같은 코드)으로 루프백의 받는 프로세스(fork)에 보내서
+// 처리량, 끝-끝 지연(링 버퍼에 블록을 쓴 시각 → 받는 프로세스가 그 블록의 샘플을 받은 시각), 버린 샘플을 확인
+// - 실시간: 512샘플 블록을 32ms마다 쓰고 블록마다 poll (캡처 태스크와 같음). flush 40ms(기본)와 0ms 비교
+// - 최대 처리량: 밀린 샘플이 backlog 절반보다 적을 때만 블록을 씀 (버리지 않는 최대 속도)
+// - 느린 받는 쪽 (TCP): 받는 쪽이 패킷마다 쉬어서 백프레셔 → 오래된 샘플을 버림.
+//   받는 쪽이 본 구멍(position이 건너뛴 샘플 수) = 패킷 헤더의 누적 dropped = 보낸 쪽 통계인지
+// 모든 경우에 받은 샘플이 링 위치로 만든 패턴과 같은지(링 끝을 넘는 두 조각 포함), 패킷/이벤트 순서가 맞는지 확인
+// TCP 송신 버퍼는 장치(lwIP TCP_SND_BUF)와 비슷하게 작게 잡음
+//
+//   ./bench_transport [--seconds 2]
+//
+// 기준을 만족하지 못하면 FAILED를 출력하고 1을 반환합니다.
+
+#define CAPTURE_BLOCK_SAMPLES 512  // wake_word.cpp와 같은 값
+#define BLOCK_US ((uint64_t)CAPTURE_BLOCK_SAMPLES * 1000000 / MODEL_SAMPLE_RATE)
+#define RING_SAMPLES 32768         // 장치 링 버퍼 (모델 창 + 프리롤 + 여유를 2의 거듭제곱으로)
+#define SOCKET_SNDBUF 5760         // lwIP TCP_SND_BUF 기본값 정도
+#define MAX_BLOCKS (1u << 22)
+#define MAX_LATENCIES (1u << 20)
+#define SLOW_READER_US 500         // 느린 받는 쪽: 패킷마다 쉬는 시간
+
+typedef struct {
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t samples;
+    uint64_t bad_samples;      // 패턴과 다른 샘플
+    uint64_t gap_samples;      // position이 건너뛴 샘플
+    uint64_t lost_packets;     // sequence가 건너뛴 패킷 (UDP)
+    uint64_t order_errors;     // 시작/끝 이벤트 순서, 뒤로 간 position
+    uint32_t header_dropped;   // 마지막 패킷 헤더의 누적 dropped_samples
+    int got_start;
+    int got_end;
+    uint64_t first_us;
+    uint64_t last_us;
+    uint32_t latencies;
+    float latency_us[MAX_LATENCIES];
+} receiver_result_t;
+
+typedef struct {
+    const char *name;
+    int udp;
+    int mode;                  // MODE_*
+    uint32_t flush_ms;
+} bench_case_t;
+
+enum { MODE_REALTIME, MODE_THROUGHPUT, MODE_SLOW_READER };
+
+static uint64_t *write_us;     // 블록을 링 버퍼에 쓴 시각 (받는 프로세스와 공유)
+static receiver_result_t *result;
+static int failures;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static int16_t pattern(uint32_t position) {
+    return (int16_t)((position * 2654435761u) >> 16);
+}
+
+static void check(int ok, const char *what) {
+    if (!ok) {
+        printf("  FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+// TCP 스트림에서 정확히 size 바이트
+static int read_exact(int fd, void *data, size_t size) {
+    uint8_t *p = (uint8_t *)data;
+    while (size > 0) {
+        ssize_t n = recv(fd, p, size, 0);
+        if (n <= 0) {
+            return 0;
+        }
+        p += n;
+        size -= (size_t)n;
+    }
+    return 1;
+}
+
+// 패킷 하나 처리 (받는 프로세스). 끝 이벤트면 0
+static int receive_packet(const audio_transport_header_t *h, const uint8_t *payload, uint32_t *expected_position,
+                          uint32_t *expected_sequence) {
+    uint64_t now = now_us();
+    if (h->magic != AUDIO_TRANSPORT_MAGIC || h->version != AUDIO_TRANSPORT_VERSION) {
+        result->order_errors++;
+        return 1;
+    }
+    if (result->packets == 0) {
+        result->first_us = now;
+    }
+    result->last_us = now;
+    result->packets++;
+    result->bytes += sizeof(*h) + h->payload_size;
+    if (h->sequence != *expected_sequence) {
+        result->lost_packets += h->sequence - *expected_sequence;
+    }
+    *expected_sequence = h->sequence + 1;
+    result->header_dropped = h->dropped_samples;
+
+    if (h->type == AUDIO_TRANSPORT_EVENT) {
+        if (h->payload_size == 5 && memcmp(payload, "START", 5) == 0) {
+            result->got_start = 1;
+            *expected_position = h->position;
+        } else if (h->payload_size == 3 && memcmp(payload, "END", 3) == 0) {
+            // 끝 이벤트는 마지막 오디오 뒤에
+            if (h->position != *expected_position) {
+                result->gap_samples += h->position - *expected_position;
+            }
+            result->got_end = 1;
+            return 0;
+        }
+        return 1;
+    }
+    if (!result->got_start || (int32_t)(h->position - *expected_position) < 0) {
+        result->order_errors++;
+        return 1;
+    }
+    result->gap_samples += h->position - *expected_position;
+    size_t count = h->payload_size / sizeof(int16_t);
+    const int16_t *samples = (const int16_t *)payload;
+    for (size_t i = 0; i < count; i++) {
+        if (samples[i] != pattern(h->position + (uint32_t)i)) {
+            result->bad_samples++;
+        }
+    }
+    result->samples += count;
+    *expected_position = h->position + (uint32_t)count;
+
+    // 이 패킷의 첫 샘플(가장 오래 기다린 샘플)이 들어있던 블록을 쓴 시각부터 (묶느라 기다린 시간 포함)
+    uint32_t block = h->position / CAPTURE_BLOCK_SAMPLES;
+    if (count > 0 && block < MAX_BLOCKS && write_us[block] != 0 && result->latencies < MAX_LATENCIES) {
+        result->latency_us[result->latencies++] = (float)(now - write_us[block]);
+    }
+    return 1;
+}
+
+static void receiver(int fd, int udp, int slow) {
+    uint8_t buffer[TRANSPORT_SOCKET_MTU + 64];
+    uint32_t expected_position = 0;
+    uint32_t expected_sequence = 0;
+    struct timeval timeout = {2, 0};  // UDP: 끝 이벤트를 잃었으면
+    if (!udp) {
+        fd = accept(fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+    }
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    while (1) {
+        audio_transport_header_t h;
+        const uint8_t *payload = buffer;
+        if (udp) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n < (ssize_t)sizeof(h)) {
+                return;
+            }
+            memcpy(&h, buffer, sizeof(h));
+            payload = buffer + sizeof(h);
+            if ((size_t)n != sizeof(h) + h.payload_size) {
+                result->order_errors++;
+                continue;
+            }
+        } else {
+            if (!read_exact(fd, &h, sizeof(h)) || h.payload_size > sizeof(buffer) ||
+                !read_exact(fd, buffer, h.payload_size)) {
+                return;
+            }
+        }
+        if (!receive_packet(&h, payload, &expected_position, &expected_sequence)) {
+            return;
+        }
+        if (slow) {
+            usleep(SLOW_READER_US);
+        }
+    }
+}
+
+static int compare_float(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static float percentile(float *values, uint32_t count, double p) {
+    if (count == 0) {
+        return 0.0f;
+    }
+    size_t i = (size_t)(p * (count - 1) + 0.5);
+    return values[i];
+}
+
+static void run_case(const bench_case_t *c, double seconds, audio_ring_t *ring) {
+    // 받는 쪽 소켓을 먼저 열고 (임시 포트) fork
+    int fd = socket(AF_INET, c->udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || (!c->udp && listen(fd, 1) != 0) ||
+        getsockname(fd, (struct sockaddr *)&address, &length) != 0) {
+        printf("%-22s socket setup failed: %s\n", c->name, strerror(errno));
+        failures++;
+        close(fd);
+        return;
+    }
+    memset(write_us, 0, sizeof(uint64_t) * MAX_BLOCKS);
+    memset(result, 0, sizeof(*result));
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0) {
+        receiver(fd, c->udp, c->mode == MODE_SLOW_READER);
+        _exit(0);
+    }
+    close(fd);
+
+    transport_socket_t sock;
+    char host[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &address.sin_addr, host, sizeof(host));
+    transport_socket_init(&sock, host, ntohs(address.sin_port), c->udp);
+    uint64_t deadline = now_us() + 1000000;
+    while (!transport_socket_ready(&sock) && now_us() < deadline) {
+        usleep(1000);
+    }
+    if (!c->udp && sock.fd >= 0) {
+        int size = SOCKET_SNDBUF;
+        setsockopt(sock.fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    }
+    audio_transport_backend_t backend;
+    transport_socket_backend(&sock, &backend);
+    audio_ring_reset(ring);
+    audio_transport_t t;
+    audio_transport_init(&t, &backend, ring, (uint32_t)ring->capacity - CAPTURE_BLOCK_SAMPLES, c->flush_ms * 1000);
+    audio_transport_start(&t, 0, "START");
+
+    // 블록 쓰기 + poll (캡처 태스크 흉내)
+    int16_t block[CAPTURE_BLOCK_SAMPLES];
+    uint64_t start = now_us();
+    uint64_t end = start + (uint64_t)(seconds * 1e6);
+    uint64_t poll_us = 0;
+    uint32_t polls = 0;
+    uint32_t blocks = 0;
+    while (blocks < MAX_BLOCKS) {
+        uint64_t now = now_us();
+        if (now >= end) {
+            break;
+        }
+        int write_block = 1;
+        if (c->mode == MODE_REALTIME) {
+            uint64_t due = start + blocks * BLOCK_US;
+            if (now < due) {
+                usleep((useconds_t)(due - now));
+            }
+        } else if (c->mode == MODE_THROUGHPUT) {
+            write_block = ring->written - t.position < t.backlog / 2;
+        } else if (blocks % 16 == 0) {
+            usleep(1000);  // 블록 16개(8192샘플)/ms: 받는 쪽보다 빠르게
+        }
+        if (write_block) {
+            uint32_t position = ring->written;
+            for (size_t i = 0; i < CAPTURE_BLOCK_SAMPLES; i++) {
+                block[i] = pattern(position + (uint32_t)i);
+            }
+            audio_ring_write(ring, block, CAPTURE_BLOCK_SAMPLES);
+            write_us[blocks++] = now_us();
+        }
+        uint64_t poll_start = now_us();
+        audio_transport_poll(&t, (uint32_t)poll_start, false);
+        poll_us += now_us() - poll_start;
+        polls++;
+    }
+
+    // 끝: 남은 것을 다 보내고 끝 이벤트
+    audio_transport_stop(&t, ring->written, "END");
+    deadline = now_us() + 5000000;
+    while (audio_transport_streaming(&t) && now_us() < deadline) {
+        if (audio_transport_poll(&t, (uint32_t)now_us(), true) == 0) {
+            usleep(100);
+        }
+    }
+    int status = 0;
+    if (waitpid(child, &status, 0) != child) {
+        kill(child, SIGKILL);
+    }
+    transport_socket_close(&sock);
+
+    double elapsed = (result->last_us - result->first_us) / 1e6;
+    double mbps = elapsed > 0 ? result->bytes / elapsed / 1e6 : 0.0;
+    double realtime = elapsed > 0 ? result->samples / elapsed / MODEL_SAMPLE_RATE : 0.0;
+    qsort(result->latency_us, result->latencies, sizeof(float), compare_float);
+    printf("%-22s %7llu pkts %5.0f B  %8.3f MB/s (x%-5.0f) latency p50 %6.2f p99 %6.2f max %6.2f ms  "
+           "dropped %llu, lost %llu, busy %lu, poll %.1f us\n",
+           c->name, (unsigned long long)result->packets,
+           result->packets ? (double)result->bytes / result->packets : 0.0, mbps, realtime,
+           percentile(result->latency_us, result->latencies, 0.5) / 1000.0,
+           percentile(result->latency_us, result->latencies, 0.99) / 1000.0,
+           percentile(result->latency_us, result->latencies, 1.0) / 1000.0,
+           (unsigned long long)t.stats.dropped_samples,
+           (unsigned long long)(result->gap_samples > t.stats.dropped_samples ? result->gap_samples - t.stats.dropped_samples : 0),
+           (unsigned long)t.stats.busy, polls ? (double)poll_us / polls : 0.0);
+
+    check(result->got_start && (result->got_end || c->udp), "start/end events");
+    check(result->bad_samples == 0, "received samples differ from what was written");
+    check(result->order_errors == 0, "packet order or format");
+    check(result->samples + result->gap_samples == (uint64_t)blocks * CAPTURE_BLOCK_SAMPLES || (c->udp && !result->got_end),
+          "received + skipped samples != written samples");
+    if (!c->udp) {
+        check(result->gap_samples == t.stats.dropped_samples, "receiver gaps != sender dropped_samples");
+        check(result->header_dropped == t.stats.dropped_samples, "header dropped_samples != sender stats");
+        check(result->lost_packets == 0, "TCP packet sequence");
+    }
+    if (c->mode == MODE_REALTIME) {
+        check(t.stats.dropped_samples == 0 && result->gap_samples == 0, "samples dropped in real time");
+        float max_ms = percentile(result->latency_us, result->latencies, 1.0) / 1000.0f;
+        check(max_ms < c->flush_ms + 2 * BLOCK_US / 1000.0 + 20.0, "latency above flush + 2 blocks + 20 ms");
+    } else if (c->mode == MODE_THROUGHPUT && !c->udp) {
+        check(t.stats.dropped_samples == 0, "flow-controlled writer dropped samples");
+    } else if (c->mode == MODE_SLOW_READER) {
+        check(t.stats.dropped_samples > 0 && t.stats.busy > 0, "slow reader caused no backpressure");
+    }
+}
+
+int main(int argc, char **argv) {
+    double seconds = 2.0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S]\n", argv[0]);
+            return 1;
+        }
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    // 받는 프로세스와 공유
+    write_us = mmap(NULL, sizeof(uint64_t) * MAX_BLOCKS, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    result = mmap(NULL, sizeof(*result), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (write_us == MAP_FAILED || result == MAP_FAILED) {
+        fprintf(stderr, "mmap failed\n");
+        return 1;
+    }
+    audio_ring_t ring;
+    if (!audio_ring_init(&ring, RING_SAMPLES)) {
+        return 1;
+    }
+
+    static const bench_case_t cases[] = {
+        {"tcp realtime", 0, MODE_REALTIME, 40},
+        {"tcp realtime flush=0", 0, MODE_REALTIME, 0},
+        {"udp realtime", 1, MODE_REALTIME, 40},
+        {"tcp throughput", 0, MODE_THROUGHPUT, 40},
+        {"udp throughput", 1, MODE_THROUGHPUT, 40},
+        {"tcp slow reader", 0, MODE_SLOW_READER, 40},
+    };
+    printf("Loopback, %d Hz mono, %u-sample blocks (%llu us), MTU %d, ring %u samples, %.1f s per case\n",
+           MODEL_SAMPLE_RATE, CAPTURE_BLOCK_SAMPLES, (unsigned long long)BLOCK_US, TRANSPORT_SOCKET_MTU,
+           (unsigned)ring.capacity, seconds);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        run_case(&cases[i], cases[i].mode == MODE_REALTIME ? seconds : seconds / 2, &ring);
+    }
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,376 @@
+#include <libgen.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ima_adpcm.h"
+#include "playback.h"
+#include "wav_io.h"
+
+// 안내 음성 에셋 빌드: WAV(아무 샘플링 레이트, PCM) → 8kHz IMA ADPCM WAV (speaker.c play_prompt/load_wav용)
+// - 블록 256바이트 = 505샘플 (블록 앞 4바이트 헤더: 첫 샘플, 스텝 위치). 일반 WAV 플레이어로도 들을 수 있음
+// - 8비트 PCM(지금 SPIFFS의 test.wav)보다 절반, 16비트보다 1/4 크기라서 같은 spiffs 파티션(320KB)에 두 배 길이
+// - 만든 파일을 바로 확인: playback 믹서(장치와 같은 코드)로 256샘플 블록마다 디코딩한 결과가 기준 디코딩과
+//   비트 단위로 같은지, 스트림(조각조각 채움, 비었다가 다시 채움)으로도 같은지, 원본 대비 SNR, 블록당 디코딩 시간
+// 입력이 없으면 합성 음성으로 확인만 합니다.
+//
+//   ./encode_prompts [--normalize] [--block 256] input.wav output.wav
+//   ./encode_prompts [--normalize] --out-dir data prompts/*.wav
+//
+// 확인에 실패하면 FAILED를 출력하고 1을 반환합니다.
+
+#define RATE PLAYBACK_SAMPLE_RATE
+#define RENDER_BLOCK 256        // speaker.c PLAYBACK_BLOCK
+#define SPIFFS_BYTES 0x50000    // partitions.csv spiffs
+
+static int failures;
+
+static void check(int condition, const char *what) {
+    if (!condition) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t rng_state = 1;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static size_t samples_per_block(size_t block_bytes) {
+    return (block_bytes - 4) * 2 + 1;
+}
+
+// 블록마다: 헤더에 첫 샘플을 그대로, 나머지는 이어지는 스텝 위치로 인코딩. 마지막 블록은 마지막 샘플로 채움
+static uint8_t *encode(const int16_t *pcm, size_t count, size_t block_bytes, size_t *size) {
+    size_t per_block = samples_per_block(block_bytes);
+    size_t blocks = (count + per_block - 1) / per_block;
+    uint8_t *out = calloc(blocks, block_bytes);
+    int16_t *padded = malloc(per_block * sizeof(int16_t));
+    ima_adpcm_state_t state;
+    ima_adpcm_init(&state);
+    for (size_t b = 0; b < blocks; b++) {
+        size_t start = b * per_block;
+        size_t n = count - start < per_block ? count - start : per_block;
+        memcpy(padded, pcm + start, n * sizeof(int16_t));
+        for (size_t i = n; i < per_block; i++) {
+            padded[i] = pcm[count - 1];
+        }
+        uint8_t *block = out + b * block_bytes;
+        state.predictor = padded[0];
+        block[0] = (uint8_t)(padded[0] & 0xFF);
+        block[1] = (uint8_t)((uint16_t)padded[0] >> 8);
+        block[2] = state.index;
+        block[3] = 0;
+        ima_adpcm_encode(&state, padded + 1, block + 4, per_block - 1);
+    }
+    free(padded);
+    *size = blocks * block_bytes;
+    return out;
+}
+
+// 기준 디코딩 (블록 단위 한 번에)
+static int16_t *decode(const uint8_t *data, size_t size, size_t block_bytes, size_t count) {
+    size_t per_block = samples_per_block(block_bytes);
+    int16_t *out = malloc((size / block_bytes) * per_block * sizeof(int16_t));
+    for (size_t b = 0; b < size / block_bytes; b++) {
+        const uint8_t *block = data + b * block_bytes;
+        ima_adpcm_state_t state = {(int16_t)(block[0] | block[1] << 8), block[2] > 88 ? 88 : block[2]};
+        out[b * per_block] = state.predictor;
+        ima_adpcm_decode(&state, block + 4, out + b * per_block + 1, per_block - 1);
+    }
+    (void)count;
+    return out;
+}
+
+static void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+// WAVE_FORMAT_IMA_ADPCM (0x11) + fact (실제 샘플 수)
+static int write_adpcm_wav(const char *path, const uint8_t *data, size_t size, size_t block_bytes, size_t count) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return -1;
+    }
+    uint8_t h[60];
+    size_t per_block = samples_per_block(block_bytes);
+    memcpy(h, "RIFF", 4);
+    put_u32(h + 4, (uint32_t)(52 + size));
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_u32(h + 16, 20);
+    put_u16(h + 20, 0x11);
+    put_u16(h + 22, 1);
+    put_u32(h + 24, RATE);
+    put_u32(h + 28, (uint32_t)(RATE * block_bytes / per_block));  // 평균 바이트/초
+    put_u16(h + 32, (uint16_t)block_bytes);
+    put_u16(h + 34, 4);
+    put_u16(h + 36, 2);
+    put_u16(h + 38, (uint16_t)per_block);
+    memcpy(h + 40, "fact", 4);
+    put_u32(h + 44, 4);
+    put_u32(h + 48, (uint32_t)count);
+    memcpy(h + 52, "data", 4);
+    put_u32(h + 56, (uint32_t)size);
+    int ok = fwrite(h, 1, sizeof(h), f) == sizeof(h) && fwrite(data, 1, size, f) == size;
+    return fclose(f) == 0 && ok ? 0 : -1;
+}
+
+static double snr_db(const int16_t *ref, const int16_t *x, size_t n) {
+    double signal = 0, noise = 0;
+    for (size_t i = 0; i < n; i++) {
+        double d = (double)x[i] - ref[i];
+        signal += (double)ref[i] * ref[i];
+        noise += d * d;
+    }
+    return 10 * log10((signal + 1e-9) / (noise + 1e-9));
+}
+
+static void adpcm_clip(playback_clip_t *clip, const uint8_t *data, size_t block_bytes, size_t count,
+                       playback_stream_t *stream) {
+    memset(clip, 0, sizeof(*clip));
+    clip->kind = PLAYBACK_ADPCM;
+    clip->gain_q15 = 32767;
+    clip->length = (uint32_t)count;
+    clip->data = data;
+    clip->block_bytes = (uint16_t)block_bytes;
+    clip->stream = stream;
+}
+
+// 스트림으로 재생: 블록마다 write_bytes(무작위면 0)만큼 채움. starve면 가끔 채우지 않음.
+// 무음으로 기다린 샘플(블록 끝)은 빼고 out에 모음. 반환: 모은 샘플 수
+static size_t render_stream(const uint8_t *data, size_t size, size_t block_bytes, size_t count, int starve,
+                            int16_t *out, uint32_t *starved) {
+    static playback_t p;
+    static uint8_t buffer[2048];
+    playback_stream_t stream;
+    playback_init(&p);
+    playback_stream_init(&stream, buffer, sizeof(buffer));
+    playback_stream_claim(&stream);
+    size_t fed = playback_stream_write(&stream, data, 600);
+    playback_clip_t clip;
+    adpcm_clip(&clip, NULL, block_bytes, count, &stream);
+    playback_play(&p, 0, &clip);
+
+    size_t collected = 0;
+    int16_t block[300];
+    for (int guard = 0; guard < 1000000 && !playback_stream_free(&stream); guard++) {
+        if (fed < size && (!starve || rng() % 3 == 0)) {
+            size_t chunk = 1 + rng() % (starve ? 64 : 700);
+            chunk = chunk < size - fed ? chunk : size - fed;
+            fed += playback_stream_write(&stream, data + fed, chunk);
+        }
+        size_t n = 1 + rng() % 300;
+        uint32_t before = p.stats.starved;
+        playback_render(&p, block, n);
+        size_t real = n - (p.stats.starved - before);
+        if (collected + real > count) {
+            real = count - collected;  // 클립이 끝난 뒤의 무음
+        }
+        memcpy(out + collected, block, real * sizeof(int16_t));
+        collected += real;
+    }
+    *starved = p.stats.starved;
+    return collected;
+}
+
+// 만든 ADPCM을 확인하고 결과를 출력. pcm: 8kHz 원본
+static void verify(const char *name, const int16_t *pcm, size_t count, const uint8_t *data, size_t size,
+                   size_t block_bytes) {
+    int16_t *reference = decode(data, size, block_bytes, count);
+
+    // 장치와 같은 경로: 메모리 클립을 256샘플 블록으로
+    static playback_t p;
+    playback_init(&p);
+    playback_clip_t clip;
+    adpcm_clip(&clip, data, block_bytes, count, NULL);
+    playback_play(&p, 0, &clip);
+    size_t blocks = (count + RENDER_BLOCK - 1) / RENDER_BLOCK;
+    int16_t *played = malloc(blocks * RENDER_BLOCK * sizeof(int16_t));
+    for (size_t b = 0; b < blocks; b++) {
+        playback_render(&p, played + b * RENDER_BLOCK, RENDER_BLOCK);
+    }
+    int exact = memcmp(played, reference, count * sizeof(int16_t)) == 0;
+
+    int16_t *streamed = malloc(count * sizeof(int16_t));
+    uint32_t starved = 0;
+    size_t n = render_stream(data, size, block_bytes, count, 0, streamed, &starved);
+    int stream_exact = n == count && starved == 0 && memcmp(streamed, reference, count * sizeof(int16_t)) == 0;
+    n = render_stream(data, size, block_bytes, count, 1, streamed, &starved);
+    int starve_exact = n == count && starved > 0 && memcmp(streamed, reference, count * sizeof(int16_t)) == 0;
+
+    // 블록당 디코딩 시간 (같은 길이 PCM16 클립과 비교)
+    double adpcm_us = 1e9, pcm_us = 1e9;
+    for (int round = 0; round < 5; round++) {
+        double start = now_us();
+        playback_init(&p);
+        playback_play(&p, 0, &clip);
+        for (size_t b = 0; b < blocks; b++) {
+            playback_render(&p, played + b * RENDER_BLOCK, RENDER_BLOCK);
+        }
+        double t = (now_us() - start) / blocks;
+        adpcm_us = t < adpcm_us ? t : adpcm_us;
+
+        playback_clip_t raw;
+        memset(&raw, 0, sizeof(raw));
+        raw.kind = PLAYBACK_PCM16;
+        raw.gain_q15 = 32767;
+        raw.data = reference;
+        raw.length = (uint32_t)count;
+        start = now_us();
+        playback_init(&p);
+        playback_play(&p, 0, &raw);
+        for (size_t b = 0; b < blocks; b++) {
+            playback_render(&p, played + b * RENDER_BLOCK, RENDER_BLOCK);
+        }
+        t = (now_us() - start) / blocks;
+        pcm_us = t < pcm_us ? t : pcm_us;
+    }
+
+    printf("%s: %.2f s, %zu bytes (PCM8 %zu, PCM16 %zu), SNR %.1f dB, playback %s, stream %s, "
+           "starved stream %s (%u samples waited), decode %.2f us per %d-sample block (PCM16 %.2f us)\n",
+           name, (double)count / RATE, size, count, 2 * count, snr_db(pcm, reference, count),
+           exact ? "exact" : "DIFFERENT", stream_exact ? "exact" : "DIFFERENT", starve_exact ? "exact" : "DIFFERENT",
+           starved, adpcm_us, RENDER_BLOCK, pcm_us);
+    check(exact, "playback ADPCM decoding differs from reference");
+    check(stream_exact, "streamed ADPCM differs from reference");
+    check(starve_exact, "starved stream does not resume where it stopped");
+    free(reference);
+    free(played);
+    free(streamed);
+}
+
+static int16_t *load(const char *path, size_t *count, int normalize) {
+    int16_t *pcm = wav_read_mono(path, RATE, count);
+    if (!pcm || !*count) {
+        printf("Cannot read %s (PCM WAV)\n", path);
+        return NULL;
+    }
+    if (normalize) {
+        int peak = 1;
+        for (size_t i = 0; i < *count; i++) {
+            peak = abs(pcm[i]) > peak ? abs(pcm[i]) : peak;
+        }
+        double gain = 29204.0 / peak;  // -1 dBFS
+        for (size_t i = 0; i < *count; i++) {
+            pcm[i] = (int16_t)lrint(pcm[i] * gain);
+        }
+    }
+    return pcm;
+}
+
+static int encode_file(const char *in, const char *out, size_t block_bytes, int normalize, size_t *total_bytes,
+                       double *total_seconds) {
+    size_t count;
+    int16_t *pcm = load(in, &count, normalize);
+    if (!pcm) {
+        failures++;
+        return -1;
+    }
+    size_t size;
+    uint8_t *data = encode(pcm, count, block_bytes, &size);
+    if (write_adpcm_wav(out, data, size, block_bytes, count) != 0) {
+        printf("Cannot write %s\n", out);
+        failures++;
+    }
+    verify(out, pcm, count, data, size, block_bytes);
+    *total_bytes += size + 60;
+    *total_seconds += (double)count / RATE;
+    free(pcm);
+    free(data);
+    return 0;
+}
+
+// 말소리 대신 쓰는 합성 음성 (입력이 없을 때)
+static int16_t *synthetic(size_t count) {
+    int16_t *data = malloc(count * sizeof(int16_t));
+    double phase = 0;
+    for (size_t i = 0; i < count; i++) {
+        double t = (double)i / RATE;
+        phase += 2 * M_PI * (160 + 70 * sin(2 * M_PI * 2.5 * t)) / RATE;
+        double syllable = 0.5 - 0.5 * cos(2 * M_PI * 4 * t);
+        double noise = ((double)(rng() % 2001) - 1000) / 1000;
+        data[i] = (int16_t)lrint(syllable * (9000 * sin(phase) + 3000 * sin(3 * phase) + 1500 * sin(7 * phase) +
+                                             600 * noise));
+    }
+    return data;
+}
+
+int main(int argc, char **argv) {
+    size_t block_bytes = 256;
+    int normalize = 0;
+    const char *out_dir = NULL;
+    const char *files[256];
+    int file_count = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--normalize") == 0) {
+            normalize = 1;
+        } else if (strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            block_bytes = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (argv[i][0] != '-' && file_count < 256) {
+            files[file_count++] = argv[i];
+        } else {
+            printf("usage: %s [--normalize] [--block 256] input.wav output.wav\n"
+                   "       %s [--normalize] [--block 256] --out-dir dir input.wav ...\n", argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (block_bytes < 8 || block_bytes > 4096) {
+        printf("--block must be 8..4096 bytes\n");
+        return 2;
+    }
+    if (!out_dir && file_count != 0 && file_count != 2) {
+        printf("give input.wav output.wav, or --out-dir dir with inputs\n");
+        return 2;
+    }
+
+    size_t total_bytes = 0;
+    double total_seconds = 0;
+    if (file_count == 0) {
+        size_t count = RATE * 3 + 123;  // 블록 경계에 맞지 않는 길이
+        int16_t *pcm = synthetic(count);
+        size_t size;
+        uint8_t *data = encode(pcm, count, block_bytes, &size);
+        verify("synthetic", pcm, count, data, size, block_bytes);
+        total_bytes = size + 60;
+        total_seconds = (double)count / RATE;
+        free(pcm);
+        free(data);
+    } else if (!out_dir) {
+        encode_file(files[0], files[1], block_bytes, normalize, &total_bytes, &total_seconds);
+    } else {
+        for (int i = 0; i < file_count; i++) {
+            char copy[512], path[1024];
+            snprintf(copy, sizeof(copy), "%s", files[i]);
+            snprintf(path, sizeof(path), "%s/%s", out_dir, basename(copy));
+            encode_file(files[i], path, block_bytes, normalize, &total_bytes, &total_seconds);
+        }
+    }
+
+    double bytes_per_second = total_bytes / total_seconds;
+    printf("\n%.2f s in %zu bytes (%.0f bytes/s read from flash, PCM8 %d bytes/s)\n",
+           total_seconds, total_bytes, bytes_per_second, RATE);
+    printf("spiffs partition (%d KB): about %.0f s of ADPCM prompts (PCM8 %.0f s, PCM16 %.0f s)\n",
+           SPIFFS_BYTES / 1024, SPIFFS_BYTES / bytes_per_second, (double)SPIFFS_BYTES / RATE,
+           (double)SPIFFS_BYTES / (2 * RATE));
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,254 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "beamformer.h"
+#include "wav_io.h"
+
+// beamformer.c 평가: 모노 클립을 방향별 도달 시간 차로 지연시킨 합성 스테레오 신호로 확인
+//
+//   ./eval_beamformer ../data/test.wav                       # 조향 이득, 방향 추정, 처리 속도
+//   ./eval_beamformer ../data/test.wav --spacing 40 --steer 0
+//   ./eval_beamformer ../data/test.wav --write synth         # synth_<각도>deg.wav (합성 스테레오) 저장
+//   ./eval_beamformer --stereo recording.wav --write out     # 실제 스테레오 녹음을 빔포밍해서 out_beam.wav로 저장
+//
+// 빔포머는 (반올림을 빼면) 선형이므로 목표 음성과 간섭 소음을 따로 통과시켜서 각각의 이득을 구합니다.
+
+#define SAMPLE_RATE   16000
+#define BLOCK_SAMPLES 512         // wake_word.cpp의 CAPTURE_BLOCK_SAMPLES
+#define SYNTH_TAPS    64          // 합성용 분수 지연 필터 (평가 대상보다 충분히 정확하게)
+#define SYNTH_BASE    (SYNTH_TAPS / 2 + 8)
+
+static const int doa_angles[] = {-90, -60, -30, 0, 30, 60, 90};
+
+// x를 delay 샘플(실수)만큼 늦춘 신호 (Hann 창 sinc 보간)
+static void fractional_delay(const int16_t *x, int16_t *y, size_t count, double delay) {
+    for (size_t i = 0; i < count; i++) {
+        double sum = 0;
+        double center = (double)i - delay;
+        long first = (long)floor(center) - SYNTH_TAPS / 2 + 1;
+        for (long n = first; n < first + SYNTH_TAPS; n++) {
+            if (n < 0 || n >= (long)count) {
+                continue;
+            }
+            double t = center - n;
+            double sinc = fabs(t) < 1e-9 ? 1.0 : sin(M_PI * t) / (M_PI * t);
+            double window = 0.5 + 0.5 * cos(M_PI * t / (SYNTH_TAPS / 2));
+            sum += x[n] * sinc * window;
+        }
+        y[i] = (int16_t)(sum > 32767 ? 32767 : (sum < -32768 ? -32768 : lrint(sum)));
+    }
+}
+
+// 각도 angle에서 온 소리를 I2S 스테레오 버퍼(L, R, ...) 형식으로
+static int16_t *make_stereo(const int16_t *source, size_t count, double max_lag, double angle) {
+    double lag = max_lag * sin(angle * M_PI / 180.0);  // 양수면 오른쪽이 먼저
+    int16_t *left = malloc(count * sizeof(int16_t));
+    int16_t *right = malloc(count * sizeof(int16_t));
+    fractional_delay(source, left, count, SYNTH_BASE + lag / 2);
+    fractional_delay(source, right, count, SYNTH_BASE - lag / 2);
+    int16_t *stereo = malloc(2 * count * sizeof(int16_t));
+    for (size_t i = 0; i < count; i++) {
+        stereo[2 * i] = left[i];
+        stereo[2 * i + 1] = right[i];
+    }
+    free(left);
+    free(right);
+    return stereo;
+}
+
+// 펌웨어 capture_task와 같이 블록 단위로 deinterleave → 빔포밍
+static void run(beamformer_t *bf, const int16_t *stereo, int16_t *out, size_t count) {
+    static int16_t left[BLOCK_SAMPLES], right[BLOCK_SAMPLES];
+    for (size_t i = 0; i < count; i += BLOCK_SAMPLES) {
+        size_t n = count - i < BLOCK_SAMPLES ? count - i : BLOCK_SAMPLES;
+        beamformer_deinterleave(stereo + 2 * i, left, right, n);
+        beamformer_process(bf, left, right, out + i, n);
+    }
+}
+
+static double energy(const int16_t *x, size_t count) {
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)x[i] * x[i];
+    }
+    return sum;
+}
+
+static double left_energy(const int16_t *stereo, size_t count) {
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)stereo[2 * i] * stereo[2 * i];
+    }
+    return sum;
+}
+
+// 한 마이크(왼쪽) 대비 빔포머 출력의 이득 (dB)
+static double beam_gain(float spacing, float steer, const int16_t *source, size_t count, double angle) {
+    beamformer_t bf;
+    beamformer_init(&bf, SAMPLE_RATE, spacing, steer);
+    int16_t *stereo = make_stereo(source, count, bf.max_lag, angle);
+    int16_t *out = malloc(count * sizeof(int16_t));
+    run(&bf, stereo, out, count);
+    double gain = 10 * log10(energy(out, count) / left_energy(stereo, count));
+    free(stereo);
+    free(out);
+    return gain;
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int process_stereo_file(const char *path, float spacing, float steer, const char *prefix) {
+    int channels;
+    size_t frames;
+    int16_t *stereo = wav_read(path, SAMPLE_RATE, &channels, &frames);
+    if (!stereo || channels != 2) {
+        fprintf(stderr, "%s: 2채널 WAV가 아닙니다.\n", path);
+        free(stereo);
+        return 1;
+    }
+    beamformer_t bf;
+    beamformer_init(&bf, SAMPLE_RATE, spacing, steer);
+    int16_t *out = malloc(frames * sizeof(int16_t));
+    run(&bf, stereo, out, frames);
+
+    // 블록별 방향 추정 (큰 블록만)
+    static int16_t left[BLOCK_SAMPLES], right[BLOCK_SAMPLES];
+    double threshold = left_energy(stereo, frames) / frames * BLOCK_SAMPLES;
+    for (size_t i = 0; i + BLOCK_SAMPLES <= frames; i += BLOCK_SAMPLES) {
+        beamformer_deinterleave(stereo + 2 * i, left, right, BLOCK_SAMPLES);
+        if (energy(left, BLOCK_SAMPLES) > threshold) {
+            printf("%7.2f s: DOA %+5.0f deg\n", (double)i / SAMPLE_RATE,
+                   beamformer_estimate_doa(&bf, left, right, BLOCK_SAMPLES));
+        }
+    }
+
+    char out_path[512];
+    snprintf(out_path, sizeof(out_path), "%s_beam.wav", prefix ? prefix : "beam");
+    wav_write_mono(out_path, SAMPLE_RATE, out, frames);
+    printf("Beamformed output written to %s\n", out_path);
+    free(stereo);
+    free(out);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *clean_path = NULL;
+    const char *stereo_path = NULL;
+    const char *write_prefix = NULL;
+    float spacing = 60.0f;
+    float steer = 0.0f;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--spacing") == 0 && i + 1 < argc) {
+            spacing = strtof(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--steer") == 0 && i + 1 < argc) {
+            steer = strtof(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--stereo") == 0 && i + 1 < argc) {
+            stereo_path = argv[++i];
+        } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            write_prefix = argv[++i];
+        } else if (argv[i][0] != '-' && !clean_path) {
+            clean_path = argv[i];
+        } else {
+            clean_path = stereo_path = NULL;
+            break;
+        }
+    }
+    if (stereo_path) {
+        return process_stereo_file(stereo_path, spacing, steer, write_prefix);
+    }
+    if (!clean_path) {
+        fprintf(stderr, "usage: %s CLEAN.wav [--spacing MM] [--steer DEG] [--write PREFIX]\n"
+                        "       %s --stereo STEREO.wav [--spacing MM] [--steer DEG] [--write PREFIX]\n",
+                argv[0], argv[0]);
+        return 2;
+    }
+
+    size_t count;
+    int16_t *speech = wav_read_mono(clean_path, SAMPLE_RATE, &count);
+    if (!speech) {
+        fprintf(stderr, "Failed to read %s\n", clean_path);
+        return 1;
+    }
+
+    // 광대역 간섭 소음 (고정 난수)
+    int16_t *noise = malloc(count * sizeof(int16_t));
+    uint32_t seed = 7;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        noise[i] = (int16_t)((int32_t)(seed >> 16) - 32768) / 4;
+    }
+
+    beamformer_t bf;
+    beamformer_init(&bf, SAMPLE_RATE, spacing, steer);
+    printf("Spacing %.0f mm (max lag %.2f samples), steering %.0f deg, delay %s%d + FIR\n",
+           spacing, bf.max_lag, steer, bf.delay_right ? "right " : "left ", bf.delay_int);
+
+    // 1. 방향별 이득: 조향 방향은 0dB 근처, 다른 방향의 광대역 소음은 줄어야 함
+    printf("\n%8s %14s %14s\n", "angle", "speech gain", "noise gain");
+    for (size_t a = 0; a < sizeof(doa_angles) / sizeof(doa_angles[0]); a++) {
+        printf("%6d deg %+11.2f dB %+11.2f dB\n", doa_angles[a],
+               beam_gain(spacing, steer, speech, count, doa_angles[a]),
+               beam_gain(spacing, steer, noise, count, doa_angles[a]));
+    }
+
+    // 2. 방향 추정: 음성이 큰 블록마다 추정해서 평균
+    printf("\n%8s %12s %10s\n", "angle", "DOA mean", "blocks");
+    static int16_t left[BLOCK_SAMPLES], right[BLOCK_SAMPLES];
+    double threshold = energy(speech, count) / count * BLOCK_SAMPLES;
+    for (size_t a = 0; a < sizeof(doa_angles) / sizeof(doa_angles[0]); a++) {
+        int16_t *stereo = make_stereo(speech, count, bf.max_lag, doa_angles[a]);
+        double sum = 0;
+        int blocks = 0;
+        for (size_t i = 0; i + BLOCK_SAMPLES <= count; i += BLOCK_SAMPLES) {
+            beamformer_deinterleave(stereo + 2 * i, left, right, BLOCK_SAMPLES);
+            if (energy(left, BLOCK_SAMPLES) > threshold) {
+                sum += beamformer_estimate_doa(&bf, left, right, BLOCK_SAMPLES);
+                blocks++;
+            }
+        }
+        printf("%6d deg %+9.1f deg %10d\n", doa_angles[a], blocks ? sum / blocks : 0.0, blocks);
+
+        if (write_prefix) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s_%ddeg.wav", write_prefix, doa_angles[a]);
+            wav_write(path, SAMPLE_RATE, 2, stereo, count);
+        }
+        free(stereo);
+    }
+
+    // 3. 처리 속도 (deinterleave + 빔포밍, 방향 추정)
+    int16_t *stereo = make_stereo(speech, count, bf.max_lag, steer);
+    int16_t *out = malloc(count * sizeof(int16_t));
+    int iterations = 0;
+    double start = now_us(), elapsed = 0;
+    while (elapsed < 300000.0) {
+        run(&bf, stereo, out, count);
+        iterations++;
+        elapsed = now_us() - start;
+    }
+    double beam_us = elapsed / ((double)iterations * count / BLOCK_SAMPLES);
+    iterations = 0;
+    start = now_us();
+    elapsed = 0;
+    while (elapsed < 300000.0) {
+        beamformer_deinterleave(stereo, left, right, BLOCK_SAMPLES);
+        volatile float doa = beamformer_estimate_doa(&bf, left, right, BLOCK_SAMPLES);
+        (void)doa;
+        iterations++;
+        elapsed = now_us() - start;
+    }
+    printf("\nHost cost per %d-sample block: beamformer %.2f us, DOA %.2f us (block = %.0f us)\n",
+           BLOCK_SAMPLES, beam_us, elapsed / iterations, 1e6 * BLOCK_SAMPLES / SAMPLE_RATE);
+
+    free(stereo);
+    free(out);
+    free(noise);
+    free(speech);
+    return 0;
+}
@@ -0,0 +1,511 @@
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "frontend_simd.h"
+#include "keyword_detector.h"
+#include "model_runner.h"
+#include "wake_word_model.h"
+#include "wake_word_sim.h"
+#include "wav_mmap.h"
+
+// 라벨별 폴더의 WAV 코퍼스를 펌웨어와 같은 오디오 경로와 모델로 평가 (scripts/confusion_matrix.py의 대용량/병렬 버전)
+// - 파일마다: wake_word_sim.c(capture_pipeline, 추론 시점, 입력 창) → 모델(TFLM) → keyword_detector.c (같은 라벨 테이블)
+// - 작업 훔치기(work-stealing) 스레드 풀: 스레드마다 인터프리터와 텐서 아레나, 오디오 경로 상태를 따로 가짐
+// - WAV는 메모리 맵으로 읽고 지나간 페이지를 돌려주므로 수십 GB 코퍼스도 메모리에 다 올리지 않음
+// - 결과: 파일별 점수(--scores), 임계값별 ROC/DET(--roc), 시간당 오검출(FA/h), 처리량(오디오 시간 / 실제 초)
+//
+//   ./eval_corpus dataset                                  # 요약, 임계값 0.05 간격 ROC/DET 표
+//   ./eval_corpus dataset --scores scores.csv --roc roc.csv --jobs 16
+//   ./eval_corpus dataset --model new_model.tflite         # 다른 모델 (라벨 테이블은 src/wake_word_model.h)
+//
+// 데이터 폴더 구조는 confusion_matrix.py와 같습니다. (최상위 하위 폴더 이름이 라벨, 그 아래는 재귀)
+//   dataset/리지야/*.wav         → 양성 (라벨 테이블의 첫 클래스, --positive로 변경)
+//   dataset/_unknown_/*.wav      → 음성 (다른 명령어, 배경, 몇 시간짜리 생활 소음 녹음 등 나머지 전부)
+// 오검출(FA)은 음성 파일에서 호출어 클래스가 검출된 횟수(평활화 + refractory 포함)이고, FA/h는 음성 오디오 전체 길이 기준,
+// 검출률은 양성 파일 중 한 번이라도 평활화된 확률이 임계값을 넘은 비율입니다. 파일마다 --tail-ms만큼 무음을 덧붙여서
+// 파일 끝에 있는 호출어도 창을 다 지나가게 합니다. (무음은 오디오 시간에 포함하지 않음)
+//
+// 옵션: --jobs N (기본 CPU 코어 수), --positive 라벨, --tail-ms N (기본 1000), --arena 바이트 (기본 펌웨어와 같음),
+//       --hop N, --first N (추론 간격, 첫 추론까지 샘플 수. 기본값은 펌웨어 기본 설정),
+//       --isa auto|portable|sse4.1|avx2 (특징 추출 커널, 기본 auto = 이 CPU에서 가장 빠른 것. 결과는 같음, frontend_simd.h)
+//
+// TFLM 없이 빌드하면(-DTFLM_DIR 없음) 모델 대신 입력 창의 에너지를 점수로 써서 코퍼스 읽기, 스레드 풀, 보고서만 확인합니다.
+
+namespace {
+
+constexpr int kThresholds = 101;                // ROC/DET 임계값 0.00 ~ 1.00 (0.01 간격)
+
+struct FileItem {
+    std::string path;
+    std::string label;
+    bool positive;
+    uintmax_t bytes;
+};
+
+struct FileResult {
+    bool ok = false;
+    double seconds = 0.0;
+    uint32_t hops = 0;
+    float max_score = 0.0f;     // 호출어 클래스 확률 최대값
+    float max_smoothed = 0.0f;  // 평활화된 확률 최대값
+    uint32_t detections = 0;    // 라벨 테이블 임계값 기준 검출 횟수 (모든 클래스)
+    int first_detection = -1;   // 처음 검출된 클래스
+};
+
+// 스레드마다 따로 더하고 끝나고 합침
+struct Totals {
+    uint64_t files = 0, failed = 0, steals = 0, hops = 0;
+    double positive_seconds = 0.0, negative_seconds = 0.0, invoke_seconds = 0.0;
+    uint64_t positive_files = 0, positive_detected = 0, negative_detections = 0;
+    uint64_t hits[kThresholds] = {};           // 양성 파일 중 max_smoothed >= 임계값
+    uint64_t false_accepts[kThresholds] = {};  // 음성 오디오의 호출어 검출 횟수
+
+    void add(const Totals &other) {
+        files += other.files;
+        failed += other.failed;
+        steals += other.steals;
+        hops += other.hops;
+        positive_seconds += other.positive_seconds;
+        negative_seconds += other.negative_seconds;
+        invoke_seconds += other.invoke_seconds;
+        positive_files += other.positive_files;
+        positive_detected += other.positive_detected;
+        negative_detections += other.negative_detections;
+        for (int t = 0; t < kThresholds; t++) {
+            hits[t] += other.hits[t];
+            false_accepts[t] += other.false_accepts[t];
+        }
+    }
+};
+
+float threshold_at(int t) {
+    return t / (float)(kThresholds - 1);
+}
+
+// 작업 훔치기 스레드 풀 ---------------------------------------------------------------------------
+// 파일을 크기 순으로 스레드별 큐에 나눠 담고, 자기 큐는 앞(큰 파일)부터, 자기 큐가 비면 다른 큐의 뒤(작은 파일)에서 가져옴
+// 몇 시간짜리 녹음과 1초짜리 클립이 섞여 있어도 끝날 때 한 스레드만 남아서 도는 시간이 짧습니다.
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<size_t> items;
+};
+
+bool take_work(std::vector<WorkQueue> &queues, size_t self, size_t *item, bool *stolen) {
+    {
+        std::lock_guard<std::mutex> lock(queues[self].mutex);
+        if (!queues[self].items.empty()) {
+            *item = queues[self].items.front();
+            queues[self].items.pop_front();
+            *stolen = false;
+            return true;
+        }
+    }
+    for (size_t k = 1; k < queues.size(); k++) {
+        WorkQueue &victim = queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty()) {
+            *item = victim.items.back();
+            victim.items.pop_back();
+            *stolen = true;
+            return true;
+        }
+    }
+    return false;  // 작업 추가가 없으므로 모든 큐가 비면 끝
+}
+
+struct Options {
+    const uint8_t *model = model_tflite;
+    size_t arena_size = kModelTensorArenaSize;
+    size_t hop = SIM_INFERENCE_HOP_SAMPLES;
+    size_t first = SIM_FIRST_INFERENCE_SAMPLES;
+    size_t tail_samples = I2S_SAMPLE_RATE;
+    int positive_class = 0;
+};
+
+struct Worker {
+    wake_word_sim_t sim;
+    keyword_detector_t detector;
+    ModelRunner runner;
+    Totals totals;
+};
+
+// 파일 하나: 메모리 맵 → 캡처 블록 단위로 오디오 경로 → 추론 시점마다 모델, 검출기, 임계값별 오검출
+void evaluate_file(Worker *worker, const Options &options, const FileItem &item, FileResult *result) {
+    wav_mmap_t wav;
+    if (!wav_mmap_open(&wav, item.path.c_str())) {
+        worker->totals.failed++;
+        return;
+    }
+    const size_t length = wav_mmap_length(&wav, I2S_SAMPLE_RATE);
+    const keyword_class_t &positive = model_classes[options.positive_class];
+    Totals &totals = worker->totals;
+
+    wake_word_sim_reset(&worker->sim);
+    keyword_detector_reset(&worker->detector);
+    uint16_t cooldown[kThresholds] = {};
+    float scores[KEYWORD_MAX_CLASSES];
+    float smoothed[KEYWORD_MAX_CLASSES];
+    int16_t block[SIM_CAPTURE_BLOCK_SAMPLES];
+
+    for (size_t offset = 0; offset < length + options.tail_samples; offset += SIM_CAPTURE_BLOCK_SAMPLES) {
+        wav_mmap_read_mono(&wav, I2S_SAMPLE_RATE, offset, block, SIM_CAPTURE_BLOCK_SAMPLES);
+        uint32_t position;
+        const int16_t *window = wake_word_sim_block(&worker->sim, block, SIM_CAPTURE_BLOCK_SAMPLES, &position);
+        if (!window) {
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (!model_runner_invoke(&worker->runner, window, scores)) {
+            break;
+        }
+        totals.invoke_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result->hops++;
+
+        int detected = keyword_detector_update(&worker->detector, scores, worker->runner.num_classes, smoothed);
+        if (detected >= 0) {
+            result->detections++;
+            if (result->first_detection < 0) {
+                result->first_detection = detected;
+            }
+            if (!item.positive && detected == options.positive_class) {
+                totals.negative_detections++;
+            }
+        }
+        const float score = smoothed[options.positive_class];
+        result->max_score = std::max(result->max_score, scores[options.positive_class]);
+        result->max_smoothed = std::max(result->max_smoothed, score);
+
+        // 음성 오디오: 임계값마다 keyword_detector.c와 같은 refractory로 호출어 검출 횟수
+        if (!item.positive) {
+            for (int t = 0; t < kThresholds; t++) {
+                if (cooldown[t] > 0) {
+                    cooldown[t]--;
+                } else if (score >= threshold_at(t)) {
+                    totals.false_accepts[t]++;
+                    cooldown[t] = positive.refractory;
+                }
+            }
+        }
+    }
+    wav_mmap_close(&wav);
+
+    result->ok = true;
+    result->seconds = (double)length / I2S_SAMPLE_RATE;
+    totals.files++;
+    totals.hops += result->hops;
+    if (item.positive) {
+        totals.positive_seconds += result->seconds;
+        totals.positive_files++;
+        totals.positive_detected += result->first_detection == options.positive_class;
+        for (int t = 0; t < kThresholds; t++) {
+            totals.hits[t] += result->max_smoothed >= threshold_at(t);
+        }
+    } else {
+        totals.negative_seconds += result->seconds;
+    }
+}
+
+// 라벨 폴더 아래 WAV 파일 전부 (confusion_matrix.py collect_files()와 같은 규칙)
+std::vector<FileItem> collect_files(const std::string &root, const char *positive_label) {
+    namespace fs = std::filesystem;
+    std::vector<FileItem> items;
+    std::error_code error;
+    for (const fs::directory_entry &folder : fs::directory_iterator(root, error)) {
+        if (!folder.is_directory()) {
+            continue;
+        }
+        const std::string label = folder.path().filename().string();
+        for (auto it = fs::recursive_directory_iterator(folder.path(), fs::directory_options::follow_directory_symlink, error);
+             it != fs::recursive_directory_iterator(); it.increment(error)) {
+            std::string extension = it->path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+            if (it->is_regular_file() && extension == ".wav") {
+                items.push_back({it->path().string(), label, label == positive_label, it->file_size()});
+            }
+        }
+    }
+    std::sort(items.begin(), items.end(), [](const FileItem &a, const FileItem &b) { return a.path < b.path; });
+    return items;
+}
+
+std::string csv_quote(const std::string &text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
+bool write_scores(const char *path, const std::vector<FileItem> &items, const std::vector<FileResult> &results) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "path,label,positive,seconds,hops,max_score,max_smoothed,detections,first_detection\n");
+    for (size_t i = 0; i < items.size(); i++) {
+        const FileResult &r = results[i];
+        if (!r.ok) {
+            continue;
+        }
+        fprintf(f, "%s,%s,%d,%.3f,%lu,%.4f,%.4f,%lu,%s\n", csv_quote(items[i].path).c_str(),
+                csv_quote(items[i].label).c_str(), items[i].positive ? 1 : 0, r.seconds, (unsigned long)r.hops,
+                r.max_score, r.max_smoothed, (unsigned long)r.detections,
+                r.first_detection >= 0 ? model_classes[r.first_detection].label : "");
+    }
+    return fclose(f) == 0;
+}
+
+// ROC(검출률 - FA/h)와 DET(놓친 비율 - FA/h)는 같은 표에서 그림
+bool write_roc(const char *path, const Totals &totals) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        return false;
+    }
+    const double negative_hours = totals.negative_seconds / 3600.0;
+    fprintf(f, "threshold,detection_rate,miss_rate,false_accepts,false_accepts_per_hour\n");
+    for (int t = 0; t < kThresholds; t++) {
+        double rate = totals.positive_files ? (double)totals.hits[t] / totals.positive_files : 0.0;
+        fprintf(f, "%.2f,%.4f,%.4f,%lu,%.3f\n", threshold_at(t), rate, 1.0 - rate, (unsigned long)totals.false_accepts[t],
+                negative_hours > 0 ? totals.false_accepts[t] / negative_hours : 0.0);
+    }
+    return fclose(f) == 0;
+}
+
+int usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s <dataset> [--jobs N] [--model model.tflite] [--scores scores.csv] [--roc roc.csv]\n"
+            "       [--positive LABEL] [--tail-ms N] [--arena BYTES] [--hop N] [--first N] [--isa NAME]\n",
+            program);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    const char *dataset = nullptr;
+    const char *model_path = nullptr;
+    const char *scores_path = nullptr;
+    const char *roc_path = nullptr;
+    const char *positive_label = model_classes[0].label;
+    const char *isa = nullptr;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobs = (unsigned)std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+            model_path = argv[++i];
+        } else if (strcmp(argv[i], "--scores") == 0 && i + 1 < argc) {
+            scores_path = argv[++i];
+        } else if (strcmp(argv[i], "--roc") == 0 && i + 1 < argc) {
+            roc_path = argv[++i];
+        } else if (strcmp(argv[i], "--positive") == 0 && i + 1 < argc) {
+            positive_label = argv[++i];
+        } else if (strcmp(argv[i], "--tail-ms") == 0 && i + 1 < argc) {
+            options.tail_samples = (size_t)atoi(argv[++i]) * I2S_SAMPLE_RATE / 1000;
+        } else if (strcmp(argv[i], "--arena") == 0 && i + 1 < argc) {
+            options.arena_size = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--hop") == 0 && i + 1 < argc) {
+            options.hop = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            options.first = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+            isa = argv[++i];
+        } else if (argv[i][0] != '-') {
+            dataset = argv[i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (!dataset || options.hop == 0) {
+        return usage(argv[0]);
+    }
+    const audio_frontend_kernels_t *frontend_kernels = frontend_simd_install(isa);
+    if (!frontend_kernels) {
+        return 2;
+    }
+
+    options.positive_class = -1;
+    for (unsigned c = 0; c < model_classes_len; c++) {
+        if (strcmp(model_classes[c].label, positive_label) == 0 && !model_classes[c].background) {
+            options.positive_class = (int)c;
+        }
+    }
+    if (options.positive_class < 0) {
+        fprintf(stderr, "Label %s is not a keyword class in src/wake_word_model.h\n", positive_label);
+        return 2;
+    }
+
+    // --model: 스레드들이 같은 모델 데이터를 공유 (인터프리터와 아레나만 스레드마다)
+    std::vector<uint8_t> model_file;
+    if (model_path) {
+        FILE *f = fopen(model_path, "rb");
+        if (!f) {
+            perror(model_path);
+            return 1;
+        }
+        uint8_t chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            model_file.insert(model_file.end(), chunk, chunk + n);
+        }
+        fclose(f);
+        options.model = model_file.data();
+    }
+
+    std::vector<FileItem> items = collect_files(dataset, positive_label);
+    if (items.empty()) {
+        fprintf(stderr, "No WAV files found in %s\n", dataset);
+        return 1;
+    }
+    jobs = std::min<unsigned>(jobs, (unsigned)items.size());
+
+    // 스레드마다 오디오 경로, 검출기, 인터프리터/아레나
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (unsigned w = 0; w < jobs; w++) {
+        std::unique_ptr<Worker> worker(new Worker());
+        std::string error;
+        if (!wake_word_sim_init(&worker->sim) ||
+            !model_runner_init(&worker->runner, options.model, options.arena_size, model_classes, model_classes_len, false,
+                               &error)) {
+            fprintf(stderr, "Worker init failed: %s\n", error.c_str());
+            return 1;
+        }
+        if (worker->runner.window == 0 || worker->runner.window > SIM_MODEL_WINDOW_MAX_SAMPLES ||
+            worker->runner.num_classes != model_classes_len ||
+            !keyword_detector_init(&worker->detector, model_classes, model_classes_len)) {
+            fprintf(stderr, "Model input %lu samples / %lu classes does not match this build (%d samples, %u classes)\n",
+                    (unsigned long)worker->runner.window, (unsigned long)worker->runner.num_classes,
+                    SIM_MODEL_WINDOW_MAX_SAMPLES, model_classes_len);
+            return 1;
+        }
+        worker->sim.hop = options.hop;
+        worker->sim.first = options.first;
+        worker->sim.window = worker->runner.window;
+        workers.push_back(std::move(worker));
+    }
+
+    // 큰 파일부터 스레드별 큐에 번갈아 담음
+    std::vector<size_t> order(items.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return items[a].bytes > items[b].bytes; });
+    std::vector<WorkQueue> queues(jobs);
+    for (size_t i = 0; i < order.size(); i++) {
+        queues[i % jobs].items.push_back(order[i]);
+    }
+
+    printf("%lu files, %u jobs, model %s%s, frontend %s, positive \"%s\"\n", (unsigned long)items.size(), jobs,
+           model_runner_backend(), HAVE_TFLM ? "" : " (TFLM 없음, 도구 확인용)", frontend_kernels->name,
+           model_classes[options.positive_class].label);
+    fflush(stdout);
+
+    std::vector<FileResult> results(items.size());
+    std::atomic<size_t> done(0);
+    std::mutex done_mutex;
+    std::condition_variable done_changed;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned w = 0; w < jobs; w++) {
+        threads.emplace_back([&, w]() {
+            Worker *worker = workers[w].get();
+            size_t item;
+            bool stolen;
+            while (take_work(queues, w, &item, &stolen)) {
+                worker->totals.steals += stolen;
+                evaluate_file(worker, options, items[item], &results[item]);
+                done++;
+                done_changed.notify_one();
+            }
+        });
+    }
+
+    // 진행 상황 (터미널일 때만)
+    const bool progress = isatty(fileno(stderr));
+    std::unique_lock<std::mutex> lock(done_mutex);
+    while (!done_changed.wait_for(lock, std::chrono::milliseconds(500), [&]() { return done == items.size(); })) {
+        if (progress) {
+            fprintf(stderr, "\r%lu / %lu files", (unsigned long)done.load(), (unsigned long)items.size());
+        }
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (progress) {
+        fprintf(stderr, "\n");
+    }
+
+    Totals totals;
+    for (unsigned w = 0; w < jobs; w++) {
+        totals.add(workers[w]->totals);
+        wake_word_sim_free(&workers[w]->sim);
+    }
+    for (size_t i = 0; i < items.size(); i++) {
+        if (!results[i].ok) {
+            fprintf(stderr, "Failed to read %s\n", items[i].path.c_str());
+        }
+    }
+
+    const double audio_hours = (totals.positive_seconds + totals.negative_seconds) / 3600.0;
+    const double negative_hours = totals.negative_seconds / 3600.0;
+    printf("Audio: %.3f h (positive %lu files %.3f h, negative %lu files %.3f h), %lu failed\n", audio_hours,
+           (unsigned long)totals.positive_files, totals.positive_seconds / 3600.0,
+           (unsigned long)(totals.files - totals.positive_files), negative_hours, (unsigned long)totals.failed);
+    printf("Throughput: %.4f audio-h per wall-s (%.0fx realtime), %.2f s wall, %lu hops, %.1f us/invoke\n",
+           audio_hours / wall, audio_hours * 3600.0 / wall, wall, (unsigned long)totals.hops,
+           totals.hops ? totals.invoke_seconds * 1e6 / totals.hops : 0.0);
+    for (unsigned w = 0; w < jobs; w++) {
+        const Totals &t = workers[w]->totals;
+        printf("  worker %u: %lu files, %.3f h, %lu stolen\n", w, (unsigned long)t.files,
+               (t.positive_seconds + t.negative_seconds) / 3600.0, (unsigned long)t.steals);
+    }
+
+    // 라벨 테이블 임계값(펌웨어 동작) 기준
+    const keyword_class_t &positive = model_classes[options.positive_class];
+    printf("Label table (threshold %.2f, smoothing %u, refractory %u): detected %lu / %lu positive files, "
+           "%lu false accepts in %.3f h",
+           positive.threshold, positive.smoothing, positive.refractory, (unsigned long)totals.positive_detected,
+           (unsigned long)totals.positive_files, (unsigned long)totals.negative_detections, negative_hours);
+    if (negative_hours > 0) {
+        printf(" = %.3f FA/h", totals.negative_detections / negative_hours);
+    }
+    printf("\n");
+
+    printf("ROC/DET (smoothed \"%s\" score, refractory %u):\n", positive.label, positive.refractory);
+    printf("  threshold  detection  miss   false_accepts  FA/h\n");
+    for (int t = 0; t < kThresholds; t += 5) {
+        double rate = totals.positive_files ? (double)totals.hits[t] / totals.positive_files : 0.0;
+        printf("  %9.2f  %9.3f  %5.3f  %13lu  %.3f\n", threshold_at(t), rate, 1.0 - rate,
+               (unsigned long)totals.false_accepts[t], negative_hours > 0 ? totals.false_accepts[t] / negative_hours : 0.0);
+    }
+
+    if (scores_path && !write_scores(scores_path, items, results)) {
+        perror(scores_path);
+        return 1;
+    }
+    if (roc_path && !write_roc(roc_path, totals)) {
+        perror(roc_path);
+        return 1;
+    }
+    return totals.failed ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_frontend.h"
+#include "energy_vad.h"
+#include "noise_suppressor.h"
+#include "wav_io.h"
+
+// noise_suppressor.c 평가: 깨끗한 음성(data/ 클립)에 냉장고 소음을 섞어서 잡음 제거 전후 SNR과 처리 시간을 비교
+//
+//   ./eval_noise_suppression ../data/test.wav                     # 합성 컴프레서 소음
+//   ./eval_noise_suppression ../data/test.wav --noise fridge.wav   # 녹음한 소음 (반복해서 씀)
+//   ./eval_noise_suppression ../data/test.wav --write out          # out_<SNR>dB_{noisy,clean}.wav 저장
+//
+// 펌웨어와 같이 32ms 블록마다 VAD를 돌리고, 16ms hop마다 분석 → 잡음 제거 → 합성합니다.
+// 음성 앞에 소음만 있는 구간(LEAD_SECONDS)을 둬서 잡음 추정이 자리잡은 뒤의 성능을 봅니다.
+
+#define SAMPLE_RATE   MODEL_SAMPLE_RATE                 // eval_noise_suppression_8k는 8kHz로 빌드됨
+#define BLOCK_SAMPLES (512 / MODEL_DECIMATION)          // wake_word.cpp의 MODEL_BLOCK_SAMPLES
+#define LEAD_SECONDS  2
+#define TAIL_SECONDS  1
+#define DELAY         FRONTEND_HOP    // 분석/합성 지연
+
+static const int snr_list[] = {-5, 0, 5, 10, 20};
+
+// 합성 컴프레서 소음: 전원 주파수 고조파(60Hz 계열) + 저역 통과한 팬 소음 + 느린 진폭 변동
+static void make_compressor_noise(int16_t *out, size_t count) {
+    uint32_t seed = 2024;
+    double lowpass = 0;
+    for (size_t i = 0; i < count; i++) {
+        double t = (double)i / SAMPLE_RATE;
+        double hum = 0;
+        for (int h = 1; h <= 8; h++) {
+            hum += sin(2 * M_PI * 60 * h * t + h * 0.7) / h;
+        }
+        seed = seed * 1664525u + 1013904223u;
+        double white = ((double)(seed >> 8) / (1 << 24)) * 2 - 1;
+        lowpass += 0.05 * (white - lowpass);
+        double wobble = 1.0 + 0.1 * sin(2 * M_PI * 0.5 * t);
+        double v = 3000 * wobble * hum + 6000 * lowpass + 300 * white;
+        out[i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+}
+
+static double energy(const int16_t *x, size_t count) {
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)x[i] * x[i];
+    }
+    return sum;
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 펌웨어 capture_task와 같은 순서로 처리. 반환값: hop당 평균 처리 시간(µs)
+static double process(int16_t *samples, size_t count) {
+    static audio_frontend_t fe;
+    static noise_suppressor_t ns;
+    noise_suppressor_config_t config;
+    noise_suppressor_default_config(&config, SAMPLE_RATE);
+    audio_frontend_init(&fe);
+    noise_suppressor_init(&ns, &config);
+    energy_vad_t vad;
+    energy_vad_init(&vad);
+
+    double elapsed = 0;
+    size_t hops = 0;
+    for (size_t i = 0; i + BLOCK_SAMPLES <= count; i += BLOCK_SAMPLES) {
+        bool speech = energy_vad_process(&vad, samples + i, BLOCK_SAMPLES);
+        double start = now_us();
+        for (size_t j = 0; j < BLOCK_SAMPLES; j += FRONTEND_HOP) {
+            audio_frontend_analyze(&fe, samples + i + j);
+            noise_suppressor_apply(&ns, &fe, speech);
+            audio_frontend_synthesize(&fe, samples + i + j);
+            hops++;
+        }
+        elapsed += now_us() - start;
+    }
+    return hops ? elapsed / hops : 0;
+}
+
+int main(int argc, char **argv) {
+    const char *clean_path = NULL;
+    const char *noise_path = NULL;
+    const char *write_prefix = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc) {
+            noise_path = argv[++i];
+        } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            write_prefix = argv[++i];
+        } else if (argv[i][0] != '-' && !clean_path) {
+            clean_path = argv[i];
+        } else {
+            clean_path = NULL;
+            break;
+        }
+    }
+    if (!clean_path) {
+        fprintf(stderr, "usage: %s CLEAN.wav [--noise NOISE.wav] [--write PREFIX]\n", argv[0]);
+        return 2;
+    }
+
+    size_t speech_count;
+    int16_t *speech = wav_read_mono(clean_path, SAMPLE_RATE, &speech_count);
+    if (!speech) {
+        fprintf(stderr, "Failed to read %s\n", clean_path);
+        return 1;
+    }
+
+    // [소음만 LEAD_SECONDS][음성 + 소음][소음만 TAIL_SECONDS], 블록 단위로 맞춤
+    const size_t lead = LEAD_SECONDS * SAMPLE_RATE;
+    size_t total = lead + speech_count + TAIL_SECONDS * SAMPLE_RATE;
+    total = (total + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES * BLOCK_SAMPLES;
+
+    int16_t *noise = malloc(total * sizeof(int16_t));
+    int16_t *clean = calloc(total, sizeof(int16_t));
+    int16_t *mixture = malloc(total * sizeof(int16_t));
+    if (noise_path) {
+        size_t noise_count;
+        int16_t *recorded = wav_read_mono(noise_path, SAMPLE_RATE, &noise_count);
+        if (!recorded || noise_count == 0) {
+            fprintf(stderr, "Failed to read %s\n", noise_path);
+            return 1;
+        }
+        for (size_t i = 0; i < total; i++) {
+            noise[i] = recorded[i % noise_count];
+        }
+        free(recorded);
+    } else {
+        make_compressor_noise(noise, total);
+    }
+    memcpy(clean + lead, speech, speech_count * sizeof(int16_t));
+
+    const double speech_energy = energy(speech, speech_count);
+    const double noise_energy = energy(noise + lead, speech_count);
+    printf("Clean: %s (%.2f s), noise: %s\n", clean_path, (double)speech_count / SAMPLE_RATE,
+           noise_path ? noise_path : "synthetic compressor hum");
+    printf("%8s %10s %10s %12s %14s\n", "SNR in", "SNR out", "gain", "noise atten", "us/hop");
+
+    double worst_hop_us = 0;
+    for (size_t s = 0; s < sizeof(snr_list) / sizeof(snr_list[0]); s++) {
+        // 음성 구간 기준으로 원하는 SNR이 되도록 소음 크기 조절
+        double scale = sqrt(speech_energy / (noise_energy * pow(10.0, snr_list[s] / 10.0)));
+        for (size_t i = 0; i < total; i++) {
+            double v = clean[i] + noise[i] * scale;
+            mixture[i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+        }
+        int16_t *output = malloc(total * sizeof(int16_t));
+        memcpy(output, mixture, total * sizeof(int16_t));
+        double hop_us = process(output, total);
+        worst_hop_us = hop_us > worst_hop_us ? hop_us : worst_hop_us;
+
+        // 음성 구간: 깨끗한 음성과의 차이를 잡음+왜곡으로 봄 (출력은 DELAY만큼 늦음)
+        double error_in = 0, error_out = 0;
+        for (size_t i = lead; i < lead + speech_count; i++) {
+            error_in += pow((double)mixture[i] - clean[i], 2);
+            error_out += pow((double)output[i + DELAY] - clean[i], 2);
+        }
+        double snr_in = 10 * log10(speech_energy / error_in);
+        double snr_out = 10 * log10(speech_energy / error_out);
+
+        // 소음만 있는 구간 (앞쪽은 잡음 추정이 자리잡는 시간이라 뒤쪽 절반만)
+        size_t from = lead / 2, to = lead;
+        double atten = 10 * log10(energy(mixture + from, to - from) / energy(output + from + DELAY, to - from));
+
+        printf("%6d dB %7.2f dB %+7.2f dB %9.2f dB %11.2f\n",
+               snr_list[s], snr_out, snr_out - snr_in, atten, hop_us);
+
+        if (write_prefix) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s_%ddB_noisy.wav", write_prefix, snr_list[s]);
+            wav_write_mono(path, SAMPLE_RATE, mixture, total);
+            snprintf(path, sizeof(path), "%s_%ddB_clean.wav", write_prefix, snr_list[s]);
+            wav_write_mono(path, SAMPLE_RATE, output, total);
+        }
+        free(output);
+    }
+
+    // hop 하나(16ms) 안에 처리해야 실시간. 호스트 시간이므로 ESP32에서는 별도로 확인 필요
+    double hop_budget_us = 1e6 * FRONTEND_HOP / SAMPLE_RATE;
+    printf("Host cost: %.2f us per %d-sample hop (%.3f%% of one core in real time)\n",
+           worst_hop_us, FRONTEND_HOP, 100.0 * worst_hop_us / hop_budget_us);
+
+    free(speech);
+    free(noise);
+    free(clean);
+    free(mixture);
+    return 0;
+}
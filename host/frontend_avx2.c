@@ -0,0 +1,152 @@
+#include <immintrin.h>
+#include "frontend_simd_x86.h"
+
+// AVX2 커널 (-mavx2로 컴파일, frontend_simd.c가 CPU를 확인한 뒤에만 부름)
+// 256비트 = 복소수 8개. 남는 부분과 FFT 앞쪽 단계(len <= 8)는 frontend_simd_x86.h의 SSE4.1 커널
+
+static uint32_t avx2_peak(const int16_t *samples, int count) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc = _mm256_or_si256(acc, _mm256_abs_epi16(_mm256_loadu_si256((const __m256i *)(samples + i))));
+    }
+    __m128i half = _mm_or_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 8));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 4));
+    half = _mm_or_si128(half, _mm_srli_si128(half, 2));
+    return ((uint32_t)_mm_cvtsi128_si32(half) & 0xFFFF) | sse_peak(samples + i, count - i);
+}
+
+static void avx2_window(int16_t *spectrum, const int16_t *samples, const int16_t *window, int count, int shift) {
+    const __m256i low16 = _mm256_set1_epi32(0xFFFF);
+    const __m128i s = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(samples + i)));
+        __m256i w = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(window + i)));
+        __m256i v = _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_sll_epi32(x, s), w), 15);
+        _mm256_storeu_si256((__m256i *)(spectrum + 2 * i), _mm256_and_si256(v, low16));
+    }
+    sse_window(spectrum + 2 * i, samples + i, window + i, count - i, shift);
+}
+
+static void avx2_power(const int16_t *spectrum, uint32_t *power, int bins) {
+    int k = 0;
+    for (; k + 8 <= bins; k += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(spectrum + 2 * k));
+        _mm256_storeu_si256((__m256i *)(power + k), _mm256_madd_epi16(v, v));
+    }
+    sse_power(spectrum + 2 * k, power + k, bins - k);
+}
+
+static void avx2_mel(const int16_t *spectrum, uint64_t *energy) {
+    uint32_t power[FRONTEND_BINS];
+    avx2_power(spectrum, power, FRONTEND_BINS);
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        const int16_t *weights = dsp_mel.weights_q15 + dsp_mel.offset[m];
+        const uint32_t *p = power + dsp_mel.start[m];
+        const int length = dsp_mel.length[m];
+        __m256i acc = _mm256_setzero_si256();
+        int j = 0;
+        for (; j + 8 <= length; j += 8) {
+            __m256i pv = _mm256_loadu_si256((const __m256i *)(p + j));
+            __m256i w = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(weights + j)));
+            acc = _mm256_add_epi64(acc, _mm256_mul_epu32(pv, w));
+            acc = _mm256_add_epi64(acc, _mm256_mul_epu32(_mm256_srli_epi64(pv, 32), _mm256_srli_epi64(w, 32)));
+        }
+        __m128i acc128 = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        for (; j + 4 <= length; j += 4) {
+            acc128 = sse_mel_accumulate(acc128, p + j, weights + j);
+        }
+        energy[m] = sse_sum_epi64(acc128) + mel_tail(p + j, weights + j, length - j);
+    }
+}
+
+static uint32_t avx2_max_abs(const int16_t *data, int count) {
+    __m256i m = _mm256_setzero_si256();
+    for (int i = 0; i < count; i += 16) {
+        m = _mm256_max_epu16(m, _mm256_abs_epi16(_mm256_loadu_si256((const __m256i *)(data + i))));
+    }
+    __m128i half = _mm_max_epu16(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+    half = _mm_max_epu16(half, _mm_srli_si128(half, 8));
+    half = _mm_max_epu16(half, _mm_srli_si128(half, 4));
+    half = _mm_max_epu16(half, _mm_srli_si128(half, 2));
+    return (uint32_t)_mm_cvtsi128_si32(half) & 0xFFFF;
+}
+
+static void avx2_halve(int16_t *data, int count) {
+    const __m256i one = _mm256_set1_epi16(1);
+    for (int i = 0; i < count; i += 16) {
+        __m256i *p = (__m256i *)(data + i);
+        __m256i x = _mm256_loadu_si256(p);
+        _mm256_storeu_si256(p, _mm256_add_epi16(_mm256_srai_epi16(x, 1), _mm256_and_si256(x, one)));
+    }
+}
+
+// sse_butterfly의 256비트 버전
+static inline void avx2_butterfly(__m256i *a, __m256i *b, __m256i w) {
+    const __m256i round = _mm256_set1_epi32(1 << 14);
+    const __m256i conj = _mm256_set1_epi32((int32_t)0xFFFF0001);
+    const __m256i low16 = _mm256_set1_epi32(0xFFFF);
+    __m256i w_swap = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(w, 0xB1), 0xB1);
+    __m256i tr = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(_mm256_sign_epi16(*b, conj), w), round), 15);
+    __m256i ti = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(*b, w_swap), round), 15);
+    __m256i t = _mm256_or_si256(_mm256_and_si256(tr, low16), _mm256_slli_epi32(ti, 16));
+    *b = _mm256_sub_epi16(*a, t);
+    *a = _mm256_add_epi16(*a, t);
+}
+
+static void avx2_stage(int16_t *data, int n, int len, const uint32_t *w) {
+    const int half = len >> 1;
+    for (int start = 0; start < n; start += len) {
+        for (int k = 0; k < half; k += 8) {
+            __m256i *pa = (__m256i *)(data + 2 * (start + k));
+            __m256i *pb = (__m256i *)(data + 2 * (start + k + half));
+            __m256i a = _mm256_loadu_si256(pa);
+            __m256i b = _mm256_loadu_si256(pb);
+            avx2_butterfly(&a, &b, _mm256_loadu_si256((const __m256i *)(w + k)));
+            _mm256_storeu_si256(pa, a);
+            _mm256_storeu_si256(pb, b);
+        }
+    }
+}
+
+static int avx2_fft(int16_t *data, int log2n, const int16_t *twiddle) {
+    if (log2n < FRONTEND_SIMD_FFT_MIN_LOG2 || log2n > FRONTEND_SIMD_FFT_MAX_LOG2) {
+        return fft_q15(data, log2n, twiddle);
+    }
+    const int n = 1 << log2n;
+    uint32_t w[1 << (FRONTEND_SIMD_FFT_MAX_LOG2 - 1)];
+    int shift = 0;
+
+    fft_bit_reverse(data, n);
+
+    for (int len = 2; len <= n; len <<= 1) {
+        if (avx2_max_abs(data, 2 * n) > FFT_Q15_SCALE_THRESHOLD) {
+            avx2_halve(data, 2 * n);
+            shift++;
+        }
+        if (len == 2) {
+            sse_stage2(data, n, twiddle);
+        } else if (len == 4) {
+            sse_stage4(data, n, twiddle);
+        } else {
+            gather_stage_twiddle(w, twiddle, n, len);
+            if (len == 8) {
+                sse_stage(data, n, len, w);
+            } else {
+                avx2_stage(data, n, len, w);
+            }
+        }
+    }
+    return shift;
+}
+
+const audio_frontend_kernels_t frontend_avx2_kernels = {
+    .name = "avx2",
+    .peak = avx2_peak,
+    .window = avx2_window,
+    .fft = avx2_fft,
+    .power = avx2_power,
+    .mel = avx2_mel,
+};
@@ -0,0 +1,56 @@
+#include "frontend_simd.h"
+#include <stdio.h>
+#include <string.h>
+
+#if FRONTEND_SIMD_X86
+extern const audio_frontend_kernels_t frontend_sse41_kernels;
+extern const audio_frontend_kernels_t frontend_avx2_kernels;
+#endif
+
+static const char *const isa_names[FRONTEND_ISA_COUNT] = {"portable", "sse4.1", "avx2"};
+
+const char *frontend_isa_name(frontend_isa_t isa) {
+    return isa < FRONTEND_ISA_COUNT ? isa_names[isa] : "?";
+}
+
+const audio_frontend_kernels_t *frontend_simd_kernels(frontend_isa_t isa) {
+    switch (isa) {
+    case FRONTEND_ISA_PORTABLE:
+        return &audio_frontend_portable_kernels;
+#if FRONTEND_SIMD_X86
+    case FRONTEND_ISA_SSE41:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1") ? &frontend_sse41_kernels : NULL;
+    case FRONTEND_ISA_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? &frontend_avx2_kernels : NULL;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+const audio_frontend_kernels_t *frontend_simd_install(const char *name) {
+    const audio_frontend_kernels_t *kernels = NULL;
+    if (!name || strcmp(name, "auto") == 0) {
+        for (int isa = FRONTEND_ISA_COUNT - 1; isa >= 0 && !kernels; isa--) {
+            kernels = frontend_simd_kernels((frontend_isa_t)isa);
+        }
+    } else {
+        int isa = 0;
+        while (isa < FRONTEND_ISA_COUNT && strcmp(name, isa_names[isa]) != 0) {
+            isa++;
+        }
+        if (isa == FRONTEND_ISA_COUNT) {
+            fprintf(stderr, "Unknown ISA %s (auto, portable, sse4.1, avx2)\n", name);
+            return NULL;
+        }
+        kernels = frontend_simd_kernels((frontend_isa_t)isa);
+        if (!kernels) {
+            fprintf(stderr, "ISA %s is not supported by this CPU or build\n", name);
+            return NULL;
+        }
+    }
+    audio_frontend_set_kernels(kernels);
+    return kernels;
+}
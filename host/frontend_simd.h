@@ -0,0 +1,39 @@
+#ifndef FRONTEND_SIMD_H
+#define FRONTEND_SIMD_H
+
+#include <stdbool.h>
+#include "audio_frontend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 호스트 도구용 특징 추출 커널 (창, FFT, 파워 스펙트럼, mel 필터뱅크)의 SSE4.1/AVX2 버전과 실행 중 CPU 선택
+// - 장치에서 실행하는 이식 가능한 C 버전(src/audio_frontend.c, fft_q15.c)과 비트 단위로 같은 결과
+//   (같은 정수 연산 순서, 같은 반올림/잘림, FFT는 같은 단계별 스케일링)
+// - ISA별 소스는 그 ISA 옵션으로만 컴파일(-msse4.1, -mavx2)하고, 실행할 때 __builtin_cpu_supports로 확인해서 설치
+// - x86-64가 아닌 호스트에서는 portable만
+// 확인/벤치마크: host/bench_frontend.c
+
+typedef enum {
+    FRONTEND_ISA_PORTABLE,
+    FRONTEND_ISA_SSE41,
+    FRONTEND_ISA_AVX2,
+    FRONTEND_ISA_COUNT,
+} frontend_isa_t;
+
+// "portable", "sse4.1", "avx2"
+const char *frontend_isa_name(frontend_isa_t isa);
+
+// 이 CPU/빌드에서 쓸 수 없으면 NULL
+const audio_frontend_kernels_t *frontend_simd_kernels(frontend_isa_t isa);
+
+// 커널을 골라서 audio_frontend_set_kernels로 설치 (스레드를 만들기 전에)
+// name: NULL 또는 "auto"면 쓸 수 있는 것 중 가장 빠른 것. 모르는 이름이거나 쓸 수 없으면 stderr에 쓰고 NULL
+const audio_frontend_kernels_t *frontend_simd_install(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRONTEND_SIMD_H
@@ -0,0 +1,225 @@
+#ifndef FRONTEND_SIMD_X86_H
+#define FRONTEND_SIMD_X86_H
+
+#include <smmintrin.h>
+#include <stdint.h>
+#include <string.h>
+#include "audio_frontend.h"
+#include "dsp_tables.h"
+#include "fft_q15.h"
+
+// frontend_sse41.c, frontend_avx2.c가 같이 쓰는 SSE4.1 커널 (각 파일의 -msse4.1/-mavx2로 컴파일됨)
+// 복소수 하나(int16 실수, 허수)를 32비트 레인 하나로 다룸. 비트 단위로 같게 하기 위한 규칙:
+// - int32 곱/합은 이식 가능한 C와 같은 값 (_mm_madd_epi16은 두 곱이 모두 -32768 * -32768일 때만 넘치는데,
+//   그 값의 비트는 C의 (uint32_t)(re * re) + (uint32_t)(im * im)과 같음)
+// - int16으로 바꿀 때는 포화(packs)가 아니라 하위 16비트 (C의 (int16_t) 변환과 같음)
+// - FFT 버터플라이 입력은 단계별 스케일링 덕분에 |값| <= 16384라서 허수부 부호를 바꿔도 넘치지 않음
+
+// 지원하는 FFT 크기 (단계별 트위들을 스택에 모음). 밖이면 fft_q15
+#define FRONTEND_SIMD_FFT_MIN_LOG2 3
+#define FRONTEND_SIMD_FFT_MAX_LOG2 12
+
+static inline uint32_t sse_peak(const int16_t *samples, int count) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // _mm_abs_epi16(-32768) = 0x8000: 부호 없는 16비트로 보면 C와 같은 32768
+        acc = _mm_or_si128(acc, _mm_abs_epi16(_mm_loadu_si128((const __m128i *)(samples + i))));
+    }
+    acc = _mm_or_si128(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_or_si128(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_or_si128(acc, _mm_srli_si128(acc, 2));
+    uint32_t peak = (uint32_t)_mm_cvtsi128_si32(acc) & 0xFFFF;
+    for (; i < count; i++) {
+        peak |= (uint32_t)(samples[i] < 0 ? -samples[i] : samples[i]);
+    }
+    return peak;
+}
+
+static inline void sse_window(int16_t *spectrum, const int16_t *samples, const int16_t *window, int count,
+                              int shift) {
+    const __m128i low16 = _mm_set1_epi32(0xFFFF);  // 실수부 = 곱의 하위 16비트, 허수부 = 0
+    const __m128i s = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i x = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)(samples + i)));
+        __m128i w = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)(window + i)));
+        __m128i v = _mm_srai_epi32(_mm_mullo_epi32(_mm_sll_epi32(x, s), w), 15);
+        _mm_storeu_si128((__m128i *)(spectrum + 2 * i), _mm_and_si128(v, low16));
+    }
+    for (; i < count; i++) {
+        spectrum[2 * i] = (int16_t)((((int32_t)samples[i] << shift) * window[i]) >> 15);
+        spectrum[2 * i + 1] = 0;
+    }
+}
+
+static inline void sse_power(const int16_t *spectrum, uint32_t *power, int bins) {
+    int k = 0;
+    for (; k + 4 <= bins; k += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(spectrum + 2 * k));
+        _mm_storeu_si128((__m128i *)(power + k), _mm_madd_epi16(v, v));
+    }
+    for (; k < bins; k++) {
+        int32_t re = spectrum[2 * k], im = spectrum[2 * k + 1];
+        power[k] = (uint32_t)(re * re) + (uint32_t)(im * im);
+    }
+}
+
+// mel: 파워 스펙트럼을 한 번 구한 뒤(bin 하나가 필터 두 개에 걸치므로) 필터마다 power * weight 합
+// power 4개 * weight 4개를 64비트 두 레인에 더함 (짝수/홀수 레인을 _mm_mul_epu32로 따로)
+static inline __m128i sse_mel_accumulate(__m128i acc, const uint32_t *power, const int16_t *weights) {
+    __m128i p = _mm_loadu_si128((const __m128i *)power);
+    // 부호 확장 = C의 (uint32_t)weights[j]
+    __m128i w = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)weights));
+    acc = _mm_add_epi64(acc, _mm_mul_epu32(p, w));
+    return _mm_add_epi64(acc, _mm_mul_epu32(_mm_srli_epi64(p, 32), _mm_srli_epi64(w, 32)));
+}
+
+static inline uint64_t sse_sum_epi64(__m128i v) {
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, v);
+    return lanes[0] + lanes[1];
+}
+
+static inline uint64_t mel_tail(const uint32_t *power, const int16_t *weights, int count) {
+    uint64_t sum = 0;
+    for (int j = 0; j < count; j++) {
+        sum += (uint64_t)power[j] * (uint32_t)weights[j];
+    }
+    return sum;
+}
+
+static inline void sse_mel(const int16_t *spectrum, uint64_t *energy) {
+    uint32_t power[FRONTEND_BINS];
+    sse_power(spectrum, power, FRONTEND_BINS);
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        const int16_t *weights = dsp_mel.weights_q15 + dsp_mel.offset[m];
+        const uint32_t *p = power + dsp_mel.start[m];
+        const int length = dsp_mel.length[m];
+        __m128i acc = _mm_setzero_si128();
+        int j = 0;
+        for (; j + 4 <= length; j += 4) {
+            acc = sse_mel_accumulate(acc, p + j, weights + j);
+        }
+        energy[m] = sse_sum_epi64(acc) + mel_tail(p + j, weights + j, length - j);
+    }
+}
+
+// ---- FFT (fft_q15.c와 같은 단계, 같은 스케일링) ----
+
+static inline void fft_bit_reverse(int16_t *data, int n) {
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            int16_t re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+}
+
+static inline uint32_t sse_max_abs(const int16_t *data, int count) {
+    __m128i m = _mm_setzero_si128();
+    for (int i = 0; i < count; i += 8) {
+        m = _mm_max_epu16(m, _mm_abs_epi16(_mm_loadu_si128((const __m128i *)(data + i))));
+    }
+    m = _mm_max_epu16(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epu16(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epu16(m, _mm_srli_si128(m, 2));
+    return (uint32_t)_mm_cvtsi128_si32(m) & 0xFFFF;
+}
+
+// (x + 1) >> 1을 int16 안에서: (x >> 1) + (x & 1)
+static inline __m128i sse_halve1(__m128i x) {
+    return _mm_add_epi16(_mm_srai_epi16(x, 1), _mm_and_si128(x, _mm_set1_epi16(1)));
+}
+
+static inline void sse_halve(int16_t *data, int count) {
+    for (int i = 0; i < count; i += 8) {
+        __m128i *p = (__m128i *)(data + i);
+        _mm_storeu_si128(p, sse_halve1(_mm_loadu_si128(p)));
+    }
+}
+
+// 레인마다 a' = a + b·w, b' = a - b·w (w: 트위들 {wr, wi})
+static inline void sse_butterfly(__m128i *a, __m128i *b, __m128i w) {
+    const __m128i round = _mm_set1_epi32(1 << 14);
+    const __m128i conj = _mm_set1_epi32((int32_t)0xFFFF0001);  // {1, -1}: {br, -bi}
+    const __m128i low16 = _mm_set1_epi32(0xFFFF);
+    __m128i w_swap = _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, 0xB1), 0xB1);  // {wi, wr}
+    __m128i tr = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_sign_epi16(*b, conj), w), round), 15);
+    __m128i ti = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(*b, w_swap), round), 15);
+    __m128i t = _mm_or_si128(_mm_and_si128(tr, low16), _mm_slli_epi32(ti, 16));
+    *b = _mm_sub_epi16(*a, t);
+    *a = _mm_add_epi16(*a, t);
+}
+
+// 트위들 쌍 하나를 32비트로
+static inline uint32_t twiddle_at(const int16_t *twiddle, int index) {
+    uint32_t w;
+    memcpy(&w, twiddle + 2 * index, sizeof(w));
+    return w;
+}
+
+// len = 2: 복소수 8개 [a0 b0 a1 b1 | a2 b2 a3 b3]씩, 트위들은 모두 w0
+static inline void sse_stage2(int16_t *data, int n, const int16_t *twiddle) {
+    const __m128i w = _mm_set1_epi32((int32_t)twiddle_at(twiddle, 0));
+    for (int i = 0; i < n; i += 8) {
+        __m128i *p = (__m128i *)(data + 2 * i);
+        __m128 v0 = _mm_castsi128_ps(_mm_loadu_si128(p));
+        __m128 v1 = _mm_castsi128_ps(_mm_loadu_si128(p + 1));
+        __m128i a = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i b = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+        sse_butterfly(&a, &b, w);
+        _mm_storeu_si128(p, _mm_unpacklo_epi32(a, b));
+        _mm_storeu_si128(p + 1, _mm_unpackhi_epi32(a, b));
+    }
+}
+
+// len = 4: 블록 두 개 [a0 a1 b0 b1 | c0 c1 d0 d1]씩, 트위들 {w0, w(N/4)}
+static inline void sse_stage4(int16_t *data, int n, const int16_t *twiddle) {
+    const int32_t w0 = (int32_t)twiddle_at(twiddle, 0);
+    const int32_t w1 = (int32_t)twiddle_at(twiddle, n / 4);
+    const __m128i w = _mm_setr_epi32(w0, w1, w0, w1);
+    for (int i = 0; i < n; i += 8) {
+        __m128i *p = (__m128i *)(data + 2 * i);
+        __m128i v0 = _mm_loadu_si128(p);
+        __m128i v1 = _mm_loadu_si128(p + 1);
+        __m128i a = _mm_unpacklo_epi64(v0, v1);
+        __m128i b = _mm_unpackhi_epi64(v0, v1);
+        sse_butterfly(&a, &b, w);
+        _mm_storeu_si128(p, _mm_unpacklo_epi64(a, b));
+        _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(a, b));
+    }
+}
+
+// len >= 8: 단계 트위들(w[k] = twiddle[k * N / len], k < len / 2)을 이어 붙여서 4개씩
+static inline void sse_stage(int16_t *data, int n, int len, const uint32_t *w) {
+    const int half = len >> 1;
+    for (int start = 0; start < n; start += len) {
+        for (int k = 0; k < half; k += 4) {
+            __m128i *pa = (__m128i *)(data + 2 * (start + k));
+            __m128i *pb = (__m128i *)(data + 2 * (start + k + half));
+            __m128i a = _mm_loadu_si128(pa);
+            __m128i b = _mm_loadu_si128(pb);
+            sse_butterfly(&a, &b, _mm_loadu_si128((const __m128i *)(w + k)));
+            _mm_storeu_si128(pa, a);
+            _mm_storeu_si128(pb, b);
+        }
+    }
+}
+
+static inline void gather_stage_twiddle(uint32_t *w, const int16_t *twiddle, int n, int len) {
+    const int step = n / len;
+    for (int k = 0; k < len / 2; k++) {
+        w[k] = twiddle_at(twiddle, k * step);
+    }
+}
+
+#endif // FRONTEND_SIMD_X86_H
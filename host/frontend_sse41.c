@@ -0,0 +1,39 @@
+#include "frontend_simd_x86.h"
+
+// SSE4.1 커널 (-msse4.1로 컴파일, frontend_simd.c가 CPU를 확인한 뒤에만 부름)
+
+static int sse41_fft(int16_t *data, int log2n, const int16_t *twiddle) {
+    if (log2n < FRONTEND_SIMD_FFT_MIN_LOG2 || log2n > FRONTEND_SIMD_FFT_MAX_LOG2) {
+        return fft_q15(data, log2n, twiddle);
+    }
+    const int n = 1 << log2n;
+    uint32_t w[1 << (FRONTEND_SIMD_FFT_MAX_LOG2 - 1)];
+    int shift = 0;
+
+    fft_bit_reverse(data, n);
+
+    for (int len = 2; len <= n; len <<= 1) {
+        if (sse_max_abs(data, 2 * n) > FFT_Q15_SCALE_THRESHOLD) {
+            sse_halve(data, 2 * n);
+            shift++;
+        }
+        if (len == 2) {
+            sse_stage2(data, n, twiddle);
+        } else if (len == 4) {
+            sse_stage4(data, n, twiddle);
+        } else {
+            gather_stage_twiddle(w, twiddle, n, len);
+            sse_stage(data, n, len, w);
+        }
+    }
+    return shift;
+}
+
+const audio_frontend_kernels_t frontend_sse41_kernels = {
+    .name = "sse4.1",
+    .peak = sse_peak,
+    .window = sse_window,
+    .fft = sse41_fft,
+    .power = sse_power,
+    .mel = sse_mel,
+};
@@ -0,0 +1,566 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "frontend_simd.h"
+#include "keyword_detector.h"
+#include "model_runner.h"
+#include "wake_word_model.h"
+#include "wake_word_sim.h"
+#include "wav_io.h"
+
+// 골든 벡터: 고정 입력 클립에 대한 단계별 중간 결과를 파일로 저장해두고, 코드 수정 후 다시 돌려서 허용 오차로 비교
+// 양자화, 커널, 전처리(front-end) 최적화가 결과를 조용히 바꾸지 않았는지 확인합니다.
+// (bench_conditioning --golden의 파이프라인 전체 버전)
+//
+//   ./golden_vectors --write data/golden_vectors.bin [clip.wav ...]   # 기본 클립: data/test.wav
+//   ./golden_vectors --check data/golden_vectors.bin                  # 다시 실행해서 비교 (다르면 1 반환)
+//   ./golden_vectors --check data/golden_vectors.bin --tol-score 0.01 --model new_model.tflite
+//   ./golden_vectors --check data/golden_vectors.bin --isa portable   # 특징 추출 커널 (기본 auto, frontend_simd.h)
+//
+// 단계 (wake_word.cpp와 같은 순서, host/wake_word_sim.c):
+//   capture   캡처 블록마다 capture_pipeline 출력 (int16, MODEL_SAMPLE_RATE)
+//   features  잡음 제거 hop마다 잡음 제거된 스펙트럼의 로그 mel 에너지 (int32 log2 Q10, audio_frontend_mel)
+//   input     추론마다 링 버퍼 위치, 모델 입력 창(int16) CRC32 (PCM 주입 HOP 줄의 CRC와 같음)
+//   layer     추론마다 연산자 출력 (TFLM 빌드만, preserve_all_tensors)
+//   scores    추론마다 클래스별 확률 (float)
+//   detection 추론마다 keyword_detector 결과 (int32, 검출 없으면 -1)
+// 입력 샘플(I2S_SAMPLE_RATE, 캡처 블록 배수로 무음 채움)도 파일에 들어 있으므로 비교할 때 WAV가 없어도 되고,
+// scripts/pcm_inject.py --golden이 같은 샘플을 장치에 주입해서 input/scores/detection을 장치 결과와 비교합니다.
+// 모델(백엔드, 모델 CRC)이 기록할 때와 다르면 layer/scores/detection은 건너뜁니다.
+//
+// 파일 형식 (little-endian, scripts/golden_vectors.py가 같은 형식을 읽음):
+//   헤더   "GOLD" u16 버전 u16 MODEL_SAMPLE_RATE u16 I2S_SAMPLE_RATE u16 캡처 블록
+//          u32 추론 간격 u32 첫 추론 u32 창 길이 char[8] 백엔드 u32 모델 CRC32 u32 클립 수
+//   클립   u16 이름 길이, 이름, u32 레코드 수
+//   레코드 u8 단계 u8 형식 u16 번호(연산자 출력 순서) u32 순번(블록/hop/추론) u32 원소 수, 데이터
+
+namespace {
+
+constexpr uint16_t kGoldenVersion = 1;
+
+enum Stage : uint8_t {
+    kStageSource = 0,
+    kStageCapture = 1,
+    kStageFeatures = 2,
+    kStageInput = 3,
+    kStageLayer = 4,
+    kStageScores = 5,
+    kStageDetection = 6,
+    kStageCount,
+};
+
+const char *const kStageNames[kStageCount] = {"source", "capture", "features", "input", "layer", "scores", "detection"};
+
+// ModelDataType 뒤에 이어서
+constexpr uint8_t kTypeUint32 = 4;
+
+size_t type_size(uint8_t type) {
+    return type == kModelInt8 ? 1 : (type == kModelInt16 ? 2 : 4);
+}
+
+struct Record {
+    uint8_t stage;
+    uint8_t type;
+    uint16_t index;
+    uint32_t sequence;
+    std::vector<uint8_t> data;
+
+    size_t count() const { return data.size() / type_size(type); }
+    double value(size_t i) const {
+        const uint8_t *p = data.data() + i * type_size(type);
+        switch (type) {
+            case kModelInt8: return (int8_t)p[0];
+            case kModelInt16: { int16_t v; memcpy(&v, p, 2); return v; }
+            case kModelInt32: { int32_t v; memcpy(&v, p, 4); return v; }
+            case kModelFloat32: { float v; memcpy(&v, p, 4); return v; }
+            default: { uint32_t v; memcpy(&v, p, 4); return v; }
+        }
+    }
+};
+
+struct Clip {
+    std::string name;
+    std::vector<Record> records;
+};
+
+struct Golden {
+    uint16_t model_rate = MODEL_SAMPLE_RATE;
+    uint16_t i2s_rate = I2S_SAMPLE_RATE;
+    uint16_t block = SIM_CAPTURE_BLOCK_SAMPLES;
+    uint32_t hop = SIM_INFERENCE_HOP_SAMPLES;
+    uint32_t first = SIM_FIRST_INFERENCE_SAMPLES;
+    uint32_t window = 0;
+    std::string backend;
+    uint32_t model_crc = 0;
+    std::vector<Clip> clips;
+};
+
+void add_record(Clip *clip, uint8_t stage, uint8_t type, uint16_t index, uint32_t sequence, const void *data,
+                size_t count) {
+    Record record{stage, type, index, sequence, {}};
+    record.data.assign((const uint8_t *)data, (const uint8_t *)data + count * type_size(type));
+    clip->records.push_back(std::move(record));
+}
+
+// 클립 하나를 펌웨어와 같은 경로로 실행하면서 단계별 결과를 기록 ------------------------------------
+
+struct Recorder {
+    Clip *clip;
+    uint32_t feature_hops;
+};
+
+void record_features(void *user, const audio_frontend_t *frontend) {
+    Recorder *recorder = static_cast<Recorder *>(user);
+    int32_t mel[FRONTEND_MEL_BINS];
+    audio_frontend_mel(frontend, mel);
+    add_record(recorder->clip, kStageFeatures, kModelInt32, 0, recorder->feature_hops++, mel, FRONTEND_MEL_BINS);
+}
+
+bool run_clip(wake_word_sim_t *sim, ModelRunner *runner, keyword_detector_t *detector, const std::vector<int16_t> &source,
+              Clip *clip) {
+    Recorder recorder{clip, 0};
+    wake_word_sim_reset(sim);
+    sim->pipeline.hop_hook = record_features;
+    sim->pipeline.hop_hook_user = &recorder;
+    keyword_detector_reset(detector);
+
+    int16_t block[SIM_CAPTURE_BLOCK_SAMPLES];
+    float scores[KEYWORD_MAX_CLASSES];
+    uint32_t inferences = 0;
+    for (size_t offset = 0; offset < source.size(); offset += SIM_CAPTURE_BLOCK_SAMPLES) {
+        memcpy(block, source.data() + offset, sizeof(block));
+        uint32_t position;
+        const int16_t *window = wake_word_sim_block(sim, block, SIM_CAPTURE_BLOCK_SAMPLES, &position);
+        add_record(clip, kStageCapture, kModelInt16, 0, offset / SIM_CAPTURE_BLOCK_SAMPLES, block, SIM_MODEL_BLOCK_SAMPLES);
+        if (!window) {
+            continue;
+        }
+
+        const uint32_t input[2] = {position, wake_word_sim_crc32(0, (const uint8_t *)window, sim->window * sizeof(int16_t))};
+        add_record(clip, kStageInput, kTypeUint32, 0, inferences, input, 2);
+        if (!model_runner_invoke(runner, window, scores)) {
+            return false;
+        }
+        std::vector<ModelLayer> layers = model_runner_layers(runner);
+        for (size_t i = 0; i < layers.size(); i++) {
+            add_record(clip, kStageLayer, layers[i].type, (uint16_t)i, inferences, layers[i].data, layers[i].count);
+        }
+        add_record(clip, kStageScores, kModelFloat32, 0, inferences, scores, runner->num_classes);
+        const int32_t detected = keyword_detector_update(detector, scores, runner->num_classes, nullptr);
+        add_record(clip, kStageDetection, kModelInt32, 0, inferences, &detected, 1);
+        inferences++;
+    }
+    sim->pipeline.hop_hook = nullptr;
+    return true;
+}
+
+// 파일 입출력 -------------------------------------------------------------------------------------
+
+void put(std::vector<uint8_t> *out, const void *data, size_t size) {
+    out->insert(out->end(), (const uint8_t *)data, (const uint8_t *)data + size);
+}
+
+bool write_golden(const char *path, const Golden &golden) {
+    std::vector<uint8_t> out;
+    char backend[8] = {};
+    strncpy(backend, golden.backend.c_str(), sizeof(backend) - 1);
+    const uint32_t clips = (uint32_t)golden.clips.size();
+    put(&out, "GOLD", 4);
+    put(&out, &kGoldenVersion, 2);
+    put(&out, &golden.model_rate, 2);
+    put(&out, &golden.i2s_rate, 2);
+    put(&out, &golden.block, 2);
+    put(&out, &golden.hop, 4);
+    put(&out, &golden.first, 4);
+    put(&out, &golden.window, 4);
+    put(&out, backend, sizeof(backend));
+    put(&out, &golden.model_crc, 4);
+    put(&out, &clips, 4);
+    for (const Clip &clip : golden.clips) {
+        const uint16_t name_length = (uint16_t)clip.name.size();
+        const uint32_t records = (uint32_t)clip.records.size();
+        put(&out, &name_length, 2);
+        put(&out, clip.name.data(), name_length);
+        put(&out, &records, 4);
+        for (const Record &record : clip.records) {
+            const uint32_t count = (uint32_t)record.count();
+            put(&out, &record.stage, 1);
+            put(&out, &record.type, 1);
+            put(&out, &record.index, 2);
+            put(&out, &record.sequence, 4);
+            put(&out, &count, 4);
+            put(&out, record.data.data(), record.data.size());
+        }
+    }
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+    printf("Wrote %s: %lu clips, %lu bytes\n", path, (unsigned long)clips, (unsigned long)out.size());
+    return fclose(f) == 0 && ok;
+}
+
+struct Reader {
+    std::vector<uint8_t> data;
+    size_t offset = 0;
+    bool ok = true;
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (offset + sizeof(T) > data.size()) {
+            ok = false;
+            return value;
+        }
+        memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+    bool bytes(void *out, size_t size) {
+        if (offset + size > data.size()) {
+            ok = false;
+            return false;
+        }
+        memcpy(out, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+};
+
+bool read_golden(const char *path, Golden *golden) {
+    Reader reader;
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        reader.data.insert(reader.data.end(), chunk, chunk + n);
+    }
+    fclose(f);
+
+    char magic[4];
+    char backend[8];
+    if (!reader.bytes(magic, 4) || memcmp(magic, "GOLD", 4) != 0 || reader.get<uint16_t>() != kGoldenVersion) {
+        return false;
+    }
+    golden->model_rate = reader.get<uint16_t>();
+    golden->i2s_rate = reader.get<uint16_t>();
+    golden->block = reader.get<uint16_t>();
+    golden->hop = reader.get<uint32_t>();
+    golden->first = reader.get<uint32_t>();
+    golden->window = reader.get<uint32_t>();
+    reader.bytes(backend, sizeof(backend));
+    backend[sizeof(backend) - 1] = '\0';
+    golden->backend = backend;
+    golden->model_crc = reader.get<uint32_t>();
+    uint32_t clips = reader.get<uint32_t>();
+    for (uint32_t c = 0; c < clips && reader.ok; c++) {
+        Clip clip;
+        clip.name.resize(reader.get<uint16_t>());
+        reader.bytes(&clip.name[0], clip.name.size());
+        uint32_t records = reader.get<uint32_t>();
+        for (uint32_t r = 0; r < records && reader.ok; r++) {
+            Record record;
+            record.stage = reader.get<uint8_t>();
+            record.type = reader.get<uint8_t>();
+            record.index = reader.get<uint16_t>();
+            record.sequence = reader.get<uint32_t>();
+            record.data.resize(reader.get<uint32_t>() * type_size(record.type));
+            reader.bytes(record.data.data(), record.data.size());
+            if (record.stage >= kStageCount || record.type > kTypeUint32) {
+                reader.ok = false;
+            }
+            clip.records.push_back(std::move(record));
+        }
+        golden->clips.push_back(std::move(clip));
+    }
+    return reader.ok;
+}
+
+// 비교 ---------------------------------------------------------------------------------------------
+
+struct Tolerances {
+    double audio = 0;       // capture (LSB)
+    double features = 0;    // features (log2 Q10)
+    double integer = 0;     // 정수 layer (양자화 단계)
+    double floating = 1e-6; // float layer
+    double score = 1e-6;    // scores
+};
+
+struct StageDiff {
+    std::string name;
+    size_t records = 0;
+    size_t failed = 0;
+    double max_diff = 0.0;
+    long first_failed = -1;  // 처음 허용 오차를 넘은 순번
+};
+
+double tolerance_for(const Record &record, const Tolerances &tol) {
+    switch (record.stage) {
+        case kStageCapture: return tol.audio;
+        case kStageFeatures: return tol.features;
+        case kStageLayer: return record.type == kModelFloat32 ? tol.floating : tol.integer;
+        case kStageScores: return tol.score;
+        default: return 0;  // input(위치, CRC), detection은 정확히 같아야 함
+    }
+}
+
+double record_diff(const Record &a, const Record &b) {
+    if (a.type != b.type || a.count() != b.count()) {
+        return INFINITY;
+    }
+    double diff = 0.0;
+    for (size_t i = 0; i < a.count(); i++) {
+        diff = std::fmax(diff, std::fabs(a.value(i) - b.value(i)));
+    }
+    return diff;
+}
+
+// 클립 하나 비교, 허용 오차를 넘은 레코드 수를 반환
+size_t compare_clip(const Clip &expected, const Clip &actual, bool compare_model, const Tolerances &tol,
+                    const std::vector<ModelLayer> &layers) {
+    std::map<std::tuple<uint8_t, uint16_t, uint32_t>, const Record *> index;
+    for (const Record &record : actual.records) {
+        index[std::make_tuple(record.stage, record.index, record.sequence)] = &record;
+    }
+
+    std::map<std::pair<uint8_t, uint16_t>, StageDiff> stages;
+    size_t failures = 0, skipped = 0;
+    for (const Record &record : expected.records) {
+        if (record.stage == kStageSource) {
+            continue;
+        }
+        const bool model_stage = record.stage >= kStageLayer;
+        if (model_stage && !compare_model) {
+            skipped++;
+            continue;
+        }
+        StageDiff &stage = stages[std::make_pair(record.stage, record.index)];
+        if (stage.name.empty()) {
+            stage.name = kStageNames[record.stage];
+            if (record.stage == kStageLayer) {
+                stage.name += " " + std::to_string(record.index);
+                if (record.index < layers.size()) {
+                    stage.name += " " + layers[record.index].name;
+                }
+            }
+        }
+        stage.records++;
+        auto it = index.find(std::make_tuple(record.stage, record.index, record.sequence));
+        double diff = INFINITY;
+        if (it != index.end()) {
+            // 오디오 허용 오차가 있으면 모델 입력 창 CRC는 달라지는 것이 당연하므로 위치만 비교
+            diff = record.stage == kStageInput && tol.audio > 0 ? std::fabs(record.value(0) - it->second->value(0))
+                                                                 : record_diff(record, *it->second);
+        }
+        stage.max_diff = std::fmax(stage.max_diff, diff);
+        if (diff > tolerance_for(record, tol)) {
+            stage.failed++;
+            failures++;
+            if (stage.first_failed < 0) {
+                stage.first_failed = record.sequence;
+            }
+        }
+    }
+
+    // 새로 생긴 레코드 (추론 횟수가 늘어난 경우 등)
+    size_t extra = actual.records.size() > expected.records.size() ? actual.records.size() - expected.records.size() : 0;
+    printf("%s:\n", expected.name.c_str());
+    printf("  %-24s %8s %8s %12s %8s\n", "stage", "records", "failed", "max_diff", "first");
+    for (const auto &entry : stages) {
+        const StageDiff &s = entry.second;
+        printf("  %-24s %8lu %8lu %12.6g %8ld\n", s.name.c_str(), (unsigned long)s.records, (unsigned long)s.failed,
+               s.max_diff, s.first_failed);
+    }
+    if (skipped) {
+        printf("  (%lu model records skipped: model differs from the recording)\n", (unsigned long)skipped);
+    }
+    if (extra) {
+        printf("  %lu more records than the recording\n", (unsigned long)extra);
+        failures += extra;
+    }
+    return failures;
+}
+
+uint32_t model_crc(const std::vector<uint8_t> &model_file) {
+    return model_file.empty() ? wake_word_sim_crc32(0, model_tflite, model_tflite_len)
+                              : wake_word_sim_crc32(0, model_file.data(), model_file.size());
+}
+
+int usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s --write FILE [clip.wav ...] [--model model.tflite] [--arena BYTES]\n"
+            "       %s --check FILE [--model model.tflite] [--arena BYTES] [--tol-audio N] [--tol-features N]\n"
+            "          [--tol-int N] [--tol-float X] [--tol-score X]\n"
+            "       (both) [--isa auto|portable|sse4.1|avx2]\n",
+            program, program);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const char *write_path = nullptr;
+    const char *check_path = nullptr;
+    const char *model_path = nullptr;
+    size_t arena_size = 4 * kModelTensorArenaSize;  // preserve_all_tensors는 아레나를 재사용하지 않음
+    Tolerances tol;
+    const char *isa = nullptr;
+    std::vector<std::string> clips;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            write_path = argv[++i];
+        } else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            check_path = argv[++i];
+        } else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+            model_path = argv[++i];
+        } else if (strcmp(argv[i], "--arena") == 0 && i + 1 < argc) {
+            arena_size = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--tol-audio") == 0 && i + 1 < argc) {
+            tol.audio = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tol-features") == 0 && i + 1 < argc) {
+            tol.features = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tol-int") == 0 && i + 1 < argc) {
+            tol.integer = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tol-float") == 0 && i + 1 < argc) {
+            tol.floating = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tol-score") == 0 && i + 1 < argc) {
+            tol.score = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+            isa = argv[++i];
+        } else if (argv[i][0] != '-') {
+            clips.push_back(argv[i]);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (!write_path == !check_path) {
+        return usage(argv[0]);
+    }
+    if (!frontend_simd_install(isa)) {
+        return 2;
+    }
+
+    std::vector<uint8_t> model_file;
+    if (model_path) {
+        FILE *f = fopen(model_path, "rb");
+        if (!f) {
+            perror(model_path);
+            return 1;
+        }
+        uint8_t chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            model_file.insert(model_file.end(), chunk, chunk + n);
+        }
+        fclose(f);
+    }
+
+    static wake_word_sim_t sim;
+    ModelRunner runner;
+    keyword_detector_t detector;
+    std::string error;
+    if (!wake_word_sim_init(&sim) ||
+        !model_runner_init(&runner, model_file.empty() ? model_tflite : model_file.data(), arena_size, model_classes,
+                           model_classes_len, true, &error)) {
+        fprintf(stderr, "Init failed: %s\n", error.c_str());
+        return 1;
+    }
+    if (runner.window == 0 || runner.window > SIM_MODEL_WINDOW_MAX_SAMPLES || runner.num_classes != model_classes_len ||
+        !keyword_detector_init(&detector, model_classes, model_classes_len)) {
+        fprintf(stderr, "Model does not match this build (window %lu, %lu classes)\n", (unsigned long)runner.window,
+                (unsigned long)runner.num_classes);
+        return 1;
+    }
+
+    if (write_path) {
+        Golden golden;
+        golden.window = (uint32_t)runner.window;
+        golden.backend = model_runner_backend();
+        golden.model_crc = model_crc(model_file);
+        if (clips.empty()) {
+            clips.push_back("data/test.wav");
+        }
+        sim.hop = golden.hop;
+        sim.first = golden.first;
+        sim.window = golden.window;
+        for (const std::string &path : clips) {
+            size_t count;
+            int16_t *samples = wav_read_mono(path.c_str(), I2S_SAMPLE_RATE, &count);
+            if (!samples) {
+                fprintf(stderr, "Failed to read %s\n", path.c_str());
+                return 1;
+            }
+            // 캡처 블록 배수로 무음 채움 (pcm_inject.py가 마지막 블록을 채우는 것과 같음)
+            std::vector<int16_t> source(samples, samples + count);
+            free(samples);
+            source.resize((count + SIM_CAPTURE_BLOCK_SAMPLES - 1) / SIM_CAPTURE_BLOCK_SAMPLES * SIM_CAPTURE_BLOCK_SAMPLES);
+
+            Clip clip;
+            clip.name = path;
+            add_record(&clip, kStageSource, kModelInt16, 0, 0, source.data(), source.size());
+            if (!run_clip(&sim, &runner, &detector, source, &clip)) {
+                fprintf(stderr, "Invoke failed on %s\n", path.c_str());
+                return 1;
+            }
+            golden.clips.push_back(std::move(clip));
+        }
+        if (!write_golden(write_path, golden)) {
+            perror(write_path);
+            return 1;
+        }
+        return 0;
+    }
+
+    Golden golden;
+    if (!read_golden(check_path, &golden)) {
+        fprintf(stderr, "Failed to read golden vectors from %s\n", check_path);
+        return 1;
+    }
+    if (golden.model_rate != MODEL_SAMPLE_RATE || golden.i2s_rate != I2S_SAMPLE_RATE ||
+        golden.block != SIM_CAPTURE_BLOCK_SAMPLES || golden.window != runner.window) {
+        fprintf(stderr, "Recording (%u/%u Hz, block %u, window %lu) does not match this build (%d/%d Hz, block %d, window %lu)\n",
+                golden.model_rate, golden.i2s_rate, golden.block, (unsigned long)golden.window, MODEL_SAMPLE_RATE,
+                I2S_SAMPLE_RATE, SIM_CAPTURE_BLOCK_SAMPLES, (unsigned long)runner.window);
+        return 1;
+    }
+    const bool compare_model = golden.backend == model_runner_backend() && golden.model_crc == model_crc(model_file);
+    printf("%s: %lu clips, recorded with %s (model %08lx)%s\n", check_path, (unsigned long)golden.clips.size(),
+           golden.backend.c_str(), (unsigned long)golden.model_crc, compare_model ? "" : ", model differs");
+    sim.hop = golden.hop;
+    sim.first = golden.first;
+    sim.window = golden.window;
+
+    size_t failures = 0;
+    for (const Clip &expected : golden.clips) {
+        const Record &source = expected.records.front();
+        if (source.stage != kStageSource) {
+            fprintf(stderr, "%s: no source samples\n", expected.name.c_str());
+            return 1;
+        }
+        std::vector<int16_t> samples(source.count());
+        memcpy(samples.data(), source.data.data(), source.data.size());
+        Clip actual;
+        actual.name = expected.name;
+        if (!run_clip(&sim, &runner, &detector, samples, &actual)) {
+            fprintf(stderr, "Invoke failed on %s\n", expected.name.c_str());
+            return 1;
+        }
+        failures += compare_clip(expected, actual, compare_model, tol, model_runner_layers(&runner));
+    }
+    wake_word_sim_free(&sim);
+    if (failures) {
+        printf("FAILED: %lu records out of tolerance\n", (unsigned long)failures);
+    } else {
+        printf("OK\n");
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+#include "model_runner.h"
+#include <algorithm>
+#include <cmath>
+#include "audio_config.h"
+
+#if HAVE_TFLM
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/schema/schema_utils.h"
+#endif
+
+const char *model_runner_backend() {
+    return HAVE_TFLM ? "TFLM" : "energy";
+}
+
+#if HAVE_TFLM
+
+bool model_runner_init(ModelRunner *runner, const uint8_t *model_data, size_t arena_size, const keyword_class_t *classes,
+                       size_t, bool preserve_layers, std::string *error) {
+    runner->classes = classes;
+    runner->model = tflite::GetModel(model_data);
+    if (runner->model->version() != TFLITE_SCHEMA_VERSION) {
+        *error = "schema version mismatch";
+        return false;
+    }
+    // wake_word.cpp register_ops()와 같은 연산자
+    runner->resolver.AddShape();
+    runner->resolver.AddStridedSlice();
+    runner->resolver.AddPack();
+    runner->resolver.AddReshape();
+    runner->resolver.AddConv2D();
+    runner->resolver.AddMaxPool2D();
+    runner->resolver.AddMean();
+    runner->resolver.AddFullyConnected();
+    runner->resolver.AddSoftmax();
+
+    runner->arena.reset(new uint8_t[arena_size]);
+    runner->interpreter.reset(new tflite::MicroInterpreter(runner->model, runner->resolver, runner->arena.get(), arena_size,
+                                                           nullptr, nullptr, preserve_layers));
+    if (runner->interpreter->AllocateTensors() != kTfLiteOk) {
+        *error = "AllocateTensors failed (--arena)";
+        return false;
+    }
+    runner->input = runner->interpreter->input(0);
+    runner->output = runner->interpreter->output(0);
+
+    // wake_word.cpp tflm_load()와 같이 입력 창 길이, 출력 클래스 수
+    runner->window = 1;
+    for (int d = 0; d < runner->input->dims->size; d++) {
+        runner->window *= runner->input->dims->data[d];
+    }
+    runner->num_classes = runner->output->dims->data[runner->output->dims->size - 1];
+    return true;
+}
+
+bool model_runner_invoke(ModelRunner *runner, const int16_t *window, float *scores) {
+    TfLiteTensor *input = runner->input;
+    if (input->type == kTfLiteInt8) {
+        const float scale = input->params.scale;
+        const int zero_point = input->params.zero_point;
+        for (size_t i = 0; i < runner->window; i++) {
+            int q = static_cast<int>(lroundf(window[i] / 32768.0f / scale)) + zero_point;
+            input->data.int8[i] = static_cast<int8_t>(q < -128 ? -128 : (q > 127 ? 127 : q));
+        }
+    } else {
+        for (size_t i = 0; i < runner->window; i++) {
+            input->data.f[i] = static_cast<float>(window[i]) / 32768.0f;
+        }
+    }
+    if (runner->interpreter->Invoke() != kTfLiteOk) {
+        return false;
+    }
+    TfLiteTensor *output = runner->output;
+    for (size_t c = 0; c < runner->num_classes; c++) {
+        scores[c] = output->type == kTfLiteInt8 ? (output->data.int8[c] - output->params.zero_point) * output->params.scale
+                                                : output->data.f[c];
+    }
+    return true;
+}
+
+// preserve_all_tensors로 만든 인터프리터는 연산자 출력이 Invoke() 뒤에도 남아 있음
+std::vector<ModelLayer> model_runner_layers(const ModelRunner *runner) {
+    std::vector<ModelLayer> layers;
+    const auto *subgraph = runner->model->subgraphs()->Get(0);
+    const auto *opcodes = runner->model->operator_codes();
+    for (const tflite::Operator *op : *subgraph->operators()) {
+        tflite::BuiltinOperator code = tflite::GetBuiltinCode(opcodes->Get(op->opcode_index()));
+        for (int32_t index : *op->outputs()) {
+            TfLiteEvalTensor *tensor = runner->interpreter->GetTensor(index);
+            if (tensor == nullptr) {
+                continue;
+            }
+            size_t count = 1;
+            for (int d = 0; d < tensor->dims->size; d++) {
+                count *= tensor->dims->data[d];
+            }
+            ModelLayer layer;
+            layer.name = tflite::EnumNameBuiltinOperator(code);
+            layer.data = tensor->data.data;
+            layer.count = count;
+            switch (tensor->type) {
+                case kTfLiteInt8: layer.type = kModelInt8; break;
+                case kTfLiteInt16: layer.type = kModelInt16; break;
+                case kTfLiteInt32: layer.type = kModelInt32; break;
+                case kTfLiteFloat32: layer.type = kModelFloat32; break;
+                default: continue;  // 모델이 쓰지 않는 형식
+            }
+            layers.push_back(layer);
+        }
+    }
+    return layers;
+}
+
+#else
+
+bool model_runner_init(ModelRunner *runner, const uint8_t *, size_t, const keyword_class_t *classes, size_t num_classes,
+                       bool, std::string *) {
+    runner->classes = classes;
+    runner->window = MODEL_SAMPLE_RATE;  // 1초 창 (wake_word.cpp MODEL_WINDOW_MAX_SAMPLES)
+    runner->num_classes = num_classes;
+    return true;
+}
+
+// 창 에너지 -60 ~ -10 dBFS → 호출어(첫 클래스) 확률 0 ~ 1, 나머지는 첫 배경 클래스로
+bool model_runner_invoke(ModelRunner *runner, const int16_t *window, float *scores) {
+    double energy = 0.0;
+    for (size_t i = 0; i < runner->window; i++) {
+        energy += (double)window[i] * window[i];
+    }
+    double level = 10.0 * log10(energy / runner->window / (32768.0 * 32768.0) + 1e-12);
+    float score = (float)std::min(1.0, std::max(0.0, (level + 60.0) / 50.0));
+    for (size_t c = 0; c < runner->num_classes; c++) {
+        scores[c] = 0.0f;
+    }
+    scores[0] = score;
+    for (size_t c = 1; c < runner->num_classes; c++) {
+        if (runner->classes[c].background) {
+            scores[c] = 1.0f - score;
+            break;
+        }
+    }
+    return true;
+}
+
+std::vector<ModelLayer> model_runner_layers(const ModelRunner *) {
+    return {};
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef MODEL_RUNNER_H
+#define MODEL_RUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "keyword_detector.h"
+
+#ifndef HAVE_TFLM
+#define HAVE_TFLM 0  // host/CMakeLists.txt에서 -DTFLM_DIR=...을 주면 1
+#endif
+
+#if HAVE_TFLM
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#endif
+
+// 호스트 도구의 모델 실행 (eval_corpus, golden_vectors)
+// 인스턴스마다 인터프리터와 텐서 아레나를 따로 가지므로 스레드마다 하나씩 쓰면 됩니다.
+// 입력 정규화/양자화와 출력 역양자화는 wake_word.cpp fill_input() / read_scores()와 같습니다.
+// TFLM 없이 빌드하면 모델 대신 입력 창 에너지를 호출어 확률로 씁니다. (도구 확인용)
+
+// wake_word.cpp와 같은 값
+constexpr size_t kModelTensorArenaSize = 70 * 1024;  // TENSOR_ARENA_SIZE
+constexpr int kModelOpResolverSize = 9;              // OP_RESOLVER_SIZE
+
+// 텐서 원소 형식 (골든 벡터 파일에도 이 값으로 저장)
+enum ModelDataType : uint8_t {
+    kModelInt8 = 0,
+    kModelInt16 = 1,
+    kModelInt32 = 2,
+    kModelFloat32 = 3,
+};
+
+// 연산자 하나의 출력 (preserve_layers일 때, Invoke() 뒤에 유효)
+struct ModelLayer {
+    std::string name;  // 연산자 이름 (예: CONV_2D)
+    ModelDataType type;
+    const void *data;
+    size_t count;      // 원소 수
+};
+
+struct ModelRunner {
+    size_t window = 0;       // 입력 창 길이 (샘플 수)
+    size_t num_classes = 0;  // 출력 클래스 수
+    const keyword_class_t *classes = nullptr;
+#if HAVE_TFLM
+    std::unique_ptr<uint8_t[]> arena;
+    tflite::MicroMutableOpResolver<kModelOpResolverSize> resolver;
+    std::unique_ptr<tflite::MicroInterpreter> interpreter;
+    const tflite::Model *model = nullptr;
+    TfLiteTensor *input = nullptr;
+    TfLiteTensor *output = nullptr;
+#endif
+};
+
+// "TFLM" 또는 "energy"
+const char *model_runner_backend();
+
+// model: .tflite 데이터 (runner보다 오래 살아 있어야 함), classes: 라벨 테이블 (에너지 점수의 배경 클래스 확인용)
+// preserve_layers: 연산자 출력을 덮어쓰지 않도록 아레나를 재사용하지 않음 (골든 벡터용, 아레나가 더 필요)
+bool model_runner_init(ModelRunner *runner, const uint8_t *model, size_t arena_size, const keyword_class_t *classes,
+                       size_t num_classes, bool preserve_layers, std::string *error);
+
+// window: int16 window 샘플 → scores: 클래스별 확률 (num_classes개)
+bool model_runner_invoke(ModelRunner *runner, const int16_t *window, float *scores);
+
+// 연산자 출력 목록 (preserve_layers가 아니거나 TFLM이 없으면 비어 있음)
+std::vector<ModelLayer> model_runner_layers(const ModelRunner *runner);
+
+#endif // MODEL_RUNNER_H
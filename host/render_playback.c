@@ -0,0 +1,398 @@
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "playback.h"
+#include "wav_io.h"
+
+// playback.c 확인 (호스트 렌더링, speaker.c 재생 서비스의 믹서)
+// - 블록 크기를 무작위로 바꿔도 결과가 같은지 (클립 경계가 블록과 상관없이 끊김 없이 이어지는지)
+// - 클립 두 개를 이었을 때 이음매에서 샘플이 빠지거나 0이 끼지 않는지 (음량 1.0이면 비트 단위로 같음)
+// - 두 보이스 믹스가 int16을 넘을 때 뒤집히지 않고 포화되는지
+// - 톤: 주파수, 순도(고조파/보간 잡음), 어택/릴리즈(딸깍 없음), 지수 감쇠
+// - 멈춤/끼어들기: PLAYBACK_FADE_SAMPLES 안에 0이 되고 다음 클립이 바로 이어지는지
+// - 여러 스레드에서 동시에 명령을 넣을 때 (락 없는 큐) 잃거나 겹치는 명령이 없는지, 스레드별 순서가 맞는지
+// - 블록(PLAYBACK_BLOCK 256 샘플 = 32ms) 하나를 만드는 시간
+//
+//   ./render_playback [--out playback.wav]   (--out: 차임, 안내 음성 두 번 + 비프, 에러음을 8kHz WAV로)
+//
+// 기준을 만족하지 못하면 FAILED를 출력하고 1을 반환합니다.
+
+#define RATE PLAYBACK_SAMPLE_RATE
+#define BLOCK 256
+#define PRODUCERS 4
+#define PER_PRODUCER 2000
+
+static int failures;
+
+static void check(int condition, const char *what) {
+    if (!condition) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t rng_state = 1;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// 말소리 대신 쓰는 가짜 안내 음성 (주파수가 바뀌는 톤 + 음절처럼 켜졌다 꺼짐)
+static int16_t *make_prompt(size_t length) {
+    int16_t *data = malloc(length * sizeof(int16_t));
+    double phase = 0;
+    for (size_t i = 0; i < length; i++) {
+        double t = (double)i / RATE;
+        phase += 2 * M_PI * (180 + 60 * sin(2 * M_PI * 3 * t)) / RATE;
+        double syllable = 0.5 - 0.5 * cos(2 * M_PI * 4 * t);
+        data[i] = (int16_t)lrint(12000 * syllable * (sin(phase) + 0.3 * sin(3 * phase)));
+    }
+    return data;
+}
+
+static void pcm16(playback_clip_t *clip, const int16_t *data, size_t length) {
+    memset(clip, 0, sizeof(*clip));
+    clip->kind = PLAYBACK_PCM16;
+    clip->gain_q15 = 32767;
+    clip->data = data;
+    clip->length = (uint32_t)length;
+}
+
+// 명령을 모두 처음에 넣는 시나리오 (보이스 1은 쉼 클립으로 시작 시각을 맞춤)
+static void queue_scenario(playback_t *p, const int16_t *prompt, size_t prompt_length, const uint8_t *dac_clip,
+                           size_t dac_length) {
+    playback_clip_t clip;
+    playback_sound(p, 1, PLAYBACK_CHIME_UP);
+    memset(&clip, 0, sizeof(clip));
+    clip.kind = PLAYBACK_SILENCE;
+    clip.length = RATE / 2;
+    playback_play(p, 0, &clip);
+    pcm16(&clip, prompt, prompt_length);
+    playback_play(p, 0, &clip);
+    playback_play(p, 0, &clip);
+    clip.kind = PLAYBACK_PCM8;
+    clip.data = dac_clip;
+    clip.length = (uint32_t)dac_length;
+    playback_play(p, 0, &clip);
+    memset(&clip, 0, sizeof(clip));
+    clip.kind = PLAYBACK_SILENCE;
+    clip.length = RATE;
+    playback_play(p, 1, &clip);
+    playback_sound(p, 1, PLAYBACK_BEEP);
+    playback_sound(p, 1, PLAYBACK_ERROR);
+}
+
+static size_t render_all(playback_t *p, int16_t *out, size_t max, int random_blocks) {
+    size_t done = 0;
+    while (done < max) {
+        size_t n = random_blocks ? 1 + rng() % 300 : BLOCK;
+        n = n < max - done ? n : max - done;
+        playback_render(p, out + done, n);
+        done += n;
+        if (playback_idle(p)) {
+            break;
+        }
+    }
+    return done;
+}
+
+// 주파수 f의 에너지 비율 (Goertzel / 전체)
+static double tone_purity(const int16_t *x, size_t n, double f) {
+    double w = 2 * M_PI * f / RATE, c = 2 * cos(w), s1 = 0, s2 = 0, total = 0;
+    for (size_t i = 0; i < n; i++) {
+        double s0 = x[i] + c * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+        total += (double)x[i] * x[i];
+    }
+    double power = s1 * s1 + s2 * s2 - c * s1 * s2;
+    return 2 * power / (n * total);
+}
+
+static int peak(const int16_t *x, size_t n) {
+    int m = 0;
+    for (size_t i = 0; i < n; i++) {
+        m = abs(x[i]) > m ? abs(x[i]) : m;
+    }
+    return m;
+}
+
+static void test_block_sizes(const char *out_path) {
+    size_t prompt_length = RATE * 3 / 2;
+    int16_t *prompt = make_prompt(prompt_length);
+    size_t dac_length = RATE / 2;
+    uint8_t *dac_clip = malloc(dac_length);
+    for (size_t i = 0; i < dac_length; i++) {
+        dac_clip[i] = (uint8_t)(128 + lrint(60 * sin(2 * M_PI * 440.0 * i / RATE)));
+    }
+
+    size_t max = RATE * 10;
+    int16_t *a = calloc(max, sizeof(int16_t));
+    int16_t *b = calloc(max, sizeof(int16_t));
+    static playback_t p;
+    playback_init(&p);
+    queue_scenario(&p, prompt, prompt_length, dac_clip, dac_length);
+    size_t na = render_all(&p, a, max, 0);
+    uint32_t clips = p.stats.clips;
+    playback_init(&p);
+    queue_scenario(&p, prompt, prompt_length, dac_clip, dac_length);
+    size_t nb = render_all(&p, b, max, 1);
+
+    size_t expected = RATE / 2 + 2 * prompt_length + dac_length;
+    printf("Scenario: %zu samples (%.2f s), %u clips, blocks of %d vs random 1..300: %s\n",
+           na, (double)na / RATE, clips, BLOCK, memcmp(a, b, expected * sizeof(int16_t)) == 0 ? "identical" : "DIFFERENT");
+    check(memcmp(a, b, expected * sizeof(int16_t)) == 0, "output depends on block size");
+    check(na >= expected && nb >= expected && clips == 11, "scenario length / clip count");
+
+    // 보이스 하나에 같은 안내 음성 두 번: 출력이 클립을 두 번 이은 것과 같아야 함
+    static playback_t solo;
+    playback_init(&solo);
+    playback_clip_t clip;
+    pcm16(&clip, prompt, prompt_length);
+    playback_play(&solo, 0, &clip);
+    playback_play(&solo, 0, &clip);
+    int16_t *c = calloc(2 * prompt_length + BLOCK, sizeof(int16_t));
+    render_all(&solo, c, 2 * prompt_length + BLOCK, 1);
+    int exact = memcmp(c, prompt, prompt_length * 2) == 0 && memcmp(c + prompt_length, prompt, prompt_length * 2) == 0;
+    printf("Gapless: two %zu-sample clips back to back %s\n", prompt_length, exact ? "bit-exact" : "NOT exact");
+    check(exact, "clips are not joined sample-exact");
+
+    if (out_path) {
+        wav_write_mono(out_path, RATE, a, na);
+        printf("Wrote %s\n", out_path);
+    }
+    free(prompt);
+    free(dac_clip);
+    free(a);
+    free(b);
+    free(c);
+}
+
+static void test_saturation(void) {
+    static int16_t loud[4000];
+    for (size_t i = 0; i < 4000; i++) {
+        loud[i] = (int16_t)lrint(30000 * sin(2 * M_PI * 100.0 * i / RATE));
+    }
+    static playback_t p;
+    playback_init(&p);
+    playback_clip_t clip;
+    pcm16(&clip, loud, 4000);
+    playback_play(&p, 0, &clip);
+    playback_play(&p, 1, &clip);
+    static int16_t out[4000];
+    playback_render(&p, out, 4000);
+    int wrong = 0;
+    for (size_t i = 0; i < 4000; i++) {
+        int32_t sum = 2 * loud[i];
+        int32_t expected = sum > 32767 ? 32767 : (sum < -32768 ? -32768 : sum);
+        wrong += out[i] != expected;
+    }
+    printf("Saturation: %u of 4000 samples clipped, %d wrong\n", p.stats.clipped, wrong);
+    check(wrong == 0 && p.stats.clipped > 1000, "mix does not saturate correctly");
+
+    uint8_t dac[3];
+    int16_t edges[3] = {-32768, 0, 32767};
+    playback_to_dac(edges, dac, 3);
+    check(dac[0] == 0 && dac[1] == 128 && dac[2] == 255, "DAC conversion range");
+}
+
+static void test_tones(void) {
+    static playback_t p;
+    static int16_t out[RATE];
+    playback_init(&p);
+    playback_sound(&p, 0, PLAYBACK_BEEP);
+    playback_render(&p, out, RATE);
+    size_t length = 120 * RATE / 1000;
+    size_t edge = 5 * RATE / 1000;
+
+    // 주파수: 가운데 부분의 영점 통과
+    int crossings = 0;
+    for (size_t i = edge + 1; i < length - edge; i++) {
+        crossings += (out[i - 1] < 0) != (out[i] < 0);
+    }
+    double frequency = crossings / 2.0 / ((double)(length - 2 * edge - 1) / RATE);
+    double purity = tone_purity(out + edge, 800, 1000.0);
+    int amplitude = peak(out + edge, length - 2 * edge);
+    printf("Beep: %.0f Hz, peak %d, %.4f%% energy at 1 kHz (%.1f dB other), first %d, last %d, after %d\n",
+           frequency, amplitude, 100 * purity, 10 * log10(1 - purity + 1e-12), out[0], out[length - 1], peak(out + length, RATE - length));
+    check(fabs(frequency - 1000) < 15, "beep frequency");
+    check(purity > 0.9999, "beep is not a pure sine (wavetable interpolation)");
+    check(abs(amplitude - 16384) < 64, "beep amplitude");
+    check(abs(out[0]) < 10 && abs(out[length - 1]) < 10, "beep starts/ends with a click");
+    check(peak(out + length, RATE - length) == 0, "output after the beep");
+
+    // 종소리 감쇠: 첫 음 220ms, decay 120ms → 120ms 뒤 절반
+    playback_init(&p);
+    playback_sound(&p, 0, PLAYBACK_CHIME_UP);
+    playback_render(&p, out, RATE);
+    int start_peak = peak(out + edge, 40);
+    int later_peak = peak(out + edge + 120 * RATE / 1000, 40);
+    double ratio = (double)later_peak / start_peak;
+    printf("Chime: decay to %.3f after 120 ms (expected 0.5)\n", ratio);
+    check(fabs(ratio - 0.5) < 0.03, "chime decay");
+}
+
+static void test_interrupt(void) {
+    static playback_t p;
+    static int16_t out[2000];
+    playback_init(&p);
+    playback_clip_t tone;
+    playback_tone(&tone, 500, 1000, 0, 20000);
+    playback_play(&p, 0, &tone);
+    playback_render(&p, out, 1000);
+    playback_stop(&p, 0);
+    playback_render(&p, out, 2000);
+    int over = 0;
+    for (int i = 0; i < PLAYBACK_FADE_SAMPLES; i++) {
+        int limit = 20000 * (PLAYBACK_FADE_SAMPLES - i) / PLAYBACK_FADE_SAMPLES + 2;
+        over += abs(out[i]) > limit;
+    }
+    int tail = peak(out + PLAYBACK_FADE_SAMPLES, 2000 - PLAYBACK_FADE_SAMPLES);
+    printf("Stop: faded in %d samples (%d above ramp), %d after\n", PLAYBACK_FADE_SAMPLES, over, tail);
+    check(over == 0 && tail == 0, "stop fade");
+    check(playback_idle(&p), "idle after stop");
+
+    // 끼어들기: 줄이는 동안 새 클립은 기다렸다가 바로 이어짐, 원래 대기열은 버림
+    static int16_t marker[100];
+    for (int i = 0; i < 100; i++) {
+        marker[i] = 1000;
+    }
+    playback_clip_t clip;
+    pcm16(&clip, marker, 100);
+    playback_init(&p);
+    playback_play(&p, 0, &tone);
+    playback_play(&p, 0, &tone);
+    playback_render(&p, out, 333);
+    playback_interrupt(&p, 0, &clip);
+    playback_render(&p, out, 2000);
+    int ok = out[PLAYBACK_FADE_SAMPLES - 1] != 1000 && out[PLAYBACK_FADE_SAMPLES] == 1000 &&
+             out[PLAYBACK_FADE_SAMPLES + 99] == 1000 && peak(out + PLAYBACK_FADE_SAMPLES + 100, 1000) == 0;
+    printf("Interrupt: new clip at sample %d, queue discarded: %s\n", PLAYBACK_FADE_SAMPLES, ok ? "ok" : "WRONG");
+    check(ok, "interrupt");
+}
+
+// ---- 여러 생산자 ----
+
+static playback_t shared;
+static int16_t values[PRODUCERS * PER_PRODUCER];
+static volatile int producers_done;
+
+static void *producer(void *arg) {
+    int id = (int)(long)arg;
+    for (int k = 0; k < PER_PRODUCER; k++) {
+        playback_clip_t clip;
+        pcm16(&clip, &values[k * PRODUCERS + id], 1);
+        while (!playback_play(&shared, 0, &clip)) {
+            sched_yield();  // 가득 참: 재생 태스크가 꺼낼 때까지
+        }
+    }
+    __atomic_fetch_add(&producers_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void test_producers(void) {
+    for (int i = 0; i < PRODUCERS * PER_PRODUCER; i++) {
+        values[i] = (int16_t)(i + 1);  // 값 = k * PRODUCERS + id + 1
+    }
+    playback_init(&shared);
+    pthread_t threads[PRODUCERS];
+    for (long i = 0; i < PRODUCERS; i++) {
+        pthread_create(&threads[i], NULL, producer, (void *)i);
+    }
+    int last[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) {
+        last[i] = -1;
+    }
+    static uint8_t seen[PRODUCERS * PER_PRODUCER + 1];
+    int order_errors = 0, duplicates = 0;
+    size_t played = 0;
+    int16_t out[16];
+    while (1) {
+        int finished = __atomic_load_n(&producers_done, __ATOMIC_ACQUIRE) == PRODUCERS;
+        playback_render(&shared, out, 16);  // 보이스 대기열(8)이 차면 나머지는 명령 큐에서 기다림
+        for (int i = 0; i < 16; i++) {
+            if (out[i] == 0) {
+                continue;
+            }
+            int v = out[i] - 1;
+            int id = v % PRODUCERS, k = v / PRODUCERS;
+            duplicates += seen[out[i]]++ != 0;
+            order_errors += k <= last[id];
+            last[id] = k;
+            played++;
+        }
+        if (finished && playback_idle(&shared)) {
+            break;
+        }
+        sched_yield();
+    }
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    printf("Producers: %d threads x %d commands, played %zu, full-queue retries %u, order errors %d, duplicates %d\n",
+           PRODUCERS, PER_PRODUCER, played, shared.stats.dropped_commands, order_errors, duplicates);
+    check(played == PRODUCERS * PER_PRODUCER, "commands lost");
+    check(order_errors == 0 && duplicates == 0, "command order per producer");
+}
+
+static void test_speed(void) {
+    size_t length = RATE * 4;
+    int16_t *prompt = make_prompt(length);
+    static playback_t p;
+    static int16_t out[BLOCK];
+    double best = 1e9;
+    for (int round = 0; round < 5; round++) {
+        playback_init(&p);
+        playback_clip_t clip, tone;
+        pcm16(&clip, prompt, length);
+        clip.gain_q15 = 26000;  // 음량 곱셈 경로
+        playback_play(&p, 0, &clip);
+        playback_tone(&tone, 880, 4000, 500, 12000);
+        playback_play(&p, 1, &tone);
+        double start = now_us();
+        for (size_t done = 0; done < length; done += BLOCK) {
+            playback_render(&p, out, BLOCK);
+        }
+        double elapsed = now_us() - start;
+        best = elapsed < best ? elapsed : best;
+    }
+    double per_block = best / (length / BLOCK);
+    double block_us = BLOCK * 1e6 / RATE;
+    printf("Render: two voices (prompt with gain + decaying tone) %.2f us per %d-sample block "
+           "(%.0f us available, %.3f%% of real time on this PC)\n", per_block, BLOCK, block_us, 100 * per_block / block_us);
+    free(prompt);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            printf("usage: %s [--out playback.wav]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    test_block_sizes(out_path);
+    test_saturation();
+    test_tones();
+    test_interrupt();
+    test_producers();
+    test_speed();
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
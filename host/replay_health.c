@@ -0,0 +1,166 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_config.h"
+#include "compressor_monitor.h"
+#include "boot_profile.h"
+#include "wav_mmap.h"
+
+// 컴프레서 상태 감시 재생 (호스트): 긴 녹음(몇 시간~며칠)을 캡처 블록 단위로 compressor_monitor에 넣고 요약 줄을 출력
+// - 여러 파일을 주면 순서대로 이어서 하나의 스트림으로 처리 (메모리 맵, 지나간 페이지는 돌려줌)
+// - --synthetic MINUTES: 컴프레서 소리(켜짐/꺼짐 사이클, 기본 주파수 + 배음, 팬 소음, 가끔 큰 소리)를 만들어서 재생하고,
+//   --fault-at 이후에는 3차 배음이 커지고 꺼져 있는 시간이 짧아짐 (베어링 마모/냉매 부족 흉내).
+//   기준을 배운 뒤 고장 전에는 표시가 없고, 고장 뒤에는 표시가 나와야 통과 (아니면 1 반환)
+// - 끝에 오디오 시간 대비 처리 시간(코어 점유율, 호스트 기준)
+//
+//   ./replay_health recording1.wav recording2.wav ...
+//   ./replay_health --synthetic 240 [--fault-at 180] [--quiet]
+
+#define CAPTURE_BLOCK_SAMPLES 512  // wake_word.cpp와 같은 값 (I2S 레이트)
+
+typedef struct {
+    double t;               // 초
+    double phase;           // 기본 주파수 위상 (사이클)
+    uint32_t noise;         // LCG
+    double fault_at;        // 초
+    double next_burst;      // 다음 큰 소리 시각
+} synth_t;
+
+static float synth_noise(synth_t *s) {
+    s->noise = s->noise * 1664525u + 1013904223u;
+    return (float)(int32_t)s->noise / 2147483648.0f;
+}
+
+// 컴프레서: 8분 켜짐 / 12분 꺼짐 (고장 뒤 6분 꺼짐), 49.2Hz + 2, 3차 배음, 켜고 끌 때 1초 램프
+static void synth_block(synth_t *s, int16_t *block, size_t count) {
+    const double dt = 1.0 / I2S_SAMPLE_RATE;
+    for (size_t i = 0; i < count; i++) {
+        bool fault = s->t >= s->fault_at;
+        double on_s = 480.0, off_s = fault ? 360.0 : 720.0;
+        double in_cycle = fmod(s->t, on_s + off_s);
+        double gain = in_cycle < on_s ? fmin(1.0, fmin(in_cycle, on_s - in_cycle)) : 0.0;
+        double f0 = (fault ? 48.4 : 49.2) + 0.05 * sin(2 * M_PI * s->t / 300.0);
+        s->phase += f0 * dt;
+        s->phase -= floor(s->phase);
+        double h3 = fault ? 0.6 : 0.2;
+        double hum = 700.0 * sin(2 * M_PI * s->phase) + 350.0 * sin(4 * M_PI * s->phase) + 700.0 * h3 * sin(6 * M_PI * s->phase);
+        double v = gain * (hum + 120.0 * synth_noise(s)) + 40.0 * synth_noise(s);
+        // 말소리/문 소리 흉내: 약 90초마다 0.4초 큰 잡음
+        if (s->t >= s->next_burst) {
+            v += 6000.0 * synth_noise(s);
+            if (s->t >= s->next_burst + 0.4) {
+                s->next_burst = s->t + 60.0 + 60.0 * (synth_noise(s) + 1.0) / 2.0;
+            }
+        }
+        block[i] = (int16_t)lrint(v);
+        s->t += dt;
+    }
+}
+
+static compressor_monitor_t monitor;
+static bool quiet;
+static double fault_min = -1.0;  // 합성일 때만 (분)
+static double busy_us;
+static uint64_t samples;
+static uint32_t summaries, flagged_before, flagged_after, checked_before, checked_after;
+
+// 블록 하나 처리, 요약이 나오면 출력 (합성이면 고장 전후로 나눠서 표시 횟수를 셈)
+static void process_block(const int16_t *block, size_t count) {
+    int64_t start = boot_profile_now_us();
+    bool done = compressor_monitor_process(&monitor, block, count);
+    busy_us += (double)(boot_profile_now_us() - start);
+    samples += count;
+    if (!done) {
+        return;
+    }
+    summaries++;
+    const compressor_summary_t *s = &monitor.summary;
+    char line[256];
+    compressor_monitor_format(s, line, sizeof(line));
+    if (!quiet || s->flags) {
+        fputs(line, stdout);
+    }
+    if (s->baseline_ready && fault_min >= 0.0) {
+        // 고장 시작 뒤 한 사이클(20분)은 경계로 보고 셈에서 뺌
+        double minute = (double)samples / I2S_SAMPLE_RATE / 60.0;
+        if (minute <= fault_min) {
+            checked_before++;
+            flagged_before += s->flags != 0;
+        } else if (minute > fault_min + 20.0) {
+            checked_after++;
+            flagged_after += s->flags != 0;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    double synthetic_min = 0.0;
+    const char *paths[64];
+    int path_count = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--synthetic") == 0 && i + 1 < argc) {
+            synthetic_min = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--fault-at") == 0 && i + 1 < argc) {
+            fault_min = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (argv[i][0] != '-' && path_count < 64) {
+            paths[path_count++] = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [--quiet] FILE.wav ... | --synthetic MINUTES [--fault-at MINUTES]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (synthetic_min <= 0.0 && path_count == 0) {
+        synthetic_min = 240.0;  // 인자가 없으면 합성 4시간
+    }
+    if (synthetic_min > 0.0 && fault_min < 0.0) {
+        fault_min = synthetic_min * 0.75;
+    }
+
+    compressor_monitor_init(&monitor);
+    printf("Monitor state %u bytes, %d s summaries, baseline %d summaries\n", (unsigned)sizeof(monitor),
+           COMPRESSOR_PERIOD_S, COMPRESSOR_BASELINE_PERIODS);
+
+    int16_t block[CAPTURE_BLOCK_SAMPLES];
+    if (synthetic_min > 0.0) {
+        synth_t synth = {0.0, 0.0, 12345u, fault_min * 60.0, 45.0};
+        const uint64_t total = (uint64_t)(synthetic_min * 60.0 * I2S_SAMPLE_RATE);
+        while (samples < total) {
+            synth_block(&synth, block, CAPTURE_BLOCK_SAMPLES);
+            process_block(block, CAPTURE_BLOCK_SAMPLES);
+        }
+    } else {
+        for (int p = 0; p < path_count; p++) {
+            wav_mmap_t wav;
+            if (!wav_mmap_open(&wav, paths[p])) {
+                fprintf(stderr, "%s: cannot read WAV\n", paths[p]);
+                return 1;
+            }
+            size_t length = wav_mmap_length(&wav, I2S_SAMPLE_RATE);
+            for (size_t offset = 0; offset < length; offset += CAPTURE_BLOCK_SAMPLES) {
+                size_t count = wav_mmap_read_mono(&wav, I2S_SAMPLE_RATE, offset, block, CAPTURE_BLOCK_SAMPLES);
+                count -= count % 8;  // 데시메이터 3단이 같은 위상으로 이어지도록 (마지막 블록)
+                if (count == 0) {
+                    break;
+                }
+                process_block(block, count);
+            }
+            wav_mmap_close(&wav);
+        }
+    }
+
+    double audio_s = (double)samples / I2S_SAMPLE_RATE;
+    printf("%.2f h of audio, %u summaries, %.2f s processing: %.3f%% of one core (host)\n", audio_s / 3600.0,
+           (unsigned)summaries, busy_us / 1e6, 100.0 * busy_us / 1e6 / audio_s);
+
+    if (synthetic_min > 0.0) {
+        printf("Flagged summaries: %u of %u before fault, %u of %u after fault (+20 min)\n", (unsigned)flagged_before,
+               (unsigned)checked_before, (unsigned)flagged_after, (unsigned)checked_after);
+        bool pass = flagged_before == 0 && (checked_after == 0 || flagged_after > 0);
+        printf("%s\n", pass ? "PASS" : "FAIL");
+        return pass ? 0 : 1;
+    }
+    return 0;
+}
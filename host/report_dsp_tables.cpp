@@ -0,0 +1,196 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "audio_frontend.h"
+#include "dsp_tables.h"
+
+// src/dsp_tables.cpp(컴파일 시간 생성, 플래시)와 예전 방식(부팅 시 float로 생성, DRAM) 비교
+// - 테이블마다 런타임 생성 결과와의 최대 차이 (1 LSB 이내여야 함, 넘으면 1 반환)
+// - 런타임 생성 시간 (PC 기준)과 초월함수 호출 횟수, 플래시로 옮긴 바이트 수
+// - mel 필터 확인: 톤을 넣었을 때 가장 큰 mel 필터의 중심 주파수
+//
+//   ./report_dsp_tables
+
+namespace {
+
+constexpr int kLog2Size = 1 << DSP_LOG2_TABLE_BITS;
+constexpr int kExp2Size = 1 << DSP_EXP2_TABLE_BITS;
+
+// 예전 audio_frontend_init_tables() / noise_suppressor_init()과 같은 방식
+struct RuntimeTables {
+    int16_t window[FRONTEND_FFT_SIZE];
+    int16_t twiddle[FRONTEND_FFT_SIZE];
+    uint16_t log2[kLog2Size];
+    uint16_t exp2[kExp2Size];
+    int16_t mel_weights[FRONTEND_MEL_BINS][FRONTEND_BINS];  // 런타임 mel은 bin 전체 행렬로 계산
+};
+
+int transcendental_calls = 0;
+
+int16_t to_q15(float value) {
+    int32_t q = (int32_t)lrintf(value * 32768.0f);
+    return (int16_t)(q > 32767 ? 32767 : (q < -32768 ? -32768 : q));
+}
+
+float hz_to_mel(float hz) {
+    transcendental_calls++;
+    return 1127.0f * logf(1.0f + hz / 700.0f);
+}
+
+float mel_to_hz(float mel) {
+    transcendental_calls++;
+    return 700.0f * (expf(mel / 1127.0f) - 1.0f);
+}
+
+void generate_runtime(RuntimeTables *t) {
+    const float pi = 3.14159265358979f;
+    transcendental_calls = 0;
+    for (int i = 0; i < FRONTEND_FFT_SIZE; i++) {
+        t->window[i] = to_q15(sinf(pi * i / FRONTEND_FFT_SIZE));
+        transcendental_calls++;
+    }
+    for (int k = 0; k < FRONTEND_FFT_SIZE / 2; k++) {
+        t->twiddle[2 * k] = to_q15(cosf(2.0f * pi * k / FRONTEND_FFT_SIZE));
+        t->twiddle[2 * k + 1] = to_q15(-sinf(2.0f * pi * k / FRONTEND_FFT_SIZE));
+        transcendental_calls += 2;
+    }
+    for (int i = 0; i < kLog2Size; i++) {
+        t->log2[i] = (uint16_t)lrintf(log2f(1.0f + (float)i / kLog2Size) * FRONTEND_LOG2_ONE);
+        transcendental_calls++;
+    }
+    for (int i = 0; i < kExp2Size; i++) {
+        int32_t v = (int32_t)lrintf(exp2f(-(float)i / kExp2Size) * 65536.0f);
+        t->exp2[i] = (uint16_t)(v > 65535 ? 65535 : v);
+        transcendental_calls++;
+    }
+    const float mel_low = hz_to_mel(20.0f);
+    const float mel_step = (hz_to_mel(MODEL_SAMPLE_RATE / 2) - mel_low) / (FRONTEND_MEL_BINS + 1);
+    const float bin_hz = (float)MODEL_SAMPLE_RATE / FRONTEND_FFT_SIZE;
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        const float left = mel_to_hz(mel_low + m * mel_step);
+        const float center = mel_to_hz(mel_low + (m + 1) * mel_step);
+        const float right = mel_to_hz(mel_low + (m + 2) * mel_step);
+        for (int k = 0; k < FRONTEND_BINS; k++) {
+            const float hz = k * bin_hz;
+            float weight = 0.0f;
+            if (hz > left && hz <= center) {
+                weight = (hz - left) / (center - left);
+            } else if (hz > center && hz < right) {
+                weight = (right - hz) / (right - center);
+            }
+            t->mel_weights[m][k] = to_q15(weight);
+        }
+    }
+}
+
+template <typename A, typename B>
+int max_difference(const A *a, const B *b, int count) {
+    int worst = 0;
+    for (int i = 0; i < count; i++) {
+        int d = std::abs((int)a[i] - (int)b[i]);
+        worst = d > worst ? d : worst;
+    }
+    return worst;
+}
+
+int mel_difference(const RuntimeTables &t) {
+    int worst = 0;
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        for (int k = 0; k < FRONTEND_BINS; k++) {
+            int j = k - dsp_mel.start[m];
+            int flash = j >= 0 && j < dsp_mel.length[m] ? dsp_mel.weights_q15[dsp_mel.offset[m] + j] : 0;
+            int d = std::abs(flash - t.mel_weights[m][k]);
+            worst = d > worst ? d : worst;
+        }
+    }
+    return worst;
+}
+
+// 다른 설정도 컴파일 시간에 만들 수 있는지 (static_assert 통과) 보여주기 위한 인스턴스
+template <int SampleRate, int FftLog2, int MelBins>
+void print_config() {
+    using G = dsp_tables::Generator<SampleRate, FftLog2, MelBins>;
+    static_assert(G::mel_filters_nonempty(), "빈 mel 필터");
+    constexpr auto bank = G::mel();
+    std::printf("  %5d Hz, FFT %4d, %2d mel: %4zu mel weights, first filter bins %d..%d\n",
+                SampleRate, G::kFftSize, MelBins, bank.weight_count,
+                bank.start[0], bank.start[0] + bank.length[0] - 1);
+}
+
+}  // namespace
+
+int main() {
+    static RuntimeTables runtime;
+
+    // 런타임 생성 시간 (여러 번 반복한 평균)
+    int iterations = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed_us = 0;
+    while (elapsed_us < 200000.0) {
+        generate_runtime(&runtime);
+        iterations++;
+        elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::printf("Configuration: MODEL_SAMPLE_RATE %d, FFT %d, %d mel filters\n\n",
+                MODEL_SAMPLE_RATE, FRONTEND_FFT_SIZE, FRONTEND_MEL_BINS);
+
+    const size_t mel_bytes = sizeof(dsp_mel);
+    const size_t dram_before = sizeof(runtime.window) + sizeof(runtime.twiddle) + sizeof(runtime.log2) + sizeof(runtime.exp2);
+    std::printf("%-10s %8s %12s\n", "table", "bytes", "max diff");
+    std::printf("%-10s %8zu %9d LSB\n", "window", sizeof(dsp_window),
+                max_difference(dsp_window.q15, runtime.window, FRONTEND_FFT_SIZE));
+    std::printf("%-10s %8zu %9d LSB\n", "twiddle", sizeof(dsp_twiddle),
+                max_difference(dsp_twiddle.q15, runtime.twiddle, FRONTEND_FFT_SIZE));
+    std::printf("%-10s %8zu %9d LSB\n", "log2", sizeof(dsp_log2), max_difference(dsp_log2.q10, runtime.log2, kLog2Size));
+    std::printf("%-10s %8zu %9d LSB\n", "exp2", sizeof(dsp_exp2), max_difference(dsp_exp2.q16, runtime.exp2, kExp2Size));
+    std::printf("%-10s %8zu %9d LSB\n", "mel", mel_bytes, mel_difference(runtime));
+
+    std::printf("\nDRAM moved to flash: %zu bytes (window/twiddle/log2/exp2, previously .bss)"
+                " + %zu bytes mel (new, never in DRAM)\n", dram_before, mel_bytes);
+    std::printf("Runtime generation removed from boot: %.1f us on this PC, %d sinf/cosf/log2f/exp2f/logf/expf calls\n",
+                elapsed_us / iterations, transcendental_calls);
+
+    std::printf("\nOther configurations (compile-time):\n");
+    print_config<16000, 9, 40>();
+    print_config<8000, 8, 40>();
+    print_config<16000, 9, 64>();
+    print_config<8000, 8, 32>();
+
+    // mel 필터 확인: 1kHz 톤 → 가장 큰 mel 필터의 중심이 1kHz 근처여야 함
+    static audio_frontend_t fe;
+    audio_frontend_init(&fe);
+    int16_t hop[FRONTEND_HOP];
+    int32_t mel[FRONTEND_MEL_BINS];
+    for (int frame = 0; frame < 4; frame++) {
+        for (int i = 0; i < FRONTEND_HOP; i++) {
+            int n = frame * FRONTEND_HOP + i;
+            hop[i] = (int16_t)lrintf(8000.0f * sinf(2.0f * 3.14159265f * 1000.0f * n / MODEL_SAMPLE_RATE));
+        }
+        audio_frontend_analyze(&fe, hop);
+    }
+    audio_frontend_mel(&fe, mel);
+    int best = 0;
+    for (int m = 1; m < FRONTEND_MEL_BINS; m++) {
+        best = mel[m] > mel[best] ? m : best;
+    }
+    int peak_bin = dsp_mel.start[best];
+    for (int j = 0; j < dsp_mel.length[best]; j++) {
+        if (dsp_mel.weights_q15[dsp_mel.offset[best] + j] > dsp_mel.weights_q15[dsp_mel.offset[best] + peak_bin - dsp_mel.start[best]]) {
+            peak_bin = dsp_mel.start[best] + j;
+        }
+    }
+    float center_hz = (float)peak_bin * MODEL_SAMPLE_RATE / FRONTEND_FFT_SIZE;
+    std::printf("\n1 kHz tone: strongest mel filter %d (center ~%.0f Hz, log2 energy %.2f)\n",
+                best, center_hz, mel[best] / (float)FRONTEND_LOG2_ONE);
+
+    bool ok = max_difference(dsp_window.q15, runtime.window, FRONTEND_FFT_SIZE) <= 1 &&
+              max_difference(dsp_twiddle.q15, runtime.twiddle, FRONTEND_FFT_SIZE) <= 1 &&
+              max_difference(dsp_log2.q10, runtime.log2, kLog2Size) <= 1 &&
+              max_difference(dsp_exp2.q16, runtime.exp2, kExp2Size) <= 1 &&
+              mel_difference(runtime) <= 1 && std::fabs(center_hz - 1000.0f) < 150.0f;
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
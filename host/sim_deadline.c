@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_config.h"
+#include "audio_frontend.h"
+#include "model_scheduler.h"
+#include "deadline_monitor.h"
+#include "boot_profile.h"
+
+// 마감 감시/과부하 정책 확인 (호스트): wake_word.cpp 캡처/추론 태스크를 가상 시각으로 재현하고 단계를 일부러 느리게 함
+// - I2S DMA 큐(dma_desc_num개)에 캡처 블록(32ms)이 들어오고, 큐가 가득 차 있으면 DMA 넘침
+// - 코어 하나: 캡처 태스크(우선순위 높음)가 블록 처리 → 링 버퍼 → 추론 태스크를 깨움
+//   추론 태스크는 hop마다 호출어, 블록마다 소리 이벤트 모델(model_scheduler, 가짜 모델은 가상 시간만 씀)
+//   스케줄러가 재는 실행 시간도 가상 시각 (boot_profile_now_us를 여기서 정의해서 라이브러리 것 대신 링크)
+// - 구간마다 추론 쪽 시간을 몇 배로 늘리고, 한 번은 flash erase처럼 코어 전체를 멈춤
+// 정책을 켠 것과 끈 것(세기만)을 같은 시나리오로 돌려서 비교합니다.
+//   1. 보통 부하: 마감 초과, 건너뛴 hop 없이 normal
+//   2. 과부하: 단계를 낮춰서(shed → slow_hop) 정책이 없을 때보다 마감 초과/건너뛴 hop이 적음
+//   3. 우선순위 0 모델은 멈추지 않음, DMA 넘침은 바로 한 단계 낮춤
+//   4. 부하가 돌아오면 normal로 되돌아옴
+//
+//   ./sim_deadline [--quiet]
+
+#define CAPTURE_BLOCK_SAMPLES 512  // wake_word.cpp와 같은 값
+#define MODEL_BLOCK_SAMPLES (CAPTURE_BLOCK_SAMPLES / MODEL_DECIMATION)
+#define BLOCK_US ((int64_t)MODEL_BLOCK_SAMPLES * 1000000 / MODEL_SAMPLE_RATE)
+#define BLOCK_FRAMES (MODEL_BLOCK_SAMPLES / FRONTEND_HOP)
+#define FRAME_MS (FRONTEND_HOP * 1000 / MODEL_SAMPLE_RATE)
+#define INFERENCE_HOP_MS 100
+#define INFERENCE_HOP_SAMPLES (MODEL_SAMPLE_RATE * INFERENCE_HOP_MS / 1000)
+#define MODEL_WINDOW_SAMPLES MODEL_SAMPLE_RATE
+#define PREROLL_SAMPLES (MODEL_SAMPLE_RATE * 300 / 1000)
+#define DMA_DESC_NUM 4             // 모노 16비트 + BLACKBOX
+#define DEADLINE_CAPTURE_PERCENT 50
+#define DEADLINE_INFERENCE_PERCENT 100
+#define DEADLINE_WAKE_WORD_PERCENT 50
+#define WAKE_WORD_US 9000          // bench_scheduler.c와 같은 가짜 시간
+#define FRONTEND_US 1200
+#define TICK_US 50
+
+typedef struct {
+    const char *name;
+    uint32_t hop_ms;
+    uint8_t priority;
+    uint32_t cost_us;
+    uint32_t runs;
+} fake_model_t;
+
+static fake_model_t fake_models[] = {
+    {"smoke_alarm", 500, 0, 3000, 0},
+    {"glass_break", 250, 1, 5000, 0},
+    {"door_chime", 200, 2, 4000, 0},
+    {"water_leak", 1000, 3, 8000, 0},
+};
+#define FAKE_MODEL_COUNT (sizeof(fake_models) / sizeof(fake_models[0]))
+
+// 시나리오: 구간마다 호출어, 이벤트 모델 시간 배수
+typedef struct {
+    const char *name;
+    int64_t end_us;
+    double wake_load;
+    double event_load;
+} phase_t;
+
+static const phase_t phases[] = {
+    {"normal", 10000000, 1.0, 1.0},
+    {"events x6", 30000000, 1.0, 6.0},     // 이벤트 모델만 느림: 멈추면 충분
+    {"all x5", 45000000, 5.0, 5.0},        // 호출어도 느림: hop까지 늘림
+    {"recover+stall", 100000000, 1.0, 1.0},
+};
+#define PHASE_COUNT (sizeof(phases) / sizeof(phases[0]))
+#define STALL_START_US 70000000    // 코어 전체 멈춤 (flash erase 중 캐시 꺼짐)
+#define STALL_US 200000
+
+typedef struct {
+    uint32_t misses;               // 모든 단계 합
+    uint32_t skipped_hops;
+    uint32_t overruns;
+    uint32_t ring_overflows;
+    uint32_t escalations;
+    uint8_t max_level;
+    uint8_t end_level;
+} phase_result_t;
+
+static int64_t clock_us;           // 가상 시각 (추론 주기 안에서는 가짜 모델이 앞으로 돌림)
+static size_t phase;
+
+int64_t boot_profile_now_us(void) {
+    return clock_us;
+}
+
+static bool run_fake(void *user, uint32_t frame) {
+    (void)frame;
+    fake_model_t *m = (fake_model_t *)user;
+    m->runs++;
+    clock_us += (int64_t)(m->cost_us * phases[phase].event_load);
+    return true;
+}
+
+static uint32_t total_misses(const deadline_monitor_t *m) {
+    uint32_t misses = 0;
+    for (size_t i = 0; i < m->count; i++) {
+        misses += m->stages[i].misses;
+    }
+    return misses;
+}
+
+static size_t ring_capacity(void) {
+    size_t need = MODEL_WINDOW_SAMPLES + PREROLL_SAMPLES + 4 * MODEL_BLOCK_SAMPLES;
+    size_t capacity = 1;
+    while (capacity < need) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// 시나리오 한 번. max_level이 DEADLINE_LEVEL_NORMAL이면 정책 없이 세기만
+static void simulate(uint8_t max_level, bool verbose, phase_result_t *results) {
+    static model_scheduler_t scheduler;
+    static deadline_monitor_t monitor;
+    const uint32_t budget_us = (uint32_t)(BLOCK_US * 60 / 100);  // SCHED_BUDGET_PERCENT
+    model_scheduler_init(&scheduler, budget_us, 8);
+    for (size_t i = 0; i < FAKE_MODEL_COUNT; i++) {
+        fake_models[i].runs = 0;
+        model_scheduler_add(&scheduler, fake_models[i].name, fake_models[i].hop_ms / FRAME_MS, fake_models[i].priority, 0,
+                            run_fake, &fake_models[i]);
+    }
+    const uint32_t hop_us = INFERENCE_HOP_MS * 1000;
+    deadline_monitor_init(&monitor, max_level, 0);
+    int capture = deadline_monitor_add_stage(&monitor, "capture", BLOCK_US, BLOCK_US * DEADLINE_CAPTURE_PERCENT / 100, 0);
+    int inference = deadline_monitor_add_stage(&monitor, "inference", BLOCK_US, BLOCK_US * DEADLINE_INFERENCE_PERCENT / 100, 0);
+    int wake_word = deadline_monitor_add_stage(&monitor, "wake_word", hop_us, hop_us * DEADLINE_WAKE_WORD_PERCENT / 100, BLOCK_US);
+    const uint32_t ring_slack = (uint32_t)(ring_capacity() - MODEL_WINDOW_SAMPLES);
+
+    int64_t next_block = BLOCK_US;
+    int dma_queue = 0;
+    int64_t capture_left = 0;      // 남은 처리 시간 (0이면 쉬는 중)
+    int64_t inference_left = 0;
+    int64_t wake_end = -1;         // 이번 주기에 호출어를 실행했으면 끝나는 시각
+    bool notified = false;
+    uint32_t position = 0;         // 링 버퍼 위치 (샘플)
+    uint32_t frame = 0;
+    uint32_t last_position = 0;    // 마지막으로 추론한 위치
+    uint32_t processed = 0;        // 추론 태스크가 본 위치
+    uint32_t hop = INFERENCE_HOP_SAMPLES;
+
+    phase = 0;
+    phase_result_t start = {0};
+    memset(results, 0, PHASE_COUNT * sizeof(*results));
+    for (int64_t now = 0; phase < PHASE_COUNT; now += TICK_US) {
+        if (now >= phases[phase].end_us) {
+            phase_result_t *r = &results[phase];
+            r->misses = total_misses(&monitor) - start.misses;
+            r->skipped_hops = monitor.skipped_hops - start.skipped_hops;
+            r->overruns = monitor.overruns - start.overruns;
+            r->ring_overflows = monitor.ring_overflows - start.ring_overflows;
+            r->escalations = monitor.escalations - start.escalations;
+            r->end_level = monitor.level;
+            if (verbose) {
+                printf("-- %s (%.0f-%.0f s)\n", phases[phase].name, phase > 0 ? phases[phase - 1].end_us / 1e6 : 0.0,
+                       phases[phase].end_us / 1e6);
+                deadline_monitor_report(&monitor, now);
+            }
+            start.misses = total_misses(&monitor);
+            start.skipped_hops = monitor.skipped_hops;
+            start.overruns = monitor.overruns;
+            start.ring_overflows = monitor.ring_overflows;
+            start.escalations = monitor.escalations;
+            if (++phase == PHASE_COUNT) {
+                break;
+            }
+            results[phase].max_level = monitor.level;
+        }
+        // DMA: 블록이 들어올 자리가 없으면 가장 오래된 블록을 덮어씀
+        if (now >= next_block) {
+            next_block += BLOCK_US;
+            if (dma_queue == DMA_DESC_NUM) {
+                deadline_monitor_overrun(&monitor);
+            } else {
+                dma_queue++;
+            }
+        }
+        if (now >= STALL_START_US && now < STALL_START_US + STALL_US) {
+            continue;
+        }
+
+        // 캡처 태스크 (우선순위 높음)
+        if (capture_left == 0 && dma_queue > 0) {
+            dma_queue--;
+            deadline_monitor_begin(&monitor, capture, now);
+            capture_left = FRONTEND_US;
+        }
+        if (capture_left > 0) {
+            capture_left -= TICK_US;
+            if (capture_left <= 0) {
+                capture_left = 0;
+                position += MODEL_BLOCK_SAMPLES;
+                frame += BLOCK_FRAMES;
+                deadline_monitor_end(&monitor, capture, now + TICK_US);
+                notified = true;
+            }
+            continue;
+        }
+
+        // 추론 태스크: process_audio() 한 주기
+        if (inference_left == 0 && notified) {
+            notified = false;
+            if (position - processed > ring_slack) {
+                deadline_monitor_ring_overflow(&monitor, position - processed - ring_slack);
+            }
+            deadline_monitor_begin(&monitor, inference, now);
+            uint32_t used = 0;
+            wake_end = -1;
+            if (position - last_position >= hop) {
+                uint32_t hops = (position - last_position) / hop;
+                if (hops > 1) {
+                    deadline_monitor_skip(&monitor, hops - 1);
+                }
+                last_position = position;
+                used = (uint32_t)(WAKE_WORD_US * phases[phase].wake_load);
+                deadline_monitor_begin(&monitor, wake_word, now);
+                wake_end = now + used;
+            }
+            if (now + used >= next_block) {
+                used = budget_us;  // 다음 블록이 이미 들어옴
+            }
+            clock_us = wake_end >= 0 ? wake_end : now;
+            model_scheduler_cycle(&scheduler, frame, used);
+            inference_left = clock_us - now + TICK_US;
+            processed = position;
+        }
+        if (inference_left > 0) {
+            inference_left -= TICK_US;
+            if (inference_left <= 0) {
+                inference_left = 0;
+                if (wake_end >= 0) {
+                    deadline_monitor_end(&monitor, wake_word, wake_end);
+                }
+                deadline_monitor_end(&monitor, inference, now + TICK_US);
+                if (deadline_monitor_update(&monitor, now + TICK_US)) {
+                    // wake_word.cpp apply_degradation()과 같음
+                    uint8_t level = monitor.level;
+                    model_scheduler_shed(&scheduler, level >= DEADLINE_LEVEL_SHED ? 1 : 0);
+                    hop = INFERENCE_HOP_SAMPLES << (level >= DEADLINE_LEVEL_SLOW_HOP ? 1 : 0);
+                    uint32_t period = hop_us << (level >= DEADLINE_LEVEL_SLOW_HOP ? 1 : 0);
+                    deadline_monitor_set_period(&monitor, wake_word, period, period * DEADLINE_WAKE_WORD_PERCENT / 100);
+                    if (verbose) {
+                        printf("%6.2f s  level -> %s\n", (now + TICK_US) / 1e6, deadline_monitor_level_name(level));
+                    }
+                    if (level > results[phase].max_level) {
+                        results[phase].max_level = level;
+                    }
+                }
+            }
+        }
+    }
+    if (verbose) {
+        model_scheduler_entry_t *e = scheduler.entries;
+        for (size_t i = 0; i < scheduler.count; i++) {
+            printf("%-12s p%u runs %5u  shed %5u\n", e[i].name, (unsigned)e[i].priority, (unsigned)fake_models[i].runs,
+                   (unsigned)e[i].shed);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    bool verbose = true;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quiet") == 0) {
+            verbose = false;
+        } else {
+            fprintf(stderr, "usage: %s [--quiet]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    phase_result_t with_policy[PHASE_COUNT];
+    phase_result_t without_policy[PHASE_COUNT];
+    printf("Block %lld us, hop %d ms, DMA %d blocks, policy window %d ms\n", (long long)BLOCK_US, INFERENCE_HOP_MS,
+           DMA_DESC_NUM, DEADLINE_WINDOW_MS);
+    printf("== policy on\n");
+    simulate(DEADLINE_LEVEL_SLOW_HOP, verbose, with_policy);
+    uint32_t smoke_runs = fake_models[0].runs;
+    printf("== policy off\n");
+    simulate(DEADLINE_LEVEL_NORMAL, false, without_policy);
+
+    printf("%-14s %22s %22s\n", "", "policy on", "policy off");
+    printf("%-14s %6s %5s %4s %5s %6s %5s %4s %5s\n", "phase", "missed", "skip", "ovr", "max", "missed", "skip", "ovr",
+           "max");
+    for (size_t p = 0; p < PHASE_COUNT; p++) {
+        const phase_result_t *a = &with_policy[p];
+        const phase_result_t *b = &without_policy[p];
+        printf("%-14s %6u %5u %4u %5s %6u %5u %4u %5s\n", phases[p].name, (unsigned)a->misses, (unsigned)a->skipped_hops,
+               (unsigned)a->overruns, deadline_monitor_level_name(a->max_level), (unsigned)b->misses,
+               (unsigned)b->skipped_hops, (unsigned)b->overruns, deadline_monitor_level_name(b->max_level));
+    }
+
+    bool ok = true;
+    if (with_policy[0].misses != 0 || with_policy[0].skipped_hops != 0 || with_policy[0].max_level != DEADLINE_LEVEL_NORMAL) {
+        printf("FAILED: deadline misses or degradation under normal load\n");
+        ok = false;
+    }
+    if (with_policy[1].max_level < DEADLINE_LEVEL_SHED || with_policy[2].max_level != DEADLINE_LEVEL_SLOW_HOP) {
+        printf("FAILED: overload did not degrade the pipeline step by step\n");
+        ok = false;
+    }
+    for (size_t p = 1; p <= 2; p++) {
+        if (with_policy[p].misses + with_policy[p].skipped_hops >= without_policy[p].misses + without_policy[p].skipped_hops) {
+            printf("FAILED: policy did not reduce deadline misses in %s\n", phases[p].name);
+            ok = false;
+        }
+    }
+    if (smoke_runs < phases[PHASE_COUNT - 1].end_us / 1000 / fake_models[0].hop_ms * 9 / 10) {
+        printf("FAILED: priority 0 model was shed (%u runs)\n", (unsigned)smoke_runs);
+        ok = false;
+    }
+    const phase_result_t *last = &with_policy[PHASE_COUNT - 1];
+    if (last->overruns == 0 || last->escalations == 0) {
+        printf("FAILED: DMA overrun during the stall was not counted or did not degrade\n");
+        ok = false;
+    }
+    if (last->end_level != DEADLINE_LEVEL_NORMAL || last->ring_overflows != 0) {
+        printf("FAILED: pipeline did not recover (level %s, ring overflows %u)\n",
+               deadline_monitor_level_name(last->end_level), (unsigned)last->ring_overflows);
+        ok = false;
+    }
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
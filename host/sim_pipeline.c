@@ -0,0 +1,267 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "model_split.h"
+#include "layer_pipeline.h"
+#include "wake_word_model.h"
+
+// 두 코어 파이프라인 추론 확인 (호스트, INFERENCE_PIPELINE)
+// 1. 내장 모델(wake_word_model.h)을 model_split으로 나누고, 연산자별 추정 MAC 수와 자를 수 있는 곳을 출력
+//    나눈 두 모델을 다시 읽어서 연산자 수, 입력/출력 텐서 크기가 원본/경계 텐서와 맞는지 확인
+// 2. 두 스레드(앞/뒤 단계)가 layer_pipeline 이중 버퍼로 hop을 넘기는 것을 재현해서 한 코어(앞+뒤를 이어서)와
+//    처리량, 지연을 비교. 단계 시간은 MAC 비율대로 나눈 가짜 시간(sleep, 코어 하나를 온전히 쓰는 것처럼)
+//    경계 텐서에는 hop 번호로 만든 값을 써서 뒤 단계가 순서대로, 덮어쓰이지 않은 데이터를 받는지 확인
+// 3. 같은 재현을 단계 비율 50:50으로도 돌려서 파이프라인 자체가 처리량을 두 배 가까이 내는지 확인
+//    (내장 모델은 경계 텐서가 작은 곳이 MEAN 뒤뿐이라 뒤 단계가 아주 짧고, 그만큼 이득도 작음)
+//
+//   ./sim_pipeline [--hops N] [--hop-us 앞+뒤 시간] [--max-boundary 바이트] [--split-op N] [--quiet]
+
+#define DEFAULT_HOPS 40
+#define DEFAULT_HOP_US 20000       // 한 코어에서 앞+뒤 단계 시간 (가짜)
+#define DEFAULT_MAX_BOUNDARY 1024  // wake_word.cpp PIPELINE_BOUNDARY_MAX
+#define DEVICE_MMACS 20.0          // 장치 추정 시간 출력용 (ESP32 float conv, 초당 백만 MAC 정도)
+
+typedef struct {
+    uint32_t hops;
+    uint32_t front_us;
+    uint32_t back_us;
+    size_t slot_bytes;
+    layer_pipeline_t pipeline;
+    // 결과 (뒤 단계 스레드가 씀)
+    bool order_ok;
+    double latency_sum_us;
+    double latency_max_us;
+    double elapsed_us;
+} run_t;
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 코어 하나를 us만큼 쓰는 단계 (스레드마다 코어가 따로 있다고 보고 잠만 잠)
+static void stage_work(uint32_t us) {
+    struct timespec ts = {us / 1000000, (long)(us % 1000000) * 1000};
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+static void fill_boundary(uint8_t *data, size_t bytes, uint32_t hop) {
+    for (size_t i = 0; i < bytes; i++) {
+        data[i] = (uint8_t)(hop * 31 + i);
+    }
+}
+
+static bool check_boundary(const uint8_t *data, size_t bytes, uint32_t hop) {
+    for (size_t i = 0; i < bytes; i++) {
+        if (data[i] != (uint8_t)(hop * 31 + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void record_latency(run_t *r, double latency) {
+    r->latency_sum_us += latency;
+    if (latency > r->latency_max_us) {
+        r->latency_max_us = latency;
+    }
+}
+
+// 한 코어: hop마다 앞 단계 → 뒤 단계
+static void run_single(run_t *r) {
+    double start = now_us();
+    for (uint32_t hop = 0; hop < r->hops; hop++) {
+        double hop_start = now_us();
+        stage_work(r->front_us);
+        stage_work(r->back_us);
+        record_latency(r, now_us() - hop_start);
+    }
+    r->elapsed_us = now_us() - start;
+}
+
+// 뒤 단계 스레드 (장치: 코어 1의 pipeline_back 태스크)
+static void *back_stage(void *arg) {
+    run_t *r = (run_t *)arg;
+    for (uint32_t hop = 0; hop < r->hops; hop++) {
+        layer_pipeline_slot_t *slot = layer_pipeline_next(&r->pipeline);
+        if (slot->tag != hop || !check_boundary(slot->data, r->slot_bytes, hop)) {
+            r->order_ok = false;
+        }
+        stage_work(r->back_us);
+        record_latency(r, now_us() - (double)slot->start_us);
+        layer_pipeline_release(&r->pipeline);
+    }
+    return NULL;
+}
+
+// 두 코어: 앞 단계(이 스레드)가 hop N+1을 실행하는 동안 뒤 단계 스레드가 hop N을 실행
+static bool run_pipelined(run_t *r) {
+    uint8_t *memory = malloc(LAYER_PIPELINE_SLOTS * r->slot_bytes);
+    if (memory == NULL || !layer_pipeline_init(&r->pipeline, memory, r->slot_bytes)) {
+        free(memory);
+        return false;
+    }
+    r->order_ok = true;
+    pthread_t back;
+    pthread_create(&back, NULL, back_stage, r);
+    double start = now_us();
+    for (uint32_t hop = 0; hop < r->hops; hop++) {
+        layer_pipeline_slot_t *slot = layer_pipeline_acquire(&r->pipeline);
+        slot->start_us = (int64_t)now_us();
+        stage_work(r->front_us);
+        fill_boundary(slot->data, r->slot_bytes, hop);
+        slot->tag = hop;
+        layer_pipeline_submit(&r->pipeline);
+    }
+    layer_pipeline_drain(&r->pipeline);
+    r->elapsed_us = now_us() - start;
+    pthread_join(back, NULL);
+    bool complete = r->pipeline.completed == r->hops;
+    layer_pipeline_deinit(&r->pipeline);
+    free(memory);
+    return complete;
+}
+
+// 한 코어와 파이프라인 비교. 반환: 파이프라인 처리량 / 한 코어 처리량
+static double compare(const char *name, uint32_t hops, uint32_t front_us, uint32_t back_us, size_t slot_bytes,
+                      bool quiet, bool *ok) {
+    run_t single = {.hops = hops, .front_us = front_us, .back_us = back_us, .slot_bytes = slot_bytes};
+    run_t piped = single;
+    run_single(&single);
+    if (!run_pipelined(&piped)) {
+        printf("FAILED: %s: pipeline did not complete\n", name);
+        *ok = false;
+        return 0.0;
+    }
+    if (!piped.order_ok) {
+        printf("FAILED: %s: back stage got hops out of order or overwritten\n", name);
+        *ok = false;
+    }
+    double single_rate = hops * 1e6 / single.elapsed_us;
+    double piped_rate = hops * 1e6 / piped.elapsed_us;
+    if (!quiet) {
+        printf("%-10s front %6u us, back %6u us | single-core %6.1f hops/s, latency mean %6.0f us max %6.0f us"
+               " | pipelined %6.1f hops/s, latency mean %6.0f us max %6.0f us | x%.2f\n",
+               name, (unsigned)front_us, (unsigned)back_us, single_rate, single.latency_sum_us / hops,
+               single.latency_max_us, piped_rate, piped.latency_sum_us / hops, piped.latency_max_us,
+               piped_rate / single_rate);
+    }
+
+    // 파이프라인 처리량 상한은 긴 단계 하나의 시간 (여유 20%: 스레드 깨우는 시간, sleep 오차)
+    uint32_t longest = front_us > back_us ? front_us : back_us;
+    double bound = 1e6 / longest;
+    if (piped_rate < 0.8 * bound) {
+        printf("FAILED: %s: pipelined %.1f hops/s is far below the %.1f hops/s bound of the longer stage\n", name,
+               piped_rate, bound);
+        *ok = false;
+    }
+    return piped_rate / single_rate;
+}
+
+int main(int argc, char **argv) {
+    uint32_t hops = DEFAULT_HOPS;
+    uint32_t hop_us = DEFAULT_HOP_US;
+    uint32_t max_boundary = DEFAULT_MAX_BOUNDARY;
+    int32_t split_op = -1;
+    bool quiet = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hops") == 0 && i + 1 < argc) {
+            hops = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hop-us") == 0 && i + 1 < argc) {
+            hop_us = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-boundary") == 0 && i + 1 < argc) {
+            max_boundary = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--split-op") == 0 && i + 1 < argc) {
+            split_op = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else {
+            fprintf(stderr, "usage: %s [--hops N] [--hop-us US] [--max-boundary BYTES] [--split-op N] [--quiet]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (hops == 0 || hop_us < 2) {
+        fprintf(stderr, "--hops and --hop-us must be positive\n");
+        return 2;
+    }
+
+    // 1. 내장 모델 나누기
+    static model_split_plan_t plan;
+    bool planned = model_split_plan(model_tflite, model_tflite_len, max_boundary, split_op, &plan);
+    if (!quiet) {
+        printf("built-in model: %u bytes, %u ops\n", (unsigned)model_tflite_len, (unsigned)plan.op_count);
+        for (uint32_t op = 0; op < plan.op_count; op++) {
+            printf("  %2u %-16s %10llu MACs", (unsigned)op, model_split_op_name(plan.op_code[op]),
+                   (unsigned long long)plan.op_macs[op]);
+            if (plan.op_boundary[op] >= 0) {
+                printf("  | cut -> tensor %d, %u bytes%s", (int)plan.op_boundary[op],
+                       (unsigned)plan.op_boundary_bytes[op], (int32_t)op == plan.split_op ? "  <== split" : "");
+            }
+            printf("\n");
+        }
+    }
+    if (!planned) {
+        printf("FAILED: no single-tensor cut within %u bytes%s\n", (unsigned)max_boundary,
+               split_op >= 0 ? " at --split-op" : "");
+        return 1;
+    }
+
+    bool ok = true;
+    uint8_t *front = malloc(model_tflite_len);
+    uint8_t *back = malloc(model_tflite_len);
+    model_split_info_t whole;
+    model_split_info_t front_info;
+    model_split_info_t back_info;
+    if (front == NULL || back == NULL || !model_split_info(model_tflite, model_tflite_len, &whole) ||
+        !model_split_apply(model_tflite, model_tflite_len, &plan, front, back) ||
+        !model_split_info(front, model_tflite_len, &front_info) || !model_split_info(back, model_tflite_len, &back_info)) {
+        printf("FAILED: split models could not be written or read back\n");
+        free(front);
+        free(back);
+        return 1;
+    }
+    uint32_t front_ops = (uint32_t)plan.split_op + 1;
+    if (front_info.ops != front_ops || back_info.ops != whole.ops - front_ops ||
+        front_info.input_bytes != whole.input_bytes || front_info.output_bytes != plan.boundary_bytes ||
+        back_info.input_bytes != plan.boundary_bytes || back_info.output_bytes != whole.output_bytes ||
+        front_info.tensors >= whole.tensors || back_info.tensors >= whole.tensors) {
+        printf("FAILED: split models do not match the plan (front %u ops %u->%u bytes, back %u ops %u->%u bytes)\n",
+               (unsigned)front_info.ops, (unsigned)front_info.input_bytes, (unsigned)front_info.output_bytes,
+               (unsigned)back_info.ops, (unsigned)back_info.input_bytes, (unsigned)back_info.output_bytes);
+        ok = false;
+    }
+    free(front);
+    free(back);
+    uint64_t total = plan.front_macs + plan.back_macs;
+    if (!quiet) {
+        printf("split after op %d (%s): front %u ops / %u tensors, back %u ops / %u tensors, boundary %u bytes\n",
+               (int)plan.split_op, model_split_op_name(plan.op_code[plan.split_op]), (unsigned)front_info.ops,
+               (unsigned)front_info.tensors, (unsigned)back_info.ops, (unsigned)back_info.tensors,
+               (unsigned)plan.boundary_bytes);
+        printf("estimated MACs: front %llu (%.1f%%), back %llu (%.1f%%), about %.0f ms on the device at %.0f MMAC/s\n",
+               (unsigned long long)plan.front_macs, 100.0 * plan.front_macs / total,
+               (unsigned long long)plan.back_macs, 100.0 * plan.back_macs / total, total / DEVICE_MMACS / 1000.0,
+               DEVICE_MMACS);
+    }
+
+    // 2. 내장 모델 비율, 3. 50:50
+    uint32_t front_us = (uint32_t)((double)hop_us * plan.front_macs / total);
+    front_us = front_us < 1 ? 1 : (front_us >= hop_us ? hop_us - 1 : front_us);
+    double model_gain = compare("model", hops, front_us, hop_us - front_us, plan.boundary_bytes, quiet, &ok);
+    double even_gain = compare("even", hops, hop_us / 2, hop_us - hop_us / 2, plan.boundary_bytes, quiet, &ok);
+    if (model_gain < 0.9) {
+        printf("FAILED: pipelining the built-in model split lost throughput (x%.2f)\n", model_gain);
+        ok = false;
+    }
+    if (even_gain < 1.6) {
+        printf("FAILED: an even split should nearly double throughput (x%.2f)\n", even_gain);
+        ok = false;
+    }
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,327 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "audio_config.h"
+#include "frontend_simd.h"
+#include "link_rate.h"
+#include "wake_word_sim.h"
+#include "wav_io.h"
+
+// wake_word.cpp 오디오 경로 시뮬레이터 (PCM 주입 결과와 비교용, scripts/pcm_inject.py)
+// 펌웨어와 같은 capture_pipeline.c로 블록을 처리하고, 같은 규칙(wake_word_sim.c)으로 추론 시점과 모델 입력 창을 정해서
+// 추론할 때마다 HOP 줄(위치, 입력 창 CRC32)을 출력합니다. 모델(TFLM)은 없으므로 확률은 출력하지 않습니다.
+//
+//   ./sim_wake_word test.wav                        # WAV (I2S_SAMPLE_RATE로 변환)
+//   ./sim_wake_word - < audio.raw                   # int16 LE 모노 (pcm_inject.py가 장치에 보낸 그대로)
+//   ./sim_wake_word test.wav --windows windows.raw  # hop마다 모델 입력 창(int16)을 저장 (PC에서 모델 실행용)
+//   ./sim_wake_word --pty                           # 장치 대신 pty에서 PCM 주입 프로토콜로 응답 (하드웨어 없이 도구 확인)
+//   ./sim_wake_word --pty --max-baud 1500000        # LINK_RATE 협상도 응답, 이 속도보다 빠르면 시험 데이터를 깨뜨림 (scripts/link_rate.py --emulate)
+//
+// 추론 시점/창 길이 옵션 (기본값은 펌웨어 기본 설정, pcm_inject.py는 INJECT_READY 값을 넘김):
+//   --hop N     추론 간격 (INFERENCE_HOP_SAMPLES)
+//   --first N   첫 추론까지 필요한 샘플 수 (FAST_BOOT_MIN_AUDIO_MS, FAST_BOOT=0이면 창 길이)
+//   --window N  모델 입력 창 길이 (샘플 수)
+// --isa auto|portable|sse4.1|avx2: 특징 추출 커널 (기본 auto = 이 CPU에서 가장 빠른 것. 결과는 같음, frontend_simd.h)
+
+typedef struct {
+    wake_word_sim_t core;
+    FILE *windows;  // NULL이면 저장 안 함
+} sim_t;
+
+static void sim_reset(sim_t *sim) {
+    wake_word_sim_reset(&sim->core);
+}
+
+// 캡처 블록 하나 (I2S_SAMPLE_RATE) → 추론 시점이면 HOP 줄을 out에 출력
+static void sim_block(sim_t *sim, int16_t *block, size_t count, FILE *out) {
+    uint32_t position;
+    const int16_t *window = wake_word_sim_block(&sim->core, block, count, &position);
+    if (!window) {
+        return;
+    }
+    uint32_t crc = wake_word_sim_crc32(0, (const uint8_t *)window, sim->core.window * sizeof(int16_t));
+    fprintf(out, "HOP %lu -1 %08lx 0\n", (unsigned long)position, (unsigned long)crc);
+    if (sim->windows) {
+        fwrite(window, sizeof(int16_t), sim->core.window, sim->windows);
+    }
+}
+
+// 파일/표준입력 전체를 블록 단위로
+static int run_file(sim_t *sim, const char *path) {
+    int16_t *samples;
+    size_t count;
+    if (strcmp(path, "-") == 0) {
+        size_t capacity = 1 << 16;
+        count = 0;
+        samples = malloc(capacity * sizeof(int16_t));
+        size_t n;
+        while ((n = fread(samples + count, sizeof(int16_t), capacity - count, stdin)) > 0) {
+            count += n;
+            if (count == capacity) {
+                capacity *= 2;
+                samples = realloc(samples, capacity * sizeof(int16_t));
+            }
+        }
+    } else {
+        samples = wav_read_mono(path, I2S_SAMPLE_RATE, &count);
+    }
+    if (!samples) {
+        fprintf(stderr, "Failed to read %s\n", path);
+        return 1;
+    }
+
+    sim_reset(sim);
+    int16_t block[SIM_CAPTURE_BLOCK_SAMPLES];
+    for (size_t offset = 0; offset < count; offset += SIM_CAPTURE_BLOCK_SAMPLES) {
+        // 마지막 블록은 무음으로 채움 (pcm_inject.py와 같음)
+        size_t n = count - offset < SIM_CAPTURE_BLOCK_SAMPLES ? count - offset : SIM_CAPTURE_BLOCK_SAMPLES;
+        memset(block, 0, sizeof(block));
+        memcpy(block, samples + offset, n * sizeof(int16_t));
+        sim_block(sim, block, SIM_CAPTURE_BLOCK_SAMPLES, stdout);
+    }
+    fprintf(stderr, "%lu samples, %lu hops\n", (unsigned long)count, (unsigned long)sim->core.hops);
+    free(samples);
+    return 0;
+}
+
+// pty 장치 에뮬레이터 ---------------------------------------------------------
+
+static bool read_exact(int fd, void *data, size_t length) {
+    uint8_t *p = data;
+    while (length > 0) {
+        ssize_t n = read(fd, p, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+static bool read_line(int fd, char *line, size_t size) {
+    size_t length = 0;
+    char c;
+    while (read_exact(fd, &c, 1)) {
+        if (c == '\n') {
+            line[length] = '\0';
+            return true;
+        }
+        if (c != '\r' && length + 1 < size) {
+            line[length++] = c;
+        }
+    }
+    return false;
+}
+
+// LINK_RATE 협상 (wake_word.cpp와 같은 link_rate_serve). pty에는 실제 속도가 없으므로 속도만 기억하고,
+// max_baud보다 빠르면 보내는 데이터의 바이트 하나를 바꿔서 그 속도를 못 버티는 링크처럼 보이게 함
+typedef struct {
+    int fd;
+    uint32_t baud;
+    uint32_t max_baud;
+} pty_link_t;
+
+static int link_read_line(void *user, char *line, size_t size, uint32_t timeout_ms) {
+    pty_link_t *link = user;
+    size_t length = 0;
+    while (1) {
+        struct pollfd p = {link->fd, POLLIN, 0};
+        if (poll(&p, 1, (int)timeout_ms) <= 0) {
+            return -1;
+        }
+        char c;
+        if (read(link->fd, &c, 1) != 1) {
+            return -1;
+        }
+        if (c == '\n') {
+            line[length] = '\0';
+            return (int)length;
+        }
+        if (c != '\r' && length + 1 < size) {
+            line[length++] = c;
+        }
+    }
+}
+
+static void link_write(void *user, const void *data, size_t size) {
+    pty_link_t *link = user;
+    uint8_t buffer[1024];
+    const uint8_t *p = data;
+    while (size > 0) {
+        size_t n = size < sizeof(buffer) ? size : sizeof(buffer);
+        memcpy(buffer, p, n);
+        if (link->max_baud > 0 && link->baud > link->max_baud && n > 64) {
+            buffer[n / 2] ^= 0x10;  // 줄(명령 응답)은 그대로, 시험 데이터만 깨짐
+        }
+        for (size_t done = 0; done < n;) {
+            ssize_t w = write(link->fd, buffer + done, n - done);
+            if (w < 0 && errno == EINTR) {
+                continue;
+            }
+            if (w <= 0) {
+                return;
+            }
+            done += (size_t)w;
+        }
+        p += n;
+        size -= n;
+    }
+}
+
+static void link_set_baud(void *user, uint32_t baud) {
+    ((pty_link_t *)user)->baud = baud;
+}
+
+// wake_word.cpp의 INJECT_START 처리와 같은 프로토콜 (확률 없이 CRC만)
+static void serve_inject(sim_t *sim, int fd, FILE *out) {
+    sim_reset(sim);
+    fprintf(out, "INJECT_READY block=%d rate=%d model_rate=%d hop=%lu first=%lu window=%lu\n", SIM_CAPTURE_BLOCK_SAMPLES,
+            I2S_SAMPLE_RATE, MODEL_SAMPLE_RATE, (unsigned long)sim->core.hop, (unsigned long)sim->core.first,
+            (unsigned long)sim->core.window);
+    fflush(out);
+
+    int16_t block[SIM_CAPTURE_BLOCK_SAMPLES];
+    uint32_t blocks = 0;
+    while (1) {
+        uint8_t header[2];
+        if (!read_exact(fd, header, sizeof(header))) {
+            return;
+        }
+        size_t count = header[0] | (header[1] << 8);
+        if (count == 0) {
+            break;
+        }
+        if (count > SIM_CAPTURE_BLOCK_SAMPLES || count % (FRONTEND_HOP * MODEL_DECIMATION) != 0) {
+            fprintf(out, "INJECT_ERROR size\n");
+            break;
+        }
+        if (!read_exact(fd, block, count * sizeof(int16_t))) {
+            return;
+        }
+        sim_block(sim, block, count, out);
+        fprintf(out, "INJECT_ACK\n");
+        fflush(out);
+        blocks++;
+    }
+    fprintf(out, "INJECT_END blocks=%lu hops=%lu dsp_us=0 invoke_us=0\n", (unsigned long)blocks, (unsigned long)sim->core.hops);
+    fflush(out);
+}
+
+static int run_pty(sim_t *sim, uint32_t max_baud) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    const char *name = ptsname(master);
+
+    // 도구가 포트를 열고 닫아도 EIO가 나지 않도록 slave를 하나 열어두고, 에코 없는 raw 모드로
+    int slave = open(name, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if (slave < 0 || tcgetattr(slave, &tio) != 0) {
+        perror(name);
+        return 1;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    printf("PTY %s\n", name);
+    fflush(stdout);
+
+    FILE *out = fdopen(dup(master), "w");
+    pty_link_t link = {master, 460800, max_baud};  // 부팅 속도 (wake_word.cpp UART_BAUD_RATE)
+    link_rate_io_t io = {link_read_line, link_write, link_set_baud, &link};
+    static uint8_t chunk[1024];
+    char line[64];
+    unsigned long baud, bytes;
+    while (read_line(master, line, sizeof(line))) {
+        if (sscanf(line, "LINK_RATE %lu %lu", &baud, &bytes) == 2) {
+            fflush(out);
+            link.baud = link_rate_serve(&io, link.baud, baud, bytes, chunk, sizeof(chunk));
+        } else if (strcmp(line, "INJECT_START") == 0) {
+            fprintf(out, "I (0) SIM_WAKE_WORD: Command received: INJECT_START\n");  // 장치처럼 콘솔 로그도 섞임
+            serve_inject(sim, master, out);
+        } else if (line[0] != '\0') {
+            fprintf(out, "W (0) SIM_WAKE_WORD: Unknown command: %s\n", line);
+            fflush(out);
+        }
+    }
+    fclose(out);
+    close(slave);
+    close(master);
+    return 0;
+}
+
+static int usage(const char *program) {
+    fprintf(stderr, "usage: %s <file.wav | -> [--hop N] [--first N] [--window N] [--windows out.raw] [--isa NAME]\n",
+            program);
+    fprintf(stderr, "       %s --pty [--hop N] [--first N] [--window N] [--max-baud N] [--isa NAME]\n", program);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    static sim_t sim;
+    if (!wake_word_sim_init(&sim.core)) {
+        return 1;
+    }
+    const char *input = NULL;
+    const char *windows_path = NULL;
+    bool pty = false;
+    uint32_t max_baud = 0;
+    const char *isa = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hop") == 0 && i + 1 < argc) {
+            sim.core.hop = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            sim.core.first = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            sim.core.window = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--windows") == 0 && i + 1 < argc) {
+            windows_path = argv[++i];
+        } else if (strcmp(argv[i], "--max-baud") == 0 && i + 1 < argc) {
+            max_baud = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+            isa = argv[++i];
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            pty = true;
+        } else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) {
+            input = argv[i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if ((!input && !pty) || sim.core.window == 0 || sim.core.window > SIM_MODEL_WINDOW_MAX_SAMPLES || sim.core.hop == 0) {
+        return usage(argv[0]);
+    }
+    if (!frontend_simd_install(isa)) {
+        return 2;
+    }
+
+    if (pty) {
+        return run_pty(&sim, max_baud);
+    }
+    if (windows_path) {
+        sim.windows = fopen(windows_path, "wb");
+        if (!sim.windows) {
+            perror(windows_path);
+            return 1;
+        }
+    }
+    int result = run_file(&sim, input);
+    if (sim.windows) {
+        fclose(sim.windows);
+    }
+    return result;
+}
@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_pool.h"
+
+// audio_pool.c 확인: 무작위 alloc/free 순서를 단순한 모델(풀별 빈 블록 수)과 비교
+// - 받은 블록이 요청 크기/조건을 만족하고, 정렬되어 있고, 다른 블록과 겹치지 않는지 (블록마다 패턴을 써서 확인)
+// - 조건에 맞는 가장 작은 풀에서 나오는지, 맞는 풀이 모두 가득 찼을 때만 실패하는지
+// - 풀별 in_use/peak/overflows가 모델과 같은지, 이중 해제/풀 밖 포인터를 거부하는지
+// - alloc/free 한 번의 시간
+//
+//   ./verify_audio_pool [--seed N] [--steps N]
+//
+// 기준을 만족하지 못하면 FAILED를 출력하고 1을 반환합니다.
+
+#define MAX_LIVE 256
+
+static const audio_pool_budget_t budget[] = {
+    // 일부러 크기 순서를 섞어서 정렬도 확인
+    {"wide", 2048, 4, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    {"block", 1024, 6, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    {"small", 100, 40, AUDIO_POOL_CAP_INTERNAL},  // 112으로 올림
+    {"unused", 512, 0, AUDIO_POOL_CAP_INTERNAL},  // 개수 0은 건너뜀
+    {"psram", 4096, 3, AUDIO_POOL_CAP_SPIRAM},
+    {"arena", 70 * 1024, 1, AUDIO_POOL_CAP_INTERNAL},
+};
+
+typedef struct {
+    uint8_t *ptr;
+    size_t size;
+    int pool;       // 모델이 예상한 풀 (audio_pool_stats 인덱스)
+    uint8_t tag;
+} live_t;
+
+static live_t live[MAX_LIVE];
+static int live_count;
+static int failures;
+
+// 모델: 풀별 (블록 크기, 조건, 전체, 사용 중, peak, overflows)
+static audio_pool_stats_t model[AUDIO_POOL_MAX_POOLS];
+static size_t model_count;
+static uint32_t model_failures;
+
+static uint32_t rng_state = 1;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void check(int condition, const char *what, long step) {
+    if (!condition) {
+        if (failures < 10) {
+            printf("FAIL at step %ld: %s\n", step, what);
+        }
+        failures++;
+    }
+}
+
+static int model_expected_pool(size_t size, uint32_t caps, int apply) {
+    for (size_t i = 0; i < model_count; i++) {
+        if (model[i].block_size < size || (model[i].caps & caps) != caps) {
+            continue;
+        }
+        if (model[i].in_use == model[i].block_count) {
+            if (apply) {
+                model[i].overflows++;
+            }
+            continue;
+        }
+        return (int)i;
+    }
+    return -1;
+}
+
+static void snapshot(uint16_t *in_use) {
+    for (size_t i = 0; i < audio_pool_count(); i++) {
+        audio_pool_stats_t s;
+        audio_pool_stats(i, &s);
+        in_use[i] = s.in_use;
+    }
+}
+
+static void do_alloc(long step) {
+    static const uint32_t caps_choices[] = {
+        0, AUDIO_POOL_CAP_INTERNAL, AUDIO_POOL_CAP_DMA, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA, AUDIO_POOL_CAP_SPIRAM,
+    };
+    size_t size;
+    switch (rng() % 8) {
+        case 0: size = 1 + rng() % 112; break;
+        case 1: size = 1 + rng() % 1024; break;
+        case 2: size = 1 + rng() % 2048; break;
+        case 3: size = 1 + rng() % 4096; break;
+        case 4: size = 60 * 1024 + rng() % (10 * 1024 + 1); break;
+        case 5: size = 80 * 1024; break;  // 어떤 풀에도 안 맞음
+        default: size = 1 + rng() % 256; break;
+    }
+    uint32_t caps = caps_choices[rng() % (sizeof(caps_choices) / sizeof(caps_choices[0]))];
+
+    uint16_t before[AUDIO_POOL_MAX_POOLS], after[AUDIO_POOL_MAX_POOLS];
+    snapshot(before);
+    int expected = model_expected_pool(size, caps, 1);
+    uint8_t *ptr = audio_pool_alloc(size, caps);
+    snapshot(after);
+
+    if (expected < 0) {
+        model_failures++;
+        check(ptr == NULL, "allocation should fail (all matching pools full)", step);
+        return;
+    }
+    check(ptr != NULL, "allocation failed although a matching pool has a free block", step);
+    if (!ptr) {
+        return;
+    }
+    model[expected].in_use++;
+    if (model[expected].in_use > model[expected].peak) {
+        model[expected].peak = model[expected].in_use;
+    }
+    for (size_t i = 0; i < audio_pool_count(); i++) {
+        int delta = after[i] - before[i];
+        check(delta == ((int)i == expected), "block came from the wrong pool (not smallest fit)", step);
+    }
+    check(((uintptr_t)ptr % AUDIO_POOL_ALIGN) == 0, "block not aligned", step);
+
+    if (live_count < MAX_LIVE) {
+        live_t *l = &live[live_count++];
+        l->ptr = ptr;
+        l->size = size;
+        l->pool = expected;
+        l->tag = (uint8_t)(step * 31 + 7);
+        memset(ptr, l->tag, size);  // 다른 블록과 겹치면 해제할 때 패턴이 깨짐
+    } else {
+        audio_pool_free(ptr);
+        model[expected].in_use--;
+    }
+}
+
+static void do_free(long step) {
+    if (live_count == 0) {
+        return;
+    }
+    int index = (int)(rng() % (uint32_t)live_count);
+    live_t l = live[index];
+    live[index] = live[--live_count];
+
+    int intact = 1;
+    for (size_t i = 0; i < l.size; i++) {
+        intact &= l.ptr[i] == l.tag;
+    }
+    check(intact, "block contents overwritten (overlapping blocks)", step);
+    check(audio_pool_free(l.ptr), "free of a live block rejected", step);
+    model[l.pool].in_use--;
+
+    // 이중 해제, 블록 중간 포인터, 풀 밖 포인터는 거부되고 상태가 바뀌지 않아야 함
+    if (rng() % 8 == 0) {
+        check(!audio_pool_free(l.ptr), "double free accepted", step);
+        check(!audio_pool_free(l.ptr + 1), "interior pointer accepted", step);
+        int outside;
+        check(!audio_pool_free(&outside), "foreign pointer accepted", step);
+    }
+}
+
+static void compare_stats(long step) {
+    check(audio_pool_count() == model_count, "pool count", step);
+    for (size_t i = 0; i < model_count; i++) {
+        audio_pool_stats_t s;
+        audio_pool_stats(i, &s);
+        check(s.in_use == model[i].in_use, "in_use differs from model", step);
+        check(s.peak == model[i].peak, "peak differs from model", step);
+        check(s.overflows == model[i].overflows, "overflows differ from model", step);
+    }
+    check(audio_pool_failures() == model_failures, "failure count differs from model", step);
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char **argv) {
+    uint32_t seed = 12345;
+    long steps = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = strtol(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seed N] [--steps N]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed ? seed : 1;
+
+    if (!audio_pool_init(budget, sizeof(budget) / sizeof(budget[0]))) {
+        printf("FAILED: audio_pool_init\n");
+        return 1;
+    }
+
+    // 초기 상태: 블록 크기 오름차순, 정렬 단위로 올림, 개수 0인 풀 제외
+    model_count = audio_pool_count();
+    check(model_count == 5, "empty pool should be skipped", 0);
+    for (size_t i = 0; i < model_count; i++) {
+        audio_pool_stats(i, &model[i]);
+        check(model[i].block_size % AUDIO_POOL_ALIGN == 0, "block size not rounded", 0);
+        check(i == 0 || model[i - 1].block_size <= model[i].block_size, "pools not sorted by block size", 0);
+        check(model[i].in_use == 0 && model[i].peak == 0, "fresh pool not empty", 0);
+    }
+    check(model[0].block_size == 112, "100-byte pool rounded to 112", 0);
+
+    // 무작위 순서 (alloc 쪽으로 약간 치우쳐서 풀이 자주 가득 차도록)
+    for (long step = 1; step <= steps; step++) {
+        if (rng() % 100 < 55) {
+            do_alloc(step);
+        } else {
+            do_free(step);
+        }
+        if (step % 64 == 0) {
+            compare_stats(step);
+        }
+    }
+    while (live_count > 0) {
+        do_free(steps);
+    }
+    compare_stats(steps);
+    printf("Random sequence: %ld steps (seed %u), %lu failed allocations as predicted\n",
+           steps, (unsigned)seed, (unsigned long)model_failures);
+    audio_pool_report();
+
+    // alloc + free 한 쌍의 시간 (가장 작은 풀)
+    int iterations = 0;
+    double start = now_us(), elapsed = 0;
+    while (elapsed < 200000.0) {
+        for (int i = 0; i < 1000; i++) {
+            void *p = audio_pool_alloc(64, AUDIO_POOL_CAP_INTERNAL);
+            audio_pool_free(p);
+        }
+        iterations += 1000;
+        elapsed = now_us() - start;
+    }
+    printf("Host cost: %.1f ns per alloc + free\n", elapsed * 1000.0 / iterations);
+
+    audio_pool_deinit();
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
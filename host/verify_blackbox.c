@@ -0,0 +1,314 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "blackbox_log.h"
+#include "boot_profile.h"
+
+// blackbox_log.c 확인: RAM으로 흉내 낸 NOR flash(지운 섹터에만 0 비트를 쓸 수 있음)에서
+// - 빈 파티션, 여러 바퀴 도는 무작위 크기 기록: 색인이 sequence 순서인지, 남아있는 기록의 내용/CRC가 맞는지
+// - 다시 열었을 때(재부팅) 색인이 같은지, 섹터별 erase 횟수가 고른지 (wear leveling)
+// - 쓰는 중 전원이 끊겼을 때(아무 flash 동작에서나) 반쯤 쓴 기록이 보이지 않고 이전 기록은 남는지
+// - 기록이 색인 크기보다 많을 때 최신 기록이 남는지
+// - ADPCM 청크: 청크 하나만으로 디코딩되는지, 이어서 디코딩한 결과와 같은지, SNR, 청크당 인코딩 시간
+//
+//   ./verify_blackbox [--seed N] [--records N]
+//
+// 기준을 만족하지 못하면 FAILED를 출력하고 1을 반환합니다.
+
+#define SIM_SECTORS 64      // 256KB (장치 파티션보다 작게 해서 여러 바퀴)
+#define SIM_MAX_SECTORS 256 // 색인보다 기록이 많은 경우 (섹터 하나짜리 기록 256개)
+#define CHUNK_SAMPLES 512
+#define MAX_RECORD_BYTES (7 * BLACKBOX_SECTOR_SIZE)
+
+typedef struct {
+    uint8_t data[SIM_MAX_SECTORS * BLACKBOX_SECTOR_SIZE];
+    uint32_t erases[SIM_MAX_SECTORS];
+    long ops_left;          // 0이 되면 전원이 끊긴 것처럼 이후 동작 실패 (-1: 끊기지 않음)
+    int violations;         // 지우지 않은 비트를 1로 쓰려고 함, 정렬되지 않은 erase
+} sim_flash_t;
+
+static sim_flash_t sim;
+static uint8_t staging[BLACKBOX_SECTOR_SIZE];
+static int failures;
+
+static uint32_t rng_state = 1;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void check(int condition, const char *what, long step) {
+    if (!condition) {
+        if (failures < 10) {
+            printf("FAIL at %ld: %s\n", step, what);
+        }
+        failures++;
+    }
+}
+
+static bool power_ok(void) {
+    if (sim.ops_left == 0) {
+        return false;
+    }
+    if (sim.ops_left > 0) {
+        sim.ops_left--;
+    }
+    return true;
+}
+
+static bool sim_read(void *user, uint32_t offset, void *data, size_t size) {
+    (void)user;
+    if ((size_t)offset + size > sizeof(sim.data)) {
+        return false;
+    }
+    memcpy(data, sim.data + offset, size);
+    return true;
+}
+
+static bool sim_write(void *user, uint32_t offset, const void *data, size_t size) {
+    (void)user;
+    if ((size_t)offset + size > sizeof(sim.data) || !power_ok()) {
+        return false;
+    }
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        if ((sim.data[offset + i] & p[i]) != p[i]) {
+            sim.violations++;
+        }
+        sim.data[offset + i] &= p[i];
+    }
+    return true;
+}
+
+static bool sim_erase(void *user, uint32_t offset, size_t size) {
+    (void)user;
+    if (offset % BLACKBOX_SECTOR_SIZE || size % BLACKBOX_SECTOR_SIZE || (size_t)offset + size > sizeof(sim.data)) {
+        sim.violations++;
+        return false;
+    }
+    for (uint32_t s = offset / BLACKBOX_SECTOR_SIZE; s < (offset + size) / BLACKBOX_SECTOR_SIZE; s++) {
+        if (!power_ok()) {
+            return false;
+        }
+        memset(sim.data + (size_t)s * BLACKBOX_SECTOR_SIZE, 0xFF, BLACKBOX_SECTOR_SIZE);
+        sim.erases[s]++;
+    }
+    return true;
+}
+
+static blackbox_flash_t flash = {sim_read, sim_write, sim_erase, NULL, SIM_SECTORS * BLACKBOX_SECTOR_SIZE};
+
+// 기록 내용: sequence로 정해지는 패턴 (길이도 sequence로)
+static size_t record_size(uint32_t sequence) {
+    uint32_t h = sequence * 2654435761u;
+    return 1 + (h >> 8) % MAX_RECORD_BYTES;
+}
+
+static uint8_t record_byte(uint32_t sequence, size_t i) {
+    uint32_t h = (sequence * 0x9E3779B9u) ^ (uint32_t)(i * 0x85EBCA6Bu);
+    h ^= h >> 15;
+    return (uint8_t)(h * 0x2C1B3C6Du >> 24);
+}
+
+// 기록 하나 쓰기 (파티션에 쓰일 sequence를 미리 알 수 있음: log->next_sequence)
+static bool write_record(blackbox_log_t *log) {
+    uint32_t sequence = log->next_sequence;
+    size_t size = record_size(sequence);
+    if (!blackbox_log_begin(log, size)) {
+        return false;
+    }
+    uint8_t buffer[1000];
+    for (size_t offset = 0; offset < size;) {
+        size_t part = 1 + rng() % sizeof(buffer);  // 크기를 섞어서 섹터 경계 처리 확인
+        if (part > size - offset) {
+            part = size - offset;
+        }
+        for (size_t i = 0; i < part; i++) {
+            buffer[i] = record_byte(sequence, offset + i);
+        }
+        if (!blackbox_log_append(log, buffer, part)) {
+            return false;
+        }
+        offset += part;
+    }
+    blackbox_record_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.chunks = (uint16_t)sequence;
+    snprintf(header.label, sizeof(header.label), "record %u", (unsigned)sequence);
+    return blackbox_log_commit(log, &header);
+}
+
+// 색인의 모든 기록: sequence 순서, 겹치지 않음, 헤더/내용/CRC가 맞음
+static void verify_index(const blackbox_log_t *log, long step) {
+    uint8_t buffer[4096];
+    for (size_t i = 0; i < log->count; i++) {
+        const blackbox_entry_t *e = &log->index[i];
+        check(i == 0 || log->index[i - 1].sequence < e->sequence, "index not ordered by sequence", step);
+        for (size_t j = 0; j < i; j++) {
+            // 원형으로 겹치는지 (파티션 끝에서 이어지는 기록)
+            const blackbox_entry_t *o = &log->index[j];
+            uint16_t total = log->sectors;
+            check((e->sector + total - o->sector) % total >= o->sectors &&
+                      (o->sector + total - e->sector) % total >= e->sectors,
+                  "records overlap", step);
+        }
+        blackbox_record_header_t header;
+        if (!blackbox_log_header(log, i, &header)) {
+            check(0, "indexed record header invalid", step);
+            continue;
+        }
+        check(header.data_size == record_size(header.sequence), "record size", step);
+        check(header.chunks == (uint16_t)header.sequence, "header field", step);
+        uint32_t crc = 0;
+        bool same = true;
+        for (uint32_t offset = 0; offset < header.data_size; offset += sizeof(buffer)) {
+            size_t part = header.data_size - offset < sizeof(buffer) ? header.data_size - offset : sizeof(buffer);
+            if (!blackbox_log_read(log, i, sizeof(header) + offset, buffer, part)) {
+                same = false;
+                break;
+            }
+            crc = blackbox_crc32(crc, buffer, part);
+            for (size_t k = 0; k < part; k++) {
+                same = same && buffer[k] == record_byte(header.sequence, offset + k);
+            }
+        }
+        check(same, "record content", step);
+        check(crc == header.data_crc32, "record CRC", step);
+    }
+}
+
+static void verify_reopen(const blackbox_log_t *log, long step) {
+    static blackbox_log_t reopened;
+    check(blackbox_log_open(&reopened, &flash, staging), "reopen", step);
+    check(reopened.count == log->count && reopened.head == log->head && reopened.next_sequence == log->next_sequence,
+          "reopened index differs", step);
+    check(memcmp(reopened.index, log->index, log->count * sizeof(log->index[0])) == 0, "reopened index entries differ",
+          step);
+}
+
+static void test_chunks(void) {
+    // 음성 대역 톤 + 잡음 + 큰 소리 구간 (스텝 크기가 빨리 바뀌는 경우)
+    enum { CHUNKS = 64, N = CHUNKS * CHUNK_SAMPLES };
+    static int16_t audio[N], sequential[N], independent[N];
+    static uint8_t chunks[CHUNKS][BLACKBOX_CHUNK_BYTES(CHUNK_SAMPLES)];
+    for (int i = 0; i < N; i++) {
+        double t = i / 16000.0;
+        double level = (i / 4000) % 3 == 2 ? 20000.0 : 2000.0;
+        double v = level * (sin(2 * M_PI * 440.0 * t) + 0.5 * sin(2 * M_PI * 1230.0 * t)) / 1.5 +
+                   300.0 * ((int32_t)rng() / 2147483648.0);
+        audio[i] = (int16_t)lrint(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+    ima_adpcm_state_t encoder, decoder;
+    ima_adpcm_init(&encoder);
+    ima_adpcm_init(&decoder);
+    double start = (double)boot_profile_now_us();
+    for (int c = 0; c < CHUNKS; c++) {
+        blackbox_chunk_encode(&encoder, audio + c * CHUNK_SAMPLES, CHUNK_SAMPLES, chunks[c]);
+    }
+    double encode_us = ((double)boot_profile_now_us() - start) / CHUNKS;
+    for (int c = 0; c < CHUNKS; c++) {
+        ima_adpcm_decode(&decoder, chunks[c] + BLACKBOX_CHUNK_HEADER, sequential + c * CHUNK_SAMPLES, CHUNK_SAMPLES);
+    }
+    for (int c = CHUNKS; c-- > 0;) {  // 거꾸로: 청크마다 따로
+        blackbox_chunk_decode(chunks[c], CHUNK_SAMPLES, independent + c * CHUNK_SAMPLES);
+    }
+    check(memcmp(sequential, independent, sizeof(sequential)) == 0, "chunk decode differs from sequential decode", 0);
+    double signal = 0.0, noise = 0.0;
+    for (int i = 0; i < N; i++) {
+        signal += (double)audio[i] * audio[i];
+        noise += (double)(audio[i] - independent[i]) * (audio[i] - independent[i]);
+    }
+    double snr = 10.0 * log10(signal / (noise + 1e-9));
+    check(snr > 20.0, "ADPCM SNR below 20 dB", 0);
+    printf("ADPCM chunks: %d bytes per %d samples, SNR %.1f dB, host encode %.1f us per chunk\n",
+           (int)BLACKBOX_CHUNK_BYTES(CHUNK_SAMPLES), CHUNK_SAMPLES, snr, encode_us);
+}
+
+int main(int argc, char **argv) {
+    uint32_t seed = 1;
+    long records = 400;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--records") == 0 && i + 1 < argc) {
+            records = strtol(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seed N] [--records N]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed ? seed : 1;
+    test_chunks();
+
+    // 빈 파티션 (지운 상태)
+    static blackbox_log_t log;
+    memset(sim.data, 0xFF, sizeof(sim.data));
+    sim.ops_left = -1;
+    check(blackbox_log_open(&log, &flash, staging), "open empty", 0);
+    check(log.count == 0 && log.head == 0 && log.next_sequence == 1, "empty log state", 0);
+
+    // 여러 바퀴: 기록마다 색인 확인, 가끔 다시 열기
+    long used_sectors = 0, live_min = SIM_SECTORS;
+    for (long r = 1; r <= records; r++) {
+        check(write_record(&log), "write record", r);
+        check(log.index[log.count - 1].sequence == (uint32_t)r, "newest record is last written", r);
+        verify_index(&log, r);
+        long live = 0;
+        for (size_t i = 0; i < log.count; i++) {
+            live += log.index[i].sectors;
+        }
+        if (r > 40 && live < live_min) {
+            live_min = live;  // 채운 뒤에 남아있는 기록이 차지하는 섹터 (가장 적을 때)
+        }
+        used_sectors += log.index[log.count - 1].sectors;
+        if (r % 16 == 0) {
+            verify_reopen(&log, r);
+        }
+    }
+    check(live_min >= SIM_SECTORS - (MAX_RECORD_BYTES / BLACKBOX_SECTOR_SIZE + 1), "too few records retained", 0);
+    uint32_t erase_min = UINT32_MAX, erase_max = 0;
+    for (int s = 0; s < SIM_SECTORS; s++) {
+        erase_min = sim.erases[s] < erase_min ? sim.erases[s] : erase_min;
+        erase_max = sim.erases[s] > erase_max ? sim.erases[s] : erase_max;
+    }
+    check(erase_max <= erase_min + 1, "erase counts uneven", 0);
+    printf("Ring: %ld records (%.1f laps), %u retained, at least %ld of %d sectors live, erases per sector %u..%u\n",
+           records, (double)used_sectors / SIM_SECTORS, (unsigned)log.count, live_min, SIM_SECTORS,
+           (unsigned)erase_min, (unsigned)erase_max);
+
+    // 전원 끊김: 기록 중 아무 flash 동작에서 끊고 다시 열기
+    long cuts = 0;
+    for (long trial = 0; trial < 200; trial++) {
+        uint32_t committed = log.next_sequence - 1;
+        sim.ops_left = 1 + rng() % 12;
+        bool written = write_record(&log);
+        sim.ops_left = -1;
+        check(blackbox_log_open(&log, &flash, staging), "open after power cut", trial);
+        uint32_t newest = log.count ? log.index[log.count - 1].sequence : 0;
+        check(newest == (written ? committed + 1 : committed), "newest record after power cut", trial);
+        verify_index(&log, trial);
+        cuts += !written;
+    }
+    printf("Power cuts: %ld of 200 records interrupted, index consistent after each reopen\n", cuts);
+
+    // 색인보다 많은 기록 (아주 작은 기록): 최신 BLACKBOX_LOG_MAX_RECORDS개
+    memset(sim.data, 0xFF, sizeof(sim.data));
+    flash.size = sizeof(sim.data);
+    blackbox_log_open(&log, &flash, staging);
+    for (uint32_t r = 0; r < 300; r++) {
+        blackbox_record_header_t header;
+        memset(&header, 0, sizeof(header));
+        check(blackbox_log_begin(&log, 16) && blackbox_log_commit(&log, &header), "small record", r);
+    }
+    check(log.count == BLACKBOX_LOG_MAX_RECORDS && log.index[log.count - 1].sequence == 300 &&
+              log.index[0].sequence == 300 - BLACKBOX_LOG_MAX_RECORDS + 1,
+          "index keeps newest records", 0);
+    verify_reopen(&log, 300);
+
+    check(sim.violations == 0, "flash programmed without erase / unaligned erase", 0);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
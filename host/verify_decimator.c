@@ -0,0 +1,123 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "decimator.h"
+
+// decimator.c 확인: 저지대역 감쇠, 통과대역 평탄도, DMA 버퍼 경계에서의 연속성, 처리 속도
+//
+//   ./verify_decimator
+//
+// 기준을 만족하지 못하면 FAIL을 출력하고 1을 반환합니다.
+
+#define INPUT_RATE   16000
+#define SIGNAL       (INPUT_RATE * 2)
+#define SETTLE       (DECIMATOR_TAPS * 2)  // 필터가 채워지기 전 출력은 제외
+
+#define PASSBAND_HZ        3200
+#define STOPBAND_HZ        4800
+#define MIN_STOPBAND_DB    60.0
+#define MAX_PASSBAND_DB    0.1
+
+static int16_t input[SIGNAL];
+static int16_t output[SIGNAL];
+static int16_t streamed[SIGNAL];
+
+// 사인파 하나를 통과시킨 출력 크기 / 입력 크기 (dB)
+static double tone_gain(double hz) {
+    const double amplitude = 16000;
+    for (int i = 0; i < SIGNAL; i++) {
+        input[i] = (int16_t)lrint(amplitude * sin(2 * M_PI * hz * i / INPUT_RATE));
+    }
+    decimator_t d;
+    decimator_init(&d);
+    size_t produced = decimator_process(&d, input, SIGNAL, output);
+
+    double sum = 0;
+    for (size_t i = SETTLE; i < produced; i++) {
+        sum += (double)output[i] * output[i];
+    }
+    double rms = sqrt(sum / (produced - SETTLE));
+    return 20 * log10((rms + 1e-9) / (amplitude / sqrt(2)));
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(void) {
+    int failures = 0;
+
+    // 1. 통과대역/저지대역 (반올림 잡음 때문에 저지대역은 약 -90dB 아래로는 측정되지 않음)
+    double pass_min = 1e9, pass_max = -1e9, stop_max = -1e9, stop_max_hz = 0;
+    for (double hz = 50; hz < INPUT_RATE / 2; hz += 50) {
+        double gain = tone_gain(hz);
+        if (hz <= PASSBAND_HZ) {
+            pass_min = gain < pass_min ? gain : pass_min;
+            pass_max = gain > pass_max ? gain : pass_max;
+        } else if (hz >= STOPBAND_HZ && gain > stop_max) {
+            stop_max = gain;
+            stop_max_hz = hz;
+        }
+    }
+    printf("Passband 0-%d Hz: %+.3f .. %+.3f dB\n", PASSBAND_HZ, pass_min, pass_max);
+    printf("Stopband >= %d Hz: worst %.1f dB at %.0f Hz\n", STOPBAND_HZ, stop_max, stop_max_hz);
+    if (pass_max - pass_min > MAX_PASSBAND_DB || fabs(pass_max) > MAX_PASSBAND_DB) {
+        printf("FAIL: passband ripple exceeds %.2f dB\n", MAX_PASSBAND_DB);
+        failures++;
+    }
+    if (stop_max > -MIN_STOPBAND_DB) {
+        printf("FAIL: stopband attenuation below %.0f dB\n", MIN_STOPBAND_DB);
+        failures++;
+    }
+
+    // 2. 스트리밍 연속성: 한 번에 처리한 결과와 여러 크기(홀수 포함)로 나눠서 처리한 결과가 같아야 함
+    uint32_t seed = 99;
+    for (int i = 0; i < SIGNAL; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        input[i] = (int16_t)(seed >> 16);
+    }
+    decimator_t d;
+    decimator_init(&d);
+    size_t expected = decimator_process(&d, input, SIGNAL, output);
+
+    static const size_t block_sizes[] = {1, 2, 3, 7, 255, 256, 511, 512, 513, 1000, 2000};
+    for (size_t b = 0; b < sizeof(block_sizes) / sizeof(block_sizes[0]); b++) {
+        decimator_init(&d);
+        size_t produced = 0;
+        for (size_t i = 0; i < SIGNAL; i += block_sizes[b]) {
+            size_t count = SIGNAL - i < block_sizes[b] ? SIGNAL - i : block_sizes[b];
+            // 펌웨어처럼 제자리 처리 (입력 버퍼에 출력)
+            static int16_t buffer[2048];
+            memcpy(buffer, input + i, count * sizeof(int16_t));
+            size_t n = decimator_process(&d, buffer, count, buffer);
+            memcpy(streamed + produced, buffer, n * sizeof(int16_t));
+            produced += n;
+        }
+        if (produced != expected || memcmp(streamed, output, expected * sizeof(int16_t)) != 0) {
+            printf("FAIL: block size %zu gives different output (%zu samples vs %zu)\n", block_sizes[b], produced, expected);
+            failures++;
+        }
+    }
+    printf("Streaming: %zu block sizes checked against single-call output\n", sizeof(block_sizes) / sizeof(block_sizes[0]));
+
+    // 3. 처리 속도 (512 샘플 DMA 버퍼 단위)
+    int iterations = 0;
+    double start = now_us(), elapsed = 0;
+    while (elapsed < 300000.0) {
+        decimator_init(&d);
+        for (int i = 0; i + 512 <= SIGNAL; i += 512) {
+            decimator_process(&d, input + i, 512, output + i / 2);
+        }
+        iterations++;
+        elapsed = now_us() - start;
+    }
+    printf("Host cost: %.2f input samples/us (%.3f us per 512-sample buffer)\n",
+           (double)iterations * SIGNAL / elapsed, elapsed / (iterations * (SIGNAL / 512.0)));
+
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,71 @@
+#include "wake_word_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool wake_word_sim_init(wake_word_sim_t *sim) {
+    memset(sim, 0, sizeof(*sim));
+    sim->hop = SIM_INFERENCE_HOP_SAMPLES;
+    sim->first = SIM_FIRST_INFERENCE_SAMPLES;
+    sim->window = SIM_MODEL_WINDOW_MAX_SAMPLES;
+    // 링 버퍼 크기도 wake_word.cpp와 같게 (덮어써지는 시점이 같도록)
+    if (!audio_ring_init(&sim->ring, SIM_MODEL_WINDOW_MAX_SAMPLES + SIM_PREROLL_SAMPLES + 4 * SIM_MODEL_BLOCK_SAMPLES)) {
+        return false;
+    }
+    wake_word_sim_reset(sim);
+    return true;
+}
+
+void wake_word_sim_free(wake_word_sim_t *sim) {
+    free(sim->ring.data);  // 호스트 경로는 malloc
+    sim->ring.data = NULL;
+}
+
+void wake_word_sim_reset(wake_word_sim_t *sim) {
+    capture_pipeline_init(&sim->pipeline);
+    audio_ring_reset(&sim->ring);
+    sim->last_position = 0;
+    sim->window_filled = false;
+    sim->hops = 0;
+}
+
+// wake_word.cpp capture_task → inference_step → fill_input과 같은 규칙
+const int16_t *wake_word_sim_block(wake_word_sim_t *sim, int16_t *block, size_t count, uint32_t *position_out) {
+    bool speech;
+    count = capture_pipeline_process(&sim->pipeline, block, count, &speech);
+    audio_ring_write(&sim->ring, block, count);
+
+    uint32_t position = audio_ring_position(&sim->ring);
+    if (position - sim->last_position < sim->hop || position < sim->first) {
+        return NULL;
+    }
+    sim->last_position = position;
+
+    sim->window_filled = sim->window_filled || position >= SIM_MODEL_WINDOW_MAX_SAMPLES;
+    size_t padding = !sim->window_filled && position < sim->window ? sim->window - position : 0;
+    memset(sim->window_buffer, 0, padding * sizeof(int16_t));
+    if (audio_ring_read(&sim->ring, position - sim->window + padding, sim->window_buffer + padding,
+                        sim->window - padding) != sim->window - padding) {
+        return NULL;
+    }
+    sim->hops++;
+    *position_out = position;
+    return sim->window_buffer;
+}
+
+uint32_t wake_word_sim_crc32(uint32_t crc, const uint8_t *data, size_t length) {
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
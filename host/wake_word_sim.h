@@ -0,0 +1,55 @@
+#ifndef WAKE_WORD_SIM_H
+#define WAKE_WORD_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "audio_config.h"
+#include "audio_ring.h"
+#include "capture_pipeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// wake_word.cpp 오디오 경로 (캡처 블록 → capture_pipeline → 링 버퍼 → 추론 시점/모델 입력 창)
+// sim_wake_word(PCM 주입 비교)와 eval_corpus(코퍼스 평가)가 같이 씁니다.
+// 인스턴스마다 상태와 창 버퍼를 따로 가지므로 스레드마다 하나씩 쓰면 됩니다.
+
+// wake_word.cpp와 같은 값
+#define SIM_CAPTURE_BLOCK_SAMPLES 512
+#define SIM_MODEL_BLOCK_SAMPLES (SIM_CAPTURE_BLOCK_SAMPLES / MODEL_DECIMATION)
+#define SIM_MODEL_WINDOW_MAX_SAMPLES MODEL_SAMPLE_RATE
+#define SIM_PREROLL_SAMPLES (MODEL_SAMPLE_RATE * 300 / 1000)
+#define SIM_INFERENCE_HOP_SAMPLES (MODEL_SAMPLE_RATE * 100 / 1000)
+#define SIM_FIRST_INFERENCE_SAMPLES (MODEL_SAMPLE_RATE * 300 / 1000)
+
+typedef struct {
+    capture_pipeline_t pipeline;
+    audio_ring_t ring;
+    uint32_t last_position;
+    bool window_filled;
+    size_t hop, first, window;  // 추론 간격, 첫 추론까지 필요한 샘플 수, 모델 입력 창 길이
+    uint32_t hops;
+    int16_t window_buffer[SIM_MODEL_WINDOW_MAX_SAMPLES];
+} wake_word_sim_t;
+
+// 기본 설정(펌웨어 기본값)으로 초기화하고 링 버퍼를 할당 (wake_word.cpp와 같은 크기)
+bool wake_word_sim_init(wake_word_sim_t *sim);
+void wake_word_sim_free(wake_word_sim_t *sim);
+
+// 파일/주입을 새로 시작할 때 (DSP 상태, 링 버퍼, 추론 시점을 처음으로)
+void wake_word_sim_reset(wake_word_sim_t *sim);
+
+// 캡처 블록 하나 (I2S_SAMPLE_RATE, 제자리 처리)
+// 추론 시점이면 모델 입력 창(window 샘플, 앞부분 무음 포함)을 반환하고 *position에 링 버퍼 위치, 아니면 NULL
+const int16_t *wake_word_sim_block(wake_word_sim_t *sim, int16_t *block, size_t count, uint32_t *position);
+
+// esp_rom_crc32_le(crc, ...)와 같은 CRC32 (zlib.crc32와 같음)
+uint32_t wake_word_sim_crc32(uint32_t crc, const uint8_t *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAKE_WORD_SIM_H
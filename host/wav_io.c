@@ -0,0 +1,143 @@
+#include "wav_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t read_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+int16_t *wav_read(const char *path, int sample_rate, int *channels_out, size_t *frames_out) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    uint8_t header[12];
+    if (fread(header, 1, 12, f) != 12 || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    int channels = 0, bits = 0;
+    uint32_t rate = 0;
+    uint8_t *data = NULL;
+    uint32_t data_size = 0;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, 8, f) == 8) {
+        uint32_t size = read_u32(chunk + 4);
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            uint8_t fmt[16];
+            if (fread(fmt, 1, 16, f) != 16) {
+                break;
+            }
+            if (read_u16(fmt) != 1) {  // PCM만
+                break;
+            }
+            channels = read_u16(fmt + 2);
+            rate = read_u32(fmt + 4);
+            bits = read_u16(fmt + 14);
+            fseek(f, size - 16 + (size & 1), SEEK_CUR);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            data = malloc(size ? size : 1);
+            data_size = (uint32_t)fread(data, 1, size, f);
+            break;
+        } else {
+            fseek(f, size + (size & 1), SEEK_CUR);
+        }
+    }
+    fclose(f);
+    if (!data || channels <= 0 || (bits != 8 && bits != 16) || rate == 0) {
+        free(data);
+        return NULL;
+    }
+
+    // int16으로 변환 (8비트 WAV는 unsigned)
+    const size_t sample_bytes = bits / 8;
+    const size_t frames = data_size / (channels * sample_bytes);
+    const size_t count = frames * channels;
+    int16_t *samples = malloc((count ? count : 1) * sizeof(int16_t));
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *p = data + i * sample_bytes;
+        samples[i] = bits == 8 ? (int16_t)(((int32_t)p[0] - 128) << 8) : (int16_t)read_u16(p);
+    }
+    free(data);
+
+    *channels_out = channels;
+    if ((int)rate == sample_rate) {
+        *frames_out = frames;
+        return samples;
+    }
+
+    // 선형 보간 리샘플링
+    size_t out_frames = (size_t)((double)frames * sample_rate / rate);
+    int16_t *out = malloc((out_frames ? out_frames : 1) * channels * sizeof(int16_t));
+    for (size_t i = 0; i < out_frames; i++) {
+        double position = (double)i * rate / sample_rate;
+        size_t index = (size_t)position;
+        double frac = position - index;
+        for (int c = 0; c < channels; c++) {
+            int16_t a = samples[index * channels + c];
+            int16_t b = index + 1 < frames ? samples[(index + 1) * channels + c] : a;
+            out[i * channels + c] = (int16_t)(a + (b - a) * frac);
+        }
+    }
+    free(samples);
+    *frames_out = out_frames;
+    return out;
+}
+
+int16_t *wav_read_mono(const char *path, int sample_rate, size_t *count) {
+    int channels;
+    size_t frames;
+    int16_t *samples = wav_read(path, sample_rate, &channels, &frames);
+    if (!samples || channels == 1) {
+        *count = samples ? frames : 0;
+        return samples;
+    }
+    for (size_t i = 0; i < frames; i++) {
+        int32_t sum = 0;
+        for (int c = 0; c < channels; c++) {
+            sum += samples[i * channels + c];
+        }
+        samples[i] = (int16_t)(sum / channels);
+    }
+    *count = frames;
+    return samples;
+}
+
+int wav_write(const char *path, int sample_rate, int channels, const int16_t *samples, size_t frames) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return -1;
+    }
+    uint32_t data_size = (uint32_t)(frames * channels * sizeof(int16_t));
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    uint32_t riff_size = 36 + data_size;
+    memcpy(header + 4, &riff_size, 4);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    uint32_t fmt_size = 16;
+    uint16_t format = 1, channel_count = (uint16_t)channels, block_align = (uint16_t)(2 * channels), bits = 16;
+    uint32_t rate = (uint32_t)sample_rate, byte_rate = rate * block_align;
+    memcpy(header + 16, &fmt_size, 4);
+    memcpy(header + 20, &format, 2);
+    memcpy(header + 22, &channel_count, 2);
+    memcpy(header + 24, &rate, 4);
+    memcpy(header + 28, &byte_rate, 4);
+    memcpy(header + 32, &block_align, 2);
+    memcpy(header + 34, &bits, 2);
+    memcpy(header + 36, "data", 4);
+    memcpy(header + 40, &data_size, 4);
+    int ok = fwrite(header, 1, sizeof(header), f) == sizeof(header) &&
+             fwrite(samples, sizeof(int16_t), frames * channels, f) == frames * channels;
+    fclose(f);
+    return ok ? 0 : -1;
+}
+
+int wav_write_mono(const char *path, int sample_rate, const int16_t *samples, size_t count) {
+    return wav_write(path, sample_rate, 1, samples, count);
+}
@@ -0,0 +1,29 @@
+#ifndef WAV_IO_H
+#define WAV_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 호스트 도구용 간단한 WAV 입출력 (PCM 8/16비트)
+// 샘플링 레이트가 다르면 선형 보간으로 sample_rate에 맞춤.
+// 반환값은 malloc한 버퍼 (실패 시 NULL)
+
+// 채널 순서대로 섞인(interleaved) 샘플. *channels에 채널 수, *frames에 프레임 수
+int16_t *wav_read(const char *path, int sample_rate, int *channels, size_t *frames);
+
+// 여러 채널이면 평균해서 모노로
+int16_t *wav_read_mono(const char *path, int sample_rate, size_t *count);
+
+int wav_write(const char *path, int sample_rate, int channels, const int16_t *samples, size_t frames);
+
+int wav_write_mono(const char *path, int sample_rate, const int16_t *samples, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAV_IO_H
@@ -0,0 +1,147 @@
+#define _DEFAULT_SOURCE
+#include "wav_mmap.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define RELEASE_BYTES (1u << 20)  // 이만큼 지나갈 때마다 페이지를 돌려줌
+
+static uint32_t read_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+bool wav_mmap_open(wav_mmap_t *wav, const char *path) {
+    memset(wav, 0, sizeof(*wav));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 12) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // 매핑은 fd를 닫아도 유지됨
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    wav->map = map;
+    wav->map_size = (size_t)st.st_size;
+    madvise(map, wav->map_size, MADV_SEQUENTIAL);
+
+    const uint8_t *p = wav->map;
+    const uint8_t *end = p + wav->map_size;
+    if (memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        wav_mmap_close(wav);
+        return false;
+    }
+    p += 12;
+    size_t data_size = 0;
+    while (end - p >= 8) {
+        uint32_t size = read_u32(p + 4);
+        const uint8_t *body = p + 8;
+        if (memcmp(p, "fmt ", 4) == 0 && size >= 16 && end - body >= 16) {
+            uint16_t format = read_u16(body);
+            if (format != 1 && format != 0xFFFE) {  // PCM (WAVE_FORMAT_EXTENSIBLE도 정수 PCM으로 가정)
+                break;
+            }
+            wav->channels = read_u16(body + 2);
+            wav->rate = (int)read_u32(body + 4);
+            wav->bits = read_u16(body + 14);
+        } else if (memcmp(p, "data", 4) == 0) {
+            // 녹음 중에 끊긴 파일은 크기가 0이나 0xFFFFFFFF일 수 있으므로 파일 끝까지로 자름
+            wav->data = body;
+            data_size = (size_t)(end - body) < size || size == 0 ? (size_t)(end - body) : size;
+            break;
+        }
+        if ((size_t)(end - body) < size + (size & 1)) {
+            break;
+        }
+        p = body + size + (size & 1);
+    }
+    if (!wav->data || wav->channels <= 0 || wav->rate <= 0 ||
+        (wav->bits != 8 && wav->bits != 16 && wav->bits != 24 && wav->bits != 32)) {
+        wav_mmap_close(wav);
+        return false;
+    }
+    wav->frames = data_size / ((size_t)wav->channels * (wav->bits / 8));
+    return true;
+}
+
+void wav_mmap_close(wav_mmap_t *wav) {
+    if (wav->map) {
+        munmap((void *)wav->map, wav->map_size);
+    }
+    memset(wav, 0, sizeof(*wav));
+}
+
+size_t wav_mmap_length(const wav_mmap_t *wav, int sample_rate) {
+    if (wav->rate == sample_rate) {
+        return wav->frames;
+    }
+    return (size_t)((double)wav->frames * sample_rate / wav->rate);
+}
+
+// 원본 프레임 frame, 채널 c → int16 (8비트 WAV는 unsigned, 24/32비트는 상위 16비트)
+static int16_t source_sample(const wav_mmap_t *wav, size_t frame, int c) {
+    const size_t sample_bytes = wav->bits / 8;
+    const uint8_t *p = wav->data + (frame * wav->channels + c) * sample_bytes;
+    if (wav->bits == 8) {
+        return (int16_t)(((int32_t)p[0] - 128) << 8);
+    }
+    return (int16_t)read_u16(p + sample_bytes - 2);
+}
+
+// data의 byte 앞까지 페이지 단위로 돌려줌 (MAP_PRIVATE 읽기 전용이라 다시 닿으면 파일에서 다시 읽힘)
+static void release_before(wav_mmap_t *wav, size_t byte) {
+    if (byte < wav->released + RELEASE_BYTES) {
+        return;
+    }
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t start = ((size_t)(wav->data - wav->map) + wav->released) / page * page;
+    const size_t stop = ((size_t)(wav->data - wav->map) + byte) / page * page;
+    if (stop > start) {
+        madvise((void *)(wav->map + start), stop - start, MADV_DONTNEED);
+    }
+    wav->released = byte;
+}
+
+size_t wav_mmap_read_mono(wav_mmap_t *wav, int sample_rate, size_t offset, int16_t *out, size_t count) {
+    const size_t length = wav_mmap_length(wav, sample_rate);
+    const size_t available = offset >= length ? 0 : (length - offset < count ? length - offset : count);
+    const bool resample = wav->rate != sample_rate;
+    for (size_t i = 0; i < available; i++) {
+        size_t index = offset + i;
+        double frac = 0.0;
+        if (resample) {
+            // wav_io.c와 같은 선형 보간 (채널마다 int16으로 만든 뒤 평균)
+            double position = (double)index * wav->rate / sample_rate;
+            index = (size_t)position;
+            frac = position - index;
+        }
+        int32_t sum = 0;
+        for (int c = 0; c < wav->channels; c++) {
+            int16_t a = source_sample(wav, index, c);
+            if (resample) {
+                int16_t b = index + 1 < wav->frames ? source_sample(wav, index + 1, c) : a;
+                a = (int16_t)(a + (b - a) * frac);
+            }
+            sum += a;
+        }
+        out[i] = (int16_t)(sum / wav->channels);
+    }
+    memset(out + available, 0, (count - available) * sizeof(int16_t));
+
+    if (available > 0) {
+        size_t first = resample ? (size_t)((double)offset * wav->rate / sample_rate) : offset;
+        release_before(wav, first * wav->channels * (wav->bits / 8));
+    }
+    return available;
+}
@@ -0,0 +1,43 @@
+#ifndef WAV_MMAP_H
+#define WAV_MMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 메모리 맵 WAV 읽기 (큰 코퍼스용, 파일 전체를 메모리에 올리지 않음)
+// 읽은 앞부분의 페이지는 바로 돌려주므로 파일이 커도 프로세스 메모리는 일정합니다.
+// wav_io.c의 wav_read_mono()와 같은 변환 (PCM 8/16비트, 선형 보간 리샘플링 → 채널 평균)이라
+// 같은 파일이면 결과 샘플이 같습니다. 24/32비트 PCM도 읽지만 상위 16비트만 씁니다.
+
+typedef struct {
+    const uint8_t *map;   // 파일 전체 매핑
+    size_t map_size;
+    const uint8_t *data;  // data 청크 시작
+    size_t frames;        // 원본 프레임 수
+    int channels;
+    int bits;
+    int rate;
+    size_t released;      // 돌려준 바이트 수 (data 기준, 페이지 단위)
+} wav_mmap_t;
+
+// 실패하면 false (파일 없음, PCM이 아님, 지원하지 않는 비트 수)
+bool wav_mmap_open(wav_mmap_t *wav, const char *path);
+void wav_mmap_close(wav_mmap_t *wav);
+
+// sample_rate로 변환했을 때의 샘플 수
+size_t wav_mmap_length(const wav_mmap_t *wav, int sample_rate);
+
+// sample_rate 모노로 변환한 샘플 [offset, offset + count)를 out에 (끝을 넘는 부분은 0), 실제 샘플 수를 반환
+// offset이 앞으로만 진행한다고 가정하고 지나간 페이지를 돌려줍니다.
+size_t wav_mmap_read_mono(wav_mmap_t *wav, int sample_rate, size_t offset, int16_t *out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAV_MMAP_H
@@ -0,0 +1,172 @@
+import argparse
+import os
+import struct
+import sys
+import wave
+import zlib
+
+import serial
+
+# ESP32 블랙박스 기록(src/blackbox.c)을 UART로 한 번에 받아서 기록마다 WAV와 점수 CSV로 저장합니다.
+# 사용자가 "가만히 있는데 반응했다"고 하면 이 기록으로 검출 앞뒤에 어떤 소리가 있었고 점수가 어떻게 올라갔는지 봅니다.
+#
+# 장치가 보내는 형식 (BLACKBOX_DUMP 명령):
+#   BLACKBOX records=N\n
+#   BLACKBOX_RECORD seq=.. size=..\n  + 기록 size 바이트 (헤더 64바이트 + ADPCM 청크들 + 점수 타임라인)  ... N번
+#   BLACKBOX_END\n
+# 형식은 src/blackbox_log.h와 같아야 합니다. 중간에 콘솔 로그가 끼면 CRC가 맞지 않는 기록으로 표시합니다.
+#
+# 사용 예시:
+#   python scripts/blackbox_dump.py --port /dev/ttyUSB0 --out blackbox
+#   python scripts/blackbox_dump.py --raw dump.bin --out blackbox    # 저장해둔 덤프(--save-raw)에서
+
+HEADER = struct.Struct("<IHHIIIIHHHHHbB24sI")  # blackbox_record_header_t
+SCORE = struct.Struct("<HBBBb")                 # blackbox_score_t
+MAGIC = 0x31584242
+CHUNK_HEADER = 4
+
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635,
+    13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def decode_chunk(chunk, samples):
+    # src/ima_adpcm.c와 같은 IMA ADPCM (청크 앞 4바이트가 시작 상태)
+    predictor = struct.unpack_from("<h", chunk, 0)[0]
+    index = min(chunk[2], 88)
+    out = []
+    for i in range(samples):
+        code = chunk[CHUNK_HEADER + i // 2] >> (4 * (i & 1)) & 0x0F
+        step = STEP_TABLE[index]
+        diff = step >> 3
+        if code & 4:
+            diff += step
+        if code & 2:
+            diff += step >> 1
+        if code & 1:
+            diff += step >> 2
+        predictor = max(-32768, min(32767, predictor - diff if code & 8 else predictor + diff))
+        index = max(0, min(88, index + INDEX_TABLE[code & 7]))
+        out.append(predictor)
+    return out
+
+
+def parse_record(data):
+    fields = HEADER.unpack_from(data, 0)
+    (magic, version, header_size, sequence, data_size, data_crc, uptime_ms, sample_rate, chunk_samples,
+     chunks, trigger_chunk, scores, event_class, event_score, label, header_crc) = fields
+    if magic != MAGIC or header_size != HEADER.size or zlib.crc32(data[:HEADER.size - 4]) != header_crc:
+        return None, "bad header"
+    body = data[HEADER.size:HEADER.size + data_size]
+    if len(body) != data_size or zlib.crc32(body) != data_crc:
+        return None, "data CRC mismatch"
+    chunk_bytes = CHUNK_HEADER + (chunk_samples + 1) // 2
+    audio = []
+    for c in range(chunks):
+        audio += decode_chunk(body[c * chunk_bytes:(c + 1) * chunk_bytes], chunk_samples)
+    timeline = [SCORE.unpack_from(body, chunks * chunk_bytes + i * SCORE.size) for i in range(scores)]
+    return {
+        "sequence": sequence, "uptime_ms": uptime_ms, "sample_rate": sample_rate, "chunk_samples": chunk_samples,
+        "trigger_s": trigger_chunk * chunk_samples / sample_rate, "event_class": event_class,
+        "event_score": event_score / 255.0, "label": label.split(b"\0")[0].decode("utf-8", "replace"),
+        "audio": audio, "timeline": timeline,
+    }, None
+
+
+def save(record, out_dir):
+    safe = "".join(ch if ch.isalnum() else "_" for ch in record["label"]) or "event"
+    base = os.path.join(out_dir, f"blackbox_{record['sequence']:05d}_{safe}")
+    with wave.open(base + ".wav", "wb") as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(2)
+        wav.setframerate(record["sample_rate"])
+        wav.writeframes(struct.pack(f"<{len(record['audio'])}h", *record["audio"]))
+    with open(base + ".csv", "w") as csv:
+        csv.write("time_s,top_class,top_score,wake_score,detected\n")
+        for chunk, top_class, top_score, wake_score, detected in record["timeline"]:
+            t = chunk * record["chunk_samples"] / record["sample_rate"]
+            csv.write(f"{t:.3f},{top_class},{top_score / 255:.3f},{wake_score / 255:.3f},{detected}\n")
+    return base
+
+
+def read_dump(ser):
+    # 장치에서 기록들을 받음: [(seq, bytes)]
+    ser.reset_input_buffer()
+    ser.write(b"BLACKBOX_DUMP\n")
+    records = []
+    expected = None
+    while True:
+        line = ser.readline()
+        if not line:
+            raise TimeoutError("no response (BLACKBOX_DUMP)")
+        text = line.decode("ascii", "replace").strip()
+        if text.startswith("BLACKBOX records="):
+            expected = int(text.split("=")[1])
+            print(f"{expected} records on device")
+        elif text.startswith("BLACKBOX_RECORD"):
+            fields = dict(item.split("=") for item in text.split()[1:])
+            size = int(fields["size"])
+            data = ser.read(size)
+            if len(data) != size:
+                raise TimeoutError(f"record {fields['seq']}: {len(data)} of {size} bytes")
+            records.append(data)
+        elif text == "BLACKBOX_END":
+            if expected is not None and len(records) != expected:
+                print(f"warning: {len(records)} of {expected} records received")
+            return records
+        # 그 외 줄(콘솔 로그)은 무시
+
+
+def main():
+    parser = argparse.ArgumentParser(description="블랙박스 기록(검출 앞뒤 오디오, 점수) 받기")
+    parser.add_argument("--port", default="/dev/ttyUSB0")
+    parser.add_argument("--baud", type=int, default=460800)
+    parser.add_argument("--out", default="blackbox", help="WAV/CSV를 저장할 폴더")
+    parser.add_argument("--save-raw", help="받은 기록을 그대로 저장할 파일 (나중에 --raw로)")
+    parser.add_argument("--raw", help="장치 대신 --save-raw로 저장한 파일에서 읽기")
+    args = parser.parse_args()
+
+    if args.raw:
+        with open(args.raw, "rb") as f:
+            blob = f.read()
+        records, offset = [], 0
+        while offset + HEADER.size <= len(blob):
+            size = HEADER.size + HEADER.unpack_from(blob, offset)[4]
+            records.append(blob[offset:offset + size])
+            offset += size
+    else:
+        ser = serial.Serial(port=args.port, baudrate=args.baud, timeout=5)
+        ser.dtr = False  # USB 포트가 열릴 때 리셋되지 않도록
+        ser.rts = False
+        try:
+            records = read_dump(ser)
+        finally:
+            ser.close()
+        if args.save_raw:
+            with open(args.save_raw, "wb") as f:
+                f.write(b"".join(records))
+
+    os.makedirs(args.out, exist_ok=True)
+    bad = 0
+    for data in records:
+        record, error = parse_record(data)
+        if record is None:
+            bad += 1
+            print(f"skipped record: {error}")
+            continue
+        base = save(record, args.out)
+        peak = max((s[3] for s in record["timeline"]), default=0) / 255.0
+        print(f"#{record['sequence']} {record['label']} ({record['event_score']:.2f}) at {record['uptime_ms'] / 1000:.1f} s "
+              f"uptime, trigger at {record['trigger_s']:.2f} s of {len(record['audio']) / record['sample_rate']:.2f} s, "
+              f"peak wake score {peak:.2f} -> {base}.wav")
+    print(f"{len(records) - bad} records saved to {args.out}/" + (f", {bad} corrupted" if bad else ""))
+    return 1 if bad else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+import argparse
+import sys
+import time
+import wave
+
+import serial
+
+from link_rate import negotiate
+
+# 호출어('리지야') 검출 후 ESP32(src/wake_word.cpp)가 보내는 명령어 오디오를 받아서 WAV로 저장합니다.
+# (TRANSPORT_UART 빌드. Wi-Fi TCP/UDP 빌드는 scripts/stream_receiver.py)
+#
+# ESP32가 보내는 형식:
+#   <CAPTURE_START>
+#   <DATA_START> 오디오 (최대 1024샘플) <DATA_END> ... (검출 전 PREROLL_MS부터 말이 끝날 때까지 반복)
+#   <CAPTURE_END>
+# 태그 밖의 데이터(콘솔 로그)는 무시합니다.
+#
+# 사용 예시:
+#   python scripts/command_receiver.py --port /dev/ttyUSB0
+#   python scripts/command_receiver.py --port /dev/ttyUSB0 --negotiate   # 먼저 UART 속도를 올림 (scripts/link_rate.py)
+
+CAPTURE_START = b"<CAPTURE_START>"
+CAPTURE_END = b"<CAPTURE_END>"
+DATA_START = b"<DATA_START>"
+DATA_END = b"<DATA_END>"
+
+SAMPLE_RATE = 16000  # ESP32 MODEL_SAMPLE_RATE 기본값 (8kHz로 빌드했으면 --rate 8000)
+SAMPLE_WIDTH = 2
+
+
+def save_wav(path, audio, sample_rate):
+    with wave.open(path, "wb") as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(SAMPLE_WIDTH)
+        wav.setframerate(sample_rate)
+        wav.writeframes(audio)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="호출어 뒤 명령어 오디오 수신")
+    parser.add_argument("--port", default="/dev/ttyUSB0")
+    parser.add_argument("--baud", type=int, default=460800)
+    parser.add_argument("--negotiate", action="store_true", help="받기 전에 더 빠른 UART 속도를 협상")
+    parser.add_argument("--prefix", default="command", help="저장할 WAV 파일 이름 앞부분")
+    parser.add_argument("--rate", type=int, default=SAMPLE_RATE, choices=(8000, 16000),
+                        help="오디오 샘플링 레이트 (펌웨어 MODEL_SAMPLE_RATE)")
+    args = parser.parse_args()
+
+    ser = serial.Serial(port=args.port, baudrate=args.baud, timeout=0.05)
+    ser.dtr = False  # USB 포트가 열릴 때 리셋되지 않도록
+    ser.rts = False
+    if args.negotiate:
+        ser.timeout = 0.2
+        negotiate(ser)
+        ser.timeout = 0.05
+    print(f"Connected to {args.port} at {ser.baudrate} baud. Waiting for wake word...")
+
+    buffer = b""
+    audio = None          # 캡처 중이면 bytearray
+    started_at = 0.0
+    count = 0
+    try:
+        while True:
+            buffer += ser.read(4096)
+
+            while True:
+                if audio is None:
+                    index = buffer.find(CAPTURE_START)
+                    if index < 0:
+                        buffer = buffer[-len(CAPTURE_START):]  # 태그가 잘려서 들어올 수 있으므로 끝부분은 남김
+                        break
+                    buffer = buffer[index + len(CAPTURE_START):]
+                    audio = bytearray()
+                    started_at = time.time()
+                    print("Wake word detected, receiving command...")
+                    continue
+
+                start = buffer.find(DATA_START)
+                end_capture = buffer.find(CAPTURE_END)
+                if end_capture >= 0 and (start < 0 or end_capture < start):
+                    # 캡처 끝
+                    buffer = buffer[end_capture + len(CAPTURE_END):]
+                    count += 1
+                    path = f"{args.prefix}_{time.strftime('%Y%m%d_%H%M%S')}_{count}.wav"
+                    save_wav(path, bytes(audio), args.rate)
+                    seconds = len(audio) / (args.rate * SAMPLE_WIDTH)
+                    print(f"Saved {path}: {seconds:.2f} s of audio ({time.time() - started_at:.2f} s wall)")
+                    audio = None
+                    continue
+
+                if start < 0:
+                    break
+                end = buffer.find(DATA_END, start)
+                if end < 0:
+                    break  # 프레임이 아직 다 안 들어옴
+                frame = buffer[start + len(DATA_START):end]
+                if len(audio) == 0:
+                    print(f"First audio frame after {(time.time() - started_at) * 1000:.0f} ms ({len(frame)} bytes)")
+                audio += frame[:len(frame) - len(frame) % SAMPLE_WIDTH]
+                buffer = buffer[end + len(DATA_END):]
+    except KeyboardInterrupt:
+        pass
+    finally:
+        ser.close()
+        print(f"Disconnected from {args.port}.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
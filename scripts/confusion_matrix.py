@@ -0,0 +1,168 @@
+import argparse
+import multiprocessing
+import os
+import sys
+import wave
+
+import numpy as np
+
+from model_utils import load_interpreter_class, parse_model_header
+
+# 라벨별 폴더에 정리된 WAV 파일로 모델의 혼동 행렬(confusion matrix)을 계산합니다.
+# 펌웨어와 같은 모델(src/wake_word_model.h의 model_tflite[])과 같은 라벨 테이블(model_classes[]),
+# 같은 평활화/임계값 규칙(src/keyword_detector.c)을 사용합니다.
+#
+# 데이터 폴더 구조 예시:
+#   dataset/리지야/*.wav
+#   dataset/_unknown_/*.wav
+#   dataset/온도/*.wav
+#
+# 사용 예시:
+#   python scripts/confusion_matrix.py dataset
+#   python scripts/confusion_matrix.py dataset --model new_model.tflite --jobs 8
+
+MODEL_HEADER = os.path.join(os.path.dirname(__file__), "..", "src", "wake_word_model.h")
+SAMPLE_RATE = 16000  # 펌웨어 MODEL_SAMPLE_RATE 기본값 (8kHz 모델이면 --rate 8000)
+NO_DETECTION = "(none)"
+
+
+class KeywordDetector:
+    # src/keyword_detector.c와 같은 규칙 (클래스별 이동 평균 + 임계값 + refractory)
+    def __init__(self, classes):
+        self.classes = classes
+        self.history = [[] for _ in classes]
+        self.cooldown = [0] * len(classes)
+
+    def update(self, scores):
+        detected, best = -1, 0.0
+        for c, cls in enumerate(self.classes):
+            history = self.history[c]
+            history.append(float(scores[c]))
+            if len(history) > cls["smoothing"]:
+                history.pop(0)
+            average = sum(history) / len(history)
+
+            if self.cooldown[c] > 0:
+                self.cooldown[c] -= 1
+                continue
+            if cls["background"] or average < cls["threshold"]:
+                continue
+            if detected < 0 or average > best:
+                detected, best = c, average
+        if detected >= 0:
+            self.cooldown[detected] = self.classes[detected]["refractory"]
+        return detected
+
+
+def read_wav(path, sample_rate=SAMPLE_RATE):
+    with wave.open(path, "rb") as wav:
+        if wav.getframerate() != sample_rate or wav.getsampwidth() != 2:
+            raise ValueError(f"{path}: {sample_rate} Hz 16비트 WAV만 지원합니다.")
+        frames = np.frombuffer(wav.readframes(wav.getnframes()), dtype="<i2")
+        if wav.getnchannels() > 1:
+            frames = frames[::wav.getnchannels()]  # 왼쪽 채널만 사용 (펌웨어와 동일)
+    return frames.astype(np.float32) / 32768.0  # 펌웨어와 같은 정규화
+
+
+_worker = {}
+
+
+def init_worker(model, classes, hop, sample_rate):
+    interpreter = load_interpreter_class()(model_content=model, num_threads=1)
+    interpreter.allocate_tensors()
+    _worker["interpreter"] = interpreter
+    _worker["classes"] = classes
+    _worker["hop"] = hop
+    _worker["sample_rate"] = sample_rate
+
+
+def classify_file(item):
+    path, truth = item
+    interpreter = _worker["interpreter"]
+    classes = _worker["classes"]
+    input_detail = interpreter.get_input_details()[0]
+    output_detail = interpreter.get_output_details()[0]
+    window = int(input_detail["shape"][-1])
+
+    audio = read_wav(path, _worker["sample_rate"])
+    if len(audio) < window:
+        audio = np.pad(audio, (0, window - len(audio)))
+
+    detector = KeywordDetector(classes)
+    predicted = NO_DETECTION
+    for start in range(0, len(audio) - window + 1, _worker["hop"]):
+        interpreter.set_tensor(input_detail["index"], audio[start:start + window].reshape(input_detail["shape"]))
+        interpreter.invoke()
+        scores = interpreter.get_tensor(output_detail["index"]).reshape(-1)
+        if output_detail["dtype"] == np.int8:
+            scale, zero_point = output_detail["quantization"]
+            scores = (scores.astype(np.float32) - zero_point) * scale
+        detected = detector.update(scores)
+        if detected >= 0:
+            predicted = classes[detected]["label"]
+            break
+    return truth, predicted
+
+
+def collect_files(root):
+    items = []
+    for label in sorted(os.listdir(root)):
+        folder = os.path.join(root, label)
+        if not os.path.isdir(folder):
+            continue
+        for dirpath, _, filenames in os.walk(folder):
+            for name in sorted(filenames):
+                if name.lower().endswith(".wav"):
+                    items.append((os.path.join(dirpath, name), label))
+    return items
+
+
+def print_matrix(truths, columns, matrix):
+    width = max(len(x) for x in truths + columns + ["true \\ pred"]) + 2
+    print("true \\ pred".ljust(width) + "".join(c.rjust(width) for c in columns) + "recall".rjust(width))
+    for t, truth in enumerate(truths):
+        row = matrix[t]
+        total = sum(row)
+        correct = row[columns.index(truth)] if truth in columns else 0
+        recall = f"{correct / total:.3f}" if total else "-"
+        print(truth.ljust(width) + "".join(str(v).rjust(width) for v in row) + recall.rjust(width))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="라벨별 WAV 폴더로 혼동 행렬 계산")
+    parser.add_argument("dataset", help="라벨 이름의 하위 폴더에 WAV 파일이 들어있는 폴더")
+    parser.add_argument("--model", help=".tflite 파일 (기본값: src/wake_word_model.h의 모델)")
+    parser.add_argument("--header", default=MODEL_HEADER, help="라벨 테이블을 읽을 헤더 파일")
+    parser.add_argument("--hop-ms", type=int, default=100, help="추론 간격 (ms)")
+    parser.add_argument("--rate", type=int, default=SAMPLE_RATE, choices=(8000, 16000),
+                        help="모델 샘플링 레이트 (펌웨어 MODEL_SAMPLE_RATE)")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="병렬 작업 수 (기본값: CPU 코어 수)")
+    args = parser.parse_args()
+
+    model, classes = parse_model_header(args.header)
+    if args.model:
+        with open(args.model, "rb") as f:
+            model = f.read()
+
+    items = collect_files(args.dataset)
+    if not items:
+        print(f"No WAV files found in {args.dataset}")
+        return 1
+    print(f"{len(items)} files, {len(classes)} classes, {args.jobs} jobs")
+
+    hop = args.rate * args.hop_ms // 1000
+    with multiprocessing.Pool(args.jobs, initializer=init_worker, initargs=(model, classes, hop, args.rate)) as pool:
+        results = pool.map(classify_file, items, chunksize=max(1, len(items) // (args.jobs * 8)))
+
+    truths = sorted({truth for truth, _ in results})
+    columns = [cls["label"] for cls in classes if not cls["background"]] + [NO_DETECTION]
+    matrix = [[0] * len(columns) for _ in truths]
+    for truth, predicted in results:
+        matrix[truths.index(truth)][columns.index(predicted)] += 1
+
+    print_matrix(truths, columns, matrix)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,71 @@
+import argparse
+import struct
+import sys
+
+import numpy as np
+
+# host/golden_vectors.cpp가 기록한 골든 벡터 파일 읽기 (형식은 golden_vectors.cpp 주석 참고)
+# scripts/pcm_inject.py --golden이 이 모듈로 입력 샘플과 추론별 결과(위치, 입력 창 CRC, 확률, 검출)를 읽어서
+# 장치에 같은 샘플을 주입한 결과와 비교합니다.
+#
+# 사용 예시:
+#   python scripts/golden_vectors.py data/golden_vectors.bin    # 파일 내용 요약
+
+STAGES = ["source", "capture", "features", "input", "layer", "scores", "detection"]
+DTYPES = ["<i1", "<i2", "<i4", "<f4", "<u4"]
+HEADER = struct.Struct("<4sHHHHIII8sII")
+RECORD = struct.Struct("<BBHII")
+
+
+def read_golden(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, model_rate, i2s_rate, block, hop, first, window, backend, model_crc, clip_count = \
+        HEADER.unpack_from(data, 0)
+    if magic != b"GOLD" or version != 1:
+        raise ValueError(f"{path}: not a golden vector file")
+    golden = {
+        "model_rate": model_rate, "rate": i2s_rate, "block": block, "hop": hop, "first": first, "window": window,
+        "backend": backend.rstrip(b"\0").decode(), "model_crc": model_crc, "clips": [],
+    }
+    offset = HEADER.size
+    for _ in range(clip_count):
+        (name_length,) = struct.unpack_from("<H", data, offset)
+        name = data[offset + 2:offset + 2 + name_length].decode()
+        (record_count,) = struct.unpack_from("<I", data, offset + 2 + name_length)
+        offset += 6 + name_length
+        clip = {"name": name, "source": None, "hops": [], "records": {}}
+        for _ in range(record_count):
+            stage, dtype, index, sequence, count = RECORD.unpack_from(data, offset)
+            offset += RECORD.size
+            values = np.frombuffer(data, dtype=DTYPES[dtype], count=count, offset=offset)
+            offset += values.nbytes
+            clip["records"][STAGES[stage]] = clip["records"].get(STAGES[stage], 0) + 1
+            if STAGES[stage] == "source":
+                clip["source"] = values.astype("<i2")
+            elif STAGES[stage] == "input":
+                clip["hops"].append({"position": int(values[0]), "crc": int(values[1])})
+            elif STAGES[stage] == "scores":
+                clip["hops"][sequence]["scores"] = values.astype(np.float32)
+            elif STAGES[stage] == "detection":
+                clip["hops"][sequence]["detected"] = int(values[0])
+        golden["clips"].append(clip)
+    return golden
+
+
+def main():
+    parser = argparse.ArgumentParser(description="골든 벡터 파일 요약")
+    parser.add_argument("path")
+    args = parser.parse_args()
+
+    golden = read_golden(args.path)
+    print(f"{args.path}: {golden['model_rate']} Hz model, hop {golden['hop']}, first {golden['first']}, "
+          f"window {golden['window']}, recorded with {golden['backend']} (model {golden['model_crc']:08x})")
+    for clip in golden["clips"]:
+        stages = ", ".join(f"{stage} {count}" for stage, count in clip["records"].items())
+        print(f"  {clip['name']}: {len(clip['source']) / golden['rate']:.2f} s, {stages}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
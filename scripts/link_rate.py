@@ -0,0 +1,166 @@
+import argparse
+import os
+import subprocess
+import sys
+import time
+import zlib
+
+# ESP32(src/wake_word.cpp)와 UART 속도를 협상합니다. 부팅 속도(460800)에서 시작해서 RATES를 차례로 시도하고,
+# 속도마다 장치가 보낸 시험 데이터의 CRC32를 확인해서 맞으면 그 속도를 유지, 틀리면 이전 속도로 돌아가 멈춥니다.
+# 프로토콜은 src/link_rate.h 참고. 협상한 속도는 장치를 리셋하면 부팅 속도로 돌아갑니다.
+#
+# 사용 예시:
+#   python scripts/link_rate.py --port /dev/ttyUSB0                 # 협상하고 속도별 처리량 출력
+#   python scripts/link_rate.py --port /dev/ttyUSB0 --rates 921600  # 한 단계만
+#   python scripts/link_rate.py --emulate                           # 하드웨어 없이 pty로 확인 (실패 시 1 반환)
+# 다른 도구(command_receiver.py --negotiate)도 negotiate()를 씁니다.
+# 협상한 뒤 다른 스크립트나 모니터로 포트를 열 때는 --baud에 협상한 속도를 넘겨주세요.
+#
+# 호스트 도구 빌드: cmake -S host -B host/build && cmake --build host/build
+
+HOST_BUILD = os.path.join(os.path.dirname(__file__), "..", "host", "build")
+BOOT_BAUD = 460800                   # wake_word.cpp UART_BAUD_RATE
+RATES = (921600, 1500000, 2000000)   # CP210x + ESP32 UART가 정확히 맞출 수 있는 속도
+TEST_BYTES = 32 * 1024
+DEVICE_TIMEOUT = 1.0                 # 장치가 새 속도에서 기다리는 시간 (link_rate.h LINK_RATE_TIMEOUT_MS)
+SETTLE = 0.05                        # 장치가 속도를 바꾸고 수신 버퍼를 비울 때까지
+
+
+def wait_for(ser, expected, timeout):
+    # expected 중 하나가 들어있는 줄을 기다림 (콘솔 로그, 속도를 바꿀 때 들어온 잡음은 건너뜀). 반환: 그 부분부터의 문자열
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        line = ser.readline().decode("latin-1")
+        for word in expected:
+            index = line.find(word)
+            if index >= 0:
+                return line[index:].strip()
+    return None
+
+
+def read_exact(ser, size, timeout):
+    data = bytearray()
+    deadline = time.time() + timeout
+    while len(data) < size and time.time() < deadline:
+        data += ser.read(size - len(data))
+    return bytes(data)
+
+
+def try_rate(ser, baud, test_bytes):
+    # 한 단계 시도. 반환: (성공 여부, 처리량 bytes/s, 실패 이유)
+    previous = ser.baudrate
+    ser.reset_input_buffer()
+    ser.write(f"LINK_RATE {baud} {test_bytes}\n".encode())
+    reply = wait_for(ser, ("LINK_RATE_OK", "LINK_RATE_ERROR"), 2.0)
+    if reply is None:
+        return False, 0.0, "no reply"
+    if reply.startswith("LINK_RATE_ERROR"):
+        return False, 0.0, reply
+
+    ser.baudrate = baud
+    time.sleep(SETTLE)
+    ser.reset_input_buffer()
+    ser.write(b"LINK_PING\n")
+    reason = None
+    header = wait_for(ser, ("LINK_TEST",), DEVICE_TIMEOUT)
+    if header is None:
+        reason = "no test data"
+    else:
+        start = time.time()
+        _, size, crc = header.split()
+        transfer = int(size) * 10 / baud
+        data = read_exact(ser, int(size), DEVICE_TIMEOUT + transfer * 2)
+        elapsed = time.time() - start
+        if len(data) != int(size):
+            reason = f"received {len(data)} of {size} bytes"
+        elif zlib.crc32(data) != int(crc, 16):
+            reason = "CRC mismatch"
+        else:
+            ser.write(f"LINK_KEEP {zlib.crc32(data):08x}\n".encode())
+            if wait_for(ser, ("LINK_KEPT",), DEVICE_TIMEOUT) is not None:
+                return True, len(data) / max(elapsed, 1e-6), None
+            reason = "not confirmed"
+
+    # 장치가 시간 초과(시험 데이터를 보낸 뒤면 전송 시간만큼 더)로 이전 속도로 돌아갈 때까지 기다린 뒤 같이 돌아감
+    time.sleep(DEVICE_TIMEOUT + test_bytes * 10 / baud + SETTLE)
+    ser.baudrate = previous
+    ser.reset_input_buffer()
+    return False, 0.0, reason
+
+
+def negotiate(ser, rates=RATES, test_bytes=TEST_BYTES, log=print):
+    # 빠른 속도로 한 단계씩 올려보고 처음 실패한 곳에서 멈춤. 반환: 최종 속도
+    for baud in rates:
+        if baud <= ser.baudrate:
+            continue
+        ok, goodput, reason = try_rate(ser, baud, test_bytes)
+        if not ok:
+            log(f"{baud:>8} baud: FAILED ({reason}), staying at {ser.baudrate}")
+            break
+        line_rate = baud / 10  # 8N1: 바이트당 10비트
+        log(f"{baud:>8} baud: OK, goodput {goodput / 1024:.1f} KB/s ({100 * goodput / line_rate:.0f}% of line rate)")
+    return ser.baudrate
+
+
+def open_port(port, baud):
+    import serial
+
+    ser = serial.Serial(port=port, baudrate=baud, timeout=0.2)
+    try:
+        ser.dtr = False  # USB 포트를 열 때 ESP32가 리셋되지 않도록
+        ser.rts = False
+    except OSError:
+        pass  # pty에는 모뎀 제어선이 없음
+    return ser
+
+
+def start_emulator(max_baud):
+    # sim_wake_word --pty를 장치 대신 띄우고 pty 경로를 받음 (max_baud보다 빠르면 시험 데이터가 깨짐)
+    process = subprocess.Popen([os.path.join(HOST_BUILD, "sim_wake_word"), "--pty", "--max-baud", str(max_baud)],
+                               stdout=subprocess.PIPE, text=True)
+    line = process.stdout.readline().split()
+    if len(line) != 2 or line[0] != "PTY":
+        process.kill()
+        raise RuntimeError("sim_wake_word --pty did not start")
+    return process, line[1]
+
+
+def emulate(args):
+    # 1.5M까지만 버티는 링크: 921600, 1500000은 유지하고 2000000에서 실패한 뒤 1500000으로 돌아와야 함
+    # (pty에는 실제 전송 속도가 없으므로 처리량은 의미 없음)
+    process, port = start_emulator(1500000)
+    try:
+        ser = open_port(port, BOOT_BAUD)
+        final = negotiate(ser, RATES, args.bytes)
+        # 되돌린 뒤에도 장치가 명령을 받는지 (같은 속도로 한 번 더 시험)
+        again = try_rate(ser, final, 1024)[0]
+        ser.close()
+    finally:
+        process.kill()
+    ok = final == 1500000 and again
+    print("OK" if ok else f"FAILED (final {final} baud)")
+    return 0 if ok else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="UART 속도 협상과 속도별 처리량 시험")
+    parser.add_argument("--port", default="/dev/ttyUSB0")
+    parser.add_argument("--baud", type=int, default=BOOT_BAUD, help="지금 장치 속도")
+    parser.add_argument("--rates", type=int, nargs="+", default=list(RATES), help="차례로 시도할 속도")
+    parser.add_argument("--bytes", type=int, default=TEST_BYTES, help="속도마다 받을 시험 데이터 크기")
+    parser.add_argument("--emulate", action="store_true", help="장치 대신 host/build/sim_wake_word --pty로 협상/되돌림 확인")
+    args = parser.parse_args()
+
+    if args.emulate:
+        return emulate(args)
+    ser = open_port(args.port, args.baud)
+    try:
+        final = negotiate(ser, sorted(args.rates), args.bytes)
+    finally:
+        ser.close()
+    print(f"Link at {final} baud.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
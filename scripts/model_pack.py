@@ -0,0 +1,215 @@
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+from model_utils import (SUPPORTED_OPERATORS, TFLITE_SCHEMA_VERSION, inspect_tflite,
+                         operator_name, parse_model_header)
+
+# 모델 파티션(partitions.csv의 "model")에 들어갈 모델 패키지를 만들고, 확인하고, UART로 보냅니다.
+# 패키지 형식은 src/model_store.h와 같아야 합니다.
+#
+# 사용 예시:
+#   python scripts/model_pack.py pack new_model.tflite -o model.bin            # 라벨 테이블은 src/wake_word_model.h에서 가져옴
+#   python scripts/model_pack.py pack new_model.tflite -o model.bin \
+#       --class 리지야:0.8:3:10 --class 온도:0.85:3:10 --background _silence_ --background _unknown_
+#   python scripts/model_pack.py info model.bin
+#   python scripts/model_pack.py send model.bin --port /dev/ttyUSB0          # 재부팅 없이 모델 교체
+#
+# 처음 한 번은 파티션에 직접 써도 됩니다:
+#   parttool.py --port /dev/ttyUSB0 write_partition --partition-name=model --input model.bin
+
+MODEL_HEADER = os.path.join(os.path.dirname(__file__), "..", "src", "wake_word_model.h")
+
+PACKAGE_MAGIC = 0x444D464F  # "OFMD"
+PACKAGE_VERSION = 1
+SLOT_SIZE = 0x20000
+DATA_OFFSET = 0x200
+MAX_CLASSES = 8             # KEYWORD_MAX_CLASSES
+MAX_SMOOTHING = 8           # KEYWORD_MAX_SMOOTHING
+LABEL_SIZE = 32
+
+HEADER_FORMAT = "<IHHIIIB3x"
+CLASS_FORMAT = f"<{LABEL_SIZE}sfBBBx"
+CHUNK_SIZE = 1024           # MODEL_CHUNK_SIZE (src/wake_word.cpp)
+
+
+def parse_class(text, background=False):
+    # "라벨:임계값:평활화:refractory" 형식
+    parts = text.split(":")
+    return {
+        "label": parts[0],
+        "threshold": float(parts[1]) if len(parts) > 1 else 1.0,
+        "smoothing": int(parts[2]) if len(parts) > 2 else 1,
+        "refractory": int(parts[3]) if len(parts) > 3 else 0,
+        "background": background,
+    }
+
+
+def check_model(model):
+    version, operators = inspect_tflite(model)
+    if version != TFLITE_SCHEMA_VERSION:
+        raise ValueError(f"스키마 버전 {version} (펌웨어는 {TFLITE_SCHEMA_VERSION})")
+    unsupported = sorted({op for op in operators if op not in SUPPORTED_OPERATORS})
+    if unsupported:
+        names = ", ".join(operator_name(op) for op in unsupported)
+        raise ValueError(f"펌웨어에 등록되지 않은 연산자: {names} (src/wake_word.cpp의 register_ops()에 추가해주세요)")
+    if len(model) > SLOT_SIZE - DATA_OFFSET:
+        raise ValueError(f"모델이 너무 큽니다: {len(model)} bytes (최대 {SLOT_SIZE - DATA_OFFSET})")
+    return operators
+
+
+def build_package(model, classes, sequence):
+    if not 0 < len(classes) <= MAX_CLASSES:
+        raise ValueError(f"클래스는 1~{MAX_CLASSES}개여야 합니다.")
+
+    header = struct.pack(HEADER_FORMAT, PACKAGE_MAGIC, PACKAGE_VERSION, DATA_OFFSET,
+                         len(model), zlib.crc32(model), sequence, len(classes))
+    for i in range(MAX_CLASSES):
+        if i < len(classes):
+            cls = classes[i]
+            label = cls["label"].encode("utf-8")
+            if len(label) >= LABEL_SIZE:
+                raise ValueError(f"라벨이 너무 깁니다: {cls['label']}")
+            if not 0 < cls["smoothing"] <= MAX_SMOOTHING:
+                raise ValueError(f"평활화 횟수는 1~{MAX_SMOOTHING}이어야 합니다: {cls['label']}")
+            header += struct.pack(CLASS_FORMAT, label, cls["threshold"], cls["smoothing"],
+                                  cls["refractory"], 1 if cls["background"] else 0)
+        else:
+            header += bytes(struct.calcsize(CLASS_FORMAT))
+    header += struct.pack("<I", zlib.crc32(header))
+    return header.ljust(DATA_OFFSET, b"\x00") + model
+
+
+def read_package(package):
+    fields = struct.unpack_from(HEADER_FORMAT, package, 0)
+    magic, version, data_offset, model_size, model_crc, sequence, num_classes = fields
+    if magic != PACKAGE_MAGIC or version != PACKAGE_VERSION:
+        raise ValueError("모델 패키지가 아닙니다.")
+    header_size = struct.calcsize(HEADER_FORMAT) + MAX_CLASSES * struct.calcsize(CLASS_FORMAT)
+    header_crc = struct.unpack_from("<I", package, header_size)[0]
+    if zlib.crc32(package[:header_size]) != header_crc:
+        raise ValueError("헤더 CRC가 맞지 않습니다.")
+    model = package[data_offset:data_offset + model_size]
+    if len(model) != model_size or zlib.crc32(model) != model_crc:
+        raise ValueError("모델 CRC가 맞지 않습니다.")
+
+    classes = []
+    for i in range(num_classes):
+        label, threshold, smoothing, refractory, background = struct.unpack_from(
+            CLASS_FORMAT, package, struct.calcsize(HEADER_FORMAT) + i * struct.calcsize(CLASS_FORMAT))
+        classes.append({
+            "label": label.split(b"\x00")[0].decode("utf-8"),
+            "threshold": threshold,
+            "smoothing": smoothing,
+            "refractory": refractory,
+            "background": bool(background),
+        })
+    return model, classes, sequence
+
+
+def wait_for(ser, expected, timeout):
+    # 콘솔 로그도 같은 UART로 나오므로, 기다리는 응답이 나올 때까지 다른 줄은 건너뜀
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        line = ser.readline().decode("utf-8", errors="replace").strip()
+        if line.startswith(expected):
+            return line
+        if line.startswith("MODEL_ERROR"):
+            raise RuntimeError(line)
+    raise TimeoutError(f"{expected} not received")
+
+
+def cmd_pack(args):
+    with open(args.tflite, "rb") as f:
+        model = f.read()
+    if args.class_ or args.background:
+        classes = [parse_class(c) for c in args.class_] + [parse_class(c, True) for c in args.background]
+    else:
+        _, classes = parse_model_header(args.header)
+    operators = check_model(model)
+    package = build_package(model, classes, args.sequence)
+    with open(args.output, "wb") as f:
+        f.write(package)
+    print(f"Packed {args.output}: {len(package)} bytes, model CRC32 {zlib.crc32(model):08X}")
+    print(f"Operators: {', '.join(operator_name(op) for op in operators)}")
+    print(f"Classes: {', '.join(c['label'] for c in classes)}")
+
+
+def cmd_info(args):
+    with open(args.package, "rb") as f:
+        package = f.read()
+    model, classes, sequence = read_package(package)
+    operators = check_model(model)
+    print(f"Sequence {sequence}, model {len(model)} bytes, CRC32 {zlib.crc32(model):08X}")
+    print(f"Operators: {', '.join(operator_name(op) for op in operators)}")
+    for cls in classes:
+        kind = "background" if cls["background"] else f"threshold {cls['threshold']:.2f}"
+        print(f"  {cls['label']}: {kind}, smoothing {cls['smoothing']}, refractory {cls['refractory']}")
+
+
+def cmd_send(args):
+    import serial
+
+    with open(args.package, "rb") as f:
+        package = f.read()
+    read_package(package)  # 보내기 전에 검증
+
+    ser = serial.Serial(port=args.port, baudrate=args.baud, timeout=1)
+    ser.dtr = False  # USB 포트를 열 때 ESP32가 리셋되지 않도록
+    ser.rts = False
+    try:
+        ser.reset_input_buffer()
+        ser.write(f"MODEL_UPDATE {len(package)}\n".encode())
+        wait_for(ser, "MODEL_READY", 10)  # 슬롯 지우는 시간 포함
+
+        start = time.time()
+        for offset in range(0, len(package), CHUNK_SIZE):
+            ser.write(package[offset:offset + CHUNK_SIZE])
+            wait_for(ser, "MODEL_ACK", 5)
+            print(f"\rSent {min(offset + CHUNK_SIZE, len(package))}/{len(package)} bytes", end="")
+        print()
+
+        reply = wait_for(ser, "MODEL_OK", 10)
+        print(f"{reply} ({time.time() - start:.1f} s)")
+    finally:
+        ser.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="모델 파티션용 모델 패키지 도구")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    pack = sub.add_parser("pack", help=".tflite + 라벨 테이블 → 모델 패키지")
+    pack.add_argument("tflite")
+    pack.add_argument("-o", "--output", default="model.bin")
+    pack.add_argument("--class", dest="class_", action="append", default=[],
+                      help="라벨:임계값:평활화:refractory (모델 출력 순서대로)")
+    pack.add_argument("--background", action="append", default=[], help="배경 클래스 라벨 (--class 뒤에 이어짐)")
+    pack.add_argument("--header", default=MODEL_HEADER, help="--class가 없을 때 라벨 테이블을 읽을 헤더 파일")
+    pack.add_argument("--sequence", type=int, default=1, help="parttool로 직접 쓸 때의 sequence (UART로 보내면 펌웨어가 새로 붙임)")
+    pack.set_defaults(func=cmd_pack)
+
+    info = sub.add_parser("info", help="모델 패키지 내용과 CRC 확인")
+    info.add_argument("package")
+    info.set_defaults(func=cmd_info)
+
+    send = sub.add_parser("send", help="UART로 모델 교체 (재부팅 없음)")
+    send.add_argument("package")
+    send.add_argument("--port", default="/dev/ttyUSB0")
+    send.add_argument("--baud", type=int, default=460800)
+    send.set_defaults(func=cmd_send)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except (ValueError, RuntimeError, TimeoutError) as e:
+        print(f"Error: {e}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
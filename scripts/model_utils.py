@@ -0,0 +1,108 @@
+import re
+import struct
+
+# 여러 스크립트에서 같이 쓰는 모델 관련 함수
+# - src/wake_word_model.h에서 모델 바이트 배열과 라벨 테이블 읽기
+# - .tflite flatbuffer에서 스키마 버전, 연산자 목록 읽기 (tensorflow 설치 없이)
+
+# BuiltinOperator 코드 (tensorflow/lite/schema/schema.fbs)
+BUILTIN_OPERATORS = {
+    3: "CONV_2D",
+    4: "DEPTHWISE_CONV_2D",
+    9: "FULLY_CONNECTED",
+    17: "MAX_POOL_2D",
+    22: "RESHAPE",
+    25: "SOFTMAX",
+    40: "MEAN",
+    45: "STRIDED_SLICE",
+    77: "SHAPE",
+    83: "PACK",
+}
+
+# src/wake_word.cpp의 register_ops()에 등록된 연산자 (펌웨어를 수정하면 같이 수정해주세요)
+SUPPORTED_OPERATORS = {3, 9, 17, 22, 25, 40, 45, 77, 83}
+
+TFLITE_SCHEMA_VERSION = 3
+
+
+def load_interpreter_class():
+    # ai-edge-litert(tflite-runtime 후속) → tflite-runtime → tensorflow 순서로 찾음
+    try:
+        from ai_edge_litert.interpreter import Interpreter
+    except ImportError:
+        try:
+            from tflite_runtime.interpreter import Interpreter
+        except ImportError:
+            from tensorflow.lite import Interpreter
+    return Interpreter
+
+
+def parse_model_header(path):
+    # 헤더 파일에서 모델 바이트 배열과 라벨 테이블을 읽어옴
+    with open(path, encoding="utf-8") as f:
+        source = f.read()
+    array = re.search(r"model_tflite\[\]\s*=\s*\{(.*?)\};", source, re.S).group(1)
+    model = bytes(int(x, 16) for x in re.findall(r"0x([0-9A-Fa-f]{2})", array))
+
+    table = re.search(r"model_classes\[\]\s*=\s*\{(.*?)\};", source, re.S).group(1)
+    classes = []
+    for label, threshold, smoothing, refractory, background in re.findall(
+            r'\{\s*"([^"]*)"\s*,\s*([0-9.]+)f?\s*,\s*(\d+)\s*,\s*(\d+)\s*,\s*(true|false)\s*\}', table):
+        classes.append({
+            "label": label,
+            "threshold": float(threshold),
+            "smoothing": int(smoothing),
+            "refractory": int(refractory),
+            "background": background == "true",
+        })
+    return model, classes
+
+
+class _Table:
+    # flatbuffer 테이블에서 필드 위치만 찾는 최소한의 리더
+    def __init__(self, buf, pos):
+        self.buf = buf
+        self.pos = pos
+        self.vtable = pos - struct.unpack_from("<i", buf, pos)[0]
+        self.vtable_size = struct.unpack_from("<H", buf, self.vtable)[0]
+
+    def field(self, index):
+        entry = 4 + 2 * index
+        if entry >= self.vtable_size:
+            return None
+        offset = struct.unpack_from("<H", self.buf, self.vtable + entry)[0]
+        return self.pos + offset if offset else None
+
+    def vector(self, index):
+        pos = self.field(index)
+        if pos is None:
+            return []
+        start = pos + struct.unpack_from("<I", self.buf, pos)[0]
+        count = struct.unpack_from("<I", self.buf, start)[0]
+        return [start + 4 + 4 * i for i in range(count)]
+
+    def table(self, pos):
+        return _Table(self.buf, pos + struct.unpack_from("<I", self.buf, pos)[0])
+
+
+def inspect_tflite(model):
+    # 스키마 버전과 사용하는 연산자 코드 목록을 반환
+    if len(model) < 8 or model[4:8] != b"TFL3":
+        raise ValueError("TFLite flatbuffer가 아닙니다. (TFL3 식별자 없음)")
+    root = _Table(model, struct.unpack_from("<I", model, 0)[0])
+    version_pos = root.field(0)
+    version = struct.unpack_from("<I", model, version_pos)[0] if version_pos else 0
+
+    operators = []
+    for pos in root.vector(1):
+        opcode = root.table(pos)
+        deprecated = opcode.field(0)
+        builtin = opcode.field(3)
+        code = max(struct.unpack_from("<b", model, deprecated)[0] if deprecated else 0,
+                   struct.unpack_from("<i", model, builtin)[0] if builtin else 0)
+        operators.append(code)
+    return version, operators
+
+
+def operator_name(code):
+    return BUILTIN_OPERATORS.get(code, f"BUILTIN_{code}")
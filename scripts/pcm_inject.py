@@ -0,0 +1,339 @@
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import wave
+
+import numpy as np
+
+from model_utils import load_interpreter_class, parse_model_header
+
+# WAV 파일을 UART로 ESP32(src/wake_word.cpp PCM 주입 모드)에 보내서 마이크 대신 전체 파이프라인을 돌리고,
+# hop마다 받은 결과를 호스트 시뮬레이터(host/build/sim_wake_word)와 비교합니다.
+# - 모델 입력 창 CRC32: 전처리/잡음 제거/추론 시점이 펌웨어와 비트 단위로 같은지
+# - 클래스별 확률, 검출 결과: --model(.tflite)로 PC에서 같은 창을 실행해서 비교 (TFLite 인터프리터가 있을 때)
+# - 장치의 처리 속도: 실시간 대비 배속, 블록당 DSP 시간, hop당 Invoke() 시간
+# --golden이면 WAV 대신 골든 벡터 파일(host/golden_vectors.cpp)의 입력 샘플을 주입해서 기록된 결과와 비교합니다.
+# (위치와 입력 창 CRC는 정확히 같아야 하고, TFLM으로 기록한 파일이면 확률(--tolerance)과 검출 결과도 비교)
+# 장치는 ACK를 보내는 대로 다음 블록을 받으므로 실시간이 아니라 UART 속도만큼 빠르게 돌아갑니다.
+#
+# 사용 예시:
+#   python scripts/pcm_inject.py dataset/리지야 --port /dev/ttyUSB0
+#   python scripts/pcm_inject.py data/test.wav --port /dev/ttyUSB0 --model model.tflite
+#   python scripts/pcm_inject.py data/test.wav --emulate      # 하드웨어 없이 pty로 (sim_wake_word --pty가 장치 역할)
+#   python scripts/pcm_inject.py --golden data/golden_vectors.bin --port /dev/ttyUSB0
+#
+# 호스트 도구 빌드: cmake -S host -B host/build && cmake --build host/build
+
+HOST_BUILD = os.path.join(os.path.dirname(__file__), "..", "host", "build")
+MODEL_HEADER = os.path.join(os.path.dirname(__file__), "..", "src", "wake_word_model.h")
+I2S_SAMPLE_RATE = 16000  # INJECT_READY의 rate로 다시 확인
+WINDOW_BLOCKS = 3        # ACK 없이 보낼 수 있는 블록 수 (wake_word.cpp INJECT_WINDOW_BLOCKS)
+
+
+def read_wav(path, sample_rate):
+    # 16비트(또는 8비트) WAV → int16 모노 (여러 채널이면 왼쪽 채널, 레이트가 다르면 선형 보간)
+    with wave.open(path, "rb") as wav:
+        width, channels, rate = wav.getsampwidth(), wav.getnchannels(), wav.getframerate()
+        data = wav.readframes(wav.getnframes())
+    if width == 2:
+        samples = np.frombuffer(data, dtype="<i2").astype(np.float64)
+    elif width == 1:
+        samples = (np.frombuffer(data, dtype=np.uint8).astype(np.float64) - 128) * 256
+    else:
+        raise ValueError(f"{path}: 8/16비트 WAV만 지원합니다.")
+    samples = samples[::channels]
+    if rate != sample_rate:
+        positions = np.arange(int(len(samples) * sample_rate / rate)) * rate / sample_rate
+        samples = np.interp(positions, np.arange(len(samples)), samples)
+    return np.clip(np.round(samples), -32768, 32767).astype("<i2")
+
+
+def collect_files(paths):
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            for dirpath, _, filenames in os.walk(path):
+                files += [os.path.join(dirpath, n) for n in sorted(filenames) if n.lower().endswith(".wav")]
+        else:
+            files.append(path)
+    return files
+
+
+def parse_fields(line):
+    # "INJECT_READY block=512 rate=16000 ..." → {"block": 512, ...}
+    return {k: int(v) for k, v in (item.split("=") for item in line.split()[1:])}
+
+
+def parse_hop(line):
+    # HOP <위치> <검출 클래스> <입력 창 CRC32> <Invoke us> <클래스별 확률...>
+    parts = line.split()
+    return {
+        "position": int(parts[1]),
+        "detected": int(parts[2]),
+        "crc": int(parts[3], 16),
+        "invoke_us": int(parts[4]),
+        "scores": [float(x) for x in parts[5:]],
+    }
+
+
+class Device:
+    # UART(또는 pty)로 연결된 장치. 콘솔 로그도 같은 포트로 나오므로 모르는 줄은 건너뜀
+    def __init__(self, port, baud):
+        import serial
+
+        self.ser = serial.Serial(port=port, baudrate=baud, timeout=5)
+        try:
+            self.ser.dtr = False  # USB 포트를 열 때 ESP32가 리셋되지 않도록
+            self.ser.rts = False
+        except OSError:
+            pass  # pty에는 모뎀 제어선이 없음
+
+    def close(self):
+        self.ser.close()
+
+    def read_line(self):
+        line = self.ser.readline()
+        if not line:
+            raise TimeoutError("no response from device")
+        return line.decode("utf-8", errors="replace").strip()
+
+    def wait_for(self, expected, hops=None):
+        while True:
+            line = self.read_line()
+            if line.startswith("INJECT_ERROR"):
+                raise RuntimeError(line)
+            if line.startswith("HOP ") and hops is not None:
+                hops.append(parse_hop(line))
+            elif line.startswith(expected):
+                return line
+
+    def inject(self, samples):
+        # 블록을 보내고 hop 결과를 모음. 반환: (READY 설정, hop 목록, END 통계, 걸린 시간)
+        self.ser.reset_input_buffer()
+        self.ser.write(b"INJECT_START\n")
+        ready = parse_fields(self.wait_for("INJECT_READY"))
+        block = ready["block"]
+        if len(samples) % block:
+            samples = np.concatenate([samples, np.zeros(block - len(samples) % block, dtype="<i2")])
+
+        hops = []
+        start = time.time()
+        in_flight = 0
+        for offset in range(0, len(samples), block):
+            if in_flight == WINDOW_BLOCKS:
+                self.wait_for("INJECT_ACK", hops)
+                in_flight -= 1
+            self.ser.write(np.uint16(block).astype("<u2").tobytes() + samples[offset:offset + block].tobytes())
+            in_flight += 1
+        for _ in range(in_flight):
+            self.wait_for("INJECT_ACK", hops)
+        self.ser.write(b"\x00\x00")
+        end = parse_fields(self.wait_for("INJECT_END", hops))
+        return ready, hops, end, time.time() - start, samples
+
+
+def simulate(samples, ready, windows_path):
+    # 호스트 시뮬레이터로 같은 오디오 처리 (8kHz 빌드면 sim_wake_word_8k)
+    name = "sim_wake_word_8k" if ready["model_rate"] == 8000 else "sim_wake_word"
+    command = [os.path.join(HOST_BUILD, name), "-", "--hop", str(ready["hop"]), "--first", str(ready["first"]),
+               "--window", str(ready["window"])]
+    if windows_path:
+        command += ["--windows", windows_path]
+    result = subprocess.run(command, input=samples.tobytes(), capture_output=True, check=True)
+    return [parse_hop(line) for line in result.stdout.decode().splitlines() if line.startswith("HOP ")]
+
+
+class ModelRunner:
+    # PC에서 같은 모델 입력 창으로 모델 실행 (wake_word.cpp fill_input과 같은 정규화/양자화)
+    def __init__(self, model):
+        self.interpreter = load_interpreter_class()(model_content=model, num_threads=1)
+        self.interpreter.allocate_tensors()
+        self.input = self.interpreter.get_input_details()[0]
+        self.output = self.interpreter.get_output_details()[0]
+
+    def scores(self, window):
+        x = window.astype(np.float32) / 32768.0
+        if self.input["dtype"] == np.int8:
+            scale, zero_point = self.input["quantization"]
+            x = np.clip(np.round(x / scale) + zero_point, -128, 127).astype(np.int8)
+        self.interpreter.set_tensor(self.input["index"], x.reshape(self.input["shape"]))
+        self.interpreter.invoke()
+        y = self.interpreter.get_tensor(self.output["index"]).reshape(-1)
+        if self.output["dtype"] == np.int8:
+            scale, zero_point = self.output["quantization"]
+            y = (y.astype(np.float32) - zero_point) * scale
+        return y
+
+
+def compare(name, device_hops, sim_hops, windows, window, runner, classes, tolerance):
+    # 반환: 불일치 개수, 출력할 요약 문자열
+    problems = 0
+    if len(device_hops) != len(sim_hops):
+        problems += 1
+        print(f"  {name}: {len(device_hops)} hops from device, {len(sim_hops)} from simulator")
+    crc_mismatch = 0
+    for d, s in zip(device_hops, sim_hops):
+        if d["position"] != s["position"] or d["crc"] != s["crc"]:
+            if crc_mismatch == 0:
+                print(f"  {name}: first mismatch at position {d['position']} (simulator {s['position']})")
+            crc_mismatch += 1
+    problems += crc_mismatch
+    summary = f"CRC {len(sim_hops) - crc_mismatch}/{len(sim_hops)}"
+
+    if runner is None or not device_hops or not device_hops[0]["scores"]:
+        return problems, summary
+
+    # 확률과 검출 결과 (검출은 scripts/confusion_matrix.py의 KeywordDetector로 같은 규칙)
+    from confusion_matrix import KeywordDetector
+
+    detector = KeywordDetector(classes) if classes else None
+    max_diff, detection_mismatch = 0.0, 0
+    for i, d in enumerate(device_hops[:len(sim_hops)]):
+        scores = runner.scores(windows[i * window:(i + 1) * window])
+        max_diff = max(max_diff, float(np.max(np.abs(scores - np.array(d["scores"])))))
+        if detector is not None and detector.update(scores) != d["detected"]:
+            detection_mismatch += 1
+    if max_diff > tolerance:
+        problems += 1
+    problems += detection_mismatch
+    summary += f", max |score diff| {max_diff:.4f}"
+    if detector is not None:
+        summary += f", detection mismatches {detection_mismatch}"
+    return problems, summary
+
+
+def compare_golden(name, device_hops, golden, clip, tolerance):
+    # 골든 벡터와 비교. 반환: 불일치 개수, 출력할 요약 문자열
+    expected = clip["hops"]
+    problems = 0
+    if len(device_hops) != len(expected):
+        problems += 1
+        print(f"  {name}: {len(device_hops)} hops from device, {len(expected)} recorded")
+    crc_mismatch, max_diff, detection_mismatch = 0, 0.0, 0
+    compare_model = golden["backend"] == "TFLM"
+    for d, g in zip(device_hops, expected):
+        if d["position"] != g["position"] or d["crc"] != g["crc"]:
+            if crc_mismatch == 0:
+                print(f"  {name}: first mismatch at position {d['position']} (recorded {g['position']})")
+            crc_mismatch += 1
+        if compare_model and d["scores"]:
+            max_diff = max(max_diff, float(np.max(np.abs(np.array(d["scores"]) - g["scores"]))))
+            detection_mismatch += d["detected"] != g["detected"]
+    problems += crc_mismatch + detection_mismatch + (max_diff > tolerance)
+    summary = f"CRC {len(expected) - crc_mismatch}/{len(expected)}"
+    if compare_model and device_hops and device_hops[0]["scores"]:
+        summary += f", max |score diff| {max_diff:.4f}, detection mismatches {detection_mismatch}"
+    return problems, summary
+
+
+def start_emulator():
+    # sim_wake_word --pty를 장치 대신 띄우고 pty 경로를 받음
+    process = subprocess.Popen([os.path.join(HOST_BUILD, "sim_wake_word"), "--pty"], stdout=subprocess.PIPE, text=True)
+    line = process.stdout.readline().split()
+    if len(line) != 2 or line[0] != "PTY":
+        process.kill()
+        raise RuntimeError("sim_wake_word --pty did not start")
+    return process, line[1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="WAV 파일을 UART로 장치 파이프라인에 주입하고 호스트 시뮬레이터와 비교")
+    parser.add_argument("inputs", nargs="*", help="WAV 파일 또는 폴더")
+    parser.add_argument("--golden", help="WAV 대신 주입하고 비교할 골든 벡터 파일 (host/build/golden_vectors --write)")
+    parser.add_argument("--port", default="/dev/ttyUSB0")
+    parser.add_argument("--baud", type=int, default=460800)
+    parser.add_argument("--emulate", action="store_true", help="장치 대신 host/build/sim_wake_word --pty 사용")
+    parser.add_argument("--model", help="PC에서 실행해서 확률을 비교할 .tflite (장치에 올린 모델과 같아야 함)")
+    parser.add_argument("--header", default=MODEL_HEADER, help="검출 결과 비교용 라벨 테이블 헤더 파일")
+    parser.add_argument("--tolerance", type=float, default=0.02, help="허용하는 확률 차이 (TFLM과 TFLite 커널 차이)")
+    args = parser.parse_args()
+
+    golden = None
+    if args.golden:
+        from golden_vectors import read_golden
+
+        golden = read_golden(args.golden)
+        files = [clip["name"] for clip in golden["clips"]]
+    else:
+        files = collect_files(args.inputs)
+    if not files:
+        print("No WAV files found")
+        return 1
+
+    runner, classes = None, None
+    if args.model:
+        with open(args.model, "rb") as f:
+            model = f.read()
+        try:
+            runner = ModelRunner(model)
+            _, classes = parse_model_header(args.header)
+        except ImportError:
+            print("TFLite interpreter not installed; comparing CRC only")
+
+    emulator = None
+    port = args.port
+    if args.emulate:
+        emulator, port = start_emulator()
+        print(f"Emulating device on {port}")
+
+    device = Device(port, args.baud)
+    problems = 0
+    totals = {"audio": 0.0, "time": 0.0, "blocks": 0, "hops": 0, "dsp_us": 0, "invoke_us": 0}
+    try:
+        with tempfile.TemporaryDirectory() as tmp:
+            for i, path in enumerate(files):
+                name = os.path.basename(path)
+                samples = golden["clips"][i]["source"] if golden else read_wav(path, I2S_SAMPLE_RATE)
+                ready, device_hops, end, elapsed, sent = device.inject(samples)
+                if ready["rate"] != I2S_SAMPLE_RATE:
+                    raise RuntimeError(f"device I2S rate {ready['rate']} Hz is not supported")
+                if ready["window"] == 0:
+                    raise RuntimeError("device has no model loaded (upload one with scripts/model_pack.py send)")
+
+                if golden:
+                    schedule = ("model_rate", "hop", "first", "window")
+                    if any(ready[key] != golden[key] for key in schedule):
+                        raise RuntimeError("device settings differ from the recording: " +
+                                           ", ".join(f"{key} {ready[key]}/{golden[key]}" for key in schedule))
+                    file_problems, summary = compare_golden(name, device_hops, golden, golden["clips"][i],
+                                                            args.tolerance)
+                else:
+                    windows_path = os.path.join(tmp, "windows.raw") if runner else None
+                    sim_hops = simulate(sent, ready, windows_path)
+                    windows = np.fromfile(windows_path, dtype="<i2") if windows_path else None
+                    file_problems, summary = compare(name, device_hops, sim_hops, windows, ready["window"], runner,
+                                                     classes, args.tolerance)
+                problems += file_problems
+
+                audio = len(sent) / ready["rate"]
+                print(f"{name}: {len(device_hops)} hops, {summary}, {audio:.1f} s audio in {elapsed:.2f} s "
+                      f"({audio / max(elapsed, 1e-6):.1f}x real time)")
+                totals["audio"] += audio
+                totals["time"] += elapsed
+                for key in ("blocks", "hops", "dsp_us", "invoke_us"):
+                    totals[key] += end[key]
+    except FileNotFoundError as e:
+        print(f"Error: {e} (build the host tools first)")
+        return 1
+    except (RuntimeError, TimeoutError, ValueError) as e:
+        print(f"Error: {e}")
+        return 1
+    finally:
+        device.close()
+        if emulator:
+            emulator.kill()
+
+    print(f"Total: {len(files)} files, {totals['audio']:.1f} s audio in {totals['time']:.1f} s "
+          f"({totals['audio'] / max(totals['time'], 1e-6):.1f}x real time)")
+    if totals["blocks"]:
+        print(f"Device: {totals['dsp_us'] / totals['blocks'] / 1000:.2f} ms DSP per block, "
+              f"{totals['invoke_us'] / max(totals['hops'], 1) / 1000:.2f} ms Invoke() per hop")
+    print("FAILED" if problems else "OK")
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
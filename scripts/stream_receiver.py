@@ -0,0 +1,166 @@
+import argparse
+import socket
+import struct
+import sys
+import time
+import wave
+
+# Wi-Fi로 ESP32(src/wake_word.cpp, TRANSPORT_TCP/UDP 빌드)가 보내는 명령어 오디오와 검출 이벤트를 받습니다.
+# 장치가 이 PC(TRANSPORT_HOST:TRANSPORT_PORT)로 연결하므로 먼저 실행해두세요. (UART 빌드는 scripts/command_receiver.py)
+#
+# 패킷 형식 (src/audio_transport.h, little-endian): 헤더 24바이트 + payload
+#   magic "ATP1", version, type(1: 오디오 int16 샘플, 2: 이벤트 문자열), payload_size,
+#   sequence(패킷 번호), position(링 버퍼 샘플 위치), timestamp_us(장치 시계), dropped_samples(누적)
+# 이벤트: <CAPTURE_START>, <CAPTURE_END>, DETECTED <라벨> <점수>, SOUND_EVENT <모델> <라벨> <점수>
+# 캡처(<CAPTURE_START> ~ <CAPTURE_END>)마다 WAV로 저장합니다. 장치가 백프레셔로 버린 구간은 무음으로 채우고,
+# UDP에서 잃은 패킷(sequence가 건너뜀)도 position으로 자리를 맞춰서 무음으로 채웁니다.
+#
+# 사용 예시:
+#   python scripts/stream_receiver.py --tcp --port 5005
+#   python scripts/stream_receiver.py --udp --port 5005
+
+HEADER = struct.Struct("<IBBHIIII")  # audio_transport_header_t
+MAGIC = 0x31505441
+TYPE_AUDIO = 1
+TYPE_EVENT = 2
+
+SAMPLE_RATE = 16000  # ESP32 MODEL_SAMPLE_RATE 기본값 (8kHz로 빌드했으면 --rate 8000)
+SAMPLE_WIDTH = 2
+MAX_GAP_SAMPLES = SAMPLE_RATE * 10  # 이보다 크게 건너뛰면 무음으로 채우지 않음
+
+
+class Receiver:
+    def __init__(self, prefix, rate):
+        self.prefix = prefix
+        self.rate = rate
+        self.audio = None          # 캡처 중이면 bytearray
+        self.position = None       # 다음에 올 샘플 위치
+        self.sequence = None
+        self.dropped = 0
+        self.lost_packets = 0
+        self.count = 0
+        self.started_at = 0.0
+
+    def packet(self, header, payload):
+        magic, version, kind, size, sequence, position, timestamp_us, dropped = header
+        if magic != MAGIC or len(payload) != size:
+            print("bad packet (magic/size)")
+            return
+        if self.sequence is not None and sequence != self.sequence:
+            self.lost_packets += (sequence - self.sequence) & 0xFFFFFFFF
+        self.sequence = (sequence + 1) & 0xFFFFFFFF
+        if dropped != self.dropped:
+            print(f"device dropped {dropped - self.dropped} samples (backpressure)")
+            self.dropped = dropped
+
+        if kind == TYPE_EVENT:
+            self.event(payload.decode("utf-8", "replace"), position)
+        elif kind == TYPE_AUDIO and self.audio is not None:
+            self.fill_gap(position)
+            if len(self.audio) == 0:
+                print(f"First audio after {(time.time() - self.started_at) * 1000:.0f} ms")
+            self.audio += payload
+            self.position = (position + size // SAMPLE_WIDTH) & 0xFFFFFFFF
+
+    def fill_gap(self, position):
+        if self.position is None:
+            self.position = position
+        gap = (position - self.position) & 0xFFFFFFFF
+        if 0 < gap <= MAX_GAP_SAMPLES:
+            self.audio += b"\0" * (gap * SAMPLE_WIDTH)
+
+    def event(self, text, position):
+        if text == "<CAPTURE_START>":
+            self.audio = bytearray()
+            self.position = position
+            self.started_at = time.time()
+            print("Wake word detected, receiving command...")
+        elif text == "<CAPTURE_END>":
+            if self.audio is None:
+                return
+            self.fill_gap(position)
+            self.count += 1
+            path = f"{self.prefix}_{time.strftime('%Y%m%d_%H%M%S')}_{self.count}.wav"
+            with wave.open(path, "wb") as wav:
+                wav.setnchannels(1)
+                wav.setsampwidth(SAMPLE_WIDTH)
+                wav.setframerate(self.rate)
+                wav.writeframes(bytes(self.audio))
+            seconds = len(self.audio) / (self.rate * SAMPLE_WIDTH)
+            print(f"Saved {path}: {seconds:.2f} s of audio ({time.time() - self.started_at:.2f} s wall)")
+            self.audio = None
+        else:
+            print(f"[{position / self.rate:10.2f} s] {text}")
+
+
+def read_exact(conn, size):
+    data = b""
+    while len(data) < size:
+        chunk = conn.recv(size - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def serve_tcp(port, receiver):
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("", port))
+    server.listen(1)
+    print(f"Listening on TCP port {port}. Waiting for the device...")
+    while True:
+        conn, address = server.accept()
+        print(f"Device connected from {address[0]}")
+        receiver.sequence = None  # 연결마다 새로
+        with conn:
+            while True:
+                head = read_exact(conn, HEADER.size)
+                if head is None:
+                    break
+                header = HEADER.unpack(head)
+                payload = read_exact(conn, header[3])
+                if payload is None:
+                    break
+                receiver.packet(header, payload)
+        print("Device disconnected.")
+
+
+def serve_udp(port, receiver):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", port))
+    print(f"Listening on UDP port {port}...")
+    while True:
+        data, _ = sock.recvfrom(2048)
+        if len(data) < HEADER.size:
+            continue
+        receiver.packet(HEADER.unpack_from(data), data[HEADER.size:])
+        if receiver.lost_packets:
+            print(f"{receiver.lost_packets} packets lost so far")
+            receiver.lost_packets = 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Wi-Fi 명령어 오디오/검출 이벤트 수신")
+    mode = parser.add_mutually_exclusive_group()
+    mode.add_argument("--tcp", action="store_true", help="TRANSPORT_TCP 빌드 (기본)")
+    mode.add_argument("--udp", action="store_true", help="TRANSPORT_UDP 빌드")
+    parser.add_argument("--port", type=int, default=5005, help="펌웨어 TRANSPORT_PORT")
+    parser.add_argument("--prefix", default="command", help="저장할 WAV 파일 이름 앞부분")
+    parser.add_argument("--rate", type=int, default=SAMPLE_RATE, choices=(8000, 16000),
+                        help="오디오 샘플링 레이트 (펌웨어 MODEL_SAMPLE_RATE)")
+    args = parser.parse_args()
+
+    receiver = Receiver(args.prefix, args.rate)
+    try:
+        if args.udp:
+            serve_udp(args.port, receiver)
+        else:
+            serve_tcp(args.port, receiver)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -9,7 +9,7 @@ raw_file = "received_audio.raw"  # 수신된 데이터를 저장할 RAW 파일
 wav_file = "received_audio.wav"  # 변환된 WAV 파일
 
 # WAV 설정
-sample_rate = 16000  # 샘플링 속도 (ESP32 설정과 동일)
+sample_rate = 16000  # 샘플링 속도 (ESP32 설정과 동일, MODEL_SAMPLE_RATE=8000으로 빌드했으면 8000)
 channels = 1  # 오디오 채널 수 (모노)
 sample_width = 2  # 샘플 크기 (16비트)
 recording_size = 5 # 녹음 시간
@@ -0,0 +1,111 @@
+#include "arena_plan.h"
+#include <stddef.h>
+#include "esp_attr.h"
+
+#define ARENA_PLAN_MAGIC 0x4E4C5041  // "APLN"
+#define ARENA_PLAN_MAX_BUFFERS 256
+
+typedef struct {
+    uint32_t magic;
+    uint32_t signature;        // 버퍼 요구사항 해시
+    uint32_t buffer_count;
+    uint32_t maximum_size;
+    int32_t offsets[ARENA_PLAN_MAX_BUFFERS];
+    uint32_t checksum;         // 위 필드 전체 (전원이 들어온 직후 RTC 메모리의 임의 값 걸러냄)
+} arena_plan_cache_t;
+
+static RTC_NOINIT_ATTR arena_plan_cache_t plan_cache;
+
+static uint32_t cache_checksum(const arena_plan_cache_t* cache) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(cache);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(arena_plan_cache_t, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void CachedMemoryPlanner::Hash(int value) {
+    for (int i = 0; i < 4; i++) {
+        signature_ = (signature_ ^ ((static_cast<uint32_t>(value) >> (8 * i)) & 0xFF)) * 16777619u;
+    }
+}
+
+void CachedMemoryPlanner::Record(int size, int first_time_used, int last_time_used, int offline_offset) {
+    Hash(size);
+    Hash(first_time_used);
+    Hash(last_time_used);
+    Hash(offline_offset);
+    buffer_count_++;
+    state_ = kCollecting;  // 배치 후에 버퍼가 추가되면 다시 판단
+}
+
+// 기본 구현의 AddBuffer가 다른 AddBuffer 오버로드를 부르더라도 한 번만 기록
+TfLiteStatus CachedMemoryPlanner::AddBuffer(int size, int first_time_used, int last_time_used) {
+    if (adding_) {
+        return tflite::GreedyMemoryPlanner::AddBuffer(size, first_time_used, last_time_used);
+    }
+    Record(size, first_time_used, last_time_used, -1);
+    adding_ = true;
+    TfLiteStatus status = tflite::GreedyMemoryPlanner::AddBuffer(size, first_time_used, last_time_used);
+    adding_ = false;
+    return status;
+}
+
+TfLiteStatus CachedMemoryPlanner::AddBuffer(int size, int first_time_used, int last_time_used, int offline_offset) {
+    if (adding_) {
+        return tflite::GreedyMemoryPlanner::AddBuffer(size, first_time_used, last_time_used, offline_offset);
+    }
+    Record(size, first_time_used, last_time_used, offline_offset);
+    adding_ = true;
+    TfLiteStatus status = tflite::GreedyMemoryPlanner::AddBuffer(size, first_time_used, last_time_used, offline_offset);
+    adding_ = false;
+    return status;
+}
+
+// 버퍼가 다 들어온 뒤 처음 결과를 물어볼 때 캐시를 확인하거나 새로 계산해서 저장
+void CachedMemoryPlanner::Resolve() {
+    if (state_ != kCollecting) {
+        return;
+    }
+    if (plan_cache.magic == ARENA_PLAN_MAGIC && plan_cache.checksum == cache_checksum(&plan_cache) &&
+        plan_cache.signature == signature_ && plan_cache.buffer_count == static_cast<uint32_t>(buffer_count_)) {
+        state_ = kCacheHit;
+        return;
+    }
+
+    state_ = kComputed;
+    if (buffer_count_ > ARENA_PLAN_MAX_BUFFERS) {
+        return;  // 너무 큰 모델은 캐시하지 않음
+    }
+    plan_cache.magic = ARENA_PLAN_MAGIC;
+    plan_cache.signature = signature_;
+    plan_cache.buffer_count = buffer_count_;
+    plan_cache.maximum_size = tflite::GreedyMemoryPlanner::GetMaximumMemorySize();
+    for (int i = 0; i < buffer_count_; i++) {
+        int offset = 0;
+        tflite::GreedyMemoryPlanner::GetOffsetForBuffer(i, &offset);
+        plan_cache.offsets[i] = offset;
+    }
+    plan_cache.checksum = cache_checksum(&plan_cache);
+}
+
+size_t CachedMemoryPlanner::GetMaximumMemorySize() {
+    Resolve();
+    if (state_ == kCacheHit) {
+        return plan_cache.maximum_size;
+    }
+    return tflite::GreedyMemoryPlanner::GetMaximumMemorySize();
+}
+
+TfLiteStatus CachedMemoryPlanner::GetOffsetForBuffer(int buffer_index, int* offset) {
+    Resolve();
+    if (state_ == kCacheHit) {
+        if (buffer_index < 0 || buffer_index >= buffer_count_) {
+            return kTfLiteError;
+        }
+        *offset = plan_cache.offsets[buffer_index];
+        return kTfLiteOk;
+    }
+    return tflite::GreedyMemoryPlanner::GetOffsetForBuffer(buffer_index, offset);
+}
@@ -0,0 +1,35 @@
+#ifndef ARENA_PLAN_H
+#define ARENA_PLAN_H
+
+#include "tensorflow/lite/micro/memory_planner/greedy_memory_planner.h"
+
+// 텐서 아레나 배치(greedy planner 결과) 캐시
+// AllocateTensors()가 넘겨주는 버퍼 요구사항(크기, 사용 구간)이 지난번과 같으면 저장해둔 오프셋을 그대로 쓰고,
+// 다르면(모델 교체 등) greedy planner로 새로 계산해서 저장합니다.
+// 캐시는 RTC 메모리(RTC_NOINIT)에 있어서 소프트웨어 리셋, 워치독, 브라운아웃 뒤에도 남습니다. (전원이 완전히 꺼지면 다시 계산)
+//
+// MicroAllocator::Create(arena, size, &planner)에 넘기고, planner는 인터프리터보다 오래 살아 있어야 합니다.
+class CachedMemoryPlanner : public tflite::GreedyMemoryPlanner {
+ public:
+  TfLiteStatus AddBuffer(int size, int first_time_used, int last_time_used) override;
+  TfLiteStatus AddBuffer(int size, int first_time_used, int last_time_used, int offline_offset) override;
+  size_t GetMaximumMemorySize() override;
+  TfLiteStatus GetOffsetForBuffer(int buffer_index, int* offset) override;
+
+  // 이번 배치를 캐시에서 가져왔는지
+  bool cache_hit() const { return state_ == kCacheHit; }
+
+ private:
+  enum State { kCollecting, kCacheHit, kComputed };
+
+  void Resolve();
+  void Record(int size, int first_time_used, int last_time_used, int offline_offset);
+  void Hash(int value);
+
+  State state_ = kCollecting;
+  uint32_t signature_ = 2166136261u;  // FNV-1a
+  int buffer_count_ = 0;
+  bool adding_ = false;
+};
+
+#endif // ARENA_PLAN_H
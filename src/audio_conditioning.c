@@ -0,0 +1,180 @@
+#include "audio_conditioning.h"
+
+// 기본 설정 (platformio.ini build_flags에서 -DCONDITIONING_PREEMPHASIS=1 형식으로 변경 가능)
+#ifndef CONDITIONING_DC_BLOCK
+#define CONDITIONING_DC_BLOCK 1
+#endif
+#ifndef CONDITIONING_PREEMPHASIS
+#define CONDITIONING_PREEMPHASIS 0  // 모델을 프리엠퍼시스된 데이터로 학습했을 때만 켜주세요.
+#endif
+#ifndef CONDITIONING_AGC
+#define CONDITIONING_AGC 1
+#endif
+
+#define DC_STATE_SHIFT 12           // DC 제거 필터 상태의 추가 정밀도 (반올림 오차 누적 방지)
+#define GAIN_ONE_Q16   65536
+
+static inline int16_t saturate16(int32_t value) {
+    return (int16_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+}
+
+void audio_conditioning_default_config(audio_conditioning_config_t *config) {
+    config->dc_block = CONDITIONING_DC_BLOCK;
+    config->preemphasis = CONDITIONING_PREEMPHASIS;
+    config->agc = CONDITIONING_AGC;
+    config->dc_pole_q15 = 32604;            // 0.995 (16kHz에서 약 13Hz 이하 차단)
+    config->preemphasis_q15 = 31785;        // 0.97
+    config->agc_target = 8000;              // 약 -12 dBFS
+    config->agc_limit = 29000;              // 약 -1 dBFS
+    config->agc_max_gain_q16 = 16 * GAIN_ONE_Q16;
+    config->agc_attack_shift = 1;           // 큰 소리에는 빠르게 게인을 내림
+    config->agc_release_shift = 6;          // 32ms 블록 기준 약 2초에 걸쳐 천천히 올림
+}
+
+void audio_conditioning_init(audio_conditioning_t *state, const audio_conditioning_config_t *config) {
+    state->config = *config;
+    state->dc_x1 = 0;
+    state->dc_y1 = 0;
+    state->pre_x1 = 0;
+    state->gain_q16 = GAIN_ONE_Q16;
+    state->applied_gain_q16 = GAIN_ONE_Q16;
+}
+
+// DC 제거: y = x - x1 + a*y1 (y1은 Q12 추가 정밀도로 보관)
+#define DC_STEP(k) do {                                                         \
+        int32_t xn = samples[i + (k)];                                          \
+        y1 = (xn - x1) * (1 << DC_STATE_SHIFT) + (int32_t)(((int64_t)a * y1) >> 15); \
+        x1 = xn;                                                                \
+        samples[i + (k)] = saturate16((y1 + (1 << (DC_STATE_SHIFT - 1))) >> DC_STATE_SHIFT); \
+    } while (0)
+
+static void dc_block(audio_conditioning_t *state, int16_t *samples, size_t count) {
+    const int32_t a = state->config.dc_pole_q15;
+    int32_t x1 = state->dc_x1;
+    int32_t y1 = state->dc_y1;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        DC_STEP(0);
+        DC_STEP(1);
+        DC_STEP(2);
+        DC_STEP(3);
+    }
+    for (; i < count; i++) {
+        DC_STEP(0);
+    }
+    state->dc_x1 = x1;
+    state->dc_y1 = y1;
+}
+
+// 프리엠퍼시스: y = x - b*x1
+#define PRE_STEP(k) do {                                                        \
+        int32_t xn = samples[i + (k)];                                          \
+        samples[i + (k)] = saturate16(xn - ((b * x1 + (1 << 14)) >> 15));       \
+        x1 = xn;                                                                \
+    } while (0)
+
+static void preemphasis(audio_conditioning_t *state, int16_t *samples, size_t count) {
+    const int32_t b = state->config.preemphasis_q15;
+    int32_t x1 = state->pre_x1;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        PRE_STEP(0);
+        PRE_STEP(1);
+        PRE_STEP(2);
+        PRE_STEP(3);
+    }
+    for (; i < count; i++) {
+        PRE_STEP(0);
+    }
+    state->pre_x1 = x1;
+}
+
+static int32_t block_peak(const int16_t *samples, size_t count) {
+    int32_t p0 = 0, p1 = 0, p2 = 0, p3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32_t a0 = samples[i], a1 = samples[i + 1], a2 = samples[i + 2], a3 = samples[i + 3];
+        a0 = a0 < 0 ? -a0 : a0;
+        a1 = a1 < 0 ? -a1 : a1;
+        a2 = a2 < 0 ? -a2 : a2;
+        a3 = a3 < 0 ? -a3 : a3;
+        p0 = a0 > p0 ? a0 : p0;
+        p1 = a1 > p1 ? a1 : p1;
+        p2 = a2 > p2 ? a2 : p2;
+        p3 = a3 > p3 ? a3 : p3;
+    }
+    for (; i < count; i++) {
+        int32_t a0 = samples[i];
+        a0 = a0 < 0 ? -a0 : a0;
+        p0 = a0 > p0 ? a0 : p0;
+    }
+    p0 = p1 > p0 ? p1 : p0;
+    p2 = p3 > p2 ? p3 : p2;
+    return p2 > p0 ? p2 : p0;
+}
+
+// 게인 적용: 블록 안에서 이전 게인 → 새 게인으로 선형 보간 (게인이 계단처럼 바뀌면 잡음이 생김)
+#define GAIN_STEP(k) do {                                                       \
+        samples[i + (k)] = saturate16((samples[i + (k)] * gain + (1 << 15)) >> 16); \
+        gain += step;                                                           \
+    } while (0)
+
+static void agc(audio_conditioning_t *state, int16_t *samples, size_t count) {
+    const audio_conditioning_config_t *config = &state->config;
+    int32_t peak = block_peak(samples, count);
+
+    // 목표 게인을 천천히 따라감 (내릴 때는 빠르게, 올릴 때는 천천히)
+    int32_t target = config->agc_max_gain_q16;
+    if (peak > 0) {
+        int64_t wanted = ((int64_t)config->agc_target << 16) / peak;
+        if (wanted < target) {
+            target = (int32_t)wanted;
+        }
+    }
+    if (target < state->gain_q16) {
+        state->gain_q16 -= (state->gain_q16 - target) >> config->agc_attack_shift;
+    } else {
+        state->gain_q16 += (target - state->gain_q16) >> config->agc_release_shift;
+    }
+
+    // 리미터: 이 블록의 피크가 agc_limit을 넘지 않는 게인으로 제한
+    int32_t gain_end = state->gain_q16;
+    if (peak > 0) {
+        int64_t limit = ((int64_t)config->agc_limit << 16) / peak;
+        if (limit < gain_end) {
+            gain_end = (int32_t)limit;
+        }
+    }
+
+    // 게인을 내려야 하면 바로 내리고(리미터가 블록 처음부터 적용되도록), 올릴 때만 보간
+    // 모든 샘플에서 gain <= gain_end 이므로 |x| * gain <= agc_limit << 16 (int32 범위 안)
+    int32_t gain = state->applied_gain_q16 < gain_end ? state->applied_gain_q16 : gain_end;
+    int32_t step = (gain_end - gain) / (int32_t)count;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        GAIN_STEP(0);
+        GAIN_STEP(1);
+        GAIN_STEP(2);
+        GAIN_STEP(3);
+    }
+    for (; i < count; i++) {
+        GAIN_STEP(0);
+    }
+    state->applied_gain_q16 = gain_end;
+}
+
+void audio_conditioning_process(audio_conditioning_t *state, int16_t *samples, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (state->config.dc_block) {
+        dc_block(state, samples, count);
+    }
+    if (state->config.preemphasis) {
+        preemphasis(state, samples, count);
+    }
+    if (state->config.agc) {
+        agc(state, samples, count);
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef AUDIO_CONDITIONING_H
+#define AUDIO_CONDITIONING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// INMP441 입력 전처리 (고정소수점, 블록 단위)
+// 1. DC 제거 IIR:   y[n] = x[n] - x[n-1] + a * y[n-1]
+// 2. 프리엠퍼시스:  y[n] = x[n] - b * x[n-1]
+// 3. AGC + 리미터: 블록 피크로 목표 레벨까지 천천히 게인을 맞추고, 피크가 limit을 넘지 않도록 게인을 제한
+// DMA 버퍼 전체를 한 번에 처리합니다. (샘플마다 함수 호출 없음)
+// 학습 데이터 녹음(microphone.c)과 추론(wake_word.cpp)에 같은 설정을 써야 모델 입력이 같아집니다.
+
+typedef struct {
+    bool dc_block;
+    bool preemphasis;
+    bool agc;
+    int16_t dc_pole_q15;        // a (0.995 → 32604). 1에 가까울수록 차단 주파수가 낮음
+    int16_t preemphasis_q15;    // b (0.97 → 31785)
+    int16_t agc_target;         // 블록 피크 목표값
+    int16_t agc_limit;          // 리미터: 게인 적용 후 블록 피크 최대값
+    int32_t agc_max_gain_q16;   // 최대 게인 (Q16, 65536 = 1배)
+    uint8_t agc_attack_shift;   // 게인을 내릴 때 속도 (블록마다 차이의 1/2^shift)
+    uint8_t agc_release_shift;  // 게인을 올릴 때 속도 (크게 잡아서 천천히)
+} audio_conditioning_config_t;
+
+typedef struct {
+    audio_conditioning_config_t config;
+    int32_t dc_x1;              // DC 제거: 이전 입력
+    int32_t dc_y1;              // DC 제거: 이전 출력 (Q12 추가 정밀도)
+    int32_t pre_x1;             // 프리엠퍼시스: 이전 입력
+    int32_t gain_q16;           // AGC 게인 (목표 게인을 천천히 따라감)
+    int32_t applied_gain_q16;   // 이전 블록 끝에서 실제로 적용한 게인 (리미터 포함)
+} audio_conditioning_t;
+
+// 녹음/추론 공통 기본 설정 (CONDITIONING_* 매크로로 변경 가능)
+void audio_conditioning_default_config(audio_conditioning_config_t *config);
+
+void audio_conditioning_init(audio_conditioning_t *state, const audio_conditioning_config_t *config);
+
+// samples를 제자리에서 처리합니다.
+void audio_conditioning_process(audio_conditioning_t *state, int16_t *samples, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_CONDITIONING_H
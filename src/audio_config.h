@@ -0,0 +1,19 @@
+#ifndef AUDIO_CONFIG_H
+#define AUDIO_CONFIG_H
+
+// 녹음(microphone.c), 추론(wake_word.cpp), 특징 추출(audio_frontend.c)이 같이 쓰는 오디오 설정
+// platformio.ini build_flags에서 -DMODEL_SAMPLE_RATE=8000 형식으로 바꿀 수 있습니다.
+
+#define I2S_SAMPLE_RATE 16000  // I2S(INMP441) 캡처 레이트
+
+#ifndef MODEL_SAMPLE_RATE
+#define MODEL_SAMPLE_RATE 16000  // 모델 입력/특징 추출 레이트. 8000이면 decimator.c로 절반으로 줄임 (모델도 8kHz로 학습)
+#endif
+
+#if MODEL_SAMPLE_RATE != I2S_SAMPLE_RATE && MODEL_SAMPLE_RATE * 2 != I2S_SAMPLE_RATE
+#error "MODEL_SAMPLE_RATE must be I2S_SAMPLE_RATE or I2S_SAMPLE_RATE / 2"
+#endif
+
+#define MODEL_DECIMATION (I2S_SAMPLE_RATE / MODEL_SAMPLE_RATE)  // 1 또는 2
+
+#endif // AUDIO_CONFIG_H
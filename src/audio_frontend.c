@@ -0,0 +1,149 @@
+#include "audio_frontend.h"
+#include <string.h>
+#include "dsp_tables.h"
+#include "fft_q15.h"
+
+static uint32_t portable_peak(const int16_t *samples, int count) {
+    uint32_t peak = 0;
+    for (int i = 0; i < count; i++) {
+        peak |= (uint32_t)(samples[i] < 0 ? -samples[i] : samples[i]);
+    }
+    return peak;
+}
+
+static void portable_window(int16_t *spectrum, const int16_t *samples, const int16_t *window, int count, int shift) {
+    for (int i = 0; i < count; i++) {
+        spectrum[2 * i] = (int16_t)((((int32_t)samples[i] << shift) * window[i]) >> 15);
+        spectrum[2 * i + 1] = 0;
+    }
+}
+
+static void portable_power(const int16_t *spectrum, uint32_t *power, int bins) {
+    for (int k = 0; k < bins; k++) {
+        int32_t re = spectrum[2 * k], im = spectrum[2 * k + 1];
+        power[k] = (uint32_t)(re * re) + (uint32_t)(im * im);
+    }
+}
+
+static void portable_mel(const int16_t *spectrum, uint64_t *energy) {
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        const int16_t *weights = dsp_mel.weights_q15 + dsp_mel.offset[m];
+        const int16_t *bin = spectrum + 2 * dsp_mel.start[m];
+        uint64_t sum = 0;
+        for (int j = 0; j < dsp_mel.length[m]; j++, bin += 2) {
+            int32_t re = bin[0], im = bin[1];
+            uint32_t power = (uint32_t)(re * re) + (uint32_t)(im * im);
+            sum += (uint64_t)power * (uint32_t)weights[j];
+        }
+        energy[m] = sum;
+    }
+}
+
+const audio_frontend_kernels_t audio_frontend_portable_kernels = {
+    .name = "portable",
+    .peak = portable_peak,
+    .window = portable_window,
+    .fft = fft_q15,
+    .power = portable_power,
+    .mel = portable_mel,
+};
+
+#ifdef ESP_PLATFORM
+// 장치는 이식 가능한 C 커널만 (같은 파일의 const 테이블이라 컴파일러가 직접 호출로 바꿈)
+static const audio_frontend_kernels_t *const kernels = &audio_frontend_portable_kernels;
+#else
+static const audio_frontend_kernels_t *kernels = &audio_frontend_portable_kernels;
+
+void audio_frontend_set_kernels(const audio_frontend_kernels_t *set) {
+    kernels = set ? set : &audio_frontend_portable_kernels;
+}
+
+const audio_frontend_kernels_t *audio_frontend_kernels(void) {
+    return kernels;
+}
+#endif
+
+void audio_frontend_init(audio_frontend_t *fe) {
+    memset(fe, 0, sizeof(*fe));
+}
+
+int32_t audio_frontend_log2(uint32_t value) {
+    if (value == 0) {
+        return FRONTEND_LOG2_ZERO;
+    }
+    int msb = 31 - __builtin_clz(value);
+    // 최상위 비트 아래 8비트로 소수부
+    uint32_t mantissa = msb >= DSP_LOG2_TABLE_BITS ? value >> (msb - DSP_LOG2_TABLE_BITS) : value << (DSP_LOG2_TABLE_BITS - msb);
+    return msb * FRONTEND_LOG2_ONE + dsp_log2.q10[mantissa & ((1 << DSP_LOG2_TABLE_BITS) - 1)];
+}
+
+// 64비트 값의 log2, Q10
+static int32_t log2_u64(uint64_t value) {
+    uint32_t high = (uint32_t)(value >> 32);
+    if (high) {
+        int msb = 63 - __builtin_clz(high);
+        uint32_t mantissa = (uint32_t)(value >> (msb - DSP_LOG2_TABLE_BITS));
+        return msb * FRONTEND_LOG2_ONE + dsp_log2.q10[mantissa & ((1 << DSP_LOG2_TABLE_BITS) - 1)];
+    }
+    return audio_frontend_log2((uint32_t)value);
+}
+
+void audio_frontend_analyze(audio_frontend_t *fe, const int16_t *hop) {
+    int16_t *spectrum = fe->spectrum;
+
+    // 작은 소리도 정밀도를 잃지 않도록 프레임 크기를 키운 뒤 창 적용 + FFT (블록 부동소수점)
+    // OR로 구한 대략적인 최대값 (실제 최대값의 2배 이내)
+    uint32_t peak = kernels->peak(fe->history, FRONTEND_OVERLAP) | kernels->peak(hop, FRONTEND_HOP);
+    int input_shift = 0;
+    while (peak != 0 && (peak << (input_shift + 1)) < 16384) {
+        input_shift++;
+    }
+
+    kernels->window(spectrum, fe->history, dsp_window.q15, FRONTEND_OVERLAP, input_shift);
+    kernels->window(spectrum + 2 * FRONTEND_OVERLAP, hop, dsp_window.q15 + FRONTEND_OVERLAP, FRONTEND_HOP, input_shift);
+    memcpy(fe->history, hop + FRONTEND_HOP - FRONTEND_OVERLAP, sizeof(fe->history));
+
+    fe->exponent = kernels->fft(spectrum, FRONTEND_FFT_LOG2, dsp_twiddle.q15) - input_shift;
+
+    // |X|^2 = |spectrum|^2 * 2^(2 * exponent) (파워는 log_power 자리에 먼저 받아서 그 자리에서 log2로 바꿈)
+    const int32_t offset = 2 * fe->exponent * FRONTEND_LOG2_ONE;
+    uint32_t *power = (uint32_t *)fe->log_power;
+    kernels->power(spectrum, power, FRONTEND_BINS);
+    for (int k = 0; k < FRONTEND_BINS; k++) {
+        fe->log_power[k] = power[k] ? audio_frontend_log2(power[k]) + offset : FRONTEND_LOG2_ZERO;
+    }
+}
+
+void audio_frontend_synthesize(audio_frontend_t *fe, int16_t *hop) {
+    int16_t *spectrum = fe->spectrum;
+    // 실제 출력 = 역변환 결과 * 2^shift (창 곱셈의 Q15까지 합쳐서 한 번에 시프트)
+    int shift = ifft_q15(spectrum, FRONTEND_FFT_LOG2, dsp_twiddle.q15) - FRONTEND_FFT_LOG2 + fe->exponent - 15;
+    if (shift > 0) {
+        shift = 0;  // 정상 입력에서는 나오지 않음 (출력이 int16 범위를 넘음)
+    }
+
+    for (int i = 0; i < FRONTEND_FFT_SIZE; i++) {
+        int32_t v = spectrum[2 * i] * dsp_window.q15[i];
+        if (shift < 0) {
+            v = shift > -31 ? (v + (1 << (-shift - 1))) >> -shift : 0;
+        }
+
+        if (i < FRONTEND_HOP) {
+            int32_t y = fe->overlap[i] + v;
+            hop[i] = (int16_t)(y > 32767 ? 32767 : (y < -32768 ? -32768 : y));
+        }
+        if (i >= FRONTEND_HOP) {
+            fe->overlap[i - FRONTEND_HOP] = v;
+        }
+    }
+}
+
+void audio_frontend_mel(const audio_frontend_t *fe, int32_t *mel) {
+    // |X|^2 = |spectrum|^2 * 2^(2 * exponent), 가중치 Q15
+    const int32_t offset = (2 * fe->exponent - 15) * FRONTEND_LOG2_ONE;
+    uint64_t energy[FRONTEND_MEL_BINS];
+    kernels->mel(fe->spectrum, energy);
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        mel[m] = energy[m] ? log2_u64(energy[m]) + offset : FRONTEND_LOG2_ZERO;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef AUDIO_FRONTEND_H
+#define AUDIO_FRONTEND_H
+
+#include <stdint.h>
+#include "audio_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 고정소수점 STFT 분석/합성 (특징 추출과 잡음 제거가 같은 FFT 결과를 씀)
+// - 프레임 32ms, hop 16ms (16kHz: 512/256 샘플, 8kHz: 256/128 샘플), sqrt-Hann 분석/합성 창 (50% 겹침에서 완전 복원)
+// - analyze: hop만큼 새 샘플 → 창 → FFT → bin별 log2 파워
+// - 창/트위들/log 테이블은 dsp_tables.cpp에서 컴파일 시간에 생성 (플래시)
+// - (여기서 잡음 제거 등이 spectrum을 수정)
+// - synthesize: 역 FFT → 창 → overlap-add → hop만큼 출력 (지연: FRONTEND_FFT_SIZE - FRONTEND_HOP 샘플)
+
+// MODEL_SAMPLE_RATE에 맞춰 프레임 길이(시간)가 같도록
+#if MODEL_SAMPLE_RATE == 8000
+#define FRONTEND_FFT_LOG2 8
+#else
+#define FRONTEND_FFT_LOG2 9
+#endif
+#define FRONTEND_FFT_SIZE (1 << FRONTEND_FFT_LOG2)
+#define FRONTEND_HOP      (FRONTEND_FFT_SIZE / 2)
+#define FRONTEND_BINS     (FRONTEND_FFT_SIZE / 2 + 1)
+#define FRONTEND_OVERLAP  (FRONTEND_FFT_SIZE - FRONTEND_HOP)
+
+// 로그 mel 특징 (audio_frontend_mel)의 필터 수
+#ifndef FRONTEND_MEL_BINS
+#define FRONTEND_MEL_BINS 40
+#endif
+
+#define FRONTEND_LOG2_ONE   1024               // log2 값의 Q10 스케일
+#define FRONTEND_LOG2_ZERO  (-32 * FRONTEND_LOG2_ONE)  // 파워가 0인 bin
+
+typedef struct {
+    int16_t history[FRONTEND_OVERLAP];      // 이전 프레임의 뒷부분 (분석 창 겹침)
+    int32_t overlap[FRONTEND_OVERLAP];      // 합성 overlap-add 누적값
+    int16_t spectrum[2 * FRONTEND_FFT_SIZE]; // 현재 프레임의 복소 스펙트럼 (실수/허수 교대)
+    int exponent;                           // 실제 DFT = spectrum * 2^exponent (입력 샘플 단위)
+    int32_t log_power[FRONTEND_BINS];       // bin별 log2(|X|^2), Q10
+} audio_frontend_t;
+
+// 분석 커널 (analyze, mel이 부르는 순서). 기본값은 이식 가능한 C 버전(장치에서 실행하는 코드)
+// 호스트 도구는 host/frontend_simd.c가 CPU에 맞는 SSE4.1/AVX2 버전으로 바꿉니다. (결과는 비트 단위로 같아야 함, host/bench_frontend.c)
+typedef struct {
+    const char *name;
+    // |샘플|의 OR (입력 시프트를 정하는 대략적인 최대값)
+    uint32_t (*peak)(const int16_t *samples, int count);
+    // spectrum[2i] = ((samples[i] << shift) * window[i]) >> 15, spectrum[2i + 1] = 0
+    void (*window)(int16_t *spectrum, const int16_t *samples, const int16_t *window, int count, int shift);
+    // fft_q15와 같은 계약
+    int (*fft)(int16_t *data, int log2n, const int16_t *twiddle);
+    // power[k] = re^2 + im^2 (uint32, bins개)
+    void (*power)(const int16_t *spectrum, uint32_t *power, int bins);
+    // energy[m] = Σ power * weight (dsp_mel 필터, FRONTEND_MEL_BINS개)
+    void (*mel)(const int16_t *spectrum, uint64_t *energy);
+} audio_frontend_kernels_t;
+
+extern const audio_frontend_kernels_t audio_frontend_portable_kernels;
+
+void audio_frontend_init(audio_frontend_t *fe);
+
+#ifndef ESP_PLATFORM
+// 모든 audio_frontend_t가 쓰는 커널 (NULL이면 이식 가능한 C 버전). 스레드를 만들기 전에 한 번만
+void audio_frontend_set_kernels(const audio_frontend_kernels_t *kernels);
+const audio_frontend_kernels_t *audio_frontend_kernels(void);
+#endif
+
+// hop: FRONTEND_HOP 샘플
+void audio_frontend_analyze(audio_frontend_t *fe, const int16_t *hop);
+
+// 수정된 spectrum으로 FRONTEND_HOP 샘플 출력 (spectrum은 덮어씀)
+void audio_frontend_synthesize(audio_frontend_t *fe, int16_t *hop);
+
+// 현재 spectrum(잡음 제거 후이면 제거된 스펙트럼)의 mel 필터 에너지, log2 Q10 (FRONTEND_MEL_BINS개)
+// 파형 대신 mel 특징을 입력으로 받는 모델용 (FFT를 다시 하지 않음)
+void audio_frontend_mel(const audio_frontend_t *fe, int32_t *mel);
+
+// log2(value), Q10 (value == 0이면 FRONTEND_LOG2_ZERO)
+int32_t audio_frontend_log2(uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_FRONTEND_H
@@ -0,0 +1,233 @@
+#include <string.h>
+#include "audio_pool.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "AUDIO_POOL";
+static portMUX_TYPE pool_lock = portMUX_INITIALIZER_UNLOCKED;
+#define POOL_LOCK()   portENTER_CRITICAL(&pool_lock)
+#define POOL_UNLOCK() portEXIT_CRITICAL(&pool_lock)
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define POOL_LOCK()
+#define POOL_UNLOCK()
+#endif
+
+typedef struct {
+    audio_pool_budget_t budget;  // block_size는 정렬 단위로 올린 값
+    uint8_t *base;
+    void *free_list;             // 빈 블록의 첫 워드에 다음 빈 블록 주소
+    uint32_t *used;              // 블록별 사용 중 비트 (이중 해제 검사)
+    uint16_t in_use;
+    uint16_t peak;
+    uint32_t overflows;
+} pool_t;
+
+static pool_t pools[AUDIO_POOL_MAX_POOLS];  // 블록 크기 오름차순
+static size_t pool_count;
+static uint32_t failures;
+
+static void *platform_alloc(size_t size, uint32_t caps) {
+#ifdef ESP_PLATFORM
+    uint32_t heap_caps = MALLOC_CAP_8BIT;
+    if (caps & AUDIO_POOL_CAP_INTERNAL) {
+        heap_caps |= MALLOC_CAP_INTERNAL;
+    }
+    if (caps & AUDIO_POOL_CAP_DMA) {
+        heap_caps |= MALLOC_CAP_DMA;
+    }
+    if (caps & AUDIO_POOL_CAP_SPIRAM) {
+        heap_caps |= MALLOC_CAP_SPIRAM;
+    }
+    return heap_caps_aligned_alloc(AUDIO_POOL_ALIGN, size, heap_caps);
+#else
+    (void)caps;
+    return aligned_alloc(AUDIO_POOL_ALIGN, size);
+#endif
+}
+
+static void platform_free(void *ptr) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void audio_pool_deinit(void) {
+    for (size_t i = 0; i < pool_count; i++) {
+        platform_free(pools[i].base);
+        platform_free(pools[i].used);
+    }
+    memset(pools, 0, sizeof(pools));
+    pool_count = 0;
+    failures = 0;
+}
+
+bool audio_pool_init(const audio_pool_budget_t *budget, size_t count) {
+    audio_pool_deinit();
+    if (count > AUDIO_POOL_MAX_POOLS) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        pool_t pool = {0};
+        pool.budget = budget[i];
+        if (pool.budget.block_count == 0) {
+            continue;  // 설정에 따라 필요 없는 풀 (예: 모노 빌드의 스테레오 버퍼)
+        }
+        size_t block_size = pool.budget.block_size < sizeof(void *) ? sizeof(void *) : pool.budget.block_size;
+        pool.budget.block_size = (block_size + AUDIO_POOL_ALIGN - 1) & ~(size_t)(AUDIO_POOL_ALIGN - 1);
+
+        size_t words = (pool.budget.block_count + 127) / 128 * 4;  // 정렬 단위(16바이트)로 올림
+        pool.base = platform_alloc(pool.budget.block_size * pool.budget.block_count, pool.budget.caps);
+        pool.used = platform_alloc(words * sizeof(uint32_t), AUDIO_POOL_CAP_INTERNAL);
+        if (!pool.base || !pool.used) {
+#ifdef ESP_PLATFORM
+            ESP_LOGE(TAG, "Failed to allocate pool %s (%u x %u bytes)", pool.budget.name,
+                     (unsigned)pool.budget.block_count, (unsigned)pool.budget.block_size);
+#endif
+            platform_free(pool.base);
+            platform_free(pool.used);
+            audio_pool_deinit();
+            return false;
+        }
+        memset(pool.used, 0, words * sizeof(uint32_t));
+
+        // 첫 블록이 먼저 나가도록 뒤에서부터 연결
+        for (int b = pool.budget.block_count - 1; b >= 0; b--) {
+            void **block = (void **)(pool.base + (size_t)b * pool.budget.block_size);
+            *block = pool.free_list;
+            pool.free_list = block;
+        }
+
+        // 블록 크기 오름차순으로 삽입
+        size_t at = pool_count;
+        while (at > 0 && pools[at - 1].budget.block_size > pool.budget.block_size) {
+            pools[at] = pools[at - 1];
+            at--;
+        }
+        pools[at] = pool;
+        pool_count++;
+    }
+    return true;
+}
+
+void *audio_pool_alloc(size_t size, uint32_t caps) {
+    void *block = NULL;
+    POOL_LOCK();
+    for (size_t i = 0; i < pool_count; i++) {
+        pool_t *pool = &pools[i];
+        if (pool->budget.block_size < size || (pool->budget.caps & caps) != caps) {
+            continue;
+        }
+        if (!pool->free_list) {
+            pool->overflows++;
+            continue;
+        }
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+        size_t index = ((uint8_t *)block - pool->base) / pool->budget.block_size;
+        pool->used[index / 32] |= 1u << (index % 32);
+        pool->in_use++;
+        if (pool->in_use > pool->peak) {
+            pool->peak = pool->in_use;
+        }
+        break;
+    }
+    if (!block) {
+        failures++;
+    }
+    POOL_UNLOCK();
+    return block;
+}
+
+bool audio_pool_free(void *block) {
+    if (!block) {
+        return false;
+    }
+    bool freed = false;
+    POOL_LOCK();
+    for (size_t i = 0; i < pool_count; i++) {
+        pool_t *pool = &pools[i];
+        uint8_t *p = (uint8_t *)block;
+        if (p < pool->base || p >= pool->base + pool->budget.block_size * pool->budget.block_count) {
+            continue;
+        }
+        size_t offset = (size_t)(p - pool->base);
+        size_t index = offset / pool->budget.block_size;
+        uint32_t bit = 1u << (index % 32);
+        if (offset % pool->budget.block_size == 0 && (pool->used[index / 32] & bit)) {
+            pool->used[index / 32] &= ~bit;
+            *(void **)block = pool->free_list;
+            pool->free_list = block;
+            pool->in_use--;
+            freed = true;
+        }
+        break;
+    }
+    POOL_UNLOCK();
+#ifdef ESP_PLATFORM
+    if (!freed) {
+        ESP_LOGE(TAG, "Invalid free: %p", block);
+    }
+#endif
+    return freed;
+}
+
+size_t audio_pool_count(void) {
+    return pool_count;
+}
+
+bool audio_pool_stats(size_t index, audio_pool_stats_t *stats) {
+    if (index >= pool_count) {
+        return false;
+    }
+    POOL_LOCK();
+    const pool_t *pool = &pools[index];
+    stats->name = pool->budget.name;
+    stats->block_size = pool->budget.block_size;
+    stats->block_count = pool->budget.block_count;
+    stats->caps = pool->budget.caps;
+    stats->in_use = pool->in_use;
+    stats->peak = pool->peak;
+    stats->overflows = pool->overflows;
+    POOL_UNLOCK();
+    return true;
+}
+
+uint32_t audio_pool_failures(void) {
+    return failures;
+}
+
+void audio_pool_report(void) {
+    size_t total = 0;
+    size_t peak_total = 0;
+    for (size_t i = 0; i < pool_count; i++) {
+        audio_pool_stats_t s;
+        audio_pool_stats(i, &s);
+        const char *where = (s.caps & AUDIO_POOL_CAP_SPIRAM) ? "spiram" : (s.caps & AUDIO_POOL_CAP_DMA) ? "dma" : "internal";
+#ifdef ESP_PLATFORM
+        ESP_LOGI(TAG, "%-10s %6u B x %2u (%-8s) in use %2u, peak %2u, overflows %lu", s.name,
+                 (unsigned)s.block_size, (unsigned)s.block_count, where, (unsigned)s.in_use,
+                 (unsigned)s.peak, (unsigned long)s.overflows);
+#else
+        printf("%-10s %6u B x %2u (%-8s) in use %2u, peak %2u, overflows %lu\n", s.name,
+               (unsigned)s.block_size, (unsigned)s.block_count, where, (unsigned)s.in_use,
+               (unsigned)s.peak, (unsigned long)s.overflows);
+#endif
+        total += s.block_size * s.block_count;
+        peak_total += s.block_size * s.peak;
+    }
+#ifdef ESP_PLATFORM
+    ESP_LOGI(TAG, "Budget %u bytes, peak use %u bytes, failed allocations %lu",
+             (unsigned)total, (unsigned)peak_total, (unsigned long)failures);
+#else
+    printf("Budget %u bytes, peak use %u bytes, failed allocations %lu\n",
+           (unsigned)total, (unsigned)peak_total, (unsigned long)failures);
+#endif
+}
@@ -0,0 +1,67 @@
+#ifndef AUDIO_POOL_H
+#define AUDIO_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 오디오/모델 버퍼용 고정 블록 풀
+// - 부팅 시 예산 테이블(audio_pool_budget_t 배열) 하나로 풀마다 한 번에 할당하고, 이후에는 malloc/free를 쓰지 않습니다.
+//   (Wi-Fi 등이 힙을 쓰기 시작해도 오디오 버퍼는 조각나지 않음)
+// - alloc은 조건(caps)을 만족하는 풀 중 블록이 가장 작은 풀에서 O(1)로 꺼냅니다. 가득 차면 다음 크기 풀로 넘어감.
+// - 풀마다 사용 중/최대 사용 블록 수를 기록해서 audio_pool_report()로 예산을 맞출 수 있습니다.
+// - ESP32에서는 여러 태스크(코어)에서 호출해도 됩니다. (호스트 빌드는 단일 스레드 전용)
+
+#define AUDIO_POOL_MAX_POOLS 12
+#define AUDIO_POOL_ALIGN 16  // 블록 정렬 (TFLM 텐서 아레나, DMA 모두 만족)
+
+// 메모리 조건 (heap_caps의 MALLOC_CAP_*에 대응)
+#define AUDIO_POOL_CAP_INTERNAL 0x01  // 내부 SRAM (캐시 미스/PSRAM 대역폭 영향 없음)
+#define AUDIO_POOL_CAP_DMA      0x02  // DMA 가능 (내부 SRAM, I2S/SPI DMA가 직접 접근)
+#define AUDIO_POOL_CAP_SPIRAM   0x04  // PSRAM (용량이 큰 버퍼)
+
+typedef struct {
+    const char *name;
+    size_t block_size;      // 바이트 (AUDIO_POOL_ALIGN으로 올림)
+    uint16_t block_count;
+    uint32_t caps;          // AUDIO_POOL_CAP_*
+} audio_pool_budget_t;
+
+typedef struct {
+    const char *name;
+    size_t block_size;
+    uint16_t block_count;
+    uint32_t caps;
+    uint16_t in_use;
+    uint16_t peak;          // 부팅 후 최대 동시 사용 블록 수
+    uint32_t overflows;     // 이 풀이 가득 차서 더 큰 풀로 넘어간 횟수
+} audio_pool_stats_t;
+
+// 예산 테이블대로 풀을 할당합니다. 하나라도 실패하면 전부 해제하고 false.
+bool audio_pool_init(const audio_pool_budget_t *budget, size_t count);
+
+// 모든 풀 해제 (호스트 테스트용, 사용 중인 블록이 있어도 해제)
+void audio_pool_deinit(void);
+
+// size 바이트 이상, caps 조건을 모두 만족하는 블록. 없으면 NULL (audio_pool_failures() 증가)
+void *audio_pool_alloc(size_t size, uint32_t caps);
+
+// 풀에서 받은 블록 반환. 풀 밖의 포인터나 이중 해제는 무시하고 false.
+bool audio_pool_free(void *block);
+
+size_t audio_pool_count(void);
+bool audio_pool_stats(size_t index, audio_pool_stats_t *stats);
+uint32_t audio_pool_failures(void);
+
+// 풀별 블록 크기, 개수, 사용 중, 최대 사용량, 넘침 횟수를 로그로 출력
+void audio_pool_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_POOL_H
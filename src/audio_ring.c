@@ -0,0 +1,88 @@
+#include <string.h>
+#include "audio_ring.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+static const char *TAG = "AUDIO_RING";
+#else
+#include <stdlib.h>
+#endif
+
+bool audio_ring_init(audio_ring_t *ring, size_t capacity) {
+    // 2의 거듭제곱으로 올림: position(32비트)이 넘쳐서 0으로 돌아가도 position % capacity가 이어지도록
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    capacity = rounded;
+
+    size_t size = capacity * sizeof(int16_t);
+#ifdef ESP_PLATFORM
+    // 수 초 분량의 오디오는 PSRAM에 두고, PSRAM이 없는 보드에서는 내부 RAM 사용
+    ring->data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ring->data) {
+        ESP_LOGI(TAG, "Ring buffer: %u samples in PSRAM", (unsigned)capacity);
+    } else {
+        ring->data = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (ring->data) {
+            ESP_LOGI(TAG, "Ring buffer: %u samples in internal RAM", (unsigned)capacity);
+        }
+    }
+#else
+    ring->data = malloc(size);
+#endif
+    if (!ring->data) {
+        return false;
+    }
+    memset(ring->data, 0, size);
+    ring->capacity = capacity;
+    ring->written = 0;
+    return true;
+}
+
+void audio_ring_write(audio_ring_t *ring, const int16_t *samples, size_t count) {
+    uint32_t written = ring->written;
+    size_t head = written % ring->capacity;
+
+    // 끝을 넘어가는 부분은 두 번에 나눠서 복사
+    while (count > 0) {
+        size_t part = ring->capacity - head;
+        if (part > count) {
+            part = count;
+        }
+        memcpy(ring->data + head, samples, part * sizeof(int16_t));
+        samples += part;
+        count -= part;
+        written += part;
+        head = 0;
+    }
+    ring->written = written;  // 데이터를 다 쓴 뒤에 위치를 갱신해야 읽는 쪽이 덜 쓴 샘플을 보지 않음
+}
+
+void audio_ring_reset(audio_ring_t *ring) {
+    memset(ring->data, 0, ring->capacity * sizeof(int16_t));
+    ring->written = 0;
+}
+
+size_t audio_ring_read(const audio_ring_t *ring, uint32_t position, int16_t *dst, size_t count) {
+    uint32_t written = ring->written;
+    uint32_t available = written - position;  // 32비트가 넘쳐도 차이는 올바름
+    if (available > ring->capacity || count > available) {
+        return 0;  // 이미 덮어써졌거나 아직 쓰지 않은 구간
+    }
+
+    size_t tail = position % ring->capacity;
+    size_t copied = 0;
+    while (copied < count) {
+        size_t part = ring->capacity - tail;
+        if (part > count - copied) {
+            part = count - copied;
+        }
+        memcpy(dst + copied, ring->data + tail, part * sizeof(int16_t));
+        copied += part;
+        tail = 0;
+    }
+    return copied;
+}
@@ -0,0 +1,42 @@
+#ifndef AUDIO_RING_H
+#define AUDIO_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 마이크 샘플(int16)을 계속 덮어쓰며 최근 오디오를 보관하는 링 버퍼
+// - 캡처 태스크 하나만 쓰고, 다른 태스크는 절대 위치(position)로 최근 구간을 읽습니다.
+// - position은 지금까지 쓴 전체 샘플 수(32비트, 넘치면 0으로 돌아감)입니다.
+// - 읽는 구간이 쓰는 중인 블록과 겹치지 않도록, capacity는 읽을 최대 길이보다 DMA 블록 몇 개만큼 크게 잡아주세요.
+typedef struct {
+    int16_t *data;
+    size_t capacity;            // 샘플 수
+    volatile uint32_t written;  // 지금까지 쓴 전체 샘플 수
+} audio_ring_t;
+
+// capacity 샘플(2의 거듭제곱으로 올림) 크기로 할당합니다. PSRAM이 있으면 PSRAM에, 없으면 내부 RAM에 할당.
+bool audio_ring_init(audio_ring_t *ring, size_t capacity);
+
+void audio_ring_write(audio_ring_t *ring, const int16_t *samples, size_t count);
+
+// 위치를 0으로 되돌리고 내용을 지웁니다. (PCM 주입 시작 등, 쓰는 쪽과 읽는 쪽이 모두 멈춘 상태에서만)
+void audio_ring_reset(audio_ring_t *ring);
+
+// 현재 쓰기 위치 (다음에 쓸 샘플의 절대 위치)
+static inline uint32_t audio_ring_position(const audio_ring_t *ring) {
+    return ring->written;
+}
+
+// 절대 위치 position부터 count 샘플을 복사합니다. 이미 덮어써진 구간이면 0을 반환.
+size_t audio_ring_read(const audio_ring_t *ring, uint32_t position, int16_t *dst, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_RING_H
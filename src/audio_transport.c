@@ -0,0 +1,234 @@
+#include <string.h>
+#include <stdio.h>
+#include "audio_transport.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+
+static const char *TAG = "TRANSPORT";
+#endif
+
+_Static_assert(sizeof(audio_transport_header_t) == 24, "packet header layout (scripts/stream_receiver.py)");
+
+enum {
+    EVENT_TEXT = 0,
+    EVENT_START = 1,
+};
+
+// a가 b보다 앞인지 (32비트 링 위치가 넘쳐도)
+static bool before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void copy_text(char *dst, const char *text) {
+    size_t length = 0;
+    if (text) {
+        length = strlen(text);
+        if (length >= AUDIO_TRANSPORT_EVENT_TEXT) {
+            length = AUDIO_TRANSPORT_EVENT_TEXT - 1;
+        }
+        memcpy(dst, text, length);
+    }
+    dst[length] = '\0';
+}
+
+void audio_transport_init(audio_transport_t *t, const audio_transport_backend_t *backend, const audio_ring_t *ring,
+                          uint32_t backlog, uint32_t flush_us) {
+    memset(t, 0, sizeof(*t));
+    t->backend = *backend;
+    t->ring = ring;
+    t->packet_samples = (backend->mtu - sizeof(audio_transport_header_t)) / sizeof(int16_t);
+    t->backlog = backlog < ring->capacity ? backlog : (uint32_t)ring->capacity;
+    t->flush_us = flush_us;
+}
+
+static bool push_event(audio_transport_t *t, uint8_t kind, uint32_t position, const char *text) {
+    uint32_t head = t->head;
+    if (head - t->tail >= AUDIO_TRANSPORT_EVENTS) {
+        t->stats.dropped_events++;
+        return false;
+    }
+    audio_transport_event_t *e = &t->events[head % AUDIO_TRANSPORT_EVENTS];
+    e->kind = kind;
+    e->position = position;
+    copy_text(e->text, text);
+    t->head = head + 1;  // 내용을 다 쓴 뒤에 poll 태스크에 보이도록
+    return true;
+}
+
+bool audio_transport_start(audio_transport_t *t, uint32_t position, const char *text) {
+    return push_event(t, EVENT_START, position, text);
+}
+
+bool audio_transport_event(audio_transport_t *t, uint32_t position, const char *text) {
+    return push_event(t, EVENT_TEXT, position, text);
+}
+
+void audio_transport_stop(audio_transport_t *t, uint32_t position, const char *text) {
+    t->stopping = true;
+    t->stop_position = position;
+    copy_text(t->stop_text, text);
+}
+
+static audio_transport_result_t send_packet(audio_transport_t *t, uint8_t type, uint32_t position,
+                                            const audio_transport_span_t *spans, size_t count, uint32_t now_us) {
+    audio_transport_header_t header;
+    size_t payload = 0;
+    for (size_t i = 0; i < count; i++) {
+        payload += spans[i].size;
+    }
+    header.magic = AUDIO_TRANSPORT_MAGIC;
+    header.version = AUDIO_TRANSPORT_VERSION;
+    header.type = type;
+    header.payload_size = (uint16_t)payload;
+    header.sequence = t->sequence;
+    header.position = position;
+    header.timestamp_us = now_us;
+    header.dropped_samples = t->stats.dropped_samples;
+
+    audio_transport_result_t result = t->backend.send(t->backend.user, &header, spans, count);
+    if (result == AUDIO_TRANSPORT_SENT) {
+        t->sequence++;
+        t->stats.packets++;
+        t->stats.bytes += sizeof(header) + payload;
+    } else if (result == AUDIO_TRANSPORT_BUSY) {
+        t->stats.busy++;
+    } else {
+        t->stats.errors++;
+    }
+    return result;
+}
+
+static audio_transport_result_t send_text(audio_transport_t *t, uint32_t position, const char *text, uint32_t now_us) {
+    audio_transport_span_t span = {text, strlen(text)};
+    return send_packet(t, AUDIO_TRANSPORT_EVENT, position, &span, 1, now_us);
+}
+
+// 밀린 샘플이 backlog를 넘으면 오래된 것부터 버림
+static void drop_backlog(audio_transport_t *t) {
+    uint32_t pending = t->ring->written - t->position;
+    if (pending > t->backlog) {
+        uint32_t skip = pending - t->backlog;
+        t->position += skip;
+        t->stats.dropped_samples += skip;
+        t->waiting = false;
+        pending = t->backlog;
+    }
+    if (pending > t->stats.max_backlog) {
+        t->stats.max_backlog = pending;
+    }
+}
+
+// limit 전까지 오디오를 패킷으로 보냄. 다 보냈으면 true (덜 찬 패킷을 기다리거나 막혔으면 false)
+static bool send_audio(audio_transport_t *t, uint32_t limit, bool flush, uint32_t now_us, size_t *sent) {
+    const audio_ring_t *ring = t->ring;
+    while (before(t->position, limit)) {
+        uint32_t pending = limit - t->position;
+        size_t count = pending < t->packet_samples ? pending : t->packet_samples;
+        if (count < t->packet_samples && !flush) {
+            if (!t->waiting) {
+                t->waiting = true;
+                t->waiting_since_us = now_us;
+            }
+            if (now_us - t->waiting_since_us < t->flush_us) {
+                return false;  // 더 모아서 MTU를 채움
+            }
+        }
+
+        // 링 버퍼를 그대로 (끝을 넘으면 두 조각)
+        audio_transport_span_t spans[AUDIO_TRANSPORT_MAX_SPANS];
+        size_t tail = t->position % ring->capacity;
+        size_t first = ring->capacity - tail < count ? ring->capacity - tail : count;
+        size_t num_spans = 1;
+        spans[0].data = ring->data + tail;
+        spans[0].size = first * sizeof(int16_t);
+        if (first < count) {
+            spans[1].data = ring->data;
+            spans[1].size = (count - first) * sizeof(int16_t);
+            num_spans = 2;
+        }
+        if (send_packet(t, AUDIO_TRANSPORT_AUDIO, t->position, spans, num_spans, now_us) != AUDIO_TRANSPORT_SENT) {
+            return false;  // 다음 poll에 같은 위치부터
+        }
+        t->position += count;
+        t->stats.samples += count;
+        t->waiting = false;
+        (*sent)++;
+    }
+    return true;
+}
+
+size_t audio_transport_poll(audio_transport_t *t, uint32_t now_us, bool flush) {
+    size_t sent = 0;
+    while (1) {
+        audio_transport_event_t *e = t->tail != t->head ? &t->events[t->tail % AUDIO_TRANSPORT_EVENTS] : NULL;
+        if (e && e->kind == EVENT_START && t->streaming && t->stopping) {
+            e = NULL;  // 지금 스트림을 끝낸 뒤에 시작
+        }
+
+        if (t->streaming) {
+            drop_backlog(t);
+            // 다음 이벤트(또는 끝) 위치까지는 덜 찬 패킷이라도 보내야 이벤트 순서가 맞음
+            uint32_t limit = t->ring->written;
+            bool final = flush;
+            if (t->stopping && !before(limit, t->stop_position)) {
+                limit = t->stop_position;
+                final = true;
+            }
+            if (e && !before(limit, e->position)) {
+                limit = e->position;
+                final = true;
+            }
+            if (!send_audio(t, limit, final, now_us, &sent)) {
+                return sent;
+            }
+            if (!e || before(t->position, e->position)) {
+                if (!t->stopping || before(t->position, t->stop_position)) {
+                    return sent;  // 보낼 것을 다 보냄
+                }
+                if (t->stop_text[0]) {
+                    if (send_text(t, t->stop_position, t->stop_text, now_us) != AUDIO_TRANSPORT_SENT) {
+                        return sent;
+                    }
+                    sent++;
+                }
+                t->streaming = false;
+                t->stopping = false;
+                continue;
+            }
+        } else if (t->stopping && !e) {
+            t->stopping = false;  // 시작하지 않은 스트림
+        }
+        if (!e) {
+            return sent;
+        }
+
+        if (e->text[0]) {
+            if (send_text(t, e->position, e->text, now_us) != AUDIO_TRANSPORT_SENT) {
+                return sent;
+            }
+            sent++;
+        }
+        if (e->kind == EVENT_START && !t->streaming) {
+            t->streaming = true;
+            t->position = e->position;
+            t->waiting = false;
+        }
+        t->tail++;
+    }
+}
+
+void audio_transport_report(const audio_transport_t *t) {
+    const audio_transport_stats_t *s = &t->stats;
+    char line[200];
+    snprintf(line, sizeof(line),
+             "%s: packets %lu (%llu bytes, %lu samples), busy %lu, errors %lu, dropped %lu samples / %lu events, max backlog %lu",
+             t->backend.name, (unsigned long)s->packets, (unsigned long long)s->bytes, (unsigned long)s->samples,
+             (unsigned long)s->busy, (unsigned long)s->errors, (unsigned long)s->dropped_samples,
+             (unsigned long)s->dropped_events, (unsigned long)s->max_backlog);
+#ifdef ESP_PLATFORM
+    ESP_LOGI(TAG, "%s", line);
+#else
+    printf("%s\n", line);
+#endif
+}
@@ -0,0 +1,135 @@
+#ifndef AUDIO_TRANSPORT_H
+#define AUDIO_TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "audio_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 오디오/이벤트 전송 (UART, Wi-Fi TCP/UDP 공통): 링 버퍼의 오디오를 패킷으로 묶어서 백엔드로 보냄
+// - 복사 없이 보냄: 링 버퍼에서 보낼 구간을 그대로 (끝을 넘으면 두 조각) 백엔드에 넘기고,
+//   백엔드는 헤더와 함께 한 번에 보냄 (소켓: sendmsg의 iovec, UART: 드라이버 송신 버퍼로 바로)
+// - 묶어서 보냄: 백엔드 MTU만큼 찰 때까지 모으고, 덜 찼어도 가장 오래 기다린 샘플이 flush_us를 넘으면 보냄
+// - 백프레셔: 백엔드가 받지 못하면(BUSY) 다음 poll에 다시. 밀린 샘플이 backlog를 넘으면 오래된 것부터 버리고
+//   버린 수를 통계와 패킷 헤더(누적)에 남김 (받는 쪽은 position이 건너뛴 것으로도 알 수 있음)
+// - 이벤트(검출, 캡처 시작/끝)는 링 위치와 함께 큐에 넣고, 그 위치까지의 오디오를 먼저 보낸 뒤에 보냄
+// 스레드: poll/stop은 한 태스크(장치: 캡처 태스크)에서만, event/start는 다른 태스크 하나(추론 태스크)에서만
+// 호스트: host/bench_transport.c (루프백 TCP/UDP로 처리량, 지연, 버린 샘플 확인)
+
+#define AUDIO_TRANSPORT_MAGIC 0x31505441  // "ATP1"
+#define AUDIO_TRANSPORT_VERSION 1
+#define AUDIO_TRANSPORT_EVENT_TEXT 48   // 이벤트 문자열 최대 길이 ('\0' 포함)
+#define AUDIO_TRANSPORT_EVENTS 8        // 이벤트 큐 길이 (가득 차면 새 이벤트를 버림)
+#define AUDIO_TRANSPORT_MAX_SPANS 2     // 링 버퍼 구간 (끝을 넘어가면 두 조각)
+
+enum {
+    AUDIO_TRANSPORT_AUDIO = 1,  // payload: int16 LE 샘플 (MODEL_SAMPLE_RATE 모노)
+    AUDIO_TRANSPORT_EVENT = 2,  // payload: 문자열 ('\0' 없음)
+};
+
+// 패킷 헤더 (little-endian, scripts/stream_receiver.py와 같아야 함)
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t type;
+    uint16_t payload_size;
+    uint32_t sequence;          // 패킷 번호 (UDP 손실 확인)
+    uint32_t position;          // 오디오: 첫 샘플의 링 위치, 이벤트: 이벤트 시점의 링 위치
+    uint32_t timestamp_us;      // 보낸 시각 (장치 시계, 32비트)
+    uint32_t dropped_samples;   // 지금까지 백프레셔로 버린 샘플 수 (누적)
+} audio_transport_header_t;
+
+typedef struct {
+    const void *data;
+    size_t size;
+} audio_transport_span_t;
+
+typedef enum {
+    AUDIO_TRANSPORT_SENT,   // 패킷을 다 받음 (이후 span의 메모리는 다시 써도 됨)
+    AUDIO_TRANSPORT_BUSY,   // 지금은 받을 수 없음 (송신 버퍼가 참, 연결 중). 같은 패킷을 나중에 다시
+    AUDIO_TRANSPORT_ERROR,  // 보내지 못함 (연결 끊김 등). BUSY처럼 다시 시도하되 errors로 셈
+} audio_transport_result_t;
+
+// 백엔드: 헤더 + span들을 패킷 하나로 보냄. 막히면 기다리지 않고 BUSY
+typedef struct {
+    const char *name;
+    size_t mtu;  // 헤더 포함 패킷 최대 크기
+    audio_transport_result_t (*send)(void *user, const audio_transport_header_t *header,
+                                     const audio_transport_span_t *spans, size_t count);
+    void *user;
+} audio_transport_backend_t;
+
+typedef struct {
+    uint32_t packets;          // 보낸 패킷 수 (오디오 + 이벤트)
+    uint64_t bytes;            // 보낸 바이트 (헤더 포함)
+    uint32_t samples;          // 보낸 오디오 샘플 수
+    uint32_t busy;             // 백엔드가 받지 못한 횟수
+    uint32_t errors;
+    uint32_t dropped_samples;  // backlog를 넘어서 버린 샘플
+    uint32_t dropped_events;   // 큐가 가득 차서 버린 이벤트
+    uint32_t max_backlog;      // 가장 많이 밀렸던 샘플 수
+} audio_transport_stats_t;
+
+typedef struct {
+    uint8_t kind;              // 내부용 (글자 이벤트, 스트리밍 시작)
+    uint32_t position;
+    char text[AUDIO_TRANSPORT_EVENT_TEXT];
+} audio_transport_event_t;
+
+typedef struct {
+    audio_transport_backend_t backend;
+    const audio_ring_t *ring;
+    size_t packet_samples;     // 꽉 찬 오디오 패킷의 샘플 수
+    uint32_t backlog;          // 밀린 샘플이 이보다 많으면 오래된 것부터 버림
+    uint32_t flush_us;         // 덜 찬 패킷을 보내기 전에 기다리는 최대 시간
+
+    // poll 태스크만
+    bool streaming;
+    uint32_t position;         // 다음에 보낼 샘플
+    bool waiting;              // 덜 찬 패킷을 기다리는 중
+    uint32_t waiting_since_us;
+    bool stopping;
+    uint32_t stop_position;
+    char stop_text[AUDIO_TRANSPORT_EVENT_TEXT];
+    uint32_t sequence;
+    audio_transport_stats_t stats;
+
+    // 이벤트 큐 (event/start 태스크가 head, poll 태스크가 tail)
+    audio_transport_event_t events[AUDIO_TRANSPORT_EVENTS];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+} audio_transport_t;
+
+// backlog: 링 버퍼 용량보다 작게 (poll 사이에 쓰이는 블록만큼 여유)
+void audio_transport_init(audio_transport_t *t, const audio_transport_backend_t *backend, const audio_ring_t *ring,
+                          uint32_t backlog, uint32_t flush_us);
+
+// (event 태스크) position부터 오디오 스트리밍 시작. text가 있으면 시작 이벤트로 먼저 보냄. 큐가 가득 차면 false
+bool audio_transport_start(audio_transport_t *t, uint32_t position, const char *text);
+
+// (event 태스크) 이벤트 하나. position까지의 오디오를 보낸 뒤에 보냄. 큐가 가득 차면 false (dropped_events)
+bool audio_transport_event(audio_transport_t *t, uint32_t position, const char *text);
+
+// (poll 태스크) position 전까지 보내고 스트리밍을 끝냄. text가 있으면 끝 이벤트로 마지막에 보냄
+void audio_transport_stop(audio_transport_t *t, uint32_t position, const char *text);
+
+// (poll 태스크) 보낼 수 있는 만큼 보냄. flush면 덜 찬 패킷도 바로. 반환: 이번에 보낸 패킷 수
+size_t audio_transport_poll(audio_transport_t *t, uint32_t now_us, bool flush);
+
+// 통계 로그 (TRANSPORT_REPORT)
+void audio_transport_report(const audio_transport_t *t);
+
+// (poll 태스크) 스트리밍 중인지 (stop 후 끝 이벤트까지 보내면 false)
+static inline bool audio_transport_streaming(const audio_transport_t *t) {
+    return t->streaming || t->stopping;  // stop 뒤 아직 시작 이벤트를 처리하지 않았어도 true
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_TRANSPORT_H
@@ -0,0 +1,143 @@
+#include "beamformer.h"
+#include <math.h>
+#include <string.h>
+
+#define PI 3.14159265358979f
+#define DOA_MAX_LAG 4
+
+static float sinc(float x) {
+    return fabsf(x) < 1e-6f ? 1.0f : sinf(PI * x) / (PI * x);
+}
+
+void beamformer_init(beamformer_t *bf, int sample_rate, float spacing_mm, float steer_deg) {
+    memset(bf, 0, sizeof(*bf));
+    bf->sample_rate = sample_rate;
+    bf->max_lag = spacing_mm / 1000.0f / BEAM_SPEED_OF_SOUND * sample_rate;
+
+    // 조향 방향에서 온 소리의 도달 시간 차 (샘플). 양수면 오른쪽에 먼저 도착
+    float delay = bf->max_lag * sinf(steer_deg * PI / 180.0f);
+    bf->delay_right = delay > 0;
+    delay = fabsf(delay);
+    if (delay > BEAM_MAX_DELAY) {
+        delay = BEAM_MAX_DELAY;
+    }
+    bf->delay_int = (int)delay;
+    float frac = delay - bf->delay_int;
+
+    // 군지연 (TAPS/2 - 1) + frac 인 windowed sinc (Hann 창), DC 게인 1로 정규화
+    const float center = BEAM_FIR_TAPS / 2 - 1 + frac;
+    float taps[BEAM_FIR_TAPS];
+    float sum = 0;
+    for (int n = 0; n < BEAM_FIR_TAPS; n++) {
+        float window = 0.5f + 0.5f * cosf(PI * (n - center) / (BEAM_FIR_TAPS / 2));
+        taps[n] = sinc(n - center) * window;
+        sum += taps[n];
+    }
+    for (int n = 0; n < BEAM_FIR_TAPS; n++) {
+        bf->taps_q15[n] = (int16_t)lrintf(taps[n] / sum * 32767.0f);
+    }
+}
+
+void beamformer_deinterleave(const int16_t *interleaved, int16_t *left, int16_t *right, size_t frames) {
+    // L/R 한 쌍을 32비트로 읽어서 나눔 (리틀 엔디언: 아래 16비트가 L)
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        uint32_t p0, p1, p2, p3;
+        memcpy(&p0, interleaved + 2 * i, 4);
+        memcpy(&p1, interleaved + 2 * i + 2, 4);
+        memcpy(&p2, interleaved + 2 * i + 4, 4);
+        memcpy(&p3, interleaved + 2 * i + 6, 4);
+        left[i] = (int16_t)p0;
+        right[i] = (int16_t)(p0 >> 16);
+        left[i + 1] = (int16_t)p1;
+        right[i + 1] = (int16_t)(p1 >> 16);
+        left[i + 2] = (int16_t)p2;
+        right[i + 2] = (int16_t)(p2 >> 16);
+        left[i + 3] = (int16_t)p3;
+        right[i + 3] = (int16_t)(p3 >> 16);
+    }
+    for (; i < frames; i++) {
+        left[i] = interleaved[2 * i];
+        right[i] = interleaved[2 * i + 1];
+    }
+}
+
+static void process_chunk(beamformer_t *bf, const int16_t *left, const int16_t *right, int16_t *out, size_t count) {
+    // 앞쪽 BEAM_HISTORY 샘플에는 이전 블록 끝부분이 들어있음 (태스크 스택을 쓰지 않도록 구조체 안에 둠)
+    int16_t *work_left = bf->work_left;
+    int16_t *work_right = bf->work_right;
+    memcpy(work_left + BEAM_HISTORY, left, count * sizeof(int16_t));
+    memcpy(work_right + BEAM_HISTORY, right, count * sizeof(int16_t));
+
+    const int16_t *delayed = bf->delay_right ? work_right : work_left;
+    const int16_t *other = bf->delay_right ? work_left : work_right;
+    const int16_t *taps = bf->taps_q15;
+    const int fixed_delay = BEAM_FIR_TAPS / 2 - 1;
+
+    for (size_t i = 0; i < count; i++) {
+        // 분수 지연 FIR: y[i] = Σ h[n] x[i - n - delay_int]
+        const int16_t *x = delayed + BEAM_HISTORY + i - bf->delay_int;
+        int32_t acc = 1 << 14;
+        for (int n = 0; n < BEAM_FIR_TAPS; n++) {
+            acc += taps[n] * x[-n];
+        }
+        int32_t a = acc >> 15;
+        int32_t b = other[BEAM_HISTORY + i - fixed_delay];
+        out[i] = (int16_t)((a + b + 1) >> 1);
+    }
+
+    memmove(work_left, work_left + count, BEAM_HISTORY * sizeof(int16_t));
+    memmove(work_right, work_right + count, BEAM_HISTORY * sizeof(int16_t));
+}
+
+void beamformer_process(beamformer_t *bf, const int16_t *left, const int16_t *right, int16_t *out, size_t count) {
+    while (count > 0) {
+        size_t chunk = count < BEAM_MAX_BLOCK ? count : BEAM_MAX_BLOCK;
+        process_chunk(bf, left, right, out, chunk);
+        left += chunk;
+        right += chunk;
+        out += chunk;
+        count -= chunk;
+    }
+}
+
+float beamformer_estimate_doa(const beamformer_t *bf, const int16_t *left, const int16_t *right, size_t count) {
+    // R(lag) = Σ left[i] * right[i + lag]. 오른쪽에 먼저 도착하면 left가 늦으므로 음수 lag에서 최대
+    int max_lag = (int)ceilf(bf->max_lag) + 1;
+    if (max_lag > DOA_MAX_LAG) {
+        max_lag = DOA_MAX_LAG;
+    }
+    if (count <= (size_t)(2 * max_lag)) {
+        return 0;
+    }
+
+    int64_t corr[2 * DOA_MAX_LAG + 1];
+    for (int lag = -max_lag; lag <= max_lag; lag++) {
+        int64_t sum = 0;
+        for (size_t i = max_lag; i < count - max_lag; i++) {
+            sum += (int32_t)left[i] * right[i + lag];
+        }
+        corr[lag + max_lag] = sum;
+    }
+
+    int best = 0;
+    for (int i = 1; i <= 2 * max_lag; i++) {
+        if (corr[i] > corr[best]) {
+            best = i;
+        }
+    }
+
+    // 포물선 보간으로 샘플 이하 지연 추정
+    float peak = (float)(best - max_lag);
+    if (best > 0 && best < 2 * max_lag) {
+        float y0 = (float)corr[best - 1], y1 = (float)corr[best], y2 = (float)corr[best + 1];
+        float denom = y0 - 2 * y1 + y2;
+        if (denom < 0) {
+            peak += 0.5f * (y0 - y2) / denom;
+        }
+    }
+
+    float s = -peak / bf->max_lag;
+    s = s > 1 ? 1 : (s < -1 ? -1 : s);
+    return asinf(s) * 180.0f / PI;
+}
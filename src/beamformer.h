@@ -0,0 +1,48 @@
+#ifndef BEAMFORMER_H
+#define BEAMFORMER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// INMP441 두 개(같은 I2S 버스의 L/R 슬롯)를 위한 고정소수점 delay-and-sum 빔포머
+// - 먼저 도착하는 마이크 신호를 분수 지연 FIR(windowed sinc)로 늦춰서 두 신호를 맞춘 뒤 평균
+// - 다른 채널은 FIR의 군지연만큼 정수 지연 → 출력 지연은 BEAM_FIR_TAPS / 2 - 1 샘플
+// - 조향 각도: 마이크를 잇는 선의 수직 방향이 0도, 오른쪽 마이크 쪽이 +90도
+
+#define BEAM_FIR_TAPS   8
+#define BEAM_MAX_DELAY  8     // 최대 정수 지연 (샘플)
+#define BEAM_MAX_BLOCK  512   // 한 번에 처리할 최대 샘플 수 (더 길면 나눠서 처리)
+#define BEAM_HISTORY    (BEAM_FIR_TAPS + BEAM_MAX_DELAY)
+#define BEAM_SPEED_OF_SOUND 343.0f  // m/s
+
+typedef struct {
+    int16_t taps_q15[BEAM_FIR_TAPS];    // 분수 지연 FIR 계수
+    int delay_int;                      // FIR 앞에 추가로 넣는 정수 지연
+    bool delay_right;                   // true면 오른쪽 채널을 늦춤 (소리가 오른쪽에 먼저 도착)
+    int16_t work_left[BEAM_HISTORY + BEAM_MAX_BLOCK];   // 이전 블록 끝부분(BEAM_HISTORY) + 현재 블록
+    int16_t work_right[BEAM_HISTORY + BEAM_MAX_BLOCK];
+    float max_lag;                      // 마이크 간격으로 가능한 최대 도달 시간 차 (샘플)
+    int sample_rate;
+} beamformer_t;
+
+void beamformer_init(beamformer_t *bf, int sample_rate, float spacing_mm, float steer_deg);
+
+// I2S 스테레오 버퍼(L, R, L, R, ...)를 채널별 버퍼로 분리
+void beamformer_deinterleave(const int16_t *interleaved, int16_t *left, int16_t *right, size_t frames);
+
+// 두 채널을 합쳐서 out에 모노 출력 (out은 left나 right와 같은 버퍼여도 됨)
+void beamformer_process(beamformer_t *bf, const int16_t *left, const int16_t *right, int16_t *out, size_t count);
+
+// 두 채널의 상호상관으로 소리가 온 방향(도)을 추정. 소리가 충분히 클 때(VAD가 음성일 때)만 의미 있음
+float beamformer_estimate_doa(const beamformer_t *bf, const int16_t *left, const int16_t *right, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BEAMFORMER_H
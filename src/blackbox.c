@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "uart_link.h"
+#include "blackbox.h"
+
+static const char *TAG = "BLACKBOX";
+
+#define WRITER_PRIORITY 2      // 캡처(10), 추론, 명령(5)보다 낮게
+#define WRITER_POLL_MS 20      // 포스트롤 청크를 기다리는 간격
+
+typedef struct {
+    uint32_t chunk;            // 검출 시점의 캡처 청크 번호
+    uint32_t uptime_ms;
+    int8_t event_class;
+    uint8_t score;
+    char label[BLACKBOX_LABEL_SIZE];
+} trigger_t;
+
+typedef struct {
+    uint32_t chunk;            // 부팅 후 청크 번호
+    blackbox_score_t score;
+} score_entry_t;
+
+static const esp_partition_t *partition;
+static blackbox_log_t log_store;
+static SemaphoreHandle_t log_lock;       // 쓰기 태스크와 BLACKBOX_DUMP
+static QueueHandle_t triggers;
+
+// RAM 링 (캡처 태스크만 씀, 쓰기 태스크는 읽기만)
+static uint8_t *ring;
+static size_t chunk_samples;
+static size_t chunk_bytes;
+static uint32_t ring_chunks;
+static ima_adpcm_state_t encoder;
+static volatile uint32_t captured_chunks;  // 다 쓴 청크 수 (청크를 다 쓴 뒤에 증가)
+
+// 점수 링 (추론 태스크만 씀)
+static score_entry_t scores[BLACKBOX_MAX_SCORES];
+static volatile uint32_t score_count;
+static uint32_t record_end_chunk;         // 이 청크 전의 검출은 지금 기록에 포함됨 (추론 태스크)
+
+static bool flash_read(void *user, uint32_t offset, void *data, size_t size) {
+    return esp_partition_read((const esp_partition_t *)user, offset, data, size) == ESP_OK;
+}
+
+static bool flash_write(void *user, uint32_t offset, const void *data, size_t size) {
+    return esp_partition_write((const esp_partition_t *)user, offset, data, size) == ESP_OK;
+}
+
+static bool flash_erase(void *user, uint32_t offset, size_t size) {
+    // 섹터 하나씩 (erase 동안 캐시가 꺼지므로 한 번에 멈추는 시간을 섹터 하나로)
+    return esp_partition_erase_range((const esp_partition_t *)user, offset, size) == ESP_OK;
+}
+
+static uint8_t to_u8(float score) {
+    return (uint8_t)(score <= 0.0f ? 0 : (score >= 1.0f ? 255 : score * 255.0f + 0.5f));
+}
+
+static const uint8_t *ring_chunk(uint32_t chunk) {
+    return ring + (chunk % ring_chunks) * chunk_bytes;
+}
+
+// 청크 하나가 캡처될 때까지 대기하고 기록에 추가. 링에서 이미 덮어써졌으면 false
+static bool append_chunk(uint32_t chunk) {
+    while (captured_chunks <= chunk) {
+        vTaskDelay(pdMS_TO_TICKS(WRITER_POLL_MS));
+    }
+    if (captured_chunks - chunk >= ring_chunks) {
+        return false;
+    }
+    if (!blackbox_log_append(&log_store, ring_chunk(chunk), chunk_bytes)) {
+        return false;
+    }
+    return captured_chunks - chunk < ring_chunks;  // 복사하는 동안 캡처 태스크가 같은 자리를 쓰기 시작하지 않았는지
+}
+
+static void write_record(const trigger_t *t) {
+    const uint32_t pre = BLACKBOX_CHUNKS(BLACKBOX_PREROLL_MS, chunk_samples);
+    const uint32_t post = BLACKBOX_CHUNKS(BLACKBOX_POSTROLL_MS, chunk_samples);
+    uint32_t first = t->chunk > pre ? t->chunk - pre : 0;
+    uint32_t end = t->chunk + post;
+    int64_t start_us = esp_timer_get_time();
+
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    // 섹터를 먼저 한꺼번에 지움 (그동안 프리롤 청크는 RAM 링에 남아있음)
+    size_t data_size = (end - first) * chunk_bytes + BLACKBOX_MAX_SCORES * sizeof(blackbox_score_t);
+    if (!blackbox_log_begin(&log_store, data_size)) {
+        xSemaphoreGive(log_lock);
+        ESP_LOGW(TAG, "Failed to erase record sectors.");
+        return;
+    }
+    if (captured_chunks - first >= ring_chunks) {
+        first = captured_chunks - ring_chunks + 1;  // 캡처가 막 시작됐거나 erase가 오래 걸림: 남아있는 만큼만
+    }
+    for (uint32_t c = first; c < end; c++) {
+        if (!append_chunk(c)) {
+            blackbox_log_abort(&log_store);
+            xSemaphoreGive(log_lock);
+            ESP_LOGW(TAG, "Record dropped: audio ring overrun (chunk %lu).", (unsigned long)c);
+            return;
+        }
+    }
+
+    // 기록 구간의 점수 타임라인 (추론 태스크는 포스트롤 동안 계속 쓰므로 지금 남아있는 것 중에서)
+    uint16_t score_entries = 0;
+    uint32_t count = score_count;
+    for (uint32_t i = count > BLACKBOX_MAX_SCORES ? count - BLACKBOX_MAX_SCORES : 0; i < count; i++) {
+        const score_entry_t *e = &scores[i % BLACKBOX_MAX_SCORES];
+        if (e->chunk >= first && e->chunk < end) {
+            blackbox_score_t s = e->score;
+            s.chunk = (uint16_t)(e->chunk - first);
+            blackbox_log_append(&log_store, &s, sizeof(s));
+            score_entries++;
+        }
+    }
+
+    blackbox_record_header_t header = {0};
+    header.uptime_ms = t->uptime_ms;
+    header.sample_rate = MODEL_SAMPLE_RATE;
+    header.chunk_samples = (uint16_t)chunk_samples;
+    header.chunks = (uint16_t)(end - first);
+    header.trigger_chunk = (uint16_t)(t->chunk - first);
+    header.scores = score_entries;
+    header.event_class = t->event_class;
+    header.event_score = t->score;
+    memcpy(header.label, t->label, BLACKBOX_LABEL_SIZE);
+    bool ok = blackbox_log_commit(&log_store, &header);
+    xSemaphoreGive(log_lock);
+    if (ok) {
+        ESP_LOGI(TAG, "Record %lu: %s, %u chunks, %lu ms", (unsigned long)header.sequence, header.label,
+                 (unsigned)header.chunks, (unsigned long)((esp_timer_get_time() - start_us) / 1000));
+    } else {
+        ESP_LOGW(TAG, "Failed to write record header.");
+    }
+}
+
+static void writer_task(void *arg) {
+    trigger_t t;
+    while (1) {
+        if (xQueueReceive(triggers, &t, portMAX_DELAY) == pdTRUE) {
+            write_record(&t);
+        }
+    }
+}
+
+bool blackbox_init(size_t samples, uint8_t *ring_buffer, uint8_t *staging) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                         (esp_partition_subtype_t)BLACKBOX_PARTITION_SUBTYPE,
+                                         BLACKBOX_PARTITION_LABEL);
+    if (!partition) {
+        ESP_LOGW(TAG, "Blackbox partition not found.");
+        return false;
+    }
+    blackbox_flash_t flash = {flash_read, flash_write, flash_erase, (void *)partition,
+                              (uint32_t)(partition->size & ~(BLACKBOX_SECTOR_SIZE - 1))};
+    if (!blackbox_log_open(&log_store, &flash, staging)) {
+        ESP_LOGE(TAG, "Blackbox partition too small: %lu bytes", (unsigned long)partition->size);
+        partition = NULL;
+        return false;
+    }
+
+    chunk_samples = samples;
+    chunk_bytes = BLACKBOX_CHUNK_BYTES(samples);
+    ring_chunks = BLACKBOX_RING_CHUNKS(samples);
+    ring = ring_buffer;
+    ima_adpcm_init(&encoder);
+    log_lock = xSemaphoreCreateMutex();
+    triggers = xQueueCreate(1, sizeof(trigger_t));
+    xTaskCreate(writer_task, "blackbox", 3072, NULL, WRITER_PRIORITY, NULL);
+    ESP_LOGI(TAG, "%u records in %lu KB (next sequence %lu).", (unsigned)log_store.count,
+             (unsigned long)(flash.size / 1024), (unsigned long)log_store.next_sequence);
+    return true;
+}
+
+void blackbox_capture(const int16_t *samples, size_t count) {
+    if (!partition) {
+        return;
+    }
+    uint8_t *chunk = ring + (captured_chunks % ring_chunks) * chunk_bytes;
+    size_t n = count < chunk_samples ? count & ~(size_t)1 : chunk_samples;
+    blackbox_chunk_encode(&encoder, samples, n, chunk);
+    // 짧은 블록 (PCM 주입의 마지막 블록): 나머지는 무음으로 채워서 청크 길이를 맞춤
+    static const int16_t silence[32] = {0};
+    for (size_t i = n; i < chunk_samples; i += 32) {
+        size_t part = chunk_samples - i < 32 ? chunk_samples - i : 32;
+        ima_adpcm_encode(&encoder, silence, chunk + BLACKBOX_CHUNK_HEADER + i / 2, part);
+    }
+    captured_chunks = captured_chunks + 1;  // 청크를 다 쓴 뒤에 알림
+}
+
+void blackbox_score(const float *class_scores, size_t num_classes, int detected) {
+    if (!partition || num_classes == 0) {
+        return;
+    }
+    size_t top = 0;
+    for (size_t c = 1; c < num_classes; c++) {
+        if (class_scores[c] > class_scores[top]) {
+            top = c;
+        }
+    }
+    score_entry_t *e = &scores[score_count % BLACKBOX_MAX_SCORES];
+    e->chunk = captured_chunks;
+    e->score.chunk = 0;
+    e->score.top_class = (uint8_t)top;
+    e->score.top_score = to_u8(class_scores[top]);
+    e->score.wake_score = to_u8(class_scores[0]);
+    e->score.detected = (int8_t)detected;
+    score_count = score_count + 1;
+}
+
+void blackbox_trigger(int event_class, const char *label, float score) {
+    if (!partition) {
+        return;
+    }
+    uint32_t chunk = captured_chunks;
+    if (chunk < record_end_chunk) {
+        return;  // 기록 중인 구간 (타임라인의 detected로 남음)
+    }
+    trigger_t t = {0};
+    t.chunk = chunk;
+    t.uptime_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    t.event_class = (int8_t)event_class;
+    t.score = to_u8(score);
+    strncpy(t.label, label, BLACKBOX_LABEL_SIZE - 1);
+    if (xQueueSend(triggers, &t, 0) == pdTRUE) {
+        record_end_chunk = chunk + BLACKBOX_CHUNKS(BLACKBOX_POSTROLL_MS, chunk_samples);
+    }
+}
+
+void blackbox_dump(uint8_t *buffer, size_t size) {
+    char line[64];
+    if (!partition) {
+        uart_link_send_str("BLACKBOX records=0\n");
+        uart_link_send_str("BLACKBOX_END\n");
+        return;
+    }
+    xSemaphoreTake(log_lock, portMAX_DELAY);  // 쓰는 중인 기록이 끝날 때까지 (덤프 중 검출은 기록이 밀릴 수 있음)
+    snprintf(line, sizeof(line), "BLACKBOX records=%u\n", (unsigned)log_store.count);
+    uart_link_send_str(line);
+    for (size_t i = 0; i < log_store.count; i++) {
+        blackbox_record_header_t header;
+        if (!blackbox_log_header(&log_store, i, &header)) {
+            continue;
+        }
+        uint32_t total = sizeof(header) + header.data_size;
+        snprintf(line, sizeof(line), "BLACKBOX_RECORD seq=%lu size=%lu\n", (unsigned long)header.sequence,
+                 (unsigned long)total);
+        uart_link_send_str(line);
+        for (uint32_t offset = 0; offset < total; offset += size) {
+            size_t part = total - offset < size ? total - offset : size;
+            if (!blackbox_log_read(&log_store, i, offset, buffer, part)) {
+                memset(buffer, 0xFF, part);  // 길이는 맞춤 (호스트가 CRC로 확인)
+            }
+            uart_link_send(buffer, part);
+        }
+    }
+    xSemaphoreGive(log_lock);
+    uart_link_send_str("BLACKBOX_END\n");
+}
@@ -0,0 +1,64 @@
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "audio_config.h"
+#include "blackbox_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 블랙박스 기록기 (장치): 검출될 때마다 앞뒤 오디오(ADPCM)와 hop별 점수를 flash 파티션("blackbox")에 저장
+// - 캡처 태스크: 처리된 블록(모델 입력과 같은 오디오)을 ADPCM 청크로 바꿔서 RAM 링에만 씀 (flash 접근 없음)
+// - 추론 태스크: hop마다 점수, 검출 시 blackbox_trigger()는 큐에 넣기만 함
+// - 쓰기 태스크(낮은 우선순위): 섹터를 한꺼번에 지우고, 프리롤부터 RAM 링의 청크를 섹터 단위로 모아서 씀.
+//   포스트롤은 캡처되는 대로 이어서 쓰고, 끝나면 점수 타임라인과 헤더를 씀
+// - RAM 링은 프리롤 + BLACKBOX_SLACK_MS (erase하는 동안 밀리는 만큼). 쓰기가 링보다 늦어지면 그 기록은 버림
+// - 기록 중에 다시 검출되면 새 기록을 만들지 않고 타임라인의 detected로 남음
+// UART BLACKBOX_DUMP: 모든 기록을 한 번에 보냄 (scripts/blackbox_dump.py가 WAV + 점수 CSV로 저장)
+
+#define BLACKBOX_PARTITION_LABEL   "blackbox"
+#define BLACKBOX_PARTITION_SUBTYPE 0x41  // partitions.csv의 SubType과 동일
+
+#ifndef BLACKBOX_PREROLL_MS
+#define BLACKBOX_PREROLL_MS 2000  // 검출 전
+#endif
+#ifndef BLACKBOX_POSTROLL_MS
+#define BLACKBOX_POSTROLL_MS 1000  // 검출 후
+#endif
+#ifndef BLACKBOX_SLACK_MS
+#define BLACKBOX_SLACK_MS 1000  // RAM 링 여유 (섹터를 지우는 동안 쓰기 태스크가 밀리는 시간)
+#endif
+#define BLACKBOX_MAX_SCORES 64  // 점수 링 (프리롤 + 포스트롤의 hop 수보다 커야 함)
+
+// chunk_samples 샘플 청크로 ms를 덮는 청크 수
+#define BLACKBOX_CHUNKS(ms, chunk_samples) \
+    (((uint32_t)(ms) * MODEL_SAMPLE_RATE / 1000 + (chunk_samples) - 1) / (chunk_samples))
+#define BLACKBOX_RING_CHUNKS(chunk_samples) (BLACKBOX_CHUNKS(BLACKBOX_PREROLL_MS + BLACKBOX_SLACK_MS, chunk_samples) + 1)
+#define BLACKBOX_RING_BYTES(chunk_samples) (BLACKBOX_RING_CHUNKS(chunk_samples) * BLACKBOX_CHUNK_BYTES(chunk_samples))
+
+// 파티션을 찾아 색인을 만들고 쓰기 태스크를 시작 (ring: BLACKBOX_RING_BYTES, staging: BLACKBOX_SECTOR_SIZE)
+// 파티션이 없으면 false (이후 호출은 아무것도 하지 않음)
+bool blackbox_init(size_t chunk_samples, uint8_t *ring, uint8_t *staging);
+
+// 캡처 태스크: 블록 하나 (chunk_samples 이하, 모자라면 무음으로 채움)
+void blackbox_capture(const int16_t *samples, size_t count);
+
+// 추론 태스크: hop마다 클래스별 점수 (0~1)와 검출 결과 (없으면 -1)
+void blackbox_score(const float *scores, size_t num_classes, int detected);
+
+// 추론 태스크: 검출 (event_class: 호출어/명령어 클래스, 소리 이벤트면 -1)
+void blackbox_trigger(int event_class, const char *label, float score);
+
+// 명령 태스크: "BLACKBOX records=N" 뒤에 기록마다 "BLACKBOX_RECORD seq=.. size=.." 줄과 기록 바이트, 끝에 "BLACKBOX_END"
+// buffer는 flash에서 읽어 보낼 임시 버퍼
+void blackbox_dump(uint8_t *buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLACKBOX_H
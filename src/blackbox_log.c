@@ -0,0 +1,278 @@
+#include <string.h>
+#include "blackbox_log.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_rom_crc.h"
+#endif
+
+#define HEADER_SIZE sizeof(blackbox_record_header_t)
+_Static_assert(sizeof(blackbox_record_header_t) == 64, "record header layout (scripts/blackbox_dump.py)");
+_Static_assert(sizeof(blackbox_score_t) == 6, "score entry layout (scripts/blackbox_dump.py)");
+
+uint32_t blackbox_crc32(uint32_t crc, const void *data, size_t size) {
+#ifdef ESP_PLATFORM
+    return esp_rom_crc32_le(crc, (const uint8_t *)data, size);
+#else
+    // esp_rom_crc32_le와 같은 결과 (zlib.crc32). 호스트 검증용이라 테이블 없이
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++) {
+            crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+    }
+    return ~crc;
+#endif
+}
+
+static uint16_t sectors_for(size_t data_size) {
+    return (uint16_t)((HEADER_SIZE + data_size + BLACKBOX_SECTOR_SIZE - 1) / BLACKBOX_SECTOR_SIZE);
+}
+
+static bool header_valid(const blackbox_log_t *log, const blackbox_record_header_t *h) {
+    if (h->magic != BLACKBOX_MAGIC || h->version != BLACKBOX_VERSION || h->header_size != HEADER_SIZE) {
+        return false;
+    }
+    if (h->data_size > (uint32_t)log->sectors * BLACKBOX_SECTOR_SIZE || sectors_for(h->data_size) > log->sectors) {
+        return false;
+    }
+    return blackbox_crc32(0, h, offsetof(blackbox_record_header_t, header_crc32)) == h->header_crc32;
+}
+
+// 원형으로 본 섹터 구간 [a, a + n), [b, b + m)이 겹치는지
+static bool ranges_overlap(uint16_t total, uint16_t a, uint16_t n, uint16_t b, uint16_t m) {
+    return (uint16_t)((b + total - a) % total) < n || (uint16_t)((a + total - b) % total) < m;
+}
+
+// 기록 시작 섹터에서 offset만큼 떨어진 파티션 위치 (기록은 파티션 끝에서 처음으로 이어짐)
+static uint32_t physical_offset(const blackbox_log_t *log, uint16_t sector, uint32_t offset) {
+    uint32_t s = (sector + offset / BLACKBOX_SECTOR_SIZE) % log->sectors;
+    return s * BLACKBOX_SECTOR_SIZE + offset % BLACKBOX_SECTOR_SIZE;
+}
+
+static void index_remove(blackbox_log_t *log, size_t i) {
+    memmove(&log->index[i], &log->index[i + 1], (log->count - i - 1) * sizeof(log->index[0]));
+    log->count--;
+}
+
+// [sector, sector + sectors)와 (원형으로) 겹치는 기록을 색인에서 뺌 (곧 지워질 섹터)
+static void index_evict(blackbox_log_t *log, uint16_t sector, uint16_t sectors) {
+    for (size_t i = 0; i < log->count;) {
+        const blackbox_entry_t *e = &log->index[i];
+        if (ranges_overlap(log->sectors, sector, sectors, e->sector, e->sectors)) {
+            index_remove(log, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+// sequence 순서로 끼워 넣음 (가득 차 있으면 가장 오래된 것을 버림)
+static void index_insert(blackbox_log_t *log, const blackbox_entry_t *entry) {
+    if (log->count == BLACKBOX_LOG_MAX_RECORDS) {
+        if (entry->sequence < log->index[0].sequence) {
+            return;
+        }
+        index_remove(log, 0);
+    }
+    size_t i = log->count;
+    while (i > 0 && log->index[i - 1].sequence > entry->sequence) {
+        log->index[i] = log->index[i - 1];
+        i--;
+    }
+    log->index[i] = *entry;
+    log->count++;
+}
+
+bool blackbox_log_open(blackbox_log_t *log, const blackbox_flash_t *flash, uint8_t *staging) {
+    memset(log, 0, sizeof(*log));
+    log->flash = *flash;
+    log->staging = staging;
+    uint32_t sectors = flash->size / BLACKBOX_SECTOR_SIZE;
+    if (sectors < 2 || sectors > UINT16_MAX) {
+        return false;
+    }
+    log->sectors = (uint16_t)sectors;
+
+    // 섹터 시작마다 헤더 확인 (지워진 기록의 남은 섹터는 헤더가 없으므로 건너뜀)
+    for (uint16_t s = 0; s < log->sectors; s++) {
+        blackbox_record_header_t h;
+        if (!flash->read(flash->user, (uint32_t)s * BLACKBOX_SECTOR_SIZE, &h, sizeof(h)) || !header_valid(log, &h)) {
+            continue;
+        }
+        blackbox_entry_t entry = {h.sequence, s, sectors_for(h.data_size)};
+        index_insert(log, &entry);
+    }
+
+    // 겹치는 기록이 있으면 (정상적으로는 없음) 새 기록을 남김
+    for (size_t i = log->count; i-- > 1;) {
+        for (size_t j = i; j-- > 0;) {
+            const blackbox_entry_t *newer = &log->index[i], *older = &log->index[j];
+            if (ranges_overlap(log->sectors, newer->sector, newer->sectors, older->sector, older->sectors)) {
+                index_remove(log, j);
+                i--;
+            }
+        }
+    }
+
+    log->next_sequence = 1;
+    if (log->count > 0) {
+        const blackbox_entry_t *newest = &log->index[log->count - 1];
+        log->next_sequence = newest->sequence + 1;
+        log->head = (newest->sector + newest->sectors) % log->sectors;
+    }
+    return true;
+}
+
+bool blackbox_log_begin(blackbox_log_t *log, size_t data_size) {
+    if (log->writing) {
+        blackbox_log_abort(log);
+    }
+    uint16_t sectors = sectors_for(data_size);
+    if (data_size > (size_t)log->sectors * BLACKBOX_SECTOR_SIZE || sectors > log->sectors) {
+        return false;
+    }
+    // 파티션 끝에 닿으면 처음으로 이어서 씀 (끝에 남는 섹터 없이 모든 섹터를 같은 횟수로 지움)
+    uint16_t start = log->head;
+
+    // 필요한 섹터를 먼저 전부 지움 (이후 program만)
+    index_evict(log, start, sectors);
+    for (uint16_t s = 0; s < sectors; s++) {
+        if (!log->flash.erase(log->flash.user, physical_offset(log, start, (uint32_t)s * BLACKBOX_SECTOR_SIZE),
+                              BLACKBOX_SECTOR_SIZE)) {
+            return false;
+        }
+    }
+
+    log->writing = true;
+    log->write_sector = start;
+    log->write_sectors = sectors;
+    log->write_size = 0;
+    log->write_crc = 0;
+    log->staged = HEADER_SIZE;  // 첫 섹터의 헤더 자리는 비워둠 (commit에서)
+    log->staged_offset = 0;
+    return true;
+}
+
+// staging에 쌓인 부분을 program (첫 섹터는 헤더 자리 이후만)
+static bool flush_staging(blackbox_log_t *log) {
+    size_t from = log->staged_offset == 0 ? HEADER_SIZE : 0;
+    uint32_t offset = physical_offset(log, log->write_sector, log->staged_offset);
+    if (log->staged > from &&
+        !log->flash.write(log->flash.user, offset + from, log->staging + from, log->staged - from)) {
+        return false;
+    }
+    return true;
+}
+
+bool blackbox_log_append(blackbox_log_t *log, const void *data, size_t size) {
+    if (!log->writing ||
+        HEADER_SIZE + log->write_size + size > (size_t)log->write_sectors * BLACKBOX_SECTOR_SIZE) {
+        return false;
+    }
+    log->write_crc = blackbox_crc32(log->write_crc, data, size);
+    log->write_size += size;
+    const uint8_t *p = (const uint8_t *)data;
+    while (size > 0) {
+        size_t part = BLACKBOX_SECTOR_SIZE - log->staged;
+        if (part > size) {
+            part = size;
+        }
+        memcpy(log->staging + log->staged, p, part);
+        log->staged += part;
+        p += part;
+        size -= part;
+        if (log->staged == BLACKBOX_SECTOR_SIZE) {
+            if (!flush_staging(log)) {
+                blackbox_log_abort(log);
+                return false;
+            }
+            log->staged_offset += BLACKBOX_SECTOR_SIZE;
+            log->staged = 0;
+        }
+    }
+    return true;
+}
+
+bool blackbox_log_commit(blackbox_log_t *log, blackbox_record_header_t *header) {
+    if (!log->writing) {
+        return false;
+    }
+    if (!flush_staging(log)) {
+        blackbox_log_abort(log);
+        return false;
+    }
+
+    header->magic = BLACKBOX_MAGIC;
+    header->version = BLACKBOX_VERSION;
+    header->header_size = HEADER_SIZE;
+    header->sequence = log->next_sequence;
+    header->data_size = log->write_size;
+    header->data_crc32 = log->write_crc;
+    header->header_crc32 = blackbox_crc32(0, header, offsetof(blackbox_record_header_t, header_crc32));
+    log->writing = false;
+    if (!log->flash.write(log->flash.user, (uint32_t)log->write_sector * BLACKBOX_SECTOR_SIZE, header, HEADER_SIZE)) {
+        return false;
+    }
+
+    // 실제로 쓴 만큼만 차지 (begin에서 더 지운 섹터는 다음 기록이 다시 지우고 씀)
+    blackbox_entry_t entry = {log->next_sequence, log->write_sector, sectors_for(log->write_size)};
+    index_insert(log, &entry);
+    log->next_sequence++;
+    log->head = (entry.sector + entry.sectors) % log->sectors;
+    return true;
+}
+
+void blackbox_log_abort(blackbox_log_t *log) {
+    log->writing = false;
+}
+
+bool blackbox_log_header(const blackbox_log_t *log, size_t i, blackbox_record_header_t *header) {
+    if (i >= log->count) {
+        return false;
+    }
+    const blackbox_entry_t *e = &log->index[i];
+    return log->flash.read(log->flash.user, (uint32_t)e->sector * BLACKBOX_SECTOR_SIZE, header, HEADER_SIZE) &&
+           header_valid(log, header) && header->sequence == e->sequence;
+}
+
+bool blackbox_log_read(const blackbox_log_t *log, size_t i, uint32_t offset, void *data, size_t size) {
+    if (i >= log->count) {
+        return false;
+    }
+    const blackbox_entry_t *e = &log->index[i];
+    if ((size_t)offset + size > (size_t)e->sectors * BLACKBOX_SECTOR_SIZE) {
+        return false;
+    }
+    // 섹터 단위로 나눠 읽음 (파티션 끝에서 이어지는 기록)
+    uint8_t *p = (uint8_t *)data;
+    while (size > 0) {
+        size_t part = BLACKBOX_SECTOR_SIZE - offset % BLACKBOX_SECTOR_SIZE;
+        if (part > size) {
+            part = size;
+        }
+        if (!log->flash.read(log->flash.user, physical_offset(log, e->sector, offset), p, part)) {
+            return false;
+        }
+        p += part;
+        offset += part;
+        size -= part;
+    }
+    return true;
+}
+
+void blackbox_chunk_encode(ima_adpcm_state_t *state, const int16_t *samples, size_t count, uint8_t *chunk) {
+    chunk[0] = (uint8_t)(state->predictor & 0xFF);
+    chunk[1] = (uint8_t)((uint16_t)state->predictor >> 8);
+    chunk[2] = state->index;
+    chunk[3] = 0;
+    ima_adpcm_encode(state, samples, chunk + BLACKBOX_CHUNK_HEADER, count);
+}
+
+void blackbox_chunk_decode(const uint8_t *chunk, size_t count, int16_t *samples) {
+    ima_adpcm_state_t state;
+    state.predictor = (int16_t)(chunk[0] | (chunk[1] << 8));
+    state.index = chunk[2] > 88 ? 88 : chunk[2];
+    ima_adpcm_decode(&state, chunk + BLACKBOX_CHUNK_HEADER, samples, count);
+}
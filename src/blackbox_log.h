@@ -0,0 +1,126 @@
+#ifndef BLACKBOX_LOG_H
+#define BLACKBOX_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ima_adpcm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 블랙박스 로그: flash 파티션("blackbox")을 원형으로 쓰는 검출 기록 저장소 (플랫폼 독립, flash 접근은 함수 포인터)
+// - 기록 하나 = 섹터 경계에서 시작하는 연속 섹터. [헤더 64바이트][ADPCM 청크들][점수 타임라인]
+// - 기록은 바로 앞 기록 뒤에 이어서 쓰고, 파티션 끝에 닿으면 처음으로 이어짐 (기록 하나가 끝과 처음에 걸칠 수 있음).
+//   가장 오래된 기록부터 지워지고 모든 섹터를 같은 순서로 돌아가며 지우므로 따로 wear leveling 테이블이 필요 없음
+// - 쓰기 순서: 필요한 섹터를 먼저 한꺼번에 지우고 → 데이터를 섹터 단위로 모아서 program → 헤더는 마지막에.
+//   헤더(CRC 포함)가 없으면 기록이 아니므로 쓰는 중에 전원이 나가도 반쯤 쓴 기록을 읽을 일이 없음
+// - 부팅 시 섹터 시작마다 헤더를 찾아 sequence 순서로 색인을 만듦 (RAM에는 색인만)
+// 장치 쪽(파티션, 캡처 링, 쓰기 태스크)은 blackbox.c, 호스트 검증: host/verify_blackbox.c
+// 형식을 바꾸면 scripts/blackbox_dump.py도 같이 수정해주세요.
+
+#define BLACKBOX_SECTOR_SIZE      4096
+#define BLACKBOX_MAGIC            0x31584242  // "BBX1"
+#define BLACKBOX_VERSION          1
+#define BLACKBOX_LABEL_SIZE       24
+#define BLACKBOX_CHUNK_HEADER     4           // 청크 앞 ADPCM 상태 (predictor int16, index, 0)
+#define BLACKBOX_LOG_MAX_RECORDS  128         // 색인 크기 (넘으면 가장 오래된 기록부터 색인에서 빠짐)
+#define BLACKBOX_CHUNK_BYTES(chunk_samples) (BLACKBOX_CHUNK_HEADER + ((chunk_samples) + 1) / 2)  // 상태 + ADPCM
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;       // sizeof(blackbox_record_header_t)
+    uint32_t sequence;          // 기록할 때마다 증가 (부팅 후에도 이어짐)
+    uint32_t data_size;         // 헤더 뒤 데이터 크기
+    uint32_t data_crc32;
+    uint32_t uptime_ms;         // 검출 시각 (부팅 후)
+    uint16_t sample_rate;
+    uint16_t chunk_samples;     // 청크 하나의 샘플 수 (캡처 블록)
+    uint16_t chunks;            // 오디오 청크 수
+    uint16_t trigger_chunk;     // 검출된 청크 (이전은 프리롤)
+    uint16_t scores;            // 타임라인 항목 수 (청크 뒤)
+    int8_t event_class;         // 검출 클래스 (소리 이벤트면 -1)
+    uint8_t event_score;        // 0~255
+    char label[BLACKBOX_LABEL_SIZE];  // 검출 라벨 (NUL 종료)
+    uint32_t header_crc32;      // 이 필드 앞까지
+} blackbox_record_header_t;
+
+// 추론 hop 하나의 점수 (타임라인)
+typedef struct __attribute__((packed)) {
+    uint16_t chunk;             // 기록 안의 청크 위치 (× chunk_samples = 샘플 위치)
+    uint8_t top_class;          // 가장 높은 클래스
+    uint8_t top_score;          // 0~255
+    uint8_t wake_score;         // 호출어 클래스 점수 0~255
+    int8_t detected;            // 이 hop에 검출된 클래스, 없으면 -1
+} blackbox_score_t;
+
+// flash 접근 (offset은 파티션 안 위치, erase는 섹터 단위)
+typedef struct {
+    bool (*read)(void *user, uint32_t offset, void *data, size_t size);
+    bool (*write)(void *user, uint32_t offset, const void *data, size_t size);
+    bool (*erase)(void *user, uint32_t offset, size_t size);
+    void *user;
+    uint32_t size;              // 파티션 크기 (섹터 배수로 내림)
+} blackbox_flash_t;
+
+typedef struct {
+    uint32_t sequence;
+    uint16_t sector;            // 시작 섹터
+    uint16_t sectors;           // 파티션 끝을 넘으면 0번 섹터부터 이어짐
+} blackbox_entry_t;
+
+typedef struct {
+    blackbox_flash_t flash;
+    uint16_t sectors;
+    blackbox_entry_t index[BLACKBOX_LOG_MAX_RECORDS];  // 오래된 것부터
+    uint16_t count;
+    uint16_t head;              // 다음 기록 시작 섹터
+    uint32_t next_sequence;
+
+    // 쓰는 중인 기록
+    bool writing;
+    uint16_t write_sector;
+    uint16_t write_sectors;     // 지운 섹터 수
+    uint32_t write_size;        // 헤더 뒤로 쓴 바이트
+    uint32_t write_crc;
+    uint8_t *staging;           // 섹터 하나 (program은 섹터 단위로 모아서)
+    size_t staged;              // staging에 쌓인 바이트 (섹터 안 위치)
+    uint32_t staged_offset;     // staging 섹터의 기록 안 위치 (헤더 포함)
+} blackbox_log_t;
+
+// 색인 만들기 (staging: BLACKBOX_SECTOR_SIZE 바이트, 쓰기용). flash가 너무 작으면 false
+bool blackbox_log_open(blackbox_log_t *log, const blackbox_flash_t *flash, uint8_t *staging);
+
+// 새 기록 시작: 헤더 + data_size 바이트에 필요한 섹터를 한꺼번에 지움 (겹치는 오래된 기록은 색인에서 뺌)
+bool blackbox_log_begin(blackbox_log_t *log, size_t data_size);
+
+// 데이터 추가 (begin의 data_size까지). 섹터가 찰 때마다 program
+bool blackbox_log_append(blackbox_log_t *log, const void *data, size_t size);
+
+// 남은 데이터를 쓰고 헤더를 마지막에 씀. header의 magic/version/sequence/크기/CRC는 여기서 채움
+bool blackbox_log_commit(blackbox_log_t *log, blackbox_record_header_t *header);
+
+// 쓰던 기록 버리기 (헤더를 쓰지 않았으므로 flash에는 기록이 없는 것과 같음)
+void blackbox_log_abort(blackbox_log_t *log);
+
+// i번째 기록 (0 = 가장 오래된 것)의 헤더. CRC가 맞지 않으면 false
+bool blackbox_log_header(const blackbox_log_t *log, size_t i, blackbox_record_header_t *header);
+
+// i번째 기록의 offset(헤더 포함 기록 시작 기준)부터 size 바이트
+bool blackbox_log_read(const blackbox_log_t *log, size_t i, uint32_t offset, void *data, size_t size);
+
+// 샘플 → 청크 (state는 이어지는 청크 사이에 유지)
+void blackbox_chunk_encode(ima_adpcm_state_t *state, const int16_t *samples, size_t count, uint8_t *chunk);
+
+// 청크 → 샘플 (청크 앞의 상태부터 디코딩하므로 청크 하나만으로 복원)
+void blackbox_chunk_decode(const uint8_t *chunk, size_t count, int16_t *samples);
+
+uint32_t blackbox_crc32(uint32_t crc, const void *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLACKBOX_LOG_H
@@ -0,0 +1,76 @@
+#include <stdbool.h>
+#include "boot_profile.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "BOOT";
+static portMUX_TYPE profile_lock = portMUX_INITIALIZER_UNLOCKED;
+#define PROFILE_LOCK()   portENTER_CRITICAL(&profile_lock)
+#define PROFILE_UNLOCK() portEXIT_CRITICAL(&profile_lock)
+#else
+#include <stdio.h>
+#include <time.h>
+#define PROFILE_LOCK()
+#define PROFILE_UNLOCK()
+#endif
+
+typedef struct {
+    const char *phase;
+    int64_t time_us;
+} mark_t;
+
+static mark_t marks[BOOT_PROFILE_MAX_PHASES];
+static int mark_count;
+static bool closed;
+
+int64_t boot_profile_now_us(void) {
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    static int64_t origin = -1;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t now = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    if (origin < 0) {
+        origin = now;
+    }
+    return now - origin;
+#endif
+}
+
+void boot_profile_mark(const char *phase) {
+    int64_t now = boot_profile_now_us();
+    PROFILE_LOCK();
+    if (!closed && mark_count < BOOT_PROFILE_MAX_PHASES) {
+        marks[mark_count].phase = phase;
+        marks[mark_count].time_us = now;
+        mark_count++;
+    }
+    PROFILE_UNLOCK();
+}
+
+void boot_profile_report(void) {
+    PROFILE_LOCK();
+    closed = true;
+    PROFILE_UNLOCK();
+
+#ifdef ESP_PLATFORM
+    ESP_LOGI(TAG, "Reset reason %d, boot phases (ms since app start):", (int)esp_reset_reason());
+#else
+    printf("Boot phases (ms since first mark):\n");
+#endif
+    int64_t previous = 0;
+    for (int i = 0; i < mark_count; i++) {
+        int64_t t = marks[i].time_us;
+#ifdef ESP_PLATFORM
+        ESP_LOGI(TAG, "  %8.2f  +%7.2f  %s", t / 1000.0, (t - previous) / 1000.0, marks[i].phase);
+#else
+        printf("  %8.3f  +%7.3f  %s\n", t / 1000.0, (t - previous) / 1000.0, marks[i].phase);
+#endif
+        previous = t;
+    }
+}
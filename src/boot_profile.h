@@ -0,0 +1,29 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 부팅 단계별 시간 기록 (리셋 → 첫 추론까지 어디에 시간이 드는지)
+// - ESP32: esp_timer 기준 (앱 시작 직후부터, 2단계 부트로더 시간은 제외), 호스트: 첫 기록 기준
+// - 여러 태스크에서 기록해도 됩니다. boot_profile_report() 이후의 기록은 무시 (모델 교체 등 부팅 뒤 재초기화)
+
+#define BOOT_PROFILE_MAX_PHASES 24
+
+// phase는 문자열 상수여야 함 (포인터만 저장)
+void boot_profile_mark(const char *phase);
+
+// 지금까지의 시간 (us)
+int64_t boot_profile_now_us(void);
+
+// 단계별 시각과 이전 단계와의 차이를 로그로 출력하고 기록을 닫음
+void boot_profile_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_PROFILE_H
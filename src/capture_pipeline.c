@@ -0,0 +1,47 @@
+#include "capture_pipeline.h"
+
+void capture_pipeline_init(capture_pipeline_t *p) {
+    audio_conditioning_config_t conditioning_config;
+    audio_conditioning_default_config(&conditioning_config);
+    audio_conditioning_init(&p->conditioning, &conditioning_config);
+    energy_vad_init(&p->vad);
+    noise_suppressor_config_t suppressor_config;
+    noise_suppressor_default_config(&suppressor_config, MODEL_SAMPLE_RATE);
+    audio_frontend_init(&p->frontend);
+    noise_suppressor_init(&p->suppressor, &suppressor_config);
+    decimator_init(&p->decimator);
+    p->hop_hook = NULL;
+    p->hop_hook_user = NULL;
+}
+
+size_t capture_pipeline_process(capture_pipeline_t *p, int16_t *block, size_t count, bool *speech) {
+#if MODEL_DECIMATION > 1
+    // 16kHz → 8kHz (이후 전처리, 잡음 제거, 추론이 모두 절반의 샘플로 동작)
+    count = decimator_process(&p->decimator, block, count, block);
+#endif
+
+    // 전처리 → 잡음 제거 (모델 입력과 UART 스트리밍 모두 같은 오디오)
+    audio_conditioning_process(&p->conditioning, block, count);
+
+    // 배경 소음 레벨은 항상 추적해둠 (캡처 시작 시점에 이미 소음 레벨을 알고 있도록)
+    // 잡음 제거 전 오디오로 판단해야 잡음 추정이 음성 구간에서 멈춤
+    *speech = energy_vad_process(&p->vad, block, count);
+
+    if (NOISE_SUPPRESSION || p->hop_hook) {
+        // hop(16ms)마다 분석 → bin별 게인 → 합성 (출력은 FRONTEND_HOP 샘플 늦음)
+        // 잡음 제거 없이 빌드해도 hop_hook(특징 스트림)이 있으면 분석만 하고 오디오는 그대로 둠
+        for (size_t offset = 0; offset + FRONTEND_HOP <= count; offset += FRONTEND_HOP) {
+            audio_frontend_analyze(&p->frontend, block + offset);
+            if (NOISE_SUPPRESSION) {
+                noise_suppressor_apply(&p->suppressor, &p->frontend, *speech);
+            }
+            if (p->hop_hook) {
+                p->hop_hook(p->hop_hook_user, &p->frontend);
+            }
+            if (NOISE_SUPPRESSION) {
+                audio_frontend_synthesize(&p->frontend, block + offset);
+            }
+        }
+    }
+    return count;
+}
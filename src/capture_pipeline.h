@@ -0,0 +1,45 @@
+#ifndef CAPTURE_PIPELINE_H
+#define CAPTURE_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "audio_config.h"
+#include "audio_conditioning.h"
+#include "energy_vad.h"
+#include "audio_frontend.h"
+#include "noise_suppressor.h"
+#include "decimator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 캡처 블록 신호 처리 (마이크 입력 → 링 버퍼에 쓰기 직전까지)
+// (데시메이션) → 전처리(DC 제거, 프리엠퍼시스, AGC) → VAD → 잡음 제거
+// wake_word.cpp 캡처 태스크, PCM 주입, 호스트 시뮬레이터(host/sim_wake_word.c)가 같은 코드를 써서
+// 같은 입력이면 모델 입력이 비트 단위로 같습니다.
+typedef struct {
+    audio_conditioning_t conditioning;
+    energy_vad_t vad;
+    audio_frontend_t frontend;
+    noise_suppressor_t suppressor;
+    decimator_t decimator;  // MODEL_DECIMATION > 1일 때만 사용
+    // STFT hop마다 합성 직전(잡음 제거된 스펙트럼)에 호출, init이 NULL로
+    // (특징 스트림: wake_word.cpp → sound_events, 호스트 골든 벡터 기록)
+    void (*hop_hook)(void *user, const audio_frontend_t *frontend);
+    void *hop_hook_user;
+} capture_pipeline_t;
+
+// 기본 설정으로 초기화 (모든 상태를 처음으로)
+void capture_pipeline_init(capture_pipeline_t *p);
+
+// block: I2S_SAMPLE_RATE 모노 count 샘플을 제자리에서 처리해서 MODEL_SAMPLE_RATE 샘플로 바꾸고 그 개수를 반환
+// count는 FRONTEND_HOP * MODEL_DECIMATION의 배수여야 끝까지 잡음 제거됨. speech: 이 블록의 VAD 결과
+size_t capture_pipeline_process(capture_pipeline_t *p, int16_t *block, size_t count, bool *speech);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CAPTURE_PIPELINE_H
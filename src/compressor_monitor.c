@@ -0,0 +1,306 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "compressor_monitor.h"
+#include "dsp_tables.h"
+#include "fft_q15.h"
+
+#define FRAMES_PER_PERIOD ((uint32_t)COMPRESSOR_PERIOD_S * COMPRESSOR_RATE / COMPRESSOR_HOP)
+#define BIN_HZ ((float)COMPRESSOR_RATE / COMPRESSOR_FFT_SIZE)
+#define F0_MIN_HZ 40.0f             // 기본 주파수 탐색 범위 (50/60Hz 모터, 인버터 컴프레서 저속)
+#define F0_MAX_HZ 130.0f
+#define TONE_MIN_DB 6.0f            // 주변 bin 평균보다 이만큼 커야 톤으로 봄
+#define ON_THRESHOLD_DB 6.0f        // 꺼짐 레벨보다 이만큼 크면 켜짐
+#define OFF_THRESHOLD_DB 3.0f       // 켜진 뒤에는 이만큼 아래로 내려가야 꺼짐 (히스테리시스)
+#define STATE_DEBOUNCE_FRAMES 8     // 상태가 바뀐 뒤 이만큼(약 1초) 계속되어야 인정
+#define FLOOR_RISE_DB (1.0f / (60.0f * COMPRESSOR_RATE / COMPRESSOR_HOP))  // 꺼짐 레벨이 올라가는 속도 (분당 1dB)
+#define TRANSIENT_DB 10.0f          // 전체 대역 레벨이 평균보다 이만큼 크면 통계에서 뺌
+#define LEVEL_EMA 0.015625f         // 전체 대역 레벨 평균 (1/64, 약 8초)
+#define MIN_FEATURE_FRAMES (FRAMES_PER_PERIOD / 4)  // 켜져 있던 프레임이 이만큼은 되어야 주기 평균으로 인정 (켜짐/꺼짐 경계 제외)
+
+static const uint16_t band_edges_hz[COMPRESSOR_BANDS] = {20, 50, 100, 200, 400, 800};  // 마지막 대역은 I2S 전체
+
+// 기준 표준편차 하한 (너무 안정적인 항목이 작은 변화에도 표시되지 않도록)
+static float min_spread(int feature) {
+    switch (feature) {
+        case COMPRESSOR_FEATURE_DUTY: return 0.03f;
+        case COMPRESSOR_FEATURE_F0: return 0.5f;
+        case COMPRESSOR_FEATURE_H2:
+        case COMPRESSOR_FEATURE_H3: return 1.5f;
+        default: return 1.0f;  // 대역 에너지 dB
+    }
+}
+
+static void welford_add(welford_t *w, float x) {
+    w->count++;
+    float d = x - w->mean;
+    w->mean += d / w->count;
+    w->m2 += d * (x - w->mean);
+}
+
+static float welford_std(const welford_t *w) {
+    return w->count > 1 ? sqrtf(w->m2 / w->count) : 0.0f;
+}
+
+void compressor_monitor_init(compressor_monitor_t *m) {
+    memset(m, 0, sizeof(*m));
+    for (int s = 0; s < COMPRESSOR_DECIMATION_STAGES; s++) {
+        decimator_init(&m->stages[s]);
+    }
+    m->floor_db = NAN;
+    m->level_ema_db = NAN;
+}
+
+// 현재 spectrum의 bin k 파워 (scale = 2^(2 * exponent))
+static inline float bin_power(const int16_t *spectrum, int k, float scale) {
+    int32_t re = spectrum[2 * k], im = spectrum[2 * k + 1];
+    return ((float)(uint32_t)(re * re) + (float)(uint32_t)(im * im)) * scale;
+}
+
+static inline float to_db(float power) {
+    return 10.0f * log10f(power + 1e-12f);
+}
+
+static void analyze_frame(compressor_monitor_t *m) {
+    // 창 + FFT (audio_frontend_analyze와 같이 작은 소리도 정밀도를 잃지 않도록 키워서)
+    int32_t peak = 0;
+    for (int i = 0; i < COMPRESSOR_FFT_SIZE; i++) {
+        peak |= m->frame[i] < 0 ? -m->frame[i] : m->frame[i];
+    }
+    int input_shift = 0;
+    while (peak != 0 && (peak << (input_shift + 1)) < 16384) {
+        input_shift++;
+    }
+    for (int i = 0; i < COMPRESSOR_FFT_SIZE; i++) {
+        m->spectrum[2 * i] = (int16_t)((((int32_t)m->frame[i] << input_shift) * dsp_window.q15[i]) >> 15);
+        m->spectrum[2 * i + 1] = 0;
+    }
+    int exponent = fft_q15(m->spectrum, FRONTEND_FFT_LOG2, dsp_twiddle.q15) - input_shift;
+    const float scale = ldexpf(1.0f, 2 * exponent);
+    const int16_t *spectrum = m->spectrum;
+
+    // 대역 에너지 (dB, 대략 dBFS: 최대 진폭 사인파의 창 적용 FFT 피크 ≈ 32768 * N / 4)
+    const float full_scale_db = 20.0f * log10f(32768.0f * COMPRESSOR_FFT_SIZE / 4.0f);
+    float band_db[COMPRESSOR_BANDS];
+    for (int b = 0; b < COMPRESSOR_BANDS - 1; b++) {
+        int k0 = (int)(band_edges_hz[b] / BIN_HZ + 0.5f);
+        int k1 = (int)(band_edges_hz[b + 1] / BIN_HZ + 0.5f);
+        float sum = 0.0f;
+        for (int k = k0; k < k1; k++) {
+            sum += bin_power(spectrum, k, scale);
+        }
+        band_db[b] = to_db(sum) - full_scale_db;
+    }
+    float fullband = m->fullband_count ? (float)m->fullband_energy / m->fullband_count : 0.0f;
+    band_db[COMPRESSOR_BANDS - 1] = to_db(fullband / (32768.0f * 32768.0f));
+    m->fullband_energy = 0;
+    m->fullband_count = 0;
+
+    // 큰 소리 (말소리, 문 닫힘): 통계와 켜짐/꺼짐 판단에서 뺌
+    const float level = band_db[COMPRESSOR_BANDS - 1];
+    if (isnan(m->level_ema_db)) {
+        m->level_ema_db = level;
+    }
+    bool transient = level > m->level_ema_db + TRANSIENT_DB;
+    m->level_ema_db += (level - m->level_ema_db) * LEVEL_EMA;
+    m->period_frames++;
+    if (m->cycle_started) {
+        m->cycle_frames[m->on]++;
+    }
+    if (transient) {
+        m->period_transient++;
+        m->period_on += m->on;
+        return;
+    }
+
+    // 켜짐/꺼짐: 50~400Hz 레벨을 꺼져 있을 때 레벨(천천히 올라가는 최소값)과 비교
+    float low = powf(10.0f, band_db[1] / 10.0f) + powf(10.0f, band_db[2] / 10.0f) + powf(10.0f, band_db[3] / 10.0f);
+    float low_db = to_db(low);
+    if (isnan(m->floor_db) || low_db < m->floor_db) {
+        m->floor_db = low_db;
+    } else if (!m->on) {
+        m->floor_db += FLOOR_RISE_DB;
+    }
+    bool target = m->on ? low_db > m->floor_db + OFF_THRESHOLD_DB : low_db > m->floor_db + ON_THRESHOLD_DB;
+    if (target != m->on) {
+        if (++m->pending >= STATE_DEBOUNCE_FRAMES) {
+            m->on = target;
+            m->pending = 0;
+            if (target) {
+                // 꺼짐 → 켜짐: 지난 주기(켜짐 + 꺼짐)의 동작 비율
+                if (m->cycle_started && m->cycle_frames[0] > 0) {
+                    welford_add(&m->period[COMPRESSOR_FEATURE_DUTY],
+                                (float)m->cycle_frames[1] / (m->cycle_frames[0] + m->cycle_frames[1]));
+                }
+                m->cycle_started = true;
+                m->cycle_frames[0] = 0;
+                m->cycle_frames[1] = 0;
+                m->period_cycles++;
+            }
+        }
+    } else {
+        m->pending = 0;
+    }
+    m->period_on += m->on;
+    if (!m->on) {
+        return;
+    }
+
+    for (int b = 0; b < COMPRESSOR_BANDS; b++) {
+        welford_add(&m->period[COMPRESSOR_FEATURE_BAND0 + b], band_db[b]);
+    }
+
+    // 기본 주파수: 탐색 범위에서 가장 큰 bin → 주변보다 충분히 크면 포물선 보간
+    const int k_min = (int)(F0_MIN_HZ / BIN_HZ);
+    const int k_max = (int)(F0_MAX_HZ / BIN_HZ + 1.0f);
+    int k_peak = k_min;
+    float p_peak = 0.0f;
+    for (int k = k_min; k <= k_max; k++) {
+        float p = bin_power(spectrum, k, scale);
+        if (p > p_peak) {
+            p_peak = p;
+            k_peak = k;
+        }
+    }
+    float around = 0.0f;
+    int around_count = 0;
+    for (int d = 3; d <= 6; d++) {
+        if (k_peak - d > 0) {
+            around += bin_power(spectrum, k_peak - d, scale);
+            around_count++;
+        }
+        around += bin_power(spectrum, k_peak + d, scale);
+        around_count++;
+    }
+    around /= around_count;
+    if (to_db(p_peak) < to_db(around) + TONE_MIN_DB) {
+        return;  // 뚜렷한 톤 없음
+    }
+    float left = to_db(bin_power(spectrum, k_peak - 1, scale));
+    float center = to_db(p_peak);
+    float right = to_db(bin_power(spectrum, k_peak + 1, scale));
+    float denom = left - 2.0f * center + right;
+    float delta = denom < 0.0f ? 0.5f * (left - right) / denom : 0.0f;
+    float f0 = (k_peak + delta) * BIN_HZ;
+    welford_add(&m->period[COMPRESSOR_FEATURE_F0], f0);
+
+    // 2, 3차 배음: 예상 위치 ±1 bin의 최대값, 기본 주파수 대비 dB
+    for (int h = 2; h <= 3; h++) {
+        int k = (int)(h * f0 / BIN_HZ + 0.5f);
+        float p = 0.0f;
+        for (int d = -1; d <= 1; d++) {
+            if (k + d < COMPRESSOR_FFT_SIZE / 2) {
+                float q = bin_power(spectrum, k + d, scale);
+                p = q > p ? q : p;
+            }
+        }
+        welford_add(&m->period[h == 2 ? COMPRESSOR_FEATURE_H2 : COMPRESSOR_FEATURE_H3], to_db(p) - center);
+    }
+}
+
+// 주기 끝: 요약을 만들고 기준과 비교 (기준을 배우는 중이면 기준에 추가)
+static void finish_period(compressor_monitor_t *m) {
+    compressor_summary_t *s = &m->summary;
+    memset(s, 0, sizeof(*s));
+    s->sequence = m->sequence++;
+    s->frames = m->period_frames;
+    s->on_frames = m->period_on;
+    s->transient_frames = m->period_transient;
+    s->cycles = m->period_cycles;
+    for (int f = 0; f < COMPRESSOR_FEATURES; f++) {
+        const welford_t *w = &m->period[f];
+        bool valid = f == COMPRESSOR_FEATURE_DUTY ? w->count > 0 : w->count >= MIN_FEATURE_FRAMES;
+        s->value[f] = valid ? w->mean : NAN;
+        s->spread[f] = valid ? welford_std(w) : NAN;
+    }
+
+    s->baseline_ready = m->baseline_periods >= COMPRESSOR_BASELINE_PERIODS;
+    for (int f = 0; f < COMPRESSOR_FEATURES; f++) {
+        if (isnan(s->value[f])) {
+            continue;  // 이번 주기에 컴프레서가 켜지지 않았거나 톤이 없음
+        }
+        welford_t *b = &m->baseline[f];
+        if (!s->baseline_ready) {
+            welford_add(b, s->value[f]);
+            continue;
+        }
+        if (b->count < 2) {
+            continue;  // 배우는 동안 나오지 않은 항목 (컴프레서 주기가 기준 기간보다 긴 경우 등)
+        }
+        float spread = welford_std(b);
+        if (spread < min_spread(f)) {
+            spread = min_spread(f);
+        }
+        float z = fabsf(s->value[f] - b->mean) / spread;
+        if (z > s->max_z) {
+            s->max_z = z;
+        }
+        if (z > COMPRESSOR_Z_THRESHOLD) {
+            s->flags |= 1u << f;
+        }
+    }
+    if (!s->baseline_ready) {
+        m->baseline_periods++;
+    } else if (s->flags == 0) {
+        // 정상 요약으로 계절/설치 환경 변화를 천천히 따라감 (평균만)
+        for (int f = 0; f < COMPRESSOR_FEATURES; f++) {
+            if (!isnan(s->value[f])) {
+                m->baseline[f].mean += (s->value[f] - m->baseline[f].mean) / (4.0f * COMPRESSOR_BASELINE_PERIODS);
+            }
+        }
+    }
+
+    memset(m->period, 0, sizeof(m->period));
+    m->period_frames = 0;
+    m->period_on = 0;
+    m->period_transient = 0;
+    m->period_cycles = 0;
+}
+
+bool compressor_monitor_process(compressor_monitor_t *m, const int16_t *block, size_t count) {
+    if (count > DECIMATOR_MAX_BLOCK) {
+        count = DECIMATOR_MAX_BLOCK;
+    }
+    uint64_t energy = 0;
+    for (size_t i = 0; i < count; i++) {
+        energy += (int32_t)block[i] * block[i];
+    }
+    m->fullband_energy += energy;
+    m->fullband_count += count;
+
+    // I2S_SAMPLE_RATE → 2kHz (half-band 3단, 첫 단은 입력 블록을 건드리지 않도록 따로 출력)
+    size_t n = decimator_process(&m->stages[0], block, count, m->decimated);
+    for (int s = 1; s < COMPRESSOR_DECIMATION_STAGES; s++) {
+        n = decimator_process(&m->stages[s], m->decimated, n, m->decimated);
+    }
+
+    bool done = false;
+    for (size_t i = 0; i < n; i++) {
+        m->frame[m->filled++] = m->decimated[i];
+        if (m->filled == COMPRESSOR_FFT_SIZE) {
+            analyze_frame(m);
+            memmove(m->frame, m->frame + COMPRESSOR_HOP, (COMPRESSOR_FFT_SIZE - COMPRESSOR_HOP) * sizeof(int16_t));
+            m->filled = COMPRESSOR_FFT_SIZE - COMPRESSOR_HOP;
+            if (m->period_frames >= FRAMES_PER_PERIOD) {
+                finish_period(m);
+                done = true;
+            }
+        }
+    }
+    return done;
+}
+
+int compressor_monitor_format(const compressor_summary_t *s, char *line, size_t size) {
+    int len = snprintf(line, size, "HEALTH seq=%lu frames=%u on=%u cycles=%u transient=%u duty=%.3f f0=%.2f h2=%.1f h3=%.1f bands=",
+                       (unsigned long)s->sequence, (unsigned)s->frames, (unsigned)s->on_frames, (unsigned)s->cycles,
+                       (unsigned)s->transient_frames, s->value[COMPRESSOR_FEATURE_DUTY], s->value[COMPRESSOR_FEATURE_F0],
+                       s->value[COMPRESSOR_FEATURE_H2], s->value[COMPRESSOR_FEATURE_H3]);
+    for (int b = 0; b < COMPRESSOR_BANDS && len > 0 && (size_t)len < size; b++) {
+        len += snprintf(line + len, size - len, b ? ",%.1f" : "%.1f", s->value[COMPRESSOR_FEATURE_BAND0 + b]);
+    }
+    if (len > 0 && (size_t)len < size) {
+        len += snprintf(line + len, size - len, " z=%.1f flags=%03lx %s\n", s->max_z, (unsigned long)s->flags,
+                        s->baseline_ready ? "baseline" : "learning");
+    }
+    return len;
+}
@@ -0,0 +1,113 @@
+#ifndef COMPRESSOR_MONITOR_H
+#define COMPRESSOR_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "audio_config.h"
+#include "audio_frontend.h"
+#include "decimator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 컴프레서 소리 상태 감시 (예지 보전): 오디오 대신 주기마다 작은 요약 기록만 남김
+// - 캡처 태스크의 I2S 블록(전처리 전, I2S_SAMPLE_RATE)을 half-band 데시메이터 3단으로 2kHz로 줄이고,
+//   FRONTEND_FFT_SIZE점 FFT(특징 추출과 같은 창/트위들 테이블)를 hop마다 해서 0~800Hz를 봅니다. (16kHz: 3.9Hz 간격, 128ms마다)
+// - 프레임마다: 대역별 에너지(dB), 기본 주파수(40~130Hz 가장 큰 톤)와 2, 3차 배음 레벨, 컴프레서 켜짐/꺼짐 판단
+// - 요약 주기(COMPRESSOR_PERIOD_S)마다 켜져 있던 프레임의 Welford 평균/표준편차, 켜짐 횟수, 그 주기에 끝난
+//   켜짐/꺼짐 사이클의 동작 비율(duty, 한 사이클이 보통 수십 분이라 주기마다 나오지는 않음)을 요약으로 만듦
+// - 처음 COMPRESSOR_BASELINE_PERIODS개 요약으로 기준(요약 평균의 평균/분산)을 배우고, 이후에는 기준에서
+//   COMPRESSOR_Z_THRESHOLD 표준편차 이상 벗어난 항목을 flags로 표시. 벗어나지 않은 요약으로 기준을 천천히 따라감
+// - 말소리, 문 닫는 소리처럼 갑자기 큰 프레임은 통계에서 뺌 (transient)
+// - 메모리는 구조체 하나로 고정 (약 7KB, 대부분 데시메이터 작업 버퍼와 FFT 버퍼). 호스트: host/replay_health.c
+
+#define COMPRESSOR_DECIMATION_STAGES 3
+#define COMPRESSOR_RATE (I2S_SAMPLE_RATE >> COMPRESSOR_DECIMATION_STAGES)  // 분석 레이트 (2kHz)
+#define COMPRESSOR_FFT_SIZE FRONTEND_FFT_SIZE
+#define COMPRESSOR_HOP (COMPRESSOR_FFT_SIZE / 2)
+#define COMPRESSOR_BANDS 6  // 20-50, 50-100, 100-200, 200-400, 400-800Hz, 전체 대역(I2S)
+
+#ifndef COMPRESSOR_PERIOD_S
+#define COMPRESSOR_PERIOD_S 60  // 요약 주기
+#endif
+#ifndef COMPRESSOR_BASELINE_PERIODS
+#define COMPRESSOR_BASELINE_PERIODS 60  // 기준을 배우는 요약 수 (1시간)
+#endif
+#ifndef COMPRESSOR_Z_THRESHOLD
+#define COMPRESSOR_Z_THRESHOLD 4.0f
+#endif
+
+// 기준과 비교하는 항목 (flags의 비트 위치)
+enum {
+    COMPRESSOR_FEATURE_BAND0 = 0,  // ~ BAND0 + COMPRESSOR_BANDS - 1: 켜져 있을 때 대역 에너지
+    COMPRESSOR_FEATURE_DUTY = COMPRESSOR_BANDS,
+    COMPRESSOR_FEATURE_F0,
+    COMPRESSOR_FEATURE_H2,
+    COMPRESSOR_FEATURE_H3,
+    COMPRESSOR_FEATURES
+};
+
+typedef struct {
+    uint32_t count;
+    float mean;
+    float m2;  // 평균과의 차이 제곱합
+} welford_t;
+
+// 요약 하나 (주기마다)
+typedef struct {
+    uint32_t sequence;              // 부팅 후 요약 번호
+    uint16_t frames;                // 분석 프레임 수
+    uint16_t on_frames;             // 컴프레서가 켜져 있던 프레임
+    uint16_t transient_frames;      // 통계에서 뺀 큰 소리 프레임
+    uint16_t cycles;                // 꺼짐 → 켜짐 횟수
+    float value[COMPRESSOR_FEATURES];  // 항목별 주기 평균 (대역/배음 dB, duty 0~1, f0 Hz). 켜진 프레임(사이클)이 부족하면 NAN
+    float spread[COMPRESSOR_FEATURES]; // 항목별 주기 표준편차
+    float max_z;                    // 기준에서 가장 많이 벗어난 정도 (기준을 배우는 중이면 0)
+    uint32_t flags;                 // 1 << COMPRESSOR_FEATURE_*: 기준에서 벗어난 항목
+    bool baseline_ready;
+} compressor_summary_t;
+
+typedef struct {
+    decimator_t stages[COMPRESSOR_DECIMATION_STAGES];
+    int16_t decimated[DECIMATOR_MAX_BLOCK / 2];  // 첫 단 출력 (이후 단은 제자리)
+    int16_t frame[COMPRESSOR_FFT_SIZE];          // 최근 분석 프레임 (2kHz)
+    size_t filled;                               // frame에 쌓인 샘플 수
+    int16_t spectrum[2 * COMPRESSOR_FFT_SIZE];
+    uint64_t fullband_energy;                    // 지난 프레임 이후 I2S 샘플 제곱합
+    uint32_t fullband_count;
+
+    // 켜짐/꺼짐 판단
+    float floor_db;                              // 꺼져 있을 때 레벨 (천천히 올라가는 최소값)
+    float level_ema_db;                          // 전체 대역 레벨 평균 (큰 소리 판단용)
+    bool on;
+    uint16_t pending;                            // 상태가 바뀐 것으로 보이는 연속 프레임 수
+    bool cycle_started;                          // 켜짐을 한 번 본 뒤부터 사이클 길이를 셈
+    uint32_t cycle_frames[2];                    // 지금 사이클의 꺼짐/켜짐 프레임 수
+
+    // 이번 주기
+    welford_t period[COMPRESSOR_FEATURES];
+    uint16_t period_frames, period_on, period_transient, period_cycles;
+    uint32_t sequence;
+
+    // 기준 (요약 평균들의 평균/분산)
+    welford_t baseline[COMPRESSOR_FEATURES];
+    uint32_t baseline_periods;
+
+    compressor_summary_t summary;                // 마지막 요약
+} compressor_monitor_t;
+
+void compressor_monitor_init(compressor_monitor_t *m);
+
+// I2S 블록 (I2S_SAMPLE_RATE 모노, DECIMATOR_MAX_BLOCK 이하, 전처리 전). 요약 주기가 끝났으면 true (m->summary)
+bool compressor_monitor_process(compressor_monitor_t *m, const int16_t *block, size_t count);
+
+// 요약 한 줄 ("HEALTH seq=.. duty=.. ..."), 반환: 길이
+int compressor_monitor_format(const compressor_summary_t *s, char *line, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPRESSOR_MONITOR_H
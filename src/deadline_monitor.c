@@ -0,0 +1,237 @@
+#include <string.h>
+#include "deadline_monitor.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+
+static const char *TAG = "DEADLINE";
+#else
+#include <stdio.h>
+#endif
+
+static const char *const level_names[DEADLINE_LEVELS] = {"normal", "shed", "slow_hop"};
+
+void deadline_monitor_init(deadline_monitor_t *m, uint8_t max_level, int64_t now_us) {
+    memset(m, 0, sizeof(*m));
+    m->max_level = max_level < DEADLINE_LEVELS ? max_level : DEADLINE_LEVELS - 1;
+    m->recover_windows = DEADLINE_RECOVER_WINDOWS;
+    m->window_start_us = now_us;
+    m->level_since_us = now_us;
+    m->report_time_us = now_us;
+}
+
+int deadline_monitor_add_stage(deadline_monitor_t *m, const char *name, uint32_t period_us, uint32_t budget_us,
+                               uint32_t tolerance_us) {
+    if (m->count >= DEADLINE_MAX_STAGES) {
+        return -1;
+    }
+    deadline_stage_t *s = &m->stages[m->count];
+    memset(s, 0, sizeof(*s));
+    s->name = name;
+    s->period_us = period_us;
+    s->budget_us = budget_us;
+    s->tolerance_us = tolerance_us;
+    return (int)m->count++;
+}
+
+void deadline_monitor_set_period(deadline_monitor_t *m, int id, uint32_t period_us, uint32_t budget_us) {
+    if (id < 0 || (size_t)id >= m->count) {
+        return;
+    }
+    deadline_stage_t *s = &m->stages[id];
+    s->period_us = period_us;
+    s->budget_us = budget_us;
+    s->last_start_us = 0;  // 바뀌는 간격 하나는 지터로 세지 않음
+}
+
+void deadline_monitor_begin(deadline_monitor_t *m, int id, int64_t now_us) {
+    if (id < 0 || (size_t)id >= m->count) {
+        return;
+    }
+    deadline_stage_t *s = &m->stages[id];
+    if (s->last_start_us != 0) {
+        int64_t deviation = (now_us - s->last_start_us) - (int64_t)s->period_us;
+        uint32_t jitter = (uint32_t)(deviation < 0 ? -deviation : deviation);
+        jitter = jitter > s->tolerance_us ? jitter - s->tolerance_us : 0;
+        s->jitter_us += jitter;
+        if (jitter > s->max_jitter_us) {
+            s->max_jitter_us = jitter;
+        }
+    }
+    s->last_start_us = now_us;
+    s->start_us = now_us;
+}
+
+void deadline_monitor_end(deadline_monitor_t *m, int id, int64_t now_us) {
+    if (id < 0 || (size_t)id >= m->count) {
+        return;
+    }
+    deadline_stage_t *s = &m->stages[id];
+    uint32_t elapsed = (uint32_t)(now_us - s->start_us);
+    s->runs++;
+    s->busy_us += elapsed;
+    if (elapsed > s->max_us) {
+        s->max_us = elapsed;
+    }
+    if (elapsed > s->budget_us) {
+        s->misses++;
+    }
+}
+
+void deadline_monitor_ring_overflow(deadline_monitor_t *m, uint32_t samples) {
+    m->ring_overflows++;
+    m->lost_samples += samples;
+}
+
+void deadline_monitor_skip(deadline_monitor_t *m, uint32_t hops) {
+    m->skipped_hops += hops;
+}
+
+static void set_level(deadline_monitor_t *m, uint8_t level, int64_t now_us) {
+    m->level_us[m->level] += now_us - m->level_since_us;
+    m->level_since_us = now_us;
+    m->level = level;
+    m->overloaded_windows = 0;
+    m->clean_windows = 0;
+}
+
+bool deadline_monitor_update(deadline_monitor_t *m, int64_t now_us) {
+    if (now_us - m->window_start_us < (int64_t)DEADLINE_WINDOW_MS * 1000) {
+        return false;
+    }
+
+    // 이번 창: 단계별 마감 초과 비율 중 가장 나쁜 것, 잃은 오디오, 건너뛴 hop
+    bool overloaded = false;
+    bool clean = true;
+    for (size_t i = 0; i < m->count; i++) {
+        deadline_stage_t *s = &m->stages[i];
+        uint32_t runs = s->runs;
+        uint32_t misses = s->misses;
+        uint32_t d_runs = runs - s->window_runs;
+        uint32_t d_misses = misses - s->window_misses;
+        overloaded |= (uint64_t)d_misses * 100 > (uint64_t)d_runs * DEADLINE_ESCALATE_PERCENT;
+        clean &= (uint64_t)d_misses * 100 <= (uint64_t)d_runs * DEADLINE_RECOVER_PERCENT;
+        s->window_runs = runs;
+        s->window_misses = misses;
+    }
+    uint32_t lost = m->overruns + m->ring_overflows;
+    uint32_t skipped = m->skipped_hops;
+    bool lost_audio = lost != m->window_lost;
+    bool skipped_hops = skipped != m->window_skipped;
+    m->window_lost = lost;
+    m->window_skipped = skipped;
+    m->window_start_us = now_us;
+    overloaded |= lost_audio || skipped_hops;
+    clean &= !overloaded;
+
+    if (overloaded) {
+        m->clean_windows = 0;
+        if (m->overloaded_windows < UINT8_MAX) {
+            m->overloaded_windows++;
+        }
+        if (m->level < m->max_level && (lost_audio || m->overloaded_windows >= DEADLINE_ESCALATE_WINDOWS)) {
+            if (m->just_recovered) {
+                // 되돌리자마자 다시 과부하: 다음에는 더 오래 지켜본 뒤에 되돌림
+                m->recover_windows = m->recover_windows * 2 < DEADLINE_RECOVER_MAX_WINDOWS ? m->recover_windows * 2
+                                                                                         : DEADLINE_RECOVER_MAX_WINDOWS;
+                m->just_recovered = false;
+            }
+            m->escalations++;
+            set_level(m, m->level + 1, now_us);
+            return true;
+        }
+        return false;
+    }
+
+    m->overloaded_windows = 0;
+    if (!clean) {
+        m->clean_windows = 0;
+        return false;
+    }
+    if (m->clean_windows < UINT8_MAX) {
+        m->clean_windows++;
+    }
+    if (m->just_recovered && m->clean_windows >= m->recover_windows) {
+        m->just_recovered = false;  // 되돌린 단계에서 버팀
+    }
+    if (m->level > DEADLINE_LEVEL_NORMAL && m->clean_windows >= m->recover_windows) {
+        m->recoveries++;
+        set_level(m, m->level - 1, now_us);
+        m->just_recovered = true;
+        return true;
+    }
+    if (m->level == DEADLINE_LEVEL_NORMAL && m->clean_windows >= DEADLINE_RECOVER_MAX_WINDOWS) {
+        m->recover_windows = DEADLINE_RECOVER_WINDOWS;  // 오래 여유가 있었으면 처음 값으로
+    }
+    return false;
+}
+
+const char *deadline_monitor_level_name(uint8_t level) {
+    return level < DEADLINE_LEVELS ? level_names[level] : "?";
+}
+
+void deadline_monitor_report(deadline_monitor_t *m, int64_t now_us) {
+    double elapsed = (double)(now_us - m->report_time_us);
+    if (elapsed <= 0.0) {
+        elapsed = 1.0;
+    }
+
+    for (size_t i = 0; i < m->count; i++) {
+        deadline_stage_t *s = &m->stages[i];
+        uint32_t runs = s->runs;
+        uint32_t busy = s->busy_us;
+        uint32_t misses = s->misses;
+        uint32_t jitter = s->jitter_us;
+        uint32_t d_runs = runs - s->report_runs;
+        unsigned long avg = d_runs > 0 ? (unsigned long)((busy - s->report_busy_us) / d_runs) : 0;
+        unsigned long avg_jitter = d_runs > 0 ? (unsigned long)((jitter - s->report_jitter_us) / d_runs) : 0;
+#ifdef ESP_PLATFORM
+        ESP_LOGI(TAG, "%-10s period %6lu us  budget %6lu us  runs %6lu  avg %6lu us  max %6lu us  missed %lu  jitter avg %lu us, max %lu us",
+                 s->name, (unsigned long)s->period_us, (unsigned long)s->budget_us, (unsigned long)d_runs, avg,
+                 (unsigned long)s->max_us, (unsigned long)(misses - s->report_misses), avg_jitter,
+                 (unsigned long)s->max_jitter_us);
+#else
+        printf("%-10s period %6lu us  budget %6lu us  runs %6lu  avg %6lu us  max %6lu us  missed %lu  jitter avg %lu us, max %lu us\n",
+               s->name, (unsigned long)s->period_us, (unsigned long)s->budget_us, (unsigned long)d_runs, avg,
+               (unsigned long)s->max_us, (unsigned long)(misses - s->report_misses), avg_jitter,
+               (unsigned long)s->max_jitter_us);
+#endif
+        s->report_runs = runs;
+        s->report_busy_us = busy;
+        s->report_misses = misses;
+        s->report_jitter_us = jitter;
+    }
+
+    // 단계별로 머문 시간 (update를 부르는 태스크만 level_us를 쓰므로 여기서는 읽기만)
+    double level_share[DEADLINE_LEVELS];
+    uint8_t level = m->level;
+    for (int l = 0; l < DEADLINE_LEVELS; l++) {
+        int64_t total = m->level_us[l] + (l == level ? now_us - m->level_since_us : 0);
+        level_share[l] = 100.0 * (total - m->report_level_us[l]) / elapsed;
+        m->report_level_us[l] = total;
+    }
+    uint32_t overruns = m->overruns;
+    uint32_t ring_overflows = m->ring_overflows;
+    uint32_t skipped = m->skipped_hops;
+#ifdef ESP_PLATFORM
+    ESP_LOGI(TAG, "%.1f s, level %s (escalated %lu, recovered %lu), DMA overruns %lu, ring overflows %lu (%lu samples total), skipped hops %lu",
+             elapsed / 1e6, deadline_monitor_level_name(level), (unsigned long)m->escalations,
+             (unsigned long)m->recoveries, (unsigned long)(overruns - m->report_overruns),
+             (unsigned long)(ring_overflows - m->report_ring_overflows), (unsigned long)m->lost_samples,
+             (unsigned long)(skipped - m->report_skipped_hops));
+    ESP_LOGI(TAG, "time at level: normal %.1f%%, shed %.1f%%, slow_hop %.1f%%", level_share[0], level_share[1],
+             level_share[2]);
+#else
+    printf("%.1f s, level %s (escalated %lu, recovered %lu), DMA overruns %lu, ring overflows %lu (%lu samples total), skipped hops %lu\n",
+           elapsed / 1e6, deadline_monitor_level_name(level), (unsigned long)m->escalations,
+           (unsigned long)m->recoveries, (unsigned long)(overruns - m->report_overruns),
+           (unsigned long)(ring_overflows - m->report_ring_overflows), (unsigned long)m->lost_samples,
+           (unsigned long)(skipped - m->report_skipped_hops));
+    printf("time at level: normal %.1f%%, shed %.1f%%, slow_hop %.1f%%\n", level_share[0], level_share[1],
+           level_share[2]);
+#endif
+    m->report_overruns = overruns;
+    m->report_ring_overflows = ring_overflows;
+    m->report_skipped_hops = skipped;
+    m->report_time_us = now_us;
+}
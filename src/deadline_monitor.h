@@ -0,0 +1,141 @@
+#ifndef DEADLINE_MONITOR_H
+#define DEADLINE_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 오디오 파이프라인 실시간 마감 감시 (wake_word.cpp: 캡처 블록 처리, 추론 주기, 호출어 hop)
+// - 단계마다 주기(period)와 예산(budget)을 정하고, 단계를 맡은 태스크가 시작/끝 시각을 넘겨줍니다.
+//   예산을 넘기면 마감 초과(miss), 시작 간격이 주기와 다른 만큼은 지터로 셉니다.
+// - 오디오를 잃는 사건은 따로 셉니다: I2S DMA 큐 넘침(ISR), 링 버퍼 넘침(추론이 못 본 오디오가 덮어써짐),
+//   건너뛴 hop(추론이 밀려서 최근 창으로 바로 넘어감)
+// - 창(DEADLINE_WINDOW_MS)마다 정책: 과부하가 이어지면 단계적으로 낮춤 (level), 여유가 이어지면 한 단계씩 되돌림
+//   (되돌린 직후 다시 과부하면 되돌리는 데 필요한 창 수를 두 배로)
+// - 시각은 호출하는 쪽이 넘겨줌 (장치: esp_timer, 호스트 시뮬레이터: 가상 시각)
+// - 통계는 32비트 누적값이고 보고할 때 지난 보고와의 차이로 계산하므로, 단계별로 다른 태스크가 기록해도 잠금이 필요 없습니다.
+// 호스트: host/sim_deadline.c (단계를 일부러 느리게 해서 정책 확인)
+
+#define DEADLINE_MAX_STAGES 4
+
+#ifndef DEADLINE_WINDOW_MS
+#define DEADLINE_WINDOW_MS 1000      // 정책 판단 간격
+#endif
+#ifndef DEADLINE_ESCALATE_PERCENT
+#define DEADLINE_ESCALATE_PERCENT 10 // 한 단계라도 창 안에서 이 비율 넘게 마감을 넘기면 과부하 창
+#endif
+#ifndef DEADLINE_ESCALATE_WINDOWS
+#define DEADLINE_ESCALATE_WINDOWS 2  // 과부하 창이 이만큼 이어지면 한 단계 낮춤 (오디오를 잃었으면 바로)
+#endif
+#ifndef DEADLINE_RECOVER_PERCENT
+#define DEADLINE_RECOVER_PERCENT 3   // 모든 단계가 이 비율 이하로만 넘기고 잃은 오디오가 없으면 여유 창
+#endif
+#ifndef DEADLINE_RECOVER_WINDOWS
+#define DEADLINE_RECOVER_WINDOWS 5   // 여유 창이 이만큼 이어지면 한 단계 되돌림
+#endif
+#define DEADLINE_RECOVER_MAX_WINDOWS 60
+
+// 낮추는 순서 (각 단계는 앞 단계를 포함)
+typedef enum {
+    DEADLINE_LEVEL_NORMAL = 0,
+    DEADLINE_LEVEL_SHED,       // 우선순위 낮은(1 이상) 소리 이벤트 모델 중지
+    DEADLINE_LEVEL_SLOW_HOP,   // 호출어 hop 두 배
+    DEADLINE_LEVELS
+} deadline_level_t;
+
+typedef struct {
+    const char *name;
+    uint32_t period_us;
+    uint32_t budget_us;
+    uint32_t tolerance_us;         // 시작 간격이 period ± tolerance 안이면 지터 0
+    int64_t start_us;              // 지금 실행 시작 (단계를 맡은 태스크만)
+    int64_t last_start_us;         // 이전 실행 시작 (0: 아직 없음)
+    // 누적 통계 (32비트, 넘치면 0으로)
+    volatile uint32_t runs;
+    volatile uint32_t busy_us;
+    volatile uint32_t max_us;
+    volatile uint32_t misses;      // 예산을 넘긴 횟수
+    volatile uint32_t jitter_us;   // |시작 간격 - period| 중 tolerance를 넘는 부분의 합
+    volatile uint32_t max_jitter_us;
+    // 정책 창 시작 시점의 누적값
+    uint32_t window_runs;
+    uint32_t window_misses;
+    // 지난 보고 시점의 누적값
+    uint32_t report_runs;
+    uint32_t report_busy_us;
+    uint32_t report_misses;
+    uint32_t report_jitter_us;
+} deadline_stage_t;
+
+typedef struct {
+    deadline_stage_t stages[DEADLINE_MAX_STAGES];
+    size_t count;
+    // 오디오를 잃은 사건 (누적)
+    volatile uint32_t overruns;        // I2S DMA 큐 넘침 (ISR)
+    volatile uint32_t ring_overflows;  // 링 버퍼 넘침
+    volatile uint32_t lost_samples;    // 링 버퍼 넘침으로 추론하지 못한 샘플
+    volatile uint32_t skipped_hops;    // 건너뛴 호출어 hop
+    // 정책 (update를 부르는 태스크만)
+    volatile uint8_t level;            // deadline_level_t
+    uint8_t max_level;                 // 0이면 세기만 하고 낮추지 않음
+    uint8_t overloaded_windows;        // 이어진 과부하 창
+    uint8_t clean_windows;             // 이어진 여유 창
+    uint8_t recover_windows;           // 되돌리는 데 필요한 여유 창 수
+    bool just_recovered;               // 마지막 변화가 되돌림이고 아직 여유 창이 recover_windows만큼 안 지남
+    int64_t window_start_us;
+    uint32_t window_lost;              // 창 시작 시점의 overruns + ring_overflows
+    uint32_t window_skipped;
+    uint32_t escalations;
+    uint32_t recoveries;
+    int64_t level_since_us;
+    int64_t level_us[DEADLINE_LEVELS]; // 단계별로 머문 시간 (지금 단계는 level_since_us부터 더함)
+    int64_t report_time_us;
+    int64_t report_level_us[DEADLINE_LEVELS];
+    uint32_t report_overruns;
+    uint32_t report_ring_overflows;
+    uint32_t report_skipped_hops;
+} deadline_monitor_t;
+
+// max_level: 정책이 낮출 수 있는 가장 낮은 단계 (DEADLINE_LEVEL_NORMAL이면 정책 없이 세기만)
+void deadline_monitor_init(deadline_monitor_t *m, uint8_t max_level, int64_t now_us);
+
+// 단계 등록. tolerance_us: 지터로 세지 않을 간격 차이 (캡처 블록마다 깨어나서 hop을 보는 단계는 블록 길이)
+// 반환: id, 자리가 없으면 -1
+int deadline_monitor_add_stage(deadline_monitor_t *m, const char *name, uint32_t period_us, uint32_t budget_us,
+                               uint32_t tolerance_us);
+
+// 주기/예산 바꾸기 (hop을 늘릴 때). 시작 간격 지터는 다음 실행부터 새 주기로
+void deadline_monitor_set_period(deadline_monitor_t *m, int id, uint32_t period_us, uint32_t budget_us);
+
+// (단계를 맡은 태스크) 실행 시작/끝
+void deadline_monitor_begin(deadline_monitor_t *m, int id, int64_t now_us);
+void deadline_monitor_end(deadline_monitor_t *m, int id, int64_t now_us);
+
+// I2S DMA 큐 넘침 (ISR에서도, 쓰는 곳은 하나뿐)
+static inline void deadline_monitor_overrun(deadline_monitor_t *m) {
+    m->overruns++;
+}
+
+// 추론하지 못한 오디오가 링 버퍼에서 덮어써짐
+void deadline_monitor_ring_overflow(deadline_monitor_t *m, uint32_t samples);
+
+// 밀려서 건너뛴 호출어 hop
+void deadline_monitor_skip(deadline_monitor_t *m, uint32_t hops);
+
+// (정책 태스크) 창이 끝났으면 정책 적용. 단계가 바뀌었으면 true (m->level을 보고 파이프라인에 반영)
+bool deadline_monitor_update(deadline_monitor_t *m, int64_t now_us);
+
+const char *deadline_monitor_level_name(uint8_t level);
+
+// 단계별 실행 횟수, 평균/최대 시간, 마감 초과, 지터와 잃은 오디오, 단계별 머문 시간(지난 보고 이후)을 로그로 출력
+void deadline_monitor_report(deadline_monitor_t *m, int64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEADLINE_MONITOR_H
@@ -0,0 +1,47 @@
+#include "decimator.h"
+#include <string.h>
+
+#define CENTER (DECIMATOR_HISTORY / 2)
+#define CENTER_Q15 16384
+
+// 중앙에서 1, 3, 5, ... 23 떨어진 계수 (Q15, Kaiser β=7.5, 합계 32768 = DC 게인 1)
+static const int16_t side_q15[(DECIMATOR_TAPS + 1) / 4] = {
+    10363, -3276, 1766, -1071, 665, -407, 239, -131, 65, -28, 9, -2,
+};
+
+void decimator_init(decimator_t *d) {
+    memset(d, 0, sizeof(*d));
+}
+
+static size_t process_chunk(decimator_t *d, const int16_t *in, size_t count, int16_t *out) {
+    int16_t *work = d->work;
+    memcpy(work + DECIMATOR_HISTORY, in, count * sizeof(int16_t));
+
+    // 출력 m은 work[end - DECIMATOR_HISTORY .. end]를 사용 (end는 입력에서 두 샘플 간격)
+    size_t produced = 0;
+    size_t end = DECIMATOR_HISTORY + d->phase;
+    for (; end < DECIMATOR_HISTORY + count; end += 2) {
+        const int16_t *x = work + end - CENTER;
+        int32_t acc = CENTER_Q15 * x[0] + (1 << 14);
+        for (int k = 0; k < (int)(sizeof(side_q15) / sizeof(side_q15[0])); k++) {
+            acc += side_q15[k] * (x[-(2 * k + 1)] + x[2 * k + 1]);
+        }
+        acc >>= 15;
+        out[produced++] = (int16_t)(acc > 32767 ? 32767 : (acc < -32768 ? -32768 : acc));
+    }
+    d->phase = (uint8_t)(end - DECIMATOR_HISTORY - count);
+
+    memmove(work, work + count, DECIMATOR_HISTORY * sizeof(int16_t));
+    return produced;
+}
+
+size_t decimator_process(decimator_t *d, const int16_t *in, size_t count, int16_t *out) {
+    size_t produced = 0;
+    while (count > 0) {
+        size_t chunk = count < DECIMATOR_MAX_BLOCK ? count : DECIMATOR_MAX_BLOCK;
+        produced += process_chunk(d, in, chunk, out + produced);
+        in += chunk;
+        count -= chunk;
+    }
+    return produced;
+}
@@ -0,0 +1,37 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 2:1 half-band 폴리페이즈 FIR 데시메이터 (16kHz → 8kHz)
+// - 47탭 Kaiser 창 half-band: 중앙을 뺀 짝수 위치 계수가 0이고 좌우 대칭이라 출력 하나에 곱셈 13번
+// - 통과대역 0~3.2kHz (리플 0.01dB 이하), 저지대역 4.8kHz 이상 약 65dB 감쇠
+// - 출력이 필요한 위치(짝수 샘플)만 계산 (폴리페이즈)
+// - 필터 상태와 위상을 구조체에 유지하므로 DMA 버퍼 크기가 홀수여도 이어서 처리됨
+// 지연: (DECIMATOR_TAPS - 1) / 2 입력 샘플
+
+#define DECIMATOR_TAPS      47
+#define DECIMATOR_HISTORY   (DECIMATOR_TAPS - 1)
+#define DECIMATOR_MAX_BLOCK 512  // 한 번에 복사할 최대 입력 샘플 수 (더 길면 나눠서 처리)
+
+typedef struct {
+    int16_t work[DECIMATOR_HISTORY + DECIMATOR_MAX_BLOCK];  // 이전 입력 끝부분(DECIMATOR_HISTORY) + 현재 입력
+    uint8_t phase;  // 다음 출력이 현재 입력의 몇 번째 샘플에서 끝나는지 (0 또는 1)
+} decimator_t;
+
+void decimator_init(decimator_t *d);
+
+// in의 count 샘플을 처리해서 out에 출력하고 출력 샘플 수를 반환 (count / 2, 홀수면 위상에 따라 ±1)
+// out은 in과 같은 버퍼여도 됨
+size_t decimator_process(decimator_t *d, const int16_t *in, size_t count, int16_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DECIMATOR_H
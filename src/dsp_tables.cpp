@@ -0,0 +1,100 @@
+#include "dsp_tables.h"
+
+// 현재 빌드 설정(MODEL_SAMPLE_RATE, FRONTEND_FFT_LOG2, FRONTEND_MEL_BINS)의 테이블을 컴파일 시간에 만들어서
+// C 구조체 그대로 const로 내보냅니다. constexpr로 초기화하므로 부팅 시 실행되는 코드가 없고 .rodata(플래시)에 들어갑니다.
+
+namespace {
+
+using Tables = dsp_tables::Generator<MODEL_SAMPLE_RATE, FRONTEND_FFT_LOG2, FRONTEND_MEL_BINS, 15>;
+
+static_assert(Tables::kFftSize == FRONTEND_FFT_SIZE, "FFT 크기가 audio_frontend.h와 다름");
+static_assert(Tables::kBins == FRONTEND_BINS, "bin 수가 audio_frontend.h와 다름");
+static_assert(FRONTEND_HOP * 2 == FRONTEND_FFT_SIZE, "sqrt-Hann 완전 복원은 50% 겹침에서만 성립");
+static_assert(Tables::kMaxMelWeights == DSP_MEL_MAX_WEIGHTS, "mel 가중치 버퍼 크기가 다름");
+static_assert(Tables::mel_filters_nonempty(), "bin이 하나도 없는 mel 필터가 있음 (FRONTEND_MEL_BINS를 줄이세요)");
+static_assert(Tables::mel().weight_count <= DSP_MEL_MAX_WEIGHTS, "mel 가중치가 버퍼보다 많음");
+
+constexpr dsp_window_table_t make_window() {
+    dsp_window_table_t table{};
+    const auto values = Tables::window();
+    for (int i = 0; i < FRONTEND_FFT_SIZE; i++) {
+        table.q15[i] = values[i];
+    }
+    return table;
+}
+
+constexpr dsp_twiddle_table_t make_twiddle() {
+    dsp_twiddle_table_t table{};
+    const auto values = Tables::twiddle();
+    for (int i = 0; i < FRONTEND_FFT_SIZE; i++) {
+        table.q15[i] = values[i];
+    }
+    return table;
+}
+
+constexpr dsp_log2_table_t make_log2() {
+    dsp_log2_table_t table{};
+    const auto values = Tables::log2_fraction<DSP_LOG2_TABLE_BITS, 10>();
+    for (int i = 0; i < (1 << DSP_LOG2_TABLE_BITS); i++) {
+        table.q10[i] = values[i];
+    }
+    return table;
+}
+
+constexpr dsp_exp2_table_t make_exp2() {
+    dsp_exp2_table_t table{};
+    const auto values = Tables::exp2_fraction<DSP_EXP2_TABLE_BITS, 16>();
+    for (int i = 0; i < (1 << DSP_EXP2_TABLE_BITS); i++) {
+        table.q16[i] = values[i];
+    }
+    return table;
+}
+
+constexpr dsp_mel_table_t make_mel() {
+    dsp_mel_table_t table{};
+    const auto bank = Tables::mel();
+    for (int m = 0; m < FRONTEND_MEL_BINS; m++) {
+        table.start[m] = bank.start[m];
+        table.length[m] = bank.length[m];
+        table.offset[m] = bank.offset[m];
+    }
+    for (std::size_t i = 0; i < bank.weight_count; i++) {
+        table.weights_q15[i] = bank.weights[i];
+    }
+    return table;
+}
+
+constexpr dsp_sine_table_t make_sine() {
+    dsp_sine_table_t table{};
+    const auto values = Tables::sine<DSP_SINE_TABLE_BITS>();
+    for (int i = 0; i <= (1 << DSP_SINE_TABLE_BITS); i++) {
+        table.q15[i] = values[i];
+    }
+    return table;
+}
+
+constexpr dsp_window_table_t kWindow = make_window();
+constexpr dsp_twiddle_table_t kTwiddle = make_twiddle();
+constexpr dsp_log2_table_t kLog2 = make_log2();
+constexpr dsp_exp2_table_t kExp2 = make_exp2();
+constexpr dsp_mel_table_t kMel = make_mel();
+constexpr dsp_sine_table_t kSine = make_sine();
+
+static_assert(kWindow.q15[0] == 0 && kWindow.q15[FRONTEND_FFT_SIZE / 2] == 32767, "창 끝/가운데 값");
+static_assert(kTwiddle.q15[0] == 32767 && kTwiddle.q15[1] == 0, "트위들 k=0");
+static_assert(kLog2.q10[0] == 0 && kLog2.q10[128] == 599, "log2(1.5) = 0.585 (Q10 599)");
+static_assert(kExp2.q16[0] == 65535 && kExp2.q16[128] == 46341, "2^-0.5 = 0.7071 (Q16 46341)");
+static_assert(kSine.q15[0] == 0 && kSine.q15[64] == 32767 && kSine.q15[256] == 0, "사인 0, π/2, 2π");
+
+}  // namespace
+
+extern "C" {
+
+const dsp_window_table_t dsp_window = kWindow;
+const dsp_twiddle_table_t dsp_twiddle = kTwiddle;
+const dsp_log2_table_t dsp_log2 = kLog2;
+const dsp_exp2_table_t dsp_exp2 = kExp2;
+const dsp_mel_table_t dsp_mel = kMel;
+const dsp_sine_table_t dsp_sine = kSine;
+
+}
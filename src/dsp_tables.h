@@ -0,0 +1,281 @@
+#ifndef DSP_TABLES_H
+#define DSP_TABLES_H
+
+#include <stdint.h>
+#include "audio_frontend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// DSP 상수 테이블 (창, FFT 트위들, log2/exp2, mel 필터, 재생용 사인 웨이브테이블)
+// dsp_tables.cpp에서 컴파일 시간에 계산한 const 데이터라서 플래시(rodata)에 들어갑니다.
+// 부팅 시 생성 시간이 없고 DRAM을 차지하지 않습니다. (크기/시간 비교: host/report_dsp_tables)
+
+#define DSP_LOG2_TABLE_BITS 8
+#define DSP_EXP2_TABLE_BITS 8
+#define DSP_SINE_TABLE_BITS 8
+// mel 필터 하나가 걸치는 bin 수의 합 상한 (bin 하나는 최대 두 필터에 걸침)
+#define DSP_MEL_MAX_WEIGHTS (2 * FRONTEND_BINS)
+
+typedef struct {
+    int16_t q15[FRONTEND_FFT_SIZE];             // sqrt-Hann (periodic) = sin(πi/N)
+} dsp_window_table_t;
+
+typedef struct {
+    int16_t q15[FRONTEND_FFT_SIZE];             // {cos, -sin}(2πk/N) × N/2
+} dsp_twiddle_table_t;
+
+typedef struct {
+    uint16_t q10[1 << DSP_LOG2_TABLE_BITS];     // log2(1 + i/256), Q10
+} dsp_log2_table_t;
+
+typedef struct {
+    uint16_t q16[1 << DSP_EXP2_TABLE_BITS];     // 2^(-i/256), Q16 (i = 0 → 65535)
+} dsp_exp2_table_t;
+
+typedef struct {
+    int16_t q15[(1 << DSP_SINE_TABLE_BITS) + 1];  // sin(2πi/256) 한 주기 + 보간용 마지막 값(= 첫 값)
+} dsp_sine_table_t;
+
+// 삼각형 mel 필터: 필터 m은 bin start[m]부터 length[m]개, 가중치는 weights_q15[offset[m]]부터
+typedef struct {
+    uint16_t start[FRONTEND_MEL_BINS];
+    uint16_t length[FRONTEND_MEL_BINS];
+    uint16_t offset[FRONTEND_MEL_BINS];
+    int16_t weights_q15[DSP_MEL_MAX_WEIGHTS];
+} dsp_mel_table_t;
+
+extern const dsp_window_table_t dsp_window;
+extern const dsp_twiddle_table_t dsp_twiddle;
+extern const dsp_log2_table_t dsp_log2;
+extern const dsp_exp2_table_t dsp_exp2;
+extern const dsp_mel_table_t dsp_mel;
+extern const dsp_sine_table_t dsp_sine;
+
+#ifdef __cplusplus
+}
+
+#include <array>
+#include <cstddef>
+
+// 테이블 생성기 (constexpr). 샘플링 레이트, FFT 크기, mel 필터 수, Q 형식을 템플릿 인자로 받습니다.
+// 설정이 잘못되면 static_assert로 컴파일 에러가 납니다.
+namespace dsp_tables {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kLn2 = 0.69314718055994530942;
+
+// |x| <= π에서 테일러 급수 (double 정밀도까지)
+constexpr double sin_reduced(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 20; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double sin(double x) {
+    // [-π, π]로 줄임
+    double turns = x / (2 * kPi);
+    long long whole = (long long)(turns >= 0 ? turns + 0.5 : turns - 0.5);
+    return sin_reduced(x - (double)whole * 2 * kPi);
+}
+
+constexpr double cos(double x) {
+    return sin(x + kPi / 2);
+}
+
+// ln(x), x > 0: x = m * 2^e (m은 [1, 2)) 로 나눈 뒤 ln(m) = 2 atanh((m - 1) / (m + 1))
+constexpr double ln(double x) {
+    int e = 0;
+    while (x >= 2.0) {
+        x /= 2.0;
+        e++;
+    }
+    while (x < 1.0) {
+        x *= 2.0;
+        e--;
+    }
+    double t = (x - 1.0) / (x + 1.0);
+    double term = t;
+    double sum = 0.0;
+    for (int n = 1; n < 60; n += 2) {
+        sum += term / n;
+        term *= t * t;
+    }
+    return 2.0 * sum + e * kLn2;
+}
+
+constexpr double log2(double x) {
+    return ln(x) / kLn2;
+}
+
+constexpr double exp(double x) {
+    // e^x = (e^(x/2^k))^(2^k), |x/2^k| < 0.5에서 테일러 급수
+    int k = 0;
+    while (x > 0.5 || x < -0.5) {
+        x /= 2.0;
+        k++;
+    }
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; n++) {
+        term *= x / n;
+        sum += term;
+    }
+    for (int i = 0; i < k; i++) {
+        sum *= sum;
+    }
+    return sum;
+}
+
+constexpr double exp2(double x) {
+    return exp(x * kLn2);
+}
+
+// 반올림 후 [lo, hi]로 자름
+constexpr long long round_clamp(double value, long long lo, long long hi) {
+    long long q = (long long)(value >= 0 ? value + 0.5 : value - 0.5);
+    return q > hi ? hi : (q < lo ? lo : q);
+}
+
+constexpr double hz_to_mel(double hz) {
+    return 1127.0 * ln(1.0 + hz / 700.0);
+}
+
+constexpr double mel_to_hz(double mel) {
+    return 700.0 * (exp(mel / 1127.0) - 1.0);
+}
+
+template <std::size_t MaxWeights, int MelBins>
+struct MelFilterbank {
+    std::array<uint16_t, MelBins> start{};
+    std::array<uint16_t, MelBins> length{};
+    std::array<uint16_t, MelBins> offset{};
+    std::array<int16_t, MaxWeights> weights{};
+    std::size_t weight_count = 0;
+};
+
+template <int SampleRate, int FftLog2, int MelBins, int QBits = 15>
+struct Generator {
+    static constexpr int kFftSize = 1 << FftLog2;
+    static constexpr int kBins = kFftSize / 2 + 1;
+    static constexpr int kMelLowHz = 20;
+    static constexpr int kMelHighHz = SampleRate / 2;
+    static constexpr long long kOne = 1LL << QBits;
+    static constexpr std::size_t kMaxMelWeights = 2 * kBins;
+
+    static_assert(SampleRate >= 4000 && SampleRate <= 48000, "지원하지 않는 샘플링 레이트");
+    static_assert(FftLog2 >= 6 && FftLog2 <= 12, "FFT 크기는 64~4096");
+    static_assert(QBits >= 8 && QBits <= 15, "Q 형식은 int16에 들어가야 함 (Q8~Q15)");
+    static_assert(MelBins >= 1 && MelBins < kBins / 2, "mel 필터 수가 FFT bin 수에 비해 너무 많음");
+    static_assert(kMelLowHz < kMelHighHz, "mel 대역이 비어 있음");
+
+    static constexpr int16_t to_q(double value) {
+        return (int16_t)round_clamp(value * (double)kOne, -kOne, kOne - 1);
+    }
+
+    // sqrt-Hann (periodic): sqrt(0.5 - 0.5cos(2πi/N)) = sin(πi/N)
+    static constexpr std::array<int16_t, kFftSize> window() {
+        std::array<int16_t, kFftSize> table{};
+        for (int i = 0; i < kFftSize; i++) {
+            table[i] = to_q(sin(kPi * i / kFftSize));
+        }
+        return table;
+    }
+
+    static constexpr std::array<int16_t, kFftSize> twiddle() {
+        std::array<int16_t, kFftSize> table{};
+        for (int k = 0; k < kFftSize / 2; k++) {
+            table[2 * k] = to_q(cos(2.0 * kPi * k / kFftSize));
+            table[2 * k + 1] = to_q(-sin(2.0 * kPi * k / kFftSize));
+        }
+        return table;
+    }
+
+    // sin(2πi/2^TableBits) 한 주기, 선형 보간용으로 끝에 첫 값을 한 번 더
+    template <int TableBits>
+    static constexpr std::array<int16_t, (1 << TableBits) + 1> sine() {
+        std::array<int16_t, (1 << TableBits) + 1> table{};
+        for (int i = 0; i <= (1 << TableBits); i++) {
+            table[i] = to_q(sin(2.0 * kPi * (i % (1 << TableBits)) / (1 << TableBits)));
+        }
+        return table;
+    }
+
+    template <int TableBits, int ScaleBits>
+    static constexpr std::array<uint16_t, 1 << TableBits> log2_fraction() {
+        std::array<uint16_t, 1 << TableBits> table{};
+        for (int i = 0; i < (1 << TableBits); i++) {
+            table[i] = (uint16_t)round_clamp(log2(1.0 + (double)i / (1 << TableBits)) * (1 << ScaleBits), 0, 65535);
+        }
+        return table;
+    }
+
+    template <int TableBits, int ScaleBits>
+    static constexpr std::array<uint16_t, 1 << TableBits> exp2_fraction() {
+        std::array<uint16_t, 1 << TableBits> table{};
+        for (int i = 0; i < (1 << TableBits); i++) {
+            table[i] = (uint16_t)round_clamp(exp2(-(double)i / (1 << TableBits)) * (1 << ScaleBits), 0, 65535);
+        }
+        return table;
+    }
+
+    // HTK 방식 삼각형 필터 (kMelLowHz ~ 나이퀴스트를 mel 척도로 균등 분할, 면적 정규화 없음)
+    static constexpr MelFilterbank<kMaxMelWeights, MelBins> mel() {
+        MelFilterbank<kMaxMelWeights, MelBins> bank{};
+        const double mel_low = hz_to_mel(kMelLowHz);
+        const double mel_step = (hz_to_mel(kMelHighHz) - mel_low) / (MelBins + 1);
+        const double bin_hz = (double)SampleRate / kFftSize;
+        std::size_t count = 0;
+        for (int m = 0; m < MelBins; m++) {
+            const double left = mel_to_hz(mel_low + m * mel_step);
+            const double center = mel_to_hz(mel_low + (m + 1) * mel_step);
+            const double right = mel_to_hz(mel_low + (m + 2) * mel_step);
+            bank.offset[m] = (uint16_t)count;
+            int first = -1;
+            int last = -1;
+            for (int k = 0; k < kBins; k++) {
+                const double hz = k * bin_hz;
+                double weight = 0.0;
+                if (hz > left && hz <= center) {
+                    weight = (hz - left) / (center - left);
+                } else if (hz > center && hz < right) {
+                    weight = (right - hz) / (right - center);
+                }
+                const int16_t q = to_q(weight);
+                if (q > 0) {  // 삼각형이라서 가중치가 있는 bin은 연속
+                    if (first < 0) {
+                        first = k;
+                    }
+                    bank.weights[count++] = q;
+                    last = k;
+                }
+            }
+            bank.start[m] = (uint16_t)(first < 0 ? 0 : first);
+            bank.length[m] = (uint16_t)(first < 0 ? 0 : last - first + 1);
+        }
+        bank.weight_count = count;
+        return bank;
+    }
+
+    // 모든 mel 필터가 적어도 bin 하나를 가지는지 (FFT가 너무 작거나 필터가 너무 많으면 빈 필터가 생김)
+    static constexpr bool mel_filters_nonempty() {
+        const auto bank = mel();
+        for (int m = 0; m < MelBins; m++) {
+            if (bank.length[m] == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+}  // namespace dsp_tables
+
+#endif // __cplusplus
+
+#endif // DSP_TABLES_H
@@ -0,0 +1,38 @@
+#include "energy_vad.h"
+
+#define VAD_INITIAL_NOISE   (200 << 8)  // 처음 소음 레벨 추정값 (Q8)
+#define VAD_RISE_SHIFT      6           // 소음 레벨이 올라갈 때는 천천히 (1/64씩)
+#define VAD_FALL_SHIFT      2           // 내려갈 때는 빠르게 (1/4씩)
+
+void energy_vad_init(energy_vad_t *vad) {
+    vad->noise_floor = VAD_INITIAL_NOISE;
+    vad->level = 0;
+    vad->speech_ratio_q8 = 3 << 8;
+    vad->min_level = 100;
+}
+
+bool energy_vad_process(energy_vad_t *vad, const int16_t *samples, size_t count) {
+    if (count == 0) {
+        return false;
+    }
+
+    // 블록 평균 절대값 (제곱보다 가볍고, 비교용으로는 충분함)
+    uint32_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        int32_t s = samples[i];
+        sum += (uint32_t)(s < 0 ? -s : s);
+    }
+    uint32_t level = (uint32_t)(((uint64_t)sum << 8) / count);
+    vad->level = level;
+
+    bool speech = level > ((uint64_t)vad->noise_floor * vad->speech_ratio_q8 >> 8) &&
+                  level > ((uint32_t)vad->min_level << 8);
+
+    // 음성 구간에서는 소음 레벨을 갱신하지 않음
+    if (level < vad->noise_floor) {
+        vad->noise_floor -= (vad->noise_floor - level) >> VAD_FALL_SHIFT;
+    } else if (!speech) {
+        vad->noise_floor += (level - vad->noise_floor) >> VAD_RISE_SHIFT;
+    }
+    return speech;
+}
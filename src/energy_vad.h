@@ -0,0 +1,30 @@
+#ifndef ENERGY_VAD_H
+#define ENERGY_VAD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 블록 단위 에너지 기반 음성 구간 검출(VAD)
+// 배경 소음 레벨을 천천히 따라가고, 블록 레벨이 소음보다 충분히 크면 음성으로 판단합니다.
+typedef struct {
+    uint32_t noise_floor;       // 배경 소음 평균 절대값 (Q8)
+    uint32_t level;             // 마지막 블록 평균 절대값 (Q8)
+    uint16_t speech_ratio_q8;   // 음성 판단 배율 (Q8, 768이면 소음의 3배 = 약 10dB)
+    uint16_t min_level;         // 이 값보다 작은 블록은 항상 무음 (정수 샘플 단위)
+} energy_vad_t;
+
+void energy_vad_init(energy_vad_t *vad);
+
+// 블록 하나를 처리하고 음성이면 true
+bool energy_vad_process(energy_vad_t *vad, const int16_t *samples, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENERGY_VAD_H
@@ -0,0 +1,83 @@
+#include "fft_q15.h"
+
+static void bit_reverse(int16_t *data, int n) {
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            int16_t re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+}
+
+static int32_t max_abs(const int16_t *data, int count) {
+    int32_t m0 = 0, m1 = 0;
+    for (int i = 0; i < count; i += 2) {
+        int32_t a = data[i], b = data[i + 1];
+        a = a < 0 ? -a : a;
+        b = b < 0 ? -b : b;
+        m0 = a > m0 ? a : m0;
+        m1 = b > m1 ? b : m1;
+    }
+    return m0 > m1 ? m0 : m1;
+}
+
+static void halve(int16_t *data, int count) {
+    for (int i = 0; i < count; i++) {
+        data[i] = (int16_t)((data[i] + 1) >> 1);
+    }
+}
+
+int fft_q15(int16_t *data, int log2n, const int16_t *twiddle) {
+    const int n = 1 << log2n;
+    int shift = 0;
+
+    bit_reverse(data, n);
+
+    for (int len = 2; len <= n; len <<= 1) {
+        if (max_abs(data, 2 * n) > FFT_Q15_SCALE_THRESHOLD) {
+            halve(data, 2 * n);
+            shift++;
+        }
+
+        const int half = len >> 1;
+        const int step = n / len;  // 트위들 인덱스 간격
+        for (int start = 0; start < n; start += len) {
+            for (int k = 0; k < half; k++) {
+                const int32_t wr = twiddle[2 * k * step];
+                const int32_t wi = twiddle[2 * k * step + 1];
+                int16_t *a = data + 2 * (start + k);
+                int16_t *b = data + 2 * (start + k + half);
+
+                int32_t tr = (b[0] * wr - b[1] * wi + (1 << 14)) >> 15;
+                int32_t ti = (b[0] * wi + b[1] * wr + (1 << 14)) >> 15;
+                int32_t ar = a[0], ai = a[1];
+                a[0] = (int16_t)(ar + tr);
+                a[1] = (int16_t)(ai + ti);
+                b[0] = (int16_t)(ar - tr);
+                b[1] = (int16_t)(ai - ti);
+            }
+        }
+    }
+    return shift;
+}
+
+int ifft_q15(int16_t *data, int log2n, const int16_t *twiddle) {
+    // IDFT(X) = conj(DFT(conj(X))) / N
+    const int n = 1 << log2n;
+    for (int i = 0; i < n; i++) {
+        data[2 * i + 1] = (int16_t)(data[2 * i + 1] == -32768 ? 32767 : -data[2 * i + 1]);
+    }
+    int shift = fft_q15(data, log2n, twiddle);
+    for (int i = 0; i < n; i++) {
+        data[2 * i + 1] = (int16_t)(data[2 * i + 1] == -32768 ? 32767 : -data[2 * i + 1]);
+    }
+    return shift;
+}
@@ -0,0 +1,28 @@
+#ifndef FFT_Q15_H
+#define FFT_Q15_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 고정소수점(Q15) 복소수 FFT (radix-2, in-place)
+// data: 실수/허수가 번갈아 들어있는 int16 배열 (길이 2 * 2^log2n)
+// twiddle: k = 0..N/2-1에 대해 {cos(2πk/N), -sin(2πk/N)} (Q15)
+//
+// 오버플로를 막기 위해 단계마다 최대값을 확인해서 필요할 때만 1/2로 줄입니다. (블록 부동소수점)
+// 단계 시작 전 최대값이 이 값 이하면 버터플라이 결과가 int16을 넘지 않음 (|a| + |b·w| <= m + m·√2 <= 32767)
+#define FFT_Q15_SCALE_THRESHOLD 13000
+
+// 반환값 s: 실제 DFT = 결과 * 2^s
+int fft_q15(int16_t *data, int log2n, const int16_t *twiddle);
+
+// 역변환: 실제 IDFT(1/N 포함) = 결과 * 2^(반환값 - log2n)
+int ifft_q15(int16_t *data, int log2n, const int16_t *twiddle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FFT_Q15_H
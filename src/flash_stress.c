@@ -0,0 +1,85 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_partition.h"
+#include "spi_flash_mmap.h"
+#include "esp_log.h"
+#include "flash_stress.h"
+
+static const char *TAG = "FLASH_STRESS";
+
+#define STRESS_PRIORITY 3  // 명령(5)보다 낮게, 다른 코어에서는 혼자 돌도록
+#define PAGE_SIZE 256
+
+static const esp_partition_t *partition;
+static uint8_t page[PAGE_SIZE];
+static volatile bool running;
+static volatile uint32_t erases;
+static volatile uint32_t writes;
+static SemaphoreHandle_t stopped;
+
+bool flash_stress_init(void) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                         (esp_partition_subtype_t)FLASH_STRESS_PARTITION_SUBTYPE,
+                                         FLASH_STRESS_PARTITION_LABEL);
+    if (!partition || partition->size < SPI_FLASH_SEC_SIZE) {
+        ESP_LOGW(TAG, "Stress partition not found (partitions.csv).");
+        partition = NULL;
+        return false;
+    }
+    // 전용 파티션이라 내용은 버려도 됨 (부하 도중 리셋되어 남은 페이지도 여기서 지움)
+    if (esp_partition_erase_range(partition, 0, SPI_FLASH_SEC_SIZE) != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to erase stress sector.");
+        partition = NULL;
+        return false;
+    }
+    if (!stopped) {
+        stopped = xSemaphoreCreateBinary();
+    }
+    return true;
+}
+
+static void stress_task(void *arg) {
+    uint32_t pages = 0;
+    while (running) {
+        if (pages == SPI_FLASH_SEC_SIZE / PAGE_SIZE) {
+            esp_partition_erase_range(partition, 0, SPI_FLASH_SEC_SIZE);
+            erases = erases + 1;
+            pages = 0;
+        }
+        memset(page, (int)(pages * 17 + erases), PAGE_SIZE);  // 페이지마다 다른 값
+        esp_partition_write(partition, pages * PAGE_SIZE, page, PAGE_SIZE);
+        writes = writes + 1;
+        pages++;
+        vTaskDelay(pdMS_TO_TICKS(FLASH_STRESS_INTERVAL_MS));
+    }
+    if (pages > 0) {
+        esp_partition_erase_range(partition, 0, SPI_FLASH_SEC_SIZE);  // 비운 상태로 돌려놓음
+    }
+    xSemaphoreGive(stopped);
+    vTaskDelete(NULL);
+}
+
+void flash_stress_start(void) {
+    if (!partition || running) {
+        return;
+    }
+    erases = 0;
+    writes = 0;
+    running = true;
+    xTaskCreatePinnedToCore(stress_task, "flash_stress", 2048, NULL, STRESS_PRIORITY, NULL, FLASH_STRESS_CORE);
+}
+
+void flash_stress_stop(void) {
+    if (!partition || !running) {
+        return;
+    }
+    running = false;
+    xSemaphoreTake(stopped, portMAX_DELAY);
+}
+
+void flash_stress_counts(uint32_t *erases_out, uint32_t *writes_out) {
+    *erases_out = erases;
+    *writes_out = writes;
+}
@@ -0,0 +1,41 @@
+#ifndef FLASH_STRESS_H
+#define FLASH_STRESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// flash 쓰기 부하 (장치, PLACEMENT_BENCH): 다른 코어에서 섹터 하나에 페이지를 계속 쓰고, 다 차면 지움
+// - flash를 쓰거나 지우는 동안에는 캐시가 꺼지고 다른 코어도 멈춤 (IRAM 배치와 상관없음).
+//   끝난 뒤 flash에서 실행하던 코드/상수는 캐시를 다시 채우면서 느려지므로, 배치별 Invoke() 시간 차이가 여기서 드러남
+// - 부하 전용 파티션(partitions.csv의 "stress", 섹터 하나)만 씀. 모델 슬롯, 블랙박스와 겹치지 않으므로
+//   MODEL_UPDATE가 같이 와도 모델 데이터를 건드리지 않음. 시작 전에 지우고, 멈출 때 다시 지워서 비운 상태로 돌려놓음
+
+#define FLASH_STRESS_PARTITION_LABEL   "stress"
+#define FLASH_STRESS_PARTITION_SUBTYPE 0x42  // partitions.csv의 SubType과 동일
+
+#ifndef FLASH_STRESS_INTERVAL_MS
+#define FLASH_STRESS_INTERVAL_MS 10  // 페이지(256바이트) 쓰기 간격 (16페이지마다 섹터 지우기)
+#endif
+#ifndef FLASH_STRESS_CORE
+#define FLASH_STRESS_CORE 1  // 추론 태스크(app_main)와 다른 코어
+#endif
+
+// 부하를 줄 섹터를 찾아서 지움. 파티션이 없으면 false
+bool flash_stress_init(void);
+
+// 부하 태스크 시작/멈춤 (stop은 태스크가 섹터를 지우고 끝날 때까지 기다림)
+void flash_stress_start(void);
+void flash_stress_stop(void);
+
+// start 이후 지운 횟수, 쓴 페이지 수
+void flash_stress_counts(uint32_t *erases, uint32_t *writes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLASH_STRESS_H
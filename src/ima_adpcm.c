@@ -0,0 +1,79 @@
+#include "ima_adpcm.h"
+
+static const int16_t step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+static const int8_t index_table[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+void ima_adpcm_init(ima_adpcm_state_t *state) {
+    state->predictor = 0;
+    state->index = 0;
+}
+
+// 코드 하나를 적용해서 상태를 갱신 (인코더와 디코더가 같은 계산으로 같은 상태를 유지)
+static inline void apply_code(ima_adpcm_state_t *state, uint8_t code) {
+    int step = step_table[state->index];
+    int diff = step >> 3;
+    if (code & 4) {
+        diff += step;
+    }
+    if (code & 2) {
+        diff += step >> 1;
+    }
+    if (code & 1) {
+        diff += step >> 2;
+    }
+    int predictor = state->predictor + ((code & 8) ? -diff : diff);
+    state->predictor = (int16_t)(predictor < -32768 ? -32768 : (predictor > 32767 ? 32767 : predictor));
+    int index = state->index + index_table[code & 7];
+    state->index = (uint8_t)(index < 0 ? 0 : (index > 88 ? 88 : index));
+}
+
+static inline uint8_t encode_sample(ima_adpcm_state_t *state, int16_t sample) {
+    int step = step_table[state->index];
+    int diff = sample - state->predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+    }
+    apply_code(state, code);
+    return code;
+}
+
+void ima_adpcm_encode(ima_adpcm_state_t *state, const int16_t *in, uint8_t *out, size_t count) {
+    for (size_t i = 0; i + 1 < count; i += 2) {
+        uint8_t low = encode_sample(state, in[i]);
+        uint8_t high = encode_sample(state, in[i + 1]);
+        out[i / 2] = (uint8_t)(low | (high << 4));
+    }
+    if (count & 1) {
+        out[count / 2] = encode_sample(state, in[count - 1]);
+    }
+}
+
+void ima_adpcm_decode(ima_adpcm_state_t *state, const uint8_t *in, int16_t *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint8_t code = (i & 1) ? (in[i / 2] >> 4) : (in[i / 2] & 0x0F);
+        apply_code(state, code);
+        out[i] = state->predictor;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef IMA_ADPCM_H
+#define IMA_ADPCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// IMA ADPCM (4비트, 16비트 PCM의 1/4 크기)
+// 바이트 하나에 샘플 두 개 (앞 샘플이 아래 4비트, WAV IMA ADPCM과 같은 순서)
+// 블록 단위로 나눠 저장할 때는 블록 앞에 상태(predictor, index)를 같이 저장하면 블록부터 바로 디코딩할 수 있습니다.
+
+typedef struct {
+    int16_t predictor;  // 마지막으로 복원한 샘플
+    uint8_t index;      // 스텝 테이블 위치 (0~88)
+} ima_adpcm_state_t;
+
+void ima_adpcm_init(ima_adpcm_state_t *state);
+
+// count 샘플 → (count + 1) / 2 바이트
+void ima_adpcm_encode(ima_adpcm_state_t *state, const int16_t *in, uint8_t *out, size_t count);
+
+// (count + 1) / 2 바이트 → count 샘플
+void ima_adpcm_decode(ima_adpcm_state_t *state, const uint8_t *in, int16_t *out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IMA_ADPCM_H
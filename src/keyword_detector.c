@@ -0,0 +1,78 @@
+#include <string.h>
+#include "keyword_detector.h"
+
+// 모델이 Softmax로 끝나므로 출력은 클래스별 확률입니다.
+// 한 번의 추론 결과만 보고 판단하면 튀는 값 하나에 오검출이 나기 때문에,
+// 클래스마다 최근 smoothing번의 확률을 이동 평균한 뒤 클래스별 임계값과 비교합니다.
+// 한 번의 추론으로 호출어와 짧은 명령어를 모두 판별하므로 검출기를 따로 돌릴 필요가 없습니다.
+
+bool keyword_detector_init(keyword_detector_t *det, const keyword_class_t *classes, size_t num_classes) {
+    if (num_classes == 0 || num_classes > KEYWORD_MAX_CLASSES) {
+        return false;
+    }
+    for (size_t c = 0; c < num_classes; c++) {
+        if (classes[c].smoothing == 0 || classes[c].smoothing > KEYWORD_MAX_SMOOTHING) {
+            return false;
+        }
+    }
+
+    det->classes = classes;
+    det->num_classes = num_classes;
+    keyword_detector_reset(det);
+    return true;
+}
+
+void keyword_detector_reset(keyword_detector_t *det) {
+    memset(det->history, 0, sizeof(det->history));
+    memset(det->sum, 0, sizeof(det->sum));
+    memset(det->count, 0, sizeof(det->count));
+    memset(det->cooldown, 0, sizeof(det->cooldown));
+    det->head = 0;
+}
+
+int keyword_detector_update(keyword_detector_t *det, const float *scores, size_t num_scores, float *smoothed) {
+    if (num_scores != det->num_classes) {
+        return -1;  // 라벨 테이블과 모델 출력 개수가 다르면 판단하지 않음
+    }
+
+    int detected = -1;
+    float best = 0.0f;
+
+    for (size_t c = 0; c < det->num_classes; c++) {
+        const keyword_class_t *cls = &det->classes[c];
+
+        // 이동 평균: 창(smoothing) 밖으로 밀려나는 값을 빼고 새 값을 더함
+        if (det->count[c] >= cls->smoothing) {
+            det->sum[c] -= det->history[c][(det->head + KEYWORD_MAX_SMOOTHING - cls->smoothing) % KEYWORD_MAX_SMOOTHING];
+        } else {
+            det->count[c]++;
+        }
+        det->history[c][det->head] = scores[c];
+        det->sum[c] += scores[c];
+
+        float average = det->sum[c] / det->count[c];
+        if (smoothed) {
+            smoothed[c] = average;
+        }
+
+        if (det->cooldown[c] > 0) {
+            det->cooldown[c]--;
+            continue;
+        }
+        if (cls->background || average < cls->threshold) {
+            continue;
+        }
+        // 여러 클래스가 동시에 임계값을 넘으면 평균 확률이 가장 높은 클래스를 선택
+        if (detected < 0 || average > best) {
+            detected = (int)c;
+            best = average;
+        }
+    }
+
+    det->head = (det->head + 1) % KEYWORD_MAX_SMOOTHING;
+
+    if (detected >= 0) {
+        det->cooldown[detected] = det->classes[detected].refractory;
+    }
+    return detected;
+}
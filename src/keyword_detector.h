@@ -0,0 +1,48 @@
+#ifndef KEYWORD_DETECTOR_H
+#define KEYWORD_DETECTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KEYWORD_MAX_CLASSES   8   // 모델 출력 클래스 최대 개수
+#define KEYWORD_MAX_SMOOTHING 8   // 평균을 낼 수 있는 최대 추론 횟수
+
+// 클래스별 설정(라벨 테이블). 모델 출력 텐서의 인덱스 순서와 같아야 합니다.
+typedef struct {
+    const char *label;          // 클래스 이름 (예: "리지야", "온도")
+    float threshold;            // 평활화된 확률이 이 값을 넘으면 검출
+    uint8_t smoothing;          // 최근 몇 번의 추론 결과를 평균낼지 (1이면 평활화 없음)
+    uint8_t refractory;         // 검출 후 같은 클래스를 다시 검출하지 않을 추론 횟수
+    bool background;            // silence/unknown 같은 배경 클래스는 검출 이벤트를 만들지 않음
+} keyword_class_t;
+
+typedef struct {
+    const keyword_class_t *classes;
+    size_t num_classes;
+    float history[KEYWORD_MAX_CLASSES][KEYWORD_MAX_SMOOTHING]; // 클래스별 최근 확률
+    float sum[KEYWORD_MAX_CLASSES];                            // history 합계 (이동 평균용)
+    uint8_t count[KEYWORD_MAX_CLASSES];                        // history에 채워진 개수
+    uint8_t head;                                              // history 쓰기 위치
+    uint8_t cooldown[KEYWORD_MAX_CLASSES];                     // 남은 refractory 횟수
+} keyword_detector_t;
+
+// 라벨 테이블로 검출기를 초기화합니다. 클래스 수가 범위를 벗어나면 false.
+bool keyword_detector_init(keyword_detector_t *det, const keyword_class_t *classes, size_t num_classes);
+
+// 평활화 상태를 초기화합니다. (모델 교체, 오디오 끊김 후)
+void keyword_detector_reset(keyword_detector_t *det);
+
+// 한 번의 추론 결과(클래스별 확률)를 반영합니다.
+// 검출된 클래스 인덱스를 반환하고, 없으면 -1. smoothed가 NULL이 아니면 평활화된 확률을 채워줍니다.
+int keyword_detector_update(keyword_detector_t *det, const float *scores, size_t num_scores, float *smoothed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEYWORD_DETECTOR_H
@@ -0,0 +1,93 @@
+#include <string.h>
+#include "layer_pipeline.h"
+
+#ifdef ESP_PLATFORM
+static bool slot_sem_create(layer_pipeline_sem_t *sem, unsigned count) {
+    *sem = xSemaphoreCreateCounting(LAYER_PIPELINE_SLOTS, count);
+    return *sem != NULL;
+}
+
+static void slot_sem_delete(layer_pipeline_sem_t *sem) {
+    vSemaphoreDelete(*sem);
+}
+
+static void slot_sem_take(layer_pipeline_sem_t *sem) {
+    xSemaphoreTake(*sem, portMAX_DELAY);
+}
+
+static void slot_sem_give(layer_pipeline_sem_t *sem) {
+    xSemaphoreGive(*sem);
+}
+#else
+#include <errno.h>
+
+static bool slot_sem_create(layer_pipeline_sem_t *sem, unsigned count) {
+    return sem_init(sem, 0, count) == 0;
+}
+
+static void slot_sem_delete(layer_pipeline_sem_t *sem) {
+    sem_destroy(sem);
+}
+
+static void slot_sem_take(layer_pipeline_sem_t *sem) {
+    while (sem_wait(sem) != 0 && errno == EINTR) {
+    }
+}
+
+static void slot_sem_give(layer_pipeline_sem_t *sem) {
+    sem_post(sem);
+}
+#endif
+
+bool layer_pipeline_init(layer_pipeline_t *p, uint8_t *memory, size_t slot_bytes) {
+    memset(p, 0, sizeof(*p));
+    p->slot_bytes = slot_bytes;
+    for (int i = 0; i < LAYER_PIPELINE_SLOTS; i++) {
+        p->slots[i].data = memory + i * slot_bytes;
+    }
+    if (!slot_sem_create(&p->free_slots, LAYER_PIPELINE_SLOTS)) {
+        return false;
+    }
+    if (!slot_sem_create(&p->full_slots, 0)) {
+        slot_sem_delete(&p->free_slots);
+        return false;
+    }
+    return true;
+}
+
+void layer_pipeline_deinit(layer_pipeline_t *p) {
+    slot_sem_delete(&p->free_slots);
+    slot_sem_delete(&p->full_slots);
+}
+
+layer_pipeline_slot_t *layer_pipeline_acquire(layer_pipeline_t *p) {
+    slot_sem_take(&p->free_slots);
+    return &p->slots[p->head % LAYER_PIPELINE_SLOTS];
+}
+
+void layer_pipeline_submit(layer_pipeline_t *p) {
+    p->head++;
+    p->submitted++;
+    slot_sem_give(&p->full_slots);  // 세마포어가 슬롯 내용의 메모리 순서도 보장
+}
+
+layer_pipeline_slot_t *layer_pipeline_next(layer_pipeline_t *p) {
+    slot_sem_take(&p->full_slots);
+    return &p->slots[p->tail % LAYER_PIPELINE_SLOTS];
+}
+
+void layer_pipeline_release(layer_pipeline_t *p) {
+    p->tail++;
+    p->completed++;
+    slot_sem_give(&p->free_slots);
+}
+
+void layer_pipeline_drain(layer_pipeline_t *p) {
+    // 빈 슬롯을 모두 가져오면 뒤 단계가 넘긴 슬롯을 다 끝낸 것 (그 뒤 돌려놓음)
+    for (int i = 0; i < LAYER_PIPELINE_SLOTS; i++) {
+        slot_sem_take(&p->free_slots);
+    }
+    for (int i = 0; i < LAYER_PIPELINE_SLOTS; i++) {
+        slot_sem_give(&p->free_slots);
+    }
+}
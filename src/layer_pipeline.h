@@ -0,0 +1,66 @@
+#ifndef LAYER_PIPELINE_H
+#define LAYER_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+typedef SemaphoreHandle_t layer_pipeline_sem_t;
+#else
+#include <semaphore.h>
+typedef sem_t layer_pipeline_sem_t;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 두 단계 추론 파이프라인의 중간 텐서 이중 버퍼 (INFERENCE_PIPELINE, src/model_split.h)
+// - 앞 단계 태스크(생산자 하나)가 빈 슬롯에 경계 텐서를 쓰고 넘기면, 뒤 단계 태스크(소비자 하나)가 순서대로 꺼내서 실행
+// - 슬롯이 두 개라서 뒤 단계가 hop N을 실행하는 동안 앞 단계가 hop N+1을 실행할 수 있음
+//   (두 슬롯이 다 차 있으면 앞 단계가 기다림: 뒤 단계가 밀려도 경계 텐서를 덮어쓰지 않음)
+// - 장치: FreeRTOS 세마포어, 호스트: POSIX 세마포어 (host/sim_pipeline.c가 두 스레드로 같은 코드 사용)
+
+#define LAYER_PIPELINE_SLOTS 2
+
+typedef struct {
+    uint8_t *data;       // 경계 텐서 (slot_bytes)
+    uint32_t tag;        // 호출하는 쪽 값 (hop 위치 등)
+    int64_t start_us;    // 앞 단계 시작 시각 (지연 측정)
+    uint32_t front_us;   // 앞 단계 실행 시간
+} layer_pipeline_slot_t;
+
+typedef struct {
+    layer_pipeline_slot_t slots[LAYER_PIPELINE_SLOTS];
+    size_t slot_bytes;
+    uint32_t head;                  // 다음에 채울 슬롯 (생산자만)
+    uint32_t tail;                  // 다음에 꺼낼 슬롯 (소비자만)
+    layer_pipeline_sem_t free_slots;
+    layer_pipeline_sem_t full_slots;
+    volatile uint32_t submitted;
+    volatile uint32_t completed;
+} layer_pipeline_t;
+
+// memory: LAYER_PIPELINE_SLOTS * slot_bytes (4바이트 정렬)
+bool layer_pipeline_init(layer_pipeline_t *p, uint8_t *memory, size_t slot_bytes);
+void layer_pipeline_deinit(layer_pipeline_t *p);
+
+// (앞 단계) 빈 슬롯을 기다려서 받음 → 채운 뒤 submit
+layer_pipeline_slot_t *layer_pipeline_acquire(layer_pipeline_t *p);
+void layer_pipeline_submit(layer_pipeline_t *p);
+
+// (뒤 단계) 찬 슬롯을 순서대로 기다려서 받음 → 끝나면 release
+layer_pipeline_slot_t *layer_pipeline_next(layer_pipeline_t *p);
+void layer_pipeline_release(layer_pipeline_t *p);
+
+// (앞 단계) 넘긴 슬롯을 뒤 단계가 모두 끝낼 때까지 기다림 (모델 교체, 벤치, 주입처럼 뒤 단계 상태를 건드리기 전에)
+void layer_pipeline_drain(layer_pipeline_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LAYER_PIPELINE_H
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <string.h>
+#include "link_rate.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_rom_crc.h"
+#endif
+
+uint32_t link_rate_crc32(uint32_t crc, const void *data, size_t size) {
+#ifdef ESP_PLATFORM
+    return esp_rom_crc32_le(crc, (const uint8_t *)data, size);
+#else
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++) {
+            crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+    }
+    return ~crc;
+#endif
+}
+
+static void send_line(const link_rate_io_t *io, const char *line) {
+    io->write(io->user, line, strlen(line));
+}
+
+// 시험 데이터: xorshift32 (모든 바이트 값이 고르게 나오고 태그/줄바꿈도 섞임)
+static void fill_pattern(uint32_t *state, uint8_t *buffer, size_t size) {
+    uint32_t x = *state;
+    for (size_t i = 0; i < size; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buffer[i] = (uint8_t)(x >> 24);
+    }
+    *state = x;
+}
+
+static uint32_t test_crc(uint32_t seed, uint32_t bytes, uint8_t *buffer, size_t buffer_size) {
+    uint32_t state = seed;
+    uint32_t crc = 0;
+    for (uint32_t offset = 0; offset < bytes; offset += buffer_size) {
+        size_t n = bytes - offset < buffer_size ? bytes - offset : buffer_size;
+        fill_pattern(&state, buffer, n);
+        crc = link_rate_crc32(crc, buffer, n);
+    }
+    return crc;
+}
+
+// 새 속도에서 expected가 들어있는 줄을 기다림 (속도를 바꾸는 순간 앞에 붙은 잡음은 건너뜀). 반환: expected 위치
+static const char *wait_line(const link_rate_io_t *io, const char *expected, char *line, size_t size, uint32_t timeout_ms) {
+    while (1) {
+        int length = io->read_line(io->user, line, size, timeout_ms);
+        if (length < 0) {
+            return NULL;
+        }
+        const char *found = strstr(line, expected);
+        if (found) {
+            return found;
+        }
+        if (length > 0) {
+            return NULL;  // 다른 명령이나 깨진 줄: 이 속도는 쓸 수 없음
+        }
+    }
+}
+
+uint32_t link_rate_serve(const link_rate_io_t *io, uint32_t current, uint32_t baud, uint32_t bytes, uint8_t *buffer,
+                         size_t buffer_size) {
+    char line[64];
+    if (baud < LINK_RATE_MIN_BAUD || baud > LINK_RATE_MAX_BAUD) {
+        send_line(io, "LINK_RATE_ERROR baud\n");
+        return current;
+    }
+    if (bytes == 0 || bytes > LINK_RATE_MAX_TEST_BYTES || buffer_size == 0) {
+        send_line(io, "LINK_RATE_ERROR size\n");
+        return current;
+    }
+    // 헤더에 CRC를 먼저 보내야 하므로 시험 데이터를 한 번 만들어서 CRC만 구하고, 보낼 때 다시 만듦
+    uint32_t seed = (baud ^ (bytes << 1) ^ 0x9E3779B9u) | 1u;  // xorshift 상태는 0이면 안 됨
+    uint32_t crc = test_crc(seed, bytes, buffer, buffer_size);
+
+    snprintf(line, sizeof(line), "LINK_RATE_OK %lu\n", (unsigned long)baud);
+    send_line(io, line);
+    io->set_baud(io->user, baud);
+
+    bool kept = false;
+    if (wait_line(io, "LINK_PING", line, sizeof(line), LINK_RATE_TIMEOUT_MS)) {
+        snprintf(line, sizeof(line), "LINK_TEST %lu %08lx\n", (unsigned long)bytes, (unsigned long)crc);
+        send_line(io, line);
+        uint32_t state = seed;
+        for (uint32_t offset = 0; offset < bytes; offset += buffer_size) {
+            size_t n = bytes - offset < buffer_size ? bytes - offset : buffer_size;
+            fill_pattern(&state, buffer, n);
+            io->write(io->user, buffer, n);
+        }
+        // PC가 다 받을 때까지 걸리는 시간 (10비트/바이트)만큼 더 기다림
+        uint32_t transfer_ms = (uint32_t)((uint64_t)bytes * 10 * 1000 / baud);
+        const char *keep = wait_line(io, "LINK_KEEP", line, sizeof(line), LINK_RATE_TIMEOUT_MS + transfer_ms);
+        unsigned long echoed;
+        if (keep && sscanf(keep, "LINK_KEEP %lx", &echoed) == 1 && (uint32_t)echoed == crc) {
+            snprintf(line, sizeof(line), "LINK_KEPT %lu\n", (unsigned long)baud);
+            send_line(io, line);
+            kept = true;
+        }
+    }
+    if (!kept) {
+        io->set_baud(io->user, current);
+        return current;
+    }
+    return baud;
+}
@@ -0,0 +1,53 @@
+#ifndef LINK_RATE_H
+#define LINK_RATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// UART 속도 협상 (장치 쪽, 플랫폼 독립): PC(scripts/link_rate.py)가 LINK_RATE 명령으로 속도를 한 단계씩 올려봄
+// 부팅 속도(UART_BAUD_RATE, monitor_speed와 같음)는 그대로이고, 협상한 속도는 리셋하면 돌아갑니다.
+//   PC   (지금 속도) LINK_RATE <baud> <bytes>
+//   장치 (지금 속도) LINK_RATE_OK <baud>        (못 하면 LINK_RATE_ERROR <이유>)
+//                    → 보낸 줄이 다 나간 뒤 새 속도로 바꾸고 수신 버퍼를 비움
+//   PC   (새 속도)   LINK_PING
+//   장치 (새 속도)   LINK_TEST <bytes> <crc32>  + 의사난수 <bytes>바이트 (PC가 받은 시간으로 실제 처리량을 잼)
+//   PC   (새 속도)   LINK_KEEP <받은 데이터의 crc32>   (CRC가 다르면 보내지 않고 이전 속도로)
+//   장치 (새 속도)   LINK_KEPT <baud>
+// 장치는 LINK_PING, LINK_KEEP을 제시간에 받지 못하거나 CRC가 다르면 이전 속도로 돌아갑니다.
+// PC도 LINK_KEPT를 받아야 새 속도를 유지하므로, 어느 쪽이든 오류가 나면 둘 다 이전 속도에서 다시 만남
+// 호스트: host/sim_wake_word --pty가 같은 코드로 응답 (scripts/link_rate.py --emulate)
+
+#define LINK_RATE_MIN_BAUD 115200
+#define LINK_RATE_MAX_BAUD 3000000           // CP2102N 최대 (ESP32 UART는 더 빠름)
+#define LINK_RATE_MAX_TEST_BYTES (256 * 1024)
+#ifndef LINK_RATE_TIMEOUT_MS
+#define LINK_RATE_TIMEOUT_MS 1000            // 새 속도에서 PC 응답을 기다리는 시간 (시험 데이터 전송 시간은 따로 더함)
+#endif
+
+typedef struct {
+    // '\n'까지 한 줄 ('\r', '\n'은 제거). 읽은 길이, 시간 초과면 -1
+    int (*read_line)(void *user, char *line, size_t size, uint32_t timeout_ms);
+    void (*write)(void *user, const void *data, size_t size);
+    // 지금까지 보낸 데이터가 다 나간 뒤 속도를 바꾸고 수신 버퍼를 비움
+    void (*set_baud)(void *user, uint32_t baud);
+    void *user;
+} link_rate_io_t;
+
+// esp_rom_crc32_le(0, ...)와 같은 CRC32 (zlib.crc32)
+uint32_t link_rate_crc32(uint32_t crc, const void *data, size_t size);
+
+// LINK_RATE <baud> <bytes> 명령 하나 처리 (명령 줄은 current 속도로 받았음)
+// buffer: 시험 데이터를 만들어 보낼 임시 버퍼. 반환: 끝난 뒤의 속도 (실패하면 current)
+uint32_t link_rate_serve(const link_rate_io_t *io, uint32_t current, uint32_t baud, uint32_t bytes, uint8_t *buffer,
+                         size_t buffer_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINK_RATE_H
@@ -5,18 +5,29 @@
 #include "driver/uart.h"
 #include "esp_log.h"
 #include "esp_system.h"
+#include "uart_link.h"
+#include "audio_conditioning.h"
+#include "pcm_convert.h"
+#include "audio_config.h"
+#include "decimator.h"
+#include "audio_pool.h"
 
 #define I2S_NUM         I2S_NUM_0
-#define SAMPLE_RATE     16000
+#define SAMPLE_RATE     I2S_SAMPLE_RATE
 #define DMA_BUFFER_COUNT 2
 #define I2S_BUFFER_SIZE 4000  // I2S 데이터 처리를 위해 필요한 전체 DMA 버퍼 크기
 #define RECORDING_SECONDS 5  // 녹음 시간 (초)
-#define RECORDING_SIZE  (SAMPLE_RATE * 2 * RECORDING_SECONDS)   // RECORDING_SECONDS초 데이터 크기
+#define RECORDING_SIZE  (MODEL_SAMPLE_RATE * 2 * RECORDING_SECONDS)   // RECORDING_SECONDS초 데이터 크기 (모델 레이트 기준)
 #define UART_BAUD_RATE  460800
-#define UART_CHUNK_SIZE 1000                       // UART 전송 청크 크기
 
 static const char *TAG = "INMP441_UART";
 
+// 녹음 버퍼 예산: 부팅 시 한 번 할당하고 녹음마다 풀에서 꺼내 씀 (녹음할 때마다 malloc/free 하지 않음)
+static const audio_pool_budget_t pool_budget[] = {
+    {"i2s", I2S_BUFFER_SIZE, 2, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},                 // 더블 버퍼
+    {"i2s_raw", I2S_BUFFER_SIZE * 2, MIC_32BIT_SLOT, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},  // 32비트 슬롯
+};
+
 // I2S가 오디오 데이터를 읽고, DMA가 메모리로 전송하며, UART가 데이터를 외부로 전달.
 
 // INMP441 마이크: 아날로그 신호 → ADC → I2S 디지털 신호
@@ -40,7 +51,7 @@ static const char *TAG = "INMP441_UART";
 // 2. UART 하드웨어는 송신 FIFO를 통해 데이터를 송출하며, 외부 장치(예: PC)에서 수신됩니다.
 
 // **메모리 할당**:
-// - `record_and_send_audio` 함수는 녹음 데이터를 저장하기 위해 SRAM에서 DMA 버퍼 크기에 따라 동적으로 메모리를 할당합니다.
+// - `record_and_send_audio` 함수는 녹음 데이터를 저장하기 위해 부팅 시 할당해둔 풀(pool_budget)에서 버퍼를 꺼내 씁니다.
 // - ESP32의 SRAM은 약 520KB이며, 시스템과 애플리케이션에 의해 공유되므로 적절한 메모리 관리가 필요합니다.
 
 // **UART 수신 버퍼**:
@@ -52,8 +63,9 @@ void i2s_init(i2s_chan_handle_t *i2s_rx_channel) {
     i2s_chan_config_t chan_cfg = {
         .id = I2S_NUM,
         .role = I2S_ROLE_MASTER,
-        .dma_desc_num = DMA_BUFFER_COUNT,
-        .dma_frame_num = I2S_BUFFER_SIZE / DMA_BUFFER_COUNT,
+        // 32비트 슬롯이면 프레임이 2배 커지므로 DMA 버퍼(최대 4092바이트)를 2배로 나눔
+        .dma_desc_num = DMA_BUFFER_COUNT * (MIC_32BIT_SLOT ? 2 : 1),
+        .dma_frame_num = I2S_BUFFER_SIZE / DMA_BUFFER_COUNT / (MIC_32BIT_SLOT ? 2 : 1),
         .auto_clear = true
     };
 
@@ -66,8 +78,9 @@ void i2s_init(i2s_chan_handle_t *i2s_rx_channel) {
             .mclk_multiple = I2S_MCLK_MULTIPLE_256
         },
         .slot_cfg = {
-            .data_bit_width = I2S_DATA_BIT_WIDTH_16BIT, // 데이터 비트: 16비트
-            .slot_bit_width = I2S_DATA_BIT_WIDTH_16BIT, // 슬롯 비트: 16비트
+            // 데이터/슬롯 비트: 16비트 (MIC_32BIT_SLOT이면 32비트 슬롯으로 받아서 16비트로 변환)
+            .data_bit_width = MIC_32BIT_SLOT ? I2S_DATA_BIT_WIDTH_32BIT : I2S_DATA_BIT_WIDTH_16BIT,
+            .slot_bit_width = MIC_32BIT_SLOT ? I2S_SLOT_BIT_WIDTH_32BIT : I2S_SLOT_BIT_WIDTH_16BIT,
             .slot_mode = I2S_SLOT_MODE_MONO,            // 모노 모드
             .slot_mask = I2S_STD_SLOT_LEFT              // 좌측 슬롯 사용
         },
@@ -84,68 +97,74 @@ void i2s_init(i2s_chan_handle_t *i2s_rx_channel) {
     ESP_LOGI(TAG, "I2S initialized successfully.");
 }
 
-void uart_init() {
-    uart_config_t uart_config = {
-        .baud_rate = UART_BAUD_RATE,
-        .data_bits = UART_DATA_8_BITS,
-        .parity = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE
-    };
-    ESP_ERROR_CHECK(uart_driver_install(UART_NUM_0, SAMPLE_RATE*2+1000, 0, 0, NULL, 0)); //SAMPLE_RATE*2+여유 공간
-    ESP_ERROR_CHECK(uart_param_config(UART_NUM_0, &uart_config));
-    ESP_LOGI(TAG, "UART initialized successfully.");
-}
-
-void send_uart_data(const uint8_t *data, size_t length) { //UART_CHUNK_SIZE를 활용하여 데이터를 나누어 전송
-    size_t bytes_remaining = length;
-    const uint8_t *current_position = data;
-
-    while (bytes_remaining > 0) {
-        // 남은 데이터 중 한 번에 보낼 크기 결정
-        size_t chunk_size = (bytes_remaining > UART_CHUNK_SIZE) ? UART_CHUNK_SIZE : bytes_remaining;
-
-        // UART로 데이터 전송
-        uart_write_bytes(UART_NUM_0, (const char *)current_position, chunk_size);
-
-        // 포인터 이동 및 남은 데이터 크기 감소
-        current_position += chunk_size;
-        bytes_remaining -= chunk_size;
-    }
-}
-
 void record_and_send_audio(i2s_chan_handle_t i2s_rx_channel) {
-    uint8_t *buffer_a = malloc(I2S_BUFFER_SIZE);
-    uint8_t *buffer_b = malloc(I2S_BUFFER_SIZE);
+    uint8_t *buffer_a = audio_pool_alloc(I2S_BUFFER_SIZE, AUDIO_POOL_CAP_DMA);
+    uint8_t *buffer_b = audio_pool_alloc(I2S_BUFFER_SIZE, AUDIO_POOL_CAP_DMA);
 
     if (!buffer_a || !buffer_b) {
         ESP_LOGE(TAG, "Memory allocation failed.");
-        if (buffer_a) free(buffer_a);
-        if (buffer_b) free(buffer_b);
+        audio_pool_free(buffer_a);
+        audio_pool_free(buffer_b);
         return;
     }
 
     uint8_t *current_buffer = buffer_a;
     uint8_t *send_buffer = buffer_b;
 
+#if MIC_32BIT_SLOT
+    // 32비트 슬롯으로 읽을 버퍼 (변환 후 16비트로 current_buffer에 저장)
+    int32_t *raw_buffer = audio_pool_alloc(I2S_BUFFER_SIZE * 2, AUDIO_POOL_CAP_DMA);
+    if (!raw_buffer) {
+        ESP_LOGE(TAG, "Memory allocation failed.");
+        audio_pool_free(buffer_a);
+        audio_pool_free(buffer_b);
+        return;
+    }
+#endif
+
+    // 추론(wake_word.cpp)과 같은 전처리를 적용해서, 녹음한 데이터로 학습한 모델의 입력과 맞춤
+    audio_conditioning_config_t conditioning_config;
+    audio_conditioning_default_config(&conditioning_config);
+    audio_conditioning_t conditioning;
+    audio_conditioning_init(&conditioning, &conditioning_config);
+
+#if MODEL_DECIMATION > 1
+    static decimator_t decimator;
+    decimator_init(&decimator);
+#endif
+
     size_t bytes_read = 0;
 
     ESP_LOGI(TAG, "Starting %d seconds recording.", RECORDING_SECONDS);
 
     for (int second = 0; second < RECORDING_SECONDS; second++) {
         // START 전송
-        uart_write_bytes(UART_NUM_0, "<DATA_START>", strlen("<DATA_START>"));
+        uart_link_send_str(UART_LINK_FRAME_START);
         
         // 각 버퍼를 처리하는 반복문(1초 분량 채울 때까지 버퍼 스왑 계속 ㄱㄱ)
         for (int buffer_index = 0; buffer_index < 8; buffer_index++) {
             // I2S에서 데이터 읽기
+#if MIC_32BIT_SLOT
+            ESP_ERROR_CHECK(i2s_channel_read(i2s_rx_channel, raw_buffer, I2S_BUFFER_SIZE * 2, &bytes_read, portMAX_DELAY));
+            bytes_read /= 2;  // int32 → int16
+            pcm_convert_s32_block(raw_buffer, (int16_t *)current_buffer, bytes_read / sizeof(int16_t), MIC_32BIT_MIN_SHIFT);
+#else
             ESP_ERROR_CHECK(i2s_channel_read(i2s_rx_channel, current_buffer, I2S_BUFFER_SIZE, &bytes_read, portMAX_DELAY));
+#endif
             if (bytes_read < I2S_BUFFER_SIZE) {
                 ESP_LOGW(TAG, "Incomplete I2S read for buffer %d: Expected %d bytes, got %d bytes.", 
                         buffer_index + 1, I2S_BUFFER_SIZE, bytes_read);
             }
+#if MODEL_DECIMATION > 1
+            // 모델 레이트(8kHz)로 녹음해서 학습 데이터와 추론 입력을 맞춤
+            bytes_read = decimator_process(&decimator, (int16_t *)current_buffer, bytes_read / sizeof(int16_t),
+                                           (int16_t *)current_buffer) * sizeof(int16_t);
+#endif
+            // 전처리 (DMA 버퍼 전체를 한 번에)
+            audio_conditioning_process(&conditioning, (int16_t *)current_buffer, bytes_read / sizeof(int16_t));
+
             // UART로 데이터 전송
-            send_uart_data(current_buffer, bytes_read);
+            uart_link_send(current_buffer, bytes_read);
 
             // 버퍼 스왑
             uint8_t *temp = current_buffer;
@@ -155,28 +174,35 @@ void record_and_send_audio(i2s_chan_handle_t i2s_rx_channel) {
 
 
         // END 전송
-        uart_write_bytes(UART_NUM_0, "<DATA_END>", strlen("<DATA_END>"));
+        uart_link_send_str(UART_LINK_FRAME_END);
 
         ESP_LOGI(TAG, "Finished sending data for second %d.", second + 1);
     }
 
     ESP_LOGI(TAG, "Recording and transmission completed.");
-    free(buffer_a);
-    free(buffer_b);
+    audio_pool_free(buffer_a);
+    audio_pool_free(buffer_b);
+#if MIC_32BIT_SLOT
+    audio_pool_free(raw_buffer);
+#endif
 }
 
 void app_main() {
     i2s_chan_handle_t i2s_rx_channel;
+    if (!audio_pool_init(pool_budget, sizeof(pool_budget) / sizeof(pool_budget[0]))) {
+        ESP_LOGE(TAG, "Failed to allocate audio pools!");
+        return;
+    }
     i2s_init(&i2s_rx_channel);
-    uart_init();
+    uart_link_init(UART_BAUD_RATE, SAMPLE_RATE*2+1000, 0); //SAMPLE_RATE*2+여유 공간
 
     esp_log_level_set("*", ESP_LOG_NONE); //모든 로그가 출력되지 않도록 함.
-    uart_flush(UART_NUM_0);               // UART 버퍼 비우기
+    uart_flush(UART_LINK_PORT);               // UART 버퍼 비우기
 
     char uart_command[32];
     while (1) {
         memset(uart_command, 0, sizeof(uart_command)); //uart_command 배열의 모든 바이트를 0
-        int len = uart_read_bytes(UART_NUM_0, uart_command, sizeof(uart_command) - 1, portMAX_DELAY);
+        int len = uart_read_bytes(UART_LINK_PORT, uart_command, sizeof(uart_command) - 1, portMAX_DELAY);
         if (len <= 0) {
             ESP_LOGW(TAG, "No command received.");
             continue;  // 명령이 없으면 루프 재시작
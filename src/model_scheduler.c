@@ -0,0 +1,205 @@
+#include <string.h>
+#include "model_scheduler.h"
+#include "boot_profile.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+
+static const char *TAG = "SCHED";
+#else
+#include <stdio.h>
+#endif
+
+#define COST_EMA_SHIFT 3  // 실행 시간 평균: 새 값의 1/8씩 반영
+
+void model_scheduler_init(model_scheduler_t *s, uint32_t budget_us, uint8_t max_defer) {
+    memset(s, 0, sizeof(*s));
+    s->budget_us = budget_us;
+    s->max_defer = max_defer;
+    s->report_time_us = boot_profile_now_us();
+}
+
+static model_scheduler_entry_t *add_entry(model_scheduler_t *s, const char *name) {
+    if (s->count >= MODEL_SCHEDULER_MAX_MODELS) {
+        return NULL;
+    }
+    model_scheduler_entry_t *e = &s->entries[s->count];
+    memset(e, 0, sizeof(*e));
+    e->name = name;
+    return e;
+}
+
+int model_scheduler_add(model_scheduler_t *s, const char *name, uint32_t hop_frames, uint8_t priority,
+                        uint32_t first_frame, model_scheduler_run_t run, void *user) {
+    if (hop_frames == 0 || run == NULL) {
+        return -1;
+    }
+    model_scheduler_entry_t *e = add_entry(s, name);
+    if (e == NULL) {
+        return -1;
+    }
+    e->run = run;
+    e->user = user;
+    e->hop_frames = hop_frames;
+    e->priority = priority;
+    e->next_frame = first_frame;
+    return (int)s->count++;
+}
+
+int model_scheduler_add_external(model_scheduler_t *s, const char *name) {
+    if (add_entry(s, name) == NULL) {
+        return -1;
+    }
+    return (int)s->count++;
+}
+
+static void record(model_scheduler_entry_t *e, uint32_t elapsed_us) {
+    e->runs++;
+    e->busy_us += elapsed_us;
+    if (elapsed_us > e->max_us) {
+        e->max_us = elapsed_us;
+    }
+}
+
+void model_scheduler_account(model_scheduler_t *s, int id, uint32_t elapsed_us) {
+    if (id < 0 || (size_t)id >= s->count) {
+        return;
+    }
+    record(&s->entries[id], elapsed_us);
+}
+
+size_t model_scheduler_cycle(model_scheduler_t *s, uint32_t frame, uint32_t used_us) {
+    s->cycles++;
+
+    // 차례가 된 모델: 우선순위, 그다음 더 늦은 순서 (삽입 정렬, 모델 수가 적음). 멈춘 모델은 hop만 넘김
+    uint8_t order[MODEL_SCHEDULER_MAX_MODELS];
+    size_t due = 0;
+    for (size_t i = 0; i < s->count; i++) {
+        model_scheduler_entry_t *e = &s->entries[i];
+        if (e->run == NULL || (int32_t)(frame - e->next_frame) < 0) {
+            continue;
+        }
+        if (s->shed_priority > 0 && e->priority >= s->shed_priority) {
+            // 멈춘 모델: 차례가 된 hop을 모두 건너뜀
+            uint32_t hops = (frame - e->next_frame) / e->hop_frames + 1;
+            e->shed += hops;
+            e->next_frame += hops * e->hop_frames;
+            e->deferred_in_row = 0;
+            continue;
+        }
+        size_t k = due++;
+        while (k > 0) {
+            const model_scheduler_entry_t *prev = &s->entries[order[k - 1]];
+            if (prev->priority < e->priority ||
+                (prev->priority == e->priority && (int32_t)(e->next_frame - prev->next_frame) >= 0)) {
+                break;
+            }
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = (uint8_t)i;
+    }
+
+    uint64_t spent = used_us;
+    size_t ran = 0;
+    for (size_t k = 0; k < due; k++) {
+        model_scheduler_entry_t *e = &s->entries[order[k]];
+        if (e->priority > 0 && spent + e->cost_us > s->budget_us) {
+            if (e->deferred_in_row < s->max_defer) {
+                e->deferrals++;
+                e->deferred_in_row++;
+                continue;  // 다음 주기에 다시 차례가 됨
+            }
+            e->forced++;
+        }
+
+        // 밀린 hop은 건너뛰고 지금 프레임으로 한 번만 실행
+        uint32_t skipped = (frame - e->next_frame) / e->hop_frames;
+        e->missed += skipped;
+        e->next_frame += (skipped + 1) * e->hop_frames;
+        e->deferred_in_row = 0;
+
+        int64_t start = boot_profile_now_us();
+        if (!e->run(e->user, frame)) {
+            e->failures++;
+        }
+        uint32_t elapsed = (uint32_t)(boot_profile_now_us() - start);
+        record(e, elapsed);
+        if (e->cost_us == 0) {
+            e->cost_us = elapsed;
+        } else {
+            e->cost_us = (uint32_t)((int32_t)e->cost_us + ((int32_t)(elapsed - e->cost_us) >> COST_EMA_SHIFT));
+        }
+        spent += elapsed;
+        ran++;
+    }
+    if (spent > s->budget_us) {
+        s->over_budget++;
+    }
+    return ran;
+}
+
+void model_scheduler_shed(model_scheduler_t *s, uint8_t min_priority) {
+    s->shed_priority = min_priority;
+}
+
+void model_scheduler_report(model_scheduler_t *s) {
+    int64_t now = boot_profile_now_us();
+    double elapsed = (double)(now - s->report_time_us);
+    if (elapsed <= 0.0) {
+        elapsed = 1.0;
+    }
+    uint32_t cycles = s->cycles - s->report_cycles;
+    uint32_t over_budget = s->over_budget - s->report_over_budget;
+    double total_busy = 0.0;
+
+    for (size_t i = 0; i < s->count; i++) {
+        model_scheduler_entry_t *e = &s->entries[i];
+        uint32_t runs = e->runs;
+        uint32_t busy = e->busy_us;
+        uint32_t d_runs = runs - e->report_runs;
+        uint32_t d_busy = busy - e->report_busy_us;
+        uint32_t d_deferrals = e->deferrals - e->report_deferrals;
+        uint32_t d_missed = e->missed - e->report_missed;
+        uint32_t d_shed = e->shed - e->report_shed;
+        double cpu = 100.0 * d_busy / elapsed;
+        unsigned long avg = d_runs > 0 ? (unsigned long)(d_busy / d_runs) : 0;
+        total_busy += d_busy;
+        if (e->run == NULL) {
+#ifdef ESP_PLATFORM
+            ESP_LOGI(TAG, "%-12s external         runs %6lu  avg %6lu us  max %6lu us  cpu %5.1f%%", e->name,
+                     (unsigned long)d_runs, avg, (unsigned long)e->max_us, cpu);
+#else
+            printf("%-12s external         runs %6lu  avg %6lu us  max %6lu us  cpu %5.1f%%\n", e->name,
+                   (unsigned long)d_runs, avg, (unsigned long)e->max_us, cpu);
+#endif
+        } else {
+#ifdef ESP_PLATFORM
+            ESP_LOGI(TAG, "%-12s p%u hop %3lu fr  runs %6lu  avg %6lu us  max %6lu us  cpu %5.1f%%  deferred %lu (forced %lu), missed %lu, shed %lu, failed %lu",
+                     e->name, (unsigned)e->priority, (unsigned long)e->hop_frames, (unsigned long)d_runs, avg,
+                     (unsigned long)e->max_us, cpu, (unsigned long)d_deferrals, (unsigned long)e->forced,
+                     (unsigned long)d_missed, (unsigned long)d_shed, (unsigned long)e->failures);
+#else
+            printf("%-12s p%u hop %3lu fr  runs %6lu  avg %6lu us  max %6lu us  cpu %5.1f%%  deferred %lu (forced %lu), missed %lu, shed %lu, failed %lu\n",
+                   e->name, (unsigned)e->priority, (unsigned long)e->hop_frames, (unsigned long)d_runs, avg,
+                   (unsigned long)e->max_us, cpu, (unsigned long)d_deferrals, (unsigned long)e->forced,
+                   (unsigned long)d_missed, (unsigned long)d_shed, (unsigned long)e->failures);
+#endif
+        }
+        e->report_runs = runs;
+        e->report_busy_us = busy;
+        e->report_deferrals = e->deferrals;
+        e->report_missed = e->missed;
+        e->report_shed = e->shed;
+    }
+#ifdef ESP_PLATFORM
+    ESP_LOGI(TAG, "%.1f s, %lu cycles (budget %lu us), over budget %lu, total cpu %.1f%%", elapsed / 1e6,
+             (unsigned long)cycles, (unsigned long)s->budget_us, (unsigned long)over_budget, 100.0 * total_busy / elapsed);
+#else
+    printf("%.1f s, %lu cycles (budget %lu us), over budget %lu, total cpu %.1f%%\n", elapsed / 1e6,
+           (unsigned long)cycles, (unsigned long)s->budget_us, (unsigned long)over_budget, 100.0 * total_busy / elapsed);
+#endif
+    s->report_cycles = s->cycles;
+    s->report_over_budget = s->over_budget;
+    s->report_time_us = now;
+}
@@ -0,0 +1,97 @@
+#ifndef MODEL_SCHEDULER_H
+#define MODEL_SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 같은 특징 스트림(mel 프레임)을 쓰는 여러 모델의 실행 순서/간격 관리 (추론 태스크 전용)
+// - 모델마다 hop(프레임 단위)과 우선순위가 있고, 추론 태스크가 깨어날 때마다 model_scheduler_cycle()로
+//   차례가 된 모델을 우선순위 순서로 실행합니다.
+// - 이번 주기의 예산(캡처 블록 시간의 일부)에서 호출어 등 이미 쓴 시간을 빼고, 남은 시간보다 평균 실행 시간이 긴
+//   우선순위 낮은 모델은 다음 주기로 미룹니다. (max_defer번 연속으로 미룬 모델은 예산과 관계없이 실행)
+// - 너무 늦어서 hop을 여러 번 지나친 모델은 밀린 hop을 건너뛰고 한 번만 실행합니다. (missed로 셈)
+// - 과부하 때(deadline_monitor) model_scheduler_shed()로 우선순위 낮은 모델을 아예 멈출 수 있습니다. (shed로 셈)
+// - 호출어 모델, 특징 추출처럼 스케줄러 밖에서 실행되는 작업도 external로 등록해서 시간을 기록하면
+//   model_scheduler_report()에서 모델별 CPU 점유율을 같이 볼 수 있습니다.
+// - 통계는 32비트 누적값(넘치면 0으로 돌아감)이고 보고할 때 지난 보고와의 차이로 계산하므로, 다른 태스크에서
+//   model_scheduler_account()를 호출해도 잠금이 필요 없습니다. (보고 간격은 1시간 이내로)
+
+#define MODEL_SCHEDULER_MAX_MODELS 6
+
+// 모델 실행 (frame: 지금까지 나온 특징 프레임 수). 실패하면 false (시간은 그대로 기록)
+typedef bool (*model_scheduler_run_t)(void *user, uint32_t frame);
+
+typedef struct {
+    const char *name;
+    model_scheduler_run_t run;     // NULL이면 external (시간 기록만)
+    void *user;
+    uint32_t hop_frames;           // 실행 간격 (특징 프레임 수)
+    uint8_t priority;              // 0이 가장 높음. 0이면 예산과 관계없이 미루지 않음
+    uint32_t next_frame;           // 다음 실행 차례 (특징 프레임 위치)
+    uint8_t deferred_in_row;       // 연속으로 미룬 횟수
+    uint32_t cost_us;              // 실행 시간 평균 (지수 이동 평균, 미룰지 판단용)
+    // 누적 통계 (32비트, 넘치면 0으로)
+    volatile uint32_t runs;
+    volatile uint32_t busy_us;
+    volatile uint32_t max_us;
+    uint32_t deferrals;            // 예산 부족으로 미룬 횟수
+    uint32_t forced;               // max_defer에 걸려서 예산을 넘겨도 실행한 횟수
+    uint32_t missed;               // 늦어서 건너뛴 hop 수
+    uint32_t failures;             // run이 false를 반환한 횟수
+    uint32_t shed;                 // 멈춘 동안 건너뛴 hop 수
+    // 지난 보고 시점의 누적값
+    uint32_t report_runs;
+    uint32_t report_busy_us;
+    uint32_t report_deferrals;
+    uint32_t report_missed;
+    uint32_t report_shed;
+} model_scheduler_entry_t;
+
+typedef struct {
+    model_scheduler_entry_t entries[MODEL_SCHEDULER_MAX_MODELS];
+    size_t count;
+    uint32_t budget_us;            // 주기(추론 태스크가 한 번 깨어날 때)마다 쓸 수 있는 시간
+    uint8_t max_defer;
+    uint8_t shed_priority;         // 0이 아니면 우선순위가 이 값 이상인 모델은 실행하지 않음
+    uint32_t cycles;
+    uint32_t over_budget;          // 예산을 넘긴 주기 수
+    uint32_t report_cycles;
+    uint32_t report_over_budget;
+    int64_t report_time_us;        // 지난 보고 시각 (boot_profile_now_us)
+} model_scheduler_t;
+
+// budget_us: 주기마다 모델 실행에 쓸 수 있는 시간, max_defer: 한 모델을 연속으로 미룰 수 있는 최대 주기 수
+void model_scheduler_init(model_scheduler_t *s, uint32_t budget_us, uint8_t max_defer);
+
+// 모델 등록. hop_frames > 0. 첫 실행은 first_frame부터 (입력 창이 찰 때까지 기다리도록). 반환: id, 자리가 없으면 -1
+int model_scheduler_add(model_scheduler_t *s, const char *name, uint32_t hop_frames, uint8_t priority,
+                        uint32_t first_frame, model_scheduler_run_t run, void *user);
+
+// 스케줄러 밖에서 실행되는 작업 등록 (호출어 모델, 특징 추출 등). 반환: id, 자리가 없으면 -1
+int model_scheduler_add_external(model_scheduler_t *s, const char *name);
+
+// external 작업의 실행 시간 기록 (아무 태스크에서나)
+void model_scheduler_account(model_scheduler_t *s, int id, uint32_t elapsed_us);
+
+// 특징 프레임 위치 frame까지 차례가 된 모델 실행. used_us: 이번 주기에 이미 쓴 시간 (호출어 추론 등)
+// 추론 태스크가 밀려 있으면 used_us로 budget_us 이상을 넘겨서 우선순위 낮은 모델을 미루게 하면 됩니다.
+// 반환: 이번 주기에 실행한 모델 수
+size_t model_scheduler_cycle(model_scheduler_t *s, uint32_t frame, uint32_t used_us);
+
+// 우선순위가 min_priority 이상인 모델 멈추기 (0이면 모두 다시 실행, 우선순위 0은 멈추지 않음)
+// 멈춘 모델은 차례가 와도 hop을 건너뛰고, 다시 실행하면 다음 hop부터
+void model_scheduler_shed(model_scheduler_t *s, uint8_t min_priority);
+
+// 모델별 실행 횟수, 평균/최대 시간, 미룬/건너뛴 횟수, CPU 점유율(지난 보고 이후)을 로그로 출력
+void model_scheduler_report(model_scheduler_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MODEL_SCHEDULER_H
@@ -0,0 +1,531 @@
+#include <string.h>
+#include "model_split.h"
+
+// schema.fbs 필드 번호
+enum { MODEL_OPERATOR_CODES = 1, MODEL_SUBGRAPHS = 2, MODEL_BUFFERS = 4, MODEL_METADATA = 6, MODEL_SIGNATURE_DEFS = 7 };
+enum { SUBGRAPH_TENSORS = 0, SUBGRAPH_INPUTS = 1, SUBGRAPH_OUTPUTS = 2, SUBGRAPH_OPERATORS = 3 };
+enum { TENSOR_SHAPE = 0, TENSOR_TYPE = 1, TENSOR_BUFFER = 2, TENSOR_IS_VARIABLE = 5 };
+enum { OPERATOR_OPCODE_INDEX = 0, OPERATOR_INPUTS = 1, OPERATOR_OUTPUTS = 2, OPERATOR_INTERMEDIATES = 8 };
+enum { OPCODE_DEPRECATED_BUILTIN = 0, OPCODE_BUILTIN = 3 };
+enum { BUFFER_DATA = 0, BUFFER_OFFSET = 1 };
+enum { METADATA_NAME = 0 };
+
+// BuiltinOperator (MAC 추정, 로그용)
+static const struct {
+    int32_t code;
+    const char *name;
+} op_names[] = {
+    {0, "ADD"}, {1, "AVERAGE_POOL_2D"}, {2, "CONCATENATION"}, {3, "CONV_2D"}, {4, "DEPTHWISE_CONV_2D"},
+    {6, "DEQUANTIZE"}, {9, "FULLY_CONNECTED"}, {14, "LOGISTIC"}, {17, "MAX_POOL_2D"}, {18, "MUL"},
+    {19, "RELU"}, {22, "RESHAPE"}, {25, "SOFTMAX"}, {28, "TANH"}, {40, "MEAN"}, {45, "STRIDED_SLICE"},
+    {77, "SHAPE"}, {83, "PACK"}, {114, "QUANTIZE"},
+};
+#define OP_CONV_2D 3
+#define OP_DEPTHWISE_CONV_2D 4
+#define OP_FULLY_CONNECTED 9
+
+#define TENSOR_UNUSED INT8_MAX  // 어떤 연산자도 쓰지 않는 텐서 (first_use)
+_Static_assert(MODEL_SPLIT_MAX_OPS < INT8_MAX, "연산자 번호가 int8_t에 들어가야 함");
+
+// TensorType별 원소 크기 (FLOAT32, FLOAT16, INT32, UINT8, INT64, STRING, BOOL, INT16, COMPLEX64, INT8, FLOAT64)
+static const uint8_t type_bytes[] = {4, 2, 4, 1, 8, 0, 1, 2, 8, 1, 8};
+
+// 읽기 전용 flatbuffer 리더 (범위를 벗어나면 ok = false, 이후 읽기는 0)
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    bool ok;
+} fb_t;
+
+// 호출어 모델의 서브그래프 (모든 위치는 모델 시작 기준 바이트 오프셋, 나눈 모델에서도 같음)
+typedef struct {
+    fb_t fb;
+    size_t model;
+    size_t opcodes;
+    uint32_t opcode_count;
+    size_t buffers;
+    uint32_t buffer_count;
+    size_t tensors;
+    uint32_t tensor_count;
+    size_t operators;
+    uint32_t op_count;
+    size_t inputs;
+    uint32_t input_count;
+    size_t outputs;
+    uint32_t output_count;
+} graph_t;
+
+static uint32_t rd(fb_t *fb, size_t pos, int bytes) {
+    if (!fb->ok || pos + bytes > fb->size || pos + bytes < pos) {
+        fb->ok = false;
+        return 0;
+    }
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        value = value << 8 | fb->data[pos + i];
+    }
+    return value;
+}
+
+static void wr32(uint8_t *dst, size_t pos, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        dst[pos + i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+// 테이블 필드 위치 (없으면 0)
+static size_t fb_field(fb_t *fb, size_t table, int field) {
+    if (!fb->ok || table == 0) {
+        return 0;
+    }
+    int64_t vtable = (int64_t)table - (int32_t)rd(fb, table, 4);
+    if (vtable < 0 || (uint64_t)vtable >= fb->size) {
+        fb->ok = false;
+        return 0;
+    }
+    size_t entry = 4 + 2 * (size_t)field;
+    if (entry + 2 > rd(fb, (size_t)vtable, 2)) {
+        return 0;
+    }
+    uint32_t offset = rd(fb, (size_t)vtable + entry, 2);
+    return offset != 0 ? table + offset : 0;
+}
+
+// 오프셋 위치가 가리키는 곳
+static size_t fb_deref(fb_t *fb, size_t pos) {
+    size_t target = pos + rd(fb, pos, 4);
+    if (target >= fb->size) {
+        fb->ok = false;
+        return 0;
+    }
+    return target;
+}
+
+// 오프셋 필드(테이블, 벡터, 문자열)가 가리키는 곳 (없으면 0)
+static size_t fb_ref(fb_t *fb, size_t table, int field) {
+    size_t pos = fb_field(fb, table, field);
+    return pos != 0 ? fb_deref(fb, pos) : 0;
+}
+
+// 벡터 위치(길이 자리)와 원소 수 (없으면 0, 0)
+static size_t fb_vector(fb_t *fb, size_t table, int field, size_t element_bytes, uint32_t *count) {
+    size_t vector = fb_ref(fb, table, field);
+    *count = vector != 0 ? rd(fb, vector, 4) : 0;
+    if (vector != 0 && (uint64_t)vector + 4 + (uint64_t)*count * element_bytes > fb->size) {
+        fb->ok = false;
+        *count = 0;
+    }
+    return vector;
+}
+
+// 스칼라 필드 (bytes: 1, 2, 4. 부호 있는 값으로 읽음)
+static int32_t fb_scalar(fb_t *fb, size_t table, int field, int bytes, int32_t default_value) {
+    size_t pos = fb_field(fb, table, field);
+    if (pos == 0) {
+        return default_value;
+    }
+    uint32_t value = rd(fb, pos, bytes);
+    if (bytes == 1) {
+        return (int8_t)value;
+    }
+    if (bytes == 2) {
+        return (int16_t)value;
+    }
+    return (int32_t)value;
+}
+
+static size_t table_at(fb_t *fb, size_t vector, uint32_t i) {
+    return fb_deref(fb, vector + 4 + 4 * (size_t)i);
+}
+
+static int32_t int_at(fb_t *fb, size_t vector, uint32_t i) {
+    return (int32_t)rd(fb, vector + 4 + 4 * (size_t)i, 4);
+}
+
+static bool graph_open(graph_t *g, const uint8_t *model, size_t size) {
+    memset(g, 0, sizeof(*g));
+    g->fb.data = model;
+    g->fb.size = size;
+    g->fb.ok = size >= 8;
+    fb_t *fb = &g->fb;
+    g->model = fb_deref(fb, 0);
+    uint32_t subgraphs;
+    size_t subgraph_vector = fb_vector(fb, g->model, MODEL_SUBGRAPHS, 4, &subgraphs);
+    if (subgraphs != 1) {
+        return false;
+    }
+    size_t subgraph = table_at(fb, subgraph_vector, 0);
+    g->opcodes = fb_vector(fb, g->model, MODEL_OPERATOR_CODES, 4, &g->opcode_count);
+    g->buffers = fb_vector(fb, g->model, MODEL_BUFFERS, 4, &g->buffer_count);
+    g->tensors = fb_vector(fb, subgraph, SUBGRAPH_TENSORS, 4, &g->tensor_count);
+    g->operators = fb_vector(fb, subgraph, SUBGRAPH_OPERATORS, 4, &g->op_count);
+    g->inputs = fb_vector(fb, subgraph, SUBGRAPH_INPUTS, 4, &g->input_count);
+    g->outputs = fb_vector(fb, subgraph, SUBGRAPH_OUTPUTS, 4, &g->output_count);
+    return fb->ok && g->op_count > 0 && g->op_count <= MODEL_SPLIT_MAX_OPS && g->tensor_count <= MODEL_SPLIT_MAX_TENSORS;
+}
+
+static size_t op_table(graph_t *g, uint32_t op) {
+    return table_at(&g->fb, g->operators, op);
+}
+
+// 연산자 입력/출력 텐서 번호 벡터. 반환: 원소 수
+static uint32_t op_tensors(graph_t *g, size_t op, int field, size_t *vector) {
+    uint32_t count;
+    *vector = fb_vector(&g->fb, op, field, 4, &count);
+    return count;
+}
+
+static int32_t op_code(graph_t *g, size_t op) {
+    uint32_t index = (uint32_t)fb_scalar(&g->fb, op, OPERATOR_OPCODE_INDEX, 4, 0);
+    if (index >= g->opcode_count) {
+        return -1;
+    }
+    size_t opcode = table_at(&g->fb, g->opcodes, index);
+    int32_t deprecated = fb_scalar(&g->fb, opcode, OPCODE_DEPRECATED_BUILTIN, 1, 0);
+    int32_t builtin = fb_scalar(&g->fb, opcode, OPCODE_BUILTIN, 4, 0);
+    return builtin > deprecated ? builtin : deprecated;  // 127 이하는 deprecated 필드에도 들어있음
+}
+
+// 텐서 모양. 반환: 차원 수 (max_dims까지만 채움)
+static uint32_t tensor_shape(graph_t *g, int32_t tensor, int32_t *dims, uint32_t max_dims) {
+    size_t table = table_at(&g->fb, g->tensors, (uint32_t)tensor);
+    uint32_t rank;
+    size_t shape = fb_vector(&g->fb, table, TENSOR_SHAPE, 4, &rank);
+    for (uint32_t d = 0; d < rank && d < max_dims; d++) {
+        dims[d] = int_at(&g->fb, shape, d);
+    }
+    return rank;
+}
+
+// 텐서 바이트 수 (알 수 없는 타입이면 0). elements: 원소 수 (동적 차원은 1로)
+static uint32_t tensor_bytes(graph_t *g, int32_t tensor, uint64_t *elements) {
+    size_t table = table_at(&g->fb, g->tensors, (uint32_t)tensor);
+    uint32_t rank;
+    size_t shape = fb_vector(&g->fb, table, TENSOR_SHAPE, 4, &rank);
+    uint64_t count = 1;
+    for (uint32_t d = 0; d < rank; d++) {
+        int32_t dim = int_at(&g->fb, shape, d);
+        count *= dim > 0 ? (uint64_t)dim : 1;
+    }
+    if (elements != NULL) {
+        *elements = count;
+    }
+    int32_t type = fb_scalar(&g->fb, table, TENSOR_TYPE, 1, 0);
+    uint64_t bytes = type >= 0 && type < (int32_t)sizeof(type_bytes) ? count * type_bytes[type] : 0;
+    return bytes <= UINT32_MAX ? (uint32_t)bytes : 0;
+}
+
+// 가중치/상수 (버퍼에 데이터가 있는 텐서)
+static bool tensor_constant(graph_t *g, int32_t tensor) {
+    size_t table = table_at(&g->fb, g->tensors, (uint32_t)tensor);
+    uint32_t buffer = (uint32_t)fb_scalar(&g->fb, table, TENSOR_BUFFER, 4, 0);
+    if (buffer == 0 || buffer >= g->buffer_count) {
+        return false;
+    }
+    size_t buffer_table = table_at(&g->fb, g->buffers, buffer);
+    uint32_t data_bytes;
+    fb_vector(&g->fb, buffer_table, BUFFER_DATA, 1, &data_bytes);
+    // 2GB 넘는 모델은 데이터가 flatbuffer 뒤에 있음 (offset > 1)
+    size_t offset = fb_field(&g->fb, buffer_table, BUFFER_OFFSET);
+    return data_bytes > 0 || (offset != 0 && (rd(&g->fb, offset, 4) > 1 || rd(&g->fb, offset + 4, 4) != 0));
+}
+
+static bool tensor_variable(graph_t *g, int32_t tensor) {
+    size_t table = table_at(&g->fb, g->tensors, (uint32_t)tensor);
+    return fb_scalar(&g->fb, table, TENSOR_IS_VARIABLE, 1, 0) != 0;
+}
+
+// 나눌 수 있는 모델인지: 입력/출력 하나, 연산자 텐서 번호가 범위 안, intermediates 없음, 오프라인 아레나 배치 없음
+static bool graph_splittable(graph_t *g) {
+    if (g->input_count != 1 || g->output_count != 1) {
+        return false;
+    }
+    int32_t io[2] = {int_at(&g->fb, g->inputs, 0), int_at(&g->fb, g->outputs, 0)};
+    for (int i = 0; i < 2; i++) {
+        if (io[i] < 0 || (uint32_t)io[i] >= g->tensor_count) {
+            return false;
+        }
+    }
+    for (uint32_t op = 0; op < g->op_count; op++) {
+        size_t table = op_table(g, op);
+        size_t vector;
+        if (op_tensors(g, table, OPERATOR_INTERMEDIATES, &vector) > 0) {
+            return false;  // LSTM 등 (intermediates 텐서 번호까지 다시 매겨야 함)
+        }
+        for (int field = OPERATOR_INPUTS; field <= OPERATOR_OUTPUTS; field++) {
+            uint32_t count = op_tensors(g, table, field, &vector);
+            for (uint32_t i = 0; i < count; i++) {
+                int32_t tensor = int_at(&g->fb, vector, i);
+                if (tensor < -1 || tensor >= (int32_t)g->tensor_count) {
+                    return false;
+                }
+            }
+        }
+    }
+    uint32_t metadata_count;
+    size_t metadata = fb_vector(&g->fb, g->model, MODEL_METADATA, 4, &metadata_count);
+    for (uint32_t i = 0; i < metadata_count; i++) {
+        size_t name = fb_ref(&g->fb, table_at(&g->fb, metadata, i), METADATA_NAME);
+        static const char offline[] = "OfflineMemoryAllocation";  // 텐서 번호별 아레나 오프셋 (번호를 다시 매기면 틀어짐)
+        if (name != 0 && rd(&g->fb, name, 4) == sizeof(offline) - 1 && name + 4 + sizeof(offline) - 1 <= g->fb.size &&
+            memcmp(g->fb.data + name + 4, offline, sizeof(offline) - 1) == 0) {
+            return false;
+        }
+    }
+    return g->fb.ok;
+}
+
+// 연산자 비용 추정 (conv/FC는 MAC 수, 나머지는 입력/출력 원소 수 중 큰 값)
+static uint64_t op_cost(graph_t *g, size_t op, int32_t code) {
+    size_t inputs;
+    size_t outputs;
+    uint32_t input_count = op_tensors(g, op, OPERATOR_INPUTS, &inputs);
+    uint32_t output_count = op_tensors(g, op, OPERATOR_OUTPUTS, &outputs);
+    uint64_t out_elements = 0;
+    uint64_t in_elements = 0;
+    if (output_count > 0 && int_at(&g->fb, outputs, 0) >= 0) {
+        tensor_bytes(g, int_at(&g->fb, outputs, 0), &out_elements);
+    }
+    if (input_count > 0 && int_at(&g->fb, inputs, 0) >= 0) {
+        tensor_bytes(g, int_at(&g->fb, inputs, 0), &in_elements);
+    }
+    int32_t filter = input_count > 1 ? int_at(&g->fb, inputs, 1) : -1;
+    if (filter >= 0) {
+        int32_t dims[4] = {1, 1, 1, 1};
+        uint32_t rank = tensor_shape(g, filter, dims, 4);
+        if (code == OP_CONV_2D && rank == 4) {  // [out_c, kh, kw, in_c]
+            return out_elements * (uint64_t)dims[1] * dims[2] * dims[3];
+        }
+        if (code == OP_DEPTHWISE_CONV_2D && rank == 4) {  // [1, kh, kw, out_c]
+            return out_elements * (uint64_t)dims[1] * dims[2];
+        }
+        if (code == OP_FULLY_CONNECTED && rank == 2) {  // [out, in]
+            return out_elements * (uint64_t)dims[1];
+        }
+    }
+    return in_elements > out_elements ? in_elements : out_elements;
+}
+
+bool model_split_plan(const uint8_t *model, size_t size, uint32_t max_boundary_bytes, int32_t split_op,
+                      model_split_plan_t *plan) {
+    memset(plan, 0, sizeof(*plan));
+    plan->split_op = -1;
+    plan->boundary_tensor = -1;
+    graph_t g;
+    if (!graph_open(&g, model, size) || !graph_splittable(&g)) {
+        return false;
+    }
+    const uint32_t n = g.op_count;
+    plan->op_count = n;
+
+    // 텐서별 처음/마지막으로 쓰는 연산자 (모델 입력은 -1에서 만들어지고, 모델 출력은 n까지 쓰임)
+    int8_t first_use[MODEL_SPLIT_MAX_TENSORS];  // 태스크 스택에서 돌므로 작게
+    int8_t last_use[MODEL_SPLIT_MAX_TENSORS];
+    for (uint32_t t = 0; t < g.tensor_count; t++) {
+        first_use[t] = TENSOR_UNUSED;
+        last_use[t] = -1;
+    }
+    int32_t input = int_at(&g.fb, g.inputs, 0);
+    int32_t output = int_at(&g.fb, g.outputs, 0);
+    first_use[input] = -1;
+    last_use[output] = (int8_t)n;
+    uint64_t total = 0;
+    for (uint32_t op = 0; op < n; op++) {
+        size_t table = op_table(&g, op);
+        for (int field = OPERATOR_INPUTS; field <= OPERATOR_OUTPUTS; field++) {
+            size_t vector;
+            uint32_t count = op_tensors(&g, table, field, &vector);
+            for (uint32_t i = 0; i < count; i++) {
+                int32_t tensor = int_at(&g.fb, vector, i);
+                if (tensor < 0) {
+                    continue;  // 없는 선택 입력 (bias 등)
+                }
+                if (first_use[tensor] > (int8_t)op) {
+                    first_use[tensor] = (int8_t)op;
+                }
+                if (last_use[tensor] < (int8_t)op) {
+                    last_use[tensor] = (int8_t)op;
+                }
+            }
+        }
+        plan->op_code[op] = op_code(&g, table);
+        plan->op_macs[op] = op_cost(&g, table, plan->op_code[op]);
+        total += plan->op_macs[op];
+    }
+    bool constant[MODEL_SPLIT_MAX_TENSORS];
+    for (uint32_t t = 0; t < g.tensor_count; t++) {
+        constant[t] = tensor_constant(&g, (int32_t)t);
+    }
+
+    // 연산자 op 뒤에서 자를 때 양쪽에서 쓰는 텐서 (상수는 두 모델에 다 들어있으므로 제외)가 하나뿐인 곳
+    uint64_t front = 0;
+    uint64_t best_cost = UINT64_MAX;
+    for (uint32_t op = 0; op < n; op++) {
+        front += plan->op_macs[op];
+        plan->op_boundary[op] = -1;
+        if (op + 1 == n) {
+            break;
+        }
+        int32_t boundary = -1;
+        uint32_t crossing = 0;
+        for (uint32_t t = 0; t < g.tensor_count; t++) {
+            if (!constant[t] && first_use[t] <= (int8_t)op && last_use[t] > (int8_t)op) {
+                boundary = (int32_t)t;
+                crossing++;
+            }
+        }
+        if (crossing != 1 || boundary == input || boundary == output || tensor_variable(&g, boundary)) {
+            continue;
+        }
+        uint32_t bytes = tensor_bytes(&g, boundary, NULL);
+        if (bytes == 0) {
+            continue;
+        }
+        plan->op_boundary[op] = boundary;
+        plan->op_boundary_bytes[op] = bytes;
+
+        // 두 단계 중 긴 쪽이 파이프라인 처리량을 정함
+        uint64_t cost = front > total - front ? front : total - front;
+        bool chosen = split_op >= 0 ? (int32_t)op == split_op : bytes <= max_boundary_bytes && cost < best_cost;
+        if (chosen) {
+            best_cost = cost;
+            plan->split_op = (int32_t)op;
+            plan->boundary_tensor = boundary;
+            plan->boundary_bytes = bytes;
+            plan->front_macs = front;
+            plan->back_macs = total - front;
+        }
+    }
+    return g.fb.ok && plan->split_op >= 0;
+}
+
+// 원본 벡터의 from번째 오프셋을 복사본의 to번째 자리로 (가리키는 곳은 그대로)
+static void move_offset(graph_t *g, uint8_t *dst, size_t vector, uint32_t to, uint32_t from) {
+    size_t from_slot = vector + 4 + 4 * (size_t)from;
+    size_t to_slot = vector + 4 + 4 * (size_t)to;
+    size_t target = fb_deref(&g->fb, from_slot);
+    wr32(dst, to_slot, (uint32_t)(target - to_slot));  // to <= from이라 앞쪽 오프셋이 유지됨
+}
+
+// 연산자 [first_op, end_op)만 남긴 모델 (입력 in, 출력 out)을 dst에 만듦
+static bool write_stage(graph_t *g, uint8_t *dst, uint32_t first_op, uint32_t end_op, int32_t in, int32_t out) {
+    memcpy(dst, g->fb.data, g->fb.size);
+
+    // 남길 텐서: 남은 연산자가 쓰는 텐서 + 입력/출력. 번호는 원래 순서대로 다시 매김
+    int16_t map[MODEL_SPLIT_MAX_TENSORS];
+    for (uint32_t t = 0; t < g->tensor_count; t++) {
+        map[t] = -1;
+    }
+    map[in] = 0;
+    map[out] = 0;
+    for (uint32_t op = first_op; op < end_op; op++) {
+        size_t table = op_table(g, op);
+        for (int field = OPERATOR_INPUTS; field <= OPERATOR_OUTPUTS; field++) {
+            size_t vector;
+            uint32_t count = op_tensors(g, table, field, &vector);
+            for (uint32_t i = 0; i < count; i++) {
+                int32_t tensor = int_at(&g->fb, vector, i);
+                if (tensor >= 0) {
+                    map[tensor] = 0;
+                }
+            }
+        }
+    }
+    uint32_t kept = 0;
+    for (uint32_t t = 0; t < g->tensor_count; t++) {
+        if (map[t] >= 0) {
+            map[t] = (int16_t)kept++;
+        }
+    }
+
+    // 연산자 입력/출력 번호 고치기 (같은 벡터를 여러 곳에서 가리키면 한 번만)
+    size_t visited[2 * MODEL_SPLIT_MAX_OPS];
+    size_t visited_count = 0;
+    for (uint32_t op = first_op; op < end_op; op++) {
+        size_t table = op_table(g, op);
+        for (int field = OPERATOR_INPUTS; field <= OPERATOR_OUTPUTS; field++) {
+            size_t vector;
+            uint32_t count = op_tensors(g, table, field, &vector);
+            if (vector == 0) {
+                continue;
+            }
+            if (vector == g->inputs || vector == g->outputs) {
+                return false;  // 서브그래프 입력/출력과 같은 벡터 (따로 고칠 수 없음)
+            }
+            bool seen = false;
+            for (size_t v = 0; v < visited_count; v++) {
+                seen |= visited[v] == vector;
+            }
+            if (seen) {
+                continue;
+            }
+            visited[visited_count++] = vector;
+            for (uint32_t i = 0; i < count; i++) {
+                int32_t tensor = int_at(&g->fb, vector, i);
+                if (tensor >= 0) {
+                    wr32(dst, vector + 4 + 4 * (size_t)i, (uint32_t)map[tensor]);
+                }
+            }
+        }
+    }
+
+    // 연산자, 텐서 벡터를 앞으로 당겨서 줄임
+    for (uint32_t op = first_op; op < end_op; op++) {
+        move_offset(g, dst, g->operators, op - first_op, op);
+    }
+    wr32(dst, g->operators, end_op - first_op);
+    for (uint32_t t = 0; t < g->tensor_count; t++) {
+        if (map[t] >= 0) {
+            move_offset(g, dst, g->tensors, (uint32_t)map[t], t);
+        }
+    }
+    wr32(dst, g->tensors, kept);
+
+    // 서브그래프 입력/출력, signature_defs (원래 입력/출력 이름을 가리키므로 지움)
+    wr32(dst, g->inputs + 4, (uint32_t)map[in]);
+    wr32(dst, g->outputs + 4, (uint32_t)map[out]);
+    size_t signatures = fb_ref(&g->fb, g->model, MODEL_SIGNATURE_DEFS);
+    if (signatures != 0) {
+        wr32(dst, signatures, 0);
+    }
+    return g->fb.ok;
+}
+
+bool model_split_apply(const uint8_t *model, size_t size, const model_split_plan_t *plan, uint8_t *front,
+                       uint8_t *back) {
+    graph_t g;
+    if (!graph_open(&g, model, size) || !graph_splittable(&g) || plan->op_count != g.op_count ||
+        plan->split_op < 0 || (uint32_t)plan->split_op + 1 >= g.op_count || plan->boundary_tensor < 0 ||
+        (uint32_t)plan->boundary_tensor >= g.tensor_count) {
+        return false;
+    }
+    int32_t input = int_at(&g.fb, g.inputs, 0);
+    int32_t output = int_at(&g.fb, g.outputs, 0);
+    uint32_t split = (uint32_t)plan->split_op + 1;
+    return write_stage(&g, front, 0, split, input, plan->boundary_tensor) &&
+           write_stage(&g, back, split, g.op_count, plan->boundary_tensor, output);
+}
+
+bool model_split_info(const uint8_t *model, size_t size, model_split_info_t *info) {
+    memset(info, 0, sizeof(*info));
+    graph_t g;
+    if (!graph_open(&g, model, size) || !graph_splittable(&g)) {
+        return false;
+    }
+    info->ops = g.op_count;
+    info->tensors = g.tensor_count;
+    info->input_tensor = int_at(&g.fb, g.inputs, 0);
+    info->output_tensor = int_at(&g.fb, g.outputs, 0);
+    info->input_bytes = tensor_bytes(&g, info->input_tensor, NULL);
+    info->output_bytes = tensor_bytes(&g, info->output_tensor, NULL);
+    return g.fb.ok;
+}
+
+const char *model_split_op_name(int32_t code) {
+    for (size_t i = 0; i < sizeof(op_names) / sizeof(op_names[0]); i++) {
+        if (op_names[i].code == code) {
+            return op_names[i].name;
+        }
+    }
+    return "OTHER";
+}
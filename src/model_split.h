@@ -0,0 +1,65 @@
+#ifndef MODEL_SPLIT_H
+#define MODEL_SPLIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 모델(.tflite flatbuffer)을 연산자 순서대로 앞/뒤 두 모델로 나눔 (INFERENCE_PIPELINE: 앞 단계는 코어 0, 뒤 단계는 코어 1)
+// - 자르는 곳을 지나는 텐서(상수 제외)가 하나뿐인 곳에서만 자를 수 있고, 그 텐서(경계 텐서)가 앞 모델의 출력이자 뒤 모델의 입력이 됨
+// - 자동으로 고를 때는 경계 텐서가 max_boundary_bytes 이하인 곳 중 연산자별 추정 MAC 수로 두 단계가 가장 비슷한 곳
+// - TFLM 없이 flatbuffer를 직접 읽고, 원본을 복사한 뒤 제자리에서 고침 (연산자/텐서 벡터를 줄이고 텐서 번호를 다시 매김).
+//   가중치는 옮기지 않으므로 두 모델 모두 원본과 크기가 같음
+// - 서브그래프 하나, 입력/출력 하나인 모델만. signature_defs는 지우고, 오프라인 아레나 배치 메타데이터가 있으면 거부
+// 호스트: host/sim_pipeline.c (내장 모델로 나눈 결과 확인, 두 스레드로 파이프라인 재현)
+
+#define MODEL_SPLIT_MAX_OPS 64
+#define MODEL_SPLIT_MAX_TENSORS 256
+
+typedef struct {
+    uint32_t op_count;
+    int32_t split_op;                               // 앞 단계 마지막 연산자 (앞: 0..split_op, 뒤: split_op+1..)
+    int32_t boundary_tensor;
+    uint32_t boundary_bytes;
+    uint64_t front_macs;
+    uint64_t back_macs;
+    // 연산자별 (보고용)
+    int32_t op_code[MODEL_SPLIT_MAX_OPS];           // BuiltinOperator
+    uint64_t op_macs[MODEL_SPLIT_MAX_OPS];          // 추정 MAC 수 (conv, FC 외에는 입력/출력 원소 수)
+    int32_t op_boundary[MODEL_SPLIT_MAX_OPS];       // 이 연산자 뒤에서 자를 수 있으면 경계 텐서, 없으면 -1
+    uint32_t op_boundary_bytes[MODEL_SPLIT_MAX_OPS];
+} model_split_plan_t;
+
+typedef struct {
+    uint32_t ops;
+    uint32_t tensors;
+    int32_t input_tensor;
+    int32_t output_tensor;
+    uint32_t input_bytes;
+    uint32_t output_bytes;
+} model_split_info_t;
+
+// 자를 곳 계획. split_op >= 0이면 그 연산자 뒤에서 (자를 수 있는 곳일 때만), -1이면 자동
+// 반환: false (나눌 수 없는 모델이거나 조건에 맞는 곳이 없음. 연산자별 항목은 그래도 채움)
+bool model_split_plan(const uint8_t *model, size_t size, uint32_t max_boundary_bytes, int32_t split_op,
+                      model_split_plan_t *plan);
+
+// 계획대로 앞/뒤 모델을 만듦 (front, back은 각각 size 바이트 이상, 4바이트 정렬)
+bool model_split_apply(const uint8_t *model, size_t size, const model_split_plan_t *plan, uint8_t *front,
+                       uint8_t *back);
+
+// 연산자/텐서 수, 입력/출력 텐서 (나눈 모델 확인용. 연산자가 없는 텐서 번호를 쓰면 false)
+bool model_split_info(const uint8_t *model, size_t size, model_split_info_t *info);
+
+// 로그용 연산자 이름
+const char *model_split_op_name(int32_t code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MODEL_SPLIT_H
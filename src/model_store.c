@@ -0,0 +1,243 @@
+#include <string.h>
+#include "esp_partition.h"
+#include "spi_flash_mmap.h"
+#include "esp_rom_crc.h"
+#include "esp_log.h"
+#include "model_store.h"
+
+static const char *TAG = "MODEL_STORE";
+
+// 모델은 flash를 메모리 맵해서 그대로 사용합니다. (RAM으로 복사하지 않음)
+// 새 모델은 사용하지 않는 슬롯에 쓰고, 헤더는 마지막에 씁니다.
+// 헤더가 없으면 슬롯이 유효하지 않으므로, 쓰는 도중에 끊겨도 반쯤 쓰인 모델을 읽을 일이 없습니다.
+
+static const esp_partition_t *partition;
+static const uint8_t *slot_data[MODEL_SLOT_COUNT];
+static esp_partition_mmap_handle_t slot_handle[MODEL_SLOT_COUNT];
+
+// 쓰기 진행 상태
+static int write_slot = -1;
+static size_t write_expected;
+static size_t write_offset;
+static uint32_t write_sequence;
+static uint8_t header_buffer[MODEL_DATA_OFFSET];  // 헤더는 모아뒀다가 모델 데이터를 다 쓴 뒤에 씀
+
+static esp_err_t map_slot(int slot) {
+    const void *ptr;
+    esp_err_t ret = esp_partition_mmap(partition, slot * MODEL_SLOT_SIZE, MODEL_SLOT_SIZE,
+                                       ESP_PARTITION_MMAP_DATA, &ptr, &slot_handle[slot]);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to mmap slot %d (%s)", slot, esp_err_to_name(ret));
+        slot_data[slot] = NULL;
+        return ret;
+    }
+    slot_data[slot] = (const uint8_t *)ptr;
+    return ESP_OK;
+}
+
+static void unmap_slot(int slot) {
+    if (slot_data[slot]) {
+        esp_partition_munmap(slot_handle[slot]);
+        slot_data[slot] = NULL;
+    }
+}
+
+static bool header_valid(const model_package_header_t *header) {
+    if (header->magic != MODEL_PACKAGE_MAGIC || header->version != MODEL_PACKAGE_VERSION) {
+        return false;
+    }
+    if (header->data_offset != MODEL_DATA_OFFSET ||
+        header->model_size == 0 || header->model_size > MODEL_SLOT_SIZE - MODEL_DATA_OFFSET) {
+        return false;
+    }
+    if (header->num_classes == 0 || header->num_classes > KEYWORD_MAX_CLASSES) {
+        return false;
+    }
+    for (int c = 0; c < header->num_classes; c++) {
+        const model_package_class_t *cls = &header->classes[c];
+        if (memchr(cls->label, '\0', MODEL_LABEL_SIZE) == NULL) {
+            return false;  // 라벨이 NUL로 끝나지 않음
+        }
+        if (cls->smoothing == 0 || cls->smoothing > KEYWORD_MAX_SMOOTHING) {
+            return false;
+        }
+    }
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(model_package_header_t, header_crc32));
+    return crc == header->header_crc32;
+}
+
+// 슬롯의 헤더와 모델 CRC를 검사하고, 유효하면 entry를 채웁니다.
+static bool load_slot(int slot, model_entry_t *entry) {
+    if (!slot_data[slot]) {
+        return false;
+    }
+    const model_package_header_t *header = (const model_package_header_t *)slot_data[slot];
+    if (!header_valid(header)) {
+        return false;
+    }
+    const uint8_t *model = slot_data[slot] + header->data_offset;
+    if (esp_rom_crc32_le(0, model, header->model_size) != header->model_crc32) {
+        ESP_LOGW(TAG, "Slot %d: model CRC mismatch", slot);
+        return false;
+    }
+
+    entry->model = model;
+    entry->model_size = header->model_size;
+    entry->num_classes = header->num_classes;
+    for (int c = 0; c < header->num_classes; c++) {
+        const model_package_class_t *cls = &header->classes[c];
+        entry->classes[c].label = cls->label;  // 메모리 맵된 flash를 그대로 가리킴
+        entry->classes[c].threshold = cls->threshold;
+        entry->classes[c].smoothing = cls->smoothing;
+        entry->classes[c].refractory = cls->refractory;
+        entry->classes[c].background = cls->background != 0;
+    }
+    entry->sequence = header->sequence;
+    entry->slot = slot;
+    return true;
+}
+
+esp_err_t model_store_init(void) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                         (esp_partition_subtype_t)MODEL_PARTITION_SUBTYPE,
+                                         MODEL_PARTITION_LABEL);
+    if (!partition) {
+        ESP_LOGW(TAG, "Model partition not found.");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (partition->size < MODEL_SLOT_COUNT * MODEL_SLOT_SIZE) {
+        ESP_LOGE(TAG, "Model partition too small: %lu bytes", (unsigned long)partition->size);
+        partition = NULL;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    for (int slot = 0; slot < MODEL_SLOT_COUNT; slot++) {
+        map_slot(slot);
+    }
+    ESP_LOGI(TAG, "Model partition at 0x%lx mapped.", (unsigned long)partition->address);
+    return ESP_OK;
+}
+
+esp_err_t model_store_load(model_entry_t *entry) {
+    if (!partition) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    bool found = false;
+    model_entry_t candidate;
+    for (int slot = 0; slot < MODEL_SLOT_COUNT; slot++) {
+        if (load_slot(slot, &candidate) && (!found || candidate.sequence > entry->sequence)) {
+            *entry = candidate;
+            found = true;
+        }
+    }
+    if (!found) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    ESP_LOGI(TAG, "Model slot %d loaded (sequence %lu, %u bytes).",
+             entry->slot, (unsigned long)entry->sequence, (unsigned)entry->model_size);
+    return ESP_OK;
+}
+
+esp_err_t model_store_begin(size_t package_size, int active_slot) {
+    if (!partition) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (package_size <= MODEL_DATA_OFFSET || package_size > MODEL_SLOT_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // 현재 모델보다 큰 sequence를 새 모델에 붙임
+    write_sequence = 1;
+    model_entry_t current;
+    for (int slot = 0; slot < MODEL_SLOT_COUNT; slot++) {
+        if (load_slot(slot, &current) && current.sequence >= write_sequence) {
+            write_sequence = current.sequence + 1;
+        }
+    }
+
+    write_slot = (active_slot == 0) ? 1 : 0;
+    unmap_slot(write_slot);
+
+    // 헤더 영역까지 포함해서 필요한 섹터만 지움
+    size_t erase_size = (package_size + SPI_FLASH_SEC_SIZE - 1) & ~(SPI_FLASH_SEC_SIZE - 1);
+    esp_err_t ret = esp_partition_erase_range(partition, write_slot * MODEL_SLOT_SIZE, erase_size);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase slot %d (%s)", write_slot, esp_err_to_name(ret));
+        write_slot = -1;
+        return ret;
+    }
+
+    write_expected = package_size;
+    write_offset = 0;
+    memset(header_buffer, 0xFF, sizeof(header_buffer));
+    return ESP_OK;
+}
+
+esp_err_t model_store_write(const uint8_t *data, size_t length) {
+    if (write_slot < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (write_offset + length > write_expected) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // 헤더 부분은 버퍼에 모아둠
+    if (write_offset < MODEL_DATA_OFFSET) {
+        size_t header_part = MODEL_DATA_OFFSET - write_offset;
+        if (header_part > length) {
+            header_part = length;
+        }
+        memcpy(header_buffer + write_offset, data, header_part);
+        write_offset += header_part;
+        data += header_part;
+        length -= header_part;
+    }
+
+    if (length > 0) {
+        esp_err_t ret = esp_partition_write(partition, write_slot * MODEL_SLOT_SIZE + write_offset, data, length);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to write slot %d (%s)", write_slot, esp_err_to_name(ret));
+            return ret;
+        }
+        write_offset += length;
+    }
+    return ESP_OK;
+}
+
+esp_err_t model_store_finish(model_entry_t *entry) {
+    if (write_slot < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    int slot = write_slot;
+    write_slot = -1;
+
+    model_package_header_t *header = (model_package_header_t *)header_buffer;
+    if (write_offset != write_expected || !header_valid(header) ||
+        header->data_offset + header->model_size != write_expected) {
+        ESP_LOGE(TAG, "Invalid model package received.");
+        map_slot(slot);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    // 새 sequence를 붙이고 헤더 CRC를 다시 계산한 다음, 헤더를 마지막에 씀
+    header->sequence = write_sequence;
+    header->header_crc32 = esp_rom_crc32_le(0, header_buffer, offsetof(model_package_header_t, header_crc32));
+    esp_err_t ret = esp_partition_write(partition, slot * MODEL_SLOT_SIZE, header_buffer, MODEL_DATA_OFFSET);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write header of slot %d (%s)", slot, esp_err_to_name(ret));
+        map_slot(slot);
+        return ret;
+    }
+
+    ret = map_slot(slot);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (!load_slot(slot, entry)) {
+        ESP_LOGE(TAG, "Slot %d failed verification after write.", slot);
+        return ESP_ERR_INVALID_CRC;
+    }
+    ESP_LOGI(TAG, "Model written to slot %d (sequence %lu).", slot, (unsigned long)entry->sequence);
+    return ESP_OK;
+}
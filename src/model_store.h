@@ -0,0 +1,84 @@
+#ifndef MODEL_STORE_H
+#define MODEL_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "keyword_detector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 모델 파티션(partitions.csv의 "model")에 저장되는 모델 패키지 형식
+// 파티션은 두 개의 슬롯으로 나뉘고, 새 모델은 항상 사용하지 않는 슬롯에 씁니다.
+// (쓰는 도중에 전원이 나가도 기존 모델은 그대로 남아있음)
+//
+// [슬롯]
+//   0x000: model_package_header_t (헤더 + 라벨 테이블, 512바이트)
+//   0x200: .tflite flatbuffer (model_size 바이트)
+//
+// 패키지는 scripts/model_pack.py로 만듭니다. 형식을 바꾸면 스크립트도 같이 수정해주세요.
+
+#define MODEL_PARTITION_LABEL   "model"
+#define MODEL_PARTITION_SUBTYPE 0x40        // partitions.csv의 SubType과 동일
+#define MODEL_SLOT_COUNT        2
+#define MODEL_SLOT_SIZE         0x20000     // 슬롯 하나 크기 (128KB)
+#define MODEL_PACKAGE_MAGIC     0x444D464F  // "OFMD"
+#define MODEL_PACKAGE_VERSION   1
+#define MODEL_DATA_OFFSET       0x200       // 슬롯 안에서 flatbuffer 시작 위치 (16바이트 정렬 유지)
+#define MODEL_LABEL_SIZE        32
+
+typedef struct __attribute__((packed)) {
+    char label[MODEL_LABEL_SIZE];   // UTF-8, NUL 종료
+    float threshold;
+    uint8_t smoothing;
+    uint8_t refractory;
+    uint8_t background;
+    uint8_t reserved;
+} model_package_class_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t data_offset;           // MODEL_DATA_OFFSET
+    uint32_t model_size;            // flatbuffer 크기
+    uint32_t model_crc32;           // flatbuffer CRC32 (zlib과 동일)
+    uint32_t sequence;              // 모델을 쓸 때마다 증가. 두 슬롯 중 큰 쪽이 최신
+    uint8_t num_classes;
+    uint8_t reserved[3];
+    model_package_class_t classes[KEYWORD_MAX_CLASSES];
+    uint32_t header_crc32;          // 이 필드 앞까지의 헤더 CRC32
+} model_package_header_t;
+
+// 메모리 맵된 모델 (flash를 그대로 가리키므로 복사하지 않음)
+typedef struct {
+    const uint8_t *model;           // flatbuffer 시작 주소
+    size_t model_size;
+    keyword_class_t classes[KEYWORD_MAX_CLASSES];
+    size_t num_classes;
+    uint32_t sequence;
+    int slot;                       // 파티션 슬롯 번호, 파티션이 아니면 -1
+} model_entry_t;
+
+// 모델 파티션을 찾고 두 슬롯을 메모리 맵합니다.
+esp_err_t model_store_init(void);
+
+// 헤더와 CRC가 올바른 슬롯 중 가장 최신 모델을 반환합니다. 없으면 ESP_ERR_NOT_FOUND.
+esp_err_t model_store_load(model_entry_t *entry);
+
+// 새 패키지 쓰기 시작: 현재 사용 중이 아닌 슬롯을 지웁니다. (active_slot은 현재 사용 중인 슬롯, 없으면 -1)
+esp_err_t model_store_begin(size_t package_size, int active_slot);
+
+// 패키지 데이터를 순서대로 씁니다.
+esp_err_t model_store_write(const uint8_t *data, size_t length);
+
+// 쓰기를 마치고 새 슬롯의 헤더/CRC를 검증한 뒤, 그 모델을 entry에 채웁니다.
+esp_err_t model_store_finish(model_entry_t *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MODEL_STORE_H
@@ -0,0 +1,105 @@
+#include "noise_suppressor.h"
+#include <string.h>
+#include "dsp_tables.h"
+
+#define NOISE_LOW_BAND_HZ 300
+// log 파워의 평균은 평균 파워의 log보다 γ/ln2 ≈ 0.83 (log2)만큼 작음 (지수분포)
+#define NOISE_LOG_BIAS 853
+
+// 2^(-x), x는 Q10 (x >= 0), 결과 Q15
+static int32_t exp2_neg_q15(int32_t x) {
+    int32_t integer = x >> 10;
+    if (integer >= 16) {
+        return 0;
+    }
+    int32_t frac = (x & (FRONTEND_LOG2_ONE - 1)) >> (10 - DSP_EXP2_TABLE_BITS);
+    return (int32_t)(dsp_exp2.q16[frac] >> (1 + integer));
+}
+
+static uint32_t isqrt32(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void noise_suppressor_default_config(noise_suppressor_config_t *config, int sample_rate) {
+    config->oversubtract_q12 = 5325;       // 1.3
+    config->oversubtract_low_q12 = 8192;   // 2.0
+    config->low_band_bins = (int16_t)(NOISE_LOW_BAND_HZ * FRONTEND_FFT_SIZE / sample_rate + 1);
+    config->gain_floor_q15 = 3277;         // 0.1 (-20dB)
+    config->noise_shift = 4;               // 16ms 프레임 기준 약 0.25초 시상수
+    config->warmup_frames = 16;
+}
+
+void noise_suppressor_init(noise_suppressor_t *ns, const noise_suppressor_config_t *config) {
+    memset(ns, 0, sizeof(*ns));
+    ns->config = *config;
+    for (int k = 0; k < FRONTEND_BINS; k++) {
+        ns->gain_q15[k] = 32767;
+    }
+}
+
+void noise_suppressor_apply(noise_suppressor_t *ns, audio_frontend_t *fe, bool speech) {
+    const noise_suppressor_config_t *config = &ns->config;
+    const int32_t floor2_q15 = (config->gain_floor_q15 * config->gain_floor_q15) >> 15;
+
+    // 1. 잡음 추정 갱신
+    if (ns->frames == 0) {
+        memcpy(ns->noise_log_power, fe->log_power, sizeof(ns->noise_log_power));
+    } else {
+        const bool learn = !speech || ns->frames < config->warmup_frames;
+        for (int k = 0; k < FRONTEND_BINS; k++) {
+            int32_t diff = fe->log_power[k] - ns->noise_log_power[k];
+            if (diff < 0) {
+                ns->noise_log_power[k] += diff >> 2;  // 잡음이 줄어들면 빠르게
+            } else if (learn) {
+                ns->noise_log_power[k] += diff >> config->noise_shift;
+            }
+        }
+    }
+    ns->frames++;
+
+    // 2. bin별 게인 계산 및 적용 (k와 N-k는 켤레 대칭이므로 같은 게인)
+    int16_t *spectrum = fe->spectrum;
+    for (int k = 0; k < FRONTEND_BINS; k++) {
+        // N/P = 2^(noise - power)
+        int32_t snr_log = fe->log_power[k] - ns->noise_log_power[k] - NOISE_LOG_BIAS;
+        int32_t ratio_q15 = snr_log <= 0 ? 32768 : exp2_neg_q15(snr_log);
+        int32_t beta = k < config->low_band_bins ? config->oversubtract_low_q12 : config->oversubtract_q12;
+        int32_t g2_q15 = 32768 - ((ratio_q15 * beta) >> 12);
+        if (g2_q15 < floor2_q15) {
+            g2_q15 = floor2_q15;
+        }
+        int32_t gain = (int32_t)isqrt32((uint32_t)g2_q15 << 15);
+        if (gain > 32767) {
+            gain = 32767;
+        }
+
+        // 올라갈 때는 바로, 내려갈 때는 이전 게인과 평균 (말 끝부분이 잘리지 않도록)
+        if (gain < ns->gain_q15[k]) {
+            gain = (gain + ns->gain_q15[k]) >> 1;
+        }
+        ns->gain_q15[k] = (int16_t)gain;
+
+        int16_t *bin = spectrum + 2 * k;
+        bin[0] = (int16_t)((bin[0] * gain) >> 15);
+        bin[1] = (int16_t)((bin[1] * gain) >> 15);
+        if (k != 0 && k != FRONTEND_FFT_SIZE / 2) {
+            int16_t *mirror = spectrum + 2 * (FRONTEND_FFT_SIZE - k);
+            mirror[0] = (int16_t)((mirror[0] * gain) >> 15);
+            mirror[1] = (int16_t)((mirror[1] * gain) >> 15);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef NOISE_SUPPRESSOR_H
+#define NOISE_SUPPRESSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "audio_frontend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 정상(stationary) 잡음 제거 (냉장고 컴프레서 험, 팬 소음)
+// audio_frontend의 스펙트럼을 받아서 bin별 게인을 곱합니다. (FFT는 특징 추출과 공유)
+// - 잡음 추정: VAD가 조용하다고 판단한 프레임에서만 bin별 log 파워를 천천히 따라감.
+//   (말하는 중에는 고정, 잡음이 줄어들면 바로 따라 내려감)
+// - 게인: 파워 스펙트럼 차감 G^2 = max(1 - β·N/P, floor^2)
+//   컴프레서 험과 고조파가 몰려 있는 저역(NOISE_LOW_BAND_HZ 이하)은 β를 크게 잡음.
+// - 게인을 시간축으로 평활화해서 musical noise를 줄임.
+
+#ifndef NOISE_SUPPRESSION
+#define NOISE_SUPPRESSION 1  // 0이면 wake_word.cpp에서 잡음 제거를 건너뜀
+#endif
+
+typedef struct {
+    int16_t oversubtract_q12;       // β (4096 = 1.0)
+    int16_t oversubtract_low_q12;   // 저역 β
+    int16_t low_band_bins;          // 저역 bin 개수
+    int16_t gain_floor_q15;         // 최소 게인 (-20dB → 3277)
+    uint8_t noise_shift;            // 조용한 프레임에서 잡음 추정 갱신 속도 (차이의 1/2^shift)
+    uint8_t warmup_frames;          // 시작 직후 VAD와 상관없이 잡음을 학습할 프레임 수
+} noise_suppressor_config_t;
+
+typedef struct {
+    noise_suppressor_config_t config;
+    int32_t noise_log_power[FRONTEND_BINS];  // bin별 잡음 log2 파워 (Q10)
+    int16_t gain_q15[FRONTEND_BINS];         // 이전 프레임 게인 (평활화용)
+    uint32_t frames;
+} noise_suppressor_t;
+
+void noise_suppressor_default_config(noise_suppressor_config_t *config, int sample_rate);
+
+void noise_suppressor_init(noise_suppressor_t *ns, const noise_suppressor_config_t *config);
+
+// audio_frontend_analyze() 뒤, audio_frontend_synthesize() 전에 호출
+// speech: VAD 결과 (true면 잡음 추정을 갱신하지 않음)
+void noise_suppressor_apply(noise_suppressor_t *ns, audio_frontend_t *fe, bool speech);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NOISE_SUPPRESSOR_H
@@ -0,0 +1,35 @@
+#include "pcm_convert.h"
+
+int pcm_convert_s32_block(const int32_t *in, int16_t *out, size_t count, int min_shift) {
+    // 블록 최대 크기: x ^ (x >> 31)는 음수면 -x-1 (분기 없는 절대값 근사), OR로 최상위 비트만 확인
+    uint32_t bits = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        bits |= (uint32_t)(in[i] ^ (in[i] >> 31)) | (uint32_t)(in[i + 1] ^ (in[i + 1] >> 31)) |
+                (uint32_t)(in[i + 2] ^ (in[i + 2] >> 31)) | (uint32_t)(in[i + 3] ^ (in[i + 3] >> 31));
+    }
+    for (; i < count; i++) {
+        bits |= (uint32_t)(in[i] ^ (in[i] >> 31));
+    }
+
+    // 최대값이 2^(msb+1) 미만이므로 (msb + 1) - shift <= 15 가 되도록
+    int shift = min_shift;
+    if (bits != 0) {
+        int needed = 32 - __builtin_clz(bits) - 15;
+        shift = needed > shift ? needed : shift;
+    }
+
+    i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32_t a = in[i] >> shift, b = in[i + 1] >> shift;
+        int32_t c = in[i + 2] >> shift, d = in[i + 3] >> shift;
+        out[i] = (int16_t)a;
+        out[i + 1] = (int16_t)b;
+        out[i + 2] = (int16_t)c;
+        out[i + 3] = (int16_t)d;
+    }
+    for (; i < count; i++) {
+        out[i] = (int16_t)(in[i] >> shift);
+    }
+    return shift;
+}
@@ -0,0 +1,30 @@
+#ifndef PCM_CONVERT_H
+#define PCM_CONVERT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// INMP441 24비트 샘플(32비트 슬롯, 왼쪽 정렬) → int16 변환 (블록 부동소수점)
+// 블록 최대값을 한 번 구해서 블록 전체에 같은 시프트를 적용합니다. (샘플마다 분기 없음)
+// - 평소에는 min_shift로 고정 (= 16 - min_shift 비트만큼 디지털 게인, 작은 소리도 16비트 안에서 살아남음)
+// - 큰 소리로 int16을 넘는 블록만 시프트를 키워서 클리핑 대신 6dB 단위로 줄임 (블록 단위 리미터)
+
+#ifndef MIC_32BIT_SLOT
+#define MIC_32BIT_SLOT 0  // 1이면 I2S를 32비트 슬롯으로 받아서 24비트를 모두 사용
+#endif
+#ifndef MIC_32BIT_MIN_SHIFT
+#define MIC_32BIT_MIN_SHIFT 12  // 16이면 상위 16비트만 사용 (16비트 슬롯과 같은 레벨), 12면 +24dB
+#endif
+
+// 반환값: 실제로 적용한 시프트 (min_shift ~ 16)
+int pcm_convert_s32_block(const int32_t *in, int16_t *out, size_t count, int min_shift);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PCM_CONVERT_H
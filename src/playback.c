@@ -0,0 +1,500 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "playback.h"
+#include "dsp_tables.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+
+static const char *TAG = "PLAYBACK";
+#endif
+
+_Static_assert((PLAYBACK_COMMANDS & (PLAYBACK_COMMANDS - 1)) == 0, "PLAYBACK_COMMANDS는 2의 거듭제곱");
+
+#define CHUNK 64                // 믹스 버퍼 (스택)
+#define Q30_ONE (1u << 30)
+#define EDGE_SAMPLES (5 * PLAYBACK_SAMPLE_RATE / 1000)  // 톤 어택/릴리즈 5ms
+#define CLIP_NONE 0xFF          // 클립 없는 명령 (멈춤, 음량)
+#define ADPCM_HEADER 4          // 블록 헤더: predictor(int16 LE), index, 0
+#define ADPCM_STEP (CHUNK / 2)  // 한 번에 디코딩하는 바이트
+
+enum {
+    COMMAND_PLAY,
+    COMMAND_INTERRUPT,
+    COMMAND_VOLUME,
+};
+
+void playback_init(playback_t *p) {
+    memset(p, 0, sizeof(*p));
+    for (int v = 0; v < PLAYBACK_VOICES; v++) {
+        p->voices[v].gain_q15 = 32767;
+    }
+    for (uint32_t i = 0; i < PLAYBACK_COMMANDS; i++) {
+        p->commands[i].sequence = i;
+    }
+}
+
+// 다중 생산자 / 단일 소비자 큐 (칸마다 sequence: 비었으면 위치, 채워졌으면 위치 + 1)
+// 생산자는 head를 CAS로 하나 잡은 뒤 내용을 쓰고 sequence로 알림. 락이 없어서 우선순위 역전이 없음
+static bool push_command(playback_t *p, uint8_t type, int voice, int16_t gain_q15, const playback_clip_t *clip) {
+    if (voice < 0 || voice >= PLAYBACK_VOICES) {
+        return false;
+    }
+    playback_command_t *slot;
+    uint32_t head = __atomic_load_n(&p->command_head, __ATOMIC_RELAXED);
+    while (1) {
+        slot = &p->commands[head % PLAYBACK_COMMANDS];
+        uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(sequence - head);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&p->command_head, &head, head + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+            // 실패하면 head가 최신 값으로 바뀜
+        } else if (diff < 0) {
+            __atomic_fetch_add(&p->stats.dropped_commands, 1, __ATOMIC_RELAXED);
+            return false;  // 가득 참 (render가 아직 꺼내지 않은 칸)
+        } else {
+            head = __atomic_load_n(&p->command_head, __ATOMIC_RELAXED);
+        }
+    }
+    slot->type = type;
+    slot->voice = (uint8_t)voice;
+    slot->gain_q15 = gain_q15;
+    if (clip) {
+        slot->clip = *clip;
+    } else {
+        memset(&slot->clip, 0, sizeof(slot->clip));
+        slot->clip.kind = CLIP_NONE;
+    }
+    __atomic_store_n(&slot->sequence, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// 맨 앞 명령 (없으면 NULL). 처리한 뒤에 pop_command로 칸을 돌려줌
+static const playback_command_t *front_command(const playback_t *p) {
+    const playback_command_t *slot = &p->commands[p->command_tail % PLAYBACK_COMMANDS];
+    uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    return sequence == p->command_tail + 1 ? slot : NULL;
+}
+
+static void pop_command(playback_t *p) {
+    playback_command_t *slot = &p->commands[p->command_tail % PLAYBACK_COMMANDS];
+    __atomic_store_n(&slot->sequence, p->command_tail + PLAYBACK_COMMANDS, __ATOMIC_RELEASE);
+    p->command_tail++;
+}
+
+bool playback_play(playback_t *p, int voice, const playback_clip_t *clip) {
+    return push_command(p, COMMAND_PLAY, voice, 0, clip);
+}
+
+bool playback_interrupt(playback_t *p, int voice, const playback_clip_t *clip) {
+    return push_command(p, COMMAND_INTERRUPT, voice, 0, clip);
+}
+
+bool playback_stop(playback_t *p, int voice) {
+    return push_command(p, COMMAND_INTERRUPT, voice, 0, NULL);
+}
+
+bool playback_volume(playback_t *p, int voice, int16_t gain_q15) {
+    return push_command(p, COMMAND_VOLUME, voice, gain_q15, NULL);
+}
+
+void playback_tone(playback_clip_t *clip, uint16_t frequency_hz, uint16_t duration_ms, uint16_t decay_ms, int16_t gain_q15) {
+    memset(clip, 0, sizeof(*clip));
+    clip->kind = PLAYBACK_TONE;
+    clip->gain_q15 = gain_q15;
+    clip->length = (uint32_t)duration_ms * PLAYBACK_SAMPLE_RATE / 1000;
+    clip->frequency_hz = frequency_hz;
+    clip->attack = EDGE_SAMPLES;
+    clip->release = EDGE_SAMPLES;
+    clip->decay_ms = decay_ms;
+}
+
+static void rest(playback_clip_t *clip, uint16_t duration_ms) {
+    memset(clip, 0, sizeof(*clip));
+    clip->kind = PLAYBACK_SILENCE;
+    clip->length = (uint32_t)duration_ms * PLAYBACK_SAMPLE_RATE / 1000;
+}
+
+bool playback_sound(playback_t *p, int voice, playback_sound_t sound) {
+    playback_clip_t clips[3];
+    size_t count = 0;
+    switch (sound) {
+    case PLAYBACK_BEEP:
+        playback_tone(&clips[count++], 1000, 120, 0, 16384);
+        break;
+    case PLAYBACK_CHIME_UP:
+        playback_tone(&clips[count++], 660, 220, 120, 20000);  // E5 → A5
+        playback_tone(&clips[count++], 880, 450, 160, 20000);
+        break;
+    case PLAYBACK_CHIME_DOWN:
+        playback_tone(&clips[count++], 880, 220, 120, 20000);
+        playback_tone(&clips[count++], 660, 450, 160, 20000);
+        break;
+    case PLAYBACK_ERROR:
+        playback_tone(&clips[count++], 330, 150, 0, 16384);
+        rest(&clips[count++], 80);
+        playback_tone(&clips[count++], 330, 150, 0, 16384);
+        break;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!playback_play(p, voice, &clips[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void playback_stream_init(playback_stream_t *s, uint8_t *buffer, uint32_t capacity) {
+    memset(s, 0, sizeof(*s));
+    s->buffer = buffer;
+    s->capacity = capacity;
+}
+
+void playback_stream_claim(playback_stream_t *s) {
+    s->written = 0;
+    s->read = 0;
+    __atomic_store_n(&s->busy, true, __ATOMIC_RELEASE);
+}
+
+size_t playback_stream_space(const playback_stream_t *s) {
+    return s->capacity - (s->written - __atomic_load_n(&s->read, __ATOMIC_ACQUIRE));
+}
+
+size_t playback_stream_write(playback_stream_t *s, const uint8_t *data, size_t size) {
+    size_t space = playback_stream_space(s);
+    size = size < space ? size : space;
+    for (size_t i = 0; i < size; i++) {
+        s->buffer[(s->written + i) & (s->capacity - 1)] = data[i];
+    }
+    __atomic_store_n(&s->written, s->written + (uint32_t)size, __ATOMIC_RELEASE);  // 내용을 쓴 뒤에 보이도록
+    return size;
+}
+
+bool playback_stream_free(const playback_stream_t *s) {
+    return !__atomic_load_n(&s->busy, __ATOMIC_ACQUIRE);
+}
+
+void playback_stream_release(playback_stream_t *s) {
+    __atomic_store_n(&s->busy, false, __ATOMIC_RELEASE);
+}
+
+// ---- 재생 태스크 ----
+
+static void release_clip(const playback_clip_t *clip) {
+    if (clip->kind == PLAYBACK_ADPCM && clip->stream) {
+        playback_stream_release(clip->stream);
+    }
+}
+
+// 자리는 render가 미리 확인함 (끼어들기는 대기열을 비운 뒤라 항상 자리가 있음)
+static void enqueue_clip(playback_voice_t *v, const playback_clip_t *clip) {
+    if (clip->kind == CLIP_NONE) {
+        return;
+    }
+    v->clips[v->head % PLAYBACK_SEQUENCE] = *clip;
+    v->head++;
+}
+
+static void apply_command(playback_t *p, const playback_command_t *command) {
+    playback_voice_t *v = &p->voices[command->voice];
+    switch (command->type) {
+    case COMMAND_PLAY:
+        enqueue_clip(v, &command->clip);
+        break;
+    case COMMAND_INTERRUPT:
+        // 대기열은 버리고, 재생 중인 클립은 줄인 뒤 끝냄 (이미 줄이는 중이면 그대로)
+        for (uint32_t i = v->tail + (v->active ? 1 : 0); i != v->head; i++) {
+            release_clip(&v->clips[i % PLAYBACK_SEQUENCE]);
+        }
+        v->head = v->tail + (v->active ? 1 : 0);
+        if (v->active && !v->fading) {
+            v->fading = true;
+            v->fade = PLAYBACK_FADE_SAMPLES;
+        }
+        enqueue_clip(v, &command->clip);
+        break;
+    case COMMAND_VOLUME:
+        v->gain_q15 = command->gain_q15;
+        break;
+    }
+}
+
+static void start_clip(playback_voice_t *v) {
+    const playback_clip_t *c = &v->clips[v->tail % PLAYBACK_SEQUENCE];
+    v->active = true;
+    v->fading = false;
+    v->position = 0;
+    v->source = 0;
+    v->block_offset = 0;
+    v->has_carry = false;
+    if (c->kind != PLAYBACK_TONE) {
+        return;
+    }
+    v->phase = 0;
+    v->phase_step = (uint32_t)(((uint64_t)c->frequency_hz << 32) / PLAYBACK_SAMPLE_RATE);
+    v->envelope_q30 = Q30_ONE;
+    v->decay_q30 = Q30_ONE;
+    if (c->decay_ms) {
+        // 클립마다 한 번만 (샘플마다는 곱셈): decay_ms 동안 곱하면 1/2
+        float samples = (float)c->decay_ms * PLAYBACK_SAMPLE_RATE / 1000.0f;
+        v->decay_q30 = (uint32_t)(exp2f(-1.0f / samples) * (float)Q30_ONE);
+    }
+    v->attack_step = c->attack ? Q30_ONE / c->attack : 0;
+    v->release_step = c->release ? Q30_ONE / c->release : 0;
+}
+
+static void finish_clip(playback_t *p, playback_voice_t *v) {
+    release_clip(&v->clips[v->tail % PLAYBACK_SEQUENCE]);
+    v->active = false;
+    v->fading = false;
+    v->tail++;
+    p->stats.clips++;
+}
+
+// 사인 웨이브테이블 발진기 (테이블 사이는 선형 보간) × 엔벨로프
+static void render_tone(playback_voice_t *v, const playback_clip_t *c, int32_t *out, size_t count) {
+    const int16_t *table = dsp_sine.q15;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t index = v->phase >> (32 - DSP_SINE_TABLE_BITS);
+        int32_t frac = (int32_t)((v->phase >> (32 - DSP_SINE_TABLE_BITS - 15)) & 0x7FFF);
+        int32_t a = table[index];
+        int32_t s = a + (((table[index + 1] - a) * frac) >> 15);
+        v->phase += v->phase_step;
+
+        uint32_t n = v->position + (uint32_t)i;
+        int32_t level = 32767;
+        if (n < c->attack) {
+            level = (int32_t)((n * v->attack_step) >> 15);
+        }
+        uint32_t left = c->length - n;
+        if (left <= c->release) {
+            int32_t r = (int32_t)(((left - 1) * v->release_step) >> 15);
+            level = r < level ? r : level;
+        }
+        level = (int32_t)(((int64_t)level * (v->envelope_q30 >> 15)) >> 15);
+        if (v->decay_q30 != Q30_ONE) {
+            v->envelope_q30 = (uint32_t)(((uint64_t)v->envelope_q30 * v->decay_q30) >> 30);
+        }
+        out[i] = (s * level) >> 15;
+    }
+}
+
+// ADPCM 바이트를 가져옴 (메모리 클립은 포인터 그대로, 스트림은 copy로 복사). 스트림에 minimum보다 적으면 0
+static size_t adpcm_bytes(playback_voice_t *v, const playback_clip_t *c, size_t count, size_t minimum,
+                          uint8_t *copy, const uint8_t **bytes) {
+    playback_stream_t *s = c->stream;
+    if (!s) {
+        *bytes = (const uint8_t *)c->data + v->source;
+        v->source += (uint32_t)count;
+        return count;
+    }
+    size_t available = __atomic_load_n(&s->written, __ATOMIC_ACQUIRE) - s->read;
+    if (available < minimum) {
+        return 0;
+    }
+    count = count < available ? count : available;
+    for (size_t i = 0; i < count; i++) {
+        copy[i] = s->buffer[(s->read + i) & (s->capacity - 1)];
+    }
+    __atomic_store_n(&s->read, s->read + (uint32_t)count, __ATOMIC_RELEASE);  // 읽는 태스크가 다시 채울 수 있음
+    *bytes = copy;
+    return count;
+}
+
+// WAV IMA ADPCM 블록을 필요한 만큼만 디코딩 (블록 헤더의 샘플이 블록 첫 샘플, 이어서 바이트마다 두 샘플)
+// 반환: 만든 샘플 수 (스트림이 비면 count보다 적음)
+static size_t render_adpcm(playback_voice_t *v, const playback_clip_t *c, int32_t *out, size_t count) {
+    uint8_t copy[ADPCM_STEP];
+    int16_t pcm[2 * ADPCM_STEP];
+    const uint8_t *bytes;
+    size_t produced = 0;
+    while (produced < count) {
+        if (v->has_carry) {
+            out[produced++] = v->carry;
+            v->has_carry = false;
+            continue;
+        }
+        if (v->block_offset == 0) {
+            if (!adpcm_bytes(v, c, ADPCM_HEADER, ADPCM_HEADER, copy, &bytes)) {
+                break;
+            }
+            v->adpcm.predictor = (int16_t)(bytes[0] | bytes[1] << 8);
+            v->adpcm.index = bytes[2] > 88 ? 88 : bytes[2];
+            v->block_offset = ADPCM_HEADER;
+            out[produced++] = v->adpcm.predictor;
+            continue;
+        }
+        size_t want = (count - produced + 1) / 2;
+        size_t left = (size_t)c->block_bytes - v->block_offset;
+        want = want < left ? want : left;
+        want = want < ADPCM_STEP ? want : ADPCM_STEP;
+        size_t got = adpcm_bytes(v, c, want, 1, copy, &bytes);
+        if (!got) {
+            break;
+        }
+        ima_adpcm_decode(&v->adpcm, bytes, pcm, 2 * got);
+        size_t n = 2 * got;
+        if (n > count - produced) {
+            n = count - produced;  // 홀수: 마지막 샘플은 다음에
+            v->carry = pcm[n];
+            v->has_carry = true;
+        }
+        for (size_t i = 0; i < n; i++) {
+            out[produced + i] = pcm[i];
+        }
+        produced += n;
+        v->block_offset += (uint16_t)got;
+        if (v->block_offset >= c->block_bytes) {
+            v->block_offset = 0;
+        }
+    }
+    return produced;
+}
+
+// 반환: 만든 샘플 수 (ADPCM 스트림이 비었을 때만 count보다 적음)
+static size_t render_clip(playback_voice_t *v, const playback_clip_t *c, int32_t *out, size_t count) {
+    switch (c->kind) {
+    case PLAYBACK_PCM16: {
+        const int16_t *data = (const int16_t *)c->data + v->position;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = data[i];
+        }
+        break;
+    }
+    case PLAYBACK_PCM8: {
+        const uint8_t *data = (const uint8_t *)c->data + v->position;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = ((int32_t)data[i] - 128) << 8;
+        }
+        break;
+    }
+    case PLAYBACK_TONE:
+        render_tone(v, c, out, count);
+        break;
+    case PLAYBACK_ADPCM:
+        return render_adpcm(v, c, out, count);
+    default:
+        memset(out, 0, count * sizeof(int32_t));
+        break;
+    }
+    return count;
+}
+
+// 보이스 하나를 mix에 더함. 클립이 끝나면 같은 블록 안에서 바로 다음 클립
+static void render_voice(playback_t *p, playback_voice_t *v, int32_t *mix, size_t count) {
+    int32_t samples[CHUNK];
+    size_t done = 0;
+    while (done < count) {
+        if (!v->active) {
+            if (v->head == v->tail) {
+                return;  // 쉬는 중
+            }
+            start_clip(v);
+        }
+        const playback_clip_t *c = &v->clips[v->tail % PLAYBACK_SEQUENCE];
+        size_t n = count - done;
+        if (c->length - v->position < n) {
+            n = c->length - v->position;
+        }
+        if (v->fading && v->fade < n) {
+            n = v->fade;
+        }
+
+        size_t wanted = n;
+        n = render_clip(v, c, samples, n);
+        int32_t gain = ((int32_t)c->gain_q15 * v->gain_q15) >> 15;
+        if (c->gain_q15 == 32767 && v->gain_q15 == 32767 && !v->fading) {
+            for (size_t i = 0; i < n; i++) {
+                mix[done + i] += samples[i];  // 음량 1.0: 클립을 비트 단위로 그대로
+            }
+        } else if (v->fading) {
+            for (size_t i = 0; i < n; i++) {
+                int32_t ramp = (int32_t)(v->fade - i - 1) * 32767 / PLAYBACK_FADE_SAMPLES;
+                mix[done + i] += (int32_t)(((int64_t)samples[i] * gain * ramp) >> 30);
+            }
+            v->fade -= (uint16_t)n;
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                mix[done + i] += (samples[i] * gain) >> 15;
+            }
+        }
+        v->position += (uint32_t)n;
+        done += n;
+
+        if (v->position >= c->length || (v->fading && v->fade == 0)) {
+            finish_clip(p, v);
+        } else if (n < wanted) {
+            // 스트림이 비었음: 이 블록의 나머지는 무음, 다음 블록에서 이어서 (줄이던 클립은 여기서 끝)
+            if (v->fading) {
+                finish_clip(p, v);
+                continue;
+            }
+            p->stats.starved += (uint32_t)(count - done);
+            return;
+        }
+    }
+}
+
+void playback_render(playback_t *p, int16_t *out, size_t count) {
+    const playback_command_t *command;
+    while ((command = front_command(p)) != NULL) {
+        const playback_voice_t *v = &p->voices[command->voice];
+        if (command->type == COMMAND_PLAY && v->head - v->tail >= PLAYBACK_SEQUENCE) {
+            break;  // 대기열이 빌 때까지 명령 큐에 둠 (가득 차면 생산자가 false를 받음)
+        }
+        apply_command(p, command);
+        pop_command(p);
+    }
+
+    int32_t mix[CHUNK];
+    for (size_t offset = 0; offset < count; offset += CHUNK) {
+        size_t n = count - offset < CHUNK ? count - offset : CHUNK;
+        memset(mix, 0, n * sizeof(int32_t));
+        for (int v = 0; v < PLAYBACK_VOICES; v++) {
+            render_voice(p, &p->voices[v], mix, n);
+        }
+        for (size_t i = 0; i < n; i++) {
+            int32_t s = mix[i];
+            if (s > 32767 || s < -32768) {
+                s = s > 0 ? 32767 : -32768;
+                p->stats.clipped++;
+            }
+            out[offset + i] = (int16_t)s;
+        }
+    }
+    p->stats.samples += (uint32_t)count;
+}
+
+bool playback_idle(const playback_t *p) {
+    for (int v = 0; v < PLAYBACK_VOICES; v++) {
+        if (p->voices[v].active || p->voices[v].head != p->voices[v].tail) {
+            return false;
+        }
+    }
+    return __atomic_load_n(&p->commands[p->command_tail % PLAYBACK_COMMANDS].sequence, __ATOMIC_ACQUIRE) !=
+           p->command_tail + 1;
+}
+
+void playback_to_dac(const int16_t *in, uint8_t *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int32_t u = ((int32_t)in[i] + 32768 + 128) >> 8;  // 반올림
+        out[i] = (uint8_t)(u > 255 ? 255 : u);
+    }
+}
+
+void playback_report(const playback_t *p) {
+    const playback_stats_t *s = &p->stats;
+    char line[160];
+    snprintf(line, sizeof(line), "samples %lu, clips %lu, clipped %lu, dropped %lu commands, starved %lu samples",
+             (unsigned long)s->samples, (unsigned long)s->clips, (unsigned long)s->clipped,
+             (unsigned long)s->dropped_commands, (unsigned long)s->starved);
+#ifdef ESP_PLATFORM
+    ESP_LOGI(TAG, "%s", line);
+#else
+    printf("%s\n", line);
+#endif
+}
@@ -0,0 +1,169 @@
+#ifndef PLAYBACK_H
+#define PLAYBACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ima_adpcm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 재생 믹서 (speaker.c의 재생 서비스 태스크가 DAC 블록마다 playback_render 호출)
+// - 보이스마다 클립 대기열: 클립이 끝난 바로 다음 샘플부터 다음 클립 (블록 경계와 상관없이 끊김 없음)
+// - 보이스 두 개를 int32로 더한 뒤 int16으로 포화 (예: 안내 음성 위에 비프)
+// - 톤: 사인 웨이브테이블(dsp_sine) 발진기 + 엔벨로프(어택/릴리즈, 지수 감쇠)라서 짧은 효과음은 플래시 파일이 필요 없음
+// - 명령 큐는 락 없는 다중 생산자 큐: 어느 태스크에서나 playback_play 등을 부르고, 재생 태스크만 render
+//   (큐가 가득 차면 기다리지 않고 false. 보이스 대기열이 가득 차면 자리가 날 때까지 그 명령부터 큐에 남음)
+// - render는 메모리에 있는 클립과 스트림만 읽음 (파일 읽기 없음). 클립 데이터는 재생이 끝날 때까지 그대로 있어야 함
+// - ADPCM 클립 (WAV IMA ADPCM 블록): 블록마다 필요한 만큼만 바로 디코딩. 긴 안내 음성은 스트림으로
+//   (다른 태스크가 파일을 읽어서 playback_stream_write, 스트림이 비면 그 보이스만 무음으로 기다렸다가 이어서)
+// 호스트: host/render_playback.c (블록 크기와 상관없는 결과, 포화, 톤 주파수, 여러 태스크에서 명령, 처리 시간)
+
+#ifndef PLAYBACK_SAMPLE_RATE
+#define PLAYBACK_SAMPLE_RATE 8000  // speaker.c DAC 출력 (SPIFFS WAV 파일과 같음)
+#endif
+#define PLAYBACK_VOICES 2          // 0: 안내 음성, 1: 효과음 (어느 쪽에 무엇을 넣어도 됨)
+#define PLAYBACK_COMMANDS 16       // 명령 큐 길이 (2의 거듭제곱)
+#define PLAYBACK_SEQUENCE 8        // 보이스마다 대기할 수 있는 클립 수
+#define PLAYBACK_FADE_SAMPLES 32   // 멈추거나 끼어들 때 줄이는 길이 (4ms, 딸깍 소리 방지)
+
+typedef enum {
+    PLAYBACK_PCM16,    // int16 샘플
+    PLAYBACK_PCM8,     // unsigned 8비트 (DAC용 WAV, 128이 0)
+    PLAYBACK_TONE,     // 사인 (frequency_hz, attack/release, decay)
+    PLAYBACK_SILENCE,  // length만큼 쉼 (차임 음 사이)
+    PLAYBACK_ADPCM,    // WAV IMA ADPCM 모노 (block_bytes 블록, 블록 앞 4바이트 헤더). data 또는 stream에서
+} playback_kind_t;
+
+// ADPCM 스트림: 파일을 읽는 태스크 하나가 쓰고 render가 읽는 바이트 FIFO
+typedef struct {
+    uint8_t *buffer;
+    uint32_t capacity;         // 2의 거듭제곱
+    uint32_t written;          // 읽는 태스크만
+    uint32_t read;             // render만
+    bool busy;                 // 클립에 쓰는 중 (render가 클립을 끝내거나 버리면 false)
+} playback_stream_t;
+
+typedef struct {
+    uint8_t kind;              // playback_kind_t
+    int16_t gain_q15;          // 클립 음량 (32767 = 1.0)
+    uint32_t length;           // 샘플 수
+    const void *data;          // PCM16/PCM8
+    // 톤
+    uint16_t frequency_hz;
+    uint16_t attack;           // 샘플 수 (0에서 올라가는 길이)
+    uint16_t release;          // 샘플 수 (끝에서 0으로 내려가는 길이)
+    uint16_t decay_ms;         // 0이 아니면 이 시간마다 음량이 절반 (종소리)
+    // ADPCM
+    uint16_t block_bytes;      // WAV blockAlign (블록당 샘플 = (block_bytes - 4) * 2 + 1)
+    playback_stream_t *stream; // NULL이면 data에서
+} playback_clip_t;
+
+typedef enum {
+    PLAYBACK_BEEP,             // 1kHz 짧은 비프
+    PLAYBACK_CHIME_UP,         // 딩동 (올라감): 인식 시작
+    PLAYBACK_CHIME_DOWN,       // 동딩 (내려감): 인식 끝
+    PLAYBACK_ERROR,            // 낮은 음 두 번
+} playback_sound_t;
+
+typedef struct {
+    uint32_t samples;          // 출력한 샘플 수
+    uint32_t clips;            // 끝까지(또는 멈출 때까지) 재생한 클립 수
+    uint32_t clipped;          // 포화된 샘플 수 (믹스가 int16을 넘음)
+    uint32_t dropped_commands; // 명령 큐가 가득 차서 false를 돌려준 횟수
+    uint32_t starved;          // ADPCM 스트림이 비어서 무음으로 기다린 샘플
+} playback_stats_t;
+
+typedef struct {
+    uint32_t sequence;         // 이 칸 차례 (다중 생산자 큐)
+    uint8_t type;
+    uint8_t voice;
+    int16_t gain_q15;
+    playback_clip_t clip;
+} playback_command_t;
+
+typedef struct {
+    playback_clip_t clips[PLAYBACK_SEQUENCE];
+    uint32_t head;             // 대기열 (재생 태스크만)
+    uint32_t tail;
+    bool active;               // clips[tail]을 재생 중
+    uint32_t position;         // 재생 중인 클립의 샘플 위치
+    uint32_t phase;            // 톤 발진기 위상 (2^32 = 한 주기)
+    uint32_t phase_step;
+    uint32_t envelope_q30;     // 지수 감쇠
+    uint32_t decay_q30;        // 샘플마다 곱함
+    uint32_t attack_step;      // Q30 / attack
+    uint32_t release_step;
+    ima_adpcm_state_t adpcm;   // ADPCM 디코더
+    uint32_t source;           // 메모리 ADPCM 클립에서 다음에 읽을 바이트
+    uint16_t block_offset;     // 지금 블록에서 읽은 바이트 (0: 다음은 블록 헤더)
+    bool has_carry;            // 바이트 하나(샘플 둘) 중 아직 내보내지 않은 샘플
+    int16_t carry;
+    int16_t gain_q15;          // 보이스 음량
+    bool fading;               // 지금 클립을 줄이는 중 (멈춤, 끼어들기)
+    uint16_t fade;             // 줄이는 중이면 남은 샘플
+} playback_voice_t;
+
+typedef struct {
+    playback_voice_t voices[PLAYBACK_VOICES];
+    playback_stats_t stats;
+    // 명령 큐 (생산자: 아무 태스크, 소비자: render)
+    playback_command_t commands[PLAYBACK_COMMANDS];
+    uint32_t command_head;     // 생산자끼리 원자적으로 증가
+    uint32_t command_tail;
+} playback_t;
+
+void playback_init(playback_t *p);
+
+// 보이스 대기열 끝에 클립 추가 (앞 클립이 끝나면 바로 이어서). 명령 큐가 가득 차면 false
+bool playback_play(playback_t *p, int voice, const playback_clip_t *clip);
+
+// 보이스의 지금 클립과 대기열을 줄여서 멈추고 clip부터 재생 (clip이 NULL이면 멈추기만)
+bool playback_interrupt(playback_t *p, int voice, const playback_clip_t *clip);
+
+bool playback_stop(playback_t *p, int voice);
+
+// 보이스 음량 (32767 = 1.0, 기본값)
+bool playback_volume(playback_t *p, int voice, int16_t gain_q15);
+
+// 합성 효과음을 보이스 대기열에 추가. 명령을 다 넣지 못하면 false
+bool playback_sound(playback_t *p, int voice, playback_sound_t sound);
+
+// 톤 클립 채우기 (attack/release는 5ms, decay_ms가 0이면 끝까지 같은 크기)
+void playback_tone(playback_clip_t *clip, uint16_t frequency_hz, uint16_t duration_ms, uint16_t decay_ms, int16_t gain_q15);
+
+// (재생 태스크) 밀린 명령을 처리하고 count 샘플을 만듦. 재생할 것이 없으면 0
+void playback_render(playback_t *p, int16_t *out, size_t count);
+
+// 모든 보이스가 쉬는 중인지 (재생 태스크)
+bool playback_idle(const playback_t *p);
+
+// 스트림 (buffer 크기 capacity는 2의 거듭제곱). busy로 표시하고 채운 뒤 stream을 넣은 클립을 playback_play
+void playback_stream_init(playback_stream_t *s, uint8_t *buffer, uint32_t capacity);
+
+// (읽는 태스크) 비우고 busy로 표시. busy인 스트림은 쓰면 안 됨
+void playback_stream_claim(playback_stream_t *s);
+
+// (읽는 태스크) 들어가는 만큼 씀. 반환: 쓴 바이트
+size_t playback_stream_write(playback_stream_t *s, const uint8_t *data, size_t size);
+
+size_t playback_stream_space(const playback_stream_t *s);
+
+// (읽는 태스크) 클립이 끝났거나 버려졌는지 (다시 claim 가능)
+bool playback_stream_free(const playback_stream_t *s);
+
+// (읽는 태스크) 클립을 넣지 못했을 때 (playback_play가 false) busy를 풂
+void playback_stream_release(playback_stream_t *s);
+
+// int16 → DAC 8비트 (unsigned, 128이 0)
+void playback_to_dac(const int16_t *in, uint8_t *out, size_t count);
+
+void playback_report(const playback_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PLAYBACK_H
@@ -0,0 +1,18 @@
+#ifndef SOUND_EVENT_MODELS_H
+#define SOUND_EVENT_MODELS_H
+
+#include "sound_events.h"
+
+// 호출어와 같이 실행할 소리 이벤트 모델 목록 (wake_word.cpp에서만 include)
+// 모델 추가: 변환한 헤더(wake_word_model.h와 같은 형식, 라벨 테이블 포함)를 include하고 끝 표시 위에 한 줄 추가
+//   #include "glass_break_model.h"
+//   {"glass_break", glass_break_tflite, glass_break_tflite_len, glass_break_classes, 2, 250, 2, 62},
+//    이름,          모델,               크기,                   라벨 테이블,       클래스 수, hop(ms), 우선순위, 입력 프레임 수(약 1초)
+// 모델 수만큼 부팅 시 audio_pool에서 아레나를 받으므로(pool_budget의 "ev_persist", "ev_shared") 목록이 비어 있으면 메모리를 쓰지 않습니다.
+
+static const sound_event_model_t sound_event_models[] = {
+    {nullptr, nullptr, 0, nullptr, 0, 0, 0, 0},  // 끝 표시 (지우지 마세요)
+};
+#define SOUND_EVENT_MODEL_COUNT (sizeof(sound_event_models) / sizeof(sound_event_models[0]) - 1)
+
+#endif // SOUND_EVENT_MODELS_H
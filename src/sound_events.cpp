@@ -0,0 +1,256 @@
+#include <new>
+#include <math.h>
+#include "sound_events.h"
+#include "audio_ring.h"
+#include "audio_pool.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/schema/schema_utils.h"
+
+#include "esp_log.h"
+
+#define EVENT_OP_RESOLVER_SIZE 10  // 이벤트 모델용 연산자 개수 (register_event_ops)
+#define FEATURE_Q8_SHIFT 2  // mel log2 Q10 → Q8 (int16에 들어가도록, 해상도 1/256 log2)
+#define FEATURE_SILENCE (FRONTEND_LOG2_ZERO >> FEATURE_Q8_SHIFT)  // 부팅 직후 창 앞부분 (파워 0)
+
+static const char *TAG = "SOUND_EVENTS";
+
+typedef struct {
+    const sound_event_model_t* config;
+    uint8_t* persistent;  // 모델별 persistent 아레나 (audio_pool)
+    tflite::MicroInterpreter* interpreter;
+    TfLiteTensor* input;
+    TfLiteTensor* output;
+    keyword_detector_t detector;
+} event_slot_t;
+
+static tflite::MicroMutableOpResolver<EVENT_OP_RESOLVER_SIZE> resolver;
+alignas(tflite::MicroInterpreter) static uint8_t interpreter_buffers[SOUND_EVENT_MAX_MODELS][sizeof(tflite::MicroInterpreter)];
+static event_slot_t slots[SOUND_EVENT_MAX_MODELS];
+static size_t slot_count;
+static uint8_t* shared_arena;  // 모든 이벤트 모델의 중간 텐서 (추론 태스크에서 하나씩 실행하므로 겹치지 않음)
+static sound_event_callback_t event_callback;
+
+// 특징 스트림: 프레임마다 FRONTEND_MEL_BINS개의 int16 (Q8 log2). 링 위치 = 프레임 번호 * FRONTEND_MEL_BINS (32비트에서 같이 돌아감)
+static audio_ring_t features;
+static volatile uint32_t feature_frames;
+
+// 작은 CNN/DS-CNN 이벤트 모델에 필요한 연산자 (새 연산자가 필요하면 추가하고 EVENT_OP_RESOLVER_SIZE를 늘려주세요)
+static void register_event_ops() {
+    resolver.AddReshape();
+    resolver.AddConv2D();
+    resolver.AddDepthwiseConv2D();
+    resolver.AddMaxPool2D();
+    resolver.AddAveragePool2D();
+    resolver.AddMean();
+    resolver.AddFullyConnected();
+    resolver.AddSoftmax();
+    resolver.AddQuantize();
+    resolver.AddDequantize();
+}
+
+static bool event_ops_supported(const sound_event_model_t* config, const tflite::Model* model) {
+    const auto* opcodes = model->operator_codes();
+    if (opcodes == nullptr) {
+        return false;
+    }
+    for (const tflite::OperatorCode* opcode : *opcodes) {
+        tflite::BuiltinOperator code = tflite::GetBuiltinCode(opcode);
+        if (code == tflite::BuiltinOperator_CUSTOM || resolver.FindOp(code) == nullptr) {
+            ESP_LOGE(TAG, "%s: unsupported operator %s", config->name, tflite::EnumNameBuiltinOperator(code));
+            return false;
+        }
+    }
+    return true;
+}
+
+// 모델 하나 검증 → persistent 아레나 + 공유 아레나로 인터프리터 생성 → 입력/출력 모양 확인
+static bool load_event_model(event_slot_t* slot, const sound_event_model_t* config, uint8_t* interpreter_buffer) {
+    slot->config = config;
+    if (config->frames == 0 || config->frames > SOUND_EVENT_MAX_FRAMES || config->hop_ms < SOUND_EVENT_FRAME_MS) {
+        ESP_LOGE(TAG, "%s: invalid frames %u / hop %u ms", config->name, (unsigned)config->frames, (unsigned)config->hop_ms);
+        return false;
+    }
+    flatbuffers::Verifier verifier(config->model, config->model_size);
+    if (!tflite::VerifyModelBuffer(verifier)) {
+        ESP_LOGE(TAG, "%s: model flatbuffer is corrupted!", config->name);
+        return false;
+    }
+    const tflite::Model* model = tflite::GetModel(config->model);
+    if (model->version() != TFLITE_SCHEMA_VERSION || !event_ops_supported(config, model)) {
+        ESP_LOGE(TAG, "%s: unsupported model", config->name);
+        return false;
+    }
+
+    slot->persistent = static_cast<uint8_t*>(audio_pool_alloc(SOUND_EVENT_PERSISTENT_SIZE, AUDIO_POOL_CAP_INTERNAL));
+    if (slot->persistent == nullptr) {
+        ESP_LOGE(TAG, "%s: no persistent arena in audio pool", config->name);
+        return false;
+    }
+    tflite::MicroAllocator* allocator = tflite::MicroAllocator::Create(slot->persistent, SOUND_EVENT_PERSISTENT_SIZE,
+                                                                       shared_arena, SOUND_EVENT_SHARED_ARENA_SIZE);
+    if (allocator == nullptr) {
+        ESP_LOGE(TAG, "%s: failed to create arena allocator!", config->name);
+        return false;
+    }
+    slot->interpreter = new (interpreter_buffer) tflite::MicroInterpreter(model, resolver, allocator);
+    if (slot->interpreter->AllocateTensors() != kTfLiteOk) {
+        ESP_LOGE(TAG, "%s: failed to allocate tensors (persistent %d, shared %d bytes)", config->name,
+                 SOUND_EVENT_PERSISTENT_SIZE, SOUND_EVENT_SHARED_ARENA_SIZE);
+        return false;
+    }
+    slot->input = slot->interpreter->input(0);
+    slot->output = slot->interpreter->output(0);
+
+    size_t input_size = 1;
+    for (int d = 0; d < slot->input->dims->size; d++) {
+        input_size *= slot->input->dims->data[d];
+    }
+    if (input_size != (size_t)config->frames * FRONTEND_MEL_BINS) {
+        ESP_LOGE(TAG, "%s: model input of %u values, expected %u frames x %d mel bins", config->name,
+                 (unsigned)input_size, (unsigned)config->frames, FRONTEND_MEL_BINS);
+        return false;
+    }
+    int num_classes = slot->output->dims->data[slot->output->dims->size - 1];
+    if (num_classes != config->num_classes || !keyword_detector_init(&slot->detector, config->classes, config->num_classes)) {
+        ESP_LOGE(TAG, "%s: model has %d output classes, label table has %u!", config->name, num_classes,
+                 (unsigned)config->num_classes);
+        return false;
+    }
+    ESP_LOGI(TAG, "%s: %u frames every %u ms, priority %u, arena %u bytes", config->name, (unsigned)config->frames,
+             (unsigned)config->hop_ms, (unsigned)config->priority, (unsigned)slot->interpreter->arena_used_bytes());
+    return true;
+}
+
+// 로드에 실패한 모델 정리 (같은 자리를 다음 모델이 씀)
+static void unload_event_model(event_slot_t* slot) {
+    if (slot->interpreter != nullptr) {
+        slot->interpreter->~MicroInterpreter();
+        slot->interpreter = nullptr;
+    }
+    if (slot->persistent != nullptr) {
+        audio_pool_free(slot->persistent);
+        slot->persistent = nullptr;
+    }
+}
+
+// 특징 링 버퍼의 최근 frames개 프레임 (frame 직전까지)을 입력 텐서로
+static bool fill_event_input(event_slot_t* slot, uint32_t frame) {
+    const uint32_t frames = slot->config->frames;
+    TfLiteTensor* input = slot->input;
+    int16_t mel[FRONTEND_MEL_BINS];
+    for (uint32_t f = 0; f < frames; f++) {
+        uint32_t index = frame - frames + f;
+        if (frame < frames && f < frames - frame) {
+            // 부팅 직후 아직 없는 프레임은 무음
+            for (int b = 0; b < FRONTEND_MEL_BINS; b++) {
+                mel[b] = FEATURE_SILENCE;
+            }
+        } else if (audio_ring_read(&features, index * FRONTEND_MEL_BINS, mel, FRONTEND_MEL_BINS) != FRONTEND_MEL_BINS) {
+            return false;  // 너무 밀려서 덮어써짐
+        }
+        if (input->type == kTfLiteInt8) {
+            const float scale = input->params.scale * (1 << (10 - FEATURE_Q8_SHIFT));
+            const int zero_point = input->params.zero_point;
+            for (int b = 0; b < FRONTEND_MEL_BINS; b++) {
+                int q = static_cast<int>(lroundf(mel[b] / scale)) + zero_point;
+                input->data.int8[f * FRONTEND_MEL_BINS + b] = static_cast<int8_t>(q < -128 ? -128 : (q > 127 ? 127 : q));
+            }
+        } else {
+            for (int b = 0; b < FRONTEND_MEL_BINS; b++) {
+                input->data.f[f * FRONTEND_MEL_BINS + b] = mel[b] / static_cast<float>(1 << (10 - FEATURE_Q8_SHIFT));
+            }
+        }
+    }
+    return true;
+}
+
+// model_scheduler 실행 콜백 (추론 태스크)
+static bool run_event_model(void* user, uint32_t frame) {
+    event_slot_t* slot = static_cast<event_slot_t*>(user);
+    if (!fill_event_input(slot, frame)) {
+        return false;
+    }
+    if (slot->interpreter->Invoke() != kTfLiteOk) {
+        return false;
+    }
+    float scores[KEYWORD_MAX_CLASSES];
+    const TfLiteTensor* output = slot->output;
+    for (size_t c = 0; c < slot->config->num_classes; c++) {
+        scores[c] = output->type == kTfLiteInt8 ? (output->data.int8[c] - output->params.zero_point) * output->params.scale
+                                                : output->data.f[c];
+    }
+    float smoothed[KEYWORD_MAX_CLASSES];
+    int detected = keyword_detector_update(&slot->detector, scores, slot->config->num_classes, smoothed);
+    if (detected >= 0 && event_callback != nullptr) {
+        event_callback(slot->config->name, slot->config->classes[detected].label, smoothed[detected]);
+    }
+    return true;
+}
+
+size_t sound_events_init(const sound_event_model_t* models, size_t count, model_scheduler_t* scheduler,
+                         sound_event_callback_t callback) {
+    if (count == 0) {
+        return 0;
+    }
+    if (count > SOUND_EVENT_MAX_MODELS) {
+        ESP_LOGW(TAG, "Only the first %d sound event models are used", SOUND_EVENT_MAX_MODELS);
+        count = SOUND_EVENT_MAX_MODELS;
+    }
+    event_callback = callback;
+    register_event_ops();
+    shared_arena = static_cast<uint8_t*>(audio_pool_alloc(SOUND_EVENT_SHARED_ARENA_SIZE, AUDIO_POOL_CAP_INTERNAL));
+    if (shared_arena == nullptr) {
+        ESP_LOGE(TAG, "No shared arena in audio pool! Check pool_budget.");
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        event_slot_t* slot = &slots[slot_count];
+        if (!load_event_model(slot, &models[i], interpreter_buffers[slot_count])) {
+            unload_event_model(slot);
+            continue;
+        }
+        uint32_t hop_frames = models[i].hop_ms / SOUND_EVENT_FRAME_MS;
+        if (model_scheduler_add(scheduler, models[i].name, hop_frames, models[i].priority, models[i].frames,
+                                run_event_model, slot) < 0) {
+            ESP_LOGE(TAG, "%s: scheduler is full (MODEL_SCHEDULER_MAX_MODELS)", models[i].name);
+            unload_event_model(slot);
+            continue;
+        }
+        slot_count++;
+    }
+    if (slot_count == 0) {
+        return 0;
+    }
+
+    // 특징 링 버퍼 (가장 긴 입력 창 + 추론 태스크가 밀릴 때의 여유)
+    if (!audio_ring_init(&features, (SOUND_EVENT_MAX_FRAMES + 16) * FRONTEND_MEL_BINS)) {
+        ESP_LOGE(TAG, "Failed to allocate feature ring buffer!");
+        slot_count = 0;
+        return 0;
+    }
+    return slot_count;
+}
+
+bool sound_events_active(void) {
+    return slot_count > 0;
+}
+
+void sound_events_push(void* user, const audio_frontend_t* frontend) {
+    int32_t mel[FRONTEND_MEL_BINS];
+    int16_t frame[FRONTEND_MEL_BINS];
+    audio_frontend_mel(frontend, mel);
+    for (int b = 0; b < FRONTEND_MEL_BINS; b++) {
+        int32_t v = mel[b] >> FEATURE_Q8_SHIFT;
+        frame[b] = static_cast<int16_t>(v < INT16_MIN ? INT16_MIN : (v > INT16_MAX ? INT16_MAX : v));
+    }
+    audio_ring_write(&features, frame, FRONTEND_MEL_BINS);
+    feature_frames = feature_frames + 1;  // 링 버퍼에 쓴 뒤에 (읽는 쪽은 이 프레임 수까지만 읽음)
+}
+
+uint32_t sound_events_frame(void) {
+    return feature_frames;
+}
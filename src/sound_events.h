@@ -0,0 +1,70 @@
+#ifndef SOUND_EVENTS_H
+#define SOUND_EVENTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "audio_frontend.h"
+#include "keyword_detector.h"
+#include "model_scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 소리 이벤트 모델 (유리 깨짐, 물 새는 소리, 문 열림 알림음 등)
+// - 호출어 모델과 같은 캡처 파이프라인의 STFT를 다시 쓰는 log mel 특징 스트림을 구독합니다. (FFT를 다시 하지 않음)
+//   캡처 태스크가 hop(16ms)마다 sound_events_push()로 mel 프레임을 링 버퍼에 쓰고,
+//   추론 태스크의 model_scheduler가 모델마다 자기 hop/우선순위로 최근 frames개 프레임을 입력으로 실행합니다.
+// - 모델마다 작은 persistent 아레나(텐서 구조체, 연산자 데이터)만 따로 두고, 중간 텐서(입력 포함)는 공유 아레나 하나를
+//   번갈아 씁니다. 모델은 추론 태스크에서 하나씩 차례로 실행되므로 수명이 겹치지 않습니다.
+//   (호출어 모델은 아레나 배치 캐시를 쓰고 절대 기다리면 안 되므로 자기 아레나를 그대로 씀)
+// - 입력: 시간 순서 frames x FRONTEND_MEL_BINS, 값은 log2 mel 에너지 (audio_frontend_mel / 1024). int8 모델은 입력 양자화 파라미터로 변환
+// - 출력: 클래스별 확률 → keyword_detector (라벨 테이블 형식은 호출어 모델과 같음)
+
+#ifndef SOUND_EVENT_PERSISTENT_SIZE
+#define SOUND_EVENT_PERSISTENT_SIZE (8 * 1024)  // 모델별 persistent 아레나
+#endif
+#ifndef SOUND_EVENT_SHARED_ARENA_SIZE
+#define SOUND_EVENT_SHARED_ARENA_SIZE (48 * 1024)  // 모든 이벤트 모델이 번갈아 쓰는 중간 텐서 아레나
+#endif
+#ifndef SOUND_EVENT_MAX_FRAMES
+#define SOUND_EVENT_MAX_FRAMES 128  // 입력 창 최대 프레임 수 (16kHz에서 약 2초)
+#endif
+#define SOUND_EVENT_MAX_MODELS 4
+#define SOUND_EVENT_FRAME_MS (FRONTEND_HOP * 1000 / MODEL_SAMPLE_RATE)  // 특징 프레임 간격
+
+typedef struct {
+    const char *name;
+    const unsigned char *model;       // .tflite (flash)
+    unsigned int model_size;
+    const keyword_class_t *classes;   // 출력 텐서 순서의 라벨 테이블
+    uint8_t num_classes;
+    uint16_t hop_ms;                  // 추론 간격 (SOUND_EVENT_FRAME_MS 단위로 내림, 캡처 블록 32ms 이상 권장)
+    uint8_t priority;                 // 0이면 예산이 빠듯해도 미루지 않음, 클수록 먼저 미룸
+    uint16_t frames;                  // 입력 창 프레임 수 (SOUND_EVENT_MAX_FRAMES 이하)
+} sound_event_model_t;
+
+// 검출 알림 (추론 태스크에서 호출)
+typedef void (*sound_event_callback_t)(const char *model, const char *label, float score);
+
+// models의 모델을 검증/초기화하고 scheduler에 등록합니다. 아레나는 audio_pool에서 받음
+// (모델마다 SOUND_EVENT_PERSISTENT_SIZE, 모델이 있으면 공유 SOUND_EVENT_SHARED_ARENA_SIZE 하나).
+// 실패한 모델은 건너뜀. 반환: 등록한 모델 수
+size_t sound_events_init(const sound_event_model_t *models, size_t count, model_scheduler_t *scheduler,
+                         sound_event_callback_t callback);
+
+// 등록된 모델이 있는지 (없으면 특징 스트림을 만들 필요 없음)
+bool sound_events_active(void);
+
+// capture_pipeline hop_hook (캡처 태스크): 현재 프레임의 mel 특징을 특징 링 버퍼에 추가
+void sound_events_push(void *user, const audio_frontend_t *frontend);
+
+// 지금까지 추가한 특징 프레임 수 (model_scheduler_cycle의 frame)
+uint32_t sound_events_frame(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOUND_EVENTS_H
@@ -1,24 +1,50 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include "esp_system.h"
 #include "esp_log.h"
 #include "esp_spiffs.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "driver/dac_continuous.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "playback.h"
 
 static const char *TAG = "DAC_WAV";
 
 // DAC 설정
 #define DAC_CHANNEL DAC_CHAN_0 // GPIO 25번 핀 사용
-#define SAMPLE_RATE      8000 // WAV 파일 샘플링 속도 (Hz)
+#define SAMPLE_RATE      PLAYBACK_SAMPLE_RATE // WAV 파일 샘플링 속도 (Hz)
 
 // UART 연결 속도
 #define UART_BAUD_RATE  115200
 
-// WAV 파일 헤더 크기
-#define WAV_HEADER_SIZE 44
+// 재생 서비스: DAC는 한 번만 켜고 계속 돌림 (재생할 것이 없으면 무음). 예전처럼 파일마다 켜고 끄지 않음
+// DMA 버퍼 두 개(desc_num 2)를 번갈아 씀: 하나를 DAC가 내보내는 동안 태스크가 다음 블록을 만들어서 채움
+// 블록을 만드는 데는 메모리에 있는 클립과 스트림만 읽으므로(파일 읽기 없음) 블록 시간보다 훨씬 짧게 끝남
+// ADPCM 안내 음성도 블록마다 필요한 만큼만 디코딩 (디코딩 시간은 블록 만드는 시간에 포함, 로그의 Render)
+#ifndef PLAYBACK_BLOCK
+#define PLAYBACK_BLOCK 256  // 샘플 (8kHz에서 32ms). DMA 버퍼 하나 크기
+#endif
+#ifndef PLAYBACK_PRIORITY
+#define PLAYBACK_PRIORITY 12  // 캡처 태스크(10)보다 높게: 늦으면 바로 들리므로
+#endif
+
+// 빠른 부팅: SPIFFS 마운트는 파일 재생에만 필요하므로 별도 태스크에서 하고,
+// 그동안 app_main은 재생 서비스(DAC, 재생/안내 음성 태스크)를 시작하고 효과음을 냄
+static EventGroupHandle_t spiffs_events;
+#define SPIFFS_MOUNTED_BIT BIT0
+
+static playback_t playback;
+static int16_t mix_block[PLAYBACK_BLOCK];
+static uint8_t dac_block[PLAYBACK_BLOCK];
+static volatile uint32_t max_render_us;  // 블록 하나 만드는 데 걸린 최대 시간 (여유 확인)
+static volatile uint64_t total_render_us;
+static volatile uint32_t render_blocks;
 
 // SPIFFS 초기화
 void spiffs_init() {
@@ -26,7 +52,7 @@ void spiffs_init() {
         .base_path = "/spiffs",
         .partition_label = NULL,
         .max_files = 5, // 동시에 열 수 있는 최대 파일 수
-        .format_if_mount_failed = true
+        .format_if_mount_failed = true // 비어 있거나 깨진 파티션도 복구 (포맷 중에도 효과음은 재생됨)
     };
 
     esp_err_t ret = esp_vfs_spiffs_register(&conf);
@@ -45,75 +71,301 @@ void spiffs_init() {
     ESP_LOGI(TAG, "SPIFFS total: %d, used: %d", total, used);
 }
 
-// WAV 파일 재생 함수
-void play_wav(const char *file_path) {
+// SPIFFS 마운트 태스크 (마운트가 끝나면 재생 쪽에 알림)
+static void spiffs_mount_task(void *arg) {
+    spiffs_init();
+    xEventGroupSetBits(spiffs_events, SPIFFS_MOUNTED_BIT);
+    vTaskDelete(NULL);
+}
+
+#define WAV_FORMAT_PCM 1
+#define WAV_FORMAT_IMA_ADPCM 0x11
+
+typedef struct {
+    uint16_t format;
+    uint16_t channels;
+    uint32_t rate;
+    uint16_t bits;
+    uint16_t block_align;
+    uint32_t samples;    // fact 청크 (ADPCM)
+    uint32_t data_size;
+} wav_info_t;
+
+// RIFF 청크를 따라가서 fmt, fact를 읽고 data 시작에서 멈춤 (LIST 등 다른 청크는 건너뜀)
+static bool read_wav_header(FILE *file, const char *file_path, wav_info_t *info) {
+    uint8_t riff[12];
+    if (fread(riff, 1, sizeof(riff), file) != sizeof(riff) || memcmp(riff, "RIFF", 4) || memcmp(riff + 8, "WAVE", 4)) {
+        ESP_LOGE(TAG, "Not a WAV file: %s", file_path);
+        return false;
+    }
+    memset(info, 0, sizeof(*info));
+    uint8_t chunk[8];
+    while (fread(chunk, 1, sizeof(chunk), file) == sizeof(chunk)) {
+        uint32_t size = chunk[4] | chunk[5] << 8 | chunk[6] << 16 | (uint32_t)chunk[7] << 24;
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            uint8_t fmt[16];
+            if (fread(fmt, 1, sizeof(fmt), file) != sizeof(fmt)) {
+                break;
+            }
+            info->format = fmt[0] | fmt[1] << 8;
+            info->channels = fmt[2] | fmt[3] << 8;
+            info->rate = fmt[4] | fmt[5] << 8 | fmt[6] << 16 | (uint32_t)fmt[7] << 24;
+            info->block_align = fmt[12] | fmt[13] << 8;
+            info->bits = fmt[14] | fmt[15] << 8;
+            fseek(file, (long)(size - 16 + (size & 1)), SEEK_CUR);
+        } else if (memcmp(chunk, "fact", 4) == 0 && size >= 4) {
+            uint8_t fact[4];
+            if (fread(fact, 1, sizeof(fact), file) != sizeof(fact)) {
+                break;
+            }
+            info->samples = fact[0] | fact[1] << 8 | fact[2] << 16 | (uint32_t)fact[3] << 24;
+            fseek(file, (long)(size - 4 + (size & 1)), SEEK_CUR);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            info->data_size = size;
+            break;
+        } else {
+            fseek(file, (long)(size + (size & 1)), SEEK_CUR);
+        }
+    }
+
+    bool pcm = info->format == WAV_FORMAT_PCM && (info->bits == 8 || info->bits == 16);
+    bool adpcm = info->format == WAV_FORMAT_IMA_ADPCM && info->bits == 4 && info->block_align > 4;
+    if (!info->data_size || info->channels != 1 || (!pcm && !adpcm)) {
+        ESP_LOGE(TAG, "Unsupported WAV (format 0x%x, channels %u, %u bits): %s",
+                 info->format, info->channels, info->bits, file_path);
+        return false;
+    }
+    if (adpcm && !info->samples) {
+        // fact가 없으면 블록 수로 (마지막 블록이 덜 찼으면 조금 길어짐)
+        info->samples = info->data_size / info->block_align * ((info->block_align - 4) * 2 + 1);
+    }
+    if (pcm) {
+        info->samples = info->data_size / (info->bits / 8);
+    }
+    if (info->rate != SAMPLE_RATE) {
+        ESP_LOGW(TAG, "%s: %lu Hz (playback is %d Hz)", file_path, (unsigned long)info->rate, SAMPLE_RATE);
+    }
+    return true;
+}
+
+static void fill_clip(playback_clip_t *clip, const wav_info_t *info) {
+    memset(clip, 0, sizeof(*clip));
+    clip->kind = info->format == WAV_FORMAT_IMA_ADPCM ? PLAYBACK_ADPCM : (info->bits == 8 ? PLAYBACK_PCM8 : PLAYBACK_PCM16);
+    clip->gain_q15 = 32767;
+    clip->length = info->samples;
+    clip->block_bytes = info->block_align;
+}
+
+// WAV 파일을 메모리로 읽어서 클립으로 (부르는 태스크에서 파일을 읽으므로 재생 태스크는 막히지 않음)
+// 8비트(unsigned)/16비트 PCM, IMA ADPCM 모노. 클립 데이터는 해제하지 않음 (자주 쓰는 짧은 안내 음성용)
+bool load_wav(const char *file_path, playback_clip_t *clip) {
     FILE *file = fopen(file_path, "rb");
     if (!file) {
         ESP_LOGE(TAG, "Failed to open file: %s", file_path);
-        return;
+        return false;
+    }
+    wav_info_t info;
+    if (!read_wav_header(file, file_path, &info)) {
+        fclose(file);
+        return false;
     }
 
-    // WAV 헤더 건너뛰기
-    char wav_header[WAV_HEADER_SIZE];
-    if (fread(wav_header, 1, WAV_HEADER_SIZE, file) != WAV_HEADER_SIZE) {
-        ESP_LOGE(TAG, "Failed to read WAV header");
+    // 긴 안내 음성은 PSRAM에, 없으면 내부 RAM
+    void *data = heap_caps_malloc(info.data_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!data) {
+        data = heap_caps_malloc(info.data_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    if (!data || fread(data, 1, info.data_size, file) != info.data_size) {
+        ESP_LOGE(TAG, "Failed to read %lu bytes: %s", (unsigned long)info.data_size, file_path);
+        heap_caps_free(data);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    fill_clip(clip, &info);
+    clip->data = data;
+    ESP_LOGI(TAG, "Loaded %s: %lu samples", file_path, (unsigned long)clip->length);
+    return true;
+}
+
+// ADPCM 안내 음성 스트리밍: 태스크 하나가 파일을 조금씩 읽어서 스트림에 넣고, 재생 태스크가 블록마다 디코딩
+// 스트림 두 개를 번갈아 써서, 앞 안내 음성이 재생되는 동안 다음 것을 미리 채움 (끊김 없이 이어짐)
+#ifndef PROMPT_STREAM_BYTES
+#define PROMPT_STREAM_BYTES 2048  // 스트림 하나 (ADPCM 8kHz에서 약 0.5초)
+#endif
+#define PROMPT_STREAMS 2
+#define PROMPT_READ_BYTES 512     // 한 번에 읽는 양 (SPIFFS 페이지 두 개)
+#define PROMPT_PATH_MAX 48
+
+typedef struct {
+    char path[PROMPT_PATH_MAX];
+    uint8_t voice;
+} prompt_request_t;
+
+static QueueHandle_t prompt_queue;
+static playback_stream_t prompt_streams[PROMPT_STREAMS];
+static uint8_t prompt_buffers[PROMPT_STREAMS][PROMPT_STREAM_BYTES];
+
+static void stream_prompt(const prompt_request_t *request, playback_stream_t *stream) {
+    FILE *file = fopen(request->path, "rb");
+    if (!file) {
+        ESP_LOGE(TAG, "Failed to open file: %s", request->path);
+        return;
+    }
+    wav_info_t info;
+    if (!read_wav_header(file, request->path, &info) || info.format != WAV_FORMAT_IMA_ADPCM) {
+        ESP_LOGE(TAG, "Not an IMA ADPCM prompt (host/encode_prompts): %s", request->path);
         fclose(file);
         return;
     }
 
+    playback_stream_claim(stream);
+    uint8_t chunk[PROMPT_READ_BYTES];
+    uint32_t left = info.data_size;
+    bool queued = false;
+    while (left) {
+        size_t space = playback_stream_space(stream);
+        if (space < sizeof(chunk) && space < left) {
+            if (!queued) {
+                // 처음 채운 뒤에 재생 시작 (스트림이 비지 않도록)
+                playback_clip_t clip;
+                fill_clip(&clip, &info);
+                clip.stream = stream;
+                if (!playback_play(&playback, request->voice, &clip)) {
+                    ESP_LOGW(TAG, "Playback queue full, skipping %s", request->path);
+                    playback_stream_release(stream);
+                    fclose(file);
+                    return;
+                }
+                queued = true;
+            }
+            if (playback_stream_free(stream)) {
+                break;  // 멈춤/끼어들기로 버려짐
+            }
+            vTaskDelay(pdMS_TO_TICKS(20));  // 20ms에 ADPCM 80바이트씩 비워짐
+            continue;
+        }
+        size_t want = left < sizeof(chunk) ? left : sizeof(chunk);
+        want = want < space ? want : space;
+        size_t got = fread(chunk, 1, want, file);
+        if (got == 0) {
+            ESP_LOGE(TAG, "Read error: %s", request->path);
+            break;
+        }
+        playback_stream_write(stream, chunk, got);
+        left -= (uint32_t)got;
+    }
+    fclose(file);
+    if (!queued) {
+        // 스트림 하나에 다 들어가는 짧은 안내 음성
+        playback_clip_t clip;
+        fill_clip(&clip, &info);
+        clip.stream = stream;
+        if (!playback_play(&playback, request->voice, &clip)) {
+            playback_stream_release(stream);
+        }
+    }
+}
 
-    // DAC 설정
+static void prompt_task(void *arg) {
+    prompt_request_t request;
+    int next = 0;
+    while (1) {
+        xQueueReceive(prompt_queue, &request, portMAX_DELAY);
+        while (!playback_stream_free(&prompt_streams[next])) {
+            vTaskDelay(pdMS_TO_TICKS(20));  // 두 개 전 안내 음성이 끝날 때까지
+        }
+        stream_prompt(&request, &prompt_streams[next]);
+        next = (next + 1) % PROMPT_STREAMS;
+    }
+}
+
+// ADPCM 안내 음성 재생 요청 (파일은 prompt_task가 읽음). 요청 큐가 가득 차면 false
+bool play_prompt(const char *file_path, int voice) {
+    prompt_request_t request;
+    strncpy(request.path, file_path, sizeof(request.path) - 1);
+    request.path[sizeof(request.path) - 1] = '\0';
+    request.voice = (uint8_t)voice;
+    return xQueueSend(prompt_queue, &request, 0) == pdTRUE;
+}
+
+// 재생 서비스 태스크: 블록을 만들고 DMA 버퍼가 빌 때까지 기다렸다가 씀 (영원히)
+static void playback_task(void *arg) {
     dac_continuous_config_t dac_cfg = {
         .chan_mask = 1 << DAC_CHANNEL,
         .desc_num = 2,
-        .buf_size = 512,
+        .buf_size = PLAYBACK_BLOCK,
         .freq_hz = SAMPLE_RATE,
         .clk_src = DAC_DIGI_CLK_SRC_APLL // APLL 클럭 소스를 사용
     };
 
     dac_continuous_handle_t dac_handle;
-    esp_err_t ret = dac_continuous_new_channels(&dac_cfg, &dac_handle);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to configure DAC (%s)", esp_err_to_name(ret));
-        fclose(file);
-        return;
-    }
+    ESP_ERROR_CHECK(dac_continuous_new_channels(&dac_cfg, &dac_handle));
+    ESP_ERROR_CHECK(dac_continuous_enable(dac_handle));
 
-    ret = dac_continuous_enable(dac_handle);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to enable DAC Continuous (%s)", esp_err_to_name(ret));
-        dac_continuous_del_channels(dac_handle);
-        fclose(file);
-        return;
-    }
+    while (1) {
+        int64_t start = esp_timer_get_time();
+        playback_render(&playback, mix_block, PLAYBACK_BLOCK);
+        playback_to_dac(mix_block, dac_block, PLAYBACK_BLOCK);
+        uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+        if (elapsed > max_render_us) {
+            max_render_us = elapsed;
+        }
+        total_render_us += elapsed;
+        render_blocks++;
 
-    uint8_t buffer[256];
-    size_t bytes_read;
-    while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
-        size_t bytes_loaded = 0;
-        ret = dac_continuous_write(dac_handle, buffer, bytes_read, &bytes_loaded, portMAX_DELAY);
+        // 두 DMA 버퍼가 모두 차 있으면 하나가 빌 때까지 (블록 하나 시간) 기다림
+        size_t loaded = 0;
+        esp_err_t ret = dac_continuous_write(dac_handle, dac_block, PLAYBACK_BLOCK, &loaded, portMAX_DELAY);
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to write to DAC (%s)", esp_err_to_name(ret));
-            break;
         }
     }
+}
 
-    // DAC Continuous 비활성화
-    dac_continuous_disable(dac_handle);
-    dac_continuous_del_channels(dac_handle);
-    fclose(file);
-
-    ESP_LOGI(TAG, "Finished playing WAV file: %s", file_path);
+void speaker_start(void) {
+    playback_init(&playback);
+    for (int i = 0; i < PROMPT_STREAMS; i++) {
+        playback_stream_init(&prompt_streams[i], prompt_buffers[i], PROMPT_STREAM_BYTES);
+    }
+    prompt_queue = xQueueCreate(8, sizeof(prompt_request_t));
+    xTaskCreate(prompt_task, "prompt", 3072, NULL, 4, NULL);  // SPIFFS 읽기 (재생 태스크보다 한참 낮게)
+    xTaskCreatePinnedToCore(playback_task, "playback", 3072, NULL, PLAYBACK_PRIORITY, NULL, 1);
 }
 
 
 void app_main(void) {
     ESP_LOGI(TAG, "Initializing SPIFFS...");
-    spiffs_init();
+    spiffs_events = xEventGroupCreate();
+    xTaskCreate(spiffs_mount_task, "spiffs_mount", 4096, NULL, 1, NULL);
+    speaker_start();  // 재생 서비스와 효과음은 마운트를 기다리지 않음
+    playback_sound(&playback, 1, PLAYBACK_CHIME_UP);
 
+    // 파일(/spiffs) 읽기 전에 마운트 대기
+    xEventGroupWaitBits(spiffs_events, SPIFFS_MOUNTED_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+
+    playback_clip_t prompt;
+    bool loaded = load_wav("/spiffs/test.wav", &prompt);
     while (1) {
+        // 안내 음성 두 번을 끊김 없이 이어서, 그 위에 비프를 섞음
         ESP_LOGI(TAG, "Playing WAV file...");
-        play_wav("/spiffs/test.wav");
+        if (loaded) {
+            playback_play(&playback, 0, &prompt);
+            playback_play(&playback, 0, &prompt);
+        }
+        vTaskDelay(pdMS_TO_TICKS(500));
+        playback_sound(&playback, 1, PLAYBACK_BEEP);
+        vTaskDelay(pdMS_TO_TICKS(loaded ? 2 * prompt.length * 1000 / SAMPLE_RATE : 1000));
+        // ADPCM 안내 음성 (host/encode_prompts로 만든 파일, data/에 넣고 uploadfs)
+        play_prompt("/spiffs/prompt.wav", 0);
+        vTaskDelay(pdMS_TO_TICKS(3000));
+        playback_sound(&playback, 1, PLAYBACK_CHIME_DOWN);
+        uint32_t blocks = render_blocks;
+        ESP_LOGI(TAG, "Render max %lu us, average %lu us per %d-sample block (%d us available)",
+                 (unsigned long)max_render_us, (unsigned long)(blocks ? total_render_us / blocks : 0),
+                 PLAYBACK_BLOCK, PLAYBACK_BLOCK * 1000 / (SAMPLE_RATE / 1000));
+        playback_report(&playback);
         vTaskDelay(pdMS_TO_TICKS(1000)); // 1초 대기 후 반복
     }
 }
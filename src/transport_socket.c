@@ -0,0 +1,207 @@
+#include <string.h>
+#include <errno.h>
+#include "transport_socket.h"
+
+#ifdef ESP_PLATFORM
+#include "lwip/sockets.h"
+#include "esp_timer.h"
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // lwIP에는 SIGPIPE가 없음
+#endif
+
+_Static_assert(sizeof(struct sockaddr_in) <= sizeof(((transport_socket_t *)0)->address), "address field size");
+
+static uint32_t now_ms(void) {
+#ifdef ESP_PLATFORM
+    return (uint32_t)(esp_timer_get_time() / 1000);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+#endif
+}
+
+static bool would_block(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS || error == ENOMEM;
+}
+
+bool transport_socket_init(transport_socket_t *s, const char *host, uint16_t port, bool udp) {
+    memset(s, 0, sizeof(*s));
+    s->fd = -1;
+    s->udp = udp;
+    s->retry_ms = now_ms();
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &address.sin_addr) != 1) {
+        return false;
+    }
+    memcpy(s->address, &address, sizeof(address));
+    return true;
+}
+
+void transport_socket_close(transport_socket_t *s) {
+    if (s->fd >= 0) {
+        close(s->fd);
+    }
+    s->fd = -1;
+    s->connected = false;
+    s->leftover_size = 0;  // 새 연결은 패킷 경계에서 시작
+    s->leftover_sent = 0;
+}
+
+// 소켓을 열고 non-blocking connect 시작 (UDP는 바로 끝남)
+static void open_socket(transport_socket_t *s, uint32_t now) {
+    s->retry_ms = now + TRANSPORT_SOCKET_RETRY_MS;
+    s->fd = socket(AF_INET, s->udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+    if (s->fd < 0) {
+        return;
+    }
+    fcntl(s->fd, F_SETFL, fcntl(s->fd, F_GETFL, 0) | O_NONBLOCK);
+    if (!s->udp) {
+        int one = 1;  // 묶는 것은 audio_transport가 함 (Nagle로 더 기다리지 않도록)
+        setsockopt(s->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    if (connect(s->fd, (const struct sockaddr *)s->address, sizeof(struct sockaddr_in)) == 0) {
+        s->connected = true;
+        s->connects++;
+    } else if (errno != EINPROGRESS) {
+        transport_socket_close(s);
+    }
+}
+
+bool transport_socket_ready(transport_socket_t *s) {
+    if (s->connected) {
+        return true;
+    }
+    uint32_t now = now_ms();
+    if (s->fd < 0) {
+        if ((int32_t)(now - s->retry_ms) >= 0) {
+            open_socket(s, now);
+        }
+        return s->connected;
+    }
+
+    // 연결 중: 쓸 수 있게 되면 결과 확인
+    fd_set writable;
+    FD_ZERO(&writable);
+    FD_SET(s->fd, &writable);
+    struct timeval no_wait = {0, 0};
+    if (select(s->fd + 1, NULL, &writable, NULL, &no_wait) <= 0) {
+        if ((int32_t)(now - s->retry_ms) >= 0) {
+            transport_socket_close(s);  // 너무 오래 걸림: 다음 poll에 다시
+        }
+        return false;
+    }
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(s->fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+        transport_socket_close(s);
+        return false;
+    }
+    s->connected = true;
+    s->connects++;
+    return true;
+}
+
+static void disconnect(transport_socket_t *s) {
+    transport_socket_close(s);
+    s->disconnects++;
+    s->retry_ms = now_ms() + TRANSPORT_SOCKET_RETRY_MS;
+}
+
+// 지난 패킷의 남은 부분을 먼저 보냄. 다 보냈으면 true
+static bool send_leftover(transport_socket_t *s) {
+    while (s->leftover_sent < s->leftover_size) {
+        ssize_t n = send(s->fd, s->leftover + s->leftover_sent, s->leftover_size - s->leftover_sent,
+                         MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0) {
+            if (!would_block(errno)) {
+                disconnect(s);
+            }
+            return false;
+        }
+        s->leftover_sent += (size_t)n;
+    }
+    s->leftover_size = 0;
+    s->leftover_sent = 0;
+    return true;
+}
+
+static audio_transport_result_t socket_send(void *user, const audio_transport_header_t *header,
+                                            const audio_transport_span_t *spans, size_t count) {
+    transport_socket_t *s = (transport_socket_t *)user;
+    if (!transport_socket_ready(s)) {
+        return AUDIO_TRANSPORT_BUSY;  // 연결 중 (받는 쪽이 없으면 backlog를 넘는 만큼 버려짐)
+    }
+    if (s->leftover_size > 0 && !send_leftover(s)) {
+        return s->connected ? AUDIO_TRANSPORT_BUSY : AUDIO_TRANSPORT_ERROR;
+    }
+
+    // 헤더 + 링 버퍼 구간을 한 번에 (복사 없이)
+    struct iovec iov[1 + AUDIO_TRANSPORT_MAX_SPANS];
+    size_t total = sizeof(*header);
+    iov[0].iov_base = (void *)header;
+    iov[0].iov_len = sizeof(*header);
+    for (size_t i = 0; i < count && i < AUDIO_TRANSPORT_MAX_SPANS; i++) {
+        iov[1 + i].iov_base = (void *)spans[i].data;
+        iov[1 + i].iov_len = spans[i].size;
+        total += spans[i].size;
+    }
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = 1 + (count < AUDIO_TRANSPORT_MAX_SPANS ? count : AUDIO_TRANSPORT_MAX_SPANS);
+    ssize_t n = sendmsg(s->fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (n < 0) {
+        if (would_block(errno)) {
+            return AUDIO_TRANSPORT_BUSY;
+        }
+        if (!s->udp) {
+            disconnect(s);
+        }
+        return AUDIO_TRANSPORT_ERROR;  // UDP: 받는 쪽이 없다는 ICMP (ECONNREFUSED) 등, 소켓은 그대로
+    }
+
+    // TCP에서 일부만 들어감: 남은 부분만 복사해두고 이 패킷은 보낸 것으로 (링 버퍼는 그사이 덮어써질 수 있음)
+    if ((size_t)n < total && total <= sizeof(s->leftover)) {
+        size_t skip = (size_t)n;
+        s->leftover_size = 0;
+        for (size_t i = 0; i < (size_t)message.msg_iovlen; i++) {
+            const uint8_t *data = (const uint8_t *)iov[i].iov_base;
+            size_t size = iov[i].iov_len;
+            if (skip >= size) {
+                skip -= size;
+                continue;
+            }
+            memcpy(s->leftover + s->leftover_size, data + skip, size - skip);
+            s->leftover_size += size - skip;
+            skip = 0;
+        }
+        s->leftover_sent = 0;
+    } else if ((size_t)n < total) {
+        disconnect(s);  // MTU보다 큰 패킷 (설정 오류): 스트림 경계가 깨지므로 연결을 다시
+        return AUDIO_TRANSPORT_ERROR;
+    }
+    return AUDIO_TRANSPORT_SENT;
+}
+
+void transport_socket_backend(transport_socket_t *s, audio_transport_backend_t *backend) {
+    backend->name = s->udp ? "udp" : "tcp";
+    backend->mtu = TRANSPORT_SOCKET_MTU;
+    backend->send = socket_send;
+    backend->user = s;
+}
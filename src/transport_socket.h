@@ -0,0 +1,54 @@
+#ifndef TRANSPORT_SOCKET_H
+#define TRANSPORT_SOCKET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "audio_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// audio_transport 소켓 백엔드 (TCP/UDP, BSD 소켓이라 장치(lwIP)와 호스트(Linux)에서 같은 코드)
+// - 장치가 받는 쪽(PC, scripts/stream_receiver.py)에 연결. 받는 쪽이 없거나 끊기면 TRANSPORT_SOCKET_RETRY_MS마다 다시
+// - 기다리지 않음: 연결은 non-blocking connect, 보낼 때는 MSG_DONTWAIT로 헤더 + 링 버퍼 구간을 sendmsg 한 번에
+// - TCP에서 패킷 일부만 들어가면 남은 부분만 내부 버퍼(MTU)에 복사해두고 다음 send 때 먼저 보냄 (패킷 경계 유지)
+// - UDP: 패킷 하나 = 데이터그램 하나 (IP 조각이 나지 않도록 MTU를 1400으로)
+
+#ifndef TRANSPORT_SOCKET_MTU
+#define TRANSPORT_SOCKET_MTU 1400
+#endif
+#ifndef TRANSPORT_SOCKET_RETRY_MS
+#define TRANSPORT_SOCKET_RETRY_MS 1000  // 연결 재시도 간격 (연결 제한 시간도 같음)
+#endif
+
+typedef struct {
+    int fd;
+    bool udp;
+    bool connected;            // TCP: 연결됨, UDP: 소켓이 열려 있음
+    uint32_t retry_ms;         // 다음 연결 시도 (연결 중이면 포기할) 시각
+    uint8_t address[16];       // struct sockaddr_in (이 헤더가 소켓 헤더를 include하지 않도록)
+    uint8_t leftover[TRANSPORT_SOCKET_MTU];  // TCP: 아직 못 보낸 패킷의 뒷부분
+    size_t leftover_size;
+    size_t leftover_sent;
+    uint32_t connects;         // 연결된 횟수
+    uint32_t disconnects;      // 보내다 끊긴 횟수
+} transport_socket_t;
+
+// host: IPv4 주소 ("192.168.0.10"). 소켓은 처음 보낼 때 열림. 주소가 잘못됐으면 false
+bool transport_socket_init(transport_socket_t *s, const char *host, uint16_t port, bool udp);
+
+// audio_transport_init()에 넘길 백엔드
+void transport_socket_backend(transport_socket_t *s, audio_transport_backend_t *backend);
+
+// 연결 상태 확인/진행 (TCP 연결 중이면 끝났는지). 보낼 수 있으면 true
+bool transport_socket_ready(transport_socket_t *s);
+
+void transport_socket_close(transport_socket_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRANSPORT_SOCKET_H
@@ -0,0 +1,137 @@
+#include <string.h>
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "uart_link.h"
+
+static const char *TAG = "UART_LINK";
+
+static uint32_t link_baud;
+
+void uart_link_init(int baud_rate, size_t rx_buffer_size, size_t tx_buffer_size) {
+    uart_config_t uart_config = {
+        .baud_rate = baud_rate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE
+    };
+    ESP_ERROR_CHECK(uart_driver_install(UART_LINK_PORT, rx_buffer_size, tx_buffer_size, 0, NULL, 0));
+    ESP_ERROR_CHECK(uart_param_config(UART_LINK_PORT, &uart_config));
+    link_baud = baud_rate;
+    ESP_LOGI(TAG, "UART initialized successfully.");
+}
+
+void uart_link_send(const uint8_t *data, size_t length) {
+    size_t bytes_remaining = length;
+    const uint8_t *current_position = data;
+
+    while (bytes_remaining > 0) {
+        // 남은 데이터 중 한 번에 보낼 크기 결정
+        size_t chunk_size = (bytes_remaining > UART_LINK_CHUNK_SIZE) ? UART_LINK_CHUNK_SIZE : bytes_remaining;
+
+        // UART로 데이터 전송
+        uart_write_bytes(UART_LINK_PORT, (const char *)current_position, chunk_size);
+
+        // 포인터 이동 및 남은 데이터 크기 감소
+        current_position += chunk_size;
+        bytes_remaining -= chunk_size;
+    }
+}
+
+void uart_link_send_str(const char *str) {
+    uart_write_bytes(UART_LINK_PORT, str, strlen(str));
+}
+
+void uart_link_send_frame(const uint8_t *data, size_t length) {
+    uart_link_send_str(UART_LINK_FRAME_START);
+    uart_link_send(data, length);
+    uart_link_send_str(UART_LINK_FRAME_END);
+}
+
+static audio_transport_result_t transport_send(void *user, const audio_transport_header_t *header,
+                                               const audio_transport_span_t *spans, size_t count) {
+    bool audio = header->type == AUDIO_TRANSPORT_AUDIO;
+    size_t size = header->payload_size;
+    if (audio) {
+        size += strlen(UART_LINK_FRAME_START) + strlen(UART_LINK_FRAME_END);
+    }
+    size_t free_size = 0;
+    if (uart_get_tx_buffer_free_size(UART_LINK_PORT, &free_size) != ESP_OK || free_size < size) {
+        return AUDIO_TRANSPORT_BUSY;  // 캡처 태스크가 UART를 기다리지 않도록
+    }
+    if (audio) {
+        uart_link_send_str(UART_LINK_FRAME_START);
+    }
+    for (size_t i = 0; i < count; i++) {
+        uart_write_bytes(UART_LINK_PORT, (const char *)spans[i].data, spans[i].size);
+    }
+    if (audio) {
+        uart_link_send_str(UART_LINK_FRAME_END);
+    }
+    return AUDIO_TRANSPORT_SENT;
+}
+
+void uart_link_transport(audio_transport_backend_t *backend, size_t mtu) {
+    backend->name = "uart";
+    backend->mtu = mtu;
+    backend->send = transport_send;
+    backend->user = NULL;
+}
+
+static int rate_read_line(void *user, char *line, size_t size, uint32_t timeout_ms) {
+    return uart_link_read_line(line, size, pdMS_TO_TICKS(timeout_ms));
+}
+
+static void rate_write(void *user, const void *data, size_t size) {
+    uart_link_send((const uint8_t *)data, size);
+}
+
+static void rate_set_baud(void *user, uint32_t baud) {
+    uart_wait_tx_done(UART_LINK_PORT, portMAX_DELAY);  // 응답 줄은 이전 속도로 다 나가야 함
+    ESP_ERROR_CHECK(uart_set_baudrate(UART_LINK_PORT, baud));
+    vTaskDelay(pdMS_TO_TICKS(10));  // PC가 속도를 바꾸는 동안 들어온 잡음
+    uart_flush_input(UART_LINK_PORT);
+    link_baud = baud;
+}
+
+void uart_link_rate_io(link_rate_io_t *io) {
+    io->read_line = rate_read_line;
+    io->write = rate_write;
+    io->set_baud = rate_set_baud;
+    io->user = NULL;
+}
+
+uint32_t uart_link_baud(void) {
+    return link_baud;
+}
+
+int uart_link_read_line(char *line, size_t size, TickType_t timeout) {
+    size_t length = 0;
+    while (length + 1 < size) {
+        uint8_t c;
+        if (uart_read_bytes(UART_LINK_PORT, &c, 1, timeout) <= 0) {
+            return -1;
+        }
+        if (c == '\n') {
+            break;
+        }
+        if (c != '\r') {
+            line[length++] = (char)c;
+        }
+    }
+    line[length] = '\0';
+    return (int)length;
+}
+
+bool uart_link_read_exact(uint8_t *data, size_t length, TickType_t timeout) {
+    size_t received = 0;
+    while (received < length) {
+        int len = uart_read_bytes(UART_LINK_PORT, data + received, length - received, timeout);
+        if (len <= 0) {
+            return false;
+        }
+        received += len;
+    }
+    return true;
+}
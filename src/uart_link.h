@@ -0,0 +1,56 @@
+#ifndef UART_LINK_H
+#define UART_LINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "audio_transport.h"
+#include "link_rate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UART_LINK_PORT       UART_NUM_0
+#define UART_LINK_CHUNK_SIZE 1000       // UART 전송 청크 크기
+
+// 오디오 프레임 구분 태그 (sound_receiver.py에서 이 태그 사이의 데이터를 추출함)
+#define UART_LINK_FRAME_START "<DATA_START>"
+#define UART_LINK_FRAME_END   "<DATA_END>"
+
+// UART0(콘솔과 공유)를 PC와의 데이터 통로로 설정합니다.
+// tx_buffer_size가 0이면 전송이 끝날 때까지 기다리고, 0보다 크면 버퍼에 복사만 하고 바로 돌아옵니다.
+// (실시간 캡처 태스크에서 보낼 때는 송신 버퍼를 잡아야 I2S DMA를 놓치지 않음)
+void uart_link_init(int baud_rate, size_t rx_buffer_size, size_t tx_buffer_size);
+
+// UART_LINK_CHUNK_SIZE 단위로 나누어 전송
+void uart_link_send(const uint8_t *data, size_t length);
+
+// 문자열(태그, 응답) 전송
+void uart_link_send_str(const char *str);
+
+// <DATA_START> + data + <DATA_END> 형식의 프레임 하나를 전송
+void uart_link_send_frame(const uint8_t *data, size_t length);
+
+// audio_transport 백엔드: 오디오 패킷은 헤더 없이 <DATA_START> 프레임 하나로 (scripts/command_receiver.py 형식),
+// 이벤트는 글자 그대로. 송신 버퍼(tx_buffer_size)에 자리가 없으면 기다리지 않고 BUSY
+void uart_link_transport(audio_transport_backend_t *backend, size_t mtu);
+
+// 속도 협상(link_rate_serve)용 입출력: 속도를 바꿀 때는 송신 버퍼가 다 나간 뒤 바꾸고 수신 버퍼를 비움
+void uart_link_rate_io(link_rate_io_t *io);
+
+// 지금 속도 (uart_link_init 또는 협상한 속도)
+uint32_t uart_link_baud(void);
+
+// '\n'까지 한 줄을 읽습니다. ('\r', '\n'은 제거) 읽은 길이를 반환하고, 시간 초과면 -1.
+int uart_link_read_line(char *line, size_t size, TickType_t timeout);
+
+// 정확히 length 바이트를 읽습니다. 시간 초과면 false.
+bool uart_link_read_exact(uint8_t *data, size_t length, TickType_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_LINK_H
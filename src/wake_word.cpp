@@ -1,34 +1,364 @@
-#include "wake_word_model.h"  // 변환된 헤더 파일
+#include <new>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "wake_word_model.h"  // 변환된 헤더 파일 (모델 파티션이 비어있을 때 쓰는 기본 모델)
+#include "keyword_detector.h"  // 클래스별 임계값/평활화로 호출어·명령어 판별
+#include "model_store.h"  // 모델 파티션(flash)에서 모델을 메모리 맵해서 읽음
+#include "uart_link.h"  // PC와의 UART 통신 (모델 교체 명령, UART 전송 백엔드)
+#include "link_rate.h"  // UART 속도 협상 (LINK_RATE 명령)
+#include "audio_ring.h"  // 최근 오디오 링 버퍼 (모델 입력 창, 프리롤)
+#include "energy_vad.h"  // 명령어 캡처 종료(말 끝) 판단
+#include "capture_pipeline.h"  // 캡처 블록 처리: 데시메이션 → 전처리(DC 제거, AGC) → VAD → 잡음 제거
+#include "beamformer.h"  // 마이크 두 개(스테레오)일 때 delay-and-sum 빔포밍
+#include "pcm_convert.h"  // 32비트 슬롯(24비트 샘플) → int16 블록 부동소수점 변환
+#include "audio_config.h"  // I2S/모델 샘플링 레이트 (MODEL_SAMPLE_RATE)
+#include "audio_pool.h"  // 오디오/모델 버퍼 고정 블록 풀 (부팅 시 예산 테이블로 한 번 할당)
+#include "boot_profile.h"  // 부팅 단계별 시간 (리셋 → 첫 추론)
+#include "arena_plan.h"  // 텐서 아레나 배치 캐시 (RTC 메모리)
+#include "model_scheduler.h"  // 호출어 외 모델의 hop/우선순위 실행, 모델별 CPU 점유율
+#include "deadline_monitor.h"  // 단계별 마감 초과, DMA/링 버퍼 넘침, 지터와 과부하 정책
+#include "flash_stress.h"  // PLACEMENT_BENCH 중 다른 코어에서 flash 쓰기 부하
+#include "model_split.h"  // 호출어 모델을 앞/뒤 두 단계로 나눔 (INFERENCE_PIPELINE)
+#include "layer_pipeline.h"  // 앞 단계 → 뒤 단계 경계 텐서 이중 버퍼 (INFERENCE_PIPELINE)
+#include "sound_event_models.h"  // 같은 특징 스트림을 쓰는 소리 이벤트 모델 목록
+#include "compressor_monitor.h"  // 컴프레서 소리 상태 요약 (대역 통계, 배음, 동작 비율)
+#include "blackbox.h"  // 검출 앞뒤 오디오(ADPCM)와 점수를 flash 파티션에 기록
+#include "audio_transport.h"  // 명령어 오디오/이벤트 전송 (UART, Wi-Fi TCP/UDP 백엔드)
+#include "transport_socket.h"  // TCP/UDP 전송 백엔드
+#include "wifi_link.h"  // Wi-Fi STA 연결 (TCP/UDP 전송)
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"  // 필요한 연산자만 등록할 수 있음.
+#include "tensorflow/lite/micro/micro_allocator.h"  // 아레나 배치 캐시(CachedMemoryPlanner)를 쓰는 할당기
 #include "tensorflow/lite/micro/micro_interpreter.h" // TensorFlow Lite Micro 인터프리터를 정의하는 헤더 파일. 모델 데이터를 실행하고, 입력/출력 텐서를 관리함.
 #include "tensorflow/lite/schema/schema_generated.h" // TensorFlow Lite 모델의 스키마 정의를 포함하는 헤더 파일. 모델의 버전 및 구조를 확인함.
+#include "tensorflow/lite/schema/schema_utils.h" // 연산자 코드(GetBuiltinCode) 확인용
 #include "tensorflow/lite/micro/micro_log.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "driver/i2s_std.h" // I2S (마이크 입력 처리)를 위한 ESP32 드라이버.
 #include "esp_log.h"  // ESP32 로깅 유틸리티.
 #include "esp_system.h" // ESP32 시스템 관련 유틸리티.
+#include "esp_timer.h"  // PCM 주입 시 추론 시간 측정
+#include "esp_attr.h"  // IRAM_ATTR (I2S DMA 넘침 콜백)
+#include "esp_rom_crc.h"  // PCM 주입 시 모델 입력 창 CRC (호스트 시뮬레이터와 비교)
+#include "sdkconfig.h"  // CONFIG_PLACEMENT_* (Kconfig.projbuild, PLACEMENT_BENCH 보고용)
 
 #define I2S_NUM         I2S_NUM_0
-#define SAMPLE_RATE     16000
+#define SAMPLE_RATE     I2S_SAMPLE_RATE  // I2S 레이트 (링 버퍼 이후는 MODEL_SAMPLE_RATE)
 #define TENSOR_ARENA_SIZE 70 * 1024  // TENSOR_ARENA_SIZE->모델 실행에 필요한 메모리 공간 크기(바이트 단위)
+#define OP_RESOLVER_SIZE 9  // 등록할 연산자 개수
+#define UART_BAUD_RATE  460800  // 부팅 속도 (monitor_speed, 스크립트 기본값과 같음). 더 빠른 속도는 LINK_RATE 명령으로 협상
+#define UART_RX_BUFFER_SIZE 4096
+#define MODEL_CHUNK_SIZE 1024  // UART로 모델을 받을 때 한 번에 받는 크기
+#define MODEL_RX_TIMEOUT_MS 2000
+#define UART_TX_BUFFER_SIZE 16384  // 스트리밍 중 캡처 태스크가 UART 전송을 기다리지 않도록
+#define CAPTURE_BLOCK_SAMPLES 512  // I2S에서 한 번에 읽는 샘플 수 (32ms)
+#define MODEL_BLOCK_SAMPLES (CAPTURE_BLOCK_SAMPLES / MODEL_DECIMATION)  // 데시메이션 후 블록 크기
+static_assert(MODEL_BLOCK_SAMPLES % FRONTEND_HOP == 0, "capture block must be a multiple of the STFT hop");
+#define MODEL_WINDOW_MAX_SAMPLES MODEL_SAMPLE_RATE  // 모델 입력 창 최대 길이 (1초)
+#define INFERENCE_HOP_MS 100  // 추론 간격
+#define INFERENCE_HOP_SAMPLES (MODEL_SAMPLE_RATE * INFERENCE_HOP_MS / 1000)
+#define WAKE_WORD_CLASS 0  // 라벨 테이블의 첫 번째 클래스가 호출어
+
+// 모델 스케줄러: 추론 태스크가 캡처 블록마다 깨어날 때 쓸 수 있는 시간 (호출어 추론 포함)
+#ifndef SCHED_BUDGET_PERCENT
+#define SCHED_BUDGET_PERCENT 60  // 캡처 블록 시간(32ms)의 비율. 남은 시간보다 오래 걸리는 우선순위 낮은 모델은 미룸
+#endif
+#ifndef SCHED_MAX_DEFER
+#define SCHED_MAX_DEFER 8  // 한 모델을 연속으로 미룰 수 있는 최대 블록 수 (이후에는 예산을 넘겨도 실행)
+#endif
+#define SCHED_BUDGET_US ((uint32_t)((uint64_t)MODEL_BLOCK_SAMPLES * 1000000 / MODEL_SAMPLE_RATE * SCHED_BUDGET_PERCENT / 100))
+
+// 실시간 마감 감시 (DEADLINE_REPORT): 캡처 블록 처리, 추론 태스크 한 주기, 호출어 추론
+// 과부하가 이어지면 우선순위 낮은 소리 이벤트 모델을 멈추고, 그래도 밀리면 호출어 hop을 두 배로 (여유가 생기면 되돌림)
+#ifndef DEADLINE_POLICY
+#define DEADLINE_POLICY 1  // 0이면 세기만 하고 낮추지 않음
+#endif
+#ifndef DEADLINE_CAPTURE_PERCENT
+#define DEADLINE_CAPTURE_PERCENT 50  // 캡처 블록 처리 예산 (블록 시간의 비율)
+#endif
+#ifndef DEADLINE_INFERENCE_PERCENT
+#define DEADLINE_INFERENCE_PERCENT 100  // 추론 태스크 한 주기 (넘기면 다음 블록이 이미 기다림). 호출어 추론이 블록보다 긴 칩이면 늘려주세요
+#endif
+#ifndef DEADLINE_WAKE_WORD_PERCENT
+#define DEADLINE_WAKE_WORD_PERCENT 50  // 호출어 입력 복사 + Invoke (hop의 비율)
+#endif
+#define CAPTURE_BLOCK_US ((uint32_t)((uint64_t)MODEL_BLOCK_SAMPLES * 1000000 / MODEL_SAMPLE_RATE))
+#define INFERENCE_HOP_US ((uint32_t)INFERENCE_HOP_MS * 1000)
+
+// 코드/가중치 배치: 커널과 전처리의 IRAM 배치는 Kconfig.projbuild(PLACEMENT_*, placement.lf), 가중치는 여기서
+#ifndef MODEL_WEIGHTS_DRAM
+#define MODEL_WEIGHTS_DRAM 0  // 1이면 모델(flatbuffer)을 내부 DRAM에 복사해서 실행 (flash 캐시 미스 없음, MODEL_WEIGHTS_DRAM_MAX만큼 RAM 사용)
+#endif
+#ifndef MODEL_WEIGHTS_DRAM_MAX
+#define MODEL_WEIGHTS_DRAM_MAX (16 * 1024)  // 이보다 큰 모델은 flash에서 그대로 실행
+#endif
+#ifndef PLACEMENT_BENCH_RUNS
+#define PLACEMENT_BENCH_RUNS 50  // PLACEMENT_BENCH 명령의 기본 Invoke 횟수 (조합마다)
+#endif
+#ifdef CONFIG_PLACEMENT_IRAM_KERNELS
+#define PLACEMENT_KERNELS "iram"
+#else
+#define PLACEMENT_KERNELS "flash"
+#endif
+#ifdef CONFIG_PLACEMENT_IRAM_FRONTEND
+#define PLACEMENT_FRONTEND "iram"
+#else
+#define PLACEMENT_FRONTEND "flash"
+#endif
+
+// 두 코어 파이프라인 추론 설정
+#ifndef INFERENCE_PIPELINE
+#define INFERENCE_PIPELINE 0  // 1이면 호출어 모델을 두 단계로 나눠서 앞 단계는 추론 태스크(코어 0), 뒤 단계와 결과 처리는 코어 1에서 실행
+#endif
+#ifndef PIPELINE_MODEL_MAX
+#define PIPELINE_MODEL_MAX (16 * 1024)  // 나눈 모델 하나의 최대 크기 (앞/뒤 모두 원본 모델 크기, 더 큰 모델은 한 코어로)
+#endif
+#ifndef PIPELINE_BOUNDARY_MAX
+#define PIPELINE_BOUNDARY_MAX 1024  // 경계 텐서 최대 크기 (이보다 큰 텐서가 지나는 곳에서는 자르지 않음)
+#endif
+#ifndef PIPELINE_ARENA_SIZE
+#define PIPELINE_ARENA_SIZE (8 * 1024)  // 뒤 단계 텐서 아레나 (앞 단계는 TENSOR_ARENA_SIZE를 그대로 씀)
+#endif
+#ifndef PIPELINE_BACK_CORE
+#define PIPELINE_BACK_CORE 1
+#endif
+#ifndef PIPELINE_BENCH_RUNS
+#define PIPELINE_BENCH_RUNS 50  // PIPELINE_BENCH 명령의 기본 hop 수
+#endif
+
+// 호출어 뒤 명령어 캡처 설정 (platformio.ini build_flags에서 -DPREROLL_MS=500 형식으로 바꿀 수 있음)
+#ifndef PREROLL_MS
+#define PREROLL_MS 300  // 검출 시점 이전 오디오를 같이 보내서 명령어 앞부분이 잘리지 않도록
+#endif
+#ifndef END_OF_SPEECH_MS
+#define END_OF_SPEECH_MS 800  // 이만큼 조용하면 말이 끝난 것으로 판단
+#endif
+#ifndef CAPTURE_MAX_MS
+#define CAPTURE_MAX_MS 8000  // 최대 캡처 길이
+#endif
+#define PREROLL_SAMPLES (MODEL_SAMPLE_RATE * PREROLL_MS / 1000)
+#define END_OF_SPEECH_SAMPLES (MODEL_SAMPLE_RATE * END_OF_SPEECH_MS / 1000)
+#define CAPTURE_MAX_SAMPLES (MODEL_SAMPLE_RATE * CAPTURE_MAX_MS / 1000)
+
+// 마이크 두 개 설정: INMP441 두 개를 같은 I2S 버스에 연결하고 L/R 핀을 각각 GND/VDD로 (추가 GPIO 없음)
+#ifndef MIC_STEREO
+#define MIC_STEREO 0  // 1이면 스테레오로 받아서 빔포밍한 모노 오디오를 모델에 넣음
+#endif
+#ifndef BEAM_MIC_SPACING_MM
+#define BEAM_MIC_SPACING_MM 60.0f  // 두 마이크 사이 거리
+#endif
+#ifndef BEAM_STEER_DEG
+#define BEAM_STEER_DEG 0.0f  // 조향 방향. 0 = 마이크를 잇는 선의 수직 방향 (앞면에 가로로 붙였을 때 냉장고 앞쪽)
+#endif
+#ifndef BEAM_DOA
+#define BEAM_DOA 1  // 음성 블록마다 소리가 온 방향을 추정해서 호출어 검출 시 로그로 출력
+#endif
+
+// 빠른 부팅: 정전 후 최대한 빨리 다시 듣도록
+#ifndef FAST_BOOT
+#define FAST_BOOT 1  // 1이면 모델 초기화(검증, AllocateTensors)를 다른 코어에서 I2S/캡처 시작과 동시에 진행
+#endif
+#ifndef FAST_BOOT_MIN_AUDIO_MS
+#define FAST_BOOT_MIN_AUDIO_MS 300  // FAST_BOOT: 이만큼 오디오가 쌓이면 창이 다 차기 전에도 추론 시작 (앞부분은 무음)
+#endif
+#if FAST_BOOT
+#define FIRST_INFERENCE_SAMPLES (MODEL_SAMPLE_RATE * FAST_BOOT_MIN_AUDIO_MS / 1000)
+#else
+#define FIRST_INFERENCE_SAMPLES model_window
+#endif
+
+// PCM 주입: 마이크 대신 UART로 받은 오디오로 전체 파이프라인을 돌리고 hop마다 결과를 보냄 (scripts/pcm_inject.py)
+#ifndef PCM_INJECT
+#define PCM_INJECT 1
+#endif
+#define INJECT_WINDOW_BLOCKS 3  // 호스트가 INJECT_ACK 없이 미리 보낼 수 있는 블록 수
+#define INJECT_RX_TIMEOUT_MS 5000
+static_assert(INJECT_WINDOW_BLOCKS * (2 + CAPTURE_BLOCK_SAMPLES * 2) <= UART_RX_BUFFER_SIZE, "injected blocks must fit the UART RX buffer");
+
+// 컴프레서 상태 감시: 마이크 블록(전처리 전)마다 compressor_monitor, COMPRESSOR_PERIOD_S마다 HEALTH 줄을 UART로 보냄
+#ifndef COMPRESSOR_MONITOR
+#define COMPRESSOR_MONITOR 1
+#endif
+
+// 블랙박스: 검출될 때마다 앞뒤 오디오와 hop별 점수를 "blackbox" 파티션에 기록, BLACKBOX_DUMP 명령으로 전부 받음
+#ifndef BLACKBOX
+#define BLACKBOX 1
+#endif
+
+// 명령어 오디오/이벤트 전송 통로 (audio_transport): 호출어 뒤 명령어 오디오와 캡처 시작/끝 태그를 보냄
+// - TRANSPORT_UART: UART0 (콘솔과 공유, scripts/command_receiver.py). 기존과 같은 <DATA_START> 프레임
+// - TRANSPORT_TCP/UDP: Wi-Fi로 TRANSPORT_HOST:TRANSPORT_PORT에 (scripts/stream_receiver.py). 검출 이벤트도 같이 보냄
+//   (-DTRANSPORT=1 -DWIFI_SSID=\"..\" -DWIFI_PASSWORD=\"..\" -DTRANSPORT_HOST=\"192.168.0.10\")
+#define TRANSPORT_UART 0
+#define TRANSPORT_TCP 1
+#define TRANSPORT_UDP 2
+#ifndef TRANSPORT
+#define TRANSPORT TRANSPORT_UART
+#endif
+#ifndef TRANSPORT_HOST
+#define TRANSPORT_HOST "192.168.0.10"  // 받는 PC의 IPv4 주소
+#endif
+#ifndef TRANSPORT_PORT
+#define TRANSPORT_PORT 5005
+#endif
+#ifndef WIFI_SSID
+#define WIFI_SSID ""
+#endif
+#ifndef WIFI_PASSWORD
+#define WIFI_PASSWORD ""
+#endif
+#ifndef TRANSPORT_FLUSH_MS
+#define TRANSPORT_FLUSH_MS 40  // 패킷이 MTU만큼 차지 않아도 이만큼 기다렸으면 보냄 (지연 상한)
+#endif
+#define TRANSPORT_UART_MTU (sizeof(audio_transport_header_t) + 2 * AUDIO_BLOCK_BYTES)  // UART 프레임 하나 (헤더는 보내지 않음)
+
+// 오디오/모델 버퍼 예산: 부팅 시 audio_pool_init()으로 한 번에 할당하고 이후에는 힙을 쓰지 않음
+// 설정(MIC_STEREO, MIC_32BIT_SLOT 등)을 바꾸면 POOL_REPORT 명령으로 peak를 확인해서 개수를 맞춰주세요.
+#define AUDIO_BLOCK_BYTES (CAPTURE_BLOCK_SAMPLES * sizeof(int16_t))
+#define INPUT_CHUNK_SAMPLES 256  // 입력 텐서로 옮길 때 한 번에 읽는 샘플 수
+static const audio_pool_budget_t pool_budget[] = {
+    // 캡처 블록, 모델 수신 청크, 입력 텐서 청크 (+ 스테레오 오른쪽 채널)
+    {"block", AUDIO_BLOCK_BYTES, 3 + MIC_STEREO, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    // 스테레오 I2S 블록, 모노 32비트 슬롯 블록 (명령어 오디오는 audio_transport가 링 버퍼에서 바로 보냄)
+    {"wide", 2 * AUDIO_BLOCK_BYTES, MIC_STEREO + (MIC_32BIT_SLOT && !MIC_STEREO), AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    // 스테레오 + 32비트 슬롯 I2S 블록 (+ 블랙박스 섹터 버퍼)
+    {"raw", 4 * AUDIO_BLOCK_BYTES, (MIC_STEREO && MIC_32BIT_SLOT) + BLACKBOX, AUDIO_POOL_CAP_INTERNAL | AUDIO_POOL_CAP_DMA},
+    {"arena", TENSOR_ARENA_SIZE, 1, AUDIO_POOL_CAP_INTERNAL},
+    // 소리 이벤트 모델: 모델별 persistent 아레나 + 모든 이벤트 모델이 번갈아 쓰는 중간 텐서 아레나 (sound_events.h)
+    {"ev_persist", SOUND_EVENT_PERSISTENT_SIZE, SOUND_EVENT_MODEL_COUNT, AUDIO_POOL_CAP_INTERNAL},
+    {"ev_shared", SOUND_EVENT_SHARED_ARENA_SIZE, SOUND_EVENT_MODEL_COUNT > 0, AUDIO_POOL_CAP_INTERNAL},
+    // 블랙박스 ADPCM 링 (프리롤 + BLACKBOX_SLACK_MS)
+    {"blackbox", BLACKBOX_RING_BYTES(MODEL_BLOCK_SAMPLES), BLACKBOX, AUDIO_POOL_CAP_INTERNAL},
+    // 호출어 모델 복사본 (MODEL_WEIGHTS_DRAM)
+    {"weights", MODEL_WEIGHTS_DRAM_MAX, MODEL_WEIGHTS_DRAM, AUDIO_POOL_CAP_INTERNAL},
+    // 두 코어 파이프라인: 나눈 앞/뒤 모델, 뒤 단계 아레나, 경계 텐서 슬롯 (INFERENCE_PIPELINE)
+    {"pipe_model", PIPELINE_MODEL_MAX, 2 * INFERENCE_PIPELINE, AUDIO_POOL_CAP_INTERNAL},
+    {"pipe_arena", PIPELINE_ARENA_SIZE, INFERENCE_PIPELINE, AUDIO_POOL_CAP_INTERNAL},
+    {"pipe_slots", LAYER_PIPELINE_SLOTS * PIPELINE_BOUNDARY_MAX, INFERENCE_PIPELINE, AUDIO_POOL_CAP_INTERNAL},
+};
+static_assert(BLACKBOX_SECTOR_SIZE == 4 * AUDIO_BLOCK_BYTES, "blackbox sector buffer comes from the raw pool");
+
+#define CAPTURE_START_TAG "<CAPTURE_START>"
+#define CAPTURE_END_TAG "<CAPTURE_END>"
 
 static const char *TAG = "INMP441_TFLM"; // 로깅 시 표시될 태그를 정의합니다. 디버깅 및 로깅 메시지 구분에 사용됩니다.
 
 // TensorFlow Lite Micro 설정
-uint8_t tensor_arena[TENSOR_ARENA_SIZE]; // tensor_arena->모델 실행을 위한 메모리 버퍼. TensorFlow Lite Micro 인터프리터는 이 버퍼를 사용하여 중간 데이터, 가중치 등을 저장함.
+static uint8_t* tensor_arena; // tensor_arena->모델 실행을 위한 메모리 버퍼 (pool_budget의 "arena"). TensorFlow Lite Micro 인터프리터는 이 버퍼를 사용하여 중간 데이터, 가중치 등을 저장함.
+static tflite::MicroMutableOpResolver<OP_RESOLVER_SIZE> resolver; // 필요한 연산자만 등록할 수 있음.
+alignas(tflite::MicroInterpreter) static uint8_t interpreter_buffer[sizeof(tflite::MicroInterpreter)]; // 모델 교체 시 인터프리터를 다시 생성할 자리.
+alignas(CachedMemoryPlanner) static uint8_t planner_buffer[sizeof(CachedMemoryPlanner)]; // 아레나 배치 planner 자리 (인터프리터와 같이 다시 생성).
+static CachedMemoryPlanner* planner;
 tflite::MicroInterpreter* interpreter; // TensorFlow Lite Micro 인터프리터 객체.
 TfLiteTensor* input_tensor; // 모델의 입력 데이터를 저장하는 텐서.
 TfLiteTensor* output_tensor; // 모델의 출력 데이터를 저장하는 텐서.
+keyword_detector_t detector; // 출력 클래스(호출어, 명령어, 배경)별 평활화 및 검출 상태.
+static model_entry_t active_model; // 현재 사용 중인 모델 (flash를 가리킴)과 라벨 테이블.
+static uint8_t* weights_buffer; // 모델 복사본 (pool_budget의 "weights", MODEL_WEIGHTS_DRAM일 때만)
+static bool weights_dram = MODEL_WEIGHTS_DRAM; // tflm_load()에서 모델을 weights_buffer에 복사할지 (PLACEMENT_BENCH가 바꿈)
+static bool weights_in_dram; // 지금 인터프리터가 DRAM 복사본을 쓰는지
+static QueueHandle_t model_queue; // UART로 받은 새 모델을 추론 루프로 넘기는 큐.
+static SemaphoreHandle_t model_slot_lock; // 모델 교체(apply_pending_model)와 새 모델을 쓸 슬롯 고르기(receive_model) 사이
+static size_t model_window; // 모델 입력 창 길이 (샘플 수).
+static bool model_ready; // 인터프리터가 추론 가능한 상태인지 (모델 로드에 실패하면 새 모델이 올 때까지 추론하지 않음).
+static bool window_filled; // 부팅 후 링 버퍼에 모델 창 최대 길이만큼 오디오가 쌓였는지 (FAST_BOOT 무음 채우기).
+
+// 오디오 캡처 설정
+static audio_ring_t audio_ring; // 최근 오디오 (모델 입력 창 + 프리롤). 캡처 태스크가 계속 채움.
+static TaskHandle_t inference_task; // 새 오디오가 들어오면 깨울 추론 태스크.
+static volatile bool capture_active; // 호출어 뒤 명령어를 스트리밍하는 중인지 (끝 태그를 보낼 때까지). 추론 태스크가 바꿈.
+static audio_transport_t transport; // 명령어 오디오/이벤트 전송 (캡처 태스크가 poll, 추론 태스크가 시작/이벤트).
+#if TRANSPORT != TRANSPORT_UART
+static transport_socket_t transport_socket; // TCP/UDP 백엔드
+#endif
+static volatile float speech_direction; // 마지막 음성 블록의 방향 추정값 (도, MIC_STEREO && BEAM_DOA).
+static int16_t* input_chunk; // 링 버퍼 → 입력 텐서 복사용 (INPUT_CHUNK_SAMPLES, 추론 태스크 전용).
+static uint32_t last_position; // 마지막으로 추론한 링 버퍼 위치 (추론 태스크 전용).
+static volatile uint32_t processed_position; // 추론 태스크가 마지막으로 처리한 링 버퍼 위치.
+static uint32_t input_crc; // 마지막 모델 입력 창(int16)의 CRC32 (PCM 주입 중에만 계산).
+static int64_t last_invoke_us; // 마지막 Invoke() 시간.
+static model_scheduler_t scheduler; // 소리 이벤트 모델 실행 순서, 호출어/특징 추출 포함 모델별 CPU 점유율 (SCHED_REPORT).
+static int sched_wake_word; // scheduler의 external 항목: 호출어 추론 (추론 태스크)
+static int sched_frontend; // scheduler의 external 항목: 캡처 블록 처리 (캡처 태스크)
+static int sched_health; // scheduler의 external 항목: 컴프레서 상태 감시 (캡처 태스크, COMPRESSOR_MONITOR)
+static deadline_monitor_t deadline; // 단계별 마감, 잃은 오디오, 과부하 단계 (DEADLINE_REPORT)
+static int deadline_capture; // deadline 단계: 캡처 블록 처리 (캡처 태스크)
+static int deadline_inference; // deadline 단계: 추론 태스크 한 주기 (호출어 + 소리 이벤트 모델)
+static int deadline_wake_word; // deadline 단계: 호출어 추론 (hop마다)
+static uint32_t inference_hop = INFERENCE_HOP_SAMPLES; // 지금 호출어 hop (과부하 단계에 따라, 추론 태스크 전용)
+static volatile uint32_t bench_request; // command_task → 추론 태스크: PLACEMENT_BENCH Invoke 횟수 (0이면 없음)
+
+// 호출어 hop 하나의 결과 (wake_word_score → wake_word_result)
+typedef struct {
+    uint32_t position;                 // 추론한 입력 창의 끝
+    size_t num_classes;
+    int detected;                      // 검출된 클래스 (없으면 -1)
+    float smoothed;                    // 검출된 클래스의 평활화 점수
+    float scores[KEYWORD_MAX_CLASSES];
+} wake_word_hop_t;
+
+#if INFERENCE_PIPELINE
+// 두 코어 파이프라인 (앞 단계는 interpreter, 뒤 단계는 back_interpreter)
+alignas(tflite::MicroInterpreter) static uint8_t back_interpreter_buffer[sizeof(tflite::MicroInterpreter)]; // 뒤 단계 인터프리터 자리
+static tflite::MicroInterpreter* back_interpreter; // 뒤 단계 (pipeline_back 태스크, 파이프라인을 비운 뒤에는 추론 태스크도)
+static uint8_t* pipeline_models[2]; // 나눈 앞/뒤 모델 (pool_budget의 "pipe_model")
+static uint8_t* pipeline_arena; // 뒤 단계 텐서 아레나 (pool_budget의 "pipe_arena")
+static layer_pipeline_t pipeline; // 추론 태스크 → pipeline_back 태스크 경계 텐서 슬롯
+static model_split_plan_t split_plan; // 지금 모델을 자른 곳 (tflm_load)
+static TfLiteTensor* boundary_output; // 앞 단계 출력 (경계 텐서)
+static TfLiteTensor* boundary_input; // 뒤 단계 입력
+static bool pipeline_active; // 지금 모델을 두 단계로 실행하는지 (나눌 수 없는 모델이면 한 코어로)
+static volatile bool pipeline_bench_active; // PIPELINE_BENCH 중: 뒤 단계 태스크가 결과 처리 없이 지연만 기록
+static int64_t pipeline_bench_latency_us; // PIPELINE_BENCH 지연 합계 (앞 단계 시작 → 뒤 단계 끝, pipeline_back 태스크)
+static int64_t pipeline_bench_latency_max_us;
+static int64_t pipeline_bench_back_us; // PIPELINE_BENCH 뒤 단계 Invoke() 시간 합계
+static volatile uint32_t pipeline_bench_request; // command_task → 추론 태스크: PIPELINE_BENCH hop 수 (0이면 없음)
+static QueueHandle_t pipeline_results; // pipeline_back 태스크 → 추론 태스크: hop 결과 (wake_word_hop_t)
+#endif
+
+#if PCM_INJECT
+// PCM 주입 상태 (주입 중에는 command_task 대신 캡처 태스크가 UART를 읽음)
+static volatile bool inject_requested; // command_task → 캡처 태스크: 다음 블록부터 UART 오디오 사용
+static volatile bool inject_active; // 캡처 태스크가 UART에서 오디오를 받는 중 (추론 결과는 HOP 줄로 보냄)
+static volatile bool inject_reset; // 캡처 태스크 → 추론 태스크: 링 버퍼와 검출 상태를 처음으로
+static SemaphoreHandle_t inject_step; // 추론 태스크가 한 번 깨어날 때마다 (주입 중 블록 단위로 맞춤)
+static SemaphoreHandle_t inject_done; // 주입 종료 (command_task가 다시 UART 명령을 읽음)
+static uint32_t inject_blocks; // 주입 중 받은 블록 수
+static uint32_t inject_hops; // 주입 중 추론 횟수
+static int64_t inject_dsp_us; // 주입 중 캡처 블록 처리(capture_pipeline) 시간 합계
+static int64_t inject_invoke_us; // 주입 중 Invoke() 시간 합계
+#endif
+
+// 예산 테이블의 풀에서 버퍼를 받음 (부팅 시에만 호출, 실패하면 pool_budget 설정 오류)
+static void* pool_buffer(size_t size, uint32_t caps) {
+    void* buffer = audio_pool_alloc(size, caps);
+    if (buffer == nullptr) {
+        ESP_LOGE(TAG, "Audio pool has no %u byte block! Check pool_budget.", (unsigned)size);
+        audio_pool_report();
+    }
+    ESP_ERROR_CHECK(buffer != nullptr ? ESP_OK : ESP_ERR_NO_MEM);
+    return buffer;
+}
+
+// I2S DMA 큐가 가득 차서 받은 블록을 버림 (ISR)
+static IRAM_ATTR bool i2s_overrun(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx) {
+    deadline_monitor_overrun(&deadline);
+    return false;
+}
 
 // I2S 초기화
 void i2s_init(i2s_chan_handle_t *i2s_rx_channel) {
     i2s_chan_config_t chan_cfg = {
         .id = I2S_NUM,
         .role = I2S_ROLE_MASTER,
-        .dma_desc_num = 2,
-        .dma_frame_num = 512,
+        // DMA 버퍼 하나는 4092바이트 이하여야 함 (스테레오 + 32비트 슬롯이면 프레임이 8바이트라 나눠서)
+        // BLACKBOX: flash erase 중에는 캐시가 꺼져서 캡처 태스크가 멈출 수 있으므로 섹터 하나 지우는 시간만큼 더
+        .dma_desc_num = (MIC_STEREO && MIC_32BIT_SLOT ? 4 : 2) + (BLACKBOX ? 2 : 0),
+        .dma_frame_num = MIC_STEREO && MIC_32BIT_SLOT ? 256 : 512,  // 스테레오면 프레임 하나에 L/R 두 샘플
         .auto_clear = true,
     };
 
@@ -41,89 +371,1270 @@ void i2s_init(i2s_chan_handle_t *i2s_rx_channel) {
             .mclk_multiple = I2S_MCLK_MULTIPLE_256
         },
         .slot_cfg = {
-            .data_bit_width = I2S_DATA_BIT_WIDTH_16BIT,
-            .slot_bit_width = I2S_SLOT_BIT_WIDTH_16BIT,
-            .slot_mode = I2S_SLOT_MODE_MONO,
-            .slot_mask = I2S_STD_SLOT_LEFT
+            .data_bit_width = MIC_32BIT_SLOT ? I2S_DATA_BIT_WIDTH_32BIT : I2S_DATA_BIT_WIDTH_16BIT,
+            .slot_bit_width = MIC_32BIT_SLOT ? I2S_SLOT_BIT_WIDTH_32BIT : I2S_SLOT_BIT_WIDTH_16BIT,
+            .slot_mode = MIC_STEREO ? I2S_SLOT_MODE_STEREO : I2S_SLOT_MODE_MONO,
+            .slot_mask = MIC_STEREO ? I2S_STD_SLOT_BOTH : I2S_STD_SLOT_LEFT
         },
         .gpio_cfg = {
             .bclk = GPIO_NUM_14,  // BCLK 핀
             .ws = GPIO_NUM_15,    // WS 핀
             .dout = I2S_GPIO_UNUSED,
-            .din = GPIO_NUM_32    // INMP441 SD 핀
+            .din = GPIO_NUM_32    // INMP441 SD 핀 (스테레오면 두 마이크의 SD를 같이 연결)
         }
     };
 
     ESP_ERROR_CHECK(i2s_channel_init_std_mode(*i2s_rx_channel, &std_cfg));
+    i2s_event_callbacks_t callbacks = {};
+    callbacks.on_recv_q_ovf = i2s_overrun;  // 캡처 태스크가 늦어서 DMA 블록을 잃으면 deadline에 기록
+    ESP_ERROR_CHECK(i2s_channel_register_event_callback(*i2s_rx_channel, &callbacks, NULL));
     ESP_ERROR_CHECK(i2s_channel_enable(*i2s_rx_channel));
     ESP_LOGI(TAG, "I2S initialized successfully.");
 }
 
-// TensorFlow Lite Micro 초기화
-void tflm_init() {
-    const tflite::Model* model = tflite::GetModel(model_tflite);
+// 모델이 사용하는 연산자 등록
+// 모델을 다시 학습해서 새 연산자가 필요해지면 여기에 추가하고 OP_RESOLVER_SIZE를 늘려주세요.
+// (등록되지 않은 연산자를 쓰는 모델은 tflm_load()에서 거부됩니다.)
+static void register_ops() {
+    resolver.AddShape();
+    resolver.AddStridedSlice();
+    resolver.AddPack();
+    resolver.AddReshape();
+    resolver.AddConv2D();
+    resolver.AddMaxPool2D();
+    resolver.AddMean();
+    resolver.AddFullyConnected();
+    resolver.AddSoftmax();
+}
+
+// 모델에 필요한 연산자가 모두 등록되어 있는지 확인
+static bool model_ops_supported(const tflite::Model* model) {
+    const auto* opcodes = model->operator_codes();
+    if (opcodes == nullptr) {
+        return false;
+    }
+    for (const tflite::OperatorCode* opcode : *opcodes) {
+        tflite::BuiltinOperator code = tflite::GetBuiltinCode(opcode);
+        if (code == tflite::BuiltinOperator_CUSTOM || resolver.FindOp(code) == nullptr) {
+            ESP_LOGE(TAG, "Model requires unsupported operator: %s", tflite::EnumNameBuiltinOperator(code));
+            return false;
+        }
+    }
+    return true;
+}
+
+// 앱에 컴파일되어 들어있는 기본 모델 (모델 파티션이 비어있거나 손상됐을 때 사용)
+static void builtin_model(model_entry_t* entry) {
+    entry->model = model_tflite;
+    entry->model_size = model_tflite_len;
+    entry->num_classes = model_classes_len;
+    for (size_t c = 0; c < model_classes_len; c++) {
+        entry->classes[c] = model_classes[c];
+    }
+    entry->sequence = 0;
+    entry->slot = -1;
+}
+
+// TensorFlow Lite Micro 초기화 (모델 교체 시에도 다시 호출됨)
+// 모델 검증(구조, 스키마 버전, 연산자)이 끝나기 전에는 기존 인터프리터를 건드리지 않습니다.
+static bool tflm_load(const model_entry_t* entry) {
+    model_ready = false;
+    flatbuffers::Verifier verifier(entry->model, entry->model_size);
+    if (!tflite::VerifyModelBuffer(verifier)) {
+        ESP_LOGE(TAG, "Model flatbuffer is corrupted!");
+        return false;
+    }
+    const tflite::Model* model = tflite::GetModel(entry->model);
     if (model->version() != TFLITE_SCHEMA_VERSION) {
         ESP_LOGE(TAG, "Model schema version does not match!");
-        return;
+        return false;
+    }
+    if (!model_ops_supported(model)) {
+        return false;
     }
+    boot_profile_mark("model_verify");
 
-    // 필요한 연산자만 등록
-    static tflite::MicroMutableOpResolver<4> resolver;  // 최대 4개의 연산자 등록 가능
-    resolver.AddFullyConnected();
-    resolver.AddSoftmax();
-    resolver.AddConv2D();  // Conv2D 연산자 추가
-    resolver.AddReshape(); // Reshape 연산자 추가
-    
-    static tflite::MicroInterpreter static_interpreter(model, resolver, tensor_arena, TENSOR_ARENA_SIZE, nullptr);
-    interpreter = &static_interpreter;
+    // 기존 인터프리터를 정리하고 같은 자리(interpreter_buffer)와 같은 tensor_arena에 다시 생성
+#if INFERENCE_PIPELINE
+    layer_pipeline_drain(&pipeline);  // 뒤 단계가 이전 모델로 실행 중인 hop을 끝낼 때까지
+    xQueueReset(pipeline_results);    // 이전 모델의 클래스 번호로 된 결과는 버림
+    pipeline_active = false;
+    if (back_interpreter != nullptr) {
+        back_interpreter->~MicroInterpreter();
+        back_interpreter = nullptr;
+    }
+#endif
+    if (interpreter != nullptr) {
+        interpreter->~MicroInterpreter();
+        interpreter = nullptr;
+    }
+    if (planner != nullptr) {
+        planner->~CachedMemoryPlanner();
+        planner = nullptr;
+    }
+    active_model = *entry;
+
+    // 두 코어 파이프라인: 앞/뒤 모델을 DRAM에 만들어서 뒤 단계부터 준비. 나눌 수 없거나 뒤 단계가 아레나에 안 들어가면 한 코어로
+    bool split = false;
+#if INFERENCE_PIPELINE
+    if (entry->model_size <= PIPELINE_MODEL_MAX &&
+        model_split_plan(entry->model, entry->model_size, PIPELINE_BOUNDARY_MAX, -1, &split_plan) &&
+        model_split_apply(entry->model, entry->model_size, &split_plan, pipeline_models[0], pipeline_models[1])) {
+        back_interpreter = new (back_interpreter_buffer) tflite::MicroInterpreter(
+            tflite::GetModel(pipeline_models[1]), resolver, pipeline_arena, PIPELINE_ARENA_SIZE);
+        split = back_interpreter->AllocateTensors() == kTfLiteOk &&
+                back_interpreter->input(0)->bytes == split_plan.boundary_bytes;
+        if (split) {
+            model = tflite::GetModel(pipeline_models[0]);
+        } else {
+            ESP_LOGW(TAG, "Pipeline back stage does not fit PIPELINE_ARENA_SIZE, running on one core.");
+            back_interpreter->~MicroInterpreter();
+            back_interpreter = nullptr;
+        }
+    } else {
+        ESP_LOGW(TAG, "Model has no cut within PIPELINE_BOUNDARY_MAX (or exceeds PIPELINE_MODEL_MAX), running on one core.");
+    }
+#endif
+
+    // 가중치 배치: DRAM 복사본으로 실행 (검증은 flash 원본으로 끝났고, 이전 인터프리터는 이미 정리됨)
+    weights_in_dram = split;  // 나눈 모델도 DRAM
+    if (!split && weights_dram && weights_buffer != nullptr) {
+        if (entry->model_size <= MODEL_WEIGHTS_DRAM_MAX) {
+            memcpy(weights_buffer, entry->model, entry->model_size);
+            model = tflite::GetModel(weights_buffer);
+            weights_in_dram = true;
+        } else {
+            ESP_LOGW(TAG, "Model of %u bytes exceeds MODEL_WEIGHTS_DRAM_MAX, running from flash.", (unsigned)entry->model_size);
+        }
+    }
+    planner = new (planner_buffer) CachedMemoryPlanner();
+    tflite::MicroAllocator* allocator = tflite::MicroAllocator::Create(tensor_arena, TENSOR_ARENA_SIZE, planner);
+    if (allocator == nullptr) {
+        ESP_LOGE(TAG, "Failed to create arena allocator!");
+        return false;
+    }
+    interpreter = new (interpreter_buffer) tflite::MicroInterpreter(model, resolver, allocator);
 
-    // 모델 초기화
+    // 모델 초기화 (같은 모델이면 지난번 아레나 배치를 재사용)
     if (interpreter->AllocateTensors() != kTfLiteOk) {
         ESP_LOGE(TAG, "Failed to allocate tensors!");
-        return;
+        return false;
     }
+    boot_profile_mark(planner->cache_hit() ? "allocate_tensors (cached plan)" : "allocate_tensors");
 
     input_tensor = interpreter->input(0);
     output_tensor = interpreter->output(0);
-    ESP_LOGI(TAG, "TensorFlow Lite Micro initialized successfully.");
+#if INFERENCE_PIPELINE
+    if (split) {
+        boundary_output = interpreter->output(0);
+        boundary_input = back_interpreter->input(0);
+        output_tensor = back_interpreter->output(0);
+        if (boundary_output->bytes != boundary_input->bytes) {
+            ESP_LOGE(TAG, "Pipeline boundary tensor mismatch (%u vs %u bytes)!", (unsigned)boundary_output->bytes,
+                     (unsigned)boundary_input->bytes);
+            return false;
+        }
+    }
+#endif
+
+    // 입력 창 길이 확인 (링 버퍼에 들어가는 길이까지만 가능)
+    size_t window = 1;
+    for (int d = 0; d < input_tensor->dims->size; d++) {
+        window *= input_tensor->dims->data[d];
+    }
+    if (window > MODEL_WINDOW_MAX_SAMPLES) {
+        // 16kHz 모델을 MODEL_SAMPLE_RATE=8000 빌드에 올린 경우 등
+        ESP_LOGE(TAG, "Model input of %u samples exceeds %d (%d Hz build)!", (unsigned)window, MODEL_WINDOW_MAX_SAMPLES, MODEL_SAMPLE_RATE);
+        return false;
+    }
+    model_window = window;
+
+    // 출력 클래스 수와 라벨 테이블이 맞는지 확인
+    int num_classes = output_tensor->dims->data[output_tensor->dims->size - 1];
+    if (num_classes != (int)active_model.num_classes) {
+        ESP_LOGE(TAG, "Model has %d output classes, but label table has %u!", num_classes, (unsigned)active_model.num_classes);
+        return false;
+    }
+    if (!keyword_detector_init(&detector, active_model.classes, active_model.num_classes)) {
+        ESP_LOGE(TAG, "Invalid label table!");
+        return false;
+    }
+    ESP_LOGI(TAG, "TensorFlow Lite Micro initialized successfully. (model slot %d, %u bytes in %s, arena %u bytes%s)",
+             active_model.slot, (unsigned)active_model.model_size, weights_in_dram ? "DRAM" : "flash",
+             (unsigned)interpreter->arena_used_bytes(), planner->cache_hit() ? ", cached plan" : "");
+#if INFERENCE_PIPELINE
+    if (split) {
+        uint64_t total = split_plan.front_macs + split_plan.back_macs;
+        ESP_LOGI(TAG, "Two-core pipeline: ops 0-%d on core 0, %d-%u on core %d (back arena %u bytes), boundary %u bytes, estimated MACs %.1f%% / %.1f%%",
+                 (int)split_plan.split_op, (int)split_plan.split_op + 1, (unsigned)split_plan.op_count - 1,
+                 PIPELINE_BACK_CORE, (unsigned)back_interpreter->arena_used_bytes(), (unsigned)split_plan.boundary_bytes,
+                 100.0 * split_plan.front_macs / total, 100.0 * split_plan.back_macs / total);
+    }
+    pipeline_active = split;
+#endif
+    model_ready = true;
+    return true;
+}
+
+void tflm_init() {
+    register_ops();
+    tensor_arena = static_cast<uint8_t*>(pool_buffer(TENSOR_ARENA_SIZE, AUDIO_POOL_CAP_INTERNAL));
+#if MODEL_WEIGHTS_DRAM
+    weights_buffer = static_cast<uint8_t*>(pool_buffer(MODEL_WEIGHTS_DRAM_MAX, AUDIO_POOL_CAP_INTERNAL));
+#endif
+#if INFERENCE_PIPELINE
+    for (uint8_t*& buffer : pipeline_models) {
+        buffer = static_cast<uint8_t*>(pool_buffer(PIPELINE_MODEL_MAX, AUDIO_POOL_CAP_INTERNAL));
+    }
+    pipeline_arena = static_cast<uint8_t*>(pool_buffer(PIPELINE_ARENA_SIZE, AUDIO_POOL_CAP_INTERNAL));
+    uint8_t* slots = static_cast<uint8_t*>(pool_buffer(LAYER_PIPELINE_SLOTS * PIPELINE_BOUNDARY_MAX, AUDIO_POOL_CAP_INTERNAL));
+    ESP_ERROR_CHECK(layer_pipeline_init(&pipeline, slots, PIPELINE_BOUNDARY_MAX) ? ESP_OK : ESP_ERR_NO_MEM);
+    pipeline_results = xQueueCreate(2 * LAYER_PIPELINE_SLOTS, sizeof(wake_word_hop_t));
+#endif
+    model_queue = xQueueCreate(1, sizeof(model_entry_t));
+    model_slot_lock = xSemaphoreCreateMutex();
+
+    // 모델 파티션의 최신 모델을 먼저 사용하고, 없거나 검증에 실패하면 기본 모델로 돌아감
+    model_entry_t entry;
+    if (model_store_init() == ESP_OK && model_store_load(&entry) == ESP_OK && tflm_load(&entry)) {
+        return;
+    }
+    ESP_LOGW(TAG, "Using built-in model.");
+    builtin_model(&entry);
+    if (!tflm_load(&entry)) {
+        ESP_LOGE(TAG, "Built-in model failed to load! Upload a model with scripts/model_pack.py send.");
+    }
+}
+
+// 추론 루프에서 호출: UART로 새 모델이 들어왔으면 인터프리터를 다시 초기화 (재부팅 없음)
+// 꺼내서 교체(실패하면 복구)가 끝날 때까지 model_slot_lock: 그동안 receive_model이 active_model.slot을 읽지 않음
+static void apply_pending_model() {
+    if (uxQueueMessagesWaiting(model_queue) == 0) {
+        return;
+    }
+    xSemaphoreTake(model_slot_lock, portMAX_DELAY);
+    model_entry_t entry;
+    if (xQueueReceive(model_queue, &entry, 0) != pdTRUE) {
+        xSemaphoreGive(model_slot_lock);
+        return;
+    }
+
+    model_entry_t previous = active_model;
+    if (tflm_load(&entry)) {
+        xSemaphoreGive(model_slot_lock);
+        char reply[48];
+        int len = snprintf(reply, sizeof(reply), "MODEL_OK %lu\n", (unsigned long)entry.sequence);
+        uart_link_send((const uint8_t*)reply, len);
+        return;
+    }
+
+    // 새 모델을 쓸 수 없으면 이전 모델로 복구
+    uart_link_send((const uint8_t*)"MODEL_ERROR load\n", strlen("MODEL_ERROR load\n"));
+    if (!tflm_load(&previous)) {
+        ESP_LOGE(TAG, "Failed to restore previous model!");
+    }
+    xSemaphoreGive(model_slot_lock);
+}
+
+// MODEL_UPDATE <크기> 명령 처리: 패키지를 받아서 사용하지 않는 슬롯에 기록
+// 호스트(scripts/model_pack.py)는 MODEL_READY를 받은 뒤 MODEL_CHUNK_SIZE씩 보내고, 매번 MODEL_ACK를 기다립니다.
+// 앞서 받은 모델이 아직 큐에 있으면 거부 (MODEL_ERROR busy): 그 모델로 바뀌는 중에 "사용하지 않는" 슬롯을 잘못 골라서
+// 인터프리터가 실행 중인 슬롯을 지우지 않도록. 큐가 비어 있으면 슬롯을 고른 뒤에는 active_model.slot이 이 슬롯이 될 수 없음
+// PLACEMENT_BENCH가 기다리거나 도는 중에도 거부 (모델 쓰기가 flash 부하 측정에 섞이지 않도록)
+static void receive_model(uint8_t* chunk, size_t package_size) {
+    xSemaphoreTake(model_slot_lock, portMAX_DELAY);
+    if (uxQueueMessagesWaiting(model_queue) > 0 || bench_request > 0) {
+        xSemaphoreGive(model_slot_lock);
+        uart_link_send((const uint8_t*)"MODEL_ERROR busy\n", strlen("MODEL_ERROR busy\n"));
+        return;
+    }
+    esp_err_t begin = model_store_begin(package_size, active_model.slot);
+    xSemaphoreGive(model_slot_lock);
+    if (begin != ESP_OK) {
+        uart_link_send((const uint8_t*)"MODEL_ERROR begin\n", strlen("MODEL_ERROR begin\n"));
+        return;
+    }
+    uart_link_send((const uint8_t*)"MODEL_READY\n", strlen("MODEL_READY\n"));
+
+    size_t remaining = package_size;
+    while (remaining > 0) {
+        size_t chunk_size = remaining > MODEL_CHUNK_SIZE ? MODEL_CHUNK_SIZE : remaining;
+        if (!uart_link_read_exact(chunk, chunk_size, pdMS_TO_TICKS(MODEL_RX_TIMEOUT_MS)) ||
+            model_store_write(chunk, chunk_size) != ESP_OK) {
+            model_entry_t unused;
+            model_store_finish(&unused);  // 슬롯 매핑 복구 (헤더를 안 썼으므로 슬롯은 무효 상태로 남음)
+            uart_link_send((const uint8_t*)"MODEL_ERROR receive\n", strlen("MODEL_ERROR receive\n"));
+            return;
+        }
+        remaining -= chunk_size;
+        uart_link_send((const uint8_t*)"MODEL_ACK\n", strlen("MODEL_ACK\n"));
+    }
+
+    model_entry_t entry;
+    if (model_store_finish(&entry) != ESP_OK) {
+        uart_link_send((const uint8_t*)"MODEL_ERROR verify\n", strlen("MODEL_ERROR verify\n"));
+        return;
+    }
+    // 실제 교체는 추론 루프(apply_pending_model)에서 추론 사이에 진행
+    xQueueOverwrite(model_queue, &entry);
+}
+
+// 캡처 파이프라인 초기화 (소리 이벤트 모델이 있으면 STFT hop마다 mel 특징을 특징 스트림으로)
+static void capture_init(capture_pipeline_t* pipeline) {
+    capture_pipeline_init(pipeline);
+    if (sound_events_active()) {
+        pipeline->hop_hook = sound_events_push;
+    }
+}
+
+// 소리 이벤트 검출 (추론 태스크)
+static void sound_event_detected(const char* model, const char* label, float score) {
+#if PCM_INJECT
+    if (inject_active) {
+        return;
+    }
+#endif
+#if BLACKBOX
+    blackbox_trigger(-1, label, score);
+#endif
+#if TRANSPORT != TRANSPORT_UART
+    char event[AUDIO_TRANSPORT_EVENT_TEXT];
+    snprintf(event, sizeof(event), "SOUND_EVENT %s %s %.2f", model, label, score);
+    audio_transport_event(&transport, audio_ring_position(&audio_ring), event);
+#endif
+    if (!capture_active) {  // 스트리밍 중에는 오디오 프레임 사이에 로그가 끼지 않도록
+        ESP_LOGI(TAG, "Sound event: %s %s (%.2f)", model, label, score);
+    }
+}
+
+#if PCM_INJECT
+// INJECT_START 명령 처리 (command_task): 캡처 태스크에 UART를 넘기고 주입이 끝날 때까지 대기
+// 프로토콜 (scripts/pcm_inject.py):
+//   호스트 → INJECT_START\n
+//   장치   → INJECT_READY block=.. rate=.. model_rate=.. hop=.. first=.. window=..\n
+//   호스트 → [샘플 수 uint16 LE][int16 LE 샘플] 블록 (I2S_SAMPLE_RATE 모노), INJECT_ACK 없이 최대 INJECT_WINDOW_BLOCKS개
+//   장치   → 추론할 때마다 HOP <위치> <검출 클래스> <입력 창 CRC32> <Invoke us> <클래스별 확률...>\n, 블록마다 INJECT_ACK\n
+//   호스트 → 샘플 수 0 (끝)
+//   장치   → INJECT_END blocks=.. hops=.. dsp_us=.. invoke_us=..\n
+static void inject_start() {
+    if (capture_active) {
+        uart_link_send_str("INJECT_ERROR busy\n");  // 명령어 스트리밍과 섞이지 않도록
+        return;
+    }
+    inject_requested = true;
+    xSemaphoreTake(inject_done, portMAX_DELAY);
+}
+
+// 추론 태스크가 링 버퍼 position까지 처리할 때까지 대기 (주입 중 캡처 태스크)
+static bool inject_wait_position(uint32_t position) {
+    while (processed_position != position) {
+        if (xSemaphoreTake(inject_step, pdMS_TO_TICKS(INJECT_RX_TIMEOUT_MS)) != pdTRUE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 주입 시작: 캡처/추론 상태를 처음으로 되돌려서 같은 입력이면 항상 같은 결과가 나오도록
+static void inject_begin(capture_pipeline_t* pipeline) {
+    inject_requested = false;
+    capture_init(pipeline);
+    inject_blocks = 0;
+    inject_hops = 0;
+    inject_dsp_us = 0;
+    inject_invoke_us = 0;
+    inject_active = true;
+    inject_reset = true;
+    xTaskNotifyGive(inference_task);
+    while (inject_reset) {
+        xSemaphoreTake(inject_step, pdMS_TO_TICKS(100));
+    }
+
+    char reply[128];
+    snprintf(reply, sizeof(reply), "INJECT_READY block=%d rate=%d model_rate=%d hop=%d first=%u window=%u\n",
+             CAPTURE_BLOCK_SAMPLES, I2S_SAMPLE_RATE, MODEL_SAMPLE_RATE, INFERENCE_HOP_SAMPLES,
+             (unsigned)(FIRST_INFERENCE_SAMPLES), (unsigned)model_window);
+    uart_link_send_str(reply);
+}
+
+// 주입 종료: 통계를 보내고 UART를 command_task에 돌려줌
+static void inject_end(const char* error) {
+    if (error != nullptr) {
+        uart_link_send_str(error);
+    }
+    char reply[128];
+    snprintf(reply, sizeof(reply), "INJECT_END blocks=%lu hops=%lu dsp_us=%lld invoke_us=%lld\n",
+             (unsigned long)inject_blocks, (unsigned long)inject_hops, (long long)inject_dsp_us, (long long)inject_invoke_us);
+    uart_link_send_str(reply);
+    inject_active = false;
+    xSemaphoreGive(inject_done);
+}
+
+// 주입 중이면 UART에서 블록 하나를 읽음 (캡처 태스크)
+// 반환: 샘플 수. 주입 중이 아니거나 방금 끝났으면 0 (마이크에서 읽음)
+static size_t inject_read(capture_pipeline_t* pipeline, int16_t* block) {
+    if (inject_requested) {
+        inject_begin(pipeline);
+    }
+    if (!inject_active) {
+        return 0;
+    }
+    uint8_t header[2];
+    if (!uart_link_read_exact(header, sizeof(header), pdMS_TO_TICKS(INJECT_RX_TIMEOUT_MS))) {
+        inject_end("INJECT_ERROR timeout\n");
+        return 0;
+    }
+    size_t count = header[0] | (header[1] << 8);
+    if (count == 0) {
+        inject_end(nullptr);
+        return 0;
+    }
+    // 잡음 제거 hop 단위가 아니면 마이크 입력과 처리가 달라짐
+    if (count > CAPTURE_BLOCK_SAMPLES || count % (FRONTEND_HOP * MODEL_DECIMATION) != 0) {
+        inject_end("INJECT_ERROR size\n");
+        return 0;
+    }
+    if (!uart_link_read_exact(reinterpret_cast<uint8_t*>(block), count * sizeof(int16_t), pdMS_TO_TICKS(INJECT_RX_TIMEOUT_MS))) {
+        inject_end("INJECT_ERROR timeout\n");
+        return 0;
+    }
+    return count;
+}
+
+// 주입 블록 처리 후 (캡처 태스크): 추론 태스크가 이 블록까지 처리하면 ACK (실시간보다 빨라도 hop을 건너뛰지 않음)
+static void inject_block_done(int64_t dsp_us) {
+    inject_blocks++;
+    inject_dsp_us += dsp_us;
+    if (!inject_wait_position(audio_ring_position(&audio_ring))) {
+        inject_end("INJECT_ERROR inference\n");
+        return;
+    }
+    uart_link_send_str("INJECT_ACK\n");
+}
+
+// 추론 결과 한 줄 (주입 중 추론 태스크)
+static void inject_report_hop(uint32_t position, int detected, const float* scores, size_t num_classes) {
+    char line[32 + 12 * KEYWORD_MAX_CLASSES];
+    int len = snprintf(line, sizeof(line), "HOP %lu %d %08lx %lld", (unsigned long)position, detected,
+                       (unsigned long)input_crc, (long long)last_invoke_us);
+    for (size_t c = 0; c < num_classes; c++) {
+        len += snprintf(line + len, sizeof(line) - len, " %.5f", scores[c]);
+    }
+    snprintf(line + len, sizeof(line) - len, "\n");
+    uart_link_send_str(line);
+    inject_hops++;
+    inject_invoke_us += last_invoke_us;
+}
+#else
+static size_t inject_read(capture_pipeline_t*, int16_t*) { return 0; }
+static void inject_block_done(int64_t) {}
+#endif
+
+#if COMPRESSOR_MONITOR
+// 컴프레서 상태 요약을 UART로 (캡처 태스크). 스트리밍/주입 중이면 보내지 않고 false (다음 블록에 다시)
+static bool health_send(const compressor_summary_t* summary) {
+#if PCM_INJECT
+    if (inject_active) {
+        return false;
+    }
+#endif
+    if (capture_active) {
+        return false;
+    }
+    char line[256];
+    compressor_monitor_format(summary, line, sizeof(line));
+    uart_link_send_str(line);
+    return true;
+}
+#endif
+
+// LINK_RATE <속도> <바이트> 명령 처리 (command_task): 새 속도로 시험 데이터를 보내서 PC가 CRC를 확인하면 유지
+// (scripts/link_rate.py, src/link_rate.h). 명령어 스트리밍 중에는 거부합니다.
+static void link_rate_command(uint8_t* chunk, unsigned long baud, unsigned long bytes) {
+    if (capture_active) {
+        uart_link_send_str("LINK_RATE_ERROR busy\n");
+        return;
+    }
+    link_rate_io_t io;
+    uart_link_rate_io(&io);
+    uint32_t previous = uart_link_baud();
+    esp_log_level_t level = esp_log_level_get("*");
+    esp_log_level_set("*", ESP_LOG_NONE);  // 다른 태스크의 로그가 시험 데이터 사이에 끼지 않도록
+    uint32_t rate = link_rate_serve(&io, previous, baud, bytes, chunk, MODEL_CHUNK_SIZE);
+    esp_log_level_set("*", level);
+    if (rate != previous) {
+        ESP_LOGI(TAG, "UART link switched to %lu baud.", (unsigned long)rate);
+    }
+}
+
+// UART 명령 처리 태스크
+static void command_task(void* arg) {
+    static_assert(MODEL_CHUNK_SIZE <= AUDIO_BLOCK_BYTES, "model chunk must fit a pool block");
+    uint8_t* chunk = static_cast<uint8_t*>(pool_buffer(MODEL_CHUNK_SIZE, AUDIO_POOL_CAP_INTERNAL));
+    char line[64];
+    while (1) {
+        if (uart_link_read_line(line, sizeof(line), portMAX_DELAY) <= 0) {
+            continue;
+        }
+        unsigned long package_size;
+        unsigned long baud;
+        unsigned long test_bytes;
+        if (sscanf(line, "MODEL_UPDATE %lu", &package_size) == 1) {
+            ESP_LOGI(TAG, "Command received: MODEL_UPDATE (%lu bytes)", package_size);
+            receive_model(chunk, package_size);
+        } else if (sscanf(line, "LINK_RATE %lu %lu", &baud, &test_bytes) == 2) {
+            link_rate_command(chunk, baud, test_bytes);
+        } else if (strcmp(line, "POOL_REPORT") == 0) {
+            audio_pool_report();  // 풀별 최대 사용량 (예산 조정용)
+        } else if (strcmp(line, "SCHED_REPORT") == 0) {
+            model_scheduler_report(&scheduler);  // 지난 보고 이후 모델별 CPU 점유율, 미룬 횟수
+        } else if (strcmp(line, "DEADLINE_REPORT") == 0) {
+            deadline_monitor_report(&deadline, esp_timer_get_time());  // 단계별 마감 초과/지터, 잃은 오디오, 과부하 단계
+        } else if (strcmp(line, "BLACKBOX_DUMP") == 0) {
+            blackbox_dump(chunk, MODEL_CHUNK_SIZE);  // 블랙박스 기록 전부 (scripts/blackbox_dump.py)
+        } else if (strcmp(line, "TRANSPORT_REPORT") == 0) {
+            audio_transport_report(&transport);  // 보낸 패킷, 백프레셔, 버린 샘플
+        } else if (strncmp(line, "PLACEMENT_BENCH", strlen("PLACEMENT_BENCH")) == 0) {
+            unsigned long runs = PLACEMENT_BENCH_RUNS;
+            sscanf(line, "PLACEMENT_BENCH %lu", &runs);
+            bench_request = runs > 0 ? runs : 1;  // 추론 태스크가 다음 블록에서 실행
+#if INFERENCE_PIPELINE
+        } else if (strncmp(line, "PIPELINE_BENCH", strlen("PIPELINE_BENCH")) == 0) {
+            unsigned long runs = PIPELINE_BENCH_RUNS;
+            sscanf(line, "PIPELINE_BENCH %lu", &runs);
+            pipeline_bench_request = runs > 0 ? runs : 1;
+#endif
+#if PCM_INJECT
+        } else if (strcmp(line, "INJECT_START") == 0) {
+            ESP_LOGI(TAG, "Command received: INJECT_START");
+            inject_start();  // 끝날 때까지 UART는 캡처 태스크가 읽음
+#endif
+        } else {
+            ESP_LOGW(TAG, "Unknown command: %s", line);
+        }
+    }
+}
+
+// 출력 텐서를 클래스별 확률(float)로 읽기. int8로 양자화된 모델도 역양자화해서 같은 경로로 처리합니다.
+static size_t read_scores(float *scores) {
+    size_t num_classes = active_model.num_classes;
+    if (output_tensor->type == kTfLiteInt8) {
+        const float scale = output_tensor->params.scale;
+        const int zero_point = output_tensor->params.zero_point;
+        for (size_t c = 0; c < num_classes; c++) {
+            scores[c] = (output_tensor->data.int8[c] - zero_point) * scale;
+        }
+    } else {
+        for (size_t c = 0; c < num_classes; c++) {
+            scores[c] = output_tensor->data.f[c];
+        }
+    }
+    return num_classes;
+}
+
+// 링 버퍼의 최근 model_window 샘플을 입력 텐서로 복사 (float 정규화 또는 int8 양자화)
+static bool fill_input(uint32_t end_position) {
+    int16_t* chunk = input_chunk;
+    uint32_t position = end_position - model_window;
+
+    // 부팅 직후(FAST_BOOT)에는 창만큼 오디오가 없으므로 앞부분을 무음으로 채움
+    // (한 번 채워진 뒤에는 position이 32비트를 넘어 0으로 돌아가도 채우지 않음)
+    window_filled = window_filled || end_position >= MODEL_WINDOW_MAX_SAMPLES;
+    size_t padding = !window_filled && end_position < model_window ? model_window - end_position : 0;
+    for (size_t i = 0; i < padding; i++) {
+        if (input_tensor->type == kTfLiteInt8) {
+            input_tensor->data.int8[i] = static_cast<int8_t>(input_tensor->params.zero_point);
+        } else {
+            input_tensor->data.f[i] = 0.0f;
+        }
+    }
+
+    // PCM 주입 중에는 입력 창(무음 포함 int16)의 CRC를 같이 계산 (호스트 시뮬레이터와 비트 단위 비교)
+#if PCM_INJECT
+    const bool crc = inject_active;
+#else
+    const bool crc = false;
+#endif
+    input_crc = 0;
+    if (crc) {
+        memset(chunk, 0, INPUT_CHUNK_SAMPLES * sizeof(int16_t));
+        for (size_t i = 0; i < padding; i += INPUT_CHUNK_SAMPLES) {
+            size_t count = padding - i < INPUT_CHUNK_SAMPLES ? padding - i : INPUT_CHUNK_SAMPLES;
+            input_crc = esp_rom_crc32_le(input_crc, reinterpret_cast<const uint8_t*>(chunk), count * sizeof(int16_t));
+        }
+    }
+
+    for (size_t i = padding; i < model_window; i += INPUT_CHUNK_SAMPLES) {
+        size_t count = model_window - i;
+        if (count > INPUT_CHUNK_SAMPLES) {
+            count = INPUT_CHUNK_SAMPLES;
+        }
+        if (audio_ring_read(&audio_ring, position + i, chunk, count) != count) {
+            return false;
+        }
+        if (crc) {
+            input_crc = esp_rom_crc32_le(input_crc, reinterpret_cast<const uint8_t*>(chunk), count * sizeof(int16_t));
+        }
+        if (input_tensor->type == kTfLiteInt8) {
+            const float scale = input_tensor->params.scale;
+            const int zero_point = input_tensor->params.zero_point;
+            for (size_t j = 0; j < count; j++) {
+                int q = static_cast<int>(lroundf(chunk[j] / 32768.0f / scale)) + zero_point;
+                input_tensor->data.int8[i + j] = static_cast<int8_t>(q < -128 ? -128 : (q > 127 ? 127 : q));
+            }
+        } else {
+            for (size_t j = 0; j < count; j++) {
+                input_tensor->data.f[i + j] = static_cast<float>(chunk[j]) / 32768.0f;  // 정규화
+            }
+        }
+    }
+    return true;
 }
 
-// I2S 데이터 처리 및 모델 실행
-void process_audio(i2s_chan_handle_t i2s_rx_channel) {
-    uint8_t audio_buffer[512];
+// 호출어 검출 직후: 검출 시점 이전 PREROLL_MS 분량부터 스트리밍 시작 (캡처 태스크가 다음 블록에서 링 버퍼에서 바로 보냄)
+static void start_command_capture() {
+    uint32_t start = audio_ring_position(&audio_ring) - PREROLL_SAMPLES;
+    if (audio_transport_start(&transport, start, CAPTURE_START_TAG)) {
+        capture_active = true;
+    }
+}
+
+// I2S에서 int16 샘플 읽기 (32비트 슬롯이면 블록 부동소수점으로 변환). 반환값: 읽은 샘플 수
+static size_t read_samples(i2s_chan_handle_t i2s_rx_channel, int16_t *samples, size_t count) {
     size_t bytes_read;
+#if MIC_32BIT_SLOT
+    static const size_t raw_samples = CAPTURE_BLOCK_SAMPLES * (MIC_STEREO ? 2 : 1);
+    static int32_t* raw = static_cast<int32_t*>(pool_buffer(raw_samples * sizeof(int32_t), AUDIO_POOL_CAP_DMA));
+    if (count > raw_samples) {
+        count = raw_samples;
+    }
+    ESP_ERROR_CHECK(i2s_channel_read(i2s_rx_channel, raw, count * sizeof(int32_t), &bytes_read, portMAX_DELAY));
+    count = bytes_read / sizeof(int32_t);
+    pcm_convert_s32_block(raw, samples, count, MIC_32BIT_MIN_SHIFT);  // 스테레오면 두 채널에 같은 시프트
+    return count;
+#else
+    ESP_ERROR_CHECK(i2s_channel_read(i2s_rx_channel, samples, count * sizeof(int16_t), &bytes_read, portMAX_DELAY));
+    return bytes_read / sizeof(int16_t);
+#endif
+}
+
+// I2S 캡처 태스크: DMA 버퍼를 계속 읽어서 링 버퍼에 쓰고, 명령어 캡처 중이면 audio_transport로 스트리밍
+static void capture_task(void* arg) {
+    i2s_chan_handle_t i2s_rx_channel = static_cast<i2s_chan_handle_t>(arg);
+    int16_t* block = static_cast<int16_t*>(pool_buffer(AUDIO_BLOCK_BYTES, AUDIO_POOL_CAP_DMA));
+#if MIC_STEREO
+    int16_t* interleaved = static_cast<int16_t*>(pool_buffer(2 * AUDIO_BLOCK_BYTES, AUDIO_POOL_CAP_DMA));  // I2S 스테레오 (L, R, L, R, ...)
+    int16_t* right = static_cast<int16_t*>(pool_buffer(AUDIO_BLOCK_BYTES, AUDIO_POOL_CAP_INTERNAL));
+    static beamformer_t beamformer;
+    beamformer_init(&beamformer, SAMPLE_RATE, BEAM_MIC_SPACING_MM, BEAM_STEER_DEG);
+    energy_vad_t doa_vad;  // 빔포밍 전 왼쪽 채널 기준
+    energy_vad_init(&doa_vad);
+#endif
+    static capture_pipeline_t pipeline;  // 태스크 스택에 두기에는 큼
+    capture_init(&pipeline);
+#if COMPRESSOR_MONITOR
+    static compressor_monitor_t monitor;  // 약 7KB, 부팅 후 계속 같은 메모리
+    compressor_monitor_init(&monitor);
+    bool health_pending = false;  // 스트리밍/주입 중에 나온 요약은 끝난 뒤에 보냄
+#endif
+    size_t silence_samples = 0;
+    size_t captured_samples = 0;
+    bool capture_ending = false;  // 끝낼 위치를 정함 (끝 태그를 보낼 때까지 capture_active 유지)
+    bool first_block = true;
 
-    ESP_LOGI(TAG, "Processing audio...");
     while (1) {
-        // I2S 데이터 읽기
-        ESP_ERROR_CHECK(i2s_channel_read(i2s_rx_channel, audio_buffer, sizeof(audio_buffer), &bytes_read, portMAX_DELAY));
+        // PCM 주입 중이면 UART에서, 아니면 I2S에서 블록 읽기
+        size_t count = inject_read(&pipeline, block);
+        bool injected = count > 0;
+        if (!injected) {
+#if MIC_STEREO
+            // 채널별로 나눈 뒤 조향 방향으로 빔포밍해서 모노 블록으로 (왼쪽 채널은 block에 받아서 그 자리에 출력)
+            count = read_samples(i2s_rx_channel, interleaved, CAPTURE_BLOCK_SAMPLES * 2) / 2;
+            beamformer_deinterleave(interleaved, block, right, count);
+            if (BEAM_DOA && energy_vad_process(&doa_vad, block, count)) {  // 방향 추정은 음성 블록에서만
+                speech_direction = beamformer_estimate_doa(&beamformer, block, right, count);
+            }
+            beamformer_process(&beamformer, block, right, block, count);
+#else
+            count = read_samples(i2s_rx_channel, block, CAPTURE_BLOCK_SAMPLES);
+#endif
+        }
+        if (first_block) {
+            boot_profile_mark("first_audio");
+            first_block = false;
+        }
+        if (!injected) {
+            deadline_monitor_begin(&deadline, deadline_capture, esp_timer_get_time());  // 블록을 받은 시각부터
+        }
 
-        // 입력 텐서에 데이터 복사
-        for (size_t i = 0; i < bytes_read / 2; i++) {
-            input_tensor->data.f[i] = static_cast<float>(reinterpret_cast<int16_t*>(audio_buffer)[i]) / 32768.0f;  // 정규화
+#if COMPRESSOR_MONITOR
+        // 전처리(AGC, 잡음 제거) 전 마이크 오디오로 (주입된 오디오는 제외)
+        if (!injected) {
+            int64_t health_start = esp_timer_get_time();
+            health_pending |= compressor_monitor_process(&monitor, block, count);
+            model_scheduler_account(&scheduler, sched_health, (uint32_t)(esp_timer_get_time() - health_start));
+        }
+        if (health_pending) {
+            health_pending = !health_send(&monitor.summary);
         }
+#endif
 
-        // 모델 실행
-        if (interpreter->Invoke() != kTfLiteOk) {
-            ESP_LOGE(TAG, "Failed to invoke TFLite model!");
-            continue;
+        // (데시메이션) → 전처리 → 잡음 제거 후 링 버퍼에 저장 (모델 입력과 UART 스트리밍 모두 같은 오디오)
+        int64_t dsp_start = esp_timer_get_time();
+        bool speech;
+        count = capture_pipeline_process(&pipeline, block, count, &speech);
+        audio_ring_write(&audio_ring, block, count);
+#if BLACKBOX
+        if (!injected) {
+            blackbox_capture(block, count);  // RAM 링에 ADPCM으로만 (flash는 쓰기 태스크가)
         }
+#endif
+        int64_t dsp_us = esp_timer_get_time() - dsp_start;
+        model_scheduler_account(&scheduler, sched_frontend, (uint32_t)dsp_us);
 
-        // 출력 결과 확인
-        float result = output_tensor->data.f[0];  // 예측 결과
-        ESP_LOGI(TAG, "Inference result: %f", result);
+        if (capture_active && !capture_ending) {
+            // 말이 끝났는지 확인: 마지막 음성 이후 END_OF_SPEECH_MS 동안 조용하면 이 블록까지 보내고 종료
+            captured_samples += count;
+            silence_samples = speech ? 0 : silence_samples + count;
+            if (silence_samples >= END_OF_SPEECH_SAMPLES || captured_samples >= CAPTURE_MAX_SAMPLES) {
+                audio_transport_stop(&transport, audio_ring_position(&audio_ring), CAPTURE_END_TAG);
+                capture_ending = true;
+                silence_samples = 0;
+                captured_samples = 0;
+            }
+        }
+        // 밀린 오디오와 이벤트를 링 버퍼에서 바로 보냄 (백엔드가 막히면 다음 블록에 이어서, 오래 막히면 버림)
+        audio_transport_poll(&transport, (uint32_t)esp_timer_get_time(), false);
+        if (capture_ending && !audio_transport_streaming(&transport)) {
+            capture_active = false;
+            capture_ending = false;
+        }
+
+        if (!injected) {
+            deadline_monitor_end(&deadline, deadline_capture, esp_timer_get_time());
+        }
+
+        // 추론 태스크 깨우기
+        xTaskNotifyGive(inference_task);
+        if (injected) {
+            inject_block_done(dsp_us);
+        }
+    }
+}
+
+// 실시간으로 도는 중인지 (PCM 주입은 호스트에 맞춰 도므로 마감을 재지 않고 hop도 그대로)
+static bool realtime() {
+#if PCM_INJECT
+    return !inject_active;
+#else
+    return true;
+#endif
+}
 
-        vTaskDelay(pdMS_TO_TICKS(100));  // 100ms 대기
+// 추론 결과 읽기 (output_tensor): 점수, 검출기 갱신. position: 추론한 입력 창의 끝
+// 한 코어면 추론 태스크, INFERENCE_PIPELINE이면 뒤 단계를 실행한 pipeline_back 태스크에서 hop 순서대로 불림
+// PCM 주입 중에는 결과를 바로 보내고 false (명령어 캡처, 로그 없음)
+static bool wake_word_score(uint32_t position, wake_word_hop_t* hop) {
+    // 출력 결과 확인 (한 번의 추론으로 모든 클래스를 판별)
+    float smoothed[KEYWORD_MAX_CLASSES];
+    hop->position = position;
+    hop->num_classes = read_scores(hop->scores);
+    hop->detected = keyword_detector_update(&detector, hop->scores, hop->num_classes, smoothed);
+    hop->smoothed = hop->detected >= 0 ? smoothed[hop->detected] : 0.0f;
+#if PCM_INJECT
+    if (inject_active) {
+        inject_report_hop(position, hop->detected, hop->scores, hop->num_classes);
+        return false;
+    }
+#endif
+    return true;
+}
+
+// 추론 결과 처리 (추론 태스크만): 블랙박스, 검출 이벤트, 명령어 캡처 시작
+// 전송 이벤트 큐와 블랙박스 트리거는 쓰는 태스크가 하나여야 해서 INFERENCE_PIPELINE이어도 여기서 (pipeline_results)
+static void wake_word_result(const wake_word_hop_t* hop) {
+    int detected = hop->detected;
+#if BLACKBOX
+    blackbox_score(hop->scores, hop->num_classes, detected);
+    if (detected >= 0) {
+        blackbox_trigger(detected, active_model.classes[detected].label, hop->smoothed);
+    }
+#endif
+#if TRANSPORT != TRANSPORT_UART
+    if (detected >= 0) {  // UART에서는 로그 줄이 같은 역할
+        char event[AUDIO_TRANSPORT_EVENT_TEXT];
+        snprintf(event, sizeof(event), "DETECTED %s %.2f", active_model.classes[detected].label, hop->smoothed);
+        audio_transport_event(&transport, hop->position, event);
+    }
+#endif
+    if (detected == WAKE_WORD_CLASS && !capture_active) {
+#if MIC_STEREO && BEAM_DOA
+        ESP_LOGI(TAG, "Wake word from %.0f deg", speech_direction);  // CAPTURE_START 태그 전이라 스트림과 섞이지 않음
+#endif
+        // 스트리밍 중에는 콘솔 로그가 오디오 프레임 사이에 끼지 않도록 로그를 남기지 않음
+        start_command_capture();
+    } else if (detected >= 0) {
+        ESP_LOGI(TAG, "Detected: %s (%.2f)", active_model.classes[detected].label, hop->smoothed);
+    }
+}
+
+// 새 오디오가 들어올 때마다 (추론 태스크): hop만큼 쌓였으면 최근 오디오 창으로 추론. 반환: 이번에 본 링 버퍼 위치
+// INFERENCE_PIPELINE이면 앞 단계만 실행하고 경계 텐서를 뒤 단계 태스크로 넘김 (wake_word 마감 단계도 앞 단계까지)
+static uint32_t inference_step() {
+#if PCM_INJECT
+    if (inject_reset) {
+        // PCM 주입 시작 (캡처 태스크는 대기 중): 부팅 직후와 같은 상태로
+#if INFERENCE_PIPELINE
+        layer_pipeline_drain(&pipeline);  // 뒤 단계가 검출 상태를 쓰는 중일 수 있음
+#endif
+        audio_ring_reset(&audio_ring);
+        last_position = 0;
+        window_filled = false;
+        keyword_detector_init(&detector, active_model.classes, active_model.num_classes);
+        inject_reset = false;
+    }
+#endif
+    uint32_t position = audio_ring_position(&audio_ring);
+    if (!model_ready) {
+        last_position = position;  // 모델이 없으면 UART로 새 모델이 올 때까지 오디오만 계속 받음
+        return position;
+    }
+    bool timed = realtime();
+    uint32_t hop = timed ? inference_hop : INFERENCE_HOP_SAMPLES;
+    if (position - last_position < hop || position < FIRST_INFERENCE_SAMPLES) {
+        return position;
+    }
+    if (timed && position - last_position >= 2 * hop) {
+        deadline_monitor_skip(&deadline, (position - last_position) / hop - 1);  // 밀린 hop은 건너뛰고 최근 창으로
+    }
+    last_position = position;
+
+    // 입력 텐서에 최근 오디오 복사
+    if (timed) {
+        deadline_monitor_begin(&deadline, deadline_wake_word, esp_timer_get_time());
+    }
+    if (!fill_input(position)) {
+        return position;
+    }
+
+    // 모델 실행
+    int64_t invoke_start = esp_timer_get_time();
+    if (interpreter->Invoke() != kTfLiteOk) {
+        ESP_LOGE(TAG, "Failed to invoke TFLite model!");
+        return position;
+    }
+    int64_t invoke_end = esp_timer_get_time();
+    if (timed) {
+        deadline_monitor_end(&deadline, deadline_wake_word, invoke_end);
+    }
+    static bool first_invoke = true;
+    if (first_invoke) {
+        // 리셋 → 첫 추론 시간 (부팅 중 미룬 로그도 여기서)
+        boot_profile_mark("first_invoke");
+        boot_profile_report();
+        audio_pool_report();
+        first_invoke = false;
+    }
+#if INFERENCE_PIPELINE
+    if (pipeline_active) {
+        // 빈 슬롯에 경계 텐서를 넘기고 바로 다음 블록으로 (두 슬롯이 다 차 있으면 뒤 단계가 하나 끝낼 때까지 대기)
+        layer_pipeline_slot_t* slot = layer_pipeline_acquire(&pipeline);
+        memcpy(slot->data, boundary_output->data.raw, boundary_output->bytes);
+        slot->tag = position;
+        slot->start_us = invoke_start;
+        slot->front_us = (uint32_t)(invoke_end - invoke_start);
+        layer_pipeline_submit(&pipeline);
+        if (!timed) {
+            layer_pipeline_drain(&pipeline);  // PCM 주입: HOP 줄을 보낸 뒤에 블록 ACK
+        }
+        return position;
+    }
+#endif
+    last_invoke_us = invoke_end - invoke_start;
+    wake_word_hop_t result;
+    if (wake_word_score(position, &result)) {
+        wake_word_result(&result);
+    }
+    return position;
+}
+
+#if INFERENCE_PIPELINE
+// 뒤 단계 태스크 (PIPELINE_BACK_CORE): 앞 단계가 넘긴 경계 텐서로 뒤 모델을 실행하고 점수를 읽어서
+// 결과는 추론 태스크로 넘김 (pipeline_results, 처리는 pipeline_results_poll)
+static void pipeline_back_task(void* arg) {
+    wake_word_hop_t hop;
+    while (1) {
+        layer_pipeline_slot_t* slot = layer_pipeline_next(&pipeline);
+        memcpy(boundary_input->data.raw, slot->data, boundary_input->bytes);
+        int64_t start = esp_timer_get_time();
+        TfLiteStatus status = back_interpreter->Invoke();
+        int64_t end = esp_timer_get_time();
+        if (pipeline_bench_active) {
+            int64_t latency = end - slot->start_us;
+            pipeline_bench_latency_us += latency;
+            pipeline_bench_latency_max_us = latency > pipeline_bench_latency_max_us ? latency : pipeline_bench_latency_max_us;
+            pipeline_bench_back_us += end - start;
+        } else if (status != kTfLiteOk) {
+            ESP_LOGE(TAG, "Failed to invoke pipeline back stage!");
+        } else {
+            last_invoke_us = slot->front_us + (end - start);  // 앞 + 뒤 단계 (HOP 줄의 Invoke us)
+            if (wake_word_score(slot->tag, &hop) && xQueueSend(pipeline_results, &hop, 0) != pdTRUE) {
+                ESP_LOGW(TAG, "Pipeline result queue full, hop dropped.");
+            }
+        }
+        layer_pipeline_release(&pipeline);
     }
 }
 
+// 추론 태스크: 뒤 단계가 끝낸 hop 결과를 순서대로 처리 (inference_step 뒤마다, 늦어도 다음 블록에서)
+static void pipeline_results_poll() {
+    wake_word_hop_t hop;
+    while (xQueueReceive(pipeline_results, &hop, 0) == pdTRUE) {
+        wake_word_result(&hop);
+    }
+}
+#endif
+
+// 과부하 단계 반영 (추론 태스크): 우선순위 낮은 소리 이벤트 모델 멈춤 → 호출어 hop 두 배
+// (hop이 길어지면 keyword_detector의 평활화도 그만큼 느려짐)
+static void apply_degradation() {
+    uint8_t level = deadline.level;
+    model_scheduler_shed(&scheduler, level >= DEADLINE_LEVEL_SHED ? 1 : 0);
+    int slow = level >= DEADLINE_LEVEL_SLOW_HOP ? 1 : 0;
+    inference_hop = INFERENCE_HOP_SAMPLES << slow;
+    uint32_t hop_us = INFERENCE_HOP_US << slow;
+    deadline_monitor_set_period(&deadline, deadline_wake_word, hop_us, hop_us * DEADLINE_WAKE_WORD_PERCENT / 100);
+#if TRANSPORT != TRANSPORT_UART
+    char event[AUDIO_TRANSPORT_EVENT_TEXT];
+    snprintf(event, sizeof(event), "DEADLINE %s", deadline_monitor_level_name(level));
+    audio_transport_event(&transport, audio_ring_position(&audio_ring), event);
+#endif
+    if (TRANSPORT != TRANSPORT_UART || !capture_active) {  // UART 스트리밍 중에는 로그가 오디오 프레임 사이에 끼지 않도록
+        ESP_LOGW(TAG, "Deadline level: %s", deadline_monitor_level_name(level));
+    }
+}
+
+// PLACEMENT_BENCH (추론 태스크): 가중치 배치(flash, DRAM) × flash 쓰기 부하(없음, 다른 코어에서 있음)마다
+// 지금 입력 텐서로 Invoke()를 runs번 해서 평균/표준편차/최소/최대 시간을 로그로 출력
+// 커널/전처리 배치는 빌드 설정(Kconfig)이라 줄마다 같이 찍음. 설정을 바꿔 다시 빌드한 뒤 같은 명령으로 비교합니다.
+// 그동안 호출어 추론은 멈추고, 끝나면 빌드 설정의 가중치 배치로 모델을 다시 올림 (INFERENCE_PIPELINE이면 앞 단계만 잼)
+static void placement_bench(uint32_t runs) {
+#if PCM_INJECT
+    if (inject_active) {
+        ESP_LOGW(TAG, "PLACEMENT_BENCH is not available during PCM injection.");
+        return;
+    }
+#endif
+    if (!model_ready || capture_active) {
+        ESP_LOGW(TAG, "PLACEMENT_BENCH needs a loaded model and no command capture.");
+        return;
+    }
+    bool stress_available = flash_stress_init();
+    model_entry_t entry = active_model;
+    for (int dram = 0; dram <= (weights_buffer != nullptr ? 1 : 0); dram++) {
+        weights_dram = dram;
+        if (!tflm_load(&entry) || (dram && !weights_in_dram)) {
+            break;
+        }
+        for (int stress = 0; stress <= (stress_available ? 1 : 0); stress++) {
+            if (stress) {
+                flash_stress_start();
+            }
+            interpreter->Invoke();  // 캐시를 한 번 채운 뒤부터 잼
+            double sum = 0.0;
+            double sum_sq = 0.0;
+            int64_t min_us = INT64_MAX;
+            int64_t max_us = 0;
+            for (uint32_t i = 0; i < runs; i++) {
+                int64_t start = esp_timer_get_time();
+                interpreter->Invoke();
+                int64_t us = esp_timer_get_time() - start;
+                sum += (double)us;
+                sum_sq += (double)us * us;
+                min_us = us < min_us ? us : min_us;
+                max_us = us > max_us ? us : max_us;
+            }
+            uint32_t erases = 0;
+            uint32_t writes = 0;
+            if (stress) {
+                flash_stress_counts(&erases, &writes);
+                flash_stress_stop();
+            }
+            double mean = sum / runs;
+            double variance = sum_sq / runs - mean * mean;
+            ESP_LOGI(TAG, "PLACEMENT kernels=%s frontend=%s weights=%s stress=%s: %lu runs, mean %.0f us, stddev %.0f us, min %lld us, max %lld us (flash erases %lu, writes %lu)",
+                     PLACEMENT_KERNELS, PLACEMENT_FRONTEND, weights_in_dram ? "dram" : "flash", stress ? "on" : "off",
+                     (unsigned long)runs, mean, variance > 0.0 ? sqrt(variance) : 0.0, (long long)min_us,
+                     (long long)max_us, (unsigned long)erases, (unsigned long)writes);
+        }
+    }
+    if (!stress_available) {
+        ESP_LOGW(TAG, "No stress partition for write stress, measured without it.");
+    }
+    weights_dram = MODEL_WEIGHTS_DRAM;
+    if (!tflm_load(&entry)) {
+        ESP_LOGE(TAG, "Failed to restore model after PLACEMENT_BENCH!");
+    }
+}
+
+#if INFERENCE_PIPELINE
+// PIPELINE_BENCH (추론 태스크): 지금 입력 텐서로 hop runs번을 한 코어(앞 → 뒤 단계를 이어서)와 두 코어 파이프라인
+// (앞 단계가 쉬지 않고 다음 hop을 넘김)으로 실행해서 처리량(hops/s)과 지연(앞 단계 시작 → 뒤 단계 끝) 평균/최대를 로그로 출력
+// 그동안 호출어 추론은 멈추고, 뒤 단계 태스크는 결과를 처리하지 않고 지연만 기록
+static void pipeline_bench(uint32_t runs) {
+#if PCM_INJECT
+    if (inject_active) {
+        ESP_LOGW(TAG, "PIPELINE_BENCH is not available during PCM injection.");
+        return;
+    }
+#endif
+    if (!model_ready || capture_active || !pipeline_active) {
+        ESP_LOGW(TAG, "PIPELINE_BENCH needs a split model and no command capture.");
+        return;
+    }
+    layer_pipeline_drain(&pipeline);  // 이후 뒤 단계 태스크는 슬롯을 받을 때까지 back_interpreter를 쓰지 않음
+
+    // 한 코어
+    int64_t front_us = 0;
+    int64_t back_us = 0;
+    int64_t single_latency_max = 0;
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < runs; i++) {
+        int64_t hop_start = esp_timer_get_time();
+        interpreter->Invoke();
+        int64_t front_end = esp_timer_get_time();
+        memcpy(boundary_input->data.raw, boundary_output->data.raw, boundary_input->bytes);
+        back_interpreter->Invoke();
+        int64_t hop_end = esp_timer_get_time();
+        front_us += front_end - hop_start;
+        back_us += hop_end - front_end;
+        single_latency_max = hop_end - hop_start > single_latency_max ? hop_end - hop_start : single_latency_max;
+    }
+    int64_t single_us = esp_timer_get_time() - start;
+
+    // 두 코어
+    pipeline_bench_latency_us = 0;
+    pipeline_bench_latency_max_us = 0;
+    pipeline_bench_back_us = 0;
+    pipeline_bench_active = true;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < runs; i++) {
+        layer_pipeline_slot_t* slot = layer_pipeline_acquire(&pipeline);
+        slot->start_us = esp_timer_get_time();
+        interpreter->Invoke();
+        memcpy(slot->data, boundary_output->data.raw, boundary_output->bytes);
+        slot->tag = i;
+        slot->front_us = (uint32_t)(esp_timer_get_time() - slot->start_us);
+        layer_pipeline_submit(&pipeline);
+    }
+    layer_pipeline_drain(&pipeline);
+    int64_t pipelined_us = esp_timer_get_time() - start;
+    pipeline_bench_active = false;
+
+    double single_rate = runs * 1e6 / (single_us > 0 ? single_us : 1);
+    double pipelined_rate = runs * 1e6 / (pipelined_us > 0 ? pipelined_us : 1);
+    ESP_LOGI(TAG, "PIPELINE split after op %d (%s), boundary %u bytes: front %lld us, back %lld us avg (back %lld us on core %d)",
+             (int)split_plan.split_op, model_split_op_name(split_plan.op_code[split_plan.split_op]),
+             (unsigned)split_plan.boundary_bytes, (long long)(front_us / runs), (long long)(back_us / runs),
+             (long long)(pipeline_bench_back_us / runs), PIPELINE_BACK_CORE);
+    ESP_LOGI(TAG, "PIPELINE %lu hops: single-core %.1f hops/s, latency mean %lld us max %lld us | pipelined %.1f hops/s, latency mean %lld us max %lld us (x%.2f)",
+             (unsigned long)runs, single_rate, (long long)(single_us / runs), (long long)single_latency_max,
+             pipelined_rate, (long long)(pipeline_bench_latency_us / runs), (long long)pipeline_bench_latency_max_us,
+             pipelined_rate / single_rate);
+}
+#endif
+
+// 벤치가 끝난 뒤 (추론 태스크): 벤치 동안 밀린 오디오는 건너뜀 (마감 감시가 링 버퍼 넘침, 건너뛴 hop, 시작 간격 지터로 세지 않도록)
+static void skip_bench_backlog() {
+    last_position = audio_ring_position(&audio_ring);
+    processed_position = last_position;
+    for (int id : {deadline_inference, deadline_wake_word}) {
+        deadline_monitor_set_period(&deadline, id, deadline.stages[id].period_us, deadline.stages[id].budget_us);
+    }
+}
+
+// 모델 실행 (INFERENCE_HOP_MS마다 최근 오디오 창으로 추론)
+void process_audio() {
+    last_position = audio_ring_position(&audio_ring);
+    processed_position = last_position;
+    input_chunk = static_cast<int16_t*>(pool_buffer(INPUT_CHUNK_SAMPLES * sizeof(int16_t), AUDIO_POOL_CAP_INTERNAL));
+
+    ESP_LOGI(TAG, "Processing audio...");
+    while (1) {
+        // 새 모델이 들어왔으면 교체
+        apply_pending_model();
+        if (bench_request > 0) {
+            placement_bench(bench_request);
+            bench_request = 0;
+            skip_bench_backlog();
+        }
+#if INFERENCE_PIPELINE
+        if (pipeline_bench_request > 0) {
+            pipeline_bench(pipeline_bench_request);
+            pipeline_bench_request = 0;
+            skip_bench_backlog();
+        }
+#endif
+
+        // 캡처 태스크가 새 블록을 쓸 때까지 대기
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t previous = last_position;
+        int64_t step_start = esp_timer_get_time();
+        bool timed = realtime();
+        if (timed) {
+            // 추론 태스크가 링 버퍼 여유보다 오래 밀려서 보지 못한 오디오가 덮어써졌는지
+            uint32_t lag = audio_ring_position(&audio_ring) - processed_position;
+            uint32_t slack = (uint32_t)(audio_ring.capacity - model_window);
+            if (lag > slack) {
+                deadline_monitor_ring_overflow(&deadline, lag - slack);
+            }
+            deadline_monitor_begin(&deadline, deadline_inference, step_start);
+        }
+        uint32_t position = inference_step();
+#if INFERENCE_PIPELINE
+        pipeline_results_poll();
+#endif
+        uint32_t used_us = (uint32_t)(esp_timer_get_time() - step_start);
+        if (model_ready && last_position != previous) {
+            model_scheduler_account(&scheduler, sched_wake_word, used_us);
+        }
+
+        // 남은 시간에 차례가 된 소리 이벤트 모델 실행 (그사이 다음 블록이 이미 들어왔으면 우선순위 낮은 모델은 미룸)
+        if (audio_ring_position(&audio_ring) - position >= MODEL_BLOCK_SAMPLES) {
+            used_us = SCHED_BUDGET_US;
+        }
+        model_scheduler_cycle(&scheduler, sound_events_frame(), used_us);
+        processed_position = position;
+        if (timed) {
+            int64_t now = esp_timer_get_time();
+            deadline_monitor_end(&deadline, deadline_inference, now);
+            if (deadline_monitor_update(&deadline, now)) {
+                apply_degradation();
+            }
+        }
+#if PCM_INJECT
+        if (inject_active) {
+            xSemaphoreGive(inject_step);  // 캡처 태스크가 다음 블록을 받아도 됨
+        }
+#endif
+    }
+}
+
+#if FAST_BOOT
+static SemaphoreHandle_t model_init_done;
+
+// 모델 초기화 태스크 (FAST_BOOT): app_main이 I2S/캡처를 시작하는 동안 다른 코어에서 모델 검증, AllocateTensors
+static void model_init_task(void* arg) {
+    tflm_init();
+    boot_profile_mark("model_ready");
+    xSemaphoreGive(model_init_done);
+    vTaskDelete(NULL);
+}
+#endif
+
 extern "C" void app_main(void) {
-    i2s_chan_handle_t i2s_rx_channel;
+    static i2s_chan_handle_t i2s_rx_channel;
+    boot_profile_mark("app_main");
+
+#if PCM_INJECT
+    inject_step = xSemaphoreCreateBinary();
+    inject_done = xSemaphoreCreateBinary();
+#endif
 
-    // I2S 및 TensorFlow Lite Micro 초기화
+    // 오디오/모델 버퍼 풀 (텐서 아레나 포함, 이후 할당은 모두 여기서)
+    if (!audio_pool_init(pool_budget, sizeof(pool_budget) / sizeof(pool_budget[0]))) {
+        ESP_LOGE(TAG, "Failed to allocate audio pools!");
+        return;
+    }
+    boot_profile_mark("audio_pool");
+    inference_task = xTaskGetCurrentTaskHandle();
+
+#if FAST_BOOT
+    // 모델 초기화는 코어 1에서 (I2S/캡처 시작과 동시에)
+    model_init_done = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(model_init_task, "model_init", 4096, NULL, 5, NULL, 1);
+#endif
+
+    // 마감 감시 (I2S DMA 넘침 콜백이 쓰기 전에)
+    deadline_monitor_init(&deadline, DEADLINE_POLICY ? DEADLINE_LEVEL_SLOW_HOP : DEADLINE_LEVEL_NORMAL, esp_timer_get_time());
+    deadline_capture = deadline_monitor_add_stage(&deadline, "capture", CAPTURE_BLOCK_US,
+                                                  CAPTURE_BLOCK_US * DEADLINE_CAPTURE_PERCENT / 100, 0);
+    deadline_inference = deadline_monitor_add_stage(&deadline, "inference", CAPTURE_BLOCK_US,
+                                                    CAPTURE_BLOCK_US * DEADLINE_INFERENCE_PERCENT / 100, 0);
+    deadline_wake_word = deadline_monitor_add_stage(&deadline, "wake_word", INFERENCE_HOP_US,
+                                                    INFERENCE_HOP_US * DEADLINE_WAKE_WORD_PERCENT / 100, CAPTURE_BLOCK_US);  // 블록 단위로 깨어남
+
+    // I2S, UART 초기화
     i2s_init(&i2s_rx_channel);
+    boot_profile_mark("i2s");
+    uart_link_init(UART_BAUD_RATE, UART_RX_BUFFER_SIZE, UART_TX_BUFFER_SIZE);
+    boot_profile_mark("uart");
+#if TRANSPORT != TRANSPORT_UART
+    wifi_link_start(WIFI_SSID, WIFI_PASSWORD);  // 연결은 기다리지 않음 (그동안 전송은 BUSY)
+    boot_profile_mark("wifi");
+#endif
+
+#if !FAST_BOOT
+    // TensorFlow Lite Micro 초기화
     tflm_init();
+    boot_profile_mark("model_ready");
+#endif
+
+    // 최근 오디오 링 버퍼 (모델 입력 창 + 프리롤 + 여유 블록)
+    if (!audio_ring_init(&audio_ring, MODEL_WINDOW_MAX_SAMPLES + PREROLL_SAMPLES + 4 * MODEL_BLOCK_SAMPLES)) {
+        ESP_LOGE(TAG, "Failed to allocate audio ring buffer!");
+        return;
+    }
+    boot_profile_mark("audio_ring");
+
+    // 명령어 오디오/이벤트 전송 (링 버퍼에서 바로 보냄, 다음 블록을 쓸 자리만큼은 남기고 밀리면 버림)
+    audio_transport_backend_t backend;
+#if TRANSPORT == TRANSPORT_UART
+    uart_link_transport(&backend, TRANSPORT_UART_MTU);
+#else
+    if (!transport_socket_init(&transport_socket, TRANSPORT_HOST, TRANSPORT_PORT, TRANSPORT == TRANSPORT_UDP)) {
+        ESP_LOGE(TAG, "Invalid TRANSPORT_HOST: %s", TRANSPORT_HOST);
+    }
+    transport_socket_backend(&transport_socket, &backend);
+#endif
+    audio_transport_init(&transport, &backend, &audio_ring, audio_ring.capacity - MODEL_BLOCK_SAMPLES, TRANSPORT_FLUSH_MS * 1000);
+
+#if BLACKBOX
+    // 블랙박스 (파티션 색인, 쓰기 태스크): 캡처 태스크가 청크를 쓰기 전에
+    uint8_t* blackbox_ring = static_cast<uint8_t*>(pool_buffer(BLACKBOX_RING_BYTES(MODEL_BLOCK_SAMPLES), AUDIO_POOL_CAP_INTERNAL));
+    uint8_t* blackbox_sector = static_cast<uint8_t*>(pool_buffer(BLACKBOX_SECTOR_SIZE, AUDIO_POOL_CAP_INTERNAL));
+    if (blackbox_init(MODEL_BLOCK_SAMPLES, blackbox_ring, blackbox_sector)) {
+        boot_profile_mark("blackbox");
+    }
+#endif
+
+    // 모델 스케줄러 (호출어 추론, 캡처 블록 처리는 시간만 기록)와 소리 이벤트 모델 (캡처 태스크가 특징 스트림을 쓰기 전에)
+    model_scheduler_init(&scheduler, SCHED_BUDGET_US, SCHED_MAX_DEFER);
+    sched_wake_word = model_scheduler_add_external(&scheduler, "wake_word");
+    sched_frontend = model_scheduler_add_external(&scheduler, "frontend");
+    sched_health = COMPRESSOR_MONITOR ? model_scheduler_add_external(&scheduler, "health") : -1;
+    if (SOUND_EVENT_MODEL_COUNT > 0) {
+        size_t loaded = sound_events_init(sound_event_models, SOUND_EVENT_MODEL_COUNT, &scheduler, sound_event_detected);
+        ESP_LOGI(TAG, "%u of %u sound event models loaded.", (unsigned)loaded, (unsigned)SOUND_EVENT_MODEL_COUNT);
+        boot_profile_mark("sound_events");
+    }
+
+    // 오디오 캡처는 추론보다 높은 우선순위로 (추론이 늦어져도 오디오를 놓치지 않도록)
+    xTaskCreate(capture_task, "capture_task", 4096, i2s_rx_channel, 10, NULL);
+
+#if FAST_BOOT
+    // 모델 준비 대기 (그동안 캡처 태스크가 링 버퍼를 채움)
+    xSemaphoreTake(model_init_done, portMAX_DELAY);
+#endif
+
+#if INFERENCE_PIPELINE
+    // 뒤 단계 태스크 (추론 태스크와 같은 우선순위, 다른 코어)
+    xTaskCreatePinnedToCore(pipeline_back_task, "pipeline_back", 4096, NULL, uxTaskPriorityGet(NULL), NULL, PIPELINE_BACK_CORE);
+#endif
+
+    // UART 명령(모델 교체, POOL_REPORT, SCHED_REPORT, DEADLINE_REPORT, BLACKBOX_DUMP, TRANSPORT_REPORT, PLACEMENT_BENCH, PIPELINE_BENCH, LINK_RATE) 처리 (active_model이 정해진 뒤에)
+    xTaskCreate(command_task, "command_task", 4096, NULL, 5, NULL);
 
     // 오디오 데이터 처리
-    process_audio(i2s_rx_channel);
+    process_audio();
 }
@@ -2,6 +2,7 @@
 #define WAKE_WORD_MODEL_H
 
 #include <stdint.h>
+#include "keyword_detector.h"
 
 const unsigned char model_tflite[] = {
     0x1C, 0x00, 0x00, 0x00, 0x54, 0x46, 0x4C, 0x33, 0x14, 0x00, 0x20, 0x00, 
@@ -870,4 +871,13 @@ const unsigned char model_tflite[] = {
 };
 const unsigned int model_tflite_len = 10352;
 
+// 모델 출력 클래스 라벨 테이블 (출력 텐서 인덱스 순서와 같아야 함, 첫 번째 클래스가 호출어)
+// 모델을 다시 학습해서 클래스가 늘어나면(예: "_silence_", "문 닫혔어", "온도") 여기도 같이 수정해주세요.
+// { 라벨, 임계값, 평활화 횟수, refractory 횟수, 배경 클래스 여부 }
+const keyword_class_t model_classes[] = {
+    { "리지야",    0.80f, 3, 10, false },
+    { "_unknown_", 1.00f, 1,  0, true  },
+};
+const unsigned int model_classes_len = sizeof(model_classes) / sizeof(model_classes[0]);
+
 #endif // WAKE_WORD_MODEL_H
@@ -0,0 +1,23 @@
+#ifndef WIFI_LINK_H
+#define WIFI_LINK_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Wi-Fi STA 연결 (audio_transport 소켓 백엔드용)
+// 기다리지 않고 연결을 시작만 함 (부팅이 늦어지지 않도록). 끊기면 계속 다시 연결하고,
+// 그동안 소켓 백엔드는 연결하지 못한 만큼 BUSY (backlog를 넘는 오디오는 버려짐)
+// 실시간 스트리밍 지연을 줄이려고 절전(modem sleep)은 끔 (냉장고는 상시 전원)
+void wifi_link_start(const char *ssid, const char *password);
+
+// IP를 받았는지
+bool wifi_link_connected(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIFI_LINK_H